@@ -0,0 +1,277 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "bench.hpp"
+#include "data/string.hpp"
+#include <vendor/nhlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+using json = nlohmann::json;
+
+#ifndef SFG_CONFIGURATION
+#define SFG_CONFIGURATION "unknown"
+#endif
+
+namespace SFG::bench
+{
+	namespace
+	{
+		uint64 hash_name(const char* group, const char* name, uint32 size)
+		{
+			// fnv1a, so a case gets the same fixture no matter which others run.
+			uint64 h	   = 14695981039346656037ull;
+			auto   combine = [&h](const char* str) {
+				  for (; *str != 0; str++)
+				  {
+					  h ^= static_cast<uint8>(*str);
+					  h *= 1099511628211ull;
+				  }
+			};
+			combine(group);
+			combine("/");
+			combine(name);
+			return h ^ (static_cast<uint64>(size) * 0x9E3779B97F4A7C15ull);
+		}
+
+		string get_full_name(const char* group, const char* name)
+		{
+			string full = group;
+			full += "/";
+			full += name;
+			return full;
+		}
+
+		const char* get_compiler()
+		{
+#if defined(__clang__)
+			return "clang " __clang_version__;
+#elif defined(__GNUC__)
+			return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+			return "msvc";
+#else
+			return "unknown";
+#endif
+		}
+
+		void format_time(char* out, size_t size, double ns)
+		{
+			if (ns < 1e3)
+				std::snprintf(out, size, "%.2f ns", ns);
+			else if (ns < 1e6)
+				std::snprintf(out, size, "%.2f us", ns * 1e-3);
+			else if (ns < 1e9)
+				std::snprintf(out, size, "%.2f ms", ns * 1e-6);
+			else
+				std::snprintf(out, size, "%.2f s", ns * 1e-9);
+		}
+
+		void format_rate(char* out, size_t size, double per_second, const char* unit)
+		{
+			if (per_second <= 0.0)
+				std::snprintf(out, size, "-");
+			else if (per_second < 1e3)
+				std::snprintf(out, size, "%.2f %s/s", per_second, unit);
+			else if (per_second < 1e6)
+				std::snprintf(out, size, "%.2f K%s/s", per_second * 1e-3, unit);
+			else if (per_second < 1e9)
+				std::snprintf(out, size, "%.2f M%s/s", per_second * 1e-6, unit);
+			else
+				std::snprintf(out, size, "%.2f G%s/s", per_second * 1e-9, unit);
+		}
+	}
+
+	void bench_context::finish(uint64 iterations)
+	{
+		vector<double> sorted = _samples;
+		std::sort(sorted.begin(), sorted.end());
+
+		const size_t count = sorted.size();
+		double		 sum   = 0.0;
+		for (double s : sorted)
+			sum += s;
+
+		const double mean	  = count == 0 ? 0.0 : sum / static_cast<double>(count);
+		double		 variance = 0.0;
+		for (double s : sorted)
+			variance += (s - mean) * (s - mean);
+
+		_result.iterations = iterations;
+		_result.samples	   = static_cast<uint32>(count);
+		_result.min_ns	   = count == 0 ? 0.0 : sorted[0];
+		_result.median_ns  = count == 0 ? 0.0 : (count % 2 == 1 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) * 0.5);
+		_result.mean_ns	   = mean;
+		_result.stddev_ns  = count < 2 ? 0.0 : std::sqrt(variance / static_cast<double>(count - 1));
+	}
+
+	void bench_registry::add(const bench_case& c)
+	{
+		_cases.push_back(c);
+	}
+
+	int bench_registry::run(const bench_config& config)
+	{
+		std::sort(_cases.begin(), _cases.end(), [](const bench_case& a, const bench_case& b) {
+			const int group = std::strcmp(a.group, b.group);
+			return group != 0 ? group < 0 : std::strcmp(a.name, b.name) < 0;
+		});
+
+		vector<bench_result> results;
+
+		if (!config.list)
+			std::printf("%-52s %10s %12s %12s %8s %16s %16s\n", "benchmark", "size", "median", "min", "cv", "items", "bytes");
+
+		for (const bench_case& c : _cases)
+		{
+			const string full = get_full_name(c.group, c.name);
+			if (config.filter != nullptr && full.find(config.filter) == string::npos)
+				continue;
+
+			for (uint32 i = 0; i < c.size_count; i++)
+			{
+				const double scaled = std::round(static_cast<double>(c.sizes[i]) * config.scale);
+				const uint32 size	= scaled < 1.0 ? 1 : (scaled > static_cast<double>(UINT32_MAX) ? UINT32_MAX : static_cast<uint32>(scaled));
+
+				if (config.list)
+				{
+					std::printf("%s %u\n", full.c_str(), size);
+					continue;
+				}
+
+				bench_result result = {.group = c.group, .name = c.name, .size = size};
+				bench_context ctx(config, result, size, hash_name(c.group, c.name, c.sizes[i]) ^ config.seed);
+				c.function(ctx);
+
+				if (result.samples == 0)
+				{
+					std::printf("%-52s %10u   skipped, the case never called run()\n", full.c_str(), size);
+					continue;
+				}
+
+				char median[32], min[32], items[32], bytes[32];
+				format_time(median, sizeof(median), result.median_ns);
+				format_time(min, sizeof(min), result.min_ns);
+				format_rate(items, sizeof(items), result.items == 0 ? 0.0 : static_cast<double>(result.items) * 1e9 / result.median_ns, "");
+				format_rate(bytes, sizeof(bytes), result.bytes == 0 ? 0.0 : static_cast<double>(result.bytes) * 1e9 / result.median_ns, "B");
+				const double cv = result.mean_ns <= 0.0 ? 0.0 : result.stddev_ns / result.mean_ns * 100.0;
+				std::printf("%-52s %10u %12s %12s %7.1f%% %16s %16s", full.c_str(), size, median, min, cv, items, bytes);
+				for (uint32 k = 0; k < result.counter_count; k++)
+					std::printf("   %s %g", result.counter_names[k], result.counters[k]);
+				std::printf("\n");
+				std::fflush(stdout);
+
+				results.push_back(result);
+			}
+		}
+
+		if (config.list)
+			return 0;
+
+		if (config.baseline != nullptr)
+			compare(config, results);
+
+		if (config.json != nullptr && !write_json(config, results))
+			return 1;
+
+		return 0;
+	}
+
+	bool bench_registry::write_json(const bench_config& config, const vector<bench_result>& results) const
+	{
+		json out;
+		out["version"]		 = BENCH_JSON_VERSION;
+		out["timestamp"]	 = static_cast<int64>(std::time(nullptr));
+		out["configuration"] = SFG_CONFIGURATION;
+		out["compiler"]		 = get_compiler();
+		out["seed"]			 = config.seed;
+		out["scale"]		 = config.scale;
+		out["repeat"]		 = config.repeat;
+		out["min_time"]		 = config.min_time;
+		out["threads"]		 = config.threads;
+
+		json& entries = out["results"];
+		entries		  = json::array();
+
+		for (const bench_result& r : results)
+		{
+			json counters = json::object();
+			for (uint32 k = 0; k < r.counter_count; k++)
+				counters[r.counter_names[k]] = r.counters[k];
+
+			entries.push_back({
+				{"name", get_full_name(r.group, r.name)},
+				{"size", r.size},
+				{"iterations", r.iterations},
+				{"samples", r.samples},
+				{"min_ns", r.min_ns},
+				{"median_ns", r.median_ns},
+				{"mean_ns", r.mean_ns},
+				{"stddev_ns", r.stddev_ns},
+				{"items", r.items},
+				{"bytes", r.bytes},
+				{"items_per_second", r.items == 0 ? 0.0 : static_cast<double>(r.items) * 1e9 / r.median_ns},
+				{"bytes_per_second", r.bytes == 0 ? 0.0 : static_cast<double>(r.bytes) * 1e9 / r.median_ns},
+				{"counters", counters},
+			});
+		}
+
+		std::ofstream file(config.json);
+		if (!file.is_open())
+		{
+			std::fprintf(stderr, "can't write %s\n", config.json);
+			return false;
+		}
+
+		file << out.dump(1, '\t');
+		file.close();
+		std::printf("wrote %zu results to %s\n", results.size(), config.json);
+		return true;
+	}
+
+	void bench_registry::compare(const bench_config& config, const vector<bench_result>& results) const
+	{
+		std::ifstream file(config.baseline);
+		if (!file.is_open())
+		{
+			std::fprintf(stderr, "can't read baseline %s\n", config.baseline);
+			return;
+		}
+
+		json baseline;
+		try
+		{
+			baseline = json::parse(file);
+		}
+		catch (const std::exception& e)
+		{
+			std::fprintf(stderr, "can't parse baseline %s: %s\n", config.baseline, e.what());
+			return;
+		}
+
+		std::printf("\n%-52s %10s %12s %12s %9s\n", "compared to baseline", "size", "baseline", "current", "delta");
+
+		for (const bench_result& r : results)
+		{
+			const string full = get_full_name(r.group, r.name);
+
+			for (const json& entry : baseline.value("results", json::array()))
+			{
+				if (entry.value("name", "") != full || entry.value("size", 0u) != r.size)
+					continue;
+
+				const double before = entry.value("median_ns", 0.0);
+				if (before <= 0.0)
+					break;
+
+				char before_str[32], after_str[32];
+				format_time(before_str, sizeof(before_str), before);
+				format_time(after_str, sizeof(after_str), r.median_ns);
+				std::printf("%-52s %10u %12s %12s %+8.1f%%\n", full.c_str(), r.size, before_str, after_str, (r.median_ns - before) / before * 100.0);
+				break;
+			}
+		}
+	}
+}
@@ -0,0 +1,254 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "data/vector.hpp"
+#include <atomic>
+#include <chrono>
+#include <initializer_list>
+
+namespace SFG::bench
+{
+#define BENCH_DEFAULT_REPEAT	 10
+#define BENCH_DEFAULT_MIN_TIME	 0.01 // seconds per sample.
+#define BENCH_DEFAULT_SEED		 0x5F6Bu
+#define BENCH_MAX_SIZES			 4
+#define BENCH_MAX_ITERATIONS	 (1u << 24)
+#define BENCH_MAX_COUNTERS		 4
+#define BENCH_JSON_VERSION		 1
+
+	/// Deterministic across platforms, fixtures draw everything from one of these.
+	struct bench_random
+	{
+		uint64 state = 0;
+
+		inline uint32 next()
+		{
+			// pcg32.
+			const uint64 old		= state;
+			state					= old * 6364136223846793005ull + 1442695040888963407ull;
+			const uint32 xorshifted = static_cast<uint32>(((old >> 18u) ^ old) >> 27u);
+			const uint32 rot		= static_cast<uint32>(old >> 59u);
+			return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31u));
+		}
+
+		/// [0, max)
+		inline uint32 next(uint32 max)
+		{
+			return static_cast<uint32>((static_cast<uint64>(next()) * max) >> 32);
+		}
+
+		/// [min, max)
+		inline float range(float min, float max)
+		{
+			return min + (max - min) * (static_cast<float>(next() >> 8) * (1.0f / 16777216.0f));
+		}
+	};
+
+	/// Keeps the compiler from dropping a result.
+	template <typename T> inline void keep(const T& value)
+	{
+#if defined(SFG_COMPILER_MSVC) || defined(_MSC_VER)
+		const volatile char* sink = reinterpret_cast<const volatile char*>(&value);
+		(void)*sink;
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+
+	/// Stops the compiler from assuming memory is unchanged across it.
+	inline void clobber()
+	{
+#if defined(SFG_COMPILER_MSVC) || defined(_MSC_VER)
+		std::atomic_signal_fence(std::memory_order_seq_cst);
+#else
+		asm volatile("" : : : "memory");
+#endif
+	}
+
+	struct bench_result
+	{
+		const char* group							  = "";
+		const char* name							  = "";
+		uint32		size							  = 0;
+		uint64		iterations						  = 0; // per sample.
+		uint32		samples							  = 0;
+		double		min_ns							  = 0.0; // per iteration.
+		double		median_ns						  = 0.0;
+		double		mean_ns							  = 0.0;
+		double		stddev_ns						  = 0.0;
+		uint64		items							  = 0; // per iteration.
+		uint64		bytes							  = 0;
+		const char* counter_names[BENCH_MAX_COUNTERS] = {};
+		double		counters[BENCH_MAX_COUNTERS]	  = {};
+		uint32		counter_count					  = 0;
+	};
+
+	struct bench_config
+	{
+		const char* filter	 = nullptr; // substring of group/name.
+		const char* json	 = nullptr;
+		const char* baseline = nullptr;
+		double		scale	 = 1.0;
+		double		min_time = BENCH_DEFAULT_MIN_TIME;
+		uint32		repeat	 = BENCH_DEFAULT_REPEAT;
+		uint32		seed	 = BENCH_DEFAULT_SEED;
+		uint32		threads	 = 0; // job system workers, 0 picks from the hardware.
+		uint8		list	 = 0;
+	};
+
+	/*
+		Handed to every case. The case builds its fixture from get_size() & get_random(), then calls run() with the measured body. run() calibrates
+		how many calls fit min_time, then times repeat samples of that many calls. Bodies are called back to back, so anything they change has to
+		be put back by the body itself or not matter for the next call.
+	*/
+	class bench_context
+	{
+	public:
+		bench_context(const bench_config& config, bench_result& result, uint32 size, uint64 seed) : _config(config), _result(result), _size(size)
+		{
+			_random.state = seed;
+			_random.next();
+		}
+
+		inline uint32 get_size() const
+		{
+			return _size;
+		}
+
+		inline bench_random& get_random()
+		{
+			return _random;
+		}
+
+		/// Work done by one call of the body, reported as throughput.
+		inline void set_items(uint64 items)
+		{
+			_result.items = items;
+		}
+
+		inline void set_bytes(uint64 bytes)
+		{
+			_result.bytes = bytes;
+		}
+
+		/// Reported next to the timings, for what the case does besides taking time (binds issued, error, ...). name needs to be a literal.
+		inline void set_counter(const char* name, double value)
+		{
+			for (uint32 i = 0; i < _result.counter_count; i++)
+			{
+				if (_result.counter_names[i] == name)
+				{
+					_result.counters[i] = value;
+					return;
+				}
+			}
+
+			if (_result.counter_count == BENCH_MAX_COUNTERS)
+				return;
+
+			_result.counter_names[_result.counter_count] = name;
+			_result.counters[_result.counter_count++]	 = value;
+		}
+
+		template <typename F> void run(F&& body)
+		{
+			// warm up & calibrate.
+			uint64 iterations = 1;
+			for (;;)
+			{
+				const double elapsed = time_iterations(body, iterations);
+				if (elapsed >= _config.min_time || iterations >= BENCH_MAX_ITERATIONS)
+					break;
+
+				const double target = _config.min_time * 1.2;
+				const uint64 next	= elapsed <= 0.0 ? iterations * 10 : static_cast<uint64>(static_cast<double>(iterations) * target / elapsed) + 1;
+				iterations			= next > iterations * 10 ? iterations * 10 : next;
+				if (iterations > BENCH_MAX_ITERATIONS)
+					iterations = BENCH_MAX_ITERATIONS;
+			}
+
+			_samples.resize(0);
+			for (uint32 i = 0; i < _config.repeat; i++)
+				_samples.push_back(time_iterations(body, iterations) * 1e9 / static_cast<double>(iterations));
+
+			finish(iterations);
+		}
+
+	private:
+		template <typename F> double time_iterations(F& body, uint64 iterations)
+		{
+			const auto begin = std::chrono::steady_clock::now();
+			for (uint64 i = 0; i < iterations; i++)
+			{
+				body();
+				clobber();
+			}
+			const auto end = std::chrono::steady_clock::now();
+			return std::chrono::duration<double>(end - begin).count();
+		}
+
+		void finish(uint64 iterations);
+
+	private:
+		const bench_config& _config;
+		bench_result&		_result;
+		vector<double>		_samples;
+		bench_random		_random = {};
+		uint32				_size	= 0;
+	};
+
+	typedef void (*bench_function)(bench_context& ctx);
+
+	struct bench_case
+	{
+		const char*	   group				  = "";
+		const char*	   name					  = "";
+		bench_function function				  = nullptr;
+		uint32		   sizes[BENCH_MAX_SIZES] = {};
+		uint32		   size_count			  = 0;
+	};
+
+	class bench_registry
+	{
+	public:
+		static bench_registry& get()
+		{
+			static bench_registry instance;
+			return instance;
+		}
+
+		void add(const bench_case& c);
+
+		/// Returns the process exit code.
+		int run(const bench_config& config);
+
+	private:
+		bool write_json(const bench_config& config, const vector<bench_result>& results) const;
+		void compare(const bench_config& config, const vector<bench_result>& results) const;
+
+	private:
+		vector<bench_case> _cases;
+	};
+
+	struct bench_registrar
+	{
+		bench_registrar(const char* group, const char* name, bench_function function, std::initializer_list<uint32> sizes)
+		{
+			bench_case c = {.group = group, .name = name, .function = function};
+			for (uint32 size : sizes)
+			{
+				if (c.size_count < BENCH_MAX_SIZES)
+					c.sizes[c.size_count++] = size;
+			}
+			bench_registry::get().add(c);
+		}
+	};
+}
+
+/// Sizes are the input sizes the case runs at before --scale, at most BENCH_MAX_SIZES. Each size is reported as its own result.
+#define SFG_BENCH(GROUP, NAME, ...)                                                                                                   \
+	static void								 bench_##GROUP##_##NAME(SFG::bench::bench_context& ctx);                                 \
+	static const SFG::bench::bench_registrar bench_registrar_##GROUP##_##NAME(#GROUP, #NAME, &bench_##GROUP##_##NAME, {__VA_ARGS__}); \
+	static void								 bench_##GROUP##_##NAME(SFG::bench::bench_context& ctx)
@@ -0,0 +1,505 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "bench.hpp"
+#include "data/ostream.hpp"
+#include "data/istream.hpp"
+#include "serialization/compressor.hpp"
+#include "serialization/serialization.hpp"
+#include "io/mapped_file.hpp"
+#include "io/file_system.hpp"
+#include "resources/vertex.hpp"
+#include "io/log.hpp"
+#include <lz4/lz4.h>
+#include <fstream>
+#include <string>
+
+#ifndef SFG_PLATFORM_WINDOWS
+#include <unistd.h>
+#endif
+
+using namespace SFG;
+using namespace SFG::bench;
+
+namespace
+{
+	struct bench_record
+	{
+		uint32 id		 = 0;
+		float  pos[3]	 = {};
+		float  rot[4]	 = {};
+		uint16 flags	 = 0;
+		uint8  layer	 = 0;
+	};
+
+	constexpr size_t RECORD_BYTES = sizeof(uint32) + sizeof(float) * 7 + sizeof(uint16) + sizeof(uint8);
+
+	vector<bench_record> make_records(uint32 count, bench_random& rnd)
+	{
+		vector<bench_record> records(count);
+		for (uint32 i = 0; i < count; i++)
+		{
+			bench_record& r = records[i];
+			r.id			= i;
+			for (float& f : r.pos)
+				f = rnd.range(-100.0f, 100.0f);
+			for (float& f : r.rot)
+				f = rnd.range(-1.0f, 1.0f);
+			r.flags = static_cast<uint16>(rnd.next(8));
+			r.layer = static_cast<uint8>(rnd.next(4));
+		}
+		return records;
+	}
+
+	void write_record(ostream& stream, const bench_record& r)
+	{
+		stream << r.id;
+		for (const float& f : r.pos)
+			stream << f;
+		for (const float& f : r.rot)
+			stream << f;
+		stream << r.flags;
+		stream << r.layer;
+	}
+
+	/// Vertex like data, smooth positions & repeating normals, compresses about the way cooked meshes do.
+	void make_geometry(ostream& stream, size_t bytes, bench_random& rnd)
+	{
+		const uint32 vertex_count = static_cast<uint32>(bytes / (sizeof(float) * 8));
+		stream.create(bytes);
+		for (uint32 i = 0; i < vertex_count; i++)
+		{
+			const float x		  = static_cast<float>(i % 256) * 0.25f;
+			const float z		  = static_cast<float>(i / 256) * 0.25f;
+			const float y		  = static_cast<float>(rnd.next(16)) * 0.125f;
+			const float values[8] = {x, y, z, 0.0f, 1.0f, 0.0f, x * 0.01f, z * 0.01f};
+			stream.write_raw(reinterpret_cast<const uint8*>(values), sizeof(values));
+		}
+	}
+
+	vector<vertex_static> make_vertices(uint32 count, bench_random& rnd)
+	{
+		vector<vertex_static> vertices(count);
+		for (vertex_static& v : vertices)
+		{
+			v.pos	  = vector3(rnd.range(-100.0f, 100.0f), rnd.range(-100.0f, 100.0f), rnd.range(-100.0f, 100.0f));
+			v.normal  = vector3(0.0f, 1.0f, 0.0f);
+			v.tangent = vector4(1.0f, 0.0f, 0.0f, 1.0f);
+			v.uv	  = vector2(rnd.range(0.0f, 1.0f), rnd.range(0.0f, 1.0f));
+		}
+		return vertices;
+	}
+
+	/// What compressor wrote before the block container, payload & trailer as one lz4 stream. Kept to compare against.
+	ostream compress_legacy(ostream& raw)
+	{
+		const uint8	 compressed = 1;
+		const uint32 total		= static_cast<uint32>(raw.get_size() + COMPRESSOR_LEGACY_TRAILER);
+
+		ostream src;
+		src.create(total);
+		src.write_raw(raw.get_raw(), raw.get_size());
+		src << compressed << total;
+
+		const int bound = LZ4_compressBound(static_cast<int>(src.get_size()));
+		ostream	  out;
+		out.create(static_cast<size_t>(bound));
+		const int written = LZ4_compress_default((const char*)src.get_raw(), (char*)out.get_raw(), static_cast<int>(src.get_size()), bound);
+		out.shrink(static_cast<size_t>(written));
+		src.destroy();
+		return out;
+	}
+
+	/// What serialization::load_from_file did before mappings, the whole file read through an ifstream & decompressed. Kept to compare against.
+	istream load_ifstream(const char* path)
+	{
+		std::ifstream file(path, std::ios::in | std::ios::binary | std::ios::ate);
+		if (!file)
+			return {};
+
+		const size_t size = static_cast<size_t>(file.tellg());
+		file.seekg(0);
+
+		istream packed;
+		packed.create(nullptr, size);
+		file.read(reinterpret_cast<char*>(packed.get_raw()), static_cast<std::streamsize>(size));
+
+		istream out = compressor::decompress(packed);
+		packed.destroy();
+		return out;
+	}
+
+	/// Reads a field in kB out of /proc/self/status, 0 where it's not available.
+	size_t read_status_kb(const char* field)
+	{
+#ifdef SFG_PLATFORM_WINDOWS
+		return 0;
+#else
+		std::ifstream	  status("/proc/self/status");
+		std::string		  line;
+		const std::string prefix = field;
+		while (std::getline(status, line))
+		{
+			if (line.compare(0, prefix.size(), prefix) == 0)
+				return static_cast<size_t>(std::stoull(line.substr(prefix.size())));
+		}
+		return 0;
+#endif
+	}
+
+	/// Peak resident set growth while load runs once, in MB. The kernel's high water mark is reset first where that's allowed.
+	template <typename F> double measure_peak_rss(F&& load)
+	{
+#ifndef SFG_PLATFORM_WINDOWS
+		std::ofstream clear_refs("/proc/self/clear_refs");
+		if (clear_refs)
+			clear_refs << "5";
+		clear_refs.close();
+#endif
+		const size_t before = read_status_kb("VmRSS:");
+		load();
+		const size_t peak = read_status_kb("VmHWM:");
+		return peak > before ? static_cast<double>(peak - before) / 1024.0 : 0.0;
+	}
+
+#define BENCH_LOAD_PATH "bench_load_cooked.stkfrg"
+}
+
+SFG_BENCH(data, ostream_write_fields, 1024, 65536)
+{
+	const uint32			   count   = ctx.get_size();
+	const vector<bench_record> records = make_records(count, ctx.get_random());
+
+	ostream stream;
+	stream.create(RECORD_BYTES * count);
+
+	ctx.set_items(count);
+	ctx.set_bytes(RECORD_BYTES * count);
+	ctx.run([&]() {
+		stream.shrink(0);
+		for (const bench_record& r : records)
+			write_record(stream, r);
+	});
+
+	stream.destroy();
+}
+
+// writes into a stream that starts small, so growth is part of the cost.
+SFG_BENCH(data, ostream_write_growing, 1024, 65536)
+{
+	const uint32			   count   = ctx.get_size();
+	const vector<bench_record> records = make_records(count, ctx.get_random());
+
+	ctx.set_items(count);
+	ctx.set_bytes(RECORD_BYTES * count);
+	ctx.run([&]() {
+		ostream stream;
+		stream.create(64);
+		for (const bench_record& r : records)
+			write_record(stream, r);
+		stream.destroy();
+	});
+}
+
+SFG_BENCH(data, istream_read_fields, 1024, 65536)
+{
+	const uint32			   count   = ctx.get_size();
+	const vector<bench_record> records = make_records(count, ctx.get_random());
+
+	ostream out;
+	out.create(RECORD_BYTES * count);
+	for (const bench_record& r : records)
+		write_record(out, r);
+
+	istream		 in(out.get_raw(), out.get_size());
+	bench_record r = {};
+
+	ctx.set_items(count);
+	ctx.set_bytes(RECORD_BYTES * count);
+	ctx.run([&]() {
+		in.seek(0);
+		uint32 sum = 0;
+		for (uint32 i = 0; i < count; i++)
+		{
+			in >> r.id;
+			for (float& f : r.pos)
+				in >> f;
+			for (float& f : r.rot)
+				in >> f;
+			in >> r.flags;
+			in >> r.layer;
+			sum += r.id;
+		}
+		keep(sum);
+	});
+
+	out.destroy();
+}
+
+// cooked mesh sized vertex arrays, one header & copy per array.
+SFG_BENCH(data, serialize_vertices_bulk, 1048576, 4194304)
+{
+	const uint32				count	 = ctx.get_size();
+	const vector<vertex_static> vertices = make_vertices(count, ctx.get_random());
+
+	ostream out;
+	out.create(sizeof(vertex_static) * count + 64);
+
+	ctx.set_items(count);
+	ctx.set_bytes(sizeof(vertex_static) * count);
+	ctx.run([&]() {
+		out.shrink(0);
+		serialize_vector(out, vertices);
+		keep(out.get_size());
+	});
+
+	out.destroy();
+}
+
+// the field by field path bulk serialization replaced.
+SFG_BENCH(data, serialize_vertices_per_element, 1048576, 4194304)
+{
+	const uint32				count	 = ctx.get_size();
+	const vector<vertex_static> vertices = make_vertices(count, ctx.get_random());
+
+	ostream out;
+	out.create(sizeof(vertex_static) * count + 64);
+
+	ctx.set_items(count);
+	ctx.set_bytes(sizeof(vertex_static) * count);
+	ctx.run([&]() {
+		out.shrink(0);
+		out << count;
+		for (const vertex_static& v : vertices)
+			v.serialize(out);
+		keep(out.get_size());
+	});
+
+	out.destroy();
+}
+
+SFG_BENCH(data, deserialize_vertices_bulk, 1048576, 4194304)
+{
+	const uint32				count	 = ctx.get_size();
+	const vector<vertex_static> vertices = make_vertices(count, ctx.get_random());
+
+	ostream out;
+	serialize_vector(out, vertices);
+	istream				  in(out.get_raw(), out.get_size());
+	vector<vertex_static> read;
+
+	ctx.set_items(count);
+	ctx.set_bytes(sizeof(vertex_static) * count);
+	ctx.run([&]() {
+		in.seek(0);
+		deserialize_vector(in, read);
+		keep(read.data());
+	});
+
+	out.destroy();
+}
+
+SFG_BENCH(data, deserialize_vertices_per_element, 1048576, 4194304)
+{
+	const uint32				count	 = ctx.get_size();
+	const vector<vertex_static> vertices = make_vertices(count, ctx.get_random());
+
+	ostream out;
+	out << count;
+	for (const vertex_static& v : vertices)
+		v.serialize(out);
+	istream				  in(out.get_raw(), out.get_size());
+	vector<vertex_static> read;
+
+	ctx.set_items(count);
+	ctx.set_bytes(sizeof(vertex_static) * count);
+	ctx.run([&]() {
+		in.seek(0);
+		uint32 sz = 0;
+		in >> sz;
+		read.resize(sz);
+		for (vertex_static& v : read)
+			v.deserialize(in);
+		keep(read.data());
+	});
+
+	out.destroy();
+}
+
+// size is in KB, runs its blocks on the job system.
+SFG_BENCH(data, compressor_compress, 1024, 16384)
+{
+	const size_t bytes = static_cast<size_t>(ctx.get_size()) * 1024;
+
+	ostream raw;
+	make_geometry(raw, bytes, ctx.get_random());
+
+	ctx.set_bytes(raw.get_size());
+	ctx.run([&]() {
+		ostream packed = compressor::compress(raw);
+		keep(packed.get_size());
+		packed.destroy();
+	});
+
+	raw.destroy();
+}
+
+SFG_BENCH(data, compressor_decompress, 1024, 16384)
+{
+	const size_t bytes = static_cast<size_t>(ctx.get_size()) * 1024;
+
+	ostream raw;
+	make_geometry(raw, bytes, ctx.get_random());
+	ostream packed = compressor::compress(raw);
+	istream in(packed.get_raw(), packed.get_size());
+
+	ctx.set_bytes(raw.get_size());
+	ctx.run([&]() {
+		istream out = compressor::decompress(in);
+		keep(out.get_size());
+		out.destroy();
+	});
+
+	packed.destroy();
+	raw.destroy();
+}
+
+// the single threaded whole stream path compress/decompress replaced.
+SFG_BENCH(data, compressor_compress_legacy, 1024, 16384)
+{
+	const size_t bytes = static_cast<size_t>(ctx.get_size()) * 1024;
+
+	ostream raw;
+	make_geometry(raw, bytes, ctx.get_random());
+
+	ctx.set_bytes(raw.get_size());
+	ctx.run([&]() {
+		ostream packed = compress_legacy(raw);
+		keep(packed.get_size());
+		packed.destroy();
+	});
+
+	raw.destroy();
+}
+
+SFG_BENCH(data, compressor_decompress_legacy, 1024, 16384)
+{
+	const size_t bytes = static_cast<size_t>(ctx.get_size()) * 1024;
+
+	ostream raw;
+	make_geometry(raw, bytes, ctx.get_random());
+	ostream packed = compress_legacy(raw);
+	istream in(packed.get_raw(), packed.get_size());
+
+	ctx.set_bytes(raw.get_size());
+	ctx.run([&]() {
+		istream out = compressor::decompress(in);
+		keep(out.get_size());
+		out.destroy();
+	});
+
+	packed.destroy();
+	raw.destroy();
+}
+
+// a large cooked file loaded warm from the page cache, mapped vs load_from_file vs the old ifstream read.
+// Counter is how far one load pushes the resident set past what the process already held, in MB.
+SFG_BENCH(data, load_cooked_mapped, 16384, 65536)
+{
+	const size_t bytes = static_cast<size_t>(ctx.get_size()) * 1024;
+
+	ostream raw;
+	make_geometry(raw, bytes, ctx.get_random());
+	serialization::save_to_file(BENCH_LOAD_PATH, raw);
+
+	auto load = [&]() {
+		mapped_file file;
+		istream		in;
+		if (serialization::load_from_file_mapped(BENCH_LOAD_PATH, file, in))
+			keep(in.get_raw()[in.get_size() - 1]);
+		in.destroy();
+	};
+
+	ctx.set_bytes(raw.get_size());
+	ctx.set_counter("peak_rss_mb", measure_peak_rss(load));
+	ctx.run(load);
+
+	file_system::delete_file(BENCH_LOAD_PATH);
+	raw.destroy();
+}
+
+SFG_BENCH(data, load_cooked_from_file, 16384, 65536)
+{
+	const size_t bytes = static_cast<size_t>(ctx.get_size()) * 1024;
+
+	ostream raw;
+	make_geometry(raw, bytes, ctx.get_random());
+	serialization::save_to_file(BENCH_LOAD_PATH, raw);
+
+	auto load = [&]() {
+		istream in = serialization::load_from_file(BENCH_LOAD_PATH);
+		keep(in.get_size());
+		in.destroy();
+	};
+
+	ctx.set_bytes(raw.get_size());
+	ctx.set_counter("peak_rss_mb", measure_peak_rss(load));
+	ctx.run(load);
+
+	file_system::delete_file(BENCH_LOAD_PATH);
+	raw.destroy();
+}
+
+SFG_BENCH(data, load_cooked_ifstream, 16384, 65536)
+{
+	const size_t bytes = static_cast<size_t>(ctx.get_size()) * 1024;
+
+	ostream raw;
+	make_geometry(raw, bytes, ctx.get_random());
+	serialization::save_to_file(BENCH_LOAD_PATH, raw);
+
+	auto load = [&]() {
+		istream in = load_ifstream(BENCH_LOAD_PATH);
+		keep(in.get_size());
+		in.destroy();
+	};
+
+	ctx.set_bytes(raw.get_size());
+	ctx.set_counter("peak_rss_mb", measure_peak_rss(load));
+	ctx.run(load);
+
+	file_system::delete_file(BENCH_LOAD_PATH);
+	raw.destroy();
+}
+
+// size messages per call, then waits for the log thread so every call starts with an empty ring. Console output is off.
+SFG_BENCH(data, log_producer, 64, 512)
+{
+	const uint32 count = ctx.get_size();
+	SFG::log&	 l	   = SFG::log::instance();
+	l.set_console_enabled(false);
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		for (uint32 i = 0; i < count; i++)
+			SFG_INFO("bench message {0} of {1}, {2}", i, count, 0.5f);
+		l.flush();
+	});
+
+	l.set_console_enabled(true);
+}
+
+// a disabled level is a single mask test.
+SFG_BENCH(data, log_producer_filtered, 512)
+{
+	const uint32 count = ctx.get_size();
+	SFG::log&	 l	   = SFG::log::instance();
+	l.set_level_enabled(log_level::trace, false);
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		for (uint32 i = 0; i < count; i++)
+			SFG_TRACE("bench message {0} of {1}, {2}", i, count, 0.5f);
+	});
+
+	l.set_level_enabled(log_level::trace, true);
+}
@@ -0,0 +1,386 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "bench.hpp"
+#include "gfx/common/texture_buffer.hpp"
+#include "gfx/world/draw_list.hpp"
+#include "gfx/backend/backend.hpp"
+#include "gfx/common/descriptions.hpp"
+#include "gfx/world/texture_streamer.hpp"
+#include "gfx/util/mip_util.hpp"
+#include "gfx/util/image_util.hpp"
+#include "gfx/util/block_compressor.hpp"
+#include "gfx/util/mesh_util.hpp"
+#include "memory/memory.hpp"
+#include <cmath>
+
+using namespace SFG;
+using namespace SFG::bench;
+
+namespace
+{
+	/// Smooth gradients with per pixel noise, closer to albedo maps than pure noise.
+	texture_buffer make_image(uint16 size, bench_random& rnd)
+	{
+		texture_buffer buffer = {};
+		buffer.size			  = vector2ui16(size, size);
+		buffer.bpp			  = 4;
+		buffer.pixels		  = reinterpret_cast<uint8*>(SFG_MALLOC(static_cast<size_t>(size) * size * 4));
+
+		for (uint32 y = 0; y < size; y++)
+		{
+			for (uint32 x = 0; x < size; x++)
+			{
+				uint8* p = buffer.pixels + (static_cast<size_t>(y) * size + x) * 4;
+				p[0]	 = static_cast<uint8>((x * 255 / size + rnd.next(24)) & 0xFF);
+				p[1]	 = static_cast<uint8>((y * 255 / size + rnd.next(24)) & 0xFF);
+				p[2]	 = static_cast<uint8>(((x ^ y) & 0x3F) + rnd.next(16));
+				p[3]	 = 255;
+			}
+		}
+
+		return buffer;
+	}
+
+	/// Grid of side x side vertices, triangles shuffled so the vertex cache has work to do.
+	void make_grid(vector<primitive_index>& indices, uint32 side, bench_random& rnd)
+	{
+		const uint32 quads = (side - 1) * (side - 1);
+		vector<uint32> order(quads);
+		for (uint32 i = 0; i < quads; i++)
+			order[i] = i;
+		for (uint32 i = quads; i > 1; i--)
+			std::swap(order[i - 1], order[rnd.next(i)]);
+
+		indices.resize(0);
+		indices.reserve(quads * 6);
+		for (uint32 q : order)
+		{
+			const uint32 x = q % (side - 1);
+			const uint32 y = q / (side - 1);
+			const uint32 i = y * side + x;
+			const primitive_index quad[6] = {
+				static_cast<primitive_index>(i),
+				static_cast<primitive_index>(i + side),
+				static_cast<primitive_index>(i + 1),
+				static_cast<primitive_index>(i + 1),
+				static_cast<primitive_index>(i + side),
+				static_cast<primitive_index>(i + side + 1),
+			};
+			indices.insert(indices.end(), quad, quad + 6);
+		}
+	}
+
+	/// Heights of side x side vertices, a few smooth waves so collapses carry some error.
+	void make_terrain(vector<vector3>& positions, uint32 side)
+	{
+		positions.resize(static_cast<size_t>(side) * side);
+		for (uint32 y = 0; y < side; y++)
+		{
+			for (uint32 x = 0; x < side; x++)
+			{
+				const float fx			= static_cast<float>(x);
+				const float fy			= static_cast<float>(y);
+				positions[y * side + x]	= vector3(fx, std::sin(fx * 0.11f) * std::cos(fy * 0.07f) * 4.0f, fy);
+			}
+		}
+	}
+
+	/// Binds & draws in the given order, the way the renderer walks a pass.
+	template <typename Draws> void bind_all(gfx_id cmd, const Draws& draws, uint32 count, draw_stats& stats)
+	{
+		gfx_backend::get()->reset_command_buffer(cmd);
+		draw_binder binder(cmd, stats);
+		for (uint32 i = 0; i < count; i++)
+		{
+			binder.bind(draws[i], true);
+			binder.draw(draws[i]);
+		}
+	}
+
+	uint32 total_binds(const draw_stats& stats)
+	{
+		return stats.pipeline_binds + stats.group_binds + stats.vertex_binds + stats.index_binds;
+	}
+
+	/// Levels past the source, which stays with the caller.
+	void free_chain(texture_buffer* chain, uint8 levels)
+	{
+		for (uint8 i = 1; i < levels; i++)
+		{
+			SFG_FREE(chain[i].pixels);
+			chain[i] = {};
+		}
+	}
+
+	double mean_difference(const texture_buffer& a, const texture_buffer& b)
+	{
+		const size_t size = a.get_data_size();
+		uint64		 sum  = 0;
+		for (size_t i = 0; i < size; i++)
+			sum += a.pixels[i] > b.pixels[i] ? a.pixels[i] - b.pixels[i] : b.pixels[i] - a.pixels[i];
+		return static_cast<double>(sum) / static_cast<double>(size);
+	}
+
+#define BENCH_MIP_LEVELS	 13
+#define BENCH_DRAW_LIST_MAX	 16384
+#define BENCH_DRAW_PIPELINES 16
+#define BENCH_DRAW_MATERIALS 128
+#define BENCH_DRAW_MESHES	 32
+}
+
+// a frame worth of opaque draws: add, sort & record through draw_binder into a null backend command buffer.
+// Counters are binds per frame in submission vs sorted order.
+SFG_BENCH(gfx, draw_list_bind_changes, 1024, 16384)
+{
+	const uint32		 count = ctx.get_size();
+	vector<indexed_draw> draws(count);
+	vector<uint64>		 keys(count);
+	for (uint32 i = 0; i < count; i++)
+	{
+		// materials belong to one pipeline, meshes share a few vertex & index buffers.
+		bench_random& rnd	   = ctx.get_random();
+		const uint16  material = static_cast<uint16>(rnd.next(BENCH_DRAW_MATERIALS));
+		const uint32  mesh	   = rnd.next(BENCH_DRAW_MESHES);
+		indexed_draw& d		   = draws[i];
+		d.pipeline			   = static_cast<gfx_id>(material % BENCH_DRAW_PIPELINES);
+		d.bind_group		   = static_cast<gfx_id>(material);
+		d.vertex_buffer		   = static_cast<gfx_id>(mesh % 4);
+		d.idx_buffer		   = static_cast<gfx_id>(mesh % 4);
+		d.vertex_size		   = d.vertex_buffer < 2 ? 48 : 64;
+		d.index_count		   = 36;
+		d.instance_count	   = 1;
+		keys[i]				   = draw_key::make(0, d.pipeline, material, d.vertex_buffer, d.idx_buffer, static_cast<uint16>(rnd.next(UINT16_MAX)));
+	}
+
+	null_backend* backend = null_backend::create_instance();
+	const gfx_id  cmd	  = backend->create_command_buffer({.type = command_type::graphics});
+	backend->set_recording(true);
+
+	draw_stats unsorted = {};
+	bind_all(cmd, draws, count, unsorted);
+
+	draw_list<BENCH_DRAW_LIST_MAX>* list   = new draw_list<BENCH_DRAW_LIST_MAX>();
+	draw_stats						sorted = {};
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		list->clear();
+		for (uint32 i = 0; i < count; i++)
+			list->add(keys[i], draws[i]);
+		list->sort();
+
+		sorted.reset();
+		bind_all(cmd, *list, count, sorted);
+		keep(sorted);
+	});
+
+	ctx.set_counter("binds_unsorted", total_binds(unsorted));
+	ctx.set_counter("binds_sorted", total_binds(sorted));
+	ctx.set_counter("pipeline_binds", sorted.pipeline_binds);
+	delete list;
+
+	backend->set_recording(false);
+	backend->destroy_command_buffer(cmd);
+	null_backend::destroy_instance();
+}
+
+// includes copying the unsorted keys in, sorting works in place.
+SFG_BENCH(gfx, draw_sort_radix, 1024, 16384, 131072)
+{
+	const uint32   count = ctx.get_size();
+	vector<uint64> keys(count);
+	vector<uint32> indices(count);
+	for (uint32 i = 0; i < count; i++)
+	{
+		bench_random& rnd = ctx.get_random();
+		keys[i]			  = draw_key::make(static_cast<uint8>(rnd.next(2)), static_cast<gfx_id>(rnd.next(16)), static_cast<uint16>(rnd.next(64)), static_cast<gfx_id>(rnd.next(4)), static_cast<gfx_id>(rnd.next(4)), static_cast<uint16>(rnd.next(UINT16_MAX)));
+		indices[i]		  = i;
+	}
+
+	vector<uint64> work_keys(count), tmp_keys(count);
+	vector<uint32> work_indices(count), tmp_indices(count);
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		SFG_MEMCPY(work_keys.data(), keys.data(), sizeof(uint64) * count);
+		SFG_MEMCPY(work_indices.data(), indices.data(), sizeof(uint32) * count);
+		draw_sort::radix_sort(work_keys.data(), work_indices.data(), tmp_keys.data(), tmp_indices.data(), count);
+	});
+}
+
+// size is the source edge, one level down.
+SFG_BENCH(gfx, mip_downsample_box, 512, 2048)
+{
+	const uint16		 size = static_cast<uint16>(ctx.get_size() < 4096 ? ctx.get_size() : 4096);
+	texture_buffer		 src  = make_image(size, ctx.get_random());
+	texture_buffer		 dst  = {.size = vector2ui16(size / 2, size / 2), .bpp = 4};
+	const mip_util::desc desc = {.mip_filter = mip_util::filter::box, .is_linear = 0};
+	dst.pixels				  = reinterpret_cast<uint8*>(SFG_MALLOC(dst.get_data_size()));
+
+	ctx.set_bytes(src.get_data_size());
+	ctx.run([&]() { mip_util::downsample(src, dst, desc); });
+
+	SFG_FREE(src.pixels);
+	SFG_FREE(dst.pixels);
+}
+
+SFG_BENCH(gfx, mip_downsample_kaiser, 512, 2048)
+{
+	const uint16		 size = static_cast<uint16>(ctx.get_size() < 4096 ? ctx.get_size() : 4096);
+	texture_buffer		 src  = make_image(size, ctx.get_random());
+	texture_buffer		 dst  = {.size = vector2ui16(size / 2, size / 2), .bpp = 4};
+	const mip_util::desc desc = {.mip_filter = mip_util::filter::kaiser, .is_linear = 0};
+	dst.pixels				  = reinterpret_cast<uint8*>(SFG_MALLOC(dst.get_data_size()));
+
+	ctx.set_bytes(src.get_data_size());
+	ctx.run([&]() { mip_util::downsample(src, dst, desc); });
+
+	SFG_FREE(src.pixels);
+	SFG_FREE(dst.pixels);
+}
+
+// full chains through mip_util and through the stb path it replaced, sRGB box. Counter is the mean channel difference of the first level.
+SFG_BENCH(gfx, mip_chain_mip_util, 512, 2048)
+{
+	const uint16		 size	= static_cast<uint16>(ctx.get_size() < 4096 ? ctx.get_size() : 4096);
+	const uint8			 levels = image_util::calculate_mip_levels(size, size);
+	texture_buffer		 chain[BENCH_MIP_LEVELS];
+	texture_buffer		 ref[BENCH_MIP_LEVELS];
+	const mip_util::desc desc = {.mip_filter = mip_util::filter::box, .is_linear = 0};
+	chain[0]				  = make_image(size, ctx.get_random());
+	ref[0]					  = chain[0];
+
+	ctx.set_bytes(chain[0].get_data_size());
+	ctx.run([&]() {
+		mip_util::generate(chain, levels, desc);
+		free_chain(chain, levels);
+	});
+
+	mip_util::generate(chain, levels, desc);
+	image_util::generate_mips_stb(ref, levels, image_util::mip_gen_filter::box, 4, false, false);
+	ctx.set_counter("mean_diff_vs_stb", mean_difference(chain[1], ref[1]));
+	free_chain(chain, levels);
+	free_chain(ref, levels);
+	SFG_FREE(chain[0].pixels);
+}
+
+SFG_BENCH(gfx, mip_chain_stb, 512, 2048)
+{
+	const uint16   size	  = static_cast<uint16>(ctx.get_size() < 4096 ? ctx.get_size() : 4096);
+	const uint8	   levels = image_util::calculate_mip_levels(size, size);
+	texture_buffer chain[BENCH_MIP_LEVELS];
+	chain[0] = make_image(size, ctx.get_random());
+
+	ctx.set_bytes(chain[0].get_data_size());
+	ctx.run([&]() {
+		image_util::generate_mips_stb(chain, levels, image_util::mip_gen_filter::box, 4, false, false);
+		free_chain(chain, levels);
+	});
+
+	SFG_FREE(chain[0].pixels);
+}
+
+SFG_BENCH(gfx, block_compress_bc1, 256, 1024)
+{
+	const uint16				 size = static_cast<uint16>(ctx.get_size() < 4096 ? ctx.get_size() : 4096);
+	texture_buffer				 src  = make_image(size, ctx.get_random());
+	const block_compressor::desc desc = {.target = format::bc1_block_unorm};
+
+	ctx.set_bytes(src.get_data_size());
+	ctx.run([&]() {
+		texture_buffer dst = {};
+		block_compressor::compress(src, dst, desc);
+		SFG_FREE(dst.pixels);
+	});
+
+	SFG_FREE(src.pixels);
+}
+
+SFG_BENCH(gfx, block_compress_bc7, 256, 512)
+{
+	const uint16				 size = static_cast<uint16>(ctx.get_size() < 4096 ? ctx.get_size() : 4096);
+	texture_buffer				 src  = make_image(size, ctx.get_random());
+	const block_compressor::desc desc = {.target = format::bc7_block_unorm};
+
+	ctx.set_bytes(src.get_data_size());
+	ctx.run([&]() {
+		texture_buffer dst = {};
+		block_compressor::compress(src, dst, desc);
+		SFG_FREE(dst.pixels);
+	});
+
+	SFG_FREE(src.pixels);
+}
+
+// size is the grid edge in vertices, reordering a shuffled grid.
+SFG_BENCH(gfx, mesh_optimize_vertex_cache, 64, 240)
+{
+	const uint32			side = ctx.get_size() < 2 ? 2 : (ctx.get_size() > 256 ? 256 : ctx.get_size());
+	vector<primitive_index> indices;
+	make_grid(indices, side, ctx.get_random());
+	vector<primitive_index> out(indices.size());
+
+	ctx.set_items(indices.size() / 3);
+	ctx.run([&]() { mesh_util::optimize_vertex_cache(out.data(), indices.data(), indices.size(), side * side); });
+}
+
+SFG_BENCH(gfx, mesh_analyze_acmr, 64, 240)
+{
+	const uint32			side = ctx.get_size() < 2 ? 2 : (ctx.get_size() > 256 ? 256 : ctx.get_size());
+	vector<primitive_index> indices;
+	make_grid(indices, side, ctx.get_random());
+
+	ctx.set_items(indices.size() / 3);
+	ctx.run([&]() { keep(mesh_util::analyze(indices.data(), indices.size(), side * side, 32).acmr); });
+}
+
+// size is the grid edge in vertices, one LOD level at half the triangles.
+SFG_BENCH(gfx, mesh_simplify_half, 64, 240)
+{
+	const uint32			side = ctx.get_size() < 2 ? 2 : (ctx.get_size() > 256 ? 256 : ctx.get_size());
+	vector<primitive_index> indices;
+	vector<vector3>			positions;
+	make_grid(indices, side, ctx.get_random());
+	make_terrain(positions, side);
+	vector<primitive_index> out(indices.size());
+
+	ctx.set_items(indices.size() / 3);
+	ctx.run([&]() { keep(mesh_util::simplify(out.data(), indices.data(), indices.size(), reinterpret_cast<const uint8*>(positions.data()), sizeof(vector3), positions.size(), indices.size() / 2 / 3 * 3, 0.05f)); });
+}
+
+// size is the texture count, every frame requests a new mip for a quarter of them.
+SFG_BENCH(gfx, texture_streamer_update, 256, 2048)
+{
+	const uint32	 count	  = ctx.get_size() < STREAM_INVALID_ID ? ctx.get_size() : STREAM_INVALID_ID - 1;
+	texture_streamer streamer = {};
+	streamer.init({.upload_bytes = STREAM_UPLOAD_BUDGET, .resident_bytes = STREAM_RESIDENT_BUDGET});
+
+	vector<uint16> ids(count);
+	for (uint32 i = 0; i < count; i++)
+	{
+		// 2048 down to 1, rgba8.
+		uint32 mip_bytes[12] = {};
+		for (uint32 m = 0; m < 12; m++)
+		{
+			const uint32 edge = 2048u >> m;
+			mip_bytes[m]	  = edge * edge * 4;
+		}
+		ids[i] = streamer.add_texture(mip_bytes, 12, 5, 5);
+	}
+
+	vector<texture_streamer::residency_change> changes;
+	uint64									   frame = 0;
+
+	ctx.set_items(count / 4);
+	ctx.run([&]() {
+		frame++;
+		bench_random& rnd = ctx.get_random();
+		for (uint32 i = 0; i < count / 4; i++)
+			streamer.request(ids[rnd.next(count)], static_cast<uint8>(rnd.next(6)), frame);
+		changes.resize(0);
+		streamer.update(frame, changes);
+		keep(changes.size());
+	});
+
+	streamer.uninit();
+}
@@ -0,0 +1,75 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "bench.hpp"
+#include "math/vector2.hpp"
+#include "math/vector4.hpp"
+
+#define VEKT_STRING_CSTR
+#define VEKT_VEC4 SFG::vector4
+#define VEKT_VEC2 SFG::vector2
+#define VEKT_IMPL
+#include "gui/vekt.hpp"
+
+using namespace SFG;
+using namespace SFG::bench;
+
+namespace
+{
+#define BENCH_GUI_COLUMNS 32
+
+	/// Rows of BENCH_GUI_COLUMNS rects under the root, sized relative to their parents so layout has to resolve both levels.
+	void make_widgets(vekt::builder& builder, uint32 count, bench_random& rnd)
+	{
+		vekt::pos_props& root_pos = builder.widget_get_pos_props(builder.get_root());
+		root_pos.flags			  = vekt::pos_flags::pf_child_pos_column;
+
+		const uint32 rows = (count + BENCH_GUI_COLUMNS - 1) / BENCH_GUI_COLUMNS;
+		for (uint32 r = 0; r < rows; r++)
+		{
+			const vekt::id row = builder.allocate();
+			builder.widget_add_child(builder.get_root(), row);
+			builder.widget_set_size(row, vector2(1.0f, 1.0f / static_cast<float>(rows)));
+			builder.widget_get_pos_props(row).flags = vekt::pos_flags::pf_child_pos_row;
+
+			for (uint32 c = 0; c < BENCH_GUI_COLUMNS; c++)
+			{
+				const vekt::id w = builder.allocate();
+				builder.widget_add_child(row, w);
+				builder.widget_set_size(w, vector2(1.0f / BENCH_GUI_COLUMNS, 1.0f));
+
+				vekt::widget_gfx& gfx = builder.widget_get_gfx(w);
+				gfx.flags			  = vekt::gfx_flags::gfx_is_rect;
+				gfx.color			  = vector4(rnd.range(0.0f, 1.0f), rnd.range(0.0f, 1.0f), rnd.range(0.0f, 1.0f), 1.0f);
+			}
+		}
+	}
+}
+
+// size is the widget count, a full layout, draw & flush per call.
+SFG_BENCH(gui, vekt_builder_build, 256, 4096)
+{
+	const uint32  count = ctx.get_size();
+	vekt::builder builder;
+	builder.init({
+		.widget_count				 = count + count / BENCH_GUI_COLUMNS + 2,
+		.vertex_buffer_sz			 = 1024 * 1024 * 16,
+		.index_buffer_sz			 = 1024 * 1024 * 16,
+		.text_cache_vertex_buffer_sz = 1024 * 1024,
+		.text_cache_index_buffer_sz	 = 1024 * 1024,
+		.buffer_count				 = 8,
+	});
+
+	uint32 draws = 0;
+	builder.set_on_draw([&draws](const vekt::draw_buffer& buffer) { draws++; });
+	make_widgets(builder, count, ctx.get_random());
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		builder.build_begin(vector2(1920.0f, 1080.0f));
+		builder.build_end();
+		builder.flush();
+	});
+
+	keep(draws);
+	builder.uninit();
+}
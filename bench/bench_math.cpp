@@ -0,0 +1,153 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "bench.hpp"
+#include "math/matrix4x3.hpp"
+#include "math/matrix4x4.hpp"
+#include "math/quat.hpp"
+#include "math/vector3.hpp"
+#include "math/aabb.hpp"
+#include "math/frustum.hpp"
+#include "gfx/world/frustum_culler.hpp"
+#include "gfx/world/lod_selector.hpp"
+
+using namespace SFG;
+using namespace SFG::bench;
+
+namespace
+{
+	struct bench_transform
+	{
+		vector3 position = vector3::zero;
+		quat	rotation = quat::identity;
+		vector3 scale	 = vector3::one;
+	};
+
+	vector<bench_transform> make_transforms(uint32 count, bench_random& rnd)
+	{
+		vector<bench_transform> transforms(count);
+		for (bench_transform& t : transforms)
+		{
+			t.position = vector3(rnd.range(-500.0f, 500.0f), rnd.range(-20.0f, 50.0f), rnd.range(-500.0f, 500.0f));
+			t.rotation = quat::from_euler(rnd.range(-180.0f, 180.0f), rnd.range(-180.0f, 180.0f), rnd.range(-180.0f, 180.0f));
+			t.scale	   = vector3::one * rnd.range(0.5f, 2.0f);
+		}
+		return transforms;
+	}
+
+	/// Boxes scattered around a camera at the origin looking down +z, roughly a third of them in view.
+	vector<aabb> make_boxes(uint32 count, bench_random& rnd)
+	{
+		vector<aabb> boxes(count);
+		for (aabb& box : boxes)
+		{
+			const vector3 center(rnd.range(-500.0f, 500.0f), rnd.range(-20.0f, 50.0f), rnd.range(-500.0f, 500.0f));
+			const vector3 half(rnd.range(0.5f, 8.0f), rnd.range(0.5f, 8.0f), rnd.range(0.5f, 8.0f));
+			box = aabb(center - half, center + half);
+		}
+		return boxes;
+	}
+
+	frustum make_frustum()
+	{
+		const matrix4x4 view = matrix4x4::look_at(vector3(0.0f, 10.0f, 0.0f), vector3(0.0f, 10.0f, 100.0f), vector3::up);
+		const matrix4x4 proj = matrix4x4::perspective(70.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
+		return frustum::extract(proj * view);
+	}
+}
+
+SFG_BENCH(math, matrix4x3_transform, 4096, 65536)
+{
+	const uint32				  count		 = ctx.get_size();
+	const vector<bench_transform> transforms = make_transforms(count, ctx.get_random());
+	vector<matrix4x3>			  out(count);
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		for (uint32 i = 0; i < count; i++)
+			out[i] = matrix4x3::transform(transforms[i].position, transforms[i].rotation, transforms[i].scale);
+	});
+}
+
+// parent * local, the inner step of hierarchy updates.
+SFG_BENCH(math, matrix4x3_multiply, 4096, 65536)
+{
+	const uint32				  count		 = ctx.get_size();
+	const vector<bench_transform> transforms = make_transforms(count, ctx.get_random());
+	vector<matrix4x3>			  locals(count);
+	vector<matrix4x3>			  out(count);
+	for (uint32 i = 0; i < count; i++)
+		locals[i] = matrix4x3::transform(transforms[i].position, transforms[i].rotation, transforms[i].scale);
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		out[0] = locals[0];
+		for (uint32 i = 1; i < count; i++)
+			out[i] = locals[i / 2] * locals[i];
+	});
+}
+
+SFG_BENCH(math, matrix4x3_inverse, 4096, 65536)
+{
+	const uint32				  count		 = ctx.get_size();
+	const vector<bench_transform> transforms = make_transforms(count, ctx.get_random());
+	vector<matrix4x3>			  mats(count);
+	vector<matrix4x3>			  out(count);
+	for (uint32 i = 0; i < count; i++)
+		mats[i] = matrix4x3::transform(transforms[i].position, transforms[i].rotation, transforms[i].scale);
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		for (uint32 i = 0; i < count; i++)
+			out[i] = mats[i].inverse();
+	});
+}
+
+SFG_BENCH(math, frustum_test, 4096, 65536)
+{
+	const uint32	   count = ctx.get_size();
+	const vector<aabb> boxes = make_boxes(count, ctx.get_random());
+	const frustum	   fr	 = make_frustum();
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		uint32 visible = 0;
+		for (uint32 i = 0; i < count; i++)
+			visible += frustum::test(fr, boxes[i]) != frustum_result::outside;
+		keep(visible);
+	});
+}
+
+// the batched path the renderer uses, same fixture as frustum_test.
+SFG_BENCH(math, frustum_culler_cull, 4096, 65536)
+{
+	const uint32	   count = ctx.get_size();
+	const vector<aabb> boxes = make_boxes(count, ctx.get_random());
+	const frustum	   fr	 = make_frustum();
+	vector<uint8>	   visible(count);
+	cull_stats		   stats = {};
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		stats.reset();
+		frustum_culler::cull(&fr, 1, boxes.data(), count, visible.data(), stats);
+		keep(stats.visible);
+	});
+}
+
+SFG_BENCH(math, lod_selector_select, 4096, 65536)
+{
+	const uint32	count		= ctx.get_size();
+	const matrix4x4 proj		= matrix4x4::perspective(70.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
+	const float		proj_factor = lod_selector::calculate_projection_factor(proj, 1080.0f);
+	const float		errors[4]	= {0.0f, 0.01f, 0.05f, 0.2f};
+	vector<float>	distances(count);
+	vector<uint8>	levels(count);
+	for (uint32 i = 0; i < count; i++)
+		distances[i] = ctx.get_random().range(1.0f, 800.0f);
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		for (uint32 i = 0; i < count; i++)
+			levels[i] = lod_selector::select(errors, 4, levels[i], distances[i], proj_factor);
+	});
+}
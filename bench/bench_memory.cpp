@@ -0,0 +1,462 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "bench.hpp"
+#include "memory/chunk_allocator.hpp"
+#include "memory/pool_allocator16.hpp"
+#include "memory/sparse_set16.hpp"
+#include "memory/ring_allocator.hpp"
+#include "memory/range_allocator.hpp"
+#include <algorithm>
+
+using namespace SFG;
+using namespace SFG::bench;
+
+namespace
+{
+	struct bench_item
+	{
+		float  value[7] = {};
+		uint32 id		= 0;
+	};
+
+	void shuffle(vector<uint32>& indices, bench_random& rnd)
+	{
+		for (uint32 i = static_cast<uint32>(indices.size()); i > 1; i--)
+			std::swap(indices[i - 1], indices[rnd.next(i)]);
+	}
+
+	vector<uint32> make_order(uint32 count, bench_random& rnd)
+	{
+		vector<uint32> order(count);
+		for (uint32 i = 0; i < count; i++)
+			order[i] = i;
+		shuffle(order, rnd);
+		return order;
+	}
+
+	/// The address ordered first fit list chunk_allocator32 used before, kept to compare against.
+	class first_fit_allocator
+	{
+	public:
+		void init(uint32 total_size)
+		{
+			_free.resize(0);
+			_free.push_back({.head = 0, .size = total_size});
+		}
+
+		chunk_handle32 allocate(uint32 size)
+		{
+			for (auto it = _free.begin(); it != _free.end(); ++it)
+			{
+				if (it->size < size)
+					continue;
+
+				const chunk_handle32 allocated = {.head = it->head, .size = size};
+				it->head += size;
+				it->size -= size;
+				if (it->size == 0)
+					_free.erase(it);
+				return allocated;
+			}
+
+			return {};
+		}
+
+		void free(chunk_handle32 handle)
+		{
+			auto it = std::lower_bound(_free.begin(), _free.end(), handle, [](const chunk_handle32& a, const chunk_handle32& b) { return a.head < b.head; });
+
+			const bool merge_prev = it != _free.begin() && (it - 1)->head + (it - 1)->size == handle.head;
+			const bool merge_next = it != _free.end() && handle.head + handle.size == it->head;
+
+			if (merge_prev && merge_next)
+			{
+				(it - 1)->size += handle.size + it->size;
+				_free.erase(it);
+			}
+			else if (merge_prev)
+				(it - 1)->size += handle.size;
+			else if (merge_next)
+			{
+				it->head = handle.head;
+				it->size += handle.size;
+			}
+			else
+				_free.insert(it, handle);
+		}
+
+	private:
+		vector<chunk_handle32> _free;
+	};
+
+	/// Steady state mix, every step frees a random live block & allocates a new one of random size.
+	struct churn_fixture
+	{
+		vector<uint32> sizes;
+		vector<uint32> victims;
+
+		churn_fixture(uint32 count, bench_random& rnd)
+		{
+			sizes.resize(count * 2);
+			victims.resize(count);
+			for (uint32& s : sizes)
+				s = 16 + rnd.next(1009);
+			for (uint32& v : victims)
+				v = rnd.next(count);
+		}
+	};
+
+#define BENCH_OCCUPANCY_SLOTS 16384
+}
+
+// allocates size blocks of 16 - 1024 bytes, frees them in random order.
+SFG_BENCH(memory, chunk_allocator32_allocate_free, 1024, 16384)
+{
+	const uint32   count = ctx.get_size();
+	vector<uint32> sizes(count);
+	for (uint32 i = 0; i < count; i++)
+		sizes[i] = 16 + ctx.get_random().next(1009);
+	const vector<uint32> order = make_order(count, ctx.get_random());
+
+	chunk_allocator32 alloc;
+	alloc.init(static_cast<size_t>(count) * 1280, false);
+	vector<chunk_handle32> handles(count);
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		for (uint32 i = 0; i < count; i++)
+			handles[i] = alloc.allocate<uint8>(sizes[i]);
+		for (uint32 i = 0; i < count; i++)
+			alloc.free(handles[order[i]]);
+	});
+
+	alloc.uninit();
+}
+
+SFG_BENCH(memory, first_fit_allocate_free, 1024, 16384)
+{
+	const uint32   count = ctx.get_size();
+	vector<uint32> sizes(count);
+	for (uint32 i = 0; i < count; i++)
+		sizes[i] = 16 + ctx.get_random().next(1009);
+	const vector<uint32> order = make_order(count, ctx.get_random());
+
+	first_fit_allocator	   alloc;
+	vector<chunk_handle32> handles(count);
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		alloc.init(count * 1280);
+		for (uint32 i = 0; i < count; i++)
+			handles[i] = alloc.allocate(sizes[i]);
+		for (uint32 i = 0; i < count; i++)
+			alloc.free(handles[order[i]]);
+	});
+}
+
+// size live blocks, then size steps of free one at random & allocate another. Fragments the free space the way streaming does.
+SFG_BENCH(memory, chunk_allocator32_churn, 1024, 16384)
+{
+	const uint32		count = ctx.get_size();
+	const churn_fixture fixture(count, ctx.get_random());
+
+	chunk_allocator32 alloc;
+	alloc.init(static_cast<size_t>(count) * 2560, false);
+	vector<chunk_handle32> handles(count);
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		for (uint32 i = 0; i < count; i++)
+			handles[i] = alloc.allocate<uint8>(fixture.sizes[i]);
+		for (uint32 i = 0; i < count; i++)
+		{
+			chunk_handle32& h = handles[fixture.victims[i]];
+			alloc.free(h);
+			h = alloc.allocate<uint8>(fixture.sizes[count + i]);
+		}
+		for (const chunk_handle32& h : handles)
+			alloc.free(h);
+	});
+
+	alloc.uninit();
+}
+
+SFG_BENCH(memory, first_fit_churn, 1024, 16384)
+{
+	const uint32		count = ctx.get_size();
+	const churn_fixture fixture(count, ctx.get_random());
+
+	first_fit_allocator	   alloc;
+	vector<chunk_handle32> handles(count);
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		alloc.init(count * 2560);
+		for (uint32 i = 0; i < count; i++)
+			handles[i] = alloc.allocate(fixture.sizes[i]);
+		for (uint32 i = 0; i < count; i++)
+		{
+			chunk_handle32& h = handles[fixture.victims[i]];
+			alloc.free(h);
+			h = alloc.allocate(fixture.sizes[count + i]);
+		}
+		for (const chunk_handle32& h : handles)
+			alloc.free(h);
+	});
+}
+
+SFG_BENCH(memory, pool_allocator16_allocate_free, 1024, 16384)
+{
+	const uint32		 count = ctx.get_size() < UINT16_MAX - 1 ? ctx.get_size() : UINT16_MAX - 1;
+	const vector<uint32> order = make_order(count, ctx.get_random());
+
+	pool_allocator16 pool;
+	pool.init<bench_item>(count);
+	vector<pool_handle16> handles(count);
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		for (uint32 i = 0; i < count; i++)
+			handles[i] = pool.allocate<bench_item>();
+		for (uint32 i = 0; i < count; i++)
+			pool.free<bench_item>(handles[order[i]]);
+	});
+
+	pool.uninit();
+}
+
+// iteration over a half freed pool, skips dead slots & goes through handles.
+SFG_BENCH(memory, pool_allocator16_iterate_half, 1024, 16384, 60000)
+{
+	const uint32 count = ctx.get_size() < UINT16_MAX - 1 ? ctx.get_size() : UINT16_MAX - 1;
+
+	pool_allocator16 pool;
+	pool.init<bench_item>(count);
+	vector<pool_handle16> handles(count);
+	for (uint32 i = 0; i < count; i++)
+	{
+		handles[i]						 = pool.allocate<bench_item>();
+		pool.get<bench_item>(handles[i]).id = i;
+	}
+
+	const vector<uint32> order = make_order(count, ctx.get_random());
+	for (uint32 i = 0; i < count / 2; i++)
+		pool.free<bench_item>(handles[order[i]]);
+
+	ctx.set_items(count - count / 2);
+	ctx.run([&]() {
+		uint32 sum = 0;
+		for (pool_handle16 h : pool)
+			sum += pool.get<bench_item>(h).id;
+		keep(sum);
+	});
+
+	pool.uninit();
+}
+
+// same occupancy as pool_allocator16_iterate_half, walks the packed array.
+SFG_BENCH(memory, sparse_set16_iterate_half, 1024, 16384, 60000)
+{
+	const uint32 count = ctx.get_size() < UINT16_MAX - 1 ? ctx.get_size() : UINT16_MAX - 1;
+
+	sparse_set16 set;
+	set.init<bench_item>(count);
+	vector<pool_handle16> handles(count);
+	for (uint32 i = 0; i < count; i++)
+	{
+		handles[i]						= set.allocate<bench_item>();
+		set.get<bench_item>(handles[i]).id = i;
+	}
+
+	const vector<uint32> order = make_order(count, ctx.get_random());
+	for (uint32 i = 0; i < count / 2; i++)
+		set.free<bench_item>(handles[order[i]]);
+
+	ctx.set_items(set.get_count());
+	ctx.run([&]() {
+		const bench_item* items = set.get_dense<bench_item>();
+		const uint16	  n		= set.get_count();
+		uint32			  sum	= 0;
+		for (uint16 i = 0; i < n; i++)
+			sum += items[i].id;
+		keep(sum);
+	});
+
+	set.uninit();
+}
+
+// size is the percent of 16K slots still alive after random frees, for both trait storages.
+SFG_BENCH(memory, pool_allocator16_iterate_occupancy, 10, 50, 90)
+{
+	const uint32 count = BENCH_OCCUPANCY_SLOTS;
+	const uint32 freed = count - count * ctx.get_size() / 100;
+
+	pool_allocator16 pool;
+	pool.init<bench_item>(count);
+	vector<pool_handle16> handles(count);
+	for (uint32 i = 0; i < count; i++)
+	{
+		handles[i]						 = pool.allocate<bench_item>();
+		pool.get<bench_item>(handles[i]).id = i;
+	}
+
+	const vector<uint32> order = make_order(count, ctx.get_random());
+	for (uint32 i = 0; i < freed; i++)
+		pool.free<bench_item>(handles[order[i]]);
+
+	ctx.set_items(count - freed);
+	ctx.run([&]() {
+		uint32 sum = 0;
+		for (pool_handle16 h : pool)
+			sum += pool.get<bench_item>(h).id;
+		keep(sum);
+	});
+
+	pool.uninit();
+}
+
+SFG_BENCH(memory, sparse_set16_iterate_occupancy, 10, 50, 90)
+{
+	const uint32 count = BENCH_OCCUPANCY_SLOTS;
+	const uint32 freed = count - count * ctx.get_size() / 100;
+
+	sparse_set16 set;
+	set.init<bench_item>(count);
+	vector<pool_handle16> handles(count);
+	for (uint32 i = 0; i < count; i++)
+	{
+		handles[i]						= set.allocate<bench_item>();
+		set.get<bench_item>(handles[i]).id = i;
+	}
+
+	const vector<uint32> order = make_order(count, ctx.get_random());
+	for (uint32 i = 0; i < freed; i++)
+		set.free<bench_item>(handles[order[i]]);
+
+	ctx.set_items(set.get_count());
+	ctx.run([&]() {
+		const bench_item* items = set.get_dense<bench_item>();
+		const uint16	  n		= set.get_count();
+		uint32			  sum	= 0;
+		for (uint16 i = 0; i < n; i++)
+			sum += items[i].id;
+		keep(sum);
+	});
+
+	set.uninit();
+}
+
+SFG_BENCH(memory, sparse_set16_allocate_free, 1024, 16384)
+{
+	const uint32		 count = ctx.get_size() < UINT16_MAX - 1 ? ctx.get_size() : UINT16_MAX - 1;
+	const vector<uint32> order = make_order(count, ctx.get_random());
+
+	sparse_set16 set;
+	set.init<bench_item>(count);
+	vector<pool_handle16> handles(count);
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		for (uint32 i = 0; i < count; i++)
+			handles[i] = set.allocate<bench_item>();
+		for (uint32 i = 0; i < count; i++)
+			set.free<bench_item>(handles[order[i]]);
+	});
+
+	set.uninit();
+}
+
+// a frame of size allocations of 64 - 4096 bytes, the gpu trails two frames behind.
+SFG_BENCH(memory, ring_allocator_frame, 256, 4096)
+{
+	const uint32   count = ctx.get_size();
+	vector<uint32> sizes(count);
+	size_t		   frame_bytes = 0;
+	for (uint32 i = 0; i < count; i++)
+	{
+		sizes[i] = 64 + ctx.get_random().next(4033);
+		frame_bytes += sizes[i] + 256;
+	}
+
+	ring_allocator ring;
+	ring.init(frame_bytes * 4);
+	uint64 fence = 0;
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		size_t last = 0;
+		for (uint32 i = 0; i < count; i++)
+			last = ring.allocate(sizes[i], 256);
+		keep(last);
+		fence++;
+		ring.end_frame(fence);
+		if (fence > 2)
+			ring.retire(fence - 2);
+	});
+}
+
+// allocation churn on a fragmented range, every other range of the fixture is free.
+SFG_BENCH(memory, range_allocator_churn, 1024, 8192)
+{
+	const uint32   count = ctx.get_size();
+	vector<uint32> sizes(count);
+	uint64		   total = 0;
+	for (uint32 i = 0; i < count; i++)
+	{
+		sizes[i] = 256 + ctx.get_random().next(16384);
+		total += sizes[i];
+	}
+
+	range_allocator alloc;
+	alloc.init(static_cast<uint32>(total * 2));
+	vector<uint32> ids(count);
+	for (uint32 i = 0; i < count; i++)
+		ids[i] = alloc.allocate(sizes[i], 16);
+	for (uint32 i = 0; i < count; i += 2)
+		alloc.free(ids[i]);
+
+	const uint32   churn = count / 2;
+	vector<uint32> churn_ids(churn);
+
+	ctx.set_items(churn);
+	ctx.run([&]() {
+		for (uint32 i = 0; i < churn; i++)
+			churn_ids[i] = alloc.allocate(sizes[i * 2], 16);
+		for (uint32 i = 0; i < churn; i++)
+			alloc.free(churn_ids[i]);
+	});
+
+	alloc.uninit();
+}
+
+// includes building the fragmented state, defragment() needs a fresh one every time.
+SFG_BENCH(memory, range_allocator_fragment_defragment, 1024, 8192)
+{
+	const uint32   count = ctx.get_size();
+	vector<uint32> sizes(count);
+	uint64		   total = 0;
+	for (uint32 i = 0; i < count; i++)
+	{
+		sizes[i] = 256 + ctx.get_random().next(16384);
+		total += sizes[i];
+	}
+	const vector<uint32> order = make_order(count, ctx.get_random());
+
+	vector<uint32>					  ids(count);
+	vector<range_allocator::relocation> relocations;
+	relocations.reserve(count);
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		range_allocator alloc;
+		alloc.init(static_cast<uint32>(total + total / 4));
+		for (uint32 i = 0; i < count; i++)
+			ids[i] = alloc.allocate(sizes[i], 16);
+		for (uint32 i = 0; i < count / 2; i++)
+			alloc.free(ids[order[i]]);
+
+		relocations.resize(0);
+		keep(alloc.defragment(UINT32_MAX, relocations));
+		alloc.uninit();
+	});
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "bench.hpp"
+#include "thread/job_system.hpp"
+#include <thread>
+
+using namespace SFG;
+using namespace SFG::bench;
+
+namespace
+{
+	struct weighted_work
+	{
+		vector<uint32>	costs;
+		std::thread::id submitter;
+		atomic<uint32>	sink   = 0;
+		atomic<uint64>	remote = 0;
+		atomic<uint64>	total  = 0;
+	};
+
+	/// Stands in for a job body, rounds of an lcg.
+	uint32 spin(uint32 seed, uint32 rounds)
+	{
+		for (uint32 i = 0; i < rounds; i++)
+			seed = seed * 1664525u + 1013904223u;
+		return seed;
+	}
+
+	void empty_job(void* user_data, uint32 start, uint32 end)
+	{
+	}
+
+	void weighted_job(void* user_data, uint32 start, uint32 end)
+	{
+		weighted_work& w = *static_cast<weighted_work*>(user_data);
+		for (uint32 i = start; i < end; i++)
+			w.sink.fetch_add(spin(i, w.costs[i]), std::memory_order_relaxed);
+
+		w.remote.fetch_add(std::this_thread::get_id() != w.submitter ? end - start : 0, std::memory_order_relaxed);
+		w.total.fetch_add(end - start, std::memory_order_relaxed);
+	}
+
+#define BENCH_JOB_ROUNDS 256
+#define BENCH_JOB_HEAVY	 64
+}
+
+// empty jobs submitted & drained from the calling thread, the cost of the queues themselves.
+SFG_BENCH(thread, job_submit_wait, 64, 512)
+{
+	job_system&		 js	   = job_system::get();
+	const uint32	 count = ctx.get_size();
+	vector<job_desc> descs(count, {.function = &empty_job});
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		job_counter counter;
+		js.submit(descs.data(), count, &counter);
+		js.wait(&counter);
+	});
+}
+
+// every job is pushed from the calling thread and one in 16 costs 64x the rest. Counter is the share of jobs other threads stole.
+SFG_BENCH(thread, job_steal_imbalanced, 64, 512)
+{
+	job_system&	  js	= job_system::get();
+	const uint32  count = ctx.get_size();
+	weighted_work work;
+	work.submitter = std::this_thread::get_id();
+	work.costs.resize(count);
+	for (uint32 i = 0; i < count; i++)
+		work.costs[i] = ctx.get_random().next(16) == 0 ? BENCH_JOB_ROUNDS * BENCH_JOB_HEAVY : BENCH_JOB_ROUNDS;
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		job_counter counter;
+		js.submit_range(&weighted_job, &work, count, 1, &counter);
+		js.wait(&counter);
+	});
+
+	const uint64 total = work.total.load();
+	ctx.set_counter("stolen_share", total == 0 ? 0.0 : static_cast<double>(work.remote.load()) / static_cast<double>(total));
+	ctx.set_counter("workers", js.get_worker_count());
+	keep(work.sink.load());
+}
+
+// a light body per index, the batch size the engine's own callers use.
+SFG_BENCH(thread, job_parallel_for, 65536, 1048576)
+{
+	job_system&	  js	= job_system::get();
+	const uint32  count = ctx.get_size();
+	vector<float> values(count);
+	for (uint32 i = 0; i < count; i++)
+		values[i] = ctx.get_random().range(-1.0f, 1.0f);
+
+	ctx.set_items(count);
+	ctx.set_bytes(static_cast<uint64>(count) * sizeof(float) * 2);
+	ctx.run([&]() {
+		js.parallel_for(count, 1024, [&](uint32 i) { values[i] = values[i] * 0.5f + 0.25f; });
+		keep(values[0]);
+	});
+}
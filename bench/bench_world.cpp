@@ -0,0 +1,455 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "bench.hpp"
+#include "world/world.hpp"
+#include "world/entity_manager.hpp"
+#include "world/system_scheduler.hpp"
+#include "resources/animation.hpp"
+#include "resources/animation_raw.hpp"
+#include "memory/chunk_allocator.hpp"
+#include "common/profiler.hpp"
+
+using namespace SFG;
+using namespace SFG::bench;
+
+namespace
+{
+	struct bench_trait_a
+	{
+		static constexpr uint32 TYPE_INDEX = trait_types::trait_type_engine_max;
+
+		trait_meta meta;
+		float	   value = 0.0f;
+	};
+
+	struct bench_trait_b
+	{
+		static constexpr uint32 TYPE_INDEX = trait_types::trait_type_engine_max + 1;
+
+		trait_meta meta;
+		float	   value = 0.0f;
+	};
+
+	/// Random forest, every entity after the first few picks an earlier one as parent so depths stay around log(count).
+	void make_hierarchy(entity_manager& em, vector<entity_handle>& entities, uint32 count, bench_random& rnd)
+	{
+		entities.resize(count);
+		for (uint32 i = 0; i < count; i++)
+		{
+			entities[i] = em.create_entity("bench");
+			em.set_entity_position(entities[i], vector3(rnd.range(-10.0f, 10.0f), rnd.range(-10.0f, 10.0f), rnd.range(-10.0f, 10.0f)));
+			em.set_entity_rotation(entities[i], quat::from_euler(rnd.range(-180.0f, 180.0f), rnd.range(-180.0f, 180.0f), 0.0f));
+			em.set_entity_aabb(entities[i], aabb(vector3(-1.0f, -1.0f, -1.0f), vector3(1.0f, 1.0f, 1.0f)));
+
+			if (i >= 16)
+				em.add_child(entities[rnd.next(i)], entities[i]);
+		}
+		em.update_transforms();
+	}
+
+	/// Single chain, every entity is the child of the previous one so depth equals count.
+	void make_chain(entity_manager& em, vector<entity_handle>& entities, uint32 count)
+	{
+		entities.resize(count);
+		for (uint32 i = 0; i < count; i++)
+		{
+			entities[i] = em.create_entity("bench");
+			em.set_entity_position(entities[i], vector3(0.0f, 1.0f, 0.0f));
+			if (i != 0)
+				em.add_child(entities[i - 1], entities[i]);
+		}
+		em.update_transforms();
+	}
+
+	/// One root with every other entity as its direct child.
+	void make_wide(entity_manager& em, vector<entity_handle>& entities, uint32 count)
+	{
+		entities.resize(count);
+		for (uint32 i = 0; i < count; i++)
+		{
+			entities[i] = em.create_entity("bench");
+			em.set_entity_position(entities[i], vector3(static_cast<float>(i), 0.0f, 0.0f));
+			if (i != 0)
+				em.add_child(entities[0], entities[i]);
+		}
+		em.update_transforms();
+	}
+
+	struct system_work
+	{
+		vector<matrix4x3> locals;
+		vector<matrix4x3> out;
+	};
+
+	void run_system_work(world& w, float dt, void* user_data)
+	{
+		system_work& work  = *static_cast<system_work*>(user_data);
+		const uint32 count = static_cast<uint32>(work.locals.size());
+		work.out[0]		   = work.locals[0];
+		for (uint32 i = 1; i < count; i++)
+			work.out[i] = work.out[i - 1] * work.locals[i];
+	}
+
+	void make_systems(system_scheduler& scheduler, vector<system_work>& works, uint32 count, uint64 writes, bench_random& rnd)
+	{
+		works.resize(count);
+		for (uint32 i = 0; i < count; i++)
+		{
+			system_work& work = works[i];
+			work.locals.resize(1024);
+			work.out.resize(1024);
+			for (matrix4x3& m : work.locals)
+				m = matrix4x3::transform(vector3(rnd.range(-1.0f, 1.0f), 0.0f, 0.0f), quat::from_euler(0.0f, rnd.range(-5.0f, 5.0f), 0.0f), vector3::one);
+
+			scheduler.add_system({
+				.name	   = "bench",
+				.function  = &run_system_work,
+				.user_data = &work,
+				.reads	   = SYSTEM_ACCESS_TRANSFORMS,
+				.writes	   = writes,
+			});
+		}
+	}
+
+	template <typename CHANNEL, typename RAW, typename KEYFRAME, typename VALUE>
+	void make_channels(vector<CHANNEL>& channels, chunk_allocator32& alloc, uint32 count, uint32 keyframes, animation_interpolation interpolation, bench_random& rnd, VALUE (*make_value)(bench_random&))
+	{
+		channels.resize(count);
+		for (uint32 i = 0; i < count; i++)
+		{
+			RAW raw			  = {};
+			raw.interpolation = interpolation;
+			raw.node_index	  = static_cast<int16>(i);
+
+			if constexpr (std::is_same_v<KEYFRAME, animation_keyframe_v3> || std::is_same_v<KEYFRAME, animation_keyframe_q>)
+			{
+				raw.keyframes.resize(keyframes);
+				for (uint32 k = 0; k < keyframes; k++)
+					raw.keyframes[k] = {.time = static_cast<float>(k) / 30.0f, .value = make_value(rnd)};
+			}
+			else
+			{
+				raw.keyframes_spline.resize(keyframes);
+				for (uint32 k = 0; k < keyframes; k++)
+					raw.keyframes_spline[k] = {.time = static_cast<float>(k) / 30.0f, .in_tangent = make_value(rnd), .value = make_value(rnd), .out_tangent = make_value(rnd)};
+			}
+
+			channels[i].create_from_raw(raw, alloc);
+		}
+	}
+
+	vector3 make_position(bench_random& rnd)
+	{
+		return vector3(rnd.range(-1.0f, 1.0f), rnd.range(-1.0f, 1.0f), rnd.range(-1.0f, 1.0f));
+	}
+
+	quat make_rotation(bench_random& rnd)
+	{
+		return quat::from_euler(rnd.range(-180.0f, 180.0f), rnd.range(-180.0f, 180.0f), rnd.range(-180.0f, 180.0f));
+	}
+
+#define BENCH_ANIMATION_KEYFRAMES 64 // 30 fps, a little over two seconds.
+}
+
+// creates size named entities & destroys them again. Storage grows in pages on the first call, later ones reuse freed slots.
+SFG_BENCH(world, entity_manager_create_destroy, 65536, 1048576)
+{
+	const uint32		  count = ctx.get_size();
+	world				  w;
+	entity_manager&		  em = w.get_entity_manager();
+	vector<entity_handle> entities(count);
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		for (uint32 i = 0; i < count; i++)
+			entities[i] = em.create_entity("bench");
+		for (uint32 i = count; i > 0; i--)
+			em.destroy_entity(entities[i - 1]);
+	});
+}
+
+// every entity moved, then the level by level hierarchy update.
+SFG_BENCH(world, entity_manager_update_transforms, 1024, 16384, 65536)
+{
+	const uint32		  count = ctx.get_size();
+	world				  w;
+	entity_manager&		  em = w.get_entity_manager();
+	vector<entity_handle> entities;
+	make_hierarchy(em, entities, count, ctx.get_random());
+
+	float offset = 0.0f;
+	ctx.set_items(count);
+	ctx.run([&]() {
+		offset += 0.001f;
+		for (entity_handle e : entities)
+			em.set_entity_position(e, vector3(offset, 0.0f, 0.0f));
+		em.update_transforms();
+	});
+}
+
+// roots only moved, children update because their parent changed.
+SFG_BENCH(world, entity_manager_update_transforms_roots, 16384, 65536)
+{
+	const uint32		  count = ctx.get_size();
+	world				  w;
+	entity_manager&		  em = w.get_entity_manager();
+	vector<entity_handle> entities;
+	make_hierarchy(em, entities, count, ctx.get_random());
+
+	float offset = 0.0f;
+	ctx.set_items(count);
+	ctx.run([&]() {
+		offset += 0.001f;
+		for (uint32 i = 0; i < 16; i++)
+			em.set_entity_position(entities[i], vector3(offset, 0.0f, 0.0f));
+		em.update_transforms();
+	});
+}
+
+SFG_BENCH(world, entity_manager_get_transform_abs, 16384)
+{
+	const uint32		  count = ctx.get_size();
+	world				  w;
+	entity_manager&		  em = w.get_entity_manager();
+	vector<entity_handle> entities;
+	make_hierarchy(em, entities, count, ctx.get_random());
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		float sum = 0.0f;
+		for (entity_handle e : entities)
+			sum += em.get_entity_transform_abs(e).get_translation().x;
+		keep(sum);
+	});
+}
+
+// root of a chain moved, size is the depth.
+SFG_BENCH(world, entity_manager_update_transforms_deep, 1024, 16384, 65536)
+{
+	const uint32		  count = ctx.get_size();
+	world				  w;
+	entity_manager&		  em = w.get_entity_manager();
+	vector<entity_handle> entities;
+	make_chain(em, entities, count);
+
+	float offset = 0.0f;
+	ctx.set_items(count);
+	ctx.run([&]() {
+		offset += 0.001f;
+		em.set_entity_position(entities[0], vector3(offset, 0.0f, 0.0f));
+		em.update_transforms();
+	});
+}
+
+// root of a single level moved, size is the child count.
+SFG_BENCH(world, entity_manager_update_transforms_wide, 1024, 16384, 65536)
+{
+	const uint32		  count = ctx.get_size();
+	world				  w;
+	entity_manager&		  em = w.get_entity_manager();
+	vector<entity_handle> entities;
+	make_wide(em, entities, count);
+
+	float offset = 0.0f;
+	ctx.set_items(count);
+	ctx.run([&]() {
+		offset += 0.001f;
+		em.set_entity_position(entities[0], vector3(offset, 0.0f, 0.0f));
+		em.update_transforms();
+	});
+}
+
+// root of a chain moved, then every abs transform read back without update_transforms().
+SFG_BENCH(world, entity_manager_get_transform_abs_deep, 1024, 16384)
+{
+	const uint32		  count = ctx.get_size();
+	world				  w;
+	entity_manager&		  em = w.get_entity_manager();
+	vector<entity_handle> entities;
+	make_chain(em, entities, count);
+
+	float offset = 0.0f;
+	ctx.set_items(count);
+	ctx.run([&]() {
+		offset += 0.001f;
+		em.set_entity_position(entities[0], vector3(offset, 0.0f, 0.0f));
+
+		float sum = 0.0f;
+		for (entity_handle e : entities)
+			sum += em.get_entity_transform_abs(e).get_translation().y;
+		keep(sum);
+	});
+}
+
+// a chain is moved between two parents, the whole subtree changes level on each call.
+SFG_BENCH(world, entity_manager_reparent_deep, 1024, 16384, 65536)
+{
+	const uint32		  count = ctx.get_size();
+	world				  w;
+	entity_manager&		  em = w.get_entity_manager();
+	vector<entity_handle> entities;
+	make_chain(em, entities, count);
+
+	// second parent sits one level lower so every move shifts the chain depth.
+	const entity_handle parents[2] = {em.create_entity("bench"), em.create_entity("bench")};
+	em.add_child(parents[0], parents[1]);
+
+	uint32 flip = 0;
+	ctx.set_items(count);
+	ctx.run([&]() {
+		flip ^= 1;
+		em.add_child(parents[flip], entities[0]);
+	});
+}
+
+// every entity has a, half have b, query<a, b> walks b's storage.
+SFG_BENCH(world, entity_manager_query, 1024, 16384, 60000)
+{
+	const uint32 count = ctx.get_size() < UINT16_MAX - 1 ? ctx.get_size() : UINT16_MAX - 1;
+	world		 w;
+	entity_manager& em = w.get_entity_manager();
+	em.init_trait_storage<bench_trait_a>(count);
+	em.init_trait_storage<bench_trait_b>(count);
+
+	for (uint32 i = 0; i < count; i++)
+	{
+		const entity_handle e = em.create_entity("bench");
+		em.get_trait<bench_trait_a>(em.add_trait<bench_trait_a>(e)).value = ctx.get_random().range(0.0f, 1.0f);
+		if (ctx.get_random().next(2) == 0)
+			em.add_trait<bench_trait_b>(e);
+	}
+
+	ctx.set_items(em.get_trait_storage<bench_trait_b>().get_count());
+	ctx.run([&]() {
+		em.query<bench_trait_a, bench_trait_b>([](entity_handle e, bench_trait_a& a, bench_trait_b& b) { b.value += a.value; });
+	});
+}
+
+// size is the system count, none of them conflict so they share one wave.
+SFG_BENCH(world, system_scheduler_parallel, 4, 16, 64)
+{
+	world				w;
+	system_scheduler	scheduler;
+	vector<system_work> works;
+	make_systems(scheduler, works, ctx.get_size(), 0, ctx.get_random());
+
+	ctx.set_items(ctx.get_size());
+	ctx.run([&]() { scheduler.execute(w, 0.016f); });
+}
+
+// every system writes what the others read, one wave each.
+SFG_BENCH(world, system_scheduler_serial, 4, 16, 64)
+{
+	world				w;
+	system_scheduler	scheduler;
+	vector<system_work> works;
+	make_systems(scheduler, works, ctx.get_size(), SYSTEM_ACCESS_TRANSFORMS, ctx.get_random());
+
+	ctx.set_items(ctx.get_size());
+	ctx.run([&]() { scheduler.execute(w, 0.016f); });
+}
+
+// size is the channel count, one sample of every channel per call.
+SFG_BENCH(world, animation_sample_position_linear, 64, 1024)
+{
+	const uint32				 count = ctx.get_size();
+	chunk_allocator32			 alloc;
+	vector<animation_channel_v3> channels;
+	alloc.init(static_cast<size_t>(count) * BENCH_ANIMATION_KEYFRAMES * sizeof(animation_keyframe_v3) * 2);
+	make_channels<animation_channel_v3, animation_channel_v3_raw, animation_keyframe_v3>(channels, alloc, count, BENCH_ANIMATION_KEYFRAMES, animation_interpolation::linear, ctx.get_random(), &make_position);
+
+	float time = 0.0f;
+	ctx.set_items(count);
+	ctx.run([&]() {
+		time = time > 2.0f ? 0.0f : time + 0.016f;
+		vector3 sum = vector3::zero;
+		for (const animation_channel_v3& ch : channels)
+			sum += ch.sample(time, alloc);
+		keep(sum);
+	});
+
+	for (animation_channel_v3& ch : channels)
+		ch.destroy(alloc);
+	alloc.uninit();
+}
+
+SFG_BENCH(world, animation_sample_position_spline, 64, 1024)
+{
+	const uint32				 count = ctx.get_size();
+	chunk_allocator32			 alloc;
+	vector<animation_channel_v3> channels;
+	alloc.init(static_cast<size_t>(count) * BENCH_ANIMATION_KEYFRAMES * sizeof(animation_keyframe_v3_spline) * 2);
+	make_channels<animation_channel_v3, animation_channel_v3_raw, animation_keyframe_v3_spline>(channels, alloc, count, BENCH_ANIMATION_KEYFRAMES, animation_interpolation::cubic_spline, ctx.get_random(), &make_position);
+
+	float time = 0.0f;
+	ctx.set_items(count);
+	ctx.run([&]() {
+		time = time > 2.0f ? 0.0f : time + 0.016f;
+		vector3 sum = vector3::zero;
+		for (const animation_channel_v3& ch : channels)
+			sum += ch.sample(time, alloc);
+		keep(sum);
+	});
+
+	for (animation_channel_v3& ch : channels)
+		ch.destroy(alloc);
+	alloc.uninit();
+}
+
+SFG_BENCH(world, animation_sample_rotation_slerp, 64, 1024)
+{
+	const uint32				count = ctx.get_size();
+	chunk_allocator32			alloc;
+	vector<animation_channel_q> channels;
+	alloc.init(static_cast<size_t>(count) * BENCH_ANIMATION_KEYFRAMES * sizeof(animation_keyframe_q) * 2);
+	make_channels<animation_channel_q, animation_channel_q_raw, animation_keyframe_q>(channels, alloc, count, BENCH_ANIMATION_KEYFRAMES, animation_interpolation::linear, ctx.get_random(), &make_rotation);
+
+	float time = 0.0f;
+	ctx.set_items(count);
+	ctx.run([&]() {
+		time	 = time > 2.0f ? 0.0f : time + 0.016f;
+		float w = 0.0f;
+		for (const animation_channel_q& ch : channels)
+			w += ch.sample(time, alloc).w;
+		keep(w);
+	});
+
+	for (animation_channel_q& ch : channels)
+		ch.destroy(alloc);
+	alloc.uninit();
+}
+
+#ifdef ENABLE_PROFILER
+
+// size zones per call, nothing is recorded outside of a capture.
+SFG_BENCH(world, profiler_zone_idle, 1024)
+{
+	const uint32 count = ctx.get_size();
+	ctx.set_items(count);
+	ctx.run([&]() {
+		for (uint32 i = 0; i < count; i++)
+		{
+			SFG_PROFILE_ZONE("bench");
+			clobber();
+		}
+	});
+}
+
+SFG_BENCH(world, profiler_zone_capturing, 1024)
+{
+	const uint32 count = ctx.get_size();
+	profiler::get().begin_capture();
+
+	ctx.set_items(count);
+	ctx.run([&]() {
+		for (uint32 i = 0; i < count; i++)
+		{
+			SFG_PROFILE_ZONE("bench");
+			clobber();
+		}
+	});
+
+	profiler::get().end_capture();
+}
+
+#endif
@@ -0,0 +1,103 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "bench.hpp"
+#include "thread/job_system.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace SFG;
+using namespace SFG::bench;
+
+namespace
+{
+	void print_usage()
+	{
+		std::printf("usage: StakeforgeBench [options]\n"
+					"  --filter <text>    only cases whose group/name contains text\n"
+					"  --scale <factor>   multiplies every case's input sizes, default 1\n"
+					"  --repeat <count>   timed samples per case, default %u\n"
+					"  --min-time <s>     minimum seconds per sample, default %.3f\n"
+					"  --seed <value>     fixture seed, default %u\n"
+					"  --threads <count>  job system workers, 0 picks from the hardware, default 0\n"
+					"  --json <path>      writes the results as json\n"
+					"  --baseline <path>  prints the median change against an earlier --json output\n"
+					"  --list             prints the cases & sizes without running them\n",
+					BENCH_DEFAULT_REPEAT,
+					BENCH_DEFAULT_MIN_TIME,
+					BENCH_DEFAULT_SEED);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bench_config config = {};
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg	  = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+		if (std::strcmp(arg, "--list") == 0)
+		{
+			config.list = 1;
+			continue;
+		}
+
+		if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0)
+		{
+			print_usage();
+			return 0;
+		}
+
+		if (value == nullptr)
+		{
+			std::fprintf(stderr, "missing value for %s\n", arg);
+			print_usage();
+			return 1;
+		}
+
+		if (std::strcmp(arg, "--filter") == 0)
+			config.filter = value;
+		else if (std::strcmp(arg, "--json") == 0)
+			config.json = value;
+		else if (std::strcmp(arg, "--baseline") == 0)
+			config.baseline = value;
+		else if (std::strcmp(arg, "--scale") == 0)
+			config.scale = std::atof(value);
+		else if (std::strcmp(arg, "--min-time") == 0)
+			config.min_time = std::atof(value);
+		else if (std::strcmp(arg, "--repeat") == 0)
+			config.repeat = static_cast<uint32>(std::strtoul(value, nullptr, 10));
+		else if (std::strcmp(arg, "--seed") == 0)
+			config.seed = static_cast<uint32>(std::strtoul(value, nullptr, 0));
+		else if (std::strcmp(arg, "--threads") == 0)
+			config.threads = static_cast<uint32>(std::strtoul(value, nullptr, 10));
+		else
+		{
+			std::fprintf(stderr, "unknown option %s\n", arg);
+			print_usage();
+			return 1;
+		}
+
+		i++;
+	}
+
+	if (config.scale <= 0.0 || config.repeat == 0)
+	{
+		std::fprintf(stderr, "--scale & --repeat need to be positive\n");
+		return 1;
+	}
+
+	if (config.list)
+		return bench_registry::get().run(config);
+
+	job_system::get().init(config.threads);
+	job_system::get().register_thread();
+
+	const int result = bench_registry::get().run(config);
+
+	job_system::get().unregister_thread();
+	job_system::get().uninit();
+	return result;
+}
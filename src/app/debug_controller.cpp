@@ -24,6 +24,7 @@
 #include "data/istream.hpp"
 #include "serialization/serialization.hpp"
 #include "io/file_system.hpp"
+#include "io/mapped_file.hpp"
 #include "resources/shader_raw.hpp"
 
 #define VEKT_STRING_CSTR
@@ -93,7 +94,7 @@ namespace SFG
 				gfx.color			  = COLOR_CONSOLE_BG_OPAQUE;
 
 				vekt::text_props& tp = _vekt_data.builder->widget_get_text(w);
-				tp.font				 = _vekt_data.font_debug;
+				tp.fnt				 = _vekt_data.font_debug;
 				tp.text				 = _text_allocator.allocate("FPS: 1000");
 				_vekt_data.builder->widget_update_text(w);
 
@@ -121,7 +122,7 @@ namespace SFG
 				gfx.color			  = COLOR_CONSOLE_BG_OPAQUE;
 
 				vekt::text_props& tp = _vekt_data.builder->widget_get_text(w);
-				tp.font				 = _vekt_data.font_debug;
+				tp.fnt				 = _vekt_data.font_debug;
 				tp.text				 = _text_allocator.allocate("Main Thread (ms): 0.000000 ");
 				_vekt_data.builder->widget_update_text(w);
 
@@ -149,7 +150,7 @@ namespace SFG
 				gfx.color			  = COLOR_CONSOLE_BG_OPAQUE;
 
 				vekt::text_props& tp = _vekt_data.builder->widget_get_text(w);
-				tp.font				 = _vekt_data.font_debug;
+				tp.fnt				 = _vekt_data.font_debug;
 				tp.text				 = _text_allocator.allocate("Render Thread (ms): 0.000000 ");
 				_vekt_data.builder->widget_update_text(w);
 
@@ -177,7 +178,7 @@ namespace SFG
 				gfx.color			  = COLOR_CONSOLE_BG_OPAQUE;
 
 				vekt::text_props& tp = _vekt_data.builder->widget_get_text(w);
-				tp.font				 = _vekt_data.font_debug;
+				tp.fnt				 = _vekt_data.font_debug;
 				tp.text				 = _text_allocator.allocate("Present (ms): 0.000000 ");
 				_vekt_data.builder->widget_update_text(w);
 
@@ -205,7 +206,7 @@ namespace SFG
 				gfx.color			  = COLOR_CONSOLE_BG_OPAQUE;
 
 				vekt::text_props& tp = _vekt_data.builder->widget_get_text(w);
-				tp.font				 = _vekt_data.font_debug;
+				tp.fnt				 = _vekt_data.font_debug;
 				tp.text				 = _text_allocator.allocate("Glob Memory (mb): 0.00000");
 				_vekt_data.builder->widget_update_text(w);
 
@@ -233,7 +234,7 @@ namespace SFG
 				gfx.color			  = COLOR_CONSOLE_BG_OPAQUE;
 
 				vekt::text_props& tp = _vekt_data.builder->widget_get_text(w);
-				tp.font				 = _vekt_data.font_debug;
+				tp.fnt				 = _vekt_data.font_debug;
 				tp.text				 = _text_allocator.allocate("Gfx Memory (mb): 0.00000");
 				_vekt_data.builder->widget_update_text(w);
 
@@ -319,7 +320,7 @@ namespace SFG
 			gfx.color			  = COLOR_TEXT;
 
 			vekt::text_props& tp = _vekt_data.builder->widget_get_text(w);
-			tp.font				 = _vekt_data.font_icon;
+			tp.fnt				 = _vekt_data.font_icon;
 			tp.text				 = _text_allocator.allocate("\u0071");
 			_vekt_data.builder->widget_update_text(w);
 		}
@@ -335,7 +336,7 @@ namespace SFG
 			gfx.color			  = COLOR_TEXT;
 
 			vekt::text_props& tp = _vekt_data.builder->widget_get_text(w);
-			tp.font				 = _vekt_data.font_debug;
+			tp.fnt				 = _vekt_data.font_debug;
 			tp.text				 = _input_field.text;
 
 			_vekt_data.widget_input_text = w;
@@ -347,9 +348,9 @@ namespace SFG
 	void debug_controller::init(texture_queue* texture_queue, gfx_id global_bind_layout, const vector2ui16& screen_size)
 	{
 
-		_gfx_data.texture_queue = texture_queue;
-		_gfx_data.rt_size		= vector2ui16(screen_size.x, screen_size.y / 2);
-		_gfx_data.window_size	= vector2ui16(screen_size.x, screen_size.y);
+		_gfx_data.tq		  = texture_queue;
+		_gfx_data.rt_size	  = vector2ui16(screen_size.x, screen_size.y / 2);
+		_gfx_data.window_size = vector2ui16(screen_size.x, screen_size.y);
 
 		gfx_backend* backend = gfx_backend::get();
 
@@ -430,29 +431,17 @@ namespace SFG
 												   {.resource = pfd.rt_console, .pointer_index = upi_material_texture0, .type = binding_type::texture_binding},
 											   });
 
-			pfd.buf_gui_vtx.create_staging_hw(
-				{
-					.size		= sizeof(vekt::vertex) * 14000,
-					.flags		= resource_flags::rf_vertex_buffer | resource_flags::rf_cpu_visible,
-					.debug_name = "gui_vertex_stg",
-				},
-				{
-					.size		= sizeof(vekt::vertex) * 14000,
-					.flags		= resource_flags::rf_vertex_buffer | resource_flags::rf_gpu_only,
-					.debug_name = "gui_vertex_gpu",
-				});
+			pfd.buf_gui_vtx.create_hw({
+				.size		= sizeof(vekt::vertex) * 14000,
+				.flags		= resource_flags::rf_vertex_buffer | resource_flags::rf_gpu_only,
+				.debug_name = "gui_vertex_gpu",
+			});
 
-			pfd.buf_gui_idx.create_staging_hw(
-				{
-					.size		= sizeof(vekt::index) * 24000,
-					.flags		= resource_flags::rf_index_buffer | resource_flags::rf_cpu_visible,
-					.debug_name = "gui_index_stg",
-				},
-				{
-					.size		= sizeof(vekt::index) * 24000,
-					.flags		= resource_flags::rf_index_buffer | resource_flags::rf_gpu_only,
-					.debug_name = "gui_index_gpu",
-				});
+			pfd.buf_gui_idx.create_hw({
+				.size		= sizeof(vekt::index) * 24000,
+				.flags		= resource_flags::rf_index_buffer | resource_flags::rf_gpu_only,
+				.debug_name = "gui_index_gpu",
+			});
 		}
 
 		_vekt_data.builder		= new vekt::builder();
@@ -482,10 +471,16 @@ namespace SFG
 		// load history
 		if (file_system::exists(HISTORY_PATH))
 		{
-			istream in	 = serialization::load_from_file(HISTORY_PATH);
-			uint8	size = 0;
-			in >> _console_state;
-			in >> size;
+			// read in place from the mapping when stored, the texts are copied into the text allocator.
+			mapped_file file;
+			istream		in;
+			uint8		size = 0;
+
+			if (serialization::load_from_file_mapped(HISTORY_PATH, file, in))
+			{
+				in >> _console_state;
+				in >> size;
+			}
 
 			set_console_visible(_console_state == console_state::visible);
 
@@ -507,6 +502,12 @@ namespace SFG
 
 	void debug_controller::uninit()
 	{
+		log::instance().remove_listener(TO_SIDC("debug_controller"));
+
+		log_event ev = {};
+		while (_log_events.try_dequeue(ev))
+			SFG_FREE((void*)ev.text);
+
 		// save history
 		{
 			const uint8 history_sz = static_cast<uint8>(_input_field.history.size());
@@ -552,25 +553,20 @@ namespace SFG
 			backend->destroy_bind_group(pfd.bind_group_fullscreen);
 			backend->unmap_resource(pfd.buf_gui_pass_view.get_hw_gpu());
 			backend->unmap_resource(pfd.buf_fullscreen_pass_view.get_hw_gpu());
-			backend->unmap_resource(pfd.buf_gui_vtx.get_hw_staging());
-			backend->unmap_resource(pfd.buf_gui_idx.get_hw_staging());
 			pfd.buf_gui_pass_view.destroy();
 			pfd.buf_gui_vtx.destroy();
 			pfd.buf_gui_idx.destroy();
 			pfd.buf_fullscreen_pass_view.destroy();
 		}
-
-		log::instance().remove_listener(TO_SIDC("debug_controller"));
 	}
 
 	void debug_controller::upload(buffer_queue& q, uint8 frame_index)
 	{
-		_gfx_data.frame_index = frame_index;
+		_gfx_data.frame_index  = frame_index;
+		_gfx_data.bq = &q;
 
 		per_frame_data& pfd = _pfd[frame_index];
 		pfd.reset();
-		q.add_request({.buffer = &pfd.buf_gui_idx});
-		q.add_request({.buffer = &pfd.buf_gui_vtx});
 
 		const gui_pass_view view = {
 			.proj		   = matrix4x4::ortho(0, static_cast<float>(_gfx_data.rt_size.x), 0, static_cast<float>(_gfx_data.rt_size.y), 0.0f, 1.0f),
@@ -612,6 +608,13 @@ namespace SFG
 
 	void debug_controller::tick()
 	{
+		log_event ev = {};
+		while (_log_events.try_dequeue(ev))
+		{
+			add_console_text(ev.text, ev.level);
+			SFG_FREE((void*)ev.text);
+		}
+
 		const char* cmd = nullptr;
 		while (_commands.try_dequeue(cmd))
 		{
@@ -635,14 +638,14 @@ namespace SFG
 
 		render_pass_color_attachment* attachment_console_rt = alloc.allocate<render_pass_color_attachment>(1);
 		attachment_console_rt->clear_color					= vector4(0.0f, 0.0f, 0.0f, 0.0f);
-		attachment_console_rt->load_op						= load_op::clear;
-		attachment_console_rt->store_op						= store_op::store;
+		attachment_console_rt->color_load_op				= load_op::clear;
+		attachment_console_rt->color_store_op				= store_op::store;
 		attachment_console_rt->texture						= rt_console;
 
 		render_pass_color_attachment* attachment_fullscreen_rt = alloc.allocate<render_pass_color_attachment>(1);
 		attachment_fullscreen_rt->clear_color				   = vector4(0.0f, 0.0f, 0.0f, 0.0f);
-		attachment_fullscreen_rt->load_op					   = load_op::clear;
-		attachment_fullscreen_rt->store_op					   = store_op::store;
+		attachment_fullscreen_rt->color_load_op				   = load_op::clear;
+		attachment_fullscreen_rt->color_store_op			   = store_op::store;
 		attachment_fullscreen_rt->texture					   = rt_fullscreen;
 
 		gfx_backend* backend = gfx_backend::get();
@@ -727,8 +730,8 @@ namespace SFG
 		pfd.draw_call_count++;
 		pfd.counter_vtx += buffer_vtx_count;
 		pfd.counter_idx += buffer_idx_count;
-		pfd.buf_gui_vtx.buffer_data(sizeof(vekt::vertex) * static_cast<size_t>(vtx_counter), buffer_vtx_start, static_cast<size_t>(buffer_vtx_count) * sizeof(vekt::vertex));
-		pfd.buf_gui_idx.buffer_data(sizeof(vekt::index) * static_cast<size_t>(idx_counter), buffer_idx_start, static_cast<size_t>(buffer_idx_count) * sizeof(vekt::index));
+		_gfx_data.bq->upload(pfd.buf_gui_vtx.get_hw_gpu(), static_cast<uint32>(sizeof(vekt::vertex) * vtx_counter), buffer_vtx_start, static_cast<uint32>(sizeof(vekt::vertex) * buffer_vtx_count));
+		_gfx_data.bq->upload(pfd.buf_gui_idx.get_hw_gpu(), static_cast<uint32>(sizeof(vekt::index) * idx_counter), buffer_idx_start, static_cast<uint32>(sizeof(vekt::index) * buffer_idx_count));
 		SFG_ASSERT(pfd.draw_call_count < MAX_GUI_DRAW_CALLS);
 
 		gui_draw_call& dc = _gui_draw_calls[dc_count];
@@ -828,7 +831,7 @@ namespace SFG
 		ref.buffer.size		 = vector2ui16(static_cast<uint16>(atlas_width), static_cast<uint16>(atlas_height));
 		ref.buffer.bpp		 = bpp;
 
-		_gfx_data.texture_queue->add_request({
+		_gfx_data.tq->add_request({
 			.texture	  = ref.texture,
 			.intermediate = ref.intermediate_buffer,
 			.buffers	  = &ref.buffer,
@@ -838,7 +841,7 @@ namespace SFG
 
 		const int32 index  = std::distance(it, _gfx_data.atlases.begin());
 		uint8*		pixels = ref.buffer.pixels;
-		_gfx_data.texture_queue->subscribe_flush_callback([index, this, pixels]() {
+		_gfx_data.tq->subscribe_flush_callback([index, this, pixels]() {
 			atlas_ref& ref = _gfx_data.atlases[index];
 			ref.res_alive  = false;
 			delete[] pixels;
@@ -952,7 +955,11 @@ namespace SFG
 
 	void debug_controller::on_log(log_level lvl, const char* msg)
 	{
-		add_console_text(msg, lvl);
+		// called from the log thread, console widgets are only touched in tick(), add_console_text() does the filtering.
+		const size_t sz	  = strlen(msg) + 1;
+		char*		 text = (char*)SFG_MALLOC(sz);
+		SFG_MEMCPY(text, msg, sz);
+		_log_events.enqueue({.text = text, .level = lvl});
 	}
 
 	void debug_controller::add_console_text(const char* text, log_level level)
@@ -996,7 +1003,7 @@ namespace SFG
 
 		vekt::text_props& tp = _vekt_data.builder->widget_get_text(w);
 		tp.text				 = _text_allocator.allocate(text);
-		tp.font				 = _vekt_data.font_debug;
+		tp.fnt				 = _vekt_data.font_debug;
 		_vekt_data.builder->widget_update_text(w);
 		_vekt_data.builder->widget_add_child(_vekt_data.widget_console_bg, w);
 
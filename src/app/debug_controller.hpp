@@ -34,6 +34,7 @@ namespace SFG
 
 #define MAX_GUI_DRAW_CALLS 32
 #define MAX_KEY_EVENTS	   64
+#define MAX_LOG_EVENTS	   64
 
 	class debug_controller
 	{
@@ -79,6 +80,12 @@ namespace SFG
 			int16  wheel  = 0;
 		};
 
+		struct log_event
+		{
+			const char* text = nullptr;
+			log_level	level;
+		};
+
 		struct gui_draw_call
 		{
 			vector4ui16 scissors	= vector4ui16::zero;
@@ -143,10 +150,11 @@ namespace SFG
 		struct gfx_data
 		{
 			vector<atlas_ref> atlases;
-			texture_queue*	  texture_queue = nullptr;
+			texture_queue*	  tq			= nullptr;
+			buffer_queue*	  bq			= nullptr;
 			vector2ui16		  window_size	= vector2ui16::zero;
 			vector2ui16		  rt_size		= vector2ui16::zero;
-			uint64			  frame_counter = 0;
+			uint64			  frame_counter	= 0;
 			uint8			  frame_index	= 0;
 		};
 
@@ -190,6 +198,7 @@ namespace SFG
 		gui_draw_call											   _gui_draw_calls[MAX_GUI_DRAW_CALLS];
 		moodycamel::ReaderWriterQueue<input_event, MAX_KEY_EVENTS> _input_events;
 		moodycamel::ReaderWriterQueue<const char*, 2>			   _commands;
+		moodycamel::ReaderWriterQueue<log_event, MAX_LOG_EVENTS>   _log_events;
 		console_state											   _console_state = console_state::invisible;
 	};
 }
\ No newline at end of file
@@ -12,6 +12,8 @@
 #include "debug_console.hpp"
 #include "world/world.hpp"
 #include "gfx/world/world_renderer.hpp"
+#include "thread/job_system.hpp"
+#include "common/profiler.hpp"
 
 #ifdef SFG_TOOLMODE
 #include "io/file_system.hpp"
@@ -33,6 +35,8 @@ namespace SFG
 
 		time::init();
 		debug_console::init();
+		job_system::get().init();
+		job_system::get().register_thread();
 
 		_world = new world();
 
@@ -92,6 +96,14 @@ namespace SFG
 
 #endif
 
+#ifdef ENABLE_PROFILER
+		debug_console::get()->register_console_function<int>("app_profile_capture", [](int frames) { profiler::get().begin_capture(static_cast<uint32>(frames)); });
+		debug_console::get()->register_console_function<const char*>("app_profile_export", [](const char* path) {
+			profiler::get().end_capture();
+			profiler::get().export_chrome_trace(path);
+		});
+#endif
+
 		/*************** DEBUG *************/
 		_world->load_debug();
 		/*************** DEBUG *************/
@@ -113,6 +125,9 @@ namespace SFG
 #endif
 		join_render();
 
+		job_system::get().unregister_thread();
+		job_system::get().uninit();
+
 		time::uninit();
 		debug_console::uninit();
 
@@ -133,15 +148,22 @@ namespace SFG
 		const int64 FIXED_INTERVAL_US = (int64)1000000 / (int64)SFG_DT;
 		int64		previous_time	  = time::get_cpu_microseconds();
 		int64		accumulator		  = FIXED_INTERVAL_US;
+		SFG_PROFILE_THREAD("main");
 
 		while (_should_close.load(std::memory_order_acquire) == 0)
 		{
+			SFG_PROFILE_FRAME();
+			SFG_PROFILE_ZONE("game_app::tick");
+
 			const int64 current_time = time::get_cpu_microseconds();
 			const int64 delta_micro	 = current_time - previous_time;
 			previous_time			 = current_time;
 			frame_info::s_main_thread_time_milli.store(static_cast<double>(delta_micro) * 0.001);
 
-			process::pump_os_messages();
+			{
+				SFG_PROFILE_ZONE("pump_os_messages");
+				process::pump_os_messages();
+			}
 
 			const uint32	  event_count  = _main_window->get_event_count();
 			bitmask<uint8>&	  window_flags = _main_window->get_flags();
@@ -277,12 +299,17 @@ namespace SFG
 	{
 		const vector2ui16& screen_size = _window_size;
 		REGISTER_THREAD_RENDER();
+		job_system::get().register_thread();
+		SFG_PROFILE_THREAD("render");
 
 		int64 previous_time = time::get_cpu_microseconds();
 
 		while (_render_joined.load(std::memory_order_acquire) == 0)
 		{
-			_frame_available_semaphore.acquire();
+			{
+				SFG_PROFILE_ZONE("wait_frame_available");
+				_frame_available_semaphore.acquire();
+			}
 			const uint8 index = _current_render_frame_index.load(std::memory_order_acquire);
 
 #ifndef SFG_PRODUCTION
@@ -301,5 +328,7 @@ namespace SFG
 			frame_info::s_fps.store(1.0f / static_cast<float>(delta_micro * 1e-6));
 #endif
 		}
+
+		job_system::get().unregister_thread();
 	}
 }
\ No newline at end of file
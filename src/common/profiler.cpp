@@ -0,0 +1,232 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "profiler.hpp"
+
+#ifdef ENABLE_PROFILER
+#include "io/log.hpp"
+#include <chrono>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+
+namespace SFG
+{
+	thread_local profiler_thread* profiler::s_thread		= nullptr;
+	thread_local const char*	  profiler::s_thread_name	= nullptr;
+	thread_local uint8			  profiler::s_thread_failed = 0;
+
+	namespace
+	{
+		/// Hands the slot back once the owning thread exits.
+		struct thread_release
+		{
+			profiler_thread* thread = nullptr;
+
+			~thread_release()
+			{
+				if (thread != nullptr)
+					thread->in_use.store(0, std::memory_order_release);
+			}
+		};
+
+		thread_local thread_release s_release;
+
+		void write_escaped(std::ofstream& file, const char* str)
+		{
+			for (const char* c = str; *c != '\0'; c++)
+			{
+				if (*c == '"' || *c == '\\')
+					file.put('\\');
+				file.put(*c);
+			}
+		}
+	}
+
+	profiler::~profiler()
+	{
+		for (atomic<profiler_thread*>& t : _threads)
+			delete t.load(std::memory_order_acquire);
+	}
+
+	int64 profiler::get_time_ns()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	profiler_thread* profiler::acquire_released(const char* name)
+	{
+		const uint32 count = _thread_count.load(std::memory_order_acquire);
+		const uint32 slots = count < PROFILER_MAX_THREADS ? count : PROFILER_MAX_THREADS;
+
+		for (uint32 i = 0; i < slots; i++)
+		{
+			profiler_thread* t = _threads[i].load(std::memory_order_acquire);
+			if (t == nullptr || t->in_use.load(std::memory_order_relaxed) != 0)
+				continue;
+
+			if (name != nullptr && strncmp(t->name, name, PROFILER_NAME_SIZE - 1) != 0)
+				continue;
+
+			uint8 expected = 0;
+			if (t->in_use.compare_exchange_strong(expected, 1, std::memory_order_acquire))
+				return t;
+		}
+
+		return nullptr;
+	}
+
+	profiler_thread* profiler::register_thread()
+	{
+		if (s_thread_failed)
+			return nullptr;
+
+		// restarted threads (render thread on resize, job workers on re-init) continue in their old slot.
+		profiler_thread* t = s_thread_name != nullptr ? acquire_released(s_thread_name) : nullptr;
+
+		if (t == nullptr && _thread_count.load(std::memory_order_relaxed) < PROFILER_MAX_THREADS)
+		{
+			const uint32 index = _thread_count.fetch_add(1, std::memory_order_relaxed);
+			if (index < PROFILER_MAX_THREADS)
+			{
+				t		  = new profiler_thread();
+				t->id	  = index;
+				t->in_use = 1;
+				_threads[index].store(t, std::memory_order_release);
+			}
+		}
+
+		// out of new slots, any released one will do, its older events show up under the new name.
+		if (t == nullptr)
+			t = acquire_released(nullptr);
+
+		if (t == nullptr)
+		{
+			s_thread_failed = 1;
+			SFG_WARN("profiler thread limit reached, events of this thread are dropped.");
+			return nullptr;
+		}
+
+		if (s_thread_name != nullptr)
+			strncpy(t->name, s_thread_name, PROFILER_NAME_SIZE - 1);
+		else
+			snprintf(t->name, PROFILER_NAME_SIZE, "thread %u", t->id);
+
+		s_thread		 = t;
+		s_release.thread = t;
+		return t;
+	}
+
+	void profiler::set_thread_name(const char* name)
+	{
+		s_thread_name = name;
+		if (s_thread != nullptr)
+			strncpy(s_thread->name, name, PROFILER_NAME_SIZE - 1);
+	}
+
+	void profiler::begin_capture(uint32 frame_count)
+	{
+		_frames_left   = frame_count;
+		_frame_head	   = 0;
+		_capture_begin_ns = get_time_ns();
+		_capture_begin	  = get_ticks();
+		_capture_end	  = 0;
+		_capturing.store(1, std::memory_order_relaxed);
+		SFG_INFO("profiler capture started.");
+	}
+
+	void profiler::end_capture()
+	{
+		if (!is_capturing())
+			return;
+
+		_capturing.store(0, std::memory_order_relaxed);
+		_capture_end	= get_ticks();
+		_capture_end_ns = get_time_ns();
+		SFG_INFO("profiler capture ended, {0} frames.", _frame_head);
+	}
+
+	void profiler::mark_frame()
+	{
+		if (!is_capturing())
+			return;
+
+		_frames[_frame_head % PROFILER_MAX_FRAMES] = get_ticks();
+		_frame_head++;
+
+		if (_frames_left != 0 && --_frames_left == 0)
+			end_capture();
+	}
+
+	bool profiler::export_chrome_trace(const char* path)
+	{
+		if (is_capturing())
+		{
+			SFG_ERR("profiler can't export while capturing.");
+			return false;
+		}
+
+		std::ofstream file(path, std::ios::out | std::ios::trunc);
+		if (!file.is_open())
+		{
+			SFG_ERR("profiler can't open {0}", path);
+			return false;
+		}
+
+		char		 line[256];
+		bool		 first	   = true;
+		const int64	 origin	   = _capture_begin;
+		const double us_tick   = _capture_end > _capture_begin ? static_cast<double>(_capture_end_ns - _capture_begin_ns) * 0.001 / static_cast<double>(_capture_end - _capture_begin) : 0.0;
+		const uint32 thread_ct = _thread_count.load(std::memory_order_acquire);
+		const uint32 threads   = thread_ct < PROFILER_MAX_THREADS ? thread_ct : PROFILER_MAX_THREADS;
+
+		auto separator = [&]() {
+			if (!first)
+				file << ",\n";
+			first = false;
+		};
+
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+		for (uint32 i = 0; i < threads; i++)
+		{
+			const profiler_thread* t = _threads[i].load(std::memory_order_acquire);
+			if (t == nullptr)
+				continue;
+
+			separator();
+			file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << t->id << ",\"args\":{\"name\":\"";
+			write_escaped(file, t->name);
+			file << "\"}}";
+
+			const uint64 head  = t->head.load(std::memory_order_acquire);
+			const uint64 begin = head > PROFILER_THREAD_EVENTS ? head - PROFILER_THREAD_EVENTS : 0;
+			for (uint64 e = begin; e < head; e++)
+			{
+				const profiler_event& ev = t->events[e & (PROFILER_THREAD_EVENTS - 1)];
+				if (ev.begin < _capture_begin || ev.end > _capture_end)
+					continue;
+
+				separator();
+				file << "{\"name\":\"";
+				write_escaped(file, ev.name);
+				snprintf(line, sizeof(line), "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", t->id, static_cast<double>(ev.begin - origin) * us_tick, static_cast<double>(ev.end - ev.begin) * us_tick);
+				file << line;
+			}
+		}
+
+		const uint64 frame_begin = _frame_head > PROFILER_MAX_FRAMES ? _frame_head - PROFILER_MAX_FRAMES : 0;
+		for (uint64 f = frame_begin; f < _frame_head; f++)
+		{
+			separator();
+			snprintf(line, sizeof(line), "{\"name\":\"frame %llu\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":%.3f}", static_cast<unsigned long long>(f), static_cast<double>(_frames[f % PROFILER_MAX_FRAMES] - origin) * us_tick);
+			file << line;
+		}
+
+		file << "\n]}\n";
+		file.close();
+
+		SFG_INFO("profiler exported {0}", path);
+		return true;
+	}
+}
+#endif
@@ -0,0 +1,155 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#ifndef SFG_PRODUCTION
+#define ENABLE_PROFILER
+#endif
+
+#ifdef ENABLE_PROFILER
+#include "common/size_definitions.hpp"
+#include "data/atomic.hpp"
+
+#if defined(_M_X64)
+#include <intrin.h>
+#elif defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+namespace SFG
+{
+#define PROFILER_MAX_THREADS   32
+#define PROFILER_THREAD_EVENTS (1 << 16) // per thread, power of two. Oldest events are overwritten.
+#define PROFILER_MAX_FRAMES	   4096
+#define PROFILER_NAME_SIZE	   32
+
+	struct profiler_event
+	{
+		const char* name  = nullptr; // needs to outlive the capture, string literals.
+		int64		begin = 0;		 // get_ticks().
+		int64		end	  = 0;
+	};
+
+	/// Owned by one OS thread at a time, released when it exits. A later thread with the same name takes it over along with its events.
+	struct alignas(64) profiler_thread
+	{
+		profiler_event events[PROFILER_THREAD_EVENTS];
+		atomic<uint64> head						= 0;
+		char		   name[PROFILER_NAME_SIZE] = {};
+		uint32		   id						= 0;
+		atomic<uint8>  in_use					= 0;
+	};
+
+	/*
+		Scoped CPU zones go into a buffer owned by the recording thread, written without locks & published with a release store. Nothing is
+		recorded outside of a capture, a zone then costs a relaxed load. A capture runs until end_capture() or until it has seen frame_count frame
+		markers. Export once the capture is over & zones that were open at the end have closed, the next frame is enough.
+	*/
+	class profiler
+	{
+	public:
+		static profiler& get()
+		{
+			static profiler instance;
+			return instance;
+		}
+
+		~profiler();
+
+		/// 0 frame_count keeps capturing until end_capture(). Events of a previous capture are dropped from the export.
+		void begin_capture(uint32 frame_count = 0);
+		void end_capture();
+
+		/// From the main thread, once per frame.
+		void mark_frame();
+
+		/// name needs to outlive the profiler. Set it before the first zone so a restarted thread gets its old slot back.
+		void set_thread_name(const char* name);
+
+		/// Chrome trace event format, opens in chrome://tracing & ui.perfetto.dev.
+		bool export_chrome_trace(const char* path);
+
+		static int64 get_time_ns();
+
+		/// Time stamp counter where there is one, nanoseconds otherwise. Converted with the rate measured over the capture.
+		static inline int64 get_ticks()
+		{
+#if defined(_M_X64) || defined(__x86_64__)
+			return static_cast<int64>(__rdtsc());
+#else
+			return get_time_ns();
+#endif
+		}
+
+		inline bool is_capturing() const
+		{
+			return _capturing.load(std::memory_order_relaxed) != 0;
+		}
+
+		inline void record(const char* name, int64 begin, int64 end)
+		{
+			profiler_thread* t = s_thread != nullptr ? s_thread : register_thread();
+			if (t == nullptr)
+				return;
+
+			// single writer, export only reads up to the published head.
+			const uint64 head							   = t->head.load(std::memory_order_relaxed);
+			t->events[head & (PROFILER_THREAD_EVENTS - 1)] = {.name = name, .begin = begin, .end = end};
+			t->head.store(head + 1, std::memory_order_release);
+		}
+
+	private:
+		profiler_thread* register_thread();
+		profiler_thread* acquire_released(const char* name);
+
+	private:
+		static thread_local profiler_thread* s_thread;
+		static thread_local const char*		 s_thread_name;
+		static thread_local uint8			 s_thread_failed;
+
+		atomic<profiler_thread*> _threads[PROFILER_MAX_THREADS] = {};
+		atomic<uint32>			 _thread_count					= 0;
+		atomic<uint8>			 _capturing						= 0;
+		uint32					 _frames_left					= 0;
+		int64					 _capture_begin					= 0; // ticks.
+		int64					 _capture_end					= 0;
+		int64					 _capture_begin_ns				= 0;
+		int64					 _capture_end_ns				= 0;
+		uint64					 _frame_head					= 0;
+		int64					 _frames[PROFILER_MAX_FRAMES]	= {};
+	};
+
+	struct profiler_zone
+	{
+		const char* name  = nullptr;
+		int64		begin = 0;
+
+		inline profiler_zone(const char* zone_name)
+		{
+			if (!profiler::get().is_capturing())
+				return;
+
+			name  = zone_name;
+			begin = profiler::get_ticks();
+		}
+
+		inline ~profiler_zone()
+		{
+			if (name != nullptr)
+				profiler::get().record(name, begin, profiler::get_ticks());
+		}
+	};
+}
+
+#define SFG_PROFILE_CONCAT_IMPL(A, B) A##B
+#define SFG_PROFILE_CONCAT(A, B)	  SFG_PROFILE_CONCAT_IMPL(A, B)
+#define SFG_PROFILE_ZONE(NAME)		  SFG::profiler_zone SFG_PROFILE_CONCAT(_profiler_zone_, __LINE__)(NAME)
+#define SFG_PROFILE_FUNCTION()		  SFG_PROFILE_ZONE(__func__)
+#define SFG_PROFILE_FRAME()			  SFG::profiler::get().mark_frame()
+#define SFG_PROFILE_THREAD(NAME)	  SFG::profiler::get().set_thread_name(NAME)
+#else
+#define SFG_PROFILE_ZONE(NAME)
+#define SFG_PROFILE_FUNCTION()
+#define SFG_PROFILE_FRAME()
+#define SFG_PROFILE_THREAD(NAME)
+#endif
@@ -2,8 +2,9 @@
 
 #pragma once
 
-#ifdef SFG_PLATFORM_OSX
+#ifndef SFG_PLATFORM_WINDOWS
 #include <stddef.h>
+#include <stdint.h>
 #endif
 
 typedef signed char		   int8;
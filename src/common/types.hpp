@@ -4,6 +4,9 @@
 
 #include "data/vector.hpp"
 #include "data/hash_map.hpp"
+#include "data/static_vector.hpp"
+#include "data/span.hpp"
+#include <type_traits>
 
 namespace SFG
 {
@@ -37,5 +40,39 @@ namespace SFG
 
 		template <typename T> inline constexpr bool is_vector_v = is_vector<T>::value;
 
+		template <typename T> struct is_static_vector : std::false_type
+		{
+		};
+
+		template <typename U, int N> struct is_static_vector<static_vector<U, N>> : std::true_type
+		{
+		};
+
+		template <typename U, int N> struct is_static_vector<const static_vector<U, N>> : std::true_type
+		{
+		};
+
+		template <typename T> inline constexpr bool is_static_vector_v = is_static_vector<T>::value;
+
+		template <typename T> struct is_span : std::false_type
+		{
+		};
+
+		template <typename U> struct is_span<span<U>> : std::true_type
+		{
+		};
+
+		template <typename U> struct is_span<const span<U>> : std::true_type
+		{
+		};
+
+		template <typename T> inline constexpr bool is_span_v = is_span<T>::value;
+
+		/*
+			Arrays of these are serialized with a single copy. Structs opt in with `static constexpr bool bulk_serializable = true;`,
+			which promises their memory layout (no padding, no pointers) is what goes to disk.
+		*/
+		template <typename T> inline constexpr bool is_bulk_serializable_v = std::is_arithmetic_v<T> || requires { requires T::bulk_serializable; };
+
 	}
 }
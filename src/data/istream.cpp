@@ -14,8 +14,9 @@ namespace SFG
 		if (data != nullptr)
 			SFG_MEMCPY(_data, data, unaligned);
 
-		_index = 0;
-		_size  = size;
+		_index	   = 0;
+		_size	   = size;
+		_owns_data = true;
 	}
 
 	void istream::destroy()
@@ -23,10 +24,13 @@ namespace SFG
 		if (_data == nullptr)
 			return;
 
-		delete[] _data;
-		_index = 0;
-		_size  = 0;
-		_data  = nullptr;
+		if (_owns_data)
+			delete[] _data;
+
+		_index	   = 0;
+		_size	   = 0;
+		_data	   = nullptr;
+		_owns_data = false;
 	}
 
 	void istream::read_from_ifstream(std::ifstream& stream)
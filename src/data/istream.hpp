@@ -8,6 +8,7 @@
 #include "data/string.hpp"
 #include "common/types.hpp"
 #include "io/assert.hpp"
+#include "serialization/bulk.hpp"
 #include <fstream>
 
 namespace SFG
@@ -26,8 +27,64 @@ namespace SFG
 		}
 	}
 
+	/// Reads & validates the header of an array of T. Anything that doesn't match is skipped and comes back as an empty array.
+	template <typename T, typename Stream> bulk_header deserialize_bulk_header(Stream& stream)
+	{
+		// a stream too short for the header fails validation with version 0.
+		bulk_header header = {.version = 0};
+		if (stream.get_remaining() >= SERIALIZATION_BULK_HEADER_SIZE)
+			stream >> header.count >> header.element_size >> header.alignment >> header.flags >> header.version >> header.padding;
+
+		size_t skip = 0;
+		if (!header.validate(sizeof(T), std::is_arithmetic_v<T>, stream.get_remaining(), skip))
+		{
+			stream.skip_by(skip);
+			header.count = 0;
+			return header;
+		}
+
+		stream.skip_by(header.padding);
+		return header;
+	}
+
+	template <typename Stream, typename T> void deserialize_bulk(Stream& stream, const bulk_header& header, T* out)
+	{
+		stream.read_to_raw(reinterpret_cast<uint8*>(out), static_cast<size_t>(header.count) * sizeof(T));
+
+		// validated headers only differ in endianness for plain numbers.
+		if (((header.flags & SERIALIZATION_BULK_BIG_ENDIAN) != 0) == endianness::should_swap())
+			return;
+
+		if constexpr (std::is_arithmetic_v<T>)
+		{
+			for (uint32 i = 0; i < header.count; i++)
+				endianness::swap_endian(out[i]);
+		}
+	}
+
+	/// Points into the stream instead of copying, valid as long as the stream memory is. Expects a header read for T, which can't be swapped in place.
+	template <typename Stream, typename T> const T* deserialize_bulk_view(Stream& stream, const bulk_header& header)
+	{
+		if (header.count == 0)
+			return nullptr;
+
+		SFG_ASSERT(((header.flags & SERIALIZATION_BULK_BIG_ENDIAN) != 0) == endianness::should_swap(), "Bulk data was written with a different endianness!");
+
+		const uint8* ptr = stream.read_view(static_cast<size_t>(header.count) * sizeof(T));
+		SFG_ASSERT(reinterpret_cast<uintptr_t>(ptr) % alignof(T) == 0, "Misaligned bulk data!");
+		return reinterpret_cast<const T*>(ptr);
+	}
+
 	template <typename Stream, typename U> void deserialize_vector(Stream& stream, vector<U>& vec)
 	{
+		if constexpr (is_bulk_serializable_v<U>)
+		{
+			const bulk_header header = deserialize_bulk_header<U>(stream);
+			vec.resize(header.count);
+			deserialize_bulk(stream, header, vec.data());
+			return;
+		}
+
 		uint32 sz = 0;
 		stream >> sz;
 		vec.resize(sz);
@@ -47,10 +104,29 @@ namespace SFG
 		}
 	}
 
+	template <typename Stream, typename U, int N> void deserialize_static_vector(Stream& stream, static_vector<U, N>& vec)
+	{
+		if constexpr (is_bulk_serializable_v<U>)
+		{
+			const bulk_header header = deserialize_bulk_header<U>(stream);
+			vec.resize(header.count);
+			deserialize_bulk(stream, header, vec.data());
+		}
+		else
+		{
+			uint32 sz = 0;
+			stream >> sz;
+			vec.resize(sz);
+			for (uint32 i = 0; i < sz; i++)
+				stream >> vec[i];
+		}
+	}
+
 	class istream
 	{
 	public:
 		istream(){};
+		/// Views existing memory, the stream does not own nor free it.
 		istream(uint8* data, size_t size)
 		{
 			_data = data;
@@ -68,11 +144,25 @@ namespace SFG
 			_index += sizeof(T);
 		}
 
+		/// Zero-copy read, returns the current position and skips size bytes. The pointer is only valid while the underlying memory is, and is not aligned.
+		inline const uint8* read_view(size_t size)
+		{
+			SFG_ASSERT(_index + size <= _size);
+			const uint8* ptr = &_data[_index];
+			_index += size;
+			return ptr;
+		}
+
 		inline void skip_by(size_t size)
 		{
 			_index += size;
 		}
 
+		inline size_t get_remaining() const
+		{
+			return _size - _index;
+		}
+
 		inline void seek(size_t ind)
 		{
 			_index = ind;
@@ -103,10 +193,16 @@ namespace SFG
 			_size = size;
 		}
 
+		inline bool is_view() const
+		{
+			return !_owns_data;
+		}
+
 	private:
-		uint8* _data  = nullptr;
-		size_t _index = 0;
-		size_t _size  = 0;
+		uint8* _data	  = nullptr;
+		size_t _index	  = 0;
+		size_t _size	  = 0;
+		bool   _owns_data = false;
 	};
 
 	template <typename T> istream& operator>>(istream& stream, T& val)
@@ -143,6 +239,18 @@ namespace SFG
 			using ValueType = typename T::mapped_type;
 			deserialize_hash_map(stream, val);
 		}
+		else if constexpr (is_static_vector_v<T>)
+		{
+			deserialize_static_vector(stream, val);
+		}
+		else if constexpr (is_span_v<T>)
+		{
+			// spans are views, they end up pointing into the stream.
+			using element_type		 = std::remove_const_t<std::remove_pointer_t<decltype(val.data)>>;
+			const bulk_header header = deserialize_bulk_header<element_type>(stream);
+			val.data				 = const_cast<element_type*>(deserialize_bulk_view<istream, element_type>(stream, header));
+			val.size				 = header.count;
+		}
 		else if constexpr (std::is_class_v<T>)
 		{
 			// Handle custom classes or structs
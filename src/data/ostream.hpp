@@ -10,6 +10,7 @@
 #include "data/hash_map.hpp"
 #include "io/assert.hpp"
 #include "common/types.hpp"
+#include "serialization/bulk.hpp"
 #include <fstream>
 
 namespace SFG
@@ -23,8 +24,40 @@ namespace SFG
 		}
 	}
 
+	/// Header + padding + one copy of the whole array, see bulk.hpp.
+	template <typename Stream, typename T> void serialize_bulk(Stream& stream, const T* data, uint32 count)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Bulk serialized types need to be trivially copyable!");
+
+		const uint8	 zeros[SERIALIZATION_BULK_ALIGNMENT] = {};
+		const size_t payload_start						 = stream.get_size() + SERIALIZATION_BULK_HEADER_SIZE;
+
+		bulk_header header = {
+			.count		  = count,
+			.element_size = static_cast<uint16>(sizeof(T)),
+			.alignment	  = SERIALIZATION_BULK_ALIGNMENT,
+			.flags		  = static_cast<uint8>(endianness::should_swap() ? SERIALIZATION_BULK_BIG_ENDIAN : 0),
+			.version	  = SERIALIZATION_BULK_VERSION,
+			.padding	  = static_cast<uint8>((SERIALIZATION_BULK_ALIGNMENT - payload_start % SERIALIZATION_BULK_ALIGNMENT) % SERIALIZATION_BULK_ALIGNMENT),
+		};
+
+		stream << header.count << header.element_size << header.alignment << header.flags << header.version << header.padding;
+
+		if (header.padding != 0)
+			stream.write_raw(zeros, header.padding);
+
+		if (count != 0)
+			stream.write_raw(reinterpret_cast<const uint8*>(data), static_cast<size_t>(count) * sizeof(T));
+	}
+
 	template <typename Stream, typename U> void serialize_vector(Stream& stream, vector<U>& vec)
 	{
+		if constexpr (is_bulk_serializable_v<U>)
+		{
+			serialize_bulk(stream, vec.data(), static_cast<uint32>(vec.size()));
+			return;
+		}
+
 		const uint32 sz = static_cast<uint32>(vec.size());
 		stream << sz;
 
@@ -42,6 +75,12 @@ namespace SFG
 
 	template <typename Stream, typename U> void serialize_vector(Stream& stream, const vector<U>& vec)
 	{
+		if constexpr (is_bulk_serializable_v<U>)
+		{
+			serialize_bulk(stream, vec.data(), static_cast<uint32>(vec.size()));
+			return;
+		}
+
 		const uint32 sz = static_cast<uint32>(vec.size());
 		stream << sz;
 
@@ -57,6 +96,19 @@ namespace SFG
 		}
 	}
 
+	template <typename Stream, typename U, int N> void serialize_static_vector(Stream& stream, const static_vector<U, N>& vec)
+	{
+		if constexpr (is_bulk_serializable_v<U>)
+			serialize_bulk(stream, vec.data(), static_cast<uint32>(vec.size()));
+		else
+		{
+			const uint32 sz = static_cast<uint32>(vec.size());
+			stream << sz;
+			for (uint32 i = 0; i < sz; i++)
+				stream << vec[i];
+		}
+	}
+
 	class ostream
 	{
 	public:
@@ -132,6 +184,15 @@ namespace SFG
 			using ValueType = typename T::mapped_type;
 			serialize_hash_map(stream, val);
 		}
+		else if constexpr (is_static_vector_v<T>)
+		{
+			serialize_static_vector(stream, val);
+		}
+		else if constexpr (is_span_v<T>)
+		{
+			static_assert(is_bulk_serializable_v<std::remove_const_t<std::remove_pointer_t<decltype(val.data)>>>, "Spans are only serialized in bulk!");
+			serialize_bulk(stream, val.data, static_cast<uint32>(val.size));
+		}
 		else if constexpr (std::is_class_v<T>)
 		{
 			// Handle custom classes or structs
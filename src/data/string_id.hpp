@@ -4,6 +4,7 @@
 
 #include "common/size_definitions.hpp"
 #include <string>
+#include <cstring>
 
 // Headers here.
 namespace SFG
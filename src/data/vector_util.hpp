@@ -4,6 +4,7 @@
 
 #include "common/size_definitions.hpp"
 #include "data/vector.hpp"
+#include <algorithm>
 
 namespace SFG
 {
@@ -1,17 +1,18 @@
 // Copyright (c) 2025 Inan Evin
 #pragma once
 
-#ifdef SFG_PLATFORM_WINDOWS
+#if defined(SFG_PLATFORM_WINDOWS) && !defined(SFG_NULL_BACKEND)
 #include "gfx/backend/dx12/dx12_backend.hpp"
 #else
+#include "gfx/backend/null/null_backend.hpp"
 #endif
 
 namespace SFG
 {
-#ifdef SFG_PLATFORM_WINDOWS
+#if defined(SFG_PLATFORM_WINDOWS) && !defined(SFG_NULL_BACKEND)
 	typedef dx12_backend gfx_backend;
 #else
-
+	typedef null_backend gfx_backend;
 #endif
 
 }
\ No newline at end of file
@@ -231,6 +231,18 @@ namespace SFG
 				return DXGI_FORMAT_BC3_UNORM_SRGB;
 			case format::bc3_block_unorm:
 				return DXGI_FORMAT_BC3_UNORM;
+			case format::bc1_block_srgb:
+				return DXGI_FORMAT_BC1_UNORM_SRGB;
+			case format::bc1_block_unorm:
+				return DXGI_FORMAT_BC1_UNORM;
+			case format::bc4_block_unorm:
+				return DXGI_FORMAT_BC4_UNORM;
+			case format::bc5_block_unorm:
+				return DXGI_FORMAT_BC5_UNORM;
+			case format::bc7_block_srgb:
+				return DXGI_FORMAT_BC7_UNORM_SRGB;
+			case format::bc7_block_unorm:
+				return DXGI_FORMAT_BC7_UNORM;
 
 			default:
 				return DXGI_FORMAT_UNKNOWN;
@@ -922,7 +934,7 @@ namespace SFG
 	void dx12_backend::destroy_resource(gfx_id id)
 	{
 
-		VERIFY_RENDER_NOT_RUNNING();
+		VERIFY_RENDER_NOT_RUNNING_OR_RENDER_THREAD();
 
 		resource& res = _resources.get(id);
 
@@ -944,7 +956,8 @@ namespace SFG
 
 	gfx_id dx12_backend::create_texture(const texture_desc& desc)
 	{
-		VERIFY_RENDER_NOT_RUNNING();
+		// texture streaming recreates textures on the render thread, which owns the backend while rendering.
+		VERIFY_RENDER_NOT_RUNNING_OR_RENDER_THREAD();
 
 		const gfx_id id	 = _textures.add();
 		texture&	 txt = _textures.get(id);
@@ -954,12 +967,14 @@ namespace SFG
 #ifdef ENABLE_MEMORY_TRACER
 
 		{
-			const uint8 bpp	  = desc.flags.is_set(texture_flags::tf_depth_texture) ? format_get_bpp(desc.depth_stencil_format) : format_get_bpp(desc.texture_format);
-			uint16		width = desc.size.x, height = desc.size.y;
-			size_t		sz = 0;
+			const format fmt		= desc.flags.is_set(texture_flags::tf_depth_texture) ? desc.depth_stencil_format : desc.texture_format;
+			const uint8	 block_size = format_get_block_size(fmt);
+			const uint8	 bpp		= block_size != 0 ? 0 : format_get_bpp(fmt);
+			uint16		 width = desc.size.x, height = desc.size.y;
+			size_t		 sz = 0;
 			for (uint8 i = 0; i < desc.mip_levels; i++)
 			{
-				sz += width * height * bpp;
+				sz += block_size != 0 ? ((width + 3) / 4) * ((height + 3) / 4) * block_size : width * height * bpp;
 				width /= 2;
 				height /= 2;
 			}
@@ -1213,7 +1228,7 @@ namespace SFG
 
 	void dx12_backend::destroy_texture(gfx_id id)
 	{
-		VERIFY_RENDER_NOT_RUNNING();
+		VERIFY_RENDER_NOT_RUNNING_OR_RENDER_THREAD();
 
 		texture& txt = _textures.get(id);
 
@@ -1315,21 +1330,21 @@ namespace SFG
 			swp.vsync = 0;
 
 		DXGI_FORMAT swap_format = DXGI_FORMAT_B8G8R8A8_UNORM;
-		if (desc.format == format::r16g16b16a16_sfloat)
+		if (desc.swapchain_format == format::r16g16b16a16_sfloat)
 		{
 			swap_format = DXGI_FORMAT_R16G16B16A16_FLOAT;
 		}
-		else if (desc.format == format::r8g8b8a8_unorm)
+		else if (desc.swapchain_format == format::r8g8b8a8_unorm)
 		{
 			swap_format = DXGI_FORMAT_R8G8B8A8_UNORM;
 		}
-		else if (desc.format == format::r8g8b8a8_srgb)
+		else if (desc.swapchain_format == format::r8g8b8a8_srgb)
 		{
 			swap_format = DXGI_FORMAT_R8G8B8A8_UNORM;
 		}
 
 		// this is view(rtv) format
-		swp.format = static_cast<uint8>(get_format(desc.format));
+		swp.format = static_cast<uint8>(get_format(desc.swapchain_format));
 
 		const DXGI_SWAP_CHAIN_DESC1 swapchain_desc = {
 			.Width	= static_cast<UINT>(desc.size.x),
@@ -1763,7 +1778,7 @@ namespace SFG
 			input_layout.push_back({
 				.SemanticName		  = inp.name.c_str(),
 				.SemanticIndex		  = inp.index,
-				.Format				  = get_format(inp.format),
+				.Format				  = get_format(inp.input_format),
 				.InputSlot			  = inp.location,
 				.AlignedByteOffset	  = static_cast<uint32>(inp.offset),
 				.InputSlotClass		  = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA,
@@ -1797,7 +1812,7 @@ namespace SFG
 			pso_desc.BlendState.RenderTarget[i].LogicOpEnable		  = desc.flags.is_set(shader_flags::shf_enable_blend_logic_op);
 			pso_desc.BlendState.RenderTarget[i].LogicOp				  = get_logic_op(desc.blend_logic_op);
 			pso_desc.BlendState.RenderTarget[i].RenderTargetWriteMask = get_color_mask(att.blend_attachment.color_comp_flags);
-			pso_desc.RTVFormats[i]									  = get_format(att.format);
+			pso_desc.RTVFormats[i]									  = get_format(att.attachment_format);
 		}
 
 		pso_desc.DepthStencilState.DepthEnable		   = desc.depth_stencil_desc.flags.is_set(depth_stencil_flags::dsf_depth_write);
@@ -1809,11 +1824,11 @@ namespace SFG
 		pso_desc.DepthStencilState.FrontFace		   = {get_stencil_op(desc.depth_stencil_desc.front_stencil_state.fail_op),
 														  get_stencil_op(desc.depth_stencil_desc.front_stencil_state.depth_fail_op),
 														  get_stencil_op(desc.depth_stencil_desc.front_stencil_state.pass_op),
-														  get_compare_op(desc.depth_stencil_desc.front_stencil_state.compare_op)};
+														  get_compare_op(desc.depth_stencil_desc.front_stencil_state.cmp_op)};
 		pso_desc.DepthStencilState.BackFace			   = {get_stencil_op(desc.depth_stencil_desc.front_stencil_state.fail_op),
 														  get_stencil_op(desc.depth_stencil_desc.front_stencil_state.depth_fail_op),
 														  get_stencil_op(desc.depth_stencil_desc.front_stencil_state.pass_op),
-														  get_compare_op(desc.depth_stencil_desc.front_stencil_state.compare_op)};
+														  get_compare_op(desc.depth_stencil_desc.front_stencil_state.cmp_op)};
 		pso_desc.SampleMask							   = UINT_MAX;
 		pso_desc.SampleDesc.Count					   = desc.samples;
 		pso_desc.PrimitiveTopologyType				   = get_topology_type(desc.topo);
@@ -1950,7 +1965,8 @@ namespace SFG
 
 	void dx12_backend::bind_group_update_pointer(gfx_id id, uint8 binding_index, const vector<bind_group_pointer>& updates)
 	{
-		VERIFY_RENDER_NOT_RUNNING();
+		// render thread may only update groups of the frame it records, their previous use is already fenced.
+		VERIFY_RENDER_NOT_RUNNING_OR_RENDER_THREAD();
 
 		bind_group&	   group   = _bind_groups.get(id);
 		group_binding& binding = group.bindings[binding_index];
@@ -2294,8 +2310,8 @@ namespace SFG
 			cv.Color[1] = att.clear_color.y;
 			cv.Color[2] = att.clear_color.z;
 			cv.Color[3] = att.clear_color.w;
-			const D3D12_RENDER_PASS_BEGINNING_ACCESS color_begin{get_load_op(att.load_op), {cv}};
-			const D3D12_RENDER_PASS_ENDING_ACCESS	 color_end{get_store_op(att.store_op), {}};
+			const D3D12_RENDER_PASS_BEGINNING_ACCESS color_begin{get_load_op(att.color_load_op), {cv}};
+			const D3D12_RENDER_PASS_ENDING_ACCESS	 color_end{get_store_op(att.color_store_op), {}};
 
 			color_attachments[i] = {dh.cpu, color_begin, color_end};
 		}
@@ -2322,8 +2338,8 @@ namespace SFG
 			cv.Color[1] = att.clear_color.y;
 			cv.Color[2] = att.clear_color.z;
 			cv.Color[3] = att.clear_color.w;
-			const D3D12_RENDER_PASS_BEGINNING_ACCESS color_begin{get_load_op(att.load_op), {cv}};
-			const D3D12_RENDER_PASS_ENDING_ACCESS	 color_end{get_store_op(att.store_op), {}};
+			const D3D12_RENDER_PASS_BEGINNING_ACCESS color_begin{get_load_op(att.color_load_op), {cv}};
+			const D3D12_RENDER_PASS_ENDING_ACCESS	 color_end{get_store_op(att.color_store_op), {}};
 
 			color_attachments[i] = {dh.cpu, color_begin, color_end};
 		}
@@ -2359,8 +2375,8 @@ namespace SFG
 			cv.Color[1] = att.clear_color.y;
 			cv.Color[2] = att.clear_color.z;
 			cv.Color[3] = att.clear_color.w;
-			const D3D12_RENDER_PASS_BEGINNING_ACCESS color_begin{get_load_op(att.load_op), {cv}};
-			const D3D12_RENDER_PASS_ENDING_ACCESS	 color_end{get_store_op(att.store_op), {}};
+			const D3D12_RENDER_PASS_BEGINNING_ACCESS color_begin{get_load_op(att.color_load_op), {cv}};
+			const D3D12_RENDER_PASS_ENDING_ACCESS	 color_end{get_store_op(att.color_store_op), {}};
 
 			color_attachments[i] = {dh.cpu, color_begin, color_end};
 		}
@@ -2388,8 +2404,8 @@ namespace SFG
 			cv.Color[1] = att.clear_color.y;
 			cv.Color[2] = att.clear_color.z;
 			cv.Color[3] = att.clear_color.w;
-			const D3D12_RENDER_PASS_BEGINNING_ACCESS color_begin{get_load_op(att.load_op), {cv}};
-			const D3D12_RENDER_PASS_ENDING_ACCESS	 color_end{get_store_op(att.store_op), {}};
+			const D3D12_RENDER_PASS_BEGINNING_ACCESS color_begin{get_load_op(att.color_load_op), {cv}};
+			const D3D12_RENDER_PASS_ENDING_ACCESS	 color_end{get_store_op(att.color_store_op), {}};
 
 			color_attachments[i] = {dh.cpu, color_begin, color_end};
 		}
@@ -2522,6 +2538,15 @@ namespace SFG
 		cmd_list->CopyResource(dest_res.ptr->GetResource(), src_res.ptr->GetResource());
 	}
 
+	void dx12_backend::cmd_copy_buffer(gfx_id cmd_id, const command_copy_buffer& cmd) const
+	{
+		const command_buffer&		buffer	 = _command_buffers.get(cmd_id);
+		ID3D12GraphicsCommandList4* cmd_list = buffer.ptr.Get();
+		const resource&				src_res	 = _resources.get(cmd.source);
+		const resource&				dest_res = _resources.get(cmd.destination);
+		cmd_list->CopyBufferRegion(dest_res.ptr->GetResource(), cmd.destination_offset, src_res.ptr->GetResource(), cmd.source_offset, cmd.size);
+	}
+
 	uint32 dx12_backend::get_texture_size(uint32 width, uint32 height, uint32 bpp) const
 	{
 		const uint32 row_pitch	 = static_cast<uint32>((width * bpp + (D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1)) & ~(D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1));
@@ -2567,12 +2592,12 @@ namespace SFG
 		for (uint8 i = 0; i < cmd.mip_levels; i++)
 		{
 			const texture_buffer& tb		= cmd.textures[i];
-			const LONG_PTR		  row_pitch = static_cast<LONG_PTR>((tb.size.x * tb.bpp + (D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1)) & ~(D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1));
+			const LONG_PTR		  row_pitch = static_cast<LONG_PTR>((tb.get_row_pitch() + (D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1)) & ~(D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1));
 
 			const D3D12_SUBRESOURCE_DATA texture_data = {
 				.pData		= tb.pixels,
 				.RowPitch	= row_pitch,
-				.SlicePitch = row_pitch * static_cast<LONG_PTR>(tb.size.y),
+				.SlicePitch = row_pitch * static_cast<LONG_PTR>(tb.get_row_count()),
 			};
 
 			subresource_data.push_back(texture_data);
@@ -0,0 +1,625 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "null_backend.hpp"
+#include "gfx/common/descriptions.hpp"
+#include "gfx/common/commands.hpp"
+#include "gfx/common/texture_buffer.hpp"
+#include "gfx/common/format.hpp"
+#include "common/system_info.hpp"
+#include "memory/memory.hpp"
+#include "memory/memory_tracer.hpp"
+#include "io/assert.hpp"
+
+namespace SFG
+{
+	namespace
+	{
+		// Matches the d3d12 pitch/placement rules so upload sizes come out the same as on the real backend.
+		constexpr uint32 TEXTURE_PITCH_ALIGNMENT	 = 256;
+		constexpr uint32 TEXTURE_PLACEMENT_ALIGNMENT = 512;
+	}
+
+	null_backend* null_backend::s_instance = nullptr;
+
+	null_backend* null_backend::create_instance()
+	{
+		SFG_ASSERT(s_instance == nullptr);
+		s_instance = new null_backend();
+		s_instance->init();
+		return s_instance;
+	}
+
+	void null_backend::destroy_instance()
+	{
+		s_instance->uninit();
+		delete s_instance;
+		s_instance = nullptr;
+	}
+
+	void null_backend::init()
+	{
+		_queue_graphics = create_queue({
+			.type		= command_type::graphics,
+			.debug_name = {"GfxQueue"},
+		});
+		_queue_transfer = create_queue({
+			.type		= command_type::transfer,
+			.debug_name = {"TransferQueue"},
+		});
+		_queue_compute	= create_queue({
+			 .type		 = command_type::compute,
+			 .debug_name = {"CmpQueue"},
+		 });
+	}
+
+	void null_backend::uninit()
+	{
+		destroy_queue(_queue_graphics);
+		destroy_queue(_queue_transfer);
+		destroy_queue(_queue_compute);
+
+		_resources.verify_uninit();
+		_textures.verify_uninit();
+		_samplers.verify_uninit();
+		_swapchains.verify_uninit();
+		_semaphores.verify_uninit();
+		_shaders.verify_uninit();
+		_bind_groups.verify_uninit();
+		_command_buffers.verify_uninit();
+		_command_allocators.verify_uninit();
+		_queues.verify_uninit();
+		_bind_layouts.verify_uninit();
+
+		_recording.destroy();
+	}
+
+	void null_backend::reset_command_buffer(gfx_id cmd_buffer)
+	{
+		_command_buffers.get(cmd_buffer).stream.shrink(0);
+	}
+
+	void null_backend::close_command_buffer(gfx_id cmd_buffer)
+	{
+	}
+
+	void null_backend::submit_commands(gfx_id queue, const gfx_id* commands, uint8 commands_count)
+	{
+		_submitted_commands += commands_count;
+
+		if (!_recording_enabled)
+			return;
+
+		for (uint8 i = 0; i < commands_count; i++)
+		{
+			const ostream& stream = _command_buffers.get(commands[i]).stream;
+			const uint32   size	  = static_cast<uint32>(stream.get_size());
+
+			_recording.write(RECORD_SUBMIT);
+			_recording.write(queue);
+			_recording.write(commands[i]);
+			_recording.write(size);
+			if (size != 0)
+				_recording.write_raw(stream.get_raw(), size);
+		}
+	}
+
+	void null_backend::queue_wait(gfx_id queue, const gfx_id* semaphores, const uint64* semaphore_values, uint8 semaphore_count)
+	{
+	}
+
+	void null_backend::queue_signal(gfx_id queue, const gfx_id* semaphores, const uint64* semaphore_values, uint8 semaphore_count)
+	{
+		// nothing runs asynchronously, whatever was submitted before the signal is done.
+		for (uint8 i = 0; i < semaphore_count; i++)
+			_semaphores.get(semaphores[i]).value = semaphore_values[i];
+	}
+
+	void null_backend::present(const gfx_id* swapchains, uint8 swapchain_count)
+	{
+		for (uint8 i = 0; i < swapchain_count; i++)
+		{
+			swapchain& swp	= _swapchains.get(swapchains[i]);
+			swp.image_index = static_cast<uint8>((swp.image_index + 1) % BACK_BUFFER_COUNT);
+		}
+
+		if (_recording_enabled)
+		{
+			_recording.write(RECORD_PRESENT);
+			_recording.write(swapchain_count);
+		}
+	}
+
+	bool null_backend::compile_shader_vertex_pixel(
+		const string& source, const vector<string>& defines, const char* source_path, const char* vertex_entry, const char* pixel_entry, span<uint8>& vertex_out, span<uint8>& pixel_out, bool compile_layout, span<uint8>& out_layout) const
+	{
+		// no compiler, shaders are created from empty blobs.
+		vertex_out = {};
+		pixel_out  = {};
+		out_layout = {};
+		return true;
+	}
+
+	bool null_backend::compile_shader_compute(const string& source, const char* source_path, const char* entry, span<uint8>& out, bool compile_layout, span<uint8>& out_layout) const
+	{
+		out		   = {};
+		out_layout = {};
+		return true;
+	}
+
+	gfx_id null_backend::create_resource(const resource_desc& desc)
+	{
+		PUSH_MEMORY_CATEGORY("Gfx");
+		PUSH_ALLOCATION_SZ(desc.size);
+		POP_MEMORY_CATEGORY();
+
+		VERIFY_RENDER_NOT_RUNNING();
+
+		const gfx_id id	 = _resources.add();
+		resource&	 res = _resources.get(id);
+		res.size		 = desc.size;
+		res.data		 = desc.size == 0 ? nullptr : reinterpret_cast<uint8*>(SFG_MALLOC(desc.size));
+		if (res.data)
+			SFG_MEMSET(res.data, 0, desc.size);
+		return id;
+	}
+
+	gfx_id null_backend::create_texture(const texture_desc& desc)
+	{
+		VERIFY_RENDER_NOT_RUNNING_OR_RENDER_THREAD();
+
+		const gfx_id id	 = _textures.add();
+		texture&	 txt = _textures.get(id);
+		txt.width		 = desc.size.x;
+		txt.height		 = desc.size.y;
+		txt.mip_levels	 = desc.mip_levels;
+		txt.format		 = static_cast<uint8>(desc.flags.is_set(texture_flags::tf_depth_texture) ? desc.depth_stencil_format : desc.texture_format);
+
+		const uint8 block_size = format_get_block_size(static_cast<format>(txt.format));
+		const uint8 bpp		   = block_size != 0 ? 0 : format_get_bpp(static_cast<format>(txt.format));
+		uint32		width	   = desc.size.x;
+		uint32		height	   = desc.size.y;
+		for (uint8 i = 0; i < desc.mip_levels; i++)
+		{
+			txt.size += (block_size != 0 ? ((width + 3) / 4) * ((height + 3) / 4) * block_size : width * height * bpp) * desc.array_length;
+			width  = width > 1 ? width / 2 : 1;
+			height = height > 1 ? height / 2 : 1;
+		}
+
+		PUSH_MEMORY_CATEGORY("Gfx");
+		PUSH_ALLOCATION_SZ(txt.size);
+		POP_MEMORY_CATEGORY();
+		return id;
+	}
+
+	gfx_id null_backend::create_sampler(const sampler_desc& desc)
+	{
+		return _samplers.add();
+	}
+
+	gfx_id null_backend::create_swapchain(const swapchain_desc& desc)
+	{
+		const gfx_id id	 = _swapchains.add();
+		swapchain&	 swp = _swapchains.get(id);
+		swp.width		 = desc.size.x;
+		swp.height		 = desc.size.y;
+		swp.format		 = static_cast<uint8>(desc.swapchain_format);
+		swp.image_index	 = 0;
+		return id;
+	}
+
+	gfx_id null_backend::recreate_swapchain(const swapchain_recreate_desc& desc)
+	{
+		swapchain& swp	= _swapchains.get(desc.swapchain);
+		swp.width		= desc.size.x;
+		swp.height		= desc.size.y;
+		swp.image_index = 0;
+		return desc.swapchain;
+	}
+
+	gfx_id null_backend::create_semaphore()
+	{
+		return _semaphores.add();
+	}
+
+	gfx_id null_backend::create_shader(const shader_desc& desc)
+	{
+		return _shaders.add();
+	}
+
+	gfx_id null_backend::create_empty_bind_group()
+	{
+		return _bind_groups.add();
+	}
+
+	gfx_id null_backend::create_command_buffer(const command_buffer_desc& desc)
+	{
+		const gfx_id	id = _command_buffers.add();
+		command_buffer& cb = _command_buffers.get(id);
+		cb.type			   = static_cast<uint8>(desc.type);
+		cb.stream.shrink(0);
+		return id;
+	}
+
+	gfx_id null_backend::create_command_allocator(uint8 ctype)
+	{
+		return _command_allocators.add();
+	}
+
+	gfx_id null_backend::create_queue(const queue_desc& desc)
+	{
+		const gfx_id id = _queues.add();
+		_queues.get(id).type = static_cast<uint8>(desc.type);
+		return id;
+	}
+
+	gfx_id null_backend::create_empty_bind_layout()
+	{
+		return _bind_layouts.add();
+	}
+
+	void null_backend::bind_group_add_descriptor(gfx_id group, uint8 root_param_index, uint8 binding_type)
+	{
+	}
+
+	void null_backend::bind_group_add_constant(gfx_id group, uint8 root_param_index, uint8* data, uint8 count)
+	{
+	}
+
+	void null_backend::bind_group_add_pointer(gfx_id group, uint8 root_param_index, uint8 count, bool is_sampler)
+	{
+	}
+
+	void null_backend::bind_layout_add_constant(gfx_id layout, uint32 count, uint32 set, uint32 binding, uint8 shader_stage_visibility)
+	{
+	}
+
+	void null_backend::bind_layout_add_descriptor(gfx_id layout, uint8 type, uint32 set, uint32 binding, uint8 shader_stage_visibility)
+	{
+	}
+
+	void null_backend::bind_layout_add_pointer(gfx_id layout, const vector<bind_layout_pointer_param>& pointer_params, uint8 shader_stage_visibility)
+	{
+	}
+
+	void null_backend::bind_layout_add_immutable_sampler(gfx_id layout, uint32 set, uint32 binding, const sampler_desc& desc, uint8 shader_stage_visibility)
+	{
+	}
+
+	void null_backend::finalize_bind_layout(gfx_id id, bool is_compute, const char* name)
+	{
+	}
+
+	void null_backend::bind_group_update_constants(gfx_id group, uint8 binding_index, uint8* constants, uint8 count)
+	{
+	}
+
+	void null_backend::bind_group_update_descriptor(gfx_id group, uint8 binding_index, gfx_id resource)
+	{
+	}
+
+	void null_backend::bind_group_update_pointer(gfx_id group, uint8 binding_index, const vector<bind_group_pointer>& updates)
+	{
+	}
+
+	void null_backend::destroy_resource(gfx_id id)
+	{
+		VERIFY_RENDER_NOT_RUNNING_OR_RENDER_THREAD();
+
+		resource& res = _resources.get(id);
+
+		PUSH_MEMORY_CATEGORY("Gfx");
+		PUSH_DEALLOCATION_SZ(res.size);
+		POP_MEMORY_CATEGORY();
+
+		if (res.data)
+			SFG_FREE(res.data);
+
+		_resources.remove(id);
+	}
+
+	void null_backend::destroy_texture(gfx_id id)
+	{
+		VERIFY_RENDER_NOT_RUNNING_OR_RENDER_THREAD();
+
+		PUSH_MEMORY_CATEGORY("Gfx");
+		PUSH_DEALLOCATION_SZ(_textures.get(id).size);
+		POP_MEMORY_CATEGORY();
+
+		_textures.remove(id);
+	}
+
+	void null_backend::destroy_sampler(gfx_id id)
+	{
+		_samplers.remove(id);
+	}
+
+	void null_backend::destroy_swapchain(gfx_id id)
+	{
+		_swapchains.remove(id);
+	}
+
+	void null_backend::destroy_semaphore(gfx_id id)
+	{
+		VERIFY_RENDER_NOT_RUNNING();
+		_semaphores.remove(id);
+	}
+
+	void null_backend::destroy_shader(gfx_id id)
+	{
+		_shaders.remove(id);
+	}
+
+	void null_backend::destroy_bind_group(gfx_id id)
+	{
+		_bind_groups.remove(id);
+	}
+
+	void null_backend::destroy_command_buffer(gfx_id id)
+	{
+		_command_buffers.get(id).stream.destroy();
+		_command_buffers.remove(id);
+	}
+
+	void null_backend::destroy_command_allocator(gfx_id id)
+	{
+		_command_allocators.remove(id);
+	}
+
+	void null_backend::destroy_queue(gfx_id id)
+	{
+		_queues.remove(id);
+	}
+
+	void null_backend::destroy_bind_layout(gfx_id id)
+	{
+		_bind_layouts.remove(id);
+	}
+
+	void null_backend::wait_semaphore(gfx_id id, uint64 value) const
+	{
+		// a wait for a value that was never signaled would dead-lock on a real device.
+		SFG_ASSERT(_semaphores.get(id).value >= value);
+	}
+
+	void null_backend::map_resource(gfx_id id, uint8*& ptr) const
+	{
+		ptr = _resources.get(id).data;
+	}
+
+	void null_backend::unmap_resource(gfx_id id) const
+	{
+	}
+
+	void* null_backend::get_shared_handle_for_texture(gfx_id id)
+	{
+		return nullptr;
+	}
+
+	uint32 null_backend::get_texture_size(uint32 width, uint32 height, uint32 bpp) const
+	{
+		const uint32 row_pitch = (width * bpp + (TEXTURE_PITCH_ALIGNMENT - 1)) & ~(TEXTURE_PITCH_ALIGNMENT - 1);
+		return row_pitch * height;
+	}
+
+	uint32 null_backend::align_texture_size(uint32 size) const
+	{
+		return (size + TEXTURE_PLACEMENT_ALIGNMENT - 1) & ~(TEXTURE_PLACEMENT_ALIGNMENT - 1);
+	}
+
+	void* null_backend::adjust_buffer_pitch(void* data, uint32 width, uint32 height, uint8 bpp, uint32& out_total_size) const
+	{
+		const uint32 _bpp	   = static_cast<uint32>(bpp);
+		const uint32 row_pitch = (width * _bpp + (TEXTURE_PITCH_ALIGNMENT - 1)) & ~(TEXTURE_PITCH_ALIGNMENT - 1);
+		out_total_size		   = row_pitch * height;
+		char* buffer		   = reinterpret_cast<char*>(new uint8[out_total_size]);
+		char* src			   = reinterpret_cast<char*>(data);
+		char* dst			   = buffer;
+
+		for (uint32 i = 0; i < height; ++i)
+		{
+			SFG_MEMCPY(dst, src, width * _bpp);
+			dst += row_pitch;
+			src += width * _bpp;
+		}
+
+		return buffer;
+	}
+
+	void null_backend::record_render_pass(gfx_id cmd_list, uint8 tid, const void* color_attachments, uint8 color_attachment_count, const void* depth_attachment) const
+	{
+		if (!_recording_enabled)
+			return;
+
+		ostream& stream = _command_buffers.get(cmd_list).stream;
+		stream.write(tid);
+		stream.write(color_attachment_count);
+
+		const render_pass_color_attachment* attachments = reinterpret_cast<const render_pass_color_attachment*>(color_attachments);
+		for (uint8 i = 0; i < color_attachment_count; i++)
+		{
+			const render_pass_color_attachment& att = attachments[i];
+			stream.write(att.texture);
+			stream.write(att.color_load_op);
+			stream.write(att.color_store_op);
+			stream.write(att.view_index);
+		}
+
+		if (depth_attachment)
+		{
+			const render_pass_depth_stencil_attachment& att = *reinterpret_cast<const render_pass_depth_stencil_attachment*>(depth_attachment);
+			stream.write(att.texture);
+			stream.write(att.depth_load_op);
+			stream.write(att.depth_store_op);
+			stream.write(att.clear_depth);
+			stream.write(att.view_index);
+		}
+	}
+
+	void null_backend::cmd_begin_render_pass(gfx_id cmd_list, const command_begin_render_pass& command)
+	{
+		record_render_pass(cmd_list, command_begin_render_pass::TID, command.color_attachments, command.color_attachment_count, nullptr);
+	}
+
+	void null_backend::cmd_begin_render_pass_depth(gfx_id cmd_list, const command_begin_render_pass_depth& command)
+	{
+		record_render_pass(cmd_list, command_begin_render_pass_depth::TID, command.color_attachments, command.color_attachment_count, &command.depth_stencil_attachment);
+	}
+
+	void null_backend::cmd_begin_render_pass_swapchain(gfx_id cmd_list, const command_begin_render_pass_swapchain& command)
+	{
+		record_render_pass(cmd_list, command_begin_render_pass_swapchain::TID, command.color_attachments, command.color_attachment_count, nullptr);
+	}
+
+	void null_backend::cmd_begin_render_pass_swapchain_depth(gfx_id cmd_list, const command_begin_render_pass_swapchain_depth& command)
+	{
+		record_render_pass(cmd_list, command_begin_render_pass_swapchain_depth::TID, command.color_attachments, command.color_attachment_count, &command.depth_stencil_attachment);
+	}
+
+	void null_backend::cmd_end_render_pass(gfx_id cmd_list, const command_end_render_pass& command) const
+	{
+		record(cmd_list, command_end_render_pass::TID);
+	}
+
+	void null_backend::cmd_set_scissors(gfx_id cmd_list, const command_set_scissors& command) const
+	{
+		record(cmd_list, command_set_scissors::TID, command.x, command.y, command.width, command.height);
+	}
+
+	void null_backend::cmd_set_viewport(gfx_id cmd_list, const command_set_viewport& command) const
+	{
+		record(cmd_list, command_set_viewport::TID, command.x, command.y, command.min_depth, command.max_depth, command.width, command.height);
+	}
+
+	void null_backend::cmd_bind_pipeline(gfx_id cmd_list, const command_bind_pipeline& command) const
+	{
+		record(cmd_list, command_bind_pipeline::TID, command.pipeline);
+	}
+
+	void null_backend::cmd_bind_pipeline_compute(gfx_id cmd_list, const command_bind_pipeline_compute& command) const
+	{
+		record(cmd_list, command_bind_pipeline_compute::TID, command.pipeline);
+	}
+
+	void null_backend::cmd_draw_instanced(gfx_id cmd_list, const command_draw_instanced& command) const
+	{
+		record(cmd_list, command_draw_instanced::TID, command.vertex_count_per_instance, command.instance_count, command.start_vertex_location, command.start_instance_location);
+	}
+
+	void null_backend::cmd_draw_indexed_instanced(gfx_id cmd_list, const command_draw_indexed_instanced& command) const
+	{
+		record(cmd_list, command_draw_indexed_instanced::TID, command.index_count_per_instance, command.instance_count, command.start_index_location, command.base_vertex_location, command.start_instance_location);
+	}
+
+	void null_backend::cmd_draw_indexed_indirect(gfx_id cmd_list, const command_draw_indexed_indirect& command) const
+	{
+		record(cmd_list, command_draw_indexed_indirect::TID, command.indirect_buffer, command.indirect_buffer_offset, command.count, command.indirect_signature);
+	}
+
+	void null_backend::cmd_draw_indirect(gfx_id cmd_list, const command_draw_indirect& command) const
+	{
+		record(cmd_list, command_draw_indirect::TID, command.indirect_buffer, command.indirect_buffer_offset, command.count, command.indirect_signature);
+	}
+
+	void null_backend::cmd_bind_vertex_buffers(gfx_id cmd_list, const command_bind_vertex_buffers& command) const
+	{
+		record(cmd_list, command_bind_vertex_buffers::TID, command.buffer, command.slot, command.vertex_size, command.offset);
+	}
+
+	void null_backend::cmd_bind_index_buffers(gfx_id cmd_list, const command_bind_index_buffers& command) const
+	{
+		record(cmd_list, command_bind_index_buffers::TID, command.buffer, command.offset, command.bit_depth);
+	}
+
+	void null_backend::cmd_copy_resource(gfx_id cmd_list, const command_copy_resource& command) const
+	{
+		// staging to gpu copies are real copies here, gpu side data can be inspected after submit.
+		const resource& src = _resources.get(command.source);
+		const resource& dst = _resources.get(command.destination);
+		if (src.data && dst.data)
+			SFG_MEMCPY(dst.data, src.data, src.size < dst.size ? src.size : dst.size);
+
+		record(cmd_list, command_copy_resource::TID, command.source, command.destination);
+	}
+
+	void null_backend::cmd_copy_buffer(gfx_id cmd_list, const command_copy_buffer& command) const
+	{
+		const resource& src = _resources.get(command.source);
+		const resource& dst = _resources.get(command.destination);
+		SFG_ASSERT(command.source_offset + command.size <= src.size && command.destination_offset + command.size <= dst.size);
+		if (src.data && dst.data)
+			SFG_MEMCPY(dst.data + command.destination_offset, src.data + command.source_offset, command.size);
+
+		record(cmd_list, command_copy_buffer::TID, command.source, command.destination, command.source_offset, command.destination_offset, command.size);
+	}
+
+	void null_backend::cmd_copy_buffer_to_texture(gfx_id cmd_list, const command_copy_buffer_to_texture& command)
+	{
+		record(cmd_list, command_copy_buffer_to_texture::TID, command.destination_texture, command.intermediate_buffer, command.mip_levels, command.destination_slice);
+	}
+
+	void null_backend::cmd_copy_texture_to_buffer(gfx_id cmd_list, const command_copy_texture_to_buffer& command) const
+	{
+		record(cmd_list, command_copy_texture_to_buffer::TID, command.dest_buffer, command.src_texture, command.src_layer, command.src_mip, command.size.x, command.size.y, command.bpp);
+	}
+
+	void null_backend::cmd_copy_texture_to_texture(gfx_id cmd_list, const command_copy_texture_to_texture& command) const
+	{
+		record(cmd_list,
+			   command_copy_texture_to_texture::TID,
+			   command.source,
+			   command.destination,
+			   command.source_layer,
+			   command.destination_layer,
+			   command.source_mip,
+			   command.source_total_mips,
+			   command.destination_mip,
+			   command.destination_total_mips);
+	}
+
+	void null_backend::cmd_bind_constants(gfx_id cmd_list, const command_bind_constants& command) const
+	{
+		if (!_recording_enabled)
+			return;
+
+		ostream& stream = _command_buffers.get(cmd_list).stream;
+		record(cmd_list, command_bind_constants::TID, command.offset, command.count, command.param_index);
+		stream.write_raw(reinterpret_cast<const uint8*>(command.data), static_cast<size_t>(command.count) * sizeof(uint32));
+	}
+
+	void null_backend::cmd_bind_layout(gfx_id cmd_list, const command_bind_layout& command) const
+	{
+		record(cmd_list, command_bind_layout::TID, command.layout);
+	}
+
+	void null_backend::cmd_bind_layout_compute(gfx_id cmd_list, const command_bind_layout_compute& command) const
+	{
+		record(cmd_list, command_bind_layout_compute::TID, command.layout);
+	}
+
+	void null_backend::cmd_bind_group(gfx_id cmd_list, const command_bind_group& command) const
+	{
+		record(cmd_list, command_bind_group::TID, command.group);
+	}
+
+	void null_backend::cmd_dispatch(gfx_id cmd_list, const command_dispatch& command) const
+	{
+		record(cmd_list, command_dispatch::TID, command.group_size_x, command.group_size_y, command.group_size_z);
+	}
+
+	void null_backend::cmd_barrier(gfx_id cmd_list, const command_barrier& command)
+	{
+		if (!_recording_enabled)
+			return;
+
+		ostream& stream = _command_buffers.get(cmd_list).stream;
+		record(cmd_list, command_barrier::TID, command.barrier_count);
+
+		for (uint16 i = 0; i < command.barrier_count; i++)
+		{
+			const barrier& b = command.barriers[i];
+			stream.write(b.resource);
+			stream.write(b.from_state);
+			stream.write(b.to_state);
+		}
+	}
+}
@@ -26,7 +26,10 @@ namespace SFG
 		gfx_backend* backend = gfx_backend::get();
 		_total_size			 = desc.size;
 		_hw_gpu				 = backend->create_resource(desc);
-		backend->map_resource(_hw_gpu, _mapped);
+
+		// gpu only buffers are filled through the upload ring.
+		if (desc.flags.is_set(resource_flags::rf_cpu_visible))
+			backend->map_resource(_hw_gpu, _mapped);
 	}
 
 	void buffer::destroy()
@@ -43,6 +46,7 @@ namespace SFG
 
 	void buffer::buffer_data(size_t padding, const void* data, size_t size)
 	{
+		SFG_ASSERT(_mapped != nullptr);
 		SFG_ASSERT(padding + size <= _total_size);
 		SFG_MEMCPY(_mapped + padding, data, size);
 		_flags.set(buf_dirty);
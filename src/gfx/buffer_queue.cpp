@@ -2,6 +2,12 @@
 
 #include "buffer_queue.hpp"
 #include "gfx/buffer.hpp"
+#include "gfx/backend/backend.hpp"
+#include "gfx/common/descriptions.hpp"
+#include "gfx/common/commands.hpp"
+#include "io/assert.hpp"
+#include "io/log.hpp"
+#include "memory/memory.hpp"
 
 namespace SFG
 {
@@ -9,10 +15,25 @@ namespace SFG
 	void buffer_queue::init()
 	{
 		_requests.reserve(256);
+		_ring_copies.reserve(256);
+		_gpu_copies.reserve(16);
+
+		gfx_backend* backend = gfx_backend::get();
+		_ring_hw			 = backend->create_resource({
+					.size		= UPLOAD_RING_SIZE,
+					.flags		= resource_flags::rf_cpu_visible,
+					.debug_name = "upload_ring",
+		});
+		backend->map_resource(_ring_hw, _ring_mapped);
+		_ring.init(UPLOAD_RING_SIZE);
 	}
 
 	void buffer_queue::uninit()
 	{
+		gfx_backend* backend = gfx_backend::get();
+		backend->unmap_resource(_ring_hw);
+		backend->destroy_resource(_ring_hw);
+		_ring_mapped = nullptr;
 	}
 
 	void buffer_queue::add_request(const buffer_request& req)
@@ -20,19 +41,132 @@ namespace SFG
 		_requests.push_back(req);
 	}
 
+	uint8* buffer_queue::allocate(gfx_id destination, uint32 destination_offset, uint32 size)
+	{
+		const size_t offset = _ring.allocate(size, UPLOAD_RING_ALIGNMENT);
+		if (offset == RING_INVALID_OFFSET)
+		{
+			SFG_ERR("upload ring is out of space, {0} bytes requested with {1} in use.", size, _ring.get_used());
+			SFG_ASSERT(false);
+			return nullptr;
+		}
+
+		_ring_copies.push_back({
+			.destination		= destination,
+			.destination_offset = destination_offset,
+			.source_offset		= static_cast<uint32>(offset),
+			.size				= size,
+		});
+		return _ring_mapped + offset;
+	}
+
+	void buffer_queue::upload(gfx_id destination, uint32 destination_offset, const void* data, uint32 size)
+	{
+		if (size == 0)
+			return;
+
+		uint8* ptr = allocate(destination, destination_offset, size);
+		if (ptr)
+			SFG_MEMCPY(ptr, data, size);
+	}
+
+	void buffer_queue::add_copy(gfx_id source, gfx_id destination, uint32 source_offset, uint32 destination_offset, uint32 size)
+	{
+		_gpu_copies.push_back({
+			.source				= source,
+			.destination		= destination,
+			.source_offset		= source_offset,
+			.destination_offset = destination_offset,
+			.size				= size,
+			.ring_index			= static_cast<uint32>(_ring_copies.size()),
+		});
+	}
+
+	uint64 buffer_queue::end_frame()
+	{
+		_ring.end_frame(++_ring_fence);
+		return _ring_fence;
+	}
+
+	void buffer_queue::retire(uint64 completed_fence)
+	{
+		_ring.retire(completed_fence);
+	}
+
 	void buffer_queue::flush_all(gfx_id cmd_list)
 	{
 		for (const buffer_request& buf : _requests)
-			buf.buffer->copy(cmd_list);
+			buf.target->copy(cmd_list);
 
 		_requests.resize(0);
+
+		gfx_backend* backend = gfx_backend::get();
+
+		// gpu copies keep their place among ring copies, ring writes recorded before one may be what it copies.
+		uint32 ring_begin = 0;
+		for (const gpu_copy& c : _gpu_copies)
+		{
+			flush_ring(cmd_list, ring_begin, c.ring_index);
+			ring_begin = c.ring_index;
+
+			backend->cmd_copy_buffer(cmd_list,
+									 {
+										 .source			 = c.source,
+										 .destination		 = c.destination,
+										 .source_offset		 = c.source_offset,
+										 .destination_offset = c.destination_offset,
+										 .size				 = c.size,
+									 });
+		}
+
+		flush_ring(cmd_list, ring_begin, static_cast<uint32>(_ring_copies.size()));
+		_gpu_copies.resize(0);
+		_ring_copies.resize(0);
+	}
+
+	void buffer_queue::flush_ring(gfx_id cmd_list, uint32 begin, uint32 end)
+	{
+		if (begin == end)
+			return;
+
+		// back to back writes that continue each other on both sides go out as one copy. Never reordered, a later write over the same bytes has to land last.
+		gfx_backend* backend = gfx_backend::get();
+		ring_copy	 current = _ring_copies[begin];
+
+		for (uint32 i = begin + 1; i <= end; i++)
+		{
+			if (i < end)
+			{
+				const ring_copy& next = _ring_copies[i];
+				if (next.destination == current.destination && next.destination_offset == current.destination_offset + current.size && next.source_offset == current.source_offset + current.size)
+				{
+					current.size += next.size;
+					continue;
+				}
+			}
+
+			backend->cmd_copy_buffer(cmd_list,
+									 {
+										 .source			 = _ring_hw,
+										 .destination		 = current.destination,
+										 .source_offset		 = current.source_offset,
+										 .destination_offset = current.destination_offset,
+										 .size				 = current.size,
+									 });
+
+			if (i < end)
+				current = _ring_copies[i];
+		}
 	}
 
 	bool buffer_queue::empty() const
 	{
+		if (!_ring_copies.empty() || !_gpu_copies.empty())
+			return false;
+
 		for (const buffer_request& buf : _requests)
 		{
-			if (buf.buffer->is_dirty())
+			if (buf.target->is_dirty())
 				return false;
 		}
 
@@ -3,17 +3,21 @@
 #pragma once
 #include "data/vector.hpp"
 #include "gfx/common/gfx_constants.hpp"
+#include "memory/ring_allocator.hpp"
 
 namespace SFG
 {
 	class buffer;
 
+#define UPLOAD_RING_SIZE	  (16 * 1024 * 1024)
+#define UPLOAD_RING_ALIGNMENT 4
+
 	class buffer_queue
 	{
 	public:
 		struct buffer_request
 		{
-			buffer* buffer = nullptr;
+			buffer* target = nullptr;
 		};
 
 		void init();
@@ -22,7 +26,50 @@ namespace SFG
 		void flush_all(gfx_id cmd);
 		bool empty() const;
 
+		/// Space in the persistently mapped upload ring, the caller writes size bytes that land in destination at destination_offset with the next flush.
+		uint8* allocate(gfx_id destination, uint32 destination_offset, uint32 size);
+		void   upload(gfx_id destination, uint32 destination_offset, const void* data, uint32 size);
+
+		/// Gpu side copy between buffers, recorded ahead of the frame's ring copies.
+		void add_copy(gfx_id source, gfx_id destination, uint32 source_offset, uint32 destination_offset, uint32 size);
+
+		/// Ring space is fenced per frame, end_frame returns the fence of everything allocated since the previous one.
+		uint64 end_frame();
+		void   retire(uint64 completed_fence);
+
+		inline const ring_allocator& get_ring() const
+		{
+			return _ring;
+		}
+
+	private:
+		struct ring_copy
+		{
+			gfx_id destination		  = 0;
+			uint32 destination_offset = 0;
+			uint32 source_offset	  = 0;
+			uint32 size				  = 0;
+		};
+
+		struct gpu_copy
+		{
+			gfx_id source			  = 0;
+			gfx_id destination		  = 0;
+			uint32 source_offset	  = 0;
+			uint32 destination_offset = 0;
+			uint32 size				  = 0;
+			uint32 ring_index		  = 0;
+		};
+
+		void flush_ring(gfx_id cmd_list, uint32 begin, uint32 end);
+
 	private:
-		vector<buffer_request> _requests = {};
+		vector<buffer_request> _requests	= {};
+		vector<gpu_copy>	   _gpu_copies	= {};
+		vector<ring_copy>	   _ring_copies = {};
+		ring_allocator		   _ring		= {};
+		uint8*				   _ring_mapped = nullptr;
+		uint64				   _ring_fence	= 0;
+		gfx_id				   _ring_hw		= 0;
 	};
 } // namespace Lina
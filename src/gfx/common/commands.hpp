@@ -55,11 +55,11 @@ namespace SFG
 
 	struct render_pass_color_attachment
 	{
-		vector4	 clear_color = vector4(0, 0, 0, 1);
-		gfx_id	 texture	 = 0;
-		load_op	 load_op	 = load_op::clear;
-		store_op store_op	 = store_op::store;
-		uint8	 view_index	 = 0;
+		vector4	 clear_color	= vector4(0, 0, 0, 1);
+		gfx_id	 texture		= 0;
+		load_op	 color_load_op	= load_op::clear;
+		store_op color_store_op	= store_op::store;
+		uint8	 view_index		= 0;
 	};
 
 	struct render_pass_depth_stencil_attachment
@@ -198,6 +198,17 @@ namespace SFG
 		gfx_id destination = 0;
 	};
 
+	struct command_copy_buffer
+	{
+		static constexpr uint8 TID = 25;
+
+		gfx_id source			  = 0;
+		gfx_id destination		  = 0;
+		uint32 source_offset	  = 0;
+		uint32 destination_offset = 0;
+		uint32 size				  = 0;
+	};
+
 	struct command_copy_texture_to_buffer
 	{
 		static constexpr uint8 TID = 10;
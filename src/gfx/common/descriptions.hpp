@@ -119,13 +119,13 @@ namespace SFG
 
 	struct swapchain_desc
 	{
-		void*		   window	 = nullptr;
-		void*		   os_handle = nullptr;
-		float		   scaling	 = 1.0f;
-		format		   format	 = format::undefined;
-		vector2ui16	   pos		 = vector2ui16::zero;
-		vector2ui16	   size		 = vector2ui16::zero;
-		bitmask<uint8> flags	 = 0;
+		void*		   window			= nullptr;
+		void*		   os_handle		= nullptr;
+		float		   scaling			= 1.0f;
+		format		   swapchain_format	= format::undefined;
+		vector2ui16	   pos				= vector2ui16::zero;
+		vector2ui16	   size				= vector2ui16::zero;
+		bitmask<uint8> flags			= 0;
 	};
 
 	struct swapchain_recreate_desc
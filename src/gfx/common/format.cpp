@@ -40,6 +40,18 @@ namespace SFG
 		case format::r8g8b8a8_unorm:
 		case format::r8g8b8a8_srgb:
 			return 4;
+
+			// source pixels the blocks are encoded from, bc5 reads r & g out of rgba.
+		case format::bc4_block_unorm:
+			return 1;
+		case format::bc1_block_srgb:
+		case format::bc1_block_unorm:
+		case format::bc3_block_srgb:
+		case format::bc3_block_unorm:
+		case format::bc5_block_unorm:
+		case format::bc7_block_srgb:
+		case format::bc7_block_unorm:
+			return 4;
 		default:
 			break;
 		}
@@ -52,7 +64,9 @@ namespace SFG
 		switch (fmt)
 		{
 		case format::b8g8r8a8_srgb:
+		case format::bc1_block_srgb:
 		case format::bc3_block_srgb:
+		case format::bc7_block_srgb:
 		case format::r8g8b8a8_srgb:
 			return false;
 		default:
@@ -63,6 +77,25 @@ namespace SFG
 		return true;
 	}
 
+	uint8 format_get_block_size(format fmt)
+	{
+		switch (fmt)
+		{
+		case format::bc1_block_srgb:
+		case format::bc1_block_unorm:
+		case format::bc4_block_unorm:
+			return 8;
+		case format::bc3_block_srgb:
+		case format::bc3_block_unorm:
+		case format::bc5_block_unorm:
+		case format::bc7_block_srgb:
+		case format::bc7_block_unorm:
+			return 16;
+		default:
+			return 0;
+		}
+	}
+
 #ifdef SFG_TOOLMODE
 	void to_json(nlohmann::json& j, const format& f)
 	{
@@ -95,6 +128,30 @@ namespace SFG
 		case format::d32_sfloat:
 			j = "d32_sfloat";
 			return;
+		case format::bc1_block_srgb:
+			j = "bc1_srgb";
+			return;
+		case format::bc1_block_unorm:
+			j = "bc1_unorm";
+			return;
+		case format::bc3_block_srgb:
+			j = "bc3_srgb";
+			return;
+		case format::bc3_block_unorm:
+			j = "bc3_unorm";
+			return;
+		case format::bc4_block_unorm:
+			j = "bc4_unorm";
+			return;
+		case format::bc5_block_unorm:
+			j = "bc5_unorm";
+			return;
+		case format::bc7_block_srgb:
+			j = "bc7_srgb";
+			return;
+		case format::bc7_block_unorm:
+			j = "bc7_unorm";
+			return;
 		}
 
 		j = "undefined";
@@ -151,6 +208,54 @@ namespace SFG
 			return;
 		}
 
+		if (str.compare("bc1_srgb") == 0)
+		{
+			f = format::bc1_block_srgb;
+			return;
+		}
+
+		if (str.compare("bc1_unorm") == 0)
+		{
+			f = format::bc1_block_unorm;
+			return;
+		}
+
+		if (str.compare("bc3_srgb") == 0)
+		{
+			f = format::bc3_block_srgb;
+			return;
+		}
+
+		if (str.compare("bc3_unorm") == 0)
+		{
+			f = format::bc3_block_unorm;
+			return;
+		}
+
+		if (str.compare("bc4_unorm") == 0)
+		{
+			f = format::bc4_block_unorm;
+			return;
+		}
+
+		if (str.compare("bc5_unorm") == 0)
+		{
+			f = format::bc5_block_unorm;
+			return;
+		}
+
+		if (str.compare("bc7_srgb") == 0)
+		{
+			f = format::bc7_block_srgb;
+			return;
+		}
+
+		if (str.compare("bc7_unorm") == 0)
+		{
+			f = format::bc7_block_unorm;
+			return;
+		}
+
 		f = format::undefined;
 	}
 #endif
@@ -79,12 +79,19 @@ namespace SFG
 		r10g0b10a2_int,
 		bc3_block_srgb,
 		bc3_block_unorm,
+		bc1_block_srgb,
+		bc1_block_unorm,
+		bc4_block_unorm,
+		bc5_block_unorm,
+		bc7_block_srgb,
+		bc7_block_unorm,
 		format_max,
 	};
 
 	extern uint8 format_get_bpp(format fmt);
 	extern uint8 format_get_channels(format fmt);
 	extern bool	 format_is_linear(format fmt);
+	extern uint8 format_get_block_size(format fmt); // bytes per 4x4 block, 0 if not block compressed.
 
 #ifdef SFG_TOOLMODE
 	void to_json(nlohmann::json& j, const format& f);
@@ -15,9 +15,11 @@ namespace SFG
 #define MAX_COMMAND_BUFFERS			 256
 #define MAX_QUEUES					 8
 #define MAX_DESCRIPTOR_HANDLES		 1024
-#define COMMANDS_MAX_TID			 25
+#define COMMANDS_MAX_TID			 26
 #define MAX_TEXTURE_MIPS			 16
 #define MAX_MATERIAL_SHADER_VARIANTS 8
+#define MAX_MESH_LODS				 4
+#define MAX_MATERIAL_TEXTURES		 4
 
 #define FRAMES_IN_FLIGHT	2
 #define BACK_BUFFER_COUNT	3
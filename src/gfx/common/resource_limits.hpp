@@ -15,7 +15,7 @@ namespace SFG
 #define MAX_COMMAND_BUFFERS	   256
 #define MAX_QUEUES			   8
 #define MAX_DESCRIPTOR_HANDLES 1024
-#define COMMANDS_MAX_TID	   25
+#define COMMANDS_MAX_TID	   26
 
 	typedef unsigned short gfx_id;
 }
\ No newline at end of file
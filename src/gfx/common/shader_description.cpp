@@ -16,17 +16,17 @@ namespace SFG
 		j["index"]	  = s.index;
 		j["offset"]	  = s.offset;
 		j["size"]	  = s.size;
-		j["format"]	  = s.format;
+		j["format"]	  = s.input_format;
 	}
 
 	void from_json(const nlohmann::json& j, vertex_input& s)
 	{
-		s.name	   = j.value<string>("name", "");
-		s.location = j.value<uint8>("location", 0);
-		s.index	   = j.value<uint8>("index", 0);
-		s.offset   = j.value<uint8>("offset", 0);
-		s.size	   = j.value<uint32>("size", 0);
-		s.format   = j.value<format>("format", format::undefined);
+		s.name		   = j.value<string>("name", "");
+		s.location	   = j.value<uint8>("location", 0);
+		s.index		   = j.value<uint8>("index", 0);
+		s.offset	   = j.value<uint8>("offset", 0);
+		s.size		   = j.value<uint32>("size", 0);
+		s.input_format = j.value<format>("format", format::undefined);
 	}
 
 	void to_json(nlohmann::json& j, const shader_desc& s)
@@ -564,19 +564,19 @@ namespace SFG
 
 	void to_json(nlohmann::json& j, const shader_color_attachment& att)
 	{
-		j["format"]			  = att.format;
+		j["format"]			  = att.attachment_format;
 		j["blend_attachment"] = att.blend_attachment;
 	}
 
 	void from_json(const nlohmann::json& j, shader_color_attachment& att)
 	{
-		att.format			 = j.value<format>("format", format::undefined);
-		att.blend_attachment = j.value<color_blend_attachment>("blend_attachment", {});
+		att.attachment_format = j.value<format>("format", format::undefined);
+		att.blend_attachment  = j.value<color_blend_attachment>("blend_attachment", {});
 	}
 
 	void to_json(nlohmann::json& j, const stencil_state& ss)
 	{
-		j["compare_op"]	   = ss.compare_op;
+		j["compare_op"]	   = ss.cmp_op;
 		j["depth_fail_op"] = ss.depth_fail_op;
 		j["fail_op"]	   = ss.fail_op;
 		j["pass_op"]	   = ss.pass_op;
@@ -584,7 +584,7 @@ namespace SFG
 
 	void from_json(const nlohmann::json& j, stencil_state& ss)
 	{
-		ss.compare_op	 = j.value("compare_op", compare_op::always);
+		ss.cmp_op		 = j.value("compare_op", compare_op::always);
 		ss.depth_fail_op = j.value("depth_fail_op", stencil_op::keep);
 		ss.fail_op		 = j.value("fail_op", stencil_op::keep);
 		ss.pass_op		 = j.value("pass_op", stencil_op::keep);
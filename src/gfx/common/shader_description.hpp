@@ -140,12 +140,12 @@ namespace SFG
 
 	struct vertex_input
 	{
-		string name		= "TEXCOORD";
-		uint8  location = 0;
-		uint8  index	= 0;
-		size_t offset	= 0;
-		size_t size		= 0;
-		format format	= format::undefined;
+		string name			= "TEXCOORD";
+		uint8  location		= 0;
+		uint8  index		= 0;
+		size_t offset		= 0;
+		size_t size			= 0;
+		format input_format	= format::undefined;
 	};
 
 	struct shader_blob
@@ -176,8 +176,8 @@ namespace SFG
 
 	struct shader_color_attachment
 	{
-		format				   format			= format::b8g8r8a8_srgb;
-		color_blend_attachment blend_attachment = {};
+		format				   attachment_format = format::b8g8r8a8_srgb;
+		color_blend_attachment blend_attachment	 = {};
 	};
 
 	enum depth_stencil_flags
@@ -192,7 +192,7 @@ namespace SFG
 		stencil_op fail_op		 = stencil_op::keep;
 		stencil_op pass_op		 = stencil_op::keep;
 		stencil_op depth_fail_op = stencil_op::keep;
-		compare_op compare_op	 = compare_op::always;
+		compare_op cmp_op		 = compare_op::always;
 	};
 
 	struct shader_depth_stencil_desc
@@ -7,9 +7,25 @@ namespace SFG
 {
 	struct texture_buffer
 	{
-		uint8*		pixels = nullptr;
-		vector2ui16 size   = vector2ui16::zero;
-		uint8		bpp	   = 0;
+		uint8*		pixels	   = nullptr;
+		vector2ui16 size	   = vector2ui16::zero;
+		uint8		bpp		   = 0;
+		uint8		block_size = 0; // bytes per 4x4 block for block compressed data, rows below are block rows then.
+
+		inline uint32 get_row_pitch() const
+		{
+			return block_size != 0 ? ((static_cast<uint32>(size.x) + 3) / 4) * block_size : static_cast<uint32>(size.x) * bpp;
+		}
+
+		inline uint32 get_row_count() const
+		{
+			return block_size != 0 ? (static_cast<uint32>(size.y) + 3) / 4 : static_cast<uint32>(size.y);
+		}
+
+		inline size_t get_data_size() const
+		{
+			return static_cast<size_t>(get_row_pitch()) * get_row_count();
+		}
 	};
 
-}
\ No newline at end of file
+}
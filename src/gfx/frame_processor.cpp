@@ -4,9 +4,7 @@
 #include "memory/memory.hpp"
 #include "math/math_common.hpp"
 #include "gfx/backend/backend.hpp"
-#include <algorithm>
-#include <execution>
-#include <ranges>
+#include "thread/job_system.hpp"
 
 namespace SFG
 {
@@ -65,19 +63,19 @@ namespace SFG
 
 				gfx_id*		 cmd_buffers	  = event->command_buffers;
 				record_func* record_callbacks = event->command_record_callbacks;
-				const int	 count			  = static_cast<int>(event->command_buffer_count);
+				const uint32 count			  = static_cast<uint32>(event->command_buffer_count);
 
-				std::for_each_n(std::execution::par, cmd_buffers, count, [backend, cmd_buffers, record_callbacks](gfx_id& id) {
-					const int n = std::distance(cmd_buffers, &id);
-					backend->reset_command_buffer(id);
-					record_callbacks[n](id);
-					backend->close_command_buffer(id);
+				// command buffers record independently, one job each.
+				job_system::get().parallel_for(count, 1, [backend, cmd_buffers, record_callbacks](uint32 i) {
+					backend->reset_command_buffer(cmd_buffers[i]);
+					record_callbacks[i](cmd_buffers[i]);
+					backend->close_command_buffer(cmd_buffers[i]);
 				});
 
 				if (event->wait_count != 0)
 					backend->queue_wait(event->queue, event->wait_semaphores, event->wait_values, static_cast<uint8>(event->wait_count));
 
-				gfx_backend::get()->submit_commands(event->queue, cmd_buffers, count);
+				gfx_backend::get()->submit_commands(event->queue, cmd_buffers, static_cast<uint8>(count));
 
 				if (event->signal_count != 0)
 					backend->queue_signal(event->queue, event->signal_semaphores, event->signal_values, static_cast<uint8>(event->signal_count));
@@ -5,6 +5,7 @@
 #include "data/bitmask.hpp"
 #include "gfx/common/gfx_common.hpp"
 #include "io/assert.hpp"
+#include "math/math_common.hpp"
 #include "memory/memory.hpp"
 #include <functional>
 
@@ -12,6 +12,7 @@
 #include "io/log.hpp"
 #include "common/system_info.hpp"
 #include "platform/time.hpp"
+#include "common/profiler.hpp"
 #include "world/world.hpp"
 #include "gfx/world/world_renderer.hpp"
 #include "resources/shader_raw.hpp"
@@ -29,13 +30,13 @@ namespace SFG
 		gfx_backend* backend = gfx_backend::get();
 
 		_gfx_data.swapchain = backend->create_swapchain({
-			.window	   = main_window->get_window_handle(),
-			.os_handle = main_window->get_platform_handle(),
-			.scaling   = 1.0f,
-			.format	   = RT_FORMAT,
-			.pos	   = vector2ui16::zero,
-			.size	   = main_window->get_size(),
-			.flags	   = swapchain_flags::sf_allow_tearing | swapchain_flags::sf_vsync_every_v_blank,
+			.window			  = main_window->get_window_handle(),
+			.os_handle		  = main_window->get_platform_handle(),
+			.scaling		  = 1.0f,
+			.swapchain_format = RT_FORMAT,
+			.pos			  = vector2ui16::zero,
+			.size			  = main_window->get_size(),
+			.flags			  = swapchain_flags::sf_allow_tearing | swapchain_flags::sf_vsync_every_v_blank,
 		});
 
 		_gfx_data.bind_layout_global = gfx_util::create_bind_layout_global();
@@ -157,6 +158,7 @@ namespace SFG
 			per_frame_data& pfd = _pfd[i];
 			SFG_TRACE("Waiting for backend {0}", pfd.sem_frame.value);
 			backend->wait_semaphore(pfd.sem_frame.semaphore, pfd.sem_frame.value);
+		_buffer_queue.retire(pfd.upload_fence);
 		}
 
 		_gfx_data.frame_index = 0;
@@ -165,6 +167,7 @@ namespace SFG
 
 	void renderer::populate_render_data(uint8 index, double interpolation)
 	{
+		SFG_PROFILE_FUNCTION();
 		render_data& write_data = _render_data[index];
 		write_data				= {};
 
@@ -176,6 +179,7 @@ namespace SFG
 
 	void renderer::render(uint8 index, const vector2ui16& size)
 	{
+		SFG_PROFILE_FUNCTION();
 		gfx_backend* backend   = gfx_backend::get();
 		const gfx_id queue_gfx = backend->get_queue_gfx();
 
@@ -190,7 +194,10 @@ namespace SFG
 		alloc.reset();
 
 		// Wait for frame's fence, then send any uploads needed.
-		backend->wait_semaphore(pfd.sem_frame.semaphore, pfd.sem_frame.value);
+		{
+			SFG_PROFILE_ZONE("wait_frame");
+			backend->wait_semaphore(pfd.sem_frame.semaphore, pfd.sem_frame.value);
+		}
 
 		const buf_engine_global globals = {};
 		pfd.buf_engine_global.buffer_data(0, (void*)&globals, sizeof(buf_engine_global));
@@ -209,6 +216,7 @@ namespace SFG
 		_world_renderer->upload(index, frame_index);
 		_debug_controller.upload(_buffer_queue, frame_index);
 		send_uploads(frame_index);
+		pfd.upload_fence			 = _buffer_queue.end_frame();
 		const uint64 next_copy_value = pfd.sem_copy.value;
 
 		/*
@@ -241,8 +249,8 @@ namespace SFG
 		{
 			render_pass_color_attachment* attachment = alloc.allocate<render_pass_color_attachment>(1);
 			attachment->clear_color					 = vector4(0.8f, 0.7f, 0.7f, 1.0f);
-			attachment->load_op						 = load_op::clear;
-			attachment->store_op					 = store_op::store;
+			attachment->color_load_op				 = load_op::clear;
+			attachment->color_store_op				 = store_op::store;
 			attachment->texture						 = render_target;
 
 			backend->cmd_begin_render_pass_swapchain(cmd_list, {.color_attachments = attachment, .color_attachment_count = 1});
@@ -280,7 +288,10 @@ namespace SFG
 		const int64 time_before = time::get_cpu_microseconds();
 #endif
 
-		backend->present(&render_target, 1);
+		{
+			SFG_PROFILE_ZONE("present");
+			backend->present(&render_target, 1);
+		}
 
 #ifndef SFG_PRODUCTION
 		const int64 present_time = time::get_cpu_microseconds() - time_before;
@@ -334,6 +345,7 @@ namespace SFG
 
 	void renderer::send_uploads(uint8 frame_index)
 	{
+		SFG_PROFILE_FUNCTION();
 		per_frame_data& pfd		= _pfd[frame_index];
 		gfx_backend*	backend = gfx_backend::get();
 		const gfx_id	queue	= backend->get_queue_transfer();
@@ -79,6 +79,7 @@ namespace SFG
 			buffer		   buf_engine_global	= {};
 			semaphore_data sem_frame			= {};
 			semaphore_data sem_copy				= {};
+			uint64		   upload_fence			= 0;
 			gfx_id		   cmd_gfx				= 0;
 			gfx_id		   cmd_copy				= 0;
 			gfx_id		   bind_group_global	= 0;
@@ -0,0 +1,1347 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "block_compressor.hpp"
+#include "gfx/common/texture_buffer.hpp"
+#include "memory/memory.hpp"
+#include "memory/memory_tracer.hpp"
+#include "thread/job_system.hpp"
+#include "io/assert.hpp"
+#include "math/math.hpp"
+#include <cmath>
+#include <bit>
+
+namespace SFG
+{
+#define BC_REFINE_ITERATIONS 2
+
+	namespace
+	{
+		// bc7 interpolation weights, out of 64.
+		constexpr uint32 BC7_WEIGHTS3[8]  = {0, 9, 18, 27, 37, 46, 55, 64};
+		constexpr uint32 BC7_WEIGHTS4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+		// two subset partitions, bit i set means pixel i belongs to subset 1.
+		constexpr uint16 BC7_PARTITIONS2[64] = {
+			0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80, 0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+			0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE, 0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+			0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A, 0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+			0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C, 0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+		};
+
+		// subset 1 anchor pixel per partition, the msb of its index is implied 0. Subset 0 anchors on pixel 0.
+		constexpr uint8 BC7_ANCHORS2[64] = {
+			15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 2, 8, 2, 2, 8, 8, 15, 2, 8, 2, 2, 8, 8, 2, 2,
+			15, 15, 6, 8, 2, 8, 15, 15, 2, 8, 2, 2, 2, 15, 15, 6, 6, 2, 6, 8, 15, 15, 2, 2, 15, 15, 15, 15, 15, 2, 2, 15,
+		};
+
+		struct bit_writer
+		{
+			uint8* data = nullptr;
+			uint32 pos	= 0;
+
+			inline void write(uint32 value, uint32 bits)
+			{
+				for (uint32 i = 0; i < bits; i++, pos++)
+				{
+					if ((value >> i) & 1)
+						data[pos >> 3] |= static_cast<uint8>(1 << (pos & 7));
+				}
+			}
+		};
+
+		struct bit_reader
+		{
+			const uint8* data = nullptr;
+			uint32		 pos  = 0;
+
+			inline uint32 read(uint32 bits)
+			{
+				uint32 value = 0;
+				for (uint32 i = 0; i < bits; i++, pos++)
+					value |= static_cast<uint32>((data[pos >> 3] >> (pos & 7)) & 1) << i;
+				return value;
+			}
+		};
+
+		inline int32 clamp_byte(int32 v)
+		{
+			return v < 0 ? 0 : (v > 255 ? 255 : v);
+		}
+
+		inline float clamp_float(float v, float mn, float mx)
+		{
+			return v < mn ? mn : (v > mx ? mx : v);
+		}
+
+		inline uint32 expand_bits(uint32 value, uint32 bits)
+		{
+			return (value << (8 - bits)) | (value >> (2 * bits - 8));
+		}
+
+		/*
+			Shared fitting helpers.
+		*/
+
+		/// Mean & principal axis of the masked pixels over the first N channels, power iteration on the covariance. Axis is zero if they are all equal.
+		template <uint32 N> void principal_axis(const uint8* rgba, uint32 mask, float* mean, float* axis)
+		{
+			float  sum[N] = {};
+			uint32 count  = 0;
+			for (uint32 i = 0; i < 16; i++)
+			{
+				if (!((mask >> i) & 1))
+					continue;
+				for (uint32 c = 0; c < N; c++)
+					sum[c] += static_cast<float>(rgba[i * 4 + c]);
+				count++;
+			}
+
+			const float inv = count == 0 ? 0.0f : 1.0f / static_cast<float>(count);
+			for (uint32 c = 0; c < N; c++)
+			{
+				mean[c] = sum[c] * inv;
+				axis[c] = 0.0f;
+			}
+
+			float cov[N][N] = {};
+			for (uint32 i = 0; i < 16; i++)
+			{
+				if (!((mask >> i) & 1))
+					continue;
+				float d[N];
+				for (uint32 c = 0; c < N; c++)
+					d[c] = static_cast<float>(rgba[i * 4 + c]) - mean[c];
+				for (uint32 r = 0; r < N; r++)
+				{
+					for (uint32 c = r; c < N; c++)
+						cov[r][c] += d[r] * d[c];
+				}
+			}
+
+			for (uint32 r = 0; r < N; r++)
+			{
+				for (uint32 c = 0; c < r; c++)
+					cov[r][c] = cov[c][r];
+			}
+
+			// start from the channel with the largest spread so a zero first guess can't happen on non degenerate input.
+			float  v[N]	 = {};
+			uint32 major = 0;
+			for (uint32 c = 1; c < N; c++)
+			{
+				if (cov[c][c] > cov[major][major])
+					major = c;
+			}
+
+			if (cov[major][major] < MATH_EPS)
+				return;
+
+			for (uint32 c = 0; c < N; c++)
+				v[c] = cov[major][c];
+
+			for (uint32 it = 0; it < 8; it++)
+			{
+				float next[N] = {};
+				float len	  = 0.0f;
+				for (uint32 r = 0; r < N; r++)
+				{
+					for (uint32 c = 0; c < N; c++)
+						next[r] += cov[r][c] * v[c];
+					len += next[r] * next[r];
+				}
+
+				if (len < MATH_EPS)
+					break;
+
+				const float inv_len = 1.0f / std::sqrt(len);
+				for (uint32 c = 0; c < N; c++)
+					v[c] = next[c] * inv_len;
+			}
+
+			for (uint32 c = 0; c < N; c++)
+				axis[c] = v[c];
+		}
+
+		/// Extremes of the masked pixels projected on the axis.
+		template <uint32 N> void axis_endpoints(const uint8* rgba, uint32 mask, const float* mean, const float* axis, float* e0, float* e1)
+		{
+			float t_min = MATH_INF_F, t_max = -MATH_INF_F;
+			for (uint32 i = 0; i < 16; i++)
+			{
+				if (!((mask >> i) & 1))
+					continue;
+				float t = 0.0f;
+				for (uint32 c = 0; c < N; c++)
+					t += (static_cast<float>(rgba[i * 4 + c]) - mean[c]) * axis[c];
+				t_min = t < t_min ? t : t_min;
+				t_max = t > t_max ? t : t_max;
+			}
+
+			if (t_min > t_max)
+				t_min = t_max = 0.0f;
+
+			for (uint32 c = 0; c < N; c++)
+			{
+				e0[c] = clamp_float(mean[c] + axis[c] * t_min, 0.0f, 255.0f);
+				e1[c] = clamp_float(mean[c] + axis[c] * t_max, 0.0f, 255.0f);
+			}
+		}
+
+		/// Least squares endpoints for fixed interpolation weights (fraction of e1 per pixel). Returns false if the system is singular.
+		template <uint32 N> bool solve_endpoints(const uint8* rgba, uint32 mask, const float* weights, float* e0, float* e1)
+		{
+			float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+			float ax[N] = {}, bx[N] = {};
+			for (uint32 i = 0; i < 16; i++)
+			{
+				if (!((mask >> i) & 1))
+					continue;
+				const float b = weights[i];
+				const float a = 1.0f - b;
+				aa += a * a;
+				ab += a * b;
+				bb += b * b;
+				for (uint32 c = 0; c < N; c++)
+				{
+					const float x = static_cast<float>(rgba[i * 4 + c]);
+					ax[c] += a * x;
+					bx[c] += b * x;
+				}
+			}
+
+			const float det = aa * bb - ab * ab;
+			if (std::fabs(det) < MATH_EPS)
+				return false;
+
+			const float inv = 1.0f / det;
+			for (uint32 c = 0; c < N; c++)
+			{
+				e0[c] = clamp_float((ax[c] * bb - bx[c] * ab) * inv, 0.0f, 255.0f);
+				e1[c] = clamp_float((bx[c] * aa - ax[c] * ab) * inv, 0.0f, 255.0f);
+			}
+			return true;
+		}
+
+		void fetch_block(const texture_buffer& src, uint32 bx, uint32 by, uint8* rgba)
+		{
+			const uint32 w = src.size.x, h = src.size.y;
+			for (uint32 y = 0; y < 4; y++)
+			{
+				const uint32 sy = by * 4 + y < h ? by * 4 + y : h - 1;
+				for (uint32 x = 0; x < 4; x++)
+				{
+					const uint32 sx	 = bx * 4 + x < w ? bx * 4 + x : w - 1;
+					const uint8* p	 = src.pixels + (static_cast<size_t>(sy) * w + sx) * src.bpp;
+					uint8*		 out = rgba + (y * 4 + x) * 4;
+
+					if (src.bpp == 4)
+					{
+						out[0] = p[0];
+						out[1] = p[1];
+						out[2] = p[2];
+						out[3] = p[3];
+					}
+					else
+					{
+						out[0] = p[0];
+						out[1] = 0;
+						out[2] = 0;
+						out[3] = 255;
+					}
+				}
+			}
+		}
+
+		/*
+			BC1 color block.
+		*/
+
+		struct bc1_tables
+		{
+			uint8 third5[256][2]; // endpoints whose 2/3 : 1/3 mix lands closest to the value.
+			uint8 third6[256][2];
+			uint8 half5[256][2]; // same for the 1/2 : 1/2 mix of the 3 color mode.
+			uint8 half6[256][2];
+		};
+
+		void build_match(uint8 (*out)[2], uint32 bits, bool half)
+		{
+			const uint32 count = 1u << bits;
+			for (uint32 v = 0; v < 256; v++)
+			{
+				int32 best = INT32_MAX;
+				for (uint32 a = 0; a < count; a++)
+				{
+					const int32 ea = static_cast<int32>(expand_bits(a, bits));
+					for (uint32 b = 0; b < count; b++)
+					{
+						const int32 eb	= static_cast<int32>(expand_bits(b, bits));
+						const int32 mix = half ? (ea + eb) / 2 : (2 * ea + eb) / 3;
+						// ties go to the closer pair, small endpoint spread survives the 565 rounding of neighbours better.
+						const int32 err = math::abs(mix - static_cast<int32>(v)) * 256 + math::abs(ea - eb);
+						if (err < best)
+						{
+							best	  = err;
+							out[v][0] = static_cast<uint8>(a);
+							out[v][1] = static_cast<uint8>(b);
+						}
+					}
+				}
+			}
+		}
+
+		const bc1_tables& get_bc1_tables()
+		{
+			static const bc1_tables tables = [] {
+				bc1_tables t = {};
+				build_match(t.third5, 5, false);
+				build_match(t.third6, 6, false);
+				build_match(t.half5, 5, true);
+				build_match(t.half6, 6, true);
+				return t;
+			}();
+			return tables;
+		}
+
+		inline uint16 pack_565(uint32 r5, uint32 g6, uint32 b5)
+		{
+			return static_cast<uint16>((r5 << 11) | (g6 << 5) | b5);
+		}
+
+		inline uint16 quantize_565(const float* c)
+		{
+			const uint32 r = static_cast<uint32>(c[0] * 31.0f / 255.0f + 0.5f);
+			const uint32 g = static_cast<uint32>(c[1] * 63.0f / 255.0f + 0.5f);
+			const uint32 b = static_cast<uint32>(c[2] * 31.0f / 255.0f + 0.5f);
+			return pack_565(r > 31 ? 31 : r, g > 63 ? 63 : g, b > 31 ? 31 : b);
+		}
+
+		inline void unpack_565(uint16 c, int32* out)
+		{
+			out[0] = static_cast<int32>(expand_bits(c >> 11, 5));
+			out[1] = static_cast<int32>(expand_bits((c >> 5) & 63, 6));
+			out[2] = static_cast<int32>(expand_bits(c & 31, 5));
+		}
+
+		void bc1_palette(uint16 c0, uint16 c1, bool four_colors, int32 (*out)[3])
+		{
+			unpack_565(c0, out[0]);
+			unpack_565(c1, out[1]);
+			for (uint32 c = 0; c < 3; c++)
+			{
+				if (four_colors)
+				{
+					out[2][c] = (2 * out[0][c] + out[1][c]) / 3;
+					out[3][c] = (out[0][c] + 2 * out[1][c]) / 3;
+				}
+				else
+				{
+					out[2][c] = (out[0][c] + out[1][c]) / 2;
+					out[3][c] = 0;
+				}
+			}
+		}
+
+		struct bc1_candidate
+		{
+			uint16 c0	   = 0;
+			uint16 c1	   = 0;
+			uint32 indices = 0;
+			uint32 error   = UINT32_MAX;
+		};
+
+		/// Orders the endpoints for the mode, picks the closest palette entry for every masked pixel, the rest get the transparent entry.
+		void bc1_evaluate(const uint8* rgba, uint32 mask, bool four_colors, uint16 c0, uint16 c1, bc1_candidate& best)
+		{
+			if (four_colors ? c0 < c1 : c0 > c1)
+			{
+				const uint16 tmp = c0;
+				c0				 = c1;
+				c1				 = tmp;
+			}
+
+			int32 palette[4][3];
+			bc1_palette(c0, c1, four_colors, palette);
+
+			// equal endpoints decode in 3 color mode for bc1, stay on entry 0 which is the same in both.
+			const uint32 entries = c0 == c1 ? 1 : (four_colors ? 4 : 3);
+			uint32		 indices = 0;
+			uint32		 error	 = 0;
+
+			for (uint32 i = 0; i < 16; i++)
+			{
+				if (!((mask >> i) & 1))
+				{
+					indices |= 3u << (i * 2);
+					continue;
+				}
+
+				const uint8* p		  = rgba + i * 4;
+				uint32		 best_idx = 0;
+				int32		 best_err = INT32_MAX;
+				for (uint32 e = 0; e < entries; e++)
+				{
+					const int32 dr	= palette[e][0] - p[0];
+					const int32 dg	= palette[e][1] - p[1];
+					const int32 db	= palette[e][2] - p[2];
+					const int32 err = dr * dr + dg * dg + db * db;
+					if (err < best_err)
+					{
+						best_err = err;
+						best_idx = e;
+					}
+				}
+
+				indices |= best_idx << (i * 2);
+				error += static_cast<uint32>(best_err);
+			}
+
+			if (error < best.error)
+			{
+				best.c0		 = c0;
+				best.c1		 = c1;
+				best.indices = indices;
+				best.error	 = error;
+			}
+		}
+
+		uint32 encode_bc1_color(const uint8* rgba, uint32 mask, bool four_colors, uint8* out)
+		{
+			bc1_candidate best = {};
+
+			uint32 first = 16;
+			bool   solid = true;
+			for (uint32 i = 0; i < 16; i++)
+			{
+				if (!((mask >> i) & 1))
+					continue;
+				if (first == 16)
+					first = i;
+				else if (rgba[i * 4] != rgba[first * 4] || rgba[i * 4 + 1] != rgba[first * 4 + 1] || rgba[i * 4 + 2] != rgba[first * 4 + 2])
+					solid = false;
+			}
+
+			if (first == 16)
+			{
+				// fully transparent.
+				best.c0		 = 0;
+				best.c1		 = 0;
+				best.indices = 0xFFFFFFFF;
+				best.error	 = 0;
+			}
+			else if (solid)
+			{
+				const bc1_tables& t = get_bc1_tables();
+				const uint8*	  p = rgba + first * 4;
+				const uint8(*m5)[2] = four_colors ? t.third5 : t.half5;
+				const uint8(*m6)[2] = four_colors ? t.third6 : t.half6;
+				bc1_evaluate(rgba, mask, four_colors, pack_565(m5[p[0]][0], m6[p[1]][0], m5[p[2]][0]), pack_565(m5[p[0]][1], m6[p[1]][1], m5[p[2]][1]), best);
+
+				// plain rounding can still win when the exact mix needs a different endpoint order per channel.
+				const float c[3] = {static_cast<float>(p[0]), static_cast<float>(p[1]), static_cast<float>(p[2])};
+				const uint16 q	 = quantize_565(c);
+				bc1_evaluate(rgba, mask, four_colors, q, q, best);
+			}
+			else
+			{
+				float mean[3], axis[3], e0[3], e1[3];
+				principal_axis<3>(rgba, mask, mean, axis);
+				axis_endpoints<3>(rgba, mask, mean, axis, e0, e1);
+				bc1_evaluate(rgba, mask, four_colors, quantize_565(e0), quantize_565(e1), best);
+
+				// palette entries as fractions of c1.
+				const float fractions4[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+				const float fractions3[4] = {0.0f, 1.0f, 0.5f, 0.0f};
+				const float* fractions	  = four_colors ? fractions4 : fractions3;
+
+				for (uint32 it = 0; it < BC_REFINE_ITERATIONS; it++)
+				{
+					float weights[16];
+					for (uint32 i = 0; i < 16; i++)
+						weights[i] = fractions[(best.indices >> (i * 2)) & 3];
+
+					if (!solve_endpoints<3>(rgba, mask, weights, e0, e1))
+						break;
+
+					const uint32 prev = best.error;
+					bc1_evaluate(rgba, mask, four_colors, quantize_565(e0), quantize_565(e1), best);
+					if (best.error >= prev)
+						break;
+				}
+			}
+
+			out[0] = static_cast<uint8>(best.c0 & 0xFF);
+			out[1] = static_cast<uint8>(best.c0 >> 8);
+			out[2] = static_cast<uint8>(best.c1 & 0xFF);
+			out[3] = static_cast<uint8>(best.c1 >> 8);
+			out[4] = static_cast<uint8>(best.indices & 0xFF);
+			out[5] = static_cast<uint8>((best.indices >> 8) & 0xFF);
+			out[6] = static_cast<uint8>((best.indices >> 16) & 0xFF);
+			out[7] = static_cast<uint8>(best.indices >> 24);
+			return best.error;
+		}
+
+		void decode_bc1_color(const uint8* block, bool allow_three_colors, uint8* out_rgba)
+		{
+			const uint16 c0			 = static_cast<uint16>(block[0] | (block[1] << 8));
+			const uint16 c1			 = static_cast<uint16>(block[2] | (block[3] << 8));
+			const bool	 four_colors = !allow_three_colors || c0 > c1;
+			const uint32 indices	 = static_cast<uint32>(block[4]) | (static_cast<uint32>(block[5]) << 8) | (static_cast<uint32>(block[6]) << 16) | (static_cast<uint32>(block[7]) << 24);
+
+			int32 palette[4][3];
+			bc1_palette(c0, c1, four_colors, palette);
+
+			for (uint32 i = 0; i < 16; i++)
+			{
+				const uint32 idx = (indices >> (i * 2)) & 3;
+				uint8*		 p	 = out_rgba + i * 4;
+				p[0]			 = static_cast<uint8>(palette[idx][0]);
+				p[1]			 = static_cast<uint8>(palette[idx][1]);
+				p[2]			 = static_cast<uint8>(palette[idx][2]);
+				p[3]			 = (!four_colors && idx == 3) ? 0 : 255;
+			}
+		}
+
+		/*
+			BC4 single channel block, also bc3 alpha & both bc5 channels.
+		*/
+
+		void bc4_palette(uint32 e0, uint32 e1, uint32* out)
+		{
+			out[0] = e0;
+			out[1] = e1;
+			if (e0 > e1)
+			{
+				for (uint32 i = 1; i < 7; i++)
+					out[i + 1] = ((7 - i) * e0 + i * e1 + 3) / 7;
+			}
+			else
+			{
+				for (uint32 i = 1; i < 5; i++)
+					out[i + 1] = ((5 - i) * e0 + i * e1 + 2) / 5;
+				out[6] = 0;
+				out[7] = 255;
+			}
+		}
+
+		struct bc4_candidate
+		{
+			uint32 e0	   = 0;
+			uint32 e1	   = 0;
+			uint64 indices = 0;
+			uint32 error   = UINT32_MAX;
+		};
+
+		void bc4_evaluate(const uint8* values, uint32 e0, uint32 e1, bc4_candidate& best)
+		{
+			uint32 palette[8];
+			bc4_palette(e0, e1, palette);
+
+			uint64 indices = 0;
+			uint32 error   = 0;
+			for (uint32 i = 0; i < 16; i++)
+			{
+				const int32 v		 = values[i];
+				uint32		best_idx = 0;
+				int32		best_err = INT32_MAX;
+				for (uint32 e = 0; e < 8; e++)
+				{
+					const int32 d	= static_cast<int32>(palette[e]) - v;
+					const int32 err = d * d;
+					if (err < best_err)
+					{
+						best_err = err;
+						best_idx = e;
+					}
+				}
+				indices |= static_cast<uint64>(best_idx) << (i * 3);
+				error += static_cast<uint32>(best_err);
+			}
+
+			if (error < best.error)
+			{
+				best.e0		 = e0;
+				best.e1		 = e1;
+				best.indices = indices;
+				best.error	 = error;
+			}
+		}
+
+		uint32 encode_bc4_values(const uint8* values, uint8* out)
+		{
+			uint32 mn = 255, mx = 0, inner_mn = 255, inner_mx = 0;
+			bool   has_extremes = false;
+			for (uint32 i = 0; i < 16; i++)
+			{
+				const uint32 v = values[i];
+				mn			   = v < mn ? v : mn;
+				mx			   = v > mx ? v : mx;
+
+				if (v == 0 || v == 255)
+				{
+					has_extremes = true;
+					continue;
+				}
+
+				inner_mn = v < inner_mn ? v : inner_mn;
+				inner_mx = v > inner_mx ? v : inner_mx;
+			}
+
+			bc4_candidate best = {};
+			bc4_evaluate(values, mx, mn, best);
+
+			// 8 entry mode, refit the endpoints to the chosen indices.
+			if (mx > mn)
+			{
+				const float fractions[8] = {0.0f, 1.0f, 1.0f / 7.0f, 2.0f / 7.0f, 3.0f / 7.0f, 4.0f / 7.0f, 5.0f / 7.0f, 6.0f / 7.0f};
+				for (uint32 it = 0; it < BC_REFINE_ITERATIONS && best.error != 0; it++)
+				{
+					float aa = 0.0f, ab = 0.0f, bb = 0.0f, ax = 0.0f, bx = 0.0f;
+					for (uint32 i = 0; i < 16; i++)
+					{
+						const float b = fractions[(best.indices >> (i * 3)) & 7];
+						const float a = 1.0f - b;
+						const float x = static_cast<float>(values[i]);
+						aa += a * a;
+						ab += a * b;
+						bb += b * b;
+						ax += a * x;
+						bx += b * x;
+					}
+
+					const float det = aa * bb - ab * ab;
+					if (std::fabs(det) < MATH_EPS)
+						break;
+
+					const int32 e0 = clamp_byte(static_cast<int32>(std::lround((ax * bb - bx * ab) / det)));
+					const int32 e1 = clamp_byte(static_cast<int32>(std::lround((bx * aa - ax * ab) / det)));
+					if (e0 <= e1)
+						break;
+
+					const uint32 prev = best.error;
+					bc4_evaluate(values, static_cast<uint32>(e0), static_cast<uint32>(e1), best);
+					if (best.error >= prev)
+						break;
+				}
+			}
+
+			// 6 entry mode spends the last two entries on exact 0 & 255.
+			if (has_extremes)
+			{
+				if (inner_mn > inner_mx)
+					inner_mn = inner_mx = 0;
+				bc4_evaluate(values, inner_mn, inner_mx, best);
+			}
+
+			out[0] = static_cast<uint8>(best.e0);
+			out[1] = static_cast<uint8>(best.e1);
+			for (uint32 i = 0; i < 6; i++)
+				out[2 + i] = static_cast<uint8>((best.indices >> (i * 8)) & 0xFF);
+			return best.error;
+		}
+
+		/*
+			BC7, mode 6 (1 subset rgba, 7 bit + unique p-bit endpoints, 4 bit indices) & mode 1 (2 subsets rgb, 6 bit + shared p-bit, 3 bit indices).
+		*/
+
+		struct bc7_mode
+		{
+			uint32 mode;
+			uint32 channels;
+			uint32 color_bits; // without the p-bit.
+			uint32 index_bits;
+			bool   shared_pbit;
+		};
+
+		constexpr bc7_mode BC7_MODE1 = {.mode = 1, .channels = 3, .color_bits = 6, .index_bits = 3, .shared_pbit = true};
+		constexpr bc7_mode BC7_MODE6 = {.mode = 6, .channels = 4, .color_bits = 7, .index_bits = 4, .shared_pbit = false};
+
+		struct bc7_subset
+		{
+			uint32 codes[2][4] = {};
+			uint32 pbits[2]	   = {};
+			uint8  indices[16] = {};
+			uint32 error	   = UINT32_MAX;
+		};
+
+		inline const uint32* bc7_weights(uint32 index_bits)
+		{
+			return index_bits == 3 ? BC7_WEIGHTS3 : BC7_WEIGHTS4;
+		}
+
+		inline uint32 bc7_interpolate(uint32 e0, uint32 e1, uint32 w)
+		{
+			return ((64 - w) * e0 + w * e1 + 32) >> 6;
+		}
+
+		/// Closest code to v for the p-bit, expanded through the same bit replication the decoder does.
+		inline uint32 bc7_quantize(float v, uint32 color_bits, uint32 pbit)
+		{
+			const uint32 bits	= color_bits + 1;
+			const uint32 max	= (1u << color_bits) - 1;
+			const float	 scaled = (v * static_cast<float>((1u << bits) - 1) / 255.0f - static_cast<float>(pbit)) * 0.5f;
+			const int32	 guess	= static_cast<int32>(scaled + 0.5f);
+
+			uint32 best		= 0;
+			float  best_err = MATH_INF_F;
+			for (int32 q = guess - 1; q <= guess + 1; q++)
+			{
+				if (q < 0 || q > static_cast<int32>(max))
+					continue;
+				const float e	= static_cast<float>(expand_bits((static_cast<uint32>(q) << 1) | pbit, bits));
+				const float err = std::fabs(e - v);
+				if (err < best_err)
+				{
+					best_err = err;
+					best	 = static_cast<uint32>(q);
+				}
+			}
+			return best;
+		}
+
+		/// Index selection for a fixed set of codes. Projects on the endpoint line, then checks the neighbouring entries exactly.
+		uint32 bc7_select(const uint8* rgba, uint32 mask, const bc7_mode& m, const uint32 (*codes)[4], const uint32* pbits, uint8* indices)
+		{
+			const uint32  levels  = 1u << m.index_bits;
+			const uint32* weights = bc7_weights(m.index_bits);
+			const uint32  bits	  = m.color_bits + 1;
+
+			int32 e[2][4];
+			for (uint32 p = 0; p < 2; p++)
+			{
+				for (uint32 c = 0; c < 4; c++)
+					e[p][c] = c < m.channels ? static_cast<int32>(expand_bits((codes[p][c] << 1) | pbits[p], bits)) : 255;
+			}
+
+			int32 palette[16][4];
+			for (uint32 l = 0; l < levels; l++)
+			{
+				for (uint32 c = 0; c < 4; c++)
+					palette[l][c] = static_cast<int32>(bc7_interpolate(static_cast<uint32>(e[0][c]), static_cast<uint32>(e[1][c]), weights[l]));
+			}
+
+			int32 dir[4], len2 = 0;
+			for (uint32 c = 0; c < 4; c++)
+			{
+				dir[c] = e[1][c] - e[0][c];
+				len2 += dir[c] * dir[c];
+			}
+
+			const float scale = len2 == 0 ? 0.0f : static_cast<float>(levels - 1) / static_cast<float>(len2);
+			uint32		error = 0;
+
+			for (uint32 i = 0; i < 16; i++)
+			{
+				if (!((mask >> i) & 1))
+					continue;
+
+				const uint8* p	 = rgba + i * 4;
+				int32		 dot = 0;
+				for (uint32 c = 0; c < 4; c++)
+					dot += (static_cast<int32>(p[c]) - e[0][c]) * dir[c];
+
+				int32 guess = static_cast<int32>(static_cast<float>(dot) * scale + 0.5f);
+				guess		= guess < 0 ? 0 : (guess > static_cast<int32>(levels - 1) ? static_cast<int32>(levels - 1) : guess);
+
+				const uint32 lo		  = guess > 0 ? static_cast<uint32>(guess - 1) : 0;
+				const uint32 hi		  = static_cast<uint32>(guess) + 1 < levels ? static_cast<uint32>(guess + 1) : levels - 1;
+				uint32		 best_idx = 0;
+				int32		 best_err = INT32_MAX;
+				for (uint32 l = lo; l <= hi; l++)
+				{
+					int32 err = 0;
+					for (uint32 c = 0; c < 4; c++)
+					{
+						const int32 d = palette[l][c] - static_cast<int32>(p[c]);
+						err += d * d;
+					}
+					if (err < best_err)
+					{
+						best_err = err;
+						best_idx = l;
+					}
+				}
+
+				indices[i] = static_cast<uint8>(best_idx);
+				error += static_cast<uint32>(best_err);
+			}
+
+			return error;
+		}
+
+		/// Quantizes float endpoints, p-bits are picked by the smallest endpoint quantization error instead of trying every combination through index selection.
+		template <uint32 N> void bc7_try_endpoints(const uint8* rgba, uint32 mask, const bc7_mode& m, const float* e0, const float* e1, bc7_subset& out)
+		{
+			const uint32 bits = m.color_bits + 1;
+			const float* e[2] = {e0, e1};
+
+			bc7_subset cand = {};
+			float	   err[2][2]; // [endpoint][pbit]
+			uint32	   codes[2][2][4];
+
+			for (uint32 p = 0; p < 2; p++)
+			{
+				for (uint32 pbit = 0; pbit < 2; pbit++)
+				{
+					err[p][pbit] = 0.0f;
+					for (uint32 c = 0; c < N; c++)
+					{
+						codes[p][pbit][c] = bc7_quantize(e[p][c], m.color_bits, pbit);
+						const float d	  = static_cast<float>(expand_bits((codes[p][pbit][c] << 1) | pbit, bits)) - e[p][c];
+						err[p][pbit] += d * d;
+					}
+				}
+			}
+
+			if (m.shared_pbit)
+			{
+				const uint32 pbit = err[0][1] + err[1][1] < err[0][0] + err[1][0] ? 1 : 0;
+				cand.pbits[0] = cand.pbits[1] = pbit;
+			}
+			else
+			{
+				cand.pbits[0] = err[0][1] < err[0][0] ? 1 : 0;
+				cand.pbits[1] = err[1][1] < err[1][0] ? 1 : 0;
+			}
+
+			for (uint32 c = 0; c < N; c++)
+			{
+				cand.codes[0][c] = codes[0][cand.pbits[0]][c];
+				cand.codes[1][c] = codes[1][cand.pbits[1]][c];
+			}
+
+			cand.error = bc7_select(rgba, mask, m, cand.codes, cand.pbits, cand.indices);
+			if (cand.error < out.error)
+				out = cand;
+		}
+
+		template <uint32 N> void bc7_fit_subset(const uint8* rgba, uint32 mask, const bc7_mode& m, bc7_subset& out)
+		{
+			float mean[N], axis[N], e0[N], e1[N];
+			principal_axis<N>(rgba, mask, mean, axis);
+			axis_endpoints<N>(rgba, mask, mean, axis, e0, e1);
+			bc7_try_endpoints<N>(rgba, mask, m, e0, e1, out);
+
+			const uint32* weights = bc7_weights(m.index_bits);
+			for (uint32 it = 0; it < BC_REFINE_ITERATIONS && out.error != 0; it++)
+			{
+				float fractions[16];
+				for (uint32 i = 0; i < 16; i++)
+					fractions[i] = static_cast<float>(weights[out.indices[i]]) / 64.0f;
+
+				if (!solve_endpoints<N>(rgba, mask, fractions, e0, e1))
+					break;
+
+				const uint32 prev = out.error;
+				bc7_try_endpoints<N>(rgba, mask, m, e0, e1, out);
+				if (out.error >= prev)
+					break;
+			}
+		}
+
+		/// Anchor pixels store one index bit less, flip the subset so their msb is 0.
+		void bc7_fix_anchor(bc7_subset& s, uint32 mask, uint32 anchor, const bc7_mode& m)
+		{
+			const uint32 max = (1u << m.index_bits) - 1;
+			if (s.indices[anchor] <= (max >> 1))
+				return;
+
+			for (uint32 c = 0; c < 4; c++)
+			{
+				const uint32 tmp = s.codes[0][c];
+				s.codes[0][c]	 = s.codes[1][c];
+				s.codes[1][c]	 = tmp;
+			}
+
+			const uint32 tmp = s.pbits[0];
+			s.pbits[0]		 = s.pbits[1];
+			s.pbits[1]		 = tmp;
+
+			for (uint32 i = 0; i < 16; i++)
+			{
+				if ((mask >> i) & 1)
+					s.indices[i] = static_cast<uint8>(max - s.indices[i]);
+			}
+		}
+
+		void bc7_write_mode6(bc7_subset& s, uint8* out)
+		{
+			bc7_fix_anchor(s, 0xFFFF, 0, BC7_MODE6);
+
+			SFG_MEMSET(out, 0, 16);
+			bit_writer w = {.data = out};
+			w.write(1u << 6, 7);
+			for (uint32 c = 0; c < 4; c++)
+			{
+				w.write(s.codes[0][c], 7);
+				w.write(s.codes[1][c], 7);
+			}
+			w.write(s.pbits[0], 1);
+			w.write(s.pbits[1], 1);
+			for (uint32 i = 0; i < 16; i++)
+				w.write(s.indices[i], i == 0 ? 3 : 4);
+		}
+
+		void bc7_write_mode1(bc7_subset* subsets, uint32 partition, uint8* out)
+		{
+			const uint32 mask1 = BC7_PARTITIONS2[partition];
+			const uint32 mask0 = ~mask1 & 0xFFFF;
+			const uint32 a1	   = BC7_ANCHORS2[partition];
+			bc7_fix_anchor(subsets[0], mask0, 0, BC7_MODE1);
+			bc7_fix_anchor(subsets[1], mask1, a1, BC7_MODE1);
+
+			SFG_MEMSET(out, 0, 16);
+			bit_writer w = {.data = out};
+			w.write(1u << 1, 2);
+			w.write(partition, 6);
+			for (uint32 c = 0; c < 3; c++)
+			{
+				for (uint32 s = 0; s < 2; s++)
+				{
+					w.write(subsets[s].codes[0][c], 6);
+					w.write(subsets[s].codes[1][c], 6);
+				}
+			}
+			w.write(subsets[0].pbits[0], 1);
+			w.write(subsets[1].pbits[0], 1);
+			for (uint32 i = 0; i < 16; i++)
+			{
+				const uint32 s = (mask1 >> i) & 1;
+				w.write(subsets[s].indices[i], (i == 0 || i == a1) ? 2 : 3);
+			}
+		}
+
+		/// Error left after fitting a line through each subset, the sum of the minor covariance eigenvalues. Cheap enough for all 64 partitions.
+		void bc7_rank_partitions(const uint8* rgba, uint32 count, uint32* out_partitions)
+		{
+			float px[16][3], sq[16][6];
+			for (uint32 i = 0; i < 16; i++)
+			{
+				const float r = rgba[i * 4], g = rgba[i * 4 + 1], b = rgba[i * 4 + 2];
+				px[i][0]	  = r;
+				px[i][1]	  = g;
+				px[i][2]	  = b;
+				sq[i][0]	  = r * r;
+				sq[i][1]	  = r * g;
+				sq[i][2]	  = r * b;
+				sq[i][3]	  = g * g;
+				sq[i][4]	  = g * b;
+				sq[i][5]	  = b * b;
+			}
+
+			float total_m[3] = {}, total_q[6] = {};
+			for (uint32 i = 0; i < 16; i++)
+			{
+				for (uint32 c = 0; c < 3; c++)
+					total_m[c] += px[i][c];
+				for (uint32 c = 0; c < 6; c++)
+					total_q[c] += sq[i][c];
+			}
+
+			float scores[64];
+			for (uint32 p = 0; p < 64; p++)
+			{
+				// subset 1 summed over its bits, subset 0 is the rest of the block.
+				float  sm[2][3] = {}, sq_sum[2][6] = {};
+				uint32 bits		= BC7_PARTITIONS2[p];
+				while (bits != 0)
+				{
+					const uint32 i = static_cast<uint32>(std::countr_zero(bits));
+					bits &= bits - 1;
+					for (uint32 c = 0; c < 3; c++)
+						sm[1][c] += px[i][c];
+					for (uint32 c = 0; c < 6; c++)
+						sq_sum[1][c] += sq[i][c];
+				}
+
+				for (uint32 c = 0; c < 3; c++)
+					sm[0][c] = total_m[c] - sm[1][c];
+				for (uint32 c = 0; c < 6; c++)
+					sq_sum[0][c] = total_q[c] - sq_sum[1][c];
+
+				const float count1 = static_cast<float>(std::popcount(static_cast<uint32>(BC7_PARTITIONS2[p])));
+				const float counts[2] = {16.0f - count1, count1};
+
+				float score = 0.0f;
+				for (uint32 s = 0; s < 2; s++)
+				{
+					const float* m	 = sm[s];
+					const float* q	 = sq_sum[s];
+					const float	 inv = 1.0f / counts[s];
+					const float	 cov[3][3] = {
+						 {q[0] - m[0] * m[0] * inv, q[1] - m[0] * m[1] * inv, q[2] - m[0] * m[2] * inv},
+						 {q[1] - m[0] * m[1] * inv, q[3] - m[1] * m[1] * inv, q[4] - m[1] * m[2] * inv},
+						 {q[2] - m[0] * m[2] * inv, q[4] - m[1] * m[2] * inv, q[5] - m[2] * m[2] * inv},
+					 };
+
+					// one power step from the dominant column, the rayleigh quotient of that is close enough to rank.
+					const float	 trace = cov[0][0] + cov[1][1] + cov[2][2];
+					const uint32 col   = cov[0][0] > cov[1][1] ? (cov[0][0] > cov[2][2] ? 0 : 2) : (cov[1][1] > cov[2][2] ? 1 : 2);
+					const float	 v[3]  = {cov[0][col], cov[1][col], cov[2][col]};
+					const float	 cv[3] = {
+						 cov[0][0] * v[0] + cov[0][1] * v[1] + cov[0][2] * v[2],
+						 cov[1][0] * v[0] + cov[1][1] * v[1] + cov[1][2] * v[2],
+						 cov[2][0] * v[0] + cov[2][1] * v[1] + cov[2][2] * v[2],
+					 };
+					const float vv	  = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+					const float major = vv < MATH_EPS ? 0.0f : (v[0] * cv[0] + v[1] * cv[1] + v[2] * cv[2]) / vv;
+
+					score += trace - major;
+				}
+				scores[p] = score;
+			}
+
+			// partial selection of the lowest scores.
+			uint64 taken = 0;
+			for (uint32 k = 0; k < count; k++)
+			{
+				uint32 best = 0;
+				float  low	= MATH_INF_F;
+				for (uint32 p = 0; p < 64; p++)
+				{
+					if (!((taken >> p) & 1) && scores[p] < low)
+					{
+						low	 = scores[p];
+						best = p;
+					}
+				}
+				taken |= static_cast<uint64>(1) << best;
+				out_partitions[k] = best;
+			}
+		}
+
+		void decode_bc7_endpoints(bit_reader& r, uint32 subsets, uint32 channels, uint32 color_bits, int32 (*e)[4])
+		{
+			for (uint32 c = 0; c < channels; c++)
+			{
+				for (uint32 p = 0; p < subsets * 2; p++)
+					e[p][c] = static_cast<int32>(r.read(color_bits));
+			}
+		}
+	}
+
+	void block_compressor::encode_bc1(const uint8* rgba, uint8* out, bool allow_alpha)
+	{
+		uint32 mask = 0xFFFF;
+		if (allow_alpha)
+		{
+			for (uint32 i = 0; i < 16; i++)
+			{
+				if (rgba[i * 4 + 3] < 128)
+					mask &= ~(1u << i);
+			}
+		}
+
+		encode_bc1_color(rgba, mask, mask == 0xFFFF, out);
+	}
+
+	void block_compressor::encode_bc3(const uint8* rgba, uint8* out)
+	{
+		encode_bc4(rgba, 3, out);
+		encode_bc1_color(rgba, 0xFFFF, true, out + 8);
+	}
+
+	void block_compressor::encode_bc4(const uint8* rgba, uint32 channel, uint8* out)
+	{
+		uint8 values[16];
+		for (uint32 i = 0; i < 16; i++)
+			values[i] = rgba[i * 4 + channel];
+		encode_bc4_values(values, out);
+	}
+
+	void block_compressor::encode_bc5(const uint8* rgba, uint8* out)
+	{
+		encode_bc4(rgba, 0, out);
+		encode_bc4(rgba, 1, out + 8);
+	}
+
+	void block_compressor::encode_bc7(const uint8* rgba, uint8* out, uint32 partition_candidates)
+	{
+		bc7_subset single = {};
+		bc7_fit_subset<4>(rgba, 0xFFFF, BC7_MODE6, single);
+
+		bool opaque = true;
+		for (uint32 i = 0; i < 16 && opaque; i++)
+			opaque = rgba[i * 4 + 3] == 255;
+
+		if (!opaque || single.error == 0 || partition_candidates == 0)
+		{
+			bc7_write_mode6(single, out);
+			return;
+		}
+
+		const uint32 count = partition_candidates > 64 ? 64 : partition_candidates;
+		uint32		 partitions[64];
+		bc7_rank_partitions(rgba, count, partitions);
+
+		bc7_subset best[2]		  = {};
+		uint32	   best_partition = 0;
+		uint32	   best_error	  = single.error;
+
+		for (uint32 k = 0; k < count; k++)
+		{
+			const uint32 mask1 = BC7_PARTITIONS2[partitions[k]];
+			bc7_subset	 subsets[2];
+			bc7_fit_subset<3>(rgba, ~mask1 & 0xFFFF, BC7_MODE1, subsets[0]);
+			bc7_fit_subset<3>(rgba, mask1, BC7_MODE1, subsets[1]);
+
+			const uint32 error = subsets[0].error + subsets[1].error;
+			if (error < best_error)
+			{
+				best_error	   = error;
+				best_partition = partitions[k];
+				best[0]		   = subsets[0];
+				best[1]		   = subsets[1];
+			}
+		}
+
+		if (best_error < single.error)
+			bc7_write_mode1(best, best_partition, out);
+		else
+			bc7_write_mode6(single, out);
+	}
+
+	void block_compressor::decode_bc1(const uint8* block, uint8* out_rgba)
+	{
+		decode_bc1_color(block, true, out_rgba);
+	}
+
+	void block_compressor::decode_bc3(const uint8* block, uint8* out_rgba)
+	{
+		decode_bc1_color(block + 8, false, out_rgba);
+		decode_bc4(block, 3, out_rgba);
+	}
+
+	void block_compressor::decode_bc4(const uint8* block, uint32 channel, uint8* out_rgba)
+	{
+		uint32 palette[8];
+		bc4_palette(block[0], block[1], palette);
+
+		uint64 indices = 0;
+		for (uint32 i = 0; i < 6; i++)
+			indices |= static_cast<uint64>(block[2 + i]) << (i * 8);
+
+		for (uint32 i = 0; i < 16; i++)
+			out_rgba[i * 4 + channel] = static_cast<uint8>(palette[(indices >> (i * 3)) & 7]);
+	}
+
+	void block_compressor::decode_bc5(const uint8* block, uint8* out_rgba)
+	{
+		decode_bc4(block, 0, out_rgba);
+		decode_bc4(block + 8, 1, out_rgba);
+	}
+
+	bool block_compressor::decode_bc7(const uint8* block, uint8* out_rgba)
+	{
+		bit_reader r = {.data = block};
+
+		uint32 mode = 0;
+		while (mode < 8 && r.read(1) == 0)
+			mode++;
+
+		int32 e[4][4] = {};
+
+		if (mode == 6)
+		{
+			decode_bc7_endpoints(r, 1, 4, 7, e);
+			const uint32 p0 = r.read(1);
+			const uint32 p1 = r.read(1);
+			for (uint32 c = 0; c < 4; c++)
+			{
+				e[0][c] = (e[0][c] << 1) | static_cast<int32>(p0);
+				e[1][c] = (e[1][c] << 1) | static_cast<int32>(p1);
+			}
+
+			for (uint32 i = 0; i < 16; i++)
+			{
+				const uint32 w = BC7_WEIGHTS4[r.read(i == 0 ? 3 : 4)];
+				for (uint32 c = 0; c < 4; c++)
+					out_rgba[i * 4 + c] = static_cast<uint8>(bc7_interpolate(static_cast<uint32>(e[0][c]), static_cast<uint32>(e[1][c]), w));
+			}
+			return true;
+		}
+
+		if (mode == 1)
+		{
+			const uint32 partition = r.read(6);
+			decode_bc7_endpoints(r, 2, 3, 6, e);
+			const uint32 pbits[2] = {r.read(1), r.read(1)};
+			for (uint32 p = 0; p < 4; p++)
+			{
+				for (uint32 c = 0; c < 3; c++)
+					e[p][c] = static_cast<int32>(expand_bits((static_cast<uint32>(e[p][c]) << 1) | pbits[p >> 1], 7));
+			}
+
+			const uint32 mask1 = BC7_PARTITIONS2[partition];
+			const uint32 a1	   = BC7_ANCHORS2[partition];
+			for (uint32 i = 0; i < 16; i++)
+			{
+				const uint32 s = (mask1 >> i) & 1;
+				const uint32 w = BC7_WEIGHTS3[r.read((i == 0 || i == a1) ? 2 : 3)];
+				for (uint32 c = 0; c < 3; c++)
+					out_rgba[i * 4 + c] = static_cast<uint8>(bc7_interpolate(static_cast<uint32>(e[s * 2][c]), static_cast<uint32>(e[s * 2 + 1][c]), w));
+				out_rgba[i * 4 + 3] = 255;
+			}
+			return true;
+		}
+
+		SFG_MEMSET(out_rgba, 0, 64);
+		return false;
+	}
+
+	bool block_compressor::compress(const texture_buffer& src, texture_buffer& dst, const desc& d)
+	{
+		const uint8 block_size = format_get_block_size(d.target);
+		if (block_size == 0)
+			return false;
+
+		SFG_ASSERT(src.bpp == 1 || src.bpp == 4);
+		SFG_ASSERT(src.size.x != 0 && src.size.y != 0);
+
+		dst.size	   = src.size;
+		dst.bpp		   = 0;
+		dst.block_size = block_size;
+
+		const size_t data_size = dst.get_data_size();
+		dst.pixels			   = reinterpret_cast<uint8*>(SFG_MALLOC(data_size));
+		PUSH_ALLOCATION_SZ(data_size);
+
+		const uint32 blocks_x  = (src.size.x + 3) / 4;
+		const uint32 blocks_y  = (src.size.y + 3) / 4;
+		const format target	   = d.target;
+		const uint32 bc7_parts = d.bc7_partitions;
+
+		auto encode_row = [&](uint32 by) {
+			uint8  rgba[64];
+			uint8* out = dst.pixels + static_cast<size_t>(by) * blocks_x * block_size;
+
+			for (uint32 bx = 0; bx < blocks_x; bx++, out += block_size)
+			{
+				fetch_block(src, bx, by, rgba);
+
+				switch (target)
+				{
+				case format::bc1_block_srgb:
+				case format::bc1_block_unorm:
+					encode_bc1(rgba, out, src.bpp == 4);
+					break;
+				case format::bc3_block_srgb:
+				case format::bc3_block_unorm:
+					encode_bc3(rgba, out);
+					break;
+				case format::bc4_block_unorm:
+					encode_bc4(rgba, 0, out);
+					break;
+				case format::bc5_block_unorm:
+					encode_bc5(rgba, out);
+					break;
+				case format::bc7_block_srgb:
+				case format::bc7_block_unorm:
+					encode_bc7(rgba, out, bc7_parts);
+					break;
+				default:
+					break;
+				}
+			}
+		};
+
+		if (d.parallel && blocks_x * blocks_y >= BC_PARALLEL_BLOCKS)
+		{
+			job_system::get().parallel_for(blocks_y, 1, encode_row);
+			return true;
+		}
+
+		for (uint32 by = 0; by < blocks_y; by++)
+			encode_row(by);
+
+		return true;
+	}
+
+	bool block_compressor::decompress(const texture_buffer& src, format fmt, texture_buffer& dst)
+	{
+		const uint8 block_size = format_get_block_size(fmt);
+		if (block_size == 0 || src.block_size != block_size)
+			return false;
+
+		SFG_ASSERT(dst.bpp == 1 || dst.bpp == 4);
+		SFG_ASSERT(dst.size.x == src.size.x && dst.size.y == src.size.y);
+
+		const uint32 blocks_x = (src.size.x + 3) / 4;
+		const uint32 blocks_y = (src.size.y + 3) / 4;
+		const uint32 w		  = src.size.x, h = src.size.y;
+		bool		 valid	  = true;
+
+		for (uint32 by = 0; by < blocks_y; by++)
+		{
+			for (uint32 bx = 0; bx < blocks_x; bx++)
+			{
+				const uint8* block = src.pixels + (static_cast<size_t>(by) * blocks_x + bx) * block_size;
+				uint8		 rgba[64];
+				for (uint32 i = 0; i < 16; i++)
+				{
+					rgba[i * 4]		= 0;
+					rgba[i * 4 + 1] = 0;
+					rgba[i * 4 + 2] = 0;
+					rgba[i * 4 + 3] = 255;
+				}
+
+				switch (fmt)
+				{
+				case format::bc1_block_srgb:
+				case format::bc1_block_unorm:
+					decode_bc1(block, rgba);
+					break;
+				case format::bc3_block_srgb:
+				case format::bc3_block_unorm:
+					decode_bc3(block, rgba);
+					break;
+				case format::bc4_block_unorm:
+					decode_bc4(block, 0, rgba);
+					break;
+				case format::bc5_block_unorm:
+					decode_bc5(block, rgba);
+					break;
+				case format::bc7_block_srgb:
+				case format::bc7_block_unorm:
+					valid &= decode_bc7(block, rgba);
+					break;
+				default:
+					break;
+				}
+
+				for (uint32 y = 0; y < 4 && by * 4 + y < h; y++)
+				{
+					for (uint32 x = 0; x < 4 && bx * 4 + x < w; x++)
+					{
+						uint8* out = dst.pixels + (static_cast<size_t>(by * 4 + y) * w + bx * 4 + x) * dst.bpp;
+						SFG_MEMCPY(out, rgba + (y * 4 + x) * 4, dst.bpp);
+					}
+				}
+			}
+		}
+
+		return valid;
+	}
+
+	float block_compressor::calculate_psnr(const texture_buffer& a, const texture_buffer& b, uint8 channels)
+	{
+		SFG_ASSERT(a.size.x == b.size.x && a.size.y == b.size.y && a.bpp == b.bpp && channels <= a.bpp);
+
+		const size_t pixel_count = static_cast<size_t>(a.size.x) * a.size.y;
+		uint64		 sum		 = 0;
+		for (size_t i = 0; i < pixel_count; i++)
+		{
+			for (uint8 c = 0; c < channels; c++)
+			{
+				const int32 d = static_cast<int32>(a.pixels[i * a.bpp + c]) - static_cast<int32>(b.pixels[i * b.bpp + c]);
+				sum += static_cast<uint64>(d * d);
+			}
+		}
+
+		if (sum == 0)
+			return MATH_INF_F;
+
+		const double mse = static_cast<double>(sum) / static_cast<double>(pixel_count * channels);
+		return static_cast<float>(10.0 * std::log10(255.0 * 255.0 / mse));
+	}
+}
@@ -0,0 +1,53 @@
+// Copyright (c) 2025 Inan Evin
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "gfx/common/format.hpp"
+
+namespace SFG
+{
+	struct texture_buffer;
+
+#define BC_PARALLEL_BLOCKS		 (64 * 64)
+#define BC7_PARTITION_CANDIDATES 2 // mode 1 partitions fully encoded after the estimate, 1 - 64.
+
+	/*
+		CPU encoders for BC1, BC3, BC4, BC5 & BC7 from 8 bit pixels. Blocks are fitted along the principal axis and refined with least squares,
+		every candidate is scored by decoding it exactly the way the reference decoders below do. BC7 uses mode 6 (single subset rgba) and mode 1
+		(two subset rgb, for opaque blocks). Block rows run on the job system.
+	*/
+	class block_compressor
+	{
+	public:
+		struct desc
+		{
+			format target		  = format::bc7_block_unorm;
+			uint8  bc7_partitions = BC7_PARTITION_CANDIDATES;
+			uint8  parallel		  = 1;
+		};
+
+		/// src is 1 or 4 channels of 8 bits, bc4 reads channel 0, bc5 channels 0 & 1. dst pixels are allocated. Returns false if target isn't a block format.
+		static bool compress(const texture_buffer& src, texture_buffer& dst, const desc& d);
+
+		/// Reference decoder, dst pixels need to be allocated with dst.size = src.size, dst.bpp 1 or 4. Missing channels are written as 0, alpha as 255.
+		static bool decompress(const texture_buffer& src, format fmt, texture_buffer& dst);
+
+		/// Over the first channels of both buffers, same size & bpp. Returns MATH_INF_F for identical data.
+		static float calculate_psnr(const texture_buffer& a, const texture_buffer& b, uint8 channels);
+
+		/// Single blocks, rgba is 16 pixels of 4 channels in row order.
+		static void encode_bc1(const uint8* rgba, uint8* out, bool allow_alpha);
+		static void encode_bc3(const uint8* rgba, uint8* out);
+		static void encode_bc4(const uint8* rgba, uint32 channel, uint8* out);
+		static void encode_bc5(const uint8* rgba, uint8* out);
+		static void encode_bc7(const uint8* rgba, uint8* out, uint32 partition_candidates = BC7_PARTITION_CANDIDATES);
+
+		static void decode_bc1(const uint8* block, uint8* out_rgba);
+		static void decode_bc3(const uint8* block, uint8* out_rgba);
+		static void decode_bc4(const uint8* block, uint32 channel, uint8* out_rgba);
+		static void decode_bc5(const uint8* block, uint8* out_rgba);
+
+		/// Modes 1 & 6 only, the ones encode_bc7 emits. Returns false for any other mode.
+		static bool decode_bc7(const uint8* block, uint8* out_rgba);
+	};
+}
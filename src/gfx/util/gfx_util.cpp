@@ -2,6 +2,8 @@
 #include "gfx_util.hpp"
 #include "math/vector4.hpp"
 #include "gfx/backend/backend.hpp"
+#include "resources/vertex.hpp"
+#include <cstddef>
 
 namespace SFG
 {
@@ -223,28 +225,208 @@ namespace SFG
 		case input_layout_type::gui_default: {
 			inputs = {
 				{
-					.name	  = "POSITION",
-					.location = 0,
-					.index	  = 0,
-					.offset	  = 0,
-					.size	  = sizeof(vector2),
-					.format	  = format::r32g32_sfloat,
+					.name		  = "POSITION",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = 0,
+					.size		  = sizeof(vector2),
+					.input_format = format::r32g32_sfloat,
 				},
 				{
-					.name	  = "TEXCOORD",
-					.location = 0,
-					.index	  = 0,
-					.offset	  = sizeof(vector2),
-					.size	  = sizeof(vector2),
-					.format	  = format::r32g32_sfloat,
+					.name		  = "TEXCOORD",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = sizeof(vector2),
+					.size		  = sizeof(vector2),
+					.input_format = format::r32g32_sfloat,
 				},
 				{
-					.name	  = "COLOR",
-					.location = 0,
-					.index	  = 0,
-					.offset	  = sizeof(vector2) * 2,
-					.size	  = sizeof(vector4),
-					.format	  = format::r32g32b32a32_sfloat,
+					.name		  = "COLOR",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = sizeof(vector2) * 2,
+					.size		  = sizeof(vector4),
+					.input_format = format::r32g32b32a32_sfloat,
+				},
+			};
+			break;
+		}
+		case input_layout_type::mesh_static: {
+			inputs = {
+				{
+					.name		  = "POSITION",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = offsetof(vertex_static, pos),
+					.size		  = sizeof(vector3),
+					.input_format = format::r32g32b32_sfloat,
+				},
+				{
+					.name		  = "NORMAL",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = offsetof(vertex_static, normal),
+					.size		  = sizeof(vector3),
+					.input_format = format::r32g32b32_sfloat,
+				},
+				{
+					.name		  = "TANGENT",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = offsetof(vertex_static, tangent),
+					.size		  = sizeof(vector4),
+					.input_format = format::r32g32b32a32_sfloat,
+				},
+				{
+					.name		  = "TEXCOORD",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = offsetof(vertex_static, uv),
+					.size		  = sizeof(vector2),
+					.input_format = format::r32g32_sfloat,
+				},
+			};
+			break;
+		}
+		case input_layout_type::mesh_skinned: {
+			inputs = {
+				{
+					.name		  = "POSITION",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = offsetof(vertex_skinned, pos),
+					.size		  = sizeof(vector3),
+					.input_format = format::r32g32b32_sfloat,
+				},
+				{
+					.name		  = "NORMAL",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = offsetof(vertex_skinned, normal),
+					.size		  = sizeof(vector3),
+					.input_format = format::r32g32b32_sfloat,
+				},
+				{
+					.name		  = "TANGENT",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = offsetof(vertex_skinned, tangent),
+					.size		  = sizeof(vector4),
+					.input_format = format::r32g32b32a32_sfloat,
+				},
+				{
+					.name		  = "TEXCOORD",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = offsetof(vertex_skinned, uv),
+					.size		  = sizeof(vector2),
+					.input_format = format::r32g32_sfloat,
+				},
+				{
+					.name		  = "BLENDWEIGHT",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = offsetof(vertex_skinned, bone_weights),
+					.size		  = sizeof(vector4),
+					.input_format = format::r32g32b32a32_sfloat,
+				},
+				{
+					.name		  = "BLENDINDICES",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = offsetof(vertex_skinned, bone_indices),
+					.size		  = sizeof(vector4i16),
+					.input_format = format::r16g16b16a16_sint,
+				},
+			};
+			break;
+		}
+		case input_layout_type::mesh_static_packed: {
+			inputs = {
+				{
+					.name		  = "POSITION",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = offsetof(vertex_static_packed, pos),
+					.size		  = sizeof(vector4ui16),
+					.input_format = format::r16g16b16a16_unorm,
+				},
+				{
+					.name		  = "NORMAL",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = offsetof(vertex_static_packed, normal),
+					.size		  = sizeof(vector2i16),
+					.input_format = format::r16g16_snorm,
+				},
+				{
+					.name		  = "TANGENT",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = offsetof(vertex_static_packed, tangent),
+					.size		  = sizeof(vector2i16),
+					.input_format = format::r16g16_snorm,
+				},
+				{
+					.name		  = "TEXCOORD",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = offsetof(vertex_static_packed, uv),
+					.size		  = sizeof(vector2ui16),
+					.input_format = format::r16g16_sfloat,
+				},
+			};
+			break;
+		}
+		case input_layout_type::mesh_skinned_packed: {
+			inputs = {
+				{
+					.name		  = "POSITION",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = offsetof(vertex_skinned_packed, pos),
+					.size		  = sizeof(vector4ui16),
+					.input_format = format::r16g16b16a16_unorm,
+				},
+				{
+					.name		  = "NORMAL",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = offsetof(vertex_skinned_packed, normal),
+					.size		  = sizeof(vector2i16),
+					.input_format = format::r16g16_snorm,
+				},
+				{
+					.name		  = "TANGENT",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = offsetof(vertex_skinned_packed, tangent),
+					.size		  = sizeof(vector2i16),
+					.input_format = format::r16g16_snorm,
+				},
+				{
+					.name		  = "TEXCOORD",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = offsetof(vertex_skinned_packed, uv),
+					.size		  = sizeof(vector2ui16),
+					.input_format = format::r16g16_sfloat,
+				},
+				{
+					.name		  = "BLENDWEIGHT",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = offsetof(vertex_skinned_packed, bone_weights),
+					.size		  = sizeof(uint8) * 4,
+					.input_format = format::r8g8b8a8_unorm,
+				},
+				{
+					.name		  = "BLENDINDICES",
+					.location	  = 0,
+					.index		  = 0,
+					.offset		  = offsetof(vertex_skinned_packed, bone_indices),
+					.size		  = sizeof(uint8) * 4,
+					.input_format = format::r8g8b8a8_uint,
 				},
 			};
 			break;
@@ -8,6 +8,10 @@ namespace SFG
 	enum class input_layout_type
 	{
 		gui_default,
+		mesh_static,
+		mesh_skinned,
+		mesh_static_packed,
+		mesh_skinned_packed,
 	};
 
 	enum root_param_index : uint8
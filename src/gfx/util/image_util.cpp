@@ -7,6 +7,7 @@
 #include "gfx/common/texture_buffer.hpp"
 #include "memory/memory.hpp"
 #include "memory/memory_tracer.hpp"
+#include "mip_util.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_RESIZE_IMPLEMENTATION
@@ -78,7 +79,29 @@ namespace SFG
 		return data;
 	}
 
-	void image_util::generate_mips(texture_buffer* out_buffers, uint8 target_levels, mip_gen_filter filter, uint8 channels, bool is_linear, bool premultiplied_alpha)
+	void image_util::generate_mips(texture_buffer* out_buffers, uint8 target_levels, mip_gen_filter filter, uint8 channels, bool is_linear, bool premultiplied_alpha, bool is_normal_map)
+	{
+		const texture_buffer& buf = out_buffers[0];
+
+		if ((filter == mip_gen_filter::box || filter == mip_gen_filter::kaiser) && channels != 0 && buf.bpp % channels == 0)
+		{
+			const mip_util::desc desc = {
+				.mip_filter			 = filter == mip_gen_filter::box ? mip_util::filter::box : mip_util::filter::kaiser,
+				.channels			 = channels,
+				.channel_size		 = static_cast<uint8>(buf.bpp / channels),
+				.is_linear			 = static_cast<uint8>(is_linear),
+				.premultiplied_alpha = static_cast<uint8>(premultiplied_alpha),
+				.is_normal_map		 = static_cast<uint8>(is_normal_map),
+			};
+
+			mip_util::generate(out_buffers, target_levels, desc);
+			return;
+		}
+
+		generate_mips_stb(out_buffers, target_levels, filter == mip_gen_filter::kaiser ? mip_gen_filter::def : filter, channels, is_linear, premultiplied_alpha);
+	}
+
+	void image_util::generate_mips_stb(texture_buffer* out_buffers, uint8 target_levels, mip_gen_filter filter, uint8 channels, bool is_linear, bool premultiplied_alpha)
 	{
 		const texture_buffer& buf		  = out_buffers[0];
 		uint8*				  last_pixels = buf.pixels;
@@ -19,12 +19,17 @@ namespace SFG
 			cubic_spline,
 			catmullrom,
 			mitchell,
+			kaiser,
 		};
 		static void* load_from_file_ch(const char* file, uint8 force_channels);
 		static void* load_from_file_ch(const char* file, vector2ui16& out_size, uint8 force_channels);
 		static void* load_from_file(const char* file, uint8& out_channels);
 		static void* load_from_file(const char* file, vector2ui16& out_size, uint8& out_channels);
-		static void	 generate_mips(texture_buffer* out_buffers, uint8 target_levels, mip_gen_filter filter, uint8 channels, bool is_linear, bool premultiplied_alpha);
+		/// box & kaiser go through mip_util, parallel & SIMD. Other filters use the stb path.
+		static void	 generate_mips(texture_buffer* out_buffers, uint8 target_levels, mip_gen_filter filter, uint8 channels, bool is_linear, bool premultiplied_alpha, bool is_normal_map = false);
+
+		/// Single threaded stb_image_resize chain, no kaiser.
+		static void	 generate_mips_stb(texture_buffer* out_buffers, uint8 target_levels, mip_gen_filter filter, uint8 channels, bool is_linear, bool premultiplied_alpha);
 		static uint8 calculate_mip_levels(uint16 width, uint16 height);
 		static void	 free(void* data);
 	};
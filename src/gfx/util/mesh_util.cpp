@@ -0,0 +1,888 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "mesh_util.hpp"
+#include "math/vector3.hpp"
+#include "math/math.hpp"
+#include "memory/memory.hpp"
+#include "io/assert.hpp"
+#include <algorithm>
+
+namespace SFG
+{
+#define MESH_INVALID_INDEX	   0xFFFFFFFF
+#define MESH_FETCH_LINE_SIZE   64
+#define MESH_FETCH_CACHE_LINES 64
+#define MESH_KIND_MANIFOLD	   0
+#define MESH_KIND_BORDER	   1
+#define MESH_KIND_LOCKED	   2
+#define MESH_BORDER_WEIGHT	   10.0
+
+	namespace
+	{
+		uint32 hash_bytes(const uint8* data, size_t size)
+		{
+			uint32 h = 2166136261u;
+			for (size_t i = 0; i < size; i++)
+				h = (h ^ data[i]) * 16777619u;
+			return h;
+		}
+
+		const vector3& get_position(const uint8* positions, size_t stride, uint32 index)
+		{
+			return *reinterpret_cast<const vector3*>(positions + static_cast<size_t>(index) * stride);
+		}
+
+		// error(p) = (p^T A p + 2 b^T p + c) / w, A symmetric. Dividing by the total weight keeps it a squared distance.
+		struct quadric
+		{
+			double a00 = 0.0, a11 = 0.0, a22 = 0.0, a01 = 0.0, a02 = 0.0, a12 = 0.0;
+			double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+			double c = 0.0;
+			double w = 0.0;
+		};
+
+		void quadric_add_plane(quadric& q, double nx, double ny, double nz, double d, double w)
+		{
+			q.a00 += w * nx * nx;
+			q.a11 += w * ny * ny;
+			q.a22 += w * nz * nz;
+			q.a01 += w * nx * ny;
+			q.a02 += w * nx * nz;
+			q.a12 += w * ny * nz;
+			q.b0 += w * nx * d;
+			q.b1 += w * ny * d;
+			q.b2 += w * nz * d;
+			q.c += w * d * d;
+			q.w += w;
+		}
+
+		void quadric_add(quadric& q, const quadric& o)
+		{
+			q.a00 += o.a00;
+			q.a11 += o.a11;
+			q.a22 += o.a22;
+			q.a01 += o.a01;
+			q.a02 += o.a02;
+			q.a12 += o.a12;
+			q.b0 += o.b0;
+			q.b1 += o.b1;
+			q.b2 += o.b2;
+			q.c += o.c;
+			q.w += o.w;
+		}
+
+		double quadric_error(const quadric& q, const vector3& p)
+		{
+			const double x = p.x, y = p.y, z = p.z;
+			const double r = x * (q.a00 * x + 2.0 * (q.a01 * y + q.a02 * z + q.b0)) + y * (q.a11 * y + 2.0 * (q.a12 * z + q.b1)) + z * (q.a22 * z + 2.0 * q.b2) + q.c;
+			return r > 0.0 && q.w > 0.0 ? r / q.w : 0.0;
+		}
+
+		vector3 get_triangle_normal(const primitive_index* tri, const uint8* positions, size_t stride)
+		{
+			const vector3& p0 = get_position(positions, stride, tri[0]);
+			const vector3  n  = vector3::cross(get_position(positions, stride, tri[1]) - p0, get_position(positions, stride, tri[2]) - p0);
+			const float	   l  = n.magnitude();
+			return l > 0.0f ? n / l : vector3::zero;
+		}
+
+		// sphere around the bounds center, cone around the average normal. cutoff is the sin of the widest normal's angle to the axis.
+		void calculate_meshlet_bounds(meshlet& m, const primitive_index* indices, const uint8* positions, size_t stride, float orientation)
+		{
+			vector3 bounds_min = vector3(MATH_INF_F, MATH_INF_F, MATH_INF_F);
+			vector3 bounds_max = vector3(-MATH_INF_F, -MATH_INF_F, -MATH_INF_F);
+			vector3 axis	   = vector3::zero;
+
+			for (uint32 i = 0; i < m.index_count; i++)
+			{
+				const vector3& p = get_position(positions, stride, indices[i]);
+				bounds_min		 = vector3::min(bounds_min, p);
+				bounds_max		 = vector3::max(bounds_max, p);
+			}
+
+			for (uint32 i = 0; i < m.index_count; i += 3)
+				axis += get_triangle_normal(indices + i, positions, stride) * orientation;
+
+			m.center = (bounds_min + bounds_max) * 0.5f;
+			m.radius = 0.0f;
+			for (uint32 i = 0; i < m.index_count; i++)
+				m.radius = math::max(m.radius, vector3::distance(m.center, get_position(positions, stride, indices[i])));
+
+			const float axis_length = axis.magnitude();
+			m.cone_axis				= axis_length > MATH_EPS ? axis / axis_length : vector3::zero;
+			m.cone_cutoff			= 1.0f;
+			if (axis_length <= MATH_EPS)
+				return;
+
+			float min_dot = 1.0f;
+			for (uint32 i = 0; i < m.index_count; i += 3)
+			{
+				const vector3 n = get_triangle_normal(indices + i, positions, stride) * orientation;
+				if (!n.is_zero())
+					min_dot = math::min(min_dot, vector3::dot(n, m.cone_axis));
+			}
+
+			// a hemisphere or wider can't be backfacing as a whole.
+			if (min_dot > 0.0f)
+				m.cone_cutoff = std::sqrt(1.0f - min_dot * min_dot);
+		}
+	}
+
+	uint32 mesh_util::generate_weld_remap(uint32* out_remap, const primitive_index* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size)
+	{
+		const uint8* data		= reinterpret_cast<const uint8*>(vertices);
+		size_t		 table_size = 16;
+		while (table_size < vertex_count * 2)
+			table_size <<= 1;
+
+		const size_t   mask = table_size - 1;
+		vector<uint32> table(table_size, MESH_INVALID_INDEX);
+
+		for (size_t i = 0; i < vertex_count; i++)
+			out_remap[i] = MESH_INVALID_INDEX;
+
+		uint32 next = 0;
+
+		for (size_t i = 0; i < index_count; i++)
+		{
+			const uint32 v = indices[i];
+			SFG_ASSERT(v < vertex_count);
+
+			if (out_remap[v] != MESH_INVALID_INDEX)
+				continue;
+
+			const uint8* vertex = data + static_cast<size_t>(v) * vertex_size;
+			size_t		 slot	= hash_bytes(vertex, vertex_size) & mask;
+
+			// linear probing, the table is never more than half full.
+			while (table[slot] != MESH_INVALID_INDEX)
+			{
+				const uint32 other = table[slot];
+				if (SFG_MEMCMP(data + static_cast<size_t>(other) * vertex_size, vertex, vertex_size) == 0)
+					break;
+				slot = (slot + 1) & mask;
+			}
+
+			if (table[slot] == MESH_INVALID_INDEX)
+			{
+				table[slot]	 = v;
+				out_remap[v] = next++;
+			}
+			else
+				out_remap[v] = out_remap[table[slot]];
+		}
+
+		return next;
+	}
+
+	uint32 mesh_util::generate_fetch_remap(uint32* out_remap, const primitive_index* indices, size_t index_count, size_t vertex_count)
+	{
+		for (size_t i = 0; i < vertex_count; i++)
+			out_remap[i] = MESH_INVALID_INDEX;
+
+		uint32 next = 0;
+		for (size_t i = 0; i < index_count; i++)
+		{
+			const uint32 v = indices[i];
+			if (out_remap[v] == MESH_INVALID_INDEX)
+				out_remap[v] = next++;
+		}
+
+		return next;
+	}
+
+	void mesh_util::remap_indices(primitive_index* out, const primitive_index* indices, size_t index_count, const uint32* remap)
+	{
+		for (size_t i = 0; i < index_count; i++)
+		{
+			SFG_ASSERT(remap[indices[i]] != MESH_INVALID_INDEX);
+			out[i] = static_cast<primitive_index>(remap[indices[i]]);
+		}
+	}
+
+	void mesh_util::remap_vertices(void* out, const void* vertices, size_t vertex_count, size_t vertex_size, const uint32* remap)
+	{
+		SFG_ASSERT(out != vertices);
+		uint8*		 dst = reinterpret_cast<uint8*>(out);
+		const uint8* src = reinterpret_cast<const uint8*>(vertices);
+
+		for (size_t i = 0; i < vertex_count; i++)
+		{
+			if (remap[i] != MESH_INVALID_INDEX)
+				SFG_MEMCPY(dst + static_cast<size_t>(remap[i]) * vertex_size, src + i * vertex_size, vertex_size);
+		}
+	}
+
+	void mesh_util::optimize_vertex_cache(primitive_index* out, const primitive_index* indices, size_t index_count, size_t vertex_count, uint32 cache_size, vector<uint32>* out_clusters)
+	{
+		SFG_ASSERT(out != indices);
+		SFG_ASSERT(index_count % 3 == 0);
+
+		const size_t tri_count = index_count / 3;
+
+		if (out_clusters)
+		{
+			out_clusters->resize(0);
+			out_clusters->push_back(0);
+		}
+
+		if (tri_count == 0)
+			return;
+
+		// vertex -> triangles adjacency.
+		vector<uint32> live(vertex_count, 0);
+		vector<uint32> offsets(vertex_count + 1, 0);
+		vector<uint32> adjacency(index_count);
+
+		for (size_t i = 0; i < index_count; i++)
+			live[indices[i]]++;
+
+		for (size_t i = 0; i < vertex_count; i++)
+			offsets[i + 1] = offsets[i] + live[i];
+
+		{
+			vector<uint32> cursor(offsets.begin(), offsets.end() - 1);
+			for (size_t i = 0; i < index_count; i++)
+				adjacency[cursor[indices[i]]++] = static_cast<uint32>(i / 3);
+		}
+
+		vector<uint32> cache_time(vertex_count, 0);
+		vector<uint8>  emitted(tri_count, 0);
+		vector<uint32> dead_end;
+		vector<uint32> candidates;
+		dead_end.reserve(index_count);
+		candidates.reserve(64);
+
+		uint32 time	   = cache_size + 1;
+		uint32 cursor  = 0;
+		size_t out_tri = 0;
+		int64  fanning = 0;
+
+		while (fanning >= 0)
+		{
+			const uint32 f = static_cast<uint32>(fanning);
+			candidates.resize(0);
+
+			for (uint32 k = offsets[f]; k < offsets[f + 1]; k++)
+			{
+				const uint32 t = adjacency[k];
+				if (emitted[t])
+					continue;
+
+				for (uint32 c = 0; c < 3; c++)
+				{
+					const uint32 v		 = indices[t * 3 + c];
+					out[out_tri * 3 + c] = static_cast<primitive_index>(v);
+					dead_end.push_back(v);
+					candidates.push_back(v);
+					live[v]--;
+
+					if (time - cache_time[v] > cache_size)
+						cache_time[v] = time++;
+				}
+
+				emitted[t] = 1;
+				out_tri++;
+			}
+
+			// best candidate still in cache after fanning, favoring vertices with few triangles left.
+			int64 best			= -1;
+			int32 best_priority = -1;
+			for (uint32 v : candidates)
+			{
+				if (live[v] == 0)
+					continue;
+
+				int32 priority = 0;
+				if (time - cache_time[v] + 2 * live[v] <= cache_size)
+					priority = static_cast<int32>(time - cache_time[v]);
+
+				if (priority > best_priority)
+				{
+					best_priority = priority;
+					best		  = v;
+				}
+			}
+
+			if (best == -1)
+			{
+				// dead end, go back through recently emitted vertices, then scan for anything left.
+				while (!dead_end.empty())
+				{
+					const uint32 v = dead_end.back();
+					dead_end.pop_back();
+					if (live[v] != 0)
+					{
+						best = v;
+						break;
+					}
+				}
+
+				while (best == -1 && cursor < vertex_count)
+				{
+					if (live[cursor] != 0)
+						best = cursor;
+					cursor++;
+				}
+
+				if (best != -1 && out_clusters && out_tri > out_clusters->back())
+					out_clusters->push_back(static_cast<uint32>(out_tri));
+			}
+
+			fanning = best;
+		}
+
+		SFG_ASSERT(out_tri == tri_count);
+	}
+
+	void mesh_util::optimize_overdraw(primitive_index* out, const primitive_index* indices, size_t index_count, const uint8* positions, size_t position_stride, size_t vertex_count, const vector<uint32>& clusters, float threshold)
+	{
+		SFG_ASSERT(out != indices);
+
+		const size_t tri_count	   = index_count / 3;
+		const size_t cluster_count = clusters.size();
+
+		if (cluster_count <= 1)
+		{
+			SFG_MEMCPY(out, indices, index_count * sizeof(primitive_index));
+			return;
+		}
+
+		struct cluster_data
+		{
+			float  key	 = 0.0f;
+			uint32 index = 0;
+		};
+
+		// area weighted centroids, cross products are twice the area.
+		vector<vector3> cluster_centroids(cluster_count, vector3::zero);
+		vector<vector3> cluster_normals(cluster_count, vector3::zero);
+		vector<float>	cluster_areas(cluster_count, 0.0f);
+		vector3			mesh_centroid = vector3::zero;
+		float			mesh_area	  = 0.0f;
+
+		for (size_t c = 0; c < cluster_count; c++)
+		{
+			const size_t start = clusters[c];
+			const size_t end   = c + 1 < cluster_count ? clusters[c + 1] : tri_count;
+
+			for (size_t t = start; t < end; t++)
+			{
+				const vector3& p0	= get_position(positions, position_stride, indices[t * 3]);
+				const vector3& p1	= get_position(positions, position_stride, indices[t * 3 + 1]);
+				const vector3& p2	= get_position(positions, position_stride, indices[t * 3 + 2]);
+				const vector3  n	= vector3::cross(p1 - p0, p2 - p0);
+				const float	   area = n.magnitude();
+				const vector3  ctr	= (p0 + p1 + p2) * (area / 3.0f);
+
+				cluster_centroids[c] += ctr;
+				cluster_normals[c] += n;
+				cluster_areas[c] += area;
+				mesh_centroid += ctr;
+				mesh_area += area;
+			}
+		}
+
+		mesh_centroid = mesh_area > 0.0f ? mesh_centroid / mesh_area : mesh_centroid;
+
+		vector<cluster_data> sorted(cluster_count);
+		for (size_t c = 0; c < cluster_count; c++)
+		{
+			const vector3 centroid = cluster_areas[c] > 0.0f ? cluster_centroids[c] / cluster_areas[c] : mesh_centroid;
+			sorted[c]			   = {.key = vector3::dot(centroid - mesh_centroid, cluster_normals[c].normalized()), .index = static_cast<uint32>(c)};
+		}
+
+		// clusters facing away from the center are likely to occlude the rest, draw them first.
+		std::stable_sort(sorted.begin(), sorted.end(), [](const cluster_data& a, const cluster_data& b) { return a.key > b.key; });
+
+		size_t written = 0;
+		for (const cluster_data& cd : sorted)
+		{
+			const size_t start = clusters[cd.index];
+			const size_t end   = cd.index + 1 < cluster_count ? clusters[cd.index + 1] : tri_count;
+			SFG_MEMCPY(out + written, indices + start * 3, (end - start) * 3 * sizeof(primitive_index));
+			written += (end - start) * 3;
+		}
+
+		SFG_ASSERT(written == index_count);
+
+		const cache_stats before = analyze(indices, index_count, vertex_count, 0);
+		const cache_stats after	 = analyze(out, index_count, vertex_count, 0);
+
+		if (after.acmr > before.acmr * threshold)
+			SFG_MEMCPY(out, indices, index_count * sizeof(primitive_index));
+	}
+
+	size_t mesh_util::simplify(primitive_index* out, const primitive_index* indices, size_t index_count, const uint8* positions, size_t position_stride, size_t vertex_count, size_t target_index_count, float target_error, float* out_error)
+	{
+		SFG_ASSERT(index_count % 3 == 0);
+
+		if (out_error)
+			*out_error = 0.0f;
+
+		vector<uint32> result(indices, indices + index_count);
+
+		if (target_index_count >= index_count || index_count == 0)
+		{
+			SFG_MEMCPY(out, indices, index_count * sizeof(primitive_index));
+			return index_count;
+		}
+
+		// work in unit space so the error limit doesn't depend on the mesh size.
+		vector3 bounds_min = get_position(positions, position_stride, indices[0]);
+		vector3 bounds_max = bounds_min;
+		for (size_t i = 0; i < index_count; i++)
+		{
+			bounds_min = vector3::min(bounds_min, get_position(positions, position_stride, indices[i]));
+			bounds_max = vector3::max(bounds_max, get_position(positions, position_stride, indices[i]));
+		}
+
+		const vector3 size	 = bounds_max - bounds_min;
+		const float	  extent = math::max(math::max(size.x, size.y), math::max(size.z, MATH_EPS));
+
+		vector<vector3> pos(vertex_count, vector3::zero);
+		for (size_t v = 0; v < vertex_count; v++)
+			pos[v] = (get_position(positions, position_stride, static_cast<uint32>(v)) - bounds_min) / extent;
+
+		// vertices sharing a position with another one sit on an attribute seam, they stay.
+		vector<uint8> kind(vertex_count, MESH_KIND_MANIFOLD);
+		{
+			vector<uint32> order(vertex_count);
+			for (size_t v = 0; v < vertex_count; v++)
+				order[v] = static_cast<uint32>(v);
+
+			auto less = [&](uint32 a, uint32 b) {
+				if (pos[a].x != pos[b].x)
+					return pos[a].x < pos[b].x;
+				if (pos[a].y != pos[b].y)
+					return pos[a].y < pos[b].y;
+				return pos[a].z < pos[b].z;
+			};
+
+			std::sort(order.begin(), order.end(), less);
+			for (size_t i = 1; i < vertex_count; i++)
+			{
+				if (!less(order[i - 1], order[i]))
+					kind[order[i - 1]] = kind[order[i]] = MESH_KIND_LOCKED;
+			}
+		}
+
+		// directed edges without a twin are on the border, border vertices only move along it.
+		vector<uint32> border_next(vertex_count, MESH_INVALID_INDEX);
+		vector<uint32> border_prev(vertex_count, MESH_INVALID_INDEX);
+		vector<uint8>  border_edges(index_count, 0);
+		{
+			vector<uint64> edges(index_count);
+			for (size_t i = 0; i < index_count; i++)
+			{
+				const uint64 a = result[i];
+				const uint64 b = result[i - i % 3 + (i + 1) % 3];
+				edges[i]	   = (a << 32) | b;
+			}
+
+			vector<uint64> sorted_edges = edges;
+			std::sort(sorted_edges.begin(), sorted_edges.end());
+
+			vector<uint8> border_count(vertex_count, 0);
+			for (size_t i = 0; i < index_count; i++)
+			{
+				const uint32 a		 = static_cast<uint32>(edges[i] >> 32);
+				const uint32 b		 = static_cast<uint32>(edges[i] & 0xFFFFFFFF);
+				const uint64 reverse = (static_cast<uint64>(b) << 32) | a;
+				if (std::binary_search(sorted_edges.begin(), sorted_edges.end(), reverse))
+					continue;
+
+				border_edges[i] = 1;
+				border_next[a]	= b;
+				border_prev[b]	= a;
+				border_count[a]++;
+				border_count[b]++;
+			}
+
+			for (size_t v = 0; v < vertex_count; v++)
+			{
+				if (border_count[v] == 0 || kind[v] == MESH_KIND_LOCKED)
+					continue;
+				kind[v] = border_count[v] == 2 && border_next[v] != MESH_INVALID_INDEX && border_prev[v] != MESH_INVALID_INDEX ? MESH_KIND_BORDER : MESH_KIND_LOCKED;
+			}
+		}
+
+		// area weighted face planes, plus planes perpendicular to border edges keeping the silhouette.
+		vector<quadric> quadrics(vertex_count);
+		for (size_t t = 0; t < index_count; t += 3)
+		{
+			const vector3& p0	  = pos[result[t]];
+			const vector3& p1	  = pos[result[t + 1]];
+			const vector3& p2	  = pos[result[t + 2]];
+			const vector3  normal = vector3::cross(p1 - p0, p2 - p0);
+			const float	   len	  = normal.magnitude();
+			if (len <= 0.0f)
+				continue;
+
+			const vector3 n = normal / len;
+			const double  d = -vector3::dot(n, p0);
+			for (uint32 c = 0; c < 3; c++)
+				quadric_add_plane(quadrics[result[t + c]], n.x, n.y, n.z, d, len * 0.5);
+
+			for (uint32 c = 0; c < 3; c++)
+			{
+				if (!border_edges[t + c])
+					continue;
+
+				const uint32  a		  = result[t + c];
+				const uint32  b		  = result[t + (c + 1) % 3];
+				const vector3 edge	  = pos[b] - pos[a];
+				const float	  edge_sq = vector3::dot(edge, edge);
+				const vector3 en	  = vector3::cross(edge, n).normalized();
+				const double  ed	  = -vector3::dot(en, pos[a]);
+				quadric_add_plane(quadrics[a], en.x, en.y, en.z, ed, edge_sq * MESH_BORDER_WEIGHT);
+				quadric_add_plane(quadrics[b], en.x, en.y, en.z, ed, edge_sq * MESH_BORDER_WEIGHT);
+			}
+		}
+
+		struct collapse
+		{
+			double cost = 0.0;
+			uint32 v	= 0;
+			uint32 t	= 0;
+		};
+
+		const double	 error_limit = static_cast<double>(target_error) * static_cast<double>(target_error);
+		double			 max_error	 = 0.0;
+		vector<collapse> collapses;
+		vector<uint32>	 remap(vertex_count);
+		vector<uint8>	 locked(vertex_count);
+		vector<uint32>	 offsets(vertex_count + 1);
+		vector<uint32>	 adjacency;
+
+		auto can_collapse = [&](uint32 v, uint32 t) {
+			if (kind[v] == MESH_KIND_MANIFOLD)
+				return true;
+			return kind[v] == MESH_KIND_BORDER && (border_next[v] == t || border_prev[v] == t);
+		};
+
+		// rejects collapses flipping or squashing any triangle around v.
+		auto flips = [&](uint32 v, uint32 t) {
+			for (uint32 k = offsets[v]; k < offsets[v + 1]; k++)
+			{
+				const uint32 tri = adjacency[k];
+				const uint32 i0 = result[tri * 3], i1 = result[tri * 3 + 1], i2 = result[tri * 3 + 2];
+				if (i0 == t || i1 == t || i2 == t)
+					continue;
+
+				const vector3 n0 = vector3::cross(pos[i1] - pos[i0], pos[i2] - pos[i0]);
+				const vector3 q0 = i0 == v ? pos[t] : pos[i0];
+				const vector3 q1 = i1 == v ? pos[t] : pos[i1];
+				const vector3 q2 = i2 == v ? pos[t] : pos[i2];
+				const vector3 n1 = vector3::cross(q1 - q0, q2 - q0);
+
+				if (vector3::dot(n0, n1) <= 0.25f * n0.magnitude() * n1.magnitude())
+					return true;
+			}
+			return false;
+		};
+
+		size_t current_count = index_count;
+
+		while (current_count > target_index_count)
+		{
+			const size_t tri_count = current_count / 3;
+
+			// vertex -> triangles for the flip checks.
+			for (size_t v = 0; v <= vertex_count; v++)
+				offsets[v] = 0;
+			for (size_t i = 0; i < current_count; i++)
+				offsets[result[i] + 1]++;
+			for (size_t v = 0; v < vertex_count; v++)
+				offsets[v + 1] += offsets[v];
+
+			adjacency.resize(current_count);
+			{
+				vector<uint32> cursor(offsets.begin(), offsets.end() - 1);
+				for (size_t i = 0; i < current_count; i++)
+					adjacency[cursor[result[i]]++] = static_cast<uint32>(i / 3);
+			}
+
+			collapses.resize(0);
+			for (size_t i = 0; i < current_count; i++)
+			{
+				const uint32 a = result[i];
+				const uint32 b = result[i - i % 3 + (i + 1) % 3];
+
+				if (can_collapse(a, b))
+					collapses.push_back({.cost = quadric_error(quadrics[a], pos[b]), .v = a, .t = b});
+				if (can_collapse(b, a))
+					collapses.push_back({.cost = quadric_error(quadrics[b], pos[a]), .v = b, .t = a});
+			}
+
+			std::sort(collapses.begin(), collapses.end(), [](const collapse& a, const collapse& b) { return a.cost < b.cost; });
+
+			for (size_t v = 0; v < vertex_count; v++)
+			{
+				remap[v]  = static_cast<uint32>(v);
+				locked[v] = 0;
+			}
+
+			// every collapse drops ~2 triangles, a border one 1, don't overshoot the target within a pass.
+			const size_t to_remove = tri_count - target_index_count / 3;
+			size_t		 removed   = 0;
+			size_t		 applied   = 0;
+
+			for (const collapse& c : collapses)
+			{
+				if (c.cost > error_limit || removed >= to_remove)
+					break;
+
+				if (locked[c.v] || locked[c.t] || flips(c.v, c.t))
+					continue;
+
+				remap[c.v] = c.t;
+				quadric_add(quadrics[c.t], quadrics[c.v]);
+				max_error = c.cost > max_error ? c.cost : max_error;
+
+				// the one ring of v changes, nothing around it can collapse again this pass.
+				for (uint32 k = offsets[c.v]; k < offsets[c.v + 1]; k++)
+				{
+					const uint32 tri = adjacency[k];
+					for (uint32 j = 0; j < 3; j++)
+						locked[result[tri * 3 + j]] = 1;
+				}
+
+				if (kind[c.v] == MESH_KIND_BORDER)
+				{
+					const uint32 prev	= border_prev[c.v];
+					const uint32 next	= border_next[c.v];
+					border_next[prev]	= next;
+					border_prev[next]	= prev;
+					removed += 1;
+				}
+				else
+					removed += 2;
+
+				applied++;
+			}
+
+			if (applied == 0)
+				break;
+
+			size_t write = 0;
+			for (size_t i = 0; i < current_count; i += 3)
+			{
+				const uint32 a = remap[result[i]];
+				const uint32 b = remap[result[i + 1]];
+				const uint32 c = remap[result[i + 2]];
+				if (a == b || b == c || a == c)
+					continue;
+
+				result[write++] = a;
+				result[write++] = b;
+				result[write++] = c;
+			}
+
+			current_count = write;
+		}
+
+		for (size_t i = 0; i < current_count; i++)
+			out[i] = static_cast<primitive_index>(result[i]);
+
+		if (out_error)
+			*out_error = static_cast<float>(std::sqrt(max_error)) * extent;
+
+		return current_count;
+	}
+
+	size_t mesh_util::build_meshlets(vector<meshlet>& out_meshlets, primitive_index* out, const primitive_index* indices, size_t index_count, const uint8* positions, size_t position_stride, const uint8* normals, size_t normal_stride, size_t vertex_count, uint32 max_vertices, uint32 max_triangles)
+	{
+		SFG_ASSERT(out != indices);
+		SFG_ASSERT(max_vertices >= 3 && max_triangles > 0);
+
+		out_meshlets.resize(0);
+		const size_t tri_count = index_count / 3;
+		if (tri_count == 0)
+			return 0;
+
+		vector<vector3> tri_normals(tri_count);
+		float			votes = 0.0f;
+		for (size_t t = 0; t < tri_count; t++)
+		{
+			const primitive_index* tri = indices + t * 3;
+			tri_normals[t]			   = get_triangle_normal(tri, positions, position_stride);
+
+			if (normals == nullptr || tri_normals[t].is_zero())
+				continue;
+
+			const vector3 vn = get_position(normals, normal_stride, tri[0]) + get_position(normals, normal_stride, tri[1]) + get_position(normals, normal_stride, tri[2]);
+			votes += vector3::dot(tri_normals[t], vn) >= 0.0f ? 1.0f : -1.0f;
+		}
+
+		const float orientation = votes < 0.0f ? -1.0f : 1.0f;
+		if (orientation < 0.0f)
+		{
+			for (vector3& n : tri_normals)
+				n = n * -1.0f;
+		}
+
+		// vertex -> triangles.
+		vector<uint32> adjacency_offsets(vertex_count + 1, 0);
+		vector<uint32> adjacency(tri_count * 3);
+		for (size_t i = 0; i < tri_count * 3; i++)
+			adjacency_offsets[indices[i] + 1]++;
+		for (size_t v = 0; v < vertex_count; v++)
+			adjacency_offsets[v + 1] += adjacency_offsets[v];
+
+		vector<uint32> cursor(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+		for (size_t i = 0; i < tri_count * 3; i++)
+			adjacency[cursor[indices[i]]++] = static_cast<uint32>(i / 3);
+
+		vector<uint8>  emitted(tri_count, 0);
+		vector<uint32> vertex_tag(vertex_count, MESH_INVALID_INDEX);
+		vector<uint32> vertex_local(vertex_count, 0);
+		vector<uint32> meshlet_vertices;
+		meshlet_vertices.reserve(max_vertices);
+
+		vector<primitive_index> local_indices(static_cast<size_t>(max_triangles) * 3);
+		vector<primitive_index> local_optimized(static_cast<size_t>(max_triangles) * 3);
+
+		size_t written = 0;
+		size_t seed	   = 0;
+
+		while (true)
+		{
+			while (seed < tri_count && emitted[seed])
+				seed++;
+
+			if (seed == tri_count)
+				break;
+
+			const uint32 tag	   = static_cast<uint32>(out_meshlets.size());
+			const size_t start	   = written;
+			vector3		 normal_sum = vector3::zero;
+			uint32		 tri		= static_cast<uint32>(seed);
+			uint32		 tri_added	= 0;
+			meshlet_vertices.resize(0);
+
+			while (tri != MESH_INVALID_INDEX)
+			{
+				emitted[tri] = 1;
+				for (uint32 k = 0; k < 3; k++)
+				{
+					const uint32 v = indices[tri * 3 + k];
+					out[written++] = v;
+					if (vertex_tag[v] != tag)
+					{
+						vertex_tag[v]	= tag;
+						vertex_local[v] = static_cast<uint32>(meshlet_vertices.size());
+						meshlet_vertices.push_back(v);
+					}
+				}
+
+				normal_sum += tri_normals[tri];
+				if (++tri_added == max_triangles)
+					break;
+
+				// next one shares a vertex, adds the fewest new vertices and bends the cone the least.
+				const float	  sum_length = normal_sum.magnitude();
+				const vector3 axis		 = sum_length > MATH_EPS ? normal_sum / sum_length : vector3::zero;
+				float		  best_score = MATH_INF_F;
+				tri						 = MESH_INVALID_INDEX;
+
+				for (uint32 mv : meshlet_vertices)
+				{
+					for (uint32 a = adjacency_offsets[mv]; a < adjacency_offsets[mv + 1]; a++)
+					{
+						const uint32 candidate = adjacency[a];
+						if (emitted[candidate])
+							continue;
+
+						const primitive_index* c		 = indices + static_cast<size_t>(candidate) * 3;
+						const uint32		   new_verts = (vertex_tag[c[0]] != tag) + (vertex_tag[c[1]] != tag) + (vertex_tag[c[2]] != tag);
+						if (meshlet_vertices.size() + new_verts > max_vertices)
+							continue;
+
+						const float score = static_cast<float>(new_verts) + (1.0f - vector3::dot(tri_normals[candidate], axis)) * MESH_CONE_WEIGHT;
+						if (score < best_score)
+						{
+							best_score = score;
+							tri		   = candidate;
+						}
+					}
+				}
+			}
+
+			// growth order isn't cache friendly, reorder within the meshlet on its local vertices.
+			const size_t count = written - start;
+			for (size_t i = 0; i < count; i++)
+				local_indices[i] = vertex_local[out[start + i]];
+			optimize_vertex_cache(local_optimized.data(), local_indices.data(), count, meshlet_vertices.size());
+			for (size_t i = 0; i < count; i++)
+				out[start + i] = meshlet_vertices[local_optimized[i]];
+
+			meshlet m	  = {};
+			m.index_start = static_cast<uint32>(start);
+			m.index_count = static_cast<uint32>(written - start);
+			calculate_meshlet_bounds(m, out + start, positions, position_stride, orientation);
+			out_meshlets.push_back(m);
+		}
+
+		return out_meshlets.size();
+	}
+
+	mesh_util::cache_stats mesh_util::analyze(const primitive_index* indices, size_t index_count, size_t vertex_count, size_t vertex_size, uint32 cache_size)
+	{
+		cache_stats stats = {};
+		if (index_count == 0)
+			return stats;
+
+		vector<uint32> cache_time(vertex_count, 0);
+		vector<uint8>  used(vertex_count, 0);
+		uint32		   time = cache_size + 1;
+
+		// fetch side, a small fifo of cache lines the vertex fetches go through.
+		uint64 lines[MESH_FETCH_CACHE_LINES];
+		uint32 line_head = 0;
+		for (uint32 i = 0; i < MESH_FETCH_CACHE_LINES; i++)
+			lines[i] = UINT64_MAX;
+
+		for (size_t i = 0; i < index_count; i++)
+		{
+			const uint32 v = indices[i];
+
+			if (!used[v])
+			{
+				used[v] = 1;
+				stats.vertices++;
+			}
+
+			if (time - cache_time[v] <= cache_size)
+				continue;
+
+			cache_time[v] = time++;
+			stats.transformed++;
+
+			if (vertex_size == 0)
+				continue;
+
+			const uint64 first = (static_cast<uint64>(v) * vertex_size) / MESH_FETCH_LINE_SIZE;
+			const uint64 last  = (static_cast<uint64>(v) * vertex_size + vertex_size - 1) / MESH_FETCH_LINE_SIZE;
+			for (uint64 line = first; line <= last; line++)
+			{
+				bool hit = false;
+				for (uint32 k = 0; k < MESH_FETCH_CACHE_LINES && !hit; k++)
+					hit = lines[k] == line;
+
+				if (hit)
+					continue;
+
+				lines[line_head] = line;
+				line_head		 = (line_head + 1) % MESH_FETCH_CACHE_LINES;
+				stats.fetched_bytes += MESH_FETCH_LINE_SIZE;
+			}
+		}
+
+		stats.triangles = static_cast<uint32>(index_count / 3);
+		stats.acmr		= static_cast<float>(stats.transformed) / static_cast<float>(stats.triangles);
+		stats.atvr		= stats.vertices == 0 ? 0.0f : static_cast<float>(stats.transformed) / static_cast<float>(stats.vertices);
+		stats.overfetch = vertex_size == 0 ? 0.0f : static_cast<float>(stats.fetched_bytes) / static_cast<float>(vertex_count * vertex_size);
+		return stats;
+	}
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2025 Inan Evin
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "data/vector.hpp"
+#include "gfx/common/gfx_constants.hpp"
+#include "resources/meshlet.hpp"
+
+namespace SFG
+{
+#define MESH_CACHE_SIZE			16
+#define MESH_OVERDRAW_THRESHOLD 1.05f
+#define MESH_MESHLET_VERTICES	64
+#define MESH_MESHLET_TRIANGLES	124
+#define MESH_CONE_WEIGHT		0.5f
+
+	/*
+		Cook time index/vertex reordering, run in this order:
+		weld -> vertex cache (tipsify) -> overdraw (cluster sort) -> vertex fetch.
+		Everything works on plain index/vertex arrays, nothing here touches the gpu.
+	*/
+	class mesh_util
+	{
+	public:
+		struct cache_stats
+		{
+			uint32 transformed	 = 0;
+			uint32 vertices		 = 0;
+			uint32 triangles	 = 0;
+			uint32 fetched_bytes = 0;
+			float  acmr			 = 0.0f; // transformed / triangles, 0.5 best, 3 worst.
+			float  atvr			 = 0.0f; // transformed / unique vertices, 1 best.
+			float  overfetch	 = 0.0f; // fetched bytes / vertex buffer size, 1 best.
+		};
+
+		/// Bitwise identical vertices get the same index, unreferenced ones are mapped to UINT32_MAX. Returns the welded vertex count.
+		static uint32 generate_weld_remap(uint32* out_remap, const primitive_index* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size);
+
+		/// Remap in first-use order of the index buffer, so vertices are fetched linearly. Returns the used vertex count.
+		static uint32 generate_fetch_remap(uint32* out_remap, const primitive_index* indices, size_t index_count, size_t vertex_count);
+
+		static void remap_indices(primitive_index* out, const primitive_index* indices, size_t index_count, const uint32* remap);
+		static void remap_vertices(void* out, const void* vertices, size_t vertex_count, size_t vertex_size, const uint32* remap);
+
+		/// Tipsify (Sander et al. 2007). out_clusters receives the triangle offsets where the cache was flushed, optional.
+		static void optimize_vertex_cache(primitive_index* out, const primitive_index* indices, size_t index_count, size_t vertex_count, uint32 cache_size = MESH_CACHE_SIZE, vector<uint32>* out_clusters = nullptr);
+
+		/// Sorts the clusters produced by optimize_vertex_cache outside-in, as long as ACMR stays within threshold of the input.
+		static void optimize_overdraw(primitive_index* out, const primitive_index* indices, size_t index_count, const uint8* positions, size_t position_stride, size_t vertex_count, const vector<uint32>& clusters, float threshold = MESH_OVERDRAW_THRESHOLD);
+
+		/// Quadric error edge collapse onto existing vertices, so the vertex buffer is shared with the source. Stops at target_index_count or when the next collapse
+		/// costs more than target_error, relative to the mesh extent. Borders only collapse along themselves, attribute seams are kept. Returns the written index count,
+		/// out_error receives the reached error in mesh units.
+		static size_t simplify(primitive_index* out, const primitive_index* indices, size_t index_count, const uint8* positions, size_t position_stride, size_t vertex_count, size_t target_index_count, float target_error, float* out_error = nullptr);
+
+		/// Greedy clusters grown through shared vertices, preferring triangles that add the fewest vertices and keep the normal cone tight. Writes the triangles
+		/// to out so every meshlet is a contiguous range, out can't alias indices. normals are optional and only decide which side of the triangles is the front,
+		/// by majority vote against the winding. Returns the meshlet count.
+		static size_t build_meshlets(vector<meshlet>& out_meshlets, primitive_index* out, const primitive_index* indices, size_t index_count, const uint8* positions, size_t position_stride, const uint8* normals, size_t normal_stride, size_t vertex_count, uint32 max_vertices = MESH_MESHLET_VERTICES, uint32 max_triangles = MESH_MESHLET_TRIANGLES);
+
+		/// FIFO cache simulation.
+		static cache_stats analyze(const primitive_index* indices, size_t index_count, size_t vertex_count, size_t vertex_size, uint32 cache_size = MESH_CACHE_SIZE);
+
+		/// Whole pipeline on one primitive, VERTEX needs a vector3 pos member.
+		template <typename VERTEX> static void optimize(vector<VERTEX>& vertices, vector<primitive_index>& indices)
+		{
+			const size_t index_count = indices.size();
+			if (index_count == 0 || vertices.empty())
+				return;
+
+			vector<uint32>			remap(vertices.size());
+			vector<primitive_index> tmp_indices(index_count);
+			vector<VERTEX>			tmp_vertices;
+
+			const uint32 welded = generate_weld_remap(remap.data(), indices.data(), index_count, vertices.data(), vertices.size(), sizeof(VERTEX));
+			tmp_vertices.resize(welded);
+			remap_indices(indices.data(), indices.data(), index_count, remap.data());
+			remap_vertices(tmp_vertices.data(), vertices.data(), vertices.size(), sizeof(VERTEX), remap.data());
+			vertices.swap(tmp_vertices);
+
+			vector<uint32> clusters;
+			optimize_vertex_cache(tmp_indices.data(), indices.data(), index_count, vertices.size(), MESH_CACHE_SIZE, &clusters);
+			optimize_overdraw(indices.data(), tmp_indices.data(), index_count, reinterpret_cast<const uint8*>(&vertices[0].pos), sizeof(VERTEX), vertices.size(), clusters);
+
+			const uint32 used = generate_fetch_remap(remap.data(), indices.data(), index_count, vertices.size());
+			tmp_vertices.resize(used);
+			remap_indices(indices.data(), indices.data(), index_count, remap.data());
+			remap_vertices(tmp_vertices.data(), vertices.data(), vertices.size(), sizeof(VERTEX), remap.data());
+			vertices.swap(tmp_vertices);
+		}
+	};
+}
@@ -0,0 +1,479 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "mip_util.hpp"
+#include "gfx/common/texture_buffer.hpp"
+#include "data/vector.hpp"
+#include "memory/memory.hpp"
+#include "memory/memory_tracer.hpp"
+#include "thread/job_system.hpp"
+#include "io/assert.hpp"
+#include "math/math.hpp"
+#include <cmath>
+
+#if defined(__AVX__)
+#define SFG_MIP_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SFG_MIP_SSE
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#define SFG_MIP_NEON
+#include <arm_neon.h>
+#endif
+
+namespace SFG
+{
+#define MIP_SRGB_BUCKETS 4096
+
+	namespace
+	{
+		struct mip_tables
+		{
+			float srgb[256];
+			float linear[256];
+			float srgb_thresholds[256]; // linear value where the encoded byte steps from k to k + 1, last one never reached.
+			uint8 srgb_buckets[MIP_SRGB_BUCKETS];
+		};
+
+		double srgb_decode(double c)
+		{
+			return c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+		}
+
+		const mip_tables& get_tables()
+		{
+			static const mip_tables tables = []() {
+				mip_tables t;
+				for (uint32 i = 0; i < 256; i++)
+				{
+					t.srgb[i]	= static_cast<float>(srgb_decode(i / 255.0));
+					t.linear[i] = static_cast<float>(i / 255.0);
+				}
+				for (uint32 i = 0; i < 255; i++)
+					t.srgb_thresholds[i] = static_cast<float>(srgb_decode((i + 0.5) / 255.0));
+				t.srgb_thresholds[255] = MATH_INF_F;
+
+				// code at the low end of every bucket, encoding walks up from there.
+				uint32 code = 0;
+				for (uint32 i = 0; i < MIP_SRGB_BUCKETS; i++)
+				{
+					const float v = static_cast<float>(i) / static_cast<float>(MIP_SRGB_BUCKETS - 1);
+					while (t.srgb_thresholds[code] <= v)
+						code++;
+					t.srgb_buckets[i] = static_cast<uint8>(code);
+				}
+				return t;
+			}();
+			return tables;
+		}
+
+		double bessel_i0(double x)
+		{
+			double sum	= 1.0;
+			double term = 1.0;
+			for (uint32 k = 1; k < 32; k++)
+			{
+				const double t = x / (2.0 * k);
+				term *= t * t;
+				sum += term;
+				if (term < sum * 1e-12)
+					break;
+			}
+			return sum;
+		}
+
+		/// x is the distance of a source pixel center to the destination pixel center, in source pixels.
+		double filter_weight(mip_util::filter f, double x, double scale, double radius)
+		{
+			if (f == mip_util::filter::box)
+				return math::max(0.0, math::min(x + 0.5, radius) - math::max(x - 0.5, -radius));
+
+			if (x <= -radius || x >= radius)
+				return 0.0;
+
+			const double t		= x / scale;
+			const double sinc	= t == 0.0 ? 1.0 : std::sin(MATH_PI * t) / (MATH_PI * t);
+			const double r		= x / radius;
+			const double window = bessel_i0(MIP_KAISER_ALPHA * std::sqrt(1.0 - r * r)) / bessel_i0(MIP_KAISER_ALPHA);
+			return sinc * window;
+		}
+
+		/// Every destination pixel reads taps consecutive source pixels from start, edges are clamped by folding weights onto the border pixels.
+		struct contributors
+		{
+			vector<uint32> start;
+			vector<float>  weights;
+			uint32		   taps = 0;
+
+			void build(uint32 src, uint32 dst, mip_util::filter f)
+			{
+				const double scale	= static_cast<double>(src) / static_cast<double>(dst);
+				const double radius = f == mip_util::filter::box ? scale * 0.5 : MIP_KAISER_WIDTH * math::max(scale, 1.0);
+				const int64	 last	= static_cast<int64>(src) - 1;
+
+				// visits the non zero weights of destination pixel i with their clamped source index.
+				auto for_each_weight = [&](uint32 i, auto&& fn) {
+					const double center = (i + 0.5) * scale;
+					const int64	 lo		= static_cast<int64>(std::floor(center - radius));
+					const int64	 hi		= static_cast<int64>(std::ceil(center + radius));
+					for (int64 j = lo; j <= hi; j++)
+					{
+						const double w = filter_weight(f, static_cast<double>(j) + 0.5 - center, scale, radius);
+						if (w != 0.0)
+							fn(j < 0 ? 0 : (j > last ? last : j), w);
+					}
+				};
+
+				start.resize(dst);
+				taps = 1;
+				for (uint32 i = 0; i < dst; i++)
+				{
+					int64 first = last;
+					int64 end	= 0;
+					for_each_weight(i, [&](int64 j, double) {
+						first = j < first ? j : first;
+						end	  = j > end ? j : end;
+					});
+
+					start[i] = static_cast<uint32>(first <= end ? first : 0);
+					taps	 = first <= end && static_cast<uint32>(end - first + 1) > taps ? static_cast<uint32>(end - first + 1) : taps;
+				}
+
+				weights.assign(static_cast<size_t>(dst) * taps, 0.0f);
+				vector<double> local(taps);
+
+				for (uint32 i = 0; i < dst; i++)
+				{
+					start[i]   = start[i] < src - taps ? start[i] : src - taps;
+					double sum = 0.0;
+					for (double& w : local)
+						w = 0.0;
+
+					for_each_weight(i, [&](int64 j, double w) {
+						local[static_cast<size_t>(j - start[i])] += w;
+						sum += w;
+					});
+
+					float* out = weights.data() + static_cast<size_t>(i) * taps;
+					for (uint32 k = 0; k < taps; k++)
+						out[k] = static_cast<float>(sum != 0.0 ? local[k] / sum : 0.0);
+				}
+			}
+		};
+
+		struct mip_job
+		{
+			const texture_buffer* src = nullptr;
+			texture_buffer*		  dst = nullptr;
+			const mip_util::desc* d	  = nullptr;
+			contributors		  horizontal;
+			contributors		  vertical;
+			bool				  alpha_weighted = false;
+		};
+
+		uint8 encode_srgb(const mip_tables& tables, float value)
+		{
+			const float v	 = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+			uint32		code = tables.srgb_buckets[static_cast<uint32>(v * static_cast<float>(MIP_SRGB_BUCKETS - 1))];
+			while (tables.srgb_thresholds[code] <= v)
+				code++;
+			while (code > 0 && tables.srgb_thresholds[code - 1] > v)
+				code--;
+			return static_cast<uint8>(code);
+		}
+
+		void decode_row(const mip_job& job, uint32 y, float* out)
+		{
+			const mip_tables& tables   = get_tables();
+			const uint32	  channels = job.d->channels;
+			const uint32	  count	   = static_cast<uint32>(job.src->size.x) * channels;
+			const uint8*	  row	   = job.src->pixels + static_cast<size_t>(y) * job.src->size.x * job.src->bpp;
+
+			if (job.d->channel_size == 2)
+			{
+				const uint16* row16 = reinterpret_cast<const uint16*>(row);
+				for (uint32 i = 0; i < count; i++)
+					out[i] = static_cast<float>(row16[i]) * (1.0f / 65535.0f);
+			}
+			else
+			{
+				const float* channel_tables[4] = {};
+				for (uint32 c = 0; c < channels; c++)
+					channel_tables[c] = job.d->is_linear == 0 && c != 3 ? tables.srgb : tables.linear;
+
+				for (uint32 i = 0; i < count; i += channels)
+				{
+					for (uint32 c = 0; c < channels; c++)
+						out[i + c] = channel_tables[c][row[i + c]];
+				}
+			}
+
+			if (!job.alpha_weighted)
+				return;
+
+			for (uint32 i = 0; i < count; i += 4)
+			{
+				out[i]	   = out[i] * out[i + 3];
+				out[i + 1] = out[i + 1] * out[i + 3];
+				out[i + 2] = out[i + 2] * out[i + 3];
+			}
+		}
+
+		void encode_row(const mip_job& job, uint32 y, float* in)
+		{
+			const mip_tables& tables   = get_tables();
+			const uint32	  channels = job.d->channels;
+			const uint32	  width	   = job.dst->size.x;
+			const uint32	  count	   = width * channels;
+			uint8*			  row	   = job.dst->pixels + static_cast<size_t>(y) * width * job.dst->bpp;
+
+			for (uint32 x = 0; x < width; x++)
+			{
+				float* px = in + x * channels;
+
+				if (job.alpha_weighted && px[3] > 0.0f)
+				{
+					px[0] = px[0] / px[3];
+					px[1] = px[1] / px[3];
+					px[2] = px[2] / px[3];
+				}
+
+				for (uint32 c = 0; c < channels; c++)
+					px[c] = px[c] < 0.0f ? 0.0f : (px[c] > 1.0f ? 1.0f : px[c]);
+
+				if (!job.d->is_normal_map)
+					continue;
+
+				if (channels >= 3)
+				{
+					const float nx	= px[0] * 2.0f - 1.0f;
+					const float ny	= px[1] * 2.0f - 1.0f;
+					const float nz	= px[2] * 2.0f - 1.0f;
+					const float len = std::sqrt(nx * nx + ny * ny + nz * nz);
+					if (len > 0.0f)
+					{
+						px[0] = nx / len * 0.5f + 0.5f;
+						px[1] = ny / len * 0.5f + 0.5f;
+						px[2] = nz / len * 0.5f + 0.5f;
+					}
+				}
+				else if (channels == 2)
+				{
+					// z is reconstructed from xy, only xy leaving the unit disc needs fixing.
+					const float nx	= px[0] * 2.0f - 1.0f;
+					const float ny	= px[1] * 2.0f - 1.0f;
+					const float len = std::sqrt(nx * nx + ny * ny);
+					if (len > 1.0f)
+					{
+						px[0] = nx / len * 0.5f + 0.5f;
+						px[1] = ny / len * 0.5f + 0.5f;
+					}
+				}
+			}
+
+			if (job.d->channel_size == 2)
+			{
+				uint16* row16 = reinterpret_cast<uint16*>(row);
+				for (uint32 i = 0; i < count; i++)
+					row16[i] = static_cast<uint16>(in[i] * 65535.0f + 0.5f);
+				return;
+			}
+
+			for (uint32 i = 0; i < count; i += channels)
+			{
+				for (uint32 c = 0; c < channels; c++)
+					row[i + c] = job.d->is_linear == 0 && c != 3 ? encode_srgb(tables, in[i + c]) : static_cast<uint8>(in[i + c] * 255.0f + 0.5f);
+			}
+		}
+
+#if defined(SFG_MIP_AVX) || defined(SFG_MIP_SSE) || defined(SFG_MIP_NEON)
+		/// TAPS 0 reads the tap count from c.
+		template <uint32 TAPS> void filter_horizontal_rgba(const contributors& c, const float* in, float* out, uint32 dst_width)
+		{
+			const uint32 taps = TAPS == 0 ? c.taps : TAPS;
+
+			for (uint32 i = 0; i < dst_width; i++)
+			{
+				const float* w = c.weights.data() + static_cast<size_t>(i) * taps;
+				const float* s = in + static_cast<size_t>(c.start[i]) * 4;
+#if defined(SFG_MIP_NEON)
+				float32x4_t acc = vdupq_n_f32(0.0f);
+				for (uint32 k = 0; k < taps; k++)
+					acc = vaddq_f32(acc, vmulq_f32(vdupq_n_f32(w[k]), vld1q_f32(s + k * 4)));
+				vst1q_f32(out + i * 4, acc);
+#else
+				__m128 acc = _mm_setzero_ps();
+				for (uint32 k = 0; k < taps; k++)
+					acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(w[k]), _mm_loadu_ps(s + k * 4)));
+				_mm_storeu_ps(out + i * 4, acc);
+#endif
+			}
+		}
+#endif
+
+		void filter_horizontal(const contributors& c, const float* in, float* out, uint32 dst_width, uint32 channels, bool simd)
+		{
+			const uint32 taps = c.taps;
+
+#if defined(SFG_MIP_AVX) || defined(SFG_MIP_SSE) || defined(SFG_MIP_NEON)
+			if (simd && channels == 4)
+			{
+				// exact halving of a box is the common case, a fixed tap count lets it unroll.
+				if (taps == 2)
+					filter_horizontal_rgba<2>(c, in, out, dst_width);
+				else
+					filter_horizontal_rgba<0>(c, in, out, dst_width);
+				return;
+			}
+#endif
+
+			for (uint32 i = 0; i < dst_width; i++)
+			{
+				const float* w = c.weights.data() + static_cast<size_t>(i) * taps;
+				const float* s = in + static_cast<size_t>(c.start[i]) * channels;
+				float*		 o = out + static_cast<size_t>(i) * channels;
+
+				for (uint32 ch = 0; ch < channels; ch++)
+					o[ch] = 0.0f;
+
+				for (uint32 k = 0; k < taps; k++)
+				{
+					for (uint32 ch = 0; ch < channels; ch++)
+						o[ch] = o[ch] + w[k] * s[k * channels + ch];
+				}
+			}
+		}
+
+		void filter_vertical(const float* rows, size_t row_stride, const float* w, uint32 taps, float* out, uint32 count, bool simd)
+		{
+			uint32 i = 0;
+
+			if (simd)
+			{
+#if defined(SFG_MIP_AVX)
+				for (; i + 8 <= count; i += 8)
+				{
+					__m256 acc = _mm256_setzero_ps();
+					for (uint32 k = 0; k < taps; k++)
+						acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_set1_ps(w[k]), _mm256_loadu_ps(rows + k * row_stride + i)));
+					_mm256_storeu_ps(out + i, acc);
+				}
+#endif
+
+#if defined(SFG_MIP_AVX) || defined(SFG_MIP_SSE)
+				for (; i + 4 <= count; i += 4)
+				{
+					__m128 acc = _mm_setzero_ps();
+					for (uint32 k = 0; k < taps; k++)
+						acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(w[k]), _mm_loadu_ps(rows + k * row_stride + i)));
+					_mm_storeu_ps(out + i, acc);
+				}
+#elif defined(SFG_MIP_NEON)
+				for (; i + 4 <= count; i += 4)
+				{
+					float32x4_t acc = vdupq_n_f32(0.0f);
+					for (uint32 k = 0; k < taps; k++)
+						acc = vaddq_f32(acc, vmulq_f32(vdupq_n_f32(w[k]), vld1q_f32(rows + k * row_stride + i)));
+					vst1q_f32(out + i, acc);
+				}
+#endif
+			}
+
+			for (; i < count; i++)
+			{
+				float acc = 0.0f;
+				for (uint32 k = 0; k < taps; k++)
+					acc = acc + w[k] * rows[k * row_stride + i];
+				out[i] = acc;
+			}
+		}
+
+		void process_band(const mip_job& job, uint32 band)
+		{
+			const uint32 channels	= job.d->channels;
+			const uint32 dst_w		= job.dst->size.x;
+			const uint32 dst_h		= job.dst->size.y;
+			const uint32 y0			= band * MIP_BAND_ROWS;
+			const uint32 y1			= math::min(y0 + MIP_BAND_ROWS, dst_h);
+			const uint32 src_row0	= job.vertical.start[y0];
+			const uint32 src_row1	= job.vertical.start[y1 - 1] + job.vertical.taps;
+			const size_t row_floats = static_cast<size_t>(dst_w) * channels;
+			const bool	 simd		= job.d->use_simd != 0;
+
+			vector<float> decoded(static_cast<size_t>(job.src->size.x) * channels);
+			vector<float> filtered((src_row1 - src_row0) * row_floats);
+			vector<float> out(row_floats);
+
+			for (uint32 r = src_row0; r < src_row1; r++)
+			{
+				decode_row(job, r, decoded.data());
+				filter_horizontal(job.horizontal, decoded.data(), filtered.data() + (r - src_row0) * row_floats, dst_w, channels, simd);
+			}
+
+			for (uint32 y = y0; y < y1; y++)
+			{
+				const float* rows = filtered.data() + (job.vertical.start[y] - src_row0) * row_floats;
+				const float* w	  = job.vertical.weights.data() + static_cast<size_t>(y) * job.vertical.taps;
+				filter_vertical(rows, row_floats, w, job.vertical.taps, out.data(), static_cast<uint32>(row_floats), simd);
+				encode_row(job, y, out.data());
+			}
+		}
+	}
+
+	void mip_util::downsample(const texture_buffer& src, texture_buffer& dst, const desc& d)
+	{
+		SFG_ASSERT(d.channels >= 1 && d.channels <= 4);
+		SFG_ASSERT(d.channel_size == 1 || d.channel_size == 2);
+		SFG_ASSERT(src.bpp == d.channels * d.channel_size && dst.bpp == src.bpp);
+
+		mip_job job		   = {};
+		job.src			   = &src;
+		job.dst			   = &dst;
+		job.d			   = &d;
+		job.alpha_weighted = d.channels == 4 && !d.premultiplied_alpha && !d.is_normal_map;
+		job.horizontal.build(src.size.x, dst.size.x, d.mip_filter);
+		job.vertical.build(src.size.y, dst.size.y, d.mip_filter);
+
+		const uint32 band_count = (dst.size.y + MIP_BAND_ROWS - 1) / MIP_BAND_ROWS;
+
+		if (d.parallel && static_cast<uint32>(dst.size.x) * dst.size.y >= MIP_PARALLEL_PIXELS)
+		{
+			job_system::get().parallel_for(band_count, 1, [&](uint32 band) { process_band(job, band); });
+			return;
+		}
+
+		for (uint32 band = 0; band < band_count; band++)
+			process_band(job, band);
+	}
+
+	void mip_util::generate(texture_buffer* out_buffers, uint8 target_levels, const desc& d)
+	{
+		get_tables();
+
+		for (uint8 i = 1; i < target_levels; i++)
+		{
+			const texture_buffer& prev = out_buffers[i - 1];
+			const uint16		  w	   = math::max(static_cast<uint16>(prev.size.x / 2), static_cast<uint16>(1));
+			const uint16		  h	   = math::max(static_cast<uint16>(prev.size.y / 2), static_cast<uint16>(1));
+
+			texture_buffer mip = {};
+			mip.size		   = vector2ui16(w, h);
+			mip.bpp			   = prev.bpp;
+			mip.pixels		   = reinterpret_cast<uint8*>(SFG_MALLOC(static_cast<size_t>(w) * h * mip.bpp));
+			PUSH_ALLOCATION_SZ(w * h * mip.bpp);
+
+			downsample(prev, mip, d);
+			out_buffers[i] = mip;
+		}
+	}
+
+	float mip_util::srgb_to_linear(uint8 value)
+	{
+		return get_tables().srgb[value];
+	}
+
+	uint8 mip_util::linear_to_srgb(float value)
+	{
+		return encode_srgb(get_tables(), value);
+	}
+}
@@ -0,0 +1,50 @@
+// Copyright (c) 2025 Inan Evin
+#pragma once
+
+#include "common/size_definitions.hpp"
+
+namespace SFG
+{
+	struct texture_buffer;
+
+#define MIP_BAND_ROWS		16
+#define MIP_PARALLEL_PIXELS (128 * 128)
+#define MIP_KAISER_WIDTH	3.0f // in destination pixels.
+#define MIP_KAISER_ALPHA	4.0f
+
+	/*
+		Separable mip downsampling for box & kaiser filters. Pixels are filtered as linear floats, sRGB goes through tables both ways.
+		Every level filters the previous one in bands of rows, bands run on the job system. SIMD and scalar paths issue the same operations
+		in the same order, so the output is bit identical whichever runs.
+	*/
+	class mip_util
+	{
+	public:
+		enum class filter : uint8
+		{
+			box,
+			kaiser,
+		};
+
+		struct desc
+		{
+			filter mip_filter		   = filter::box;
+			uint8  channels			   = 4;
+			uint8  channel_size		   = 1; // bytes, 1 or 2.
+			uint8  is_linear		   = 1;
+			uint8  premultiplied_alpha = 0;
+			uint8  is_normal_map	   = 0; // xyz renormalized after filtering, stored as [0, 1].
+			uint8  use_simd			   = 1;
+			uint8  parallel			   = 1;
+		};
+
+		/// out_buffers[0] is the source, the rest of the chain is allocated.
+		static void generate(texture_buffer* out_buffers, uint8 target_levels, const desc& d);
+
+		/// One level, dst pixels are expected to be allocated.
+		static void downsample(const texture_buffer& src, texture_buffer& dst, const desc& d);
+
+		static float srgb_to_linear(uint8 value);
+		static uint8 linear_to_srgb(float value);
+	};
+}
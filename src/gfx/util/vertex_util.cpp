@@ -0,0 +1,261 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "vertex_util.hpp"
+#include "math/math.hpp"
+#include "memory/memory.hpp"
+
+namespace SFG
+{
+#define VERTEX_UNORM16_MAX 65535.0f
+#define VERTEX_SNORM16_MAX 32767.0f
+
+	namespace
+	{
+		uint16 quantize_unorm16(float value, float min, float extent)
+		{
+			if (extent <= 0.0f)
+				return 0;
+
+			const float t = math::clamp((value - min) / extent, 0.0f, 1.0f);
+			return static_cast<uint16>(t * VERTEX_UNORM16_MAX + 0.5f);
+		}
+
+		float dequantize_unorm16(uint16 value, float min, float extent)
+		{
+			return min + (static_cast<float>(value) / VERTEX_UNORM16_MAX) * extent;
+		}
+
+		void pack_common(const vector3& pos, const vector3& normal, const vector4& tangent, const vector2& uv, const vertex_quantization& quant, vector4ui16& out_pos, vector2i16& out_normal, vector2i16& out_tangent, vector2ui16& out_uv)
+		{
+			out_pos.x	= quantize_unorm16(pos.x, quant.position_min.x, quant.position_extent.x);
+			out_pos.y	= quantize_unorm16(pos.y, quant.position_min.y, quant.position_extent.y);
+			out_pos.z	= quantize_unorm16(pos.z, quant.position_min.z, quant.position_extent.z);
+			out_pos.w	= tangent.w < 0.0f ? 0 : 65535;
+			out_normal	= vertex_util::encode_octahedral(normal);
+			out_tangent = vertex_util::encode_octahedral(vector3(tangent.x, tangent.y, tangent.z));
+			out_uv.x	= vertex_util::float_to_half(uv.x);
+			out_uv.y	= vertex_util::float_to_half(uv.y);
+		}
+
+		void unpack_common(const vector4ui16& pos, const vector2i16& normal, const vector2i16& tangent, const vector2ui16& uv, const vertex_quantization& quant, vector3& out_pos, vector3& out_normal, vector4& out_tangent, vector2& out_uv)
+		{
+			out_pos.x				= dequantize_unorm16(pos.x, quant.position_min.x, quant.position_extent.x);
+			out_pos.y				= dequantize_unorm16(pos.y, quant.position_min.y, quant.position_extent.y);
+			out_pos.z				= dequantize_unorm16(pos.z, quant.position_min.z, quant.position_extent.z);
+			out_normal				= vertex_util::decode_octahedral(normal);
+			const vector3 tangent_d = vertex_util::decode_octahedral(tangent);
+			out_tangent				= vector4(tangent_d.x, tangent_d.y, tangent_d.z, pos.w < 32768 ? -1.0f : 1.0f);
+			out_uv.x				= vertex_util::half_to_float(uv.x);
+			out_uv.y				= vertex_util::half_to_float(uv.y);
+		}
+
+		float angle_between(const vector3& a, const vector3& b)
+		{
+			if (a.is_zero() || b.is_zero())
+				return 0.0f;
+
+			const float d = math::clamp(vector3::dot(a.normalized(), b.normalized()), -1.0f, 1.0f);
+			return std::acos(d) * RAD_2_DEG;
+		}
+
+		void measure_common(const vector3& pos_a, const vector3& pos_b, const vector3& normal_a, const vector3& normal_b, const vector4& tangent_a, const vector4& tangent_b, const vector2& uv_a, const vector2& uv_b, vertex_util::pack_error& err)
+		{
+			err.position = math::max(err.position, vector3::distance(pos_a, pos_b));
+			err.normal	 = math::max(err.normal, angle_between(normal_a, normal_b));
+			err.tangent	 = math::max(err.tangent, angle_between(vector3(tangent_a.x, tangent_a.y, tangent_a.z), vector3(tangent_b.x, tangent_b.y, tangent_b.z)));
+			err.uv		 = math::max(err.uv, math::max(math::abs(uv_a.x - uv_b.x), math::abs(uv_a.y - uv_b.y)));
+		}
+	}
+
+	vertex_quantization vertex_util::calculate_quantization(const vector3& bounds_min, const vector3& bounds_max)
+	{
+		if (bounds_min.x > bounds_max.x || bounds_min.y > bounds_max.y || bounds_min.z > bounds_max.z)
+			return {};
+
+		return {
+			.position_min	 = bounds_min,
+			.position_extent = bounds_max - bounds_min,
+		};
+	}
+
+	void vertex_util::pack(const vertex_static& in, const vertex_quantization& quant, vertex_static_packed& out)
+	{
+		pack_common(in.pos, in.normal, in.tangent, in.uv, quant, out.pos, out.normal, out.tangent, out.uv);
+	}
+
+	void vertex_util::unpack(const vertex_static_packed& in, const vertex_quantization& quant, vertex_static& out)
+	{
+		unpack_common(in.pos, in.normal, in.tangent, in.uv, quant, out.pos, out.normal, out.tangent, out.uv);
+	}
+
+	bool vertex_util::pack(const vertex_skinned& in, const vertex_quantization& quant, vertex_skinned_packed& out)
+	{
+		pack_common(in.pos, in.normal, in.tangent, in.uv, quant, out.pos, out.normal, out.tangent, out.uv);
+
+		const int16 joints[4]  = {in.bone_indices.x, in.bone_indices.y, in.bone_indices.z, in.bone_indices.w};
+		const float weights[4] = {in.bone_weights.x, in.bone_weights.y, in.bone_weights.z, in.bone_weights.w};
+
+		for (uint32 i = 0; i < 4; i++)
+		{
+			if (joints[i] < 0 || joints[i] > 255)
+				return false;
+			out.bone_indices[i] = static_cast<uint8>(joints[i]);
+		}
+
+		const float sum = weights[0] + weights[1] + weights[2] + weights[3];
+		if (sum <= 0.0f)
+		{
+			SFG_MEMSET(out.bone_weights, 0, sizeof(out.bone_weights));
+			return true;
+		}
+
+		// round each, then give the rounding remainder to the largest so the weights still sum up to 1.
+		int32  total   = 0;
+		uint32 largest = 0;
+		for (uint32 i = 0; i < 4; i++)
+		{
+			const float w		= math::max(weights[i], 0.0f) / sum;
+			out.bone_weights[i] = static_cast<uint8>(w * 255.0f + 0.5f);
+			total += out.bone_weights[i];
+			if (weights[i] > weights[largest])
+				largest = i;
+		}
+
+		out.bone_weights[largest] = static_cast<uint8>(static_cast<int32>(out.bone_weights[largest]) + 255 - total);
+		return true;
+	}
+
+	void vertex_util::unpack(const vertex_skinned_packed& in, const vertex_quantization& quant, vertex_skinned& out)
+	{
+		unpack_common(in.pos, in.normal, in.tangent, in.uv, quant, out.pos, out.normal, out.tangent, out.uv);
+		out.bone_weights = vector4(in.bone_weights[0] / 255.0f, in.bone_weights[1] / 255.0f, in.bone_weights[2] / 255.0f, in.bone_weights[3] / 255.0f);
+		out.bone_indices = vector4i16(in.bone_indices[0], in.bone_indices[1], in.bone_indices[2], in.bone_indices[3]);
+	}
+
+	void vertex_util::measure_error(const vertex_static& original, const vertex_static& decoded, pack_error& err)
+	{
+		measure_common(original.pos, decoded.pos, original.normal, decoded.normal, original.tangent, decoded.tangent, original.uv, decoded.uv, err);
+	}
+
+	void vertex_util::measure_error(const vertex_skinned& original, const vertex_skinned& decoded, pack_error& err)
+	{
+		measure_common(original.pos, decoded.pos, original.normal, decoded.normal, original.tangent, decoded.tangent, original.uv, decoded.uv, err);
+
+		const vector4& w   = original.bone_weights;
+		const float	   sum = w.x + w.y + w.z + w.w;
+		if (sum <= 0.0f)
+			return;
+
+		const vector4& d = decoded.bone_weights;
+		err.weight		 = math::max(err.weight, math::max(math::max(math::abs(w.x / sum - d.x), math::abs(w.y / sum - d.y)), math::max(math::abs(w.z / sum - d.z), math::abs(w.w / sum - d.w))));
+	}
+
+	vector2i16 vertex_util::encode_octahedral(const vector3& dir)
+	{
+		const float l1 = math::abs(dir.x) + math::abs(dir.y) + math::abs(dir.z);
+		if (l1 < MATH_EPS)
+			return vector2i16::zero;
+
+		float x = dir.x / l1;
+		float y = dir.y / l1;
+
+		// fold the lower hemisphere over the diagonals.
+		if (dir.z < 0.0f)
+		{
+			const float fx = (1.0f - math::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+			const float fy = (1.0f - math::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+			x			   = fx;
+			y			   = fy;
+		}
+
+		// pick the best of the 4 neighbouring grid points instead of plain rounding.
+		const vector3 target = dir / std::sqrt(vector3::dot(dir, dir));
+		const float	  bx	 = std::floor(math::clamp(x, -1.0f, 1.0f) * VERTEX_SNORM16_MAX);
+		const float	  by	 = std::floor(math::clamp(y, -1.0f, 1.0f) * VERTEX_SNORM16_MAX);
+
+		vector2i16 best		= vector2i16::zero;
+		float	   best_dot = -2.0f;
+		for (uint32 i = 0; i < 4; i++)
+		{
+			const float		 cx	 = math::clamp(bx + static_cast<float>(i & 1), -VERTEX_SNORM16_MAX, VERTEX_SNORM16_MAX);
+			const float		 cy	 = math::clamp(by + static_cast<float>(i >> 1), -VERTEX_SNORM16_MAX, VERTEX_SNORM16_MAX);
+			const vector2i16 cand(static_cast<int16>(cx), static_cast<int16>(cy));
+			const float		 d = vector3::dot(decode_octahedral(cand), target);
+			if (d > best_dot)
+			{
+				best_dot = d;
+				best	 = cand;
+			}
+		}
+
+		return best;
+	}
+
+	vector3 vertex_util::decode_octahedral(const vector2i16& oct)
+	{
+		float		x = math::max(static_cast<float>(oct.x) / VERTEX_SNORM16_MAX, -1.0f);
+		float		y = math::max(static_cast<float>(oct.y) / VERTEX_SNORM16_MAX, -1.0f);
+		const float z = 1.0f - math::abs(x) - math::abs(y);
+
+		if (z < 0.0f)
+		{
+			x += x >= 0.0f ? z : -z;
+			y += y >= 0.0f ? z : -z;
+		}
+
+		return vector3(x, y, z).normalized();
+	}
+
+	uint16 vertex_util::float_to_half(float value)
+	{
+		uint32 bits = 0;
+		SFG_MEMCPY(&bits, &value, sizeof(float));
+
+		const uint32 sign = (bits >> 16) & 0x8000;
+		uint32		 abs  = bits & 0x7FFFFFFF;
+
+		// inf & nan
+		if (abs >= 0x7F800000)
+			return static_cast<uint16>(sign | 0x7C00 | (abs > 0x7F800000 ? 0x200 : 0));
+
+		// rounds to 65520 or above, out of half range.
+		if (abs >= 0x477FF000)
+			return static_cast<uint16>(sign | 0x7C00);
+
+		// below the smallest normal half, value / 2^-24 is the denormal mantissa.
+		if (abs < 0x38800000)
+		{
+			float f = 0.0f;
+			SFG_MEMCPY(&f, &abs, sizeof(float));
+			return static_cast<uint16>(sign | static_cast<uint32>(std::lrint(f * 16777216.0f)));
+		}
+
+		// rebias the exponent, round to nearest even.
+		abs += 0xC8000FFF + ((abs >> 13) & 1);
+		return static_cast<uint16>(sign | (abs >> 13));
+	}
+
+	float vertex_util::half_to_float(uint16 value)
+	{
+		const uint32 sign	  = static_cast<uint32>(value & 0x8000) << 16;
+		const uint32 exponent = (value >> 10) & 0x1F;
+		const uint32 mantissa = value & 0x3FF;
+
+		uint32 bits = 0;
+
+		if (exponent == 0)
+		{
+			const float f = static_cast<float>(mantissa) / 16777216.0f;
+			SFG_MEMCPY(&bits, &f, sizeof(float));
+			bits |= sign;
+		}
+		else if (exponent == 31)
+			bits = sign | 0x7F800000 | (mantissa << 13);
+		else
+			bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+
+		float out = 0.0f;
+		SFG_MEMCPY(&out, &bits, sizeof(float));
+		return out;
+	}
+}
@@ -0,0 +1,45 @@
+// Copyright (c) 2025 Inan Evin
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "resources/vertex.hpp"
+
+namespace SFG
+{
+	/*
+		Packed vertex encoding:
+		positions unorm16 relative to the mesh bounds, normals & tangents octahedral snorm16,
+		uvs half floats, weights unorm8 & joint indices uint8.
+		vertex_static 48 -> 20 bytes, vertex_skinned 72 -> 28 bytes.
+	*/
+	class vertex_util
+	{
+	public:
+		/// Max error over all measured vertices, normals & tangents in degrees.
+		struct pack_error
+		{
+			float position = 0.0f;
+			float normal   = 0.0f;
+			float tangent  = 0.0f;
+			float uv	   = 0.0f;
+			float weight   = 0.0f;
+		};
+
+		static vertex_quantization calculate_quantization(const vector3& bounds_min, const vector3& bounds_max);
+
+		static void pack(const vertex_static& in, const vertex_quantization& quant, vertex_static_packed& out);
+		static void unpack(const vertex_static_packed& in, const vertex_quantization& quant, vertex_static& out);
+
+		/// Returns false if a joint index doesn't fit into 8 bits.
+		static bool pack(const vertex_skinned& in, const vertex_quantization& quant, vertex_skinned_packed& out);
+		static void unpack(const vertex_skinned_packed& in, const vertex_quantization& quant, vertex_skinned& out);
+
+		static void measure_error(const vertex_static& original, const vertex_static& decoded, pack_error& err);
+		static void measure_error(const vertex_skinned& original, const vertex_skinned& decoded, pack_error& err);
+
+		static vector2i16 encode_octahedral(const vector3& dir);
+		static vector3	  decode_octahedral(const vector2i16& oct);
+		static uint16	  float_to_half(float value);
+		static float	  half_to_float(uint16 value);
+	};
+}
@@ -0,0 +1,116 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "cluster_culler.hpp"
+#include "resources/meshlet.hpp"
+#include "resources/primitive.hpp"
+#include "math/frustum.hpp"
+#include "math/matrix4x3.hpp"
+
+namespace SFG
+{
+	bool cluster_culler::is_visible(const frustum* frustums, uint32 frustum_count, const vector3& center, float radius)
+	{
+		for (uint32 f = 0; f < frustum_count; f++)
+		{
+			const frustum& fr = frustums[f];
+			if (fr.left.get_signed_distance(center) < -radius || fr.right.get_signed_distance(center) < -radius || fr.bottom.get_signed_distance(center) < -radius ||
+				fr.top.get_signed_distance(center) < -radius || fr.near.get_signed_distance(center) < -radius || fr.far.get_signed_distance(center) < -radius)
+				continue;
+
+			return true;
+		}
+
+		return false;
+	}
+
+	bool cluster_culler::is_backfacing(const meshlet& m, const vector3& camera_local)
+	{
+		if (m.cone_cutoff >= 1.0f)
+			return false;
+
+		// every point p of the sphere needs dot(axis, p - camera) >= cutoff * |p - camera|.
+		const vector3 to_center = m.center - camera_local;
+		const float	  distance	= to_center.magnitude();
+		return vector3::dot(to_center, m.cone_axis) >= m.cone_cutoff * (distance + m.radius) + m.radius;
+	}
+
+	uint32 cluster_culler::cull(const meshlet*		meshlets,
+								uint32				meshlet_count,
+								const frustum*		frustums,
+								uint32				frustum_count,
+								const matrix4x3&	model,
+								float				max_scale,
+								const vector3*		camera_local,
+								primitive_lod*		out_ranges,
+								uint32				max_ranges,
+								cluster_cull_stats& stats)
+	{
+		if (max_ranges == 0)
+			return 0;
+
+		uint32 range_count = 0;
+
+		for (uint32 i = 0; i < meshlet_count; i++)
+		{
+			const meshlet& m = meshlets[i];
+			stats.tested++;
+
+			if (camera_local != nullptr && is_backfacing(m, *camera_local))
+			{
+				stats.backface_culled++;
+				continue;
+			}
+
+			if (!is_visible(frustums, frustum_count, model * m.center, m.radius * max_scale))
+			{
+				stats.frustum_culled++;
+				continue;
+			}
+
+			stats.visible++;
+
+			if (range_count != 0)
+			{
+				primitive_lod& last = out_ranges[range_count - 1];
+				if (last.index_start + last.index_count == m.index_start)
+				{
+					last.index_count += m.index_count;
+					continue;
+				}
+			}
+
+			// out of slots, close the smallest gap, which may be the one to this meshlet.
+			if (range_count == max_ranges)
+			{
+				auto gap_after = [&](uint32 r) { return out_ranges[r + 1].index_start - out_ranges[r].index_start - out_ranges[r].index_count; };
+
+				primitive_lod& last			= out_ranges[range_count - 1];
+				uint32		   smallest		= range_count - 1;
+				uint32		   smallest_gap = m.index_start - last.index_start - last.index_count;
+				for (uint32 r = 0; r + 1 < range_count; r++)
+				{
+					if (gap_after(r) < smallest_gap)
+					{
+						smallest	 = r;
+						smallest_gap = gap_after(r);
+					}
+				}
+
+				if (smallest == range_count - 1)
+				{
+					last.index_count = m.index_start + m.index_count - last.index_start;
+					continue;
+				}
+
+				out_ranges[smallest].index_count = out_ranges[smallest + 1].index_start + out_ranges[smallest + 1].index_count - out_ranges[smallest].index_start;
+				for (uint32 r = smallest + 1; r + 1 < range_count; r++)
+					out_ranges[r] = out_ranges[r + 1];
+				range_count--;
+			}
+
+			out_ranges[range_count++] = {.index_start = m.index_start, .index_count = m.index_count};
+		}
+
+		return range_count;
+	}
+}
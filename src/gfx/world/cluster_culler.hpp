@@ -0,0 +1,53 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+
+namespace SFG
+{
+	struct frustum;
+	struct meshlet;
+	struct primitive_lod;
+	struct vector3;
+	class matrix4x3;
+
+#define CLUSTER_MAX_RANGES 16
+
+	struct cluster_cull_stats
+	{
+		uint32 tested		   = 0;
+		uint32 visible		   = 0;
+		uint32 frustum_culled  = 0;
+		uint32 backface_culled = 0;
+
+		inline void reset()
+		{
+			tested = visible = frustum_culled = backface_culled = 0;
+		}
+	};
+
+	class cluster_culler
+	{
+	public:
+		/// Culls the meshlets of one primitive and writes the index ranges left to draw, returns the range count. Neighbouring survivors are merged,
+		/// then the smallest gaps are closed until max_ranges is met, so out_ranges needs max_ranges slots. camera_local is the camera in mesh space,
+		/// nullptr skips the backface test, e.g. when the ranges are also drawn from other views.
+		static uint32 cull(const meshlet*	   meshlets,
+						   uint32			   meshlet_count,
+						   const frustum*	   frustums,
+						   uint32			   frustum_count,
+						   const matrix4x3&	   model,
+						   float			   max_scale,
+						   const vector3*	   camera_local,
+						   primitive_lod*	   out_ranges,
+						   uint32			   max_ranges,
+						   cluster_cull_stats& stats);
+
+		/// Sphere in world space against all frustums.
+		static bool is_visible(const frustum* frustums, uint32 frustum_count, const vector3& center, float radius);
+
+		/// True if every triangle of the meshlet faces away from camera_local, conservative over the bounding sphere.
+		static bool is_backfacing(const meshlet& m, const vector3& camera_local);
+	};
+}
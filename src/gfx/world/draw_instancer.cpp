@@ -0,0 +1,89 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "draw_instancer.hpp"
+
+namespace SFG
+{
+	void draw_instancer::reset()
+	{
+		_inputs.resize(0);
+		_draws.resize(0);
+		_depths.resize(0);
+		_instances.resize(0);
+		_lookup.clear();
+	}
+
+	void draw_instancer::add(const indexed_draw& draw, uint32 instance, uint16 depth)
+	{
+		const uint64 hash  = hash_draw(draw);
+		uint32		 batch = static_cast<uint32>(_draws.size());
+
+		auto it = _lookup.find(hash);
+		if (it != _lookup.end() && same_batch(_draws[it->second], draw))
+			batch = it->second;
+		else
+		{
+			// on a hash collision the newer batch takes the slot, the older one just stops collecting.
+			_lookup[hash] = batch;
+			_draws.push_back(draw);
+			_draws.back().instance_count = 0;
+			_depths.push_back(depth);
+		}
+
+		indexed_draw& target = _draws[batch];
+		target.instance_count++;
+		if (depth < _depths[batch])
+			_depths[batch] = depth;
+
+		_inputs.push_back({.batch = batch, .instance = instance});
+	}
+
+	void draw_instancer::build()
+	{
+		const uint32 batch_count = static_cast<uint32>(_draws.size());
+		_offsets.resize(batch_count);
+
+		uint32 offset = 0;
+		for (uint32 i = 0; i < batch_count; i++)
+		{
+			indexed_draw& draw		 = _draws[i];
+			draw.constants.constant0 = offset;
+			draw.start_instance		 = 0;
+			_offsets[i]				 = offset;
+			offset += draw.instance_count;
+		}
+
+		_instances.resize(offset);
+		for (const input& in : _inputs)
+			_instances[_offsets[in.batch]++] = in.instance;
+	}
+
+	uint64 draw_instancer::hash_draw(const indexed_draw& draw)
+	{
+		// fnv-1a over the fields same_batch compares.
+		const uint32 fields[] = {
+			draw.base_vertex,
+			draw.index_count,
+			draw.start_index,
+			static_cast<uint32>(draw.pipeline) | (static_cast<uint32>(draw.bind_group) << 16),
+			static_cast<uint32>(draw.vertex_buffer) | (static_cast<uint32>(draw.idx_buffer) << 16),
+			draw.constants.constant1,
+			draw.constants.constant2,
+			draw.constants.constant3,
+		};
+
+		uint64 hash = 14695981039346656037ull;
+		for (uint32 f : fields)
+		{
+			hash ^= f;
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	bool draw_instancer::same_batch(const indexed_draw& a, const indexed_draw& b)
+	{
+		return a.base_vertex == b.base_vertex && a.index_count == b.index_count && a.start_index == b.start_index && a.pipeline == b.pipeline && a.bind_group == b.bind_group && a.vertex_buffer == b.vertex_buffer &&
+			   a.idx_buffer == b.idx_buffer && a.constants.constant1 == b.constants.constant1 && a.constants.constant2 == b.constants.constant2 && a.constants.constant3 == b.constants.constant3;
+	}
+}
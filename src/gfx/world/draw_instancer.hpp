@@ -0,0 +1,59 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "data/vector.hpp"
+#include "data/hash_map.hpp"
+#include "gfx/world/draws.hpp"
+
+namespace SFG
+{
+	/*
+		Collapses single instance draws that share pipeline, bind group, buffers, index range and constants1-3 into one instanced draw.
+		Instance slots (gpu_entity indices) of a batch are laid out contiguously, the emitted draw carries the first slot in constant0.
+		Shaders fetch their entity with instances[constant0 + instance_id].
+	*/
+	class draw_instancer
+	{
+	public:
+		void reset();
+		void add(const indexed_draw& draw, uint32 instance, uint16 depth);
+		void build();
+
+		/// One draw per batch, in the order batches were first seen.
+		inline const vector<indexed_draw>& get_draws() const
+		{
+			return _draws;
+		}
+
+		/// Nearest depth of each batch.
+		inline const vector<uint16>& get_depths() const
+		{
+			return _depths;
+		}
+
+		inline const vector<uint32>& get_instances() const
+		{
+			return _instances;
+		}
+
+	private:
+		static uint64 hash_draw(const indexed_draw& draw);
+		static bool	  same_batch(const indexed_draw& a, const indexed_draw& b);
+
+	private:
+		struct input
+		{
+			uint32 batch	= 0;
+			uint32 instance = 0;
+		};
+
+		vector<input>				_inputs;
+		vector<indexed_draw>		_draws;
+		vector<uint16>				_depths;
+		vector<uint32>				_instances;
+		vector<uint32>				_offsets;
+		hash_map<uint64, uint32>	_lookup;
+	};
+}
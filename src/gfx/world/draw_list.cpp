@@ -0,0 +1,128 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "draw_list.hpp"
+#include "gfx/backend/backend.hpp"
+#include "gfx/common/commands.hpp"
+#include "memory/memory.hpp"
+
+namespace SFG
+{
+	uint16 draw_key::quantize_depth(float view_depth)
+	{
+		if (!(view_depth > 0.0f))
+			return 0;
+
+		uint32 bits = 0;
+		SFG_MEMCPY(&bits, &view_depth, sizeof(float));
+		return static_cast<uint16>(bits >> 16);
+	}
+
+	void draw_sort::radix_sort(uint64* keys, uint32* indices, uint64* tmp_keys, uint32* tmp_indices, uint32 count)
+	{
+		if (count < 2)
+			return;
+
+		// all 8 histograms in one pass over the keys.
+		uint32 histograms[8][256] = {};
+		for (uint32 i = 0; i < count; i++)
+		{
+			const uint64 k = keys[i];
+			for (uint32 d = 0; d < 8; d++)
+				histograms[d][(k >> (d * 8)) & 0xFF]++;
+		}
+
+		uint64* src_keys	= keys;
+		uint32* src_indices = indices;
+		uint64* dst_keys	= tmp_keys;
+		uint32* dst_indices = tmp_indices;
+
+		for (uint32 d = 0; d < 8; d++)
+		{
+			uint32*		 hist  = histograms[d];
+			const uint32 shift = d * 8;
+
+			// every key has the same digit, nothing to move.
+			if (hist[(src_keys[0] >> shift) & 0xFF] == count)
+				continue;
+
+			uint32 offset = 0;
+			for (uint32 b = 0; b < 256; b++)
+			{
+				const uint32 c = hist[b];
+				hist[b]		   = offset;
+				offset += c;
+			}
+
+			for (uint32 i = 0; i < count; i++)
+			{
+				const uint64 k	 = src_keys[i];
+				const uint32 dst = hist[(k >> shift) & 0xFF]++;
+				dst_keys[dst]	 = k;
+				dst_indices[dst] = src_indices[i];
+			}
+
+			uint64* swap_keys	 = src_keys;
+			uint32* swap_indices = src_indices;
+			src_keys			 = dst_keys;
+			src_indices			 = dst_indices;
+			dst_keys			 = swap_keys;
+			dst_indices			 = swap_indices;
+		}
+
+		if (src_keys != keys)
+		{
+			SFG_MEMCPY(keys, src_keys, sizeof(uint64) * count);
+			SFG_MEMCPY(indices, src_indices, sizeof(uint32) * count);
+		}
+	}
+
+	void draw_binder::bind(const indexed_draw& draw, bool bind_buffers)
+	{
+		gfx_backend* backend = gfx_backend::get();
+
+		// full & packed vertices share the buffer, stride changes need a rebind too.
+		if (bind_buffers && (draw.vertex_buffer != _last_vtx || draw.vertex_size != _last_vtx_size))
+		{
+			_last_vtx	   = draw.vertex_buffer;
+			_last_vtx_size = draw.vertex_size;
+			backend->cmd_bind_vertex_buffers(_cmd_buffer, {.buffer = draw.vertex_buffer, .vertex_size = draw.vertex_size});
+			_stats.vertex_binds++;
+		}
+
+		if (bind_buffers && draw.idx_buffer != _last_idx)
+		{
+			_last_idx = draw.idx_buffer;
+			backend->cmd_bind_index_buffers(_cmd_buffer, {.buffer = draw.idx_buffer, .bit_depth = 2});
+			_stats.index_binds++;
+		}
+
+		if (draw.pipeline != _last_pipeline)
+		{
+			_last_pipeline = draw.pipeline;
+			backend->cmd_bind_pipeline(_cmd_buffer, {.pipeline = draw.pipeline});
+			_stats.pipeline_binds++;
+		}
+
+		if (draw.bind_group != _last_group)
+		{
+			_last_group = draw.bind_group;
+			backend->cmd_bind_group(_cmd_buffer, {.group = draw.bind_group});
+			_stats.group_binds++;
+		}
+	}
+
+	void draw_binder::draw(const indexed_draw& draw)
+	{
+		gfx_backend* backend = gfx_backend::get();
+		backend->cmd_bind_constants(_cmd_buffer, {.data = (void*)&draw.constants, .offset = 0, .count = 4});
+		backend->cmd_draw_indexed_instanced(_cmd_buffer,
+											{
+												.index_count_per_instance = draw.index_count,
+												.instance_count			  = draw.instance_count,
+												.start_index_location	  = draw.start_index,
+												.base_vertex_location	  = draw.base_vertex,
+												.start_instance_location  = draw.start_instance,
+											});
+		_stats.draws++;
+	}
+}
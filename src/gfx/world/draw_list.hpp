@@ -0,0 +1,139 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "data/static_vector.hpp"
+#include "gfx/world/draws.hpp"
+#include <limits>
+
+namespace SFG
+{
+	/*
+		64 bit draw key, most significant bits first:
+		[63..60] pass/bucket, [59..48] pipeline, [47..32] material, [31..24] vertex buffer, [23..16] index buffer, [15..0] depth.
+		State sorted passes keep depth in the lowest bits so draws with the same state end up front to back.
+		Blended passes use make_depth_first to put back to front depth right after the bucket.
+	*/
+	struct draw_key
+	{
+		static constexpr uint64 PASS_SHIFT		  = 60;
+		static constexpr uint64 PIPELINE_SHIFT	  = 48;
+		static constexpr uint64 MATERIAL_SHIFT	  = 32;
+		static constexpr uint64 VTX_SHIFT		  = 24;
+		static constexpr uint64 IDX_SHIFT		  = 16;
+		static constexpr uint64 DEPTH_FIRST_SHIFT = 44;
+
+		static inline uint64 make(uint8 pass, gfx_id pipeline, uint16 material, gfx_id vertex_buffer, gfx_id index_buffer, uint16 depth)
+		{
+			return (static_cast<uint64>(pass & 0xF) << PASS_SHIFT) | (static_cast<uint64>(pipeline & 0xFFF) << PIPELINE_SHIFT) | (static_cast<uint64>(material) << MATERIAL_SHIFT) |
+				   (static_cast<uint64>(vertex_buffer & 0xFF) << VTX_SHIFT) | (static_cast<uint64>(index_buffer & 0xFF) << IDX_SHIFT) | static_cast<uint64>(depth);
+		}
+
+		static inline uint64 make_depth_first(uint8 pass, uint16 depth, gfx_id pipeline, uint16 material)
+		{
+			const uint16 inv_depth = static_cast<uint16>(0xFFFF - depth);
+			return (static_cast<uint64>(pass & 0xF) << PASS_SHIFT) | (static_cast<uint64>(inv_depth) << DEPTH_FIRST_SHIFT) | (static_cast<uint64>(pipeline & 0xFFF) << 32) | (static_cast<uint64>(material) << 16);
+		}
+
+		/// Upper 16 bits of a non-negative float, ordering is preserved without knowing near/far.
+		static uint16 quantize_depth(float view_depth);
+	};
+
+	struct draw_stats
+	{
+		uint32 draws		  = 0;
+		uint32 pipeline_binds = 0;
+		uint32 group_binds	  = 0;
+		uint32 vertex_binds	  = 0;
+		uint32 index_binds	  = 0;
+
+		inline void reset()
+		{
+			draws = pipeline_binds = group_binds = vertex_binds = index_binds = 0;
+		}
+	};
+
+	class draw_sort
+	{
+	public:
+		/// LSD radix sort over 8 bit digits, digits every key shares are skipped. Result ends up back in keys/indices.
+		static void radix_sort(uint64* keys, uint32* indices, uint64* tmp_keys, uint32* tmp_indices, uint32 count);
+	};
+
+	/*
+		Records the last bound state and only issues binds that change it, counting them into draw_stats.
+	*/
+	class draw_binder
+	{
+	public:
+		draw_binder(gfx_id cmd_buffer, draw_stats& stats) : _cmd_buffer(cmd_buffer), _stats(stats){};
+
+		void bind(const indexed_draw& draw, bool bind_buffers);
+		void draw(const indexed_draw& draw);
+
+	private:
+		gfx_id		_cmd_buffer	   = 0;
+		draw_stats& _stats;
+		gfx_id		_last_group	   = std::numeric_limits<gfx_id>::max();
+		gfx_id		_last_pipeline = std::numeric_limits<gfx_id>::max();
+		gfx_id		_last_vtx	   = std::numeric_limits<gfx_id>::max();
+		gfx_id		_last_idx	   = std::numeric_limits<gfx_id>::max();
+		uint16		_last_vtx_size = 0;
+	};
+
+	template <uint32 MAX_DRAWS> class draw_list
+	{
+	public:
+		inline void clear()
+		{
+			_draws.clear();
+		}
+
+		inline void add(uint64 key, const indexed_draw& draw)
+		{
+			const uint32 idx = static_cast<uint32>(_draws.size());
+			_keys[idx]		 = key;
+			_indices[idx]	 = idx;
+			_draws.push_back(draw);
+		}
+
+		inline void sort()
+		{
+			draw_sort::radix_sort(_keys, _indices, _tmp_keys, _tmp_indices, static_cast<uint32>(_draws.size()));
+		}
+
+		inline uint32 size() const
+		{
+			return static_cast<uint32>(_draws.size());
+		}
+
+		inline bool empty() const
+		{
+			return _draws.empty();
+		}
+
+		inline bool full() const
+		{
+			return _draws.size() == MAX_DRAWS;
+		}
+
+		/// i-th draw in sorted order.
+		inline const indexed_draw& operator[](uint32 i) const
+		{
+			return _draws[_indices[i]];
+		}
+
+		inline uint64 get_key(uint32 i) const
+		{
+			return _keys[i];
+		}
+
+	private:
+		static_vector<indexed_draw, MAX_DRAWS> _draws;
+		uint64								   _keys[MAX_DRAWS];
+		uint32								   _indices[MAX_DRAWS];
+		uint64								   _tmp_keys[MAX_DRAWS];
+		uint32								   _tmp_indices[MAX_DRAWS];
+	};
+}
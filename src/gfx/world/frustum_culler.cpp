@@ -0,0 +1,170 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "frustum_culler.hpp"
+#include "math/frustum.hpp"
+#include "math/aabb.hpp"
+#include "math/math.hpp"
+
+#if defined(__AVX__)
+#define SFG_CULL_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SFG_CULL_SSE
+#include <emmintrin.h>
+#endif
+
+namespace SFG
+{
+	namespace
+	{
+		// Planes are stored as n.p - distance >= 0 for the inside half space.
+		inline void get_planes(const frustum& fr, const plane* (&out)[6])
+		{
+			out[0] = &fr.left;
+			out[1] = &fr.right;
+			out[2] = &fr.bottom;
+			out[3] = &fr.top;
+			out[4] = &fr.near;
+			out[5] = &fr.far;
+		}
+
+		template <uint32 WIDTH> inline void load_boxes(const aabb* boxes, float (&c)[3][WIDTH], float (&e)[3][WIDTH])
+		{
+			for (uint32 k = 0; k < WIDTH; k++)
+			{
+				const vector3& mn = boxes[k].bounds_min;
+				const vector3& mx = boxes[k].bounds_max;
+				c[0][k]			  = (mn.x + mx.x) * 0.5f;
+				c[1][k]			  = (mn.y + mx.y) * 0.5f;
+				c[2][k]			  = (mn.z + mx.z) * 0.5f;
+				e[0][k]			  = (mx.x - mn.x) * 0.5f;
+				e[1][k]			  = (mx.y - mn.y) * 0.5f;
+				e[2][k]			  = (mx.z - mn.z) * 0.5f;
+			}
+		}
+	}
+
+	bool frustum_culler::is_visible(const frustum* frustums, uint32 frustum_count, const aabb& box)
+	{
+		const vector3 center = (box.bounds_min + box.bounds_max) * 0.5f;
+		const vector3 extent = (box.bounds_max - box.bounds_min) * 0.5f;
+
+		for (uint32 f = 0; f < frustum_count; f++)
+		{
+			const plane* planes[6];
+			get_planes(frustums[f], planes);
+
+			bool outside = false;
+			for (uint32 p = 0; p < 6 && !outside; p++)
+			{
+				const vector3& n = planes[p]->normal;
+				const float	   d = vector3::dot(n, center) - planes[p]->distance;
+				const float	   r = math::abs(n.x) * extent.x + math::abs(n.y) * extent.y + math::abs(n.z) * extent.z;
+				outside			 = d + r < 0.0f;
+			}
+
+			if (!outside)
+				return true;
+		}
+
+		return false;
+	}
+
+	void frustum_culler::cull(const frustum* frustums, uint32 frustum_count, const aabb* boxes, uint32 box_count, uint8* out_visible, cull_stats& stats)
+	{
+		uint32 i = 0;
+
+#if defined(SFG_CULL_AVX)
+
+		for (; i + 8 <= box_count; i += 8)
+		{
+			float c[3][8], e[3][8];
+			load_boxes<8>(boxes + i, c, e);
+
+			const __m256 cx		 = _mm256_loadu_ps(c[0]);
+			const __m256 cy		 = _mm256_loadu_ps(c[1]);
+			const __m256 cz		 = _mm256_loadu_ps(c[2]);
+			const __m256 ex		 = _mm256_loadu_ps(e[0]);
+			const __m256 ey		 = _mm256_loadu_ps(e[1]);
+			const __m256 ez		 = _mm256_loadu_ps(e[2]);
+			const __m256 zero	 = _mm256_setzero_ps();
+			__m256		 visible = zero;
+
+			for (uint32 f = 0; f < frustum_count; f++)
+			{
+				const plane* planes[6];
+				get_planes(frustums[f], planes);
+
+				__m256 outside = zero;
+				for (uint32 p = 0; p < 6; p++)
+				{
+					const vector3& n = planes[p]->normal;
+					const __m256   d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(n.x), cx), _mm256_mul_ps(_mm256_set1_ps(n.y), cy)), _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(n.z), cz), _mm256_set1_ps(-planes[p]->distance)));
+					const __m256   r = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(math::abs(n.x)), ex), _mm256_mul_ps(_mm256_set1_ps(math::abs(n.y)), ey)), _mm256_mul_ps(_mm256_set1_ps(math::abs(n.z)), ez));
+					outside			 = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(d, r), zero, _CMP_LT_OQ));
+				}
+
+				visible = _mm256_or_ps(visible, _mm256_andnot_ps(outside, _mm256_castsi256_ps(_mm256_set1_epi32(-1))));
+				if (_mm256_movemask_ps(visible) == 0xFF)
+					break;
+			}
+
+			const int mask = _mm256_movemask_ps(visible);
+			for (uint32 k = 0; k < 8; k++)
+				out_visible[i + k] = static_cast<uint8>((mask >> k) & 1);
+		}
+
+#elif defined(SFG_CULL_SSE)
+
+		for (; i + 4 <= box_count; i += 4)
+		{
+			float c[3][4], e[3][4];
+			load_boxes<4>(boxes + i, c, e);
+
+			const __m128 cx		 = _mm_loadu_ps(c[0]);
+			const __m128 cy		 = _mm_loadu_ps(c[1]);
+			const __m128 cz		 = _mm_loadu_ps(c[2]);
+			const __m128 ex		 = _mm_loadu_ps(e[0]);
+			const __m128 ey		 = _mm_loadu_ps(e[1]);
+			const __m128 ez		 = _mm_loadu_ps(e[2]);
+			const __m128 zero	 = _mm_setzero_ps();
+			__m128		 visible = zero;
+
+			for (uint32 f = 0; f < frustum_count; f++)
+			{
+				const plane* planes[6];
+				get_planes(frustums[f], planes);
+
+				__m128 outside = zero;
+				for (uint32 p = 0; p < 6; p++)
+				{
+					const vector3& n = planes[p]->normal;
+					const __m128   d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(n.x), cx), _mm_mul_ps(_mm_set1_ps(n.y), cy)), _mm_add_ps(_mm_mul_ps(_mm_set1_ps(n.z), cz), _mm_set1_ps(-planes[p]->distance)));
+					const __m128   r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(math::abs(n.x)), ex), _mm_mul_ps(_mm_set1_ps(math::abs(n.y)), ey)), _mm_mul_ps(_mm_set1_ps(math::abs(n.z)), ez));
+					outside			 = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), zero));
+				}
+
+				visible = _mm_or_ps(visible, _mm_andnot_ps(outside, _mm_castsi128_ps(_mm_set1_epi32(-1))));
+				if (_mm_movemask_ps(visible) == 0xF)
+					break;
+			}
+
+			const int mask = _mm_movemask_ps(visible);
+			for (uint32 k = 0; k < 4; k++)
+				out_visible[i + k] = static_cast<uint8>((mask >> k) & 1);
+		}
+
+#endif
+
+		for (; i < box_count; i++)
+			out_visible[i] = is_visible(frustums, frustum_count, boxes[i]) ? 1 : 0;
+
+		uint32 visible_count = 0;
+		for (uint32 j = 0; j < box_count; j++)
+			visible_count += out_visible[j];
+
+		stats.tested += box_count;
+		stats.visible += visible_count;
+		stats.culled += box_count - visible_count;
+	}
+}
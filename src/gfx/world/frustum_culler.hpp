@@ -0,0 +1,33 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+
+namespace SFG
+{
+	struct aabb;
+	struct frustum;
+
+	struct cull_stats
+	{
+		uint32 tested  = 0;
+		uint32 visible = 0;
+		uint32 culled  = 0;
+
+		inline void reset()
+		{
+			tested = visible = culled = 0;
+		}
+	};
+
+	class frustum_culler
+	{
+	public:
+		/// out_visible[i] is 1 if boxes[i] touches any of the frustums, boxes are tested 4 or 8 at a time.
+		static void cull(const frustum* frustums, uint32 frustum_count, const aabb* boxes, uint32 box_count, uint8* out_visible, cull_stats& stats);
+
+		/// Reference path, one box against all frustums.
+		static bool is_visible(const frustum* frustums, uint32 frustum_count, const aabb& box);
+	};
+}
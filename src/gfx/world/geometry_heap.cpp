@@ -0,0 +1,112 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "geometry_heap.hpp"
+#include "gfx/buffer_queue.hpp"
+#include "gfx/backend/backend.hpp"
+#include "gfx/common/descriptions.hpp"
+#include "io/assert.hpp"
+#include "io/log.hpp"
+
+namespace SFG
+{
+	void geometry_heap::init(uint32 capacity, uint8 usage_flags, const char* debug_name)
+	{
+		_usage_flags = usage_flags;
+		_debug_name	 = debug_name;
+		_allocator.init(capacity);
+		_buffer.create_hw({
+			.size		= capacity,
+			.flags		= usage_flags | resource_flags::rf_gpu_only,
+			.debug_name = debug_name,
+		});
+	}
+
+	void geometry_heap::uninit()
+	{
+		gfx_backend* backend = gfx_backend::get();
+		for (const pending_release& r : _releases)
+		{
+			if (r.is_buffer)
+				backend->destroy_resource(r.hw);
+		}
+
+		_releases.clear();
+		_buffer.destroy();
+		_allocator.uninit();
+	}
+
+	uint32 geometry_heap::allocate(buffer_queue* bq, uint32 size, uint32 alignment, uint32 user, uint64 frame)
+	{
+		uint32 id = _allocator.allocate(size, alignment, user);
+		if (id != RANGE_INVALID_ID)
+			return id;
+
+		grow(bq, _allocator.get_capacity() + size + alignment, frame);
+		id = _allocator.allocate(size, alignment, user);
+		SFG_ASSERT(id != RANGE_INVALID_ID);
+		return id;
+	}
+
+	void geometry_heap::free(uint32 id, uint64 frame)
+	{
+		_allocator.retire(id);
+		_releases.push_back({.frame = frame, .id = id});
+	}
+
+	void geometry_heap::upload(buffer_queue* bq, uint32 id, const void* data)
+	{
+		bq->upload(_buffer.get_hw_gpu(), _allocator.get_offset(id), data, _allocator.get_size(id));
+	}
+
+	void geometry_heap::grow(buffer_queue* bq, uint32 min_capacity, uint64 frame)
+	{
+		const uint32 old_capacity = _allocator.get_capacity();
+		uint32		 new_capacity = old_capacity * 2;
+		new_capacity			  = new_capacity < min_capacity ? min_capacity : new_capacity;
+
+		// frames in flight keep drawing from the old buffer, its contents move over before anything new is written.
+		const gfx_id old_hw = _buffer.get_hw_gpu();
+		_buffer				= {};
+		_buffer.create_hw({
+			.size		= new_capacity,
+			.flags		= _usage_flags | resource_flags::rf_gpu_only,
+			.debug_name = _debug_name,
+		});
+
+		const uint32 used_end = _allocator.get_high_water();
+		if (used_end != 0)
+			bq->add_copy(old_hw, _buffer.get_hw_gpu(), 0, 0, used_end);
+		_releases.push_back({.frame = frame, .hw = old_hw, .is_buffer = 1});
+		_allocator.grow(new_capacity);
+
+		SFG_INFO("geometry heap {0} grew to {1} bytes.", _debug_name, new_capacity);
+	}
+
+	void geometry_heap::update(uint64 frame, vector<range_allocator::relocation>& out_relocations)
+	{
+		gfx_backend* backend = gfx_backend::get();
+
+		for (auto it = _releases.begin(); it != _releases.end();)
+		{
+			if (frame < it->frame + GEOMETRY_RELEASE_FRAMES)
+			{
+				++it;
+				continue;
+			}
+
+			if (it->is_buffer)
+				backend->destroy_resource(it->hw);
+			else
+				_allocator.free(it->id);
+			it = _releases.erase(it);
+		}
+
+		const size_t first = out_relocations.size();
+		_allocator.defragment(GEOMETRY_DEFRAG_BYTES, out_relocations);
+
+		// ranges left behind are read by frames in flight for a while.
+		const size_t count = out_relocations.size();
+		for (size_t i = first; i < count; i++)
+			_releases.push_back({.frame = frame, .id = out_relocations[i].retired_id});
+	}
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "data/vector.hpp"
+#include "gfx/buffer.hpp"
+#include "memory/range_allocator.hpp"
+
+namespace SFG
+{
+	class buffer_queue;
+
+#define GEOMETRY_HEAP_INITIAL_SIZE (2 * 1024 * 1024)
+#define GEOMETRY_DEFRAG_BYTES	   (256 * 1024) // per heap & frame.
+#define GEOMETRY_RELEASE_FRAMES (FRAMES_IN_FLIGHT + THREAD_BUFFER_COUNT + 1) // extracted frames still draw from old ranges.
+
+	/*
+		Gpu only buffer sub-allocated with a range_allocator. Data goes in through the upload ring, freed & relocated ranges are held back until no
+		frame in flight can read them. Running out of space grows the buffer, the old contents are copied over on the gpu. Relocations from the
+		incremental defragmentation are handed back to the caller, which re-uploads the data & patches its offsets.
+	*/
+	class geometry_heap
+	{
+	public:
+		void init(uint32 capacity, uint8 usage_flags, const char* debug_name);
+		void uninit();
+
+		/// Returns a range id, offsets are a multiple of alignment. Grows the buffer if needed.
+		uint32 allocate(buffer_queue* bq, uint32 size, uint32 alignment, uint32 user, uint64 frame);
+		void   free(uint32 id, uint64 frame);
+		void   upload(buffer_queue* bq, uint32 id, const void* data);
+
+		/// Releases ranges old enough & runs a defragmentation step.
+		void update(uint64 frame, vector<range_allocator::relocation>& out_relocations);
+
+		inline uint32 get_offset(uint32 id) const
+		{
+			return _allocator.get_offset(id);
+		}
+
+		inline buffer& get_buffer()
+		{
+			return _buffer;
+		}
+
+		inline const range_allocator& get_allocator() const
+		{
+			return _allocator;
+		}
+
+	private:
+		struct pending_release
+		{
+			uint64 frame	 = 0;
+			uint32 id		 = 0;
+			gfx_id hw		 = 0;
+			uint8  is_buffer = 0;
+		};
+
+		void grow(buffer_queue* bq, uint32 min_capacity, uint64 frame);
+
+	private:
+		range_allocator			_allocator;
+		vector<pending_release> _releases;
+		buffer					_buffer		 = {};
+		const char*				_debug_name	 = "";
+		uint8					_usage_flags = 0;
+	};
+}
@@ -2,6 +2,7 @@
 
 #pragma once
 #include "math/matrix4x3.hpp"
+#include "math/vector4.hpp"
 
 namespace SFG
 {
@@ -9,6 +10,8 @@ namespace SFG
 
 	struct gpu_entity
 	{
-		matrix4x3 model = matrix4x3::identity;
+		matrix4x3 model			  = matrix4x3::identity;
+		vector4	  position_min	  = vector4::zero; // packed vertex position = min + unorm * extent, identity for full precision meshes.
+		vector4	  position_extent = vector4::one;
 	};
 }
@@ -0,0 +1,37 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "lod_selector.hpp"
+#include "math/matrix4x4.hpp"
+#include "math/math.hpp"
+
+namespace SFG
+{
+	float lod_selector::calculate_projection_factor(const matrix4x4& proj, float screen_height)
+	{
+		// proj[1][1] is 1 / tan(fov / 2) for perspective projections.
+		return screen_height * 0.5f * proj[5];
+	}
+
+	uint8 lod_selector::select(const float* errors, uint8 count, uint8 current, float distance, float projection_factor, float threshold, float hysteresis)
+	{
+		if (count <= 1)
+			return 0;
+
+		// inside the bounds, always full detail.
+		if (distance <= MATH_EPS)
+			return 0;
+
+		const float pixels_per_unit = projection_factor / distance;
+
+		uint8 selected = 0;
+		for (uint8 i = 1; i < count; i++)
+		{
+			const float limit = i > current ? threshold * (1.0f - hysteresis) : threshold;
+			if (errors[i] * pixels_per_unit > limit)
+				break;
+			selected = i;
+		}
+
+		return selected;
+	}
+}
@@ -0,0 +1,24 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+
+namespace SFG
+{
+	class matrix4x4;
+
+#define LOD_PIXEL_ERROR 1.0f
+#define LOD_HYSTERESIS	0.25f
+
+	class lod_selector
+	{
+	public:
+		/// Pixels a unit sized error covers at unit distance.
+		static float calculate_projection_factor(const matrix4x4& proj, float screen_height);
+
+		/// Coarsest level whose projected error stays within threshold pixels. Going coarser than current needs the error to drop
+		/// hysteresis below the threshold, so entities sitting on a boundary don't flicker between levels. errors ascend.
+		static uint8 select(const float* errors, uint8 count, uint8 current, float distance, float projection_factor, float threshold = LOD_PIXEL_ERROR, float hysteresis = LOD_HYSTERESIS);
+	};
+}
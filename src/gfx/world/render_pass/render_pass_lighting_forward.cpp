@@ -5,6 +5,11 @@
 #include "gfx/common/descriptions.hpp"
 #include "gfx/common/commands.hpp"
 #include "gfx/util/gfx_util.hpp"
+#include "gfx/world/world_render_data.hpp"
+#include "world/world.hpp"
+#include "resources/material.hpp"
+#include "resources/shader.hpp"
+#include "math/math.hpp"
 
 namespace SFG
 {
@@ -96,8 +101,49 @@ namespace SFG
 		}
 	}
 
-	void render_pass_lighting_forward::populate_render_data(world* w, uint8 data_index)
+	void render_pass_lighting_forward::populate_render_data(world* w, const view& v, const world_render_data& wd, uint8 data_index)
 	{
+		render_data& rd = _render_data[data_index];
+		rd.draws.clear();
+
+		world_resources& resources = w->get_resources();
+
+		for (const renderable_object& obj : wd.renderables)
+		{
+			const material&		  mat	= resources.get_resource<material>(obj.material);
+			const bitmask<uint8>& flags = mat.get_flags();
+
+			if (!flags.is_set(material::flags::is_forward))
+				continue;
+
+			if (rd.draws.full())
+				break;
+
+			// forward draws blend, so they go back to front before state.
+			const gfx_id  pipeline = mat.get_shader(resources, (obj.is_skinned ? shader::flags::is_skinned : 0) | (obj.is_packed ? shader::flags::is_packed : 0));
+			const vector3 pos	   = v.view_matrix * wd.entities[obj.gpu_entity].model.get_translation();
+			const uint16  depth	   = draw_key::quantize_depth(math::abs(pos.z));
+			const uint64  key	   = draw_key::make_depth_first(0, depth, pipeline, obj.material.index);
+
+			rd.draws.add(key,
+						 {
+							 .constants =
+								 {
+									 .constant0 = obj.gpu_entity,
+								 },
+							 .base_vertex	 = obj.vertex_start,
+							 .index_count	 = obj.index_count,
+							 .instance_count = 1,
+							 .start_index	 = obj.index_start,
+							 .start_instance = 0,
+							 .pipeline		 = pipeline,
+							 .vertex_buffer	 = obj.vertex_buffer->get_hw_gpu(),
+							 .idx_buffer	 = obj.index_buffer->get_hw_gpu(),
+							 .vertex_size	 = obj.vertex_size,
+						 });
+		}
+
+		rd.draws.sort();
 	}
 
 	void render_pass_lighting_forward::render(uint8 data_index, uint8 frame_index, const vector2ui16& size, gfx_id global_layout, gfx_id global_group)
@@ -117,8 +163,8 @@ namespace SFG
 		{
 			render_pass_color_attachment& att = attachments[i];
 			att.clear_color					  = vector4(1, 0, 0, 1.0f);
-			att.load_op						  = load_op::clear;
-			att.store_op					  = store_op::store;
+			att.color_load_op				  = load_op::clear;
+			att.color_store_op				  = store_op::store;
 			att.texture						  = textures[i];
 		}
 
@@ -143,36 +189,15 @@ namespace SFG
 		backend->cmd_set_scissors(cmd_buffer, {.width = static_cast<uint16>(size.x), .height = static_cast<uint16>(size.y)});
 		backend->cmd_set_viewport(cmd_buffer, {.width = static_cast<uint16>(size.x), .height = static_cast<uint16>(size.y)});
 
-		gfx_id last_bound_group	   = std::numeric_limits<gfx_id>::max();
-		gfx_id last_bound_pipeline = std::numeric_limits<gfx_id>::max();
-
-		auto bind = [&](gfx_id group, gfx_id pipeline) {
-			if (pipeline != last_bound_pipeline)
-			{
-				last_bound_pipeline = pipeline;
-				backend->cmd_bind_pipeline(cmd_buffer, {.pipeline = pipeline});
-			}
-
-			if (group != last_bound_group)
-			{
-				last_bound_group = group;
-				backend->cmd_bind_group(cmd_buffer, {.group = group});
-			}
-		};
+		_draw_stats.reset();
+		draw_binder binder(cmd_buffer, _draw_stats);
 
-		for (const indexed_draw& draw : rd.draws)
+		const uint32 draw_count = rd.draws.size();
+		for (uint32 i = 0; i < draw_count; i++)
 		{
-			bind(draw.bind_group, draw.pipeline);
-
-			backend->cmd_bind_constants(cmd_buffer, {.data = (void*)&draw.constants, .offset = 0, .count = 4});
-			backend->cmd_draw_indexed_instanced(cmd_buffer,
-												{
-													.index_count_per_instance = draw.index_count,
-													.instance_count			  = draw.instance_count,
-													.start_index_location	  = draw.start_index,
-													.base_vertex_location	  = draw.base_vertex,
-													.start_instance_location  = draw.start_instance,
-												});
+			const indexed_draw& draw = rd.draws[i];
+			binder.bind(draw, true);
+			binder.draw(draw);
 		}
 
 		backend->cmd_end_render_pass(cmd_buffer, {});
@@ -5,12 +5,14 @@
 #include "gfx/render_pass.hpp"
 #include "gfx/common/barrier_description.hpp"
 #include "gfx/buffer.hpp"
-#include "gfx/world/draws.hpp"
+#include "gfx/world/draw_list.hpp"
 #include "memory/bump_allocator.hpp"
 
 namespace SFG
 {
 	class world;
+	struct world_render_data;
+	struct view;
 
 	class render_pass_lighting_forward
 	{
@@ -42,7 +44,7 @@ namespace SFG
 
 		struct render_data
 		{
-			static_vector<indexed_draw, MAX_DRAWS> draws;
+			draw_list<MAX_DRAWS> draws;
 		};
 
 	public:
@@ -61,7 +63,7 @@ namespace SFG
 		void init(const init_data& data);
 		void uninit();
 		void reset_target_textures(gfx_id* opaque_textures, gfx_id* depth_textures);
-		void populate_render_data(world* w, uint8 data_index);
+		void populate_render_data(world* w, const view& v, const world_render_data& wd, uint8 data_index);
 		void render(uint8 data_index, uint8 frame_index, const vector2ui16& size, gfx_id global_layout, gfx_id global_group);
 		void resize(const vector2ui16& size);
 
@@ -75,6 +77,11 @@ namespace SFG
 			return _pfd[frame_index].cmd_buffer;
 		}
 
+		inline const draw_stats& get_draw_stats() const
+		{
+			return _draw_stats;
+		}
+
 	private:
 		void destroy_textures();
 		void create_textures(const vector2ui16& sz);
@@ -83,6 +90,7 @@ namespace SFG
 		render_pass	   _pass = {};
 		per_frame_data _pfd[FRAMES_IN_FLIGHT];
 		render_data	   _render_data[THREAD_BUFFER_COUNT];
-		bump_allocator _alloc = {};
+		bump_allocator _alloc	   = {};
+		draw_stats	   _draw_stats = {};
 	};
 }
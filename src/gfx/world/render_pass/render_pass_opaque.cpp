@@ -10,8 +10,8 @@
 #include "world/world.hpp"
 #include "resources/material.hpp"
 #include "resources/shader.hpp"
-#include "resources/vertex.hpp"
 #include "math/vector2ui16.hpp"
+#include "math/math.hpp"
 
 namespace SFG
 {
@@ -31,6 +31,11 @@ namespace SFG
 			pfd.semaphore.semaphore = backend->create_semaphore();
 
 			pfd.ubo.create_hw({.size = sizeof(ubo), .flags = resource_flags::rf_constant_buffer | resource_flags::rf_cpu_visible, .debug_name = "opaque_ubo"});
+			pfd.instances.create_hw({
+				.size		= sizeof(uint32) * MAX_INSTANCES,
+				.flags		= resource_flags::rf_gpu_only | resource_flags::rf_storage_buffer,
+				.debug_name = "opaque_instances_gpu",
+			});
 
 			pfd.bind_group = backend->create_empty_bind_group();
 			backend->bind_group_add_pointer(pfd.bind_group, rpi_table_render_pass, 5, false);
@@ -40,6 +45,7 @@ namespace SFG
 												   {.resource = pfd.ubo.get_hw_gpu(), .view = 0, .pointer_index = upi_render_pass_ubo0, .type = binding_type::ubo},
 												   {.resource = params.entity_buffers[i], .view = 0, .pointer_index = upi_render_pass_ssbo0, .type = binding_type::ssbo},
 												   {.resource = params.bone_buffers[i], .view = 0, .pointer_index = upi_render_pass_ssbo1, .type = binding_type::ssbo},
+												   {.resource = pfd.instances.get_hw_gpu(), .view = 0, .pointer_index = upi_render_pass_ssbo2, .type = binding_type::ssbo},
 											   });
 		}
 	}
@@ -58,6 +64,7 @@ namespace SFG
 			backend->destroy_bind_group(pfd.bind_group);
 			backend->destroy_semaphore(pfd.semaphore.semaphore);
 			pfd.ubo.destroy();
+			pfd.instances.destroy();
 		}
 
 		destroy_textures();
@@ -70,9 +77,11 @@ namespace SFG
 		rd.view			= v.view_matrix;
 		rd.view_proj	= v.view_proj_matrix;
 		rd.draws.clear();
+		rd.instancer.reset();
 
 		world_resources& resources = w->get_resources();
 
+		uint32 instance_count = 0;
 		for (const renderable_object& obj : wd.renderables)
 		{
 			const material&		  mat	= resources.get_resource<material>(obj.material);
@@ -81,21 +90,48 @@ namespace SFG
 			if (!flags.is_set(material::flags::is_opaque))
 				continue;
 
-			rd.draws.push_back({
-				.constants =
-					{
-						.constant0 = obj.gpu_entity,
-					},
-				.base_vertex	= obj.vertex_start,
-				.index_count	= obj.index_count,
-				.instance_count = 1,
-				.start_index	= obj.index_start,
-				.start_instance = 0,
-				.pipeline		= mat.get_shader(resources, obj.is_skinned ? shader::flags::is_skinned : 0),
-				.vertex_buffer	= obj.vertex_buffer->get_hw_gpu(),
-				.idx_buffer		= obj.index_buffer->get_hw_gpu(),
-			});
+			if (instance_count == MAX_INSTANCES)
+				break;
+
+			const vector3 pos	= v.view_matrix * wd.entities[obj.gpu_entity].model.get_translation();
+			const uint16  depth = draw_key::quantize_depth(math::abs(pos.z));
+
+			rd.instancer.add(
+				{
+					.constants =
+						{
+							.constant1 = obj.material.index,
+						},
+					.base_vertex	= obj.vertex_start,
+					.index_count	= obj.index_count,
+					.instance_count = 1,
+					.start_index	= obj.index_start,
+					.start_instance = 0,
+					.pipeline		= mat.get_shader(resources, (obj.is_skinned ? shader::flags::is_skinned : 0) | (obj.is_packed ? shader::flags::is_packed : 0)),
+					.vertex_buffer	= obj.vertex_buffer->get_hw_gpu(),
+					.idx_buffer		= obj.index_buffer->get_hw_gpu(),
+					.vertex_size	= obj.vertex_size,
+				},
+				obj.gpu_entity,
+				depth);
+
+			instance_count++;
 		}
+
+		rd.instancer.build();
+
+		const vector<indexed_draw>& batches = rd.instancer.get_draws();
+		const vector<uint16>&		depths	= rd.instancer.get_depths();
+		const uint32				count	= static_cast<uint32>(batches.size());
+
+		for (uint32 i = 0; i < count && !rd.draws.full(); i++)
+		{
+			const indexed_draw& draw = batches[i];
+			const uint64		key	 = draw_key::make(0, draw.pipeline, static_cast<uint16>(draw.constants.constant1), draw.vertex_buffer, draw.idx_buffer, depths[i]);
+			rd.draws.add(key, draw);
+		}
+
+		rd.draws.sort();
 	}
 
 	void render_pass_opaque::upload(world* w, buffer_queue* queue, uint8 data_index, uint8 frame_index)
@@ -110,7 +146,10 @@ namespace SFG
 		};
 
 		pfd.ubo.buffer_data(0, &ubo_data, sizeof(ubo));
-		queue->add_request({.buffer = &pfd.ubo});
+		queue->add_request({.target = &pfd.ubo});
+
+		const vector<uint32>& instances = rd.instancer.get_instances();
+		queue->upload(pfd.instances.get_hw_gpu(), 0, instances.data(), static_cast<uint32>(sizeof(uint32) * instances.size()));
 	}
 
 	void render_pass_opaque::render(uint8 data_index, uint8 frame_index, const vector2ui16& size, gfx_id global_layout, gfx_id global_group)
@@ -135,8 +174,8 @@ namespace SFG
 
 			render_pass_color_attachment& att = attachments[i];
 			att.clear_color					  = vector4(0, 0, 0, 1.0f);
-			att.load_op						  = load_op::clear;
-			att.store_op					  = store_op::store;
+			att.color_load_op				  = load_op::clear;
+			att.color_store_op				  = store_op::store;
 			att.texture						  = txt;
 
 			barriers.push_back({
@@ -197,49 +236,15 @@ namespace SFG
 		backend->cmd_set_scissors(cmd_buffer, {.width = static_cast<uint16>(size.x), .height = static_cast<uint16>(size.y)});
 		backend->cmd_set_viewport(cmd_buffer, {.width = static_cast<uint16>(size.x), .height = static_cast<uint16>(size.y)});
 
-		gfx_id last_bound_group	   = std::numeric_limits<gfx_id>::max();
-		gfx_id last_bound_pipeline = std::numeric_limits<gfx_id>::max();
-		gfx_id last_vtx			   = std::numeric_limits<gfx_id>::max();
-		gfx_id last_idx			   = std::numeric_limits<gfx_id>::max();
-
-		auto bind = [&](gfx_id group, gfx_id pipeline, gfx_id vtx, gfx_id idx) {
-			if (vtx != last_vtx)
-			{
-				last_vtx = vtx;
-				backend->cmd_bind_vertex_buffers(cmd_buffer, {.buffer = vtx, .vertex_size = sizeof(vertex_static)});
-			}
-
-			if (idx != last_idx)
-			{
-				last_idx = idx;
-				backend->cmd_bind_index_buffers(cmd_buffer, {.buffer = idx, .bit_depth = 2});
-			}
-			if (pipeline != last_bound_pipeline)
-			{
-				last_bound_pipeline = pipeline;
-				backend->cmd_bind_pipeline(cmd_buffer, {.pipeline = pipeline});
-			}
-
-			if (group != last_bound_group)
-			{
-				last_bound_group = group;
-				backend->cmd_bind_group(cmd_buffer, {.group = group});
-			}
-		};
+		_draw_stats.reset();
+		draw_binder binder(cmd_buffer, _draw_stats);
 
-		for (const indexed_draw& draw : rd.draws)
+		const uint32 draw_count = rd.draws.size();
+		for (uint32 i = 0; i < draw_count; i++)
 		{
-			bind(draw.bind_group, draw.pipeline, draw.vertex_buffer, draw.idx_buffer);
-
-			backend->cmd_bind_constants(cmd_buffer, {.data = (void*)&draw.constants, .offset = 0, .count = 4});
-			backend->cmd_draw_indexed_instanced(cmd_buffer,
-												{
-													.index_count_per_instance = draw.index_count,
-													.instance_count			  = draw.instance_count,
-													.start_index_location	  = draw.start_index,
-													.base_vertex_location	  = draw.base_vertex,
-													.start_instance_location  = draw.start_instance,
-												});
+			const indexed_draw& draw = rd.draws[i];
+			binder.bind(draw, true);
+			binder.draw(draw);
 		}
 
 		backend->cmd_end_render_pass(cmd_buffer, {});
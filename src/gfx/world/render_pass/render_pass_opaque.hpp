@@ -5,7 +5,8 @@
 #include "gfx/render_pass.hpp"
 #include "gfx/common/barrier_description.hpp"
 #include "gfx/buffer.hpp"
-#include "gfx/world/draws.hpp"
+#include "gfx/world/draw_list.hpp"
+#include "gfx/world/draw_instancer.hpp"
 #include "memory/bump_allocator.hpp"
 #include "math/matrix4x4.hpp"
 
@@ -22,6 +23,7 @@ namespace SFG
 	{
 	private:
 		static constexpr uint32 MAX_DRAWS	   = 512;
+		static constexpr uint32 MAX_INSTANCES  = 1024;
 		static constexpr uint32 MAX_BARRIERS   = 16;
 		static constexpr uint32 COLOR_TEXTURES = 4;
 
@@ -37,6 +39,7 @@ namespace SFG
 			gfx_id								  cmd_buffer;
 			gfx_id								  bind_group;
 			buffer								  ubo;
+			buffer								  instances;
 			semaphore_data						  semaphore;
 			static_vector<gfx_id, COLOR_TEXTURES> color_textures;
 			gfx_id								  depth_texture = 0;
@@ -45,10 +48,11 @@ namespace SFG
 
 		struct render_data
 		{
-			static_vector<indexed_draw, MAX_DRAWS> draws;
-			matrix4x4							   view		 = matrix4x4::identity;
-			matrix4x4							   proj		 = matrix4x4::identity;
-			matrix4x4							   view_proj = matrix4x4::identity;
+			draw_list<MAX_DRAWS> draws;
+			draw_instancer		 instancer;
+			matrix4x4			 view	   = matrix4x4::identity;
+			matrix4x4			 proj	   = matrix4x4::identity;
+			matrix4x4			 view_proj = matrix4x4::identity;
 		};
 
 	public:
@@ -89,6 +93,11 @@ namespace SFG
 			return _pfd[frame_index].cmd_buffer;
 		}
 
+		inline const draw_stats& get_draw_stats() const
+		{
+			return _draw_stats;
+		}
+
 	private:
 		void destroy_textures();
 		void create_textures(const vector2ui16& sz);
@@ -97,6 +106,7 @@ namespace SFG
 		render_pass	   _pass = {};
 		per_frame_data _pfd[FRAMES_IN_FLIGHT];
 		render_data	   _render_data[THREAD_BUFFER_COUNT];
-		bump_allocator _alloc = {};
+		bump_allocator _alloc	   = {};
+		draw_stats	   _draw_stats = {};
 	};
 }
@@ -75,8 +75,8 @@ namespace SFG
 		{
 			render_pass_color_attachment& att = attachments[i];
 			att.clear_color					  = vector4(1, 0, 0, 1.0f);
-			att.load_op						  = load_op::clear;
-			att.store_op					  = store_op::store;
+			att.color_load_op				  = load_op::clear;
+			att.color_store_op				  = store_op::store;
 			att.texture						  = textures[i];
 		}
 
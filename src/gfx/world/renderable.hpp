@@ -18,6 +18,8 @@ namespace SFG
 		uint32			index_count	  = 0;
 		resource_handle material	  = {};
 		uint16			gpu_entity	  = 0;
+		uint16			vertex_size	  = 0;
 		uint8			is_skinned	  = 0;
+		uint8			is_packed	  = 0;
 	};
 }
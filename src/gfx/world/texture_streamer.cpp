@@ -0,0 +1,225 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "texture_streamer.hpp"
+#include "gfx/common/texture_buffer.hpp"
+#include "io/assert.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace SFG
+{
+	void texture_streamer::init(const budget& b)
+	{
+		_budget = b;
+		_stats	= {};
+		_entries.reserve(MAX_TEXTURE_MIPS * 4);
+	}
+
+	void texture_streamer::uninit()
+	{
+		_entries.clear();
+		_free_ids.clear();
+		_candidates.clear();
+		_lru.clear();
+		_stats = {};
+	}
+
+	uint16 texture_streamer::add_texture(const uint32* mip_bytes, uint8 mip_count, uint8 tail_mip, uint8 resident_mip)
+	{
+		SFG_ASSERT(mip_count != 0 && mip_count <= MAX_TEXTURE_MIPS);
+		SFG_ASSERT(tail_mip < mip_count && resident_mip <= tail_mip);
+
+		uint16 id = 0;
+		if (!_free_ids.empty())
+		{
+			id = _free_ids.back();
+			_free_ids.pop_back();
+		}
+		else
+		{
+			id = static_cast<uint16>(_entries.size());
+			_entries.push_back({});
+		}
+
+		stream_entry& e = _entries[id];
+		e				= {};
+		e.mip_count		= mip_count;
+		e.tail_mip		= tail_mip;
+		e.resident_mip	= resident_mip;
+		e.alive			= 1;
+		for (uint8 i = 0; i < mip_count; i++)
+			e.mip_bytes[i] = mip_bytes[i];
+
+		_stats.resident_bytes += bytes_from(e, resident_mip);
+		return id;
+	}
+
+	void texture_streamer::remove_texture(uint16 id)
+	{
+		stream_entry& e = _entries[id];
+		SFG_ASSERT(e.alive);
+		_stats.resident_bytes -= bytes_from(e, e.resident_mip);
+		e.alive = 0;
+		_free_ids.push_back(id);
+	}
+
+	void texture_streamer::request(uint16 id, uint8 mip, uint64 frame)
+	{
+		stream_entry& e = _entries[id];
+		SFG_ASSERT(e.alive);
+
+		mip			 = mip < e.mip_count ? mip : static_cast<uint8>(e.mip_count - 1);
+		e.wanted_mip = e.requested && e.wanted_mip < mip ? e.wanted_mip : mip;
+		e.requested	 = 1;
+		e.last_used	 = frame;
+	}
+
+	uint8 texture_streamer::get_resident_mip(uint16 id) const
+	{
+		return _entries[id].resident_mip;
+	}
+
+	uint64 texture_streamer::get_resident_bytes(uint16 id) const
+	{
+		const stream_entry& e = _entries[id];
+		return bytes_from(e, e.resident_mip);
+	}
+
+	uint64 texture_streamer::bytes_from(const stream_entry& e, uint8 first_mip) const
+	{
+		uint64 total = 0;
+		for (uint8 i = first_mip; i < e.mip_count; i++)
+			total += e.mip_bytes[i];
+		return total;
+	}
+
+	bool texture_streamer::make_room(uint64 frame, uint64 needed, vector<residency_change>& out_changes)
+	{
+		if (_stats.resident_bytes + needed <= _budget.resident_bytes)
+			return true;
+
+		if (!_lru_built)
+		{
+			// anything above its tail that wasn't asked for this frame, oldest first.
+			_lru.resize(0);
+			for (uint16 id = 0; id < static_cast<uint16>(_entries.size()); id++)
+			{
+				const stream_entry& e = _entries[id];
+				if (e.alive && e.resident_mip < e.tail_mip && e.last_used < frame)
+					_lru.push_back(id);
+			}
+
+			std::sort(_lru.begin(), _lru.end(), [this](uint16 a, uint16 b) { return _entries[a].last_used != _entries[b].last_used ? _entries[a].last_used < _entries[b].last_used : a < b; });
+			_lru_built = 1;
+			_lru_next  = 0;
+		}
+
+		while (_stats.resident_bytes + needed > _budget.resident_bytes && _lru_next < static_cast<uint32>(_lru.size()))
+		{
+			const uint16  id   = _lru[_lru_next++];
+			stream_entry& e	   = _entries[id];
+			const uint64  tail = bytes_from(e, e.tail_mip);
+
+			_stats.resident_bytes -= bytes_from(e, e.resident_mip) - tail;
+			_stats.uploaded_bytes += tail;
+			_stats.uploads++;
+			_stats.evictions++;
+			e.resident_mip = e.tail_mip;
+			out_changes.push_back({.id = id, .first_mip = e.tail_mip, .evicted = 1});
+		}
+
+		return _stats.resident_bytes + needed <= _budget.resident_bytes;
+	}
+
+	void texture_streamer::update(uint64 frame, vector<residency_change>& out_changes)
+	{
+		_stats.reset();
+		_candidates.resize(0);
+		_lru_built = 0;
+
+		const uint16 count = static_cast<uint16>(_entries.size());
+		for (uint16 id = 0; id < count; id++)
+		{
+			const stream_entry& e = _entries[id];
+			if (e.alive && e.requested && e.wanted_mip < e.resident_mip)
+				_candidates.push_back(id);
+		}
+
+		// furthest behind first.
+		std::sort(_candidates.begin(), _candidates.end(), [this](uint16 a, uint16 b) {
+			const uint32 gap_a = _entries[a].resident_mip - _entries[a].wanted_mip;
+			const uint32 gap_b = _entries[b].resident_mip - _entries[b].wanted_mip;
+			return gap_a != gap_b ? gap_a > gap_b : a < b;
+		});
+
+		for (uint16 id : _candidates)
+		{
+			stream_entry& e			 = _entries[id];
+			const uint64  current	 = bytes_from(e, e.resident_mip);
+			const uint64  upload_left = _budget.upload_bytes > _stats.uploaded_bytes ? _budget.upload_bytes - _stats.uploaded_bytes : 0;
+
+			// coarser until the rebuild fits the frame. One step over budget is let through on an otherwise idle frame, so big mips can't starve.
+			uint8 target = e.wanted_mip;
+			while (target + 1 < e.resident_mip && bytes_from(e, target) > upload_left)
+				target++;
+
+			if (bytes_from(e, target) > upload_left && _stats.uploaded_bytes != 0)
+			{
+				_stats.starved++;
+				continue;
+			}
+
+			while (target < e.resident_mip && !make_room(frame, bytes_from(e, target) - current, out_changes))
+				target++;
+
+			if (target >= e.resident_mip)
+			{
+				_stats.starved++;
+				continue;
+			}
+
+			const uint64 cost = bytes_from(e, target);
+			_stats.resident_bytes += cost - current;
+			_stats.uploaded_bytes += cost;
+			_stats.uploads++;
+
+			if (target > e.wanted_mip)
+				_stats.starved++;
+
+			e.resident_mip = target;
+			out_changes.push_back({.id = id, .first_mip = target});
+		}
+
+		for (stream_entry& e : _entries)
+			e.requested = 0;
+	}
+
+	uint8 texture_streamer::calculate_tail_mip(const texture_buffer* buffers, uint8 count, uint16 tail_size)
+	{
+		for (uint8 i = 0; i < count; i++)
+		{
+			const texture_buffer& b = buffers[i];
+			if ((b.size.x > b.size.y ? b.size.x : b.size.y) <= tail_size)
+				return i;
+		}
+
+		return count == 0 ? 0 : static_cast<uint8>(count - 1);
+	}
+
+	uint8 texture_streamer::calculate_demand_mip(uint16 width, uint16 height, uint8 mip_count, float screen_size)
+	{
+		if (mip_count == 0)
+			return 0;
+
+		const uint8 last = static_cast<uint8>(mip_count - 1);
+		if (screen_size <= 0.0f)
+			return last;
+
+		const float ratio = static_cast<float>(width > height ? width : height) / screen_size;
+		if (ratio <= 1.0f)
+			return 0;
+
+		const float mip = std::floor(std::log2(ratio));
+		return mip >= static_cast<float>(last) ? last : static_cast<uint8>(mip);
+	}
+}
@@ -0,0 +1,115 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "data/vector.hpp"
+#include "gfx/common/gfx_constants.hpp"
+
+namespace SFG
+{
+	struct texture_buffer;
+
+#define STREAM_TAIL_SIZE	   64				   // mips this size or smaller load first & stay resident.
+#define STREAM_UPLOAD_BUDGET   (8 * 1024 * 1024)   // bytes per frame.
+#define STREAM_RESIDENT_BUDGET (256 * 1024 * 1024) // bytes over every streamed texture.
+#define STREAM_INVALID_ID	   UINT16_MAX
+
+	struct stream_stats
+	{
+		uint64 resident_bytes = 0;
+		uint64 uploaded_bytes = 0; // this update.
+		uint32 uploads		  = 0;
+		uint32 evictions	  = 0;
+		uint32 starved		  = 0; // requests left for later frames.
+
+		inline void reset()
+		{
+			uploaded_bytes = 0;
+			uploads		   = 0;
+			evictions	   = 0;
+			starved		   = 0;
+		}
+	};
+
+	/*
+		Residency policy for mip streaming, knows nothing about the device. Every texture starts with its mip tail resident, extraction requests the
+		most detailed mip it needs each frame and update() turns that into residency changes. A change means the texture is rebuilt from first_mip down,
+		so it costs the bytes of every mip it keeps. Uploads stay within the per frame budget, resident bytes within theirs by dropping the least
+		recently requested textures back to their tail.
+	*/
+	class texture_streamer
+	{
+	public:
+		struct budget
+		{
+			uint64 upload_bytes	  = STREAM_UPLOAD_BUDGET;
+			uint64 resident_bytes = STREAM_RESIDENT_BUDGET;
+		};
+
+		struct residency_change
+		{
+			uint16 id		 = 0;
+			uint8  first_mip = 0;
+			uint8  evicted	 = 0;
+		};
+
+		void init(const budget& b);
+		void uninit();
+
+		/// mip_bytes has a size per mip, most detailed first. resident_mip is what the device holds at the moment, usually tail_mip.
+		uint16 add_texture(const uint32* mip_bytes, uint8 mip_count, uint8 tail_mip, uint8 resident_mip);
+		void   remove_texture(uint16 id);
+
+		/// Keeps the most detailed request per texture until the next update.
+		void request(uint16 id, uint8 mip, uint64 frame);
+
+		/// Decides this frame's changes, the caller applies them to the device.
+		void update(uint64 frame, vector<residency_change>& out_changes);
+
+		uint8  get_resident_mip(uint16 id) const;
+		uint64 get_resident_bytes(uint16 id) const;
+
+		inline const stream_stats& get_stats() const
+		{
+			return _stats;
+		}
+
+		inline void set_budget(const budget& b)
+		{
+			_budget = b;
+		}
+
+		/// First mip whose larger side is within tail_size, the last one if none is.
+		static uint8 calculate_tail_mip(const texture_buffer* buffers, uint8 count, uint16 tail_size = STREAM_TAIL_SIZE);
+
+		/// Coarsest mip that still has a texel per pixel when the texture spans screen_size pixels.
+		static uint8 calculate_demand_mip(uint16 width, uint16 height, uint8 mip_count, float screen_size);
+
+	private:
+		struct stream_entry
+		{
+			uint32 mip_bytes[MAX_TEXTURE_MIPS] = {};
+			uint64 last_used				   = 0;
+			uint8  mip_count				   = 0;
+			uint8  tail_mip					   = 0;
+			uint8  resident_mip				   = 0;
+			uint8  wanted_mip				   = 0;
+			uint8  requested				   = 0;
+			uint8  alive					   = 0;
+		};
+
+		uint64 bytes_from(const stream_entry& e, uint8 first_mip) const;
+		bool   make_room(uint64 frame, uint64 needed, vector<residency_change>& out_changes);
+
+	private:
+		vector<stream_entry> _entries;
+		vector<uint16>		 _free_ids;
+		vector<uint16>		 _candidates;
+		vector<uint16>		 _lru;
+		budget				 _budget	 = {};
+		stream_stats		 _stats		 = {};
+		uint32				 _lru_next	 = 0;
+		uint8				 _lru_built	 = 0;
+	};
+}
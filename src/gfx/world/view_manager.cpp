@@ -50,16 +50,16 @@ namespace SFG
 	{
 		for (const view& v : _views)
 		{
-			if (frustum::test(v.view_frustum, box) == frustum_result::outside)
-				return false;
+			if (frustum::test(v.view_frustum, box) != frustum_result::outside)
+				return true;
 		}
 
-		return true;
+		return false;
 	}
 
 	bool view_manager::visibility_test_main_view(const aabb& box)
 	{
-		SFG_ASSERT(_views.empty());
+		SFG_ASSERT(!_views.empty());
 		return frustum::test(_views[0].view_frustum, box) != frustum_result::outside;
 	}
 }
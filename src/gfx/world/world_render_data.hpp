@@ -9,8 +9,16 @@
 
 namespace SFG
 {
+	class texture;
+
 #define MAX_RENDERABLES 1024
 
+	struct texture_demand
+	{
+		texture* txt = nullptr;
+		uint8	 mip = 0;
+	};
+
 	struct world_render_data
 	{
 		view_manager									  views;
@@ -18,12 +26,14 @@ namespace SFG
 		static_vector<gpu_entity, MAX_GPU_ENTITIES>		  entities;
 		static_vector<gpu_light, MAX_GPU_LIGHTS>		  lights;
 		static_vector<gpu_bone, MAX_GPU_BONES>			  bones;
+		static_vector<texture_demand, MAX_WORLD_TEXTURES> texture_demands;
 
 		inline void reset()
 		{
 			views.reset();
 			renderables.clear();
 			entities.clear();
+			texture_demands.clear();
 		}
 	};
 }
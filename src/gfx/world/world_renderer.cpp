@@ -14,8 +14,13 @@
 #include "world/traits/trait_mesh_renderer.hpp"
 #include "resources/mesh.hpp"
 #include "resources/primitive.hpp"
-#include <algorithm>
-#include <execution>
+#include "resources/meshlet.hpp"
+#include "resources/material.hpp"
+#include "resources/texture.hpp"
+#include "thread/job_system.hpp"
+#include "lod_selector.hpp"
+#include "math/math.hpp"
+#include "common/profiler.hpp"
 
 namespace SFG
 {
@@ -47,41 +52,23 @@ namespace SFG
 			per_frame_data& pfd	  = _pfd[i];
 			pfd.sem_gfx.semaphore = backend->create_semaphore();
 
-			pfd.bones.create_staging_hw(
-				{
-					.size		= sizeof(gpu_bone) * MAX_GPU_BONES,
-					.flags		= resource_flags::rf_cpu_visible,
-					.debug_name = "bones_cpu",
-				},
-				{
-					.size		= sizeof(gpu_bone) * MAX_GPU_BONES,
-					.flags		= resource_flags::rf_gpu_only | resource_flags::rf_storage_buffer,
-					.debug_name = "bones_gpu",
-				});
+			pfd.bones.create_hw({
+				.size		= sizeof(gpu_bone) * MAX_GPU_BONES,
+				.flags		= resource_flags::rf_gpu_only | resource_flags::rf_storage_buffer,
+				.debug_name = "bones_gpu",
+			});
 
-			pfd.entities.create_staging_hw(
-				{
-					.size		= sizeof(gpu_entity) * MAX_GPU_ENTITIES,
-					.flags		= resource_flags::rf_cpu_visible,
-					.debug_name = "entities_cpu",
-				},
-				{
-					.size		= sizeof(gpu_entity) * MAX_GPU_ENTITIES,
-					.flags		= resource_flags::rf_gpu_only | resource_flags::rf_storage_buffer,
-					.debug_name = "entities_gpu",
-				});
+			pfd.entities.create_hw({
+				.size		= sizeof(gpu_entity) * MAX_GPU_ENTITIES,
+				.flags		= resource_flags::rf_gpu_only | resource_flags::rf_storage_buffer,
+				.debug_name = "entities_gpu",
+			});
 
-			pfd.lights.create_staging_hw(
-				{
-					.size		= sizeof(gpu_light) * MAX_GPU_LIGHTS,
-					.flags		= resource_flags::rf_cpu_visible,
-					.debug_name = "lights_cpu",
-				},
-				{
-					.size		= sizeof(gpu_light) * MAX_GPU_LIGHTS,
-					.flags		= resource_flags::rf_gpu_only | resource_flags::rf_storage_buffer,
-					.debug_name = "lights_gpu",
-				});
+			pfd.lights.create_hw({
+				.size		= sizeof(gpu_light) * MAX_GPU_LIGHTS,
+				.flags		= resource_flags::rf_gpu_only | resource_flags::rf_storage_buffer,
+				.debug_name = "lights_gpu",
+			});
 
 			entity_buffers.push_back(pfd.entities.get_hw_gpu());
 			bone_buffers.push_back(pfd.bones.get_hw_gpu());
@@ -170,6 +157,7 @@ namespace SFG
 
 	void world_renderer::populate_render_data(uint8 index, double interpolation)
 	{
+		SFG_PROFILE_FUNCTION();
 		buffer*		vertex_buffer = &_resource_uploads.get_big_vertex_buffer();
 		buffer*		index_buffer  = &_resource_uploads.get_big_index_buffer();
 		const float alpha		  = static_cast<float>(interpolation);
@@ -185,25 +173,57 @@ namespace SFG
 		entity_manager&	   em			 = _world->get_entity_manager();
 		chunk_allocator32& resources_aux = resources.get_aux();
 
-		const pool_allocator16& lights = em.get_trait_storage<trait_light>();
-		for (trait_handle h : lights)
+		// trait storages are dense, no dead slots to skip.
+		const sparse_set16& lights		 = em.get_trait_storage<trait_light>();
+		const trait_light*	lights_dense = lights.get_dense<trait_light>();
+		const uint16		lights_count = lights.get_count();
+		for (uint16 i = 0; i < lights_count; i++)
 		{
-			trait_light& trait = lights.get<trait_light>(h);
+			const trait_light& trait = lights_dense[i];
 			if (trait.meta.flags.is_set(trait_flags::trait_flags_is_disabled))
 				continue;
 
 			rd.lights.push_back({.color = {}});
 		}
 
-		const pool_allocator16& mesh_renderers = em.get_trait_storage<trait_mesh_renderer>();
-		for (trait_handle h : mesh_renderers)
+		const sparse_set16&	 mesh_renderers		  = em.get_trait_storage<trait_mesh_renderer>();
+		trait_mesh_renderer* mesh_renderers_dense = mesh_renderers.get_dense<trait_mesh_renderer>();
+		const uint16		 mesh_renderers_count = mesh_renderers.get_count();
+
+		// gather world bounds first, then cull them in batches against every view.
+		_cull_candidates.resize(0);
+		_cull_boxes.resize(0);
+
+		for (uint16 i = 0; i < mesh_renderers_count; i++)
 		{
-			trait_mesh_renderer& trait			 = mesh_renderers.get<trait_mesh_renderer>(h);
-			const uint16		 materials_count = trait.material_count;
+			const trait_mesh_renderer& trait = mesh_renderers_dense[i];
+			if (trait.material_count == 0)
+				continue;
+
+			_cull_candidates.push_back(i);
+			_cull_boxes.push_back(em.get_entity_aabb_abs(trait.meta.entity));
+		}
+
+		static_vector<frustum, MAX_VIEWS> frustums;
+		for (const view& v : views.get_views())
+			frustums.push_back(v.view_frustum);
 
-			if (materials_count == 0)
+		const vector3 camera_position	= cam_view.view_matrix.inverse().get_translation();
+		const float	  projection_factor = lod_selector::calculate_projection_factor(cam_view.proj_matrix, static_cast<float>(_base_size.y));
+		const uint32  candidates_count	= static_cast<uint32>(_cull_candidates.size());
+		_cull_visible.resize(candidates_count);
+		_cull_stats.reset();
+		_cluster_stats.reset();
+		frustum_culler::cull(frustums.data(), static_cast<uint32>(frustums.size()), _cull_boxes.data(), candidates_count, _cull_visible.data(), _cull_stats);
+
+		for (uint32 c = 0; c < candidates_count; c++)
+		{
+			if (_cull_visible[c] == 0)
 				continue;
 
+			trait_mesh_renderer& trait			 = mesh_renderers_dense[_cull_candidates[c]];
+			const uint16		 materials_count = trait.material_count;
+
 			const chunk_handle32 materials			  = trait.materials;
 			const entity_handle	 entity				  = trait.meta.entity;
 			resource_handle*	 ptr_material_handles = resources_aux.get<resource_handle>(trait.materials);
@@ -217,7 +237,49 @@ namespace SFG
 				continue;
 
 			const matrix4x3 entity_global = em.calculate_interpolated_transform_abs(entity, alpha);
-			const uint16	gpu_e		  = create_gpu_entity(index, {.model = entity_global});
+
+			const vector3 scale		= entity_global.get_scale();
+			const float	  max_scale = math::max(math::max(scale.x, scale.y), math::max(scale.z, MATH_EPS));
+
+			const aabb&	  box		  = _cull_boxes[c];
+			const vector3 center	  = (box.bounds_min + box.bounds_max) * 0.5f;
+			const float	  radius	  = (box.bounds_max - box.bounds_min).magnitude() * 0.5f;
+			const float	  view_dist	  = (cam_view.view_matrix * center).magnitude() - radius;
+			const float	  screen_size = view_dist > MATH_EPS ? radius * 2.0f * projection_factor / view_dist : MATH_INF_F;
+
+			// screen space error of the mesh levels, distance is measured to the bounds and scaled back into mesh space.
+			const uint8 lod_count = target_mesh.get_lod_count();
+			if (lod_count > 1)
+				trait.lod = lod_selector::select(target_mesh.get_lod_errors(), lod_count, trait.lod, view_dist / max_scale, projection_factor);
+			else
+				trait.lod = 0;
+
+			// streamed textures are asked for the detail they'd show stretched once over the bounds' screen extent.
+			for (uint16 m = 0; m < materials_count; m++)
+			{
+				const material& mat = resources.get_resource<material>(ptr_material_handles[m]);
+				for (resource_handle txt_handle : mat.get_textures())
+				{
+					texture& txt = resources.get_resource<texture>(txt_handle);
+					if (txt.get_stream_id() != STREAM_INVALID_ID)
+						add_texture_demand(index, &txt, texture_streamer::calculate_demand_mip(txt.get_width(), txt.get_height(), txt.get_cpu_count(), screen_size));
+				}
+			}
+
+			// clusters of the first level are culled on their own. Facing only holds for the main view and flips under mirroring transforms.
+			const vector3 axis_x		= vector3(entity_global.m[0], entity_global.m[1], entity_global.m[2]);
+			const vector3 axis_y		= vector3(entity_global.m[3], entity_global.m[4], entity_global.m[5]);
+			const vector3 axis_z		= vector3(entity_global.m[6], entity_global.m[7], entity_global.m[8]);
+			const bool	  backface_cull = frustums.size() == 1 && vector3::dot(vector3::cross(axis_x, axis_y), axis_z) > 0.0f;
+			const vector3 camera_local	= backface_cull ? entity_global.inverse() * camera_position : vector3::zero;
+
+			const vertex_quantization& quant = target_mesh.get_quantization();
+			const uint16			   gpu_e = create_gpu_entity(index,
+															 {
+																 .model			  = entity_global,
+																 .position_min	  = vector4(quant.position_min.x, quant.position_min.y, quant.position_min.z, 0.0f),
+																 .position_extent = vector4(quant.position_extent.x, quant.position_extent.y, quant.position_extent.z, 1.0f),
+															 });
 
 			for (uint16 i = 0; i < prims_count; i++)
 			{
@@ -226,22 +288,47 @@ namespace SFG
 				if (prim.material_index >= static_cast<int16>(materials_count) || prim.indices_count == 0)
 					continue;
 
-				create_renderable(index,
-								  {
-									  .vertex_buffer = vertex_buffer,
-									  .index_buffer	 = index_buffer,
-									  .vertex_start	 = static_cast<uint32>(prim.runtime.vertex_start),
-									  .index_start	 = static_cast<uint32>(prim.runtime.index_start),
-									  .index_count	 = prim.indices_count,
-									  .material		 = ptr_material_handles[prim.material_index],
-									  .gpu_entity	 = gpu_e,
-									  .is_skinned	 = 0,
-								  });
+				auto add_range = [&](const primitive_lod& range) {
+					create_renderable(index,
+									  {
+										  .vertex_buffer = vertex_buffer,
+										  .index_buffer	 = index_buffer,
+										  .vertex_start	 = prim.runtime.vertex_start[index],
+										  .index_start	 = prim.runtime.index_start[index] + range.index_start,
+										  .index_count	 = range.index_count,
+										  .material		 = ptr_material_handles[prim.material_index],
+										  .gpu_entity	 = gpu_e,
+										  .vertex_size	 = prim.vertex_size,
+										  .is_skinned	 = 0,
+										  .is_packed	 = prim.is_packed,
+									  });
+				};
+
+				if (trait.lod != 0 || prim.meshlet_count < 2)
+				{
+					add_range(prim.lods[trait.lod]);
+					continue;
+				}
+
+				primitive_lod  ranges[CLUSTER_MAX_RANGES];
+				const meshlet* ptr_meshlets = resources_aux.get<meshlet>(prim.meshlets);
+				const uint32   range_count	= cluster_culler::cull(ptr_meshlets,
+																   prim.meshlet_count,
+																   frustums.data(),
+																   static_cast<uint32>(frustums.size()),
+																   entity_global,
+																   max_scale,
+																   backface_cull ? &camera_local : nullptr,
+																   ranges,
+																   CLUSTER_MAX_RANGES,
+																   _cluster_stats);
+				for (uint32 r = 0; r < range_count; r++)
+					add_range(ranges[r]);
 			}
 		}
 
 		_pass_opaque.populate_render_data(_world, cam_view, rd, index);
-		_pass_lighting_fw.populate_render_data(_world, index);
+		_pass_lighting_fw.populate_render_data(_world, cam_view, rd, index);
 		_pass_post_combiner.populate_render_data(_world, index);
 	}
 
@@ -252,30 +339,26 @@ namespace SFG
 
 	void world_renderer::upload(uint8 data_index, uint8 frame_index)
 	{
+		SFG_PROFILE_FUNCTION();
 		_resource_uploads.check_uploads();
 		_resource_uploads.upload(_world->get_resources().get_aux(), _texture_queue, _buffer_queue, data_index, frame_index);
 
 		world_render_data& rd  = _render_data[data_index];
 		per_frame_data&	   pfd = _pfd[frame_index];
 
-		if (!rd.bones.empty())
-			pfd.bones.buffer_data(0, rd.bones.data(), sizeof(gpu_bone) * rd.bones.size());
-
-		if (!rd.entities.empty())
-			pfd.entities.buffer_data(0, rd.entities.data(), sizeof(gpu_entity) * rd.entities.size());
-
-		if (!rd.lights.empty())
-			pfd.lights.buffer_data(0, rd.lights.data(), sizeof(gpu_light) * rd.lights.size());
+		_resource_uploads.stream_textures(_world->get_resources(), rd.texture_demands, _texture_queue, frame_index);
 
-		_buffer_queue->add_request({.buffer = &pfd.entities});
-		_buffer_queue->add_request({.buffer = &pfd.bones});
-		_buffer_queue->add_request({.buffer = &pfd.lights});
+		// only what was extracted goes out, straight through the upload ring.
+		_buffer_queue->upload(pfd.bones.get_hw_gpu(), 0, rd.bones.data(), static_cast<uint32>(sizeof(gpu_bone) * rd.bones.size()));
+		_buffer_queue->upload(pfd.entities.get_hw_gpu(), 0, rd.entities.data(), static_cast<uint32>(sizeof(gpu_entity) * rd.entities.size()));
+		_buffer_queue->upload(pfd.lights.get_hw_gpu(), 0, rd.lights.data(), static_cast<uint32>(sizeof(gpu_light) * rd.lights.size()));
 
 		_pass_opaque.upload(_world, _buffer_queue, data_index, frame_index);
 	}
 
 	void world_renderer::render(uint8 data_index, uint8 frame_index, gfx_id layout_global, gfx_id bind_group_global, uint64 prev_copy, uint64 next_copy, gfx_id sem_copy)
 	{
+		SFG_PROFILE_FUNCTION();
 		gfx_backend* backend   = gfx_backend::get();
 		const gfx_id queue_gfx = backend->get_queue_gfx();
 
@@ -296,12 +379,16 @@ namespace SFG
 		const gfx_id	cmd_lighting_fw		= _pass_lighting_fw.get_cmd_buffer(frame_index);
 		const gfx_id	cmd_post			= _pass_post_combiner.get_cmd_buffer(frame_index);
 
-		static_vector<std::function<void()>, 1> tasks;
-		tasks.push_back([&] { _pass_opaque.render(data_index, frame_index, resolution, layout_global, bind_group_global); });
-		std::for_each(std::execution::par, tasks.begin(), tasks.end(), [](std::function<void()>& task) { task(); });
+		job_counter pass_counter;
+		auto		render_opaque = [&] { _pass_opaque.render(data_index, frame_index, resolution, layout_global, bind_group_global); };
+		job_system::get().submit(render_opaque, &pass_counter);
 
-		//	tasks.push_back([&] { _pass_lighting_fw.render(data_index, frame_index, resolution, layout_global, bind_group_global); });
-		//	tasks.push_back([&] { _pass_post_combiner.render(data_index, frame_index, resolution, layout_global, bind_group_global); });
+		//	auto render_lighting_fw = [&] { _pass_lighting_fw.render(data_index, frame_index, resolution, layout_global, bind_group_global); };
+		//	auto render_post_combiner = [&] { _pass_post_combiner.render(data_index, frame_index, resolution, layout_global, bind_group_global); };
+		//	job_system::get().submit(render_lighting_fw, &pass_counter);
+		//	job_system::get().submit(render_post_combiner, &pass_counter);
+
+		job_system::get().wait(&pass_counter);
 
 		// Submit opaque, signals itself
 		backend->submit_commands(queue_gfx, &cmd_opaque, 1);
@@ -362,6 +449,21 @@ namespace SFG
 		return i;
 	}
 
+	void world_renderer::add_texture_demand(uint8 data_index, texture* txt, uint8 mip)
+	{
+		world_render_data& rd = _render_data[data_index];
+		for (texture_demand& d : rd.texture_demands)
+		{
+			if (d.txt != txt)
+				continue;
+
+			d.mip = d.mip < mip ? d.mip : mip;
+			return;
+		}
+
+		rd.texture_demands.push_back({.txt = txt, .mip = mip});
+	}
+
 	void world_renderer::push_barrier_ps(gfx_id id, static_vector<barrier, MAX_BARRIERS>& barriers)
 	{
 		barriers.push_back({
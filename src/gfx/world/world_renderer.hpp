@@ -4,6 +4,7 @@
 
 #include "common/size_definitions.hpp"
 #include "data/static_vector.hpp"
+#include "data/vector.hpp"
 #include "data/atomic.hpp"
 #include "math/vector2ui16.hpp"
 #include "gfx/common/gfx_constants.hpp"
@@ -14,6 +15,10 @@
 #include "memory/bump_allocator.hpp"
 #include "world_resource_uploads.hpp"
 #include "world_render_data.hpp"
+#include "frustum_culler.hpp"
+#include "cluster_culler.hpp"
+#include "math/aabb.hpp"
+#include "world/traits/common_trait.hpp"
 
 #include "render_pass/render_pass_opaque.hpp"
 #include "render_pass/render_pass_lighting_forward.hpp"
@@ -52,6 +57,7 @@ namespace SFG
 
 		uint16 create_gpu_entity(uint8 data_index, const gpu_entity& e);
 		uint16 create_renderable(uint8 data_index, const renderable_object& e);
+		void   add_texture_demand(uint8 data_index, texture* txt, uint8 mip);
 
 		inline gfx_id get_output(uint8 frame_index)
 		{
@@ -70,6 +76,16 @@ namespace SFG
 			return _resource_uploads;
 		}
 
+		inline const cull_stats& get_cull_stats() const
+		{
+			return _cull_stats;
+		}
+
+		inline const cluster_cull_stats& get_cluster_stats() const
+		{
+			return _cluster_stats;
+		}
+
 	private:
 		void push_barrier_ps(gfx_id id, static_vector<barrier, MAX_BARRIERS>& barriers);
 		void push_barrier_rt(gfx_id id, static_vector<barrier, MAX_BARRIERS>& barriers);
@@ -89,5 +105,11 @@ namespace SFG
 		world_resource_uploads _resource_uploads;
 		vector2ui16			   _base_size			 = vector2ui16::zero;
 		uint8*				   _shared_command_alloc = nullptr;
+
+		vector<uint16>		 _cull_candidates; // dense trait indices.
+		vector<aabb>		 _cull_boxes;
+		vector<uint8>		 _cull_visible;
+		cull_stats			 _cull_stats	= {};
+		cluster_cull_stats	 _cluster_stats = {};
 	};
 }
@@ -13,123 +13,378 @@
 #include "memory/chunk_allocator.hpp"
 #include "common/system_info.hpp"
 #include "resources/primitive.hpp"
+#include "world/world_resources.hpp"
+#include <algorithm>
 
 namespace SFG
 {
 	void world_resource_uploads::init()
 	{
-		gfx_backend* backend			= gfx_backend::get();
-		const uint32 vertex_buffer_size = 1024 * 1024 * 2;
-		const uint32 index_buffer_size	= 1024 * 1024 * 2;
-		_mesh_data.big_vertex_buffer.create_staging_hw(
-			{
-				.size		= vertex_buffer_size,
-				.flags		= resource_flags::rf_cpu_visible,
-				.debug_name = "big_vertex_staging",
-			},
-			{
-				.size		= vertex_buffer_size,
-				.flags		= resource_flags::rf_vertex_buffer | resource_flags::rf_gpu_only,
-				.debug_name = "big_vertex_gpu",
-			});
+		_mesh_data.vertex_heap.init(GEOMETRY_HEAP_INITIAL_SIZE, resource_flags::rf_vertex_buffer, "geometry_vertices");
+		_mesh_data.index_heap.init(GEOMETRY_HEAP_INITIAL_SIZE, resource_flags::rf_index_buffer, "geometry_indices");
 
-		_mesh_data.big_index_buffer.create_staging_hw(
-			{
-				.size		= index_buffer_size,
-				.flags		= resource_flags::rf_cpu_visible,
-				.debug_name = "big_index_staging",
-			},
-			{
-				.size		= index_buffer_size,
-				.flags		= resource_flags::rf_index_buffer | resource_flags::rf_gpu_only,
-				.debug_name = "big_index_gpu",
-			});
+		_streamer.init({});
 	}
 	void world_resource_uploads::uninit()
 	{
 		gfx_backend* backend = gfx_backend::get();
 
-		_mesh_data.big_vertex_buffer.destroy();
-		_mesh_data.big_index_buffer.destroy();
+		_mesh_data.vertex_heap.uninit();
+		_mesh_data.index_heap.uninit();
+		_geometry_owners.clear();
+		_free_geometry_owners.clear();
+		_pending_starts.clear();
+
+		destroy_retired(true);
+		_streamer.uninit();
+		_materials.clear();
 	}
 
 	void world_resource_uploads::upload(chunk_allocator32& resources_aux, texture_queue* tq, buffer_queue* bq, uint8 data_index, uint8 frame_index)
 	{
 		for (texture* t : _pending_textures)
 		{
+			const uint8 first_mip = t->get_first_mip();
 			tq->add_request({
 				.texture	  = t->get_hw(),
 				.intermediate = t->get_intermediate(),
-				.buffers	  = t->get_cpu(),
-				.buffer_count = t->get_cpu_count(),
+				.buffers	  = t->get_cpu() + first_mip,
+				.buffer_count = static_cast<uint8>(t->get_cpu_count() - first_mip),
 			});
-			_uploaded_textures.push_back(t);
+
+			// streamed textures keep their cpu copy as the source of higher mips.
+			if (t->get_stream_id() != STREAM_INVALID_ID)
+				retire(t->release_intermediate(), 0, frame_info::get_render_frame());
+			else
+				_uploaded_textures.push_back(t);
+
 			_last_upload_frame = frame_info::get_render_frame();
 		}
 
+		// starts changed while the other index was being populated go out now.
+		publish_starts(resources_aux, data_index);
+
+		// meshes go out as far as the upload ring allows, the first one always does.
+		const uint64 frame	= frame_info::get_render_frame();
+		uint32		 placed = 0;
 		for (mesh* m : _pending_meshes)
 		{
-			const chunk_handle32 prims_static		= m->get_primitives_static();
-			const uint16		 prims_static_count = m->get_primitives_static_count();
-			primitive*			 ptr_static			= prims_static_count == 0 ? nullptr : resources_aux.get<primitive>(prims_static);
+			if (!place_mesh(m, resources_aux, bq, frame, data_index, placed == 0))
+				break;
+			placed++;
+		}
 
-			for (uint16 j = 0; j < prims_static_count; j++)
-			{
-				primitive& p		   = ptr_static[j];
-				p.runtime.vertex_start = _mesh_data.current_vertex_size;
-				p.runtime.index_start  = _mesh_data.current_index_size;
+		const uint32 remaining = static_cast<uint32>(_pending_meshes.size()) - placed;
+		for (uint32 i = 0; i < remaining; i++)
+			_pending_meshes[i] = _pending_meshes[i + placed];
+		_pending_meshes.resize(remaining);
+		relocate_geometry(resources_aux, bq, frame, data_index);
+
+		per_frame_data& pfd = _pfd[frame_index];
+
+		for (material* mat : pfd.pending_materials)
+		{
+			buffer&		   buf	= mat->get_buffer(frame_index);
+			const ostream& data = mat->get_data();
+			buf.buffer_data(0, data.get_raw(), data.get_size());
+			bq->add_request({.target = &buf});
+		}
+
+		pfd.pending_materials.clear();
+		_pending_textures.clear();
+	}
+
+	primitive& world_resource_uploads::get_owner_primitive(const geometry_owner& owner, chunk_allocator32& resources_aux)
+	{
+		const chunk_handle32 prims = owner.skinned ? owner.target->get_primitives_skinned() : owner.target->get_primitives_static();
+		return resources_aux.get<primitive>(prims)[owner.primitive];
+	}
+
+	bool world_resource_uploads::place_mesh(mesh* m, chunk_allocator32& resources_aux, buffer_queue* bq, uint64 frame, uint8 data_index, bool force)
+	{
+		const uint16 static_count  = m->get_primitives_static_count();
+		const uint16 skinned_count = m->get_primitives_skinned_count();
+		primitive*	 ptr_static	   = static_count == 0 ? nullptr : resources_aux.get<primitive>(m->get_primitives_static());
+		primitive*	 ptr_skinned   = skinned_count == 0 ? nullptr : resources_aux.get<primitive>(m->get_primitives_skinned());
+
+		size_t total = 0;
+		for (uint16 j = 0; j < static_count; j++)
+			total += ptr_static[j].vertices.size + ptr_static[j].indices.size + UPLOAD_RING_ALIGNMENT * 2;
+		for (uint16 j = 0; j < skinned_count; j++)
+			total += ptr_skinned[j].vertices.size + ptr_skinned[j].indices.size + UPLOAD_RING_ALIGNMENT * 2;
 
-				_mesh_data.big_index_buffer.buffer_data(_mesh_data.current_index_size, resources_aux.get(p.indices.head), p.indices.size);
-				_mesh_data.current_index_size += p.indices.size;
+		const ring_allocator& ring = bq->get_ring();
+		if (!force && ring.get_used() + total > ring.get_capacity())
+			return false;
 
-				_mesh_data.big_vertex_buffer.buffer_data(_mesh_data.current_vertex_size, resources_aux.get(p.vertices.head), p.vertices.size);
-				_mesh_data.current_vertex_size += p.vertices.size;
+		// full & packed vertices share the heap, every primitive starts on a multiple of its own stride so base vertex stays an element offset.
+		auto place = [&](primitive& p, uint16 index, uint8 skinned) {
+			uint32 owner = 0;
+			if (!_free_geometry_owners.empty())
+			{
+				owner = _free_geometry_owners.back();
+				_free_geometry_owners.pop_back();
+			}
+			else
+			{
+				owner = static_cast<uint32>(_geometry_owners.size());
+				_geometry_owners.push_back({});
 			}
+			_geometry_owners[owner] = {.target = m, .primitive = index, .skinned = skinned};
+
+			geometry_heap& vertex_heap = _mesh_data.vertex_heap;
+			geometry_heap& index_heap  = _mesh_data.index_heap;
+			p.runtime.vertex_range	   = vertex_heap.allocate(bq, p.vertices.size, p.vertex_size, owner, frame);
+			p.runtime.index_range	   = index_heap.allocate(bq, p.indices.size, sizeof(primitive_index), owner, frame);
+			set_start(p, owner, vertex_heap.get_offset(p.runtime.vertex_range) / p.vertex_size, 0, data_index);
+			set_start(p, owner, index_heap.get_offset(p.runtime.index_range) / sizeof(primitive_index), 1, data_index);
+			vertex_heap.upload(bq, p.runtime.vertex_range, resources_aux.get(p.vertices.head));
+			index_heap.upload(bq, p.runtime.index_range, resources_aux.get(p.indices.head));
+		};
+
+		for (uint16 j = 0; j < static_count; j++)
+			place(ptr_static[j], j, 0);
+		for (uint16 j = 0; j < skinned_count; j++)
+			place(ptr_skinned[j], j, 1);
+
+		return true;
+	}
+
+	void world_resource_uploads::relocate_geometry(chunk_allocator32& resources_aux, buffer_queue* bq, uint64 frame, uint8 data_index)
+	{
+		// moved ranges get their data again from the cpu copy, draws extracted before the move still read the old range.
+		_relocations.resize(0);
+		_mesh_data.vertex_heap.update(frame, _relocations);
+		for (const range_allocator::relocation& r : _relocations)
+		{
+			const uint32 owner = _mesh_data.vertex_heap.get_allocator().get_user(r.id);
+			primitive&	 p	   = get_owner_primitive(_geometry_owners[owner], resources_aux);
+			set_start(p, owner, r.new_offset / p.vertex_size, 0, data_index);
+			_mesh_data.vertex_heap.upload(bq, r.id, resources_aux.get(p.vertices.head));
+		}
+
+		_relocations.resize(0);
+		_mesh_data.index_heap.update(frame, _relocations);
+		for (const range_allocator::relocation& r : _relocations)
+		{
+			const uint32 owner = _mesh_data.index_heap.get_allocator().get_user(r.id);
+			primitive&	 p	   = get_owner_primitive(_geometry_owners[owner], resources_aux);
+			set_start(p, owner, r.new_offset / sizeof(primitive_index), 1, data_index);
+			_mesh_data.index_heap.upload(bq, r.id, resources_aux.get(p.indices.head));
+		}
+	}
 
-			const chunk_handle32 prims_skinned		 = m->get_primitives_skinned();
-			const uint16		 prims_skinned_count = m->get_primitives_skinned_count();
-			primitive*			 ptr_skinned		 = prims_skinned_count == 0 ? nullptr : resources_aux.get<primitive>(prims_skinned);
+	void world_resource_uploads::set_start(primitive& p, uint32 owner, uint32 start, uint8 is_index, uint8 data_index)
+	{
+		// the main thread may be populating any other index right now, those copies wait for their own upload.
+		uint32* starts	   = is_index ? p.runtime.index_start : p.runtime.vertex_start;
+		starts[data_index] = start;
+
+		const uint8 all = (1 << THREAD_BUFFER_COUNT) - 1;
+		_pending_starts.push_back({.owner = owner, .start = start, .is_index = is_index, .slots = static_cast<uint8>(all & ~(1 << data_index))});
+	}
 
-			for (uint16 j = 0; j < prims_skinned_count; j++)
+	void world_resource_uploads::publish_starts(chunk_allocator32& resources_aux, uint8 data_index)
+	{
+		// in order, a later move of the same range overwrites an earlier one.
+		const uint8 bit	 = static_cast<uint8>(1 << data_index);
+		size_t		kept = 0;
+		for (pending_start& ps : _pending_starts)
+		{
+			if (ps.slots & bit)
 			{
-				primitive& p = ptr_skinned[j];
+				primitive& p	  = get_owner_primitive(_geometry_owners[ps.owner], resources_aux);
+				uint32*	   starts = ps.is_index ? p.runtime.index_start : p.runtime.vertex_start;
+				starts[data_index] = ps.start;
+				ps.slots &= ~bit;
+			}
 
-				p.runtime.vertex_start = _mesh_data.current_vertex_size;
-				p.runtime.index_start  = _mesh_data.current_index_size;
+			if (ps.slots != 0)
+				_pending_starts[kept++] = ps;
+		}
+		_pending_starts.resize(kept);
+	}
+
+	void world_resource_uploads::remove_mesh(mesh* m, chunk_allocator32& resources_aux)
+	{
+		VERIFY_RENDER_NOT_RUNNING_OR_RENDER_THREAD();
+
+		auto it = std::find(_pending_meshes.begin(), _pending_meshes.end(), m);
+		if (it != _pending_meshes.end())
+		{
+			_pending_meshes.remove_index(it - _pending_meshes.begin());
+			return;
+		}
 
-				_mesh_data.big_index_buffer.buffer_data(_mesh_data.current_index_size, resources_aux.get(p.indices.head), p.indices.size);
-				_mesh_data.current_index_size += p.indices.size;
+		const uint64 frame = frame_info::get_render_frame();
+		auto		 clear = [&](primitive& p) {
+			if (p.runtime.vertex_range == RANGE_INVALID_ID)
+				return;
 
-				_mesh_data.big_vertex_buffer.buffer_data(_mesh_data.current_vertex_size, resources_aux.get(p.vertices.head), p.vertices.size);
-				_mesh_data.current_vertex_size += p.vertices.size;
+			const uint32 owner = _mesh_data.vertex_heap.get_allocator().get_user(p.runtime.vertex_range);
+			_free_geometry_owners.push_back(owner);
+
+			// starts not yet published belong to a primitive that's going away.
+			size_t kept = 0;
+			for (const pending_start& ps : _pending_starts)
+			{
+				if (ps.owner != owner)
+					_pending_starts[kept++] = ps;
 			}
+			_pending_starts.resize(kept);
+
+			_mesh_data.vertex_heap.free(p.runtime.vertex_range, frame);
+			_mesh_data.index_heap.free(p.runtime.index_range, frame);
+			p.runtime = {};
+		};
+
+		const uint16 static_count  = m->get_primitives_static_count();
+		const uint16 skinned_count = m->get_primitives_skinned_count();
+		primitive*	 ptr_static	   = static_count == 0 ? nullptr : resources_aux.get<primitive>(m->get_primitives_static());
+		primitive*	 ptr_skinned   = skinned_count == 0 ? nullptr : resources_aux.get<primitive>(m->get_primitives_skinned());
+
+		for (uint16 j = 0; j < static_count; j++)
+			clear(ptr_static[j]);
+		for (uint16 j = 0; j < skinned_count; j++)
+			clear(ptr_skinned[j]);
+	}
+
+	void world_resource_uploads::stream_textures(world_resources& resources, const static_vector<texture_demand, MAX_WORLD_TEXTURES>& demands, texture_queue* tq, uint8 frame_index)
+	{
+		const uint64 frame = frame_info::get_render_frame();
+
+		for (const texture_demand& d : demands)
+		{
+			const uint16 id = d.txt->get_stream_id();
+			if (id != STREAM_INVALID_ID)
+				_streamer.request(id, d.mip, frame);
 		}
 
-		if (!_pending_meshes.empty())
+		_stream_changes.resize(0);
+		_streamer.update(frame, _stream_changes);
+
+		// textures are rebuilt from the new first mip, the old copy lives until frames recorded with it are done.
+		for (const texture_streamer::residency_change& change : _stream_changes)
 		{
-			bq->add_request({.buffer = &_mesh_data.big_vertex_buffer});
-			bq->add_request({.buffer = &_mesh_data.big_index_buffer});
+			texture* t = _streamed_textures[change.id];
+			retire(t->release_hw(), 1, frame);
+			t->create_hw(change.first_mip);
+
+			tq->add_request({
+				.texture	  = t->get_hw(),
+				.intermediate = t->get_intermediate(),
+				.buffers	  = t->get_cpu() + change.first_mip,
+				.buffer_count = static_cast<uint8>(t->get_cpu_count() - change.first_mip),
+			});
+			retire(t->release_intermediate(), 0, frame);
+
+			for (material* mat : _materials)
+			{
+				bool uses = false;
+				for (resource_handle h : mat->get_textures())
+					uses |= &resources.get_resource<texture>(h) == t;
+
+				if (!uses)
+					continue;
+
+				for (uint8 i = 0; i < FRAMES_IN_FLIGHT; i++)
+				{
+					per_frame_data& pfd = _pfd[i];
+					if (std::find(pfd.pending_bindings.begin(), pfd.pending_bindings.end(), mat) == pfd.pending_bindings.end())
+						pfd.pending_bindings.push_back(mat);
+				}
+			}
 		}
 
+		// groups of other frames may still be in flight, each is updated once its frame records again.
 		per_frame_data& pfd = _pfd[frame_index];
+		for (material* mat : pfd.pending_bindings)
+			mat->update_bindings(resources, frame_index);
+		pfd.pending_bindings.clear();
 
-		for (material* mat : pfd.pending_materials)
+		destroy_retired(false);
+	}
+
+	void world_resource_uploads::retire(gfx_id id, uint8 is_texture, uint64 frame)
+	{
+		_retired.push_back({.frame = frame, .id = id, .is_texture = is_texture});
+	}
+
+	void world_resource_uploads::destroy_retired(bool force)
+	{
+		gfx_backend* backend = gfx_backend::get();
+		const uint64 frame	 = frame_info::get_render_frame();
+
+		for (auto it = _retired.begin(); it != _retired.end();)
 		{
-			buffer&		   buf	= mat->get_buffer(frame_index);
-			const ostream& data = mat->get_data();
-			buf.buffer_data(0, data.get_raw(), data.get_size());
-			bq->add_request({.buffer = &buf});
-		}
+			if (!force && frame < it->frame + FRAMES_IN_FLIGHT + 1)
+			{
+				++it;
+				continue;
+			}
 
-		pfd.pending_materials.clear();
-		_pending_textures.clear();
-		_pending_meshes.clear();
+			if (it->is_texture)
+				backend->destroy_texture(it->id);
+			else
+				backend->destroy_resource(it->id);
+			it = _retired.erase(it);
+		}
 	}
 
 	void world_resource_uploads::add_pending_texture(texture* txt)
 	{
 		VERIFY_RENDER_NOT_RUNNING_OR_RENDER_THREAD();
 		_pending_textures.push_back(txt);
+
+		// anything created above its tail streams.
+		const uint8 first_mip = txt->get_first_mip();
+		if (first_mip == 0 || txt->get_stream_id() != STREAM_INVALID_ID)
+			return;
+
+		const uint8 count = txt->get_cpu_count();
+		uint32		mip_bytes[MAX_TEXTURE_MIPS];
+		for (uint8 i = 0; i < count; i++)
+			mip_bytes[i] = static_cast<uint32>(txt->get_cpu()[i].get_data_size());
+
+		const uint16 id = _streamer.add_texture(mip_bytes, count, first_mip, first_mip);
+		SFG_ASSERT(id < MAX_WORLD_TEXTURES);
+		_streamed_textures[id] = txt;
+		txt->set_stream_id(id);
+	}
+
+	void world_resource_uploads::remove_texture(texture* txt)
+	{
+		VERIFY_RENDER_NOT_RUNNING();
+
+		const uint16 id = txt->get_stream_id();
+		if (id == STREAM_INVALID_ID)
+			return;
+
+		_streamer.remove_texture(id);
+		_streamed_textures[id] = nullptr;
+		txt->set_stream_id(STREAM_INVALID_ID);
+	}
+
+	void world_resource_uploads::remove_material(material* mat)
+	{
+		VERIFY_RENDER_NOT_RUNNING();
+
+		// pending lists hold one entry per add_pending_material call.
+		auto erase = [mat](static_vector<material*, MAX_WORLD_MATERIALS>& list) {
+			auto it = std::find(list.begin(), list.end(), mat);
+			while (it != list.end())
+			{
+				list.remove_index(it - list.begin());
+				it = std::find(list.begin(), list.end(), mat);
+			}
+		};
+
+		erase(_materials);
+		for (uint8 i = 0; i < FRAMES_IN_FLIGHT; i++)
+		{
+			erase(_pfd[i].pending_materials);
+			erase(_pfd[i].pending_bindings);
+		}
 	}
 
 	void world_resource_uploads::add_pending_material(material* mat)
@@ -138,6 +393,9 @@ namespace SFG
 
 		for (uint8 i = 0; i < FRAMES_IN_FLIGHT; i++)
 			_pfd[i].pending_materials.push_back(mat);
+
+		if (std::find(_materials.begin(), _materials.end(), mat) == _materials.end())
+			_materials.push_back(mat);
 	}
 
 	void world_resource_uploads::add_pending_mesh(mesh* m)
@@ -6,6 +6,9 @@
 #include "data/static_vector.hpp"
 #include "data/atomic.hpp"
 #include "world/common_world.hpp"
+#include "texture_streamer.hpp"
+#include "geometry_heap.hpp"
+#include "world_render_data.hpp"
 
 namespace SFG
 {
@@ -17,21 +20,45 @@ namespace SFG
 	class mesh;
 	class material;
 	class chunk_allocator32;
+	class world_resources;
+	struct primitive;
 
 	class world_resource_uploads
 	{
 	private:
 		struct mesh_data
 		{
-			buffer big_vertex_buffer   = {};
-			buffer big_index_buffer	   = {};
-			size_t current_vertex_size = 0;
-			size_t current_index_size  = 0;
+			geometry_heap vertex_heap;
+			geometry_heap index_heap;
+		};
+
+		struct geometry_owner
+		{
+			mesh*  target	 = nullptr;
+			uint16 primitive = 0;
+			uint8  skinned	 = 0;
 		};
 
 		struct per_frame_data
 		{
 			static_vector<material*, MAX_WORLD_MATERIALS> pending_materials;
+			static_vector<material*, MAX_WORLD_MATERIALS> pending_bindings;
+		};
+
+		/// A start the other render data indices haven't seen yet, slots is a bit per data index.
+		struct pending_start
+		{
+			uint32 owner	= 0;
+			uint32 start	= 0;
+			uint8  is_index = 0;
+			uint8  slots	= 0;
+		};
+
+		struct retired_resource
+		{
+			uint64 frame	  = 0;
+			gfx_id id		  = 0;
+			uint8  is_texture = 0;
 		};
 
 	public:
@@ -41,26 +68,62 @@ namespace SFG
 		void add_pending_texture(texture* txt);
 		void add_pending_material(material* matk);
 		void add_pending_mesh(mesh* mesh);
+		void remove_mesh(mesh* m, chunk_allocator32& resources_aux);
+		void remove_texture(texture* txt);
+		void remove_material(material* mat);
 		void upload(chunk_allocator32& resources_aux, texture_queue* tq, buffer_queue* bq, uint8 data_index, uint8 frame_index);
+		void stream_textures(world_resources& resources, const static_vector<texture_demand, MAX_WORLD_TEXTURES>& demands, texture_queue* tq, uint8 frame_index);
 		void check_uploads(bool force = false);
 
 		inline buffer& get_big_vertex_buffer()
 		{
-			return _mesh_data.big_vertex_buffer;
+			return _mesh_data.vertex_heap.get_buffer();
 		}
 
 		inline buffer& get_big_index_buffer()
 		{
-			return _mesh_data.big_index_buffer;
+			return _mesh_data.index_heap.get_buffer();
+		}
+
+		inline const geometry_heap& get_vertex_heap() const
+		{
+			return _mesh_data.vertex_heap;
+		}
+
+		inline const geometry_heap& get_index_heap() const
+		{
+			return _mesh_data.index_heap;
+		}
+
+		inline texture_streamer& get_streamer()
+		{
+			return _streamer;
 		}
 
 	private:
+		void retire(gfx_id id, uint8 is_texture, uint64 frame);
+		void destroy_retired(bool force);
+		bool place_mesh(mesh* m, chunk_allocator32& resources_aux, buffer_queue* bq, uint64 frame, uint8 data_index, bool force);
+		void relocate_geometry(chunk_allocator32& resources_aux, buffer_queue* bq, uint64 frame, uint8 data_index);
+		void set_start(primitive& p, uint32 owner, uint32 start, uint8 is_index, uint8 data_index);
+		void publish_starts(chunk_allocator32& resources_aux, uint8 data_index);
+		primitive& get_owner_primitive(const geometry_owner& owner, chunk_allocator32& resources_aux);
+
 	private:
-		mesh_data									_mesh_data = {};
-		per_frame_data								_pfd[FRAMES_IN_FLIGHT];
-		static_vector<texture*, MAX_WORLD_TEXTURES> _pending_textures;
-		static_vector<texture*, MAX_WORLD_TEXTURES> _uploaded_textures;
-		static_vector<mesh*, MAX_WORLD_MODELS>		_pending_meshes;
-		atomic<uint64>								_last_upload_frame = 0;
+		mesh_data									  _mesh_data = {};
+		per_frame_data								  _pfd[FRAMES_IN_FLIGHT];
+		static_vector<texture*, MAX_WORLD_TEXTURES>	  _pending_textures;
+		static_vector<texture*, MAX_WORLD_TEXTURES>	  _uploaded_textures;
+		static_vector<mesh*, MAX_WORLD_MODELS>		  _pending_meshes;
+		static_vector<material*, MAX_WORLD_MATERIALS> _materials;
+		texture*									  _streamed_textures[MAX_WORLD_TEXTURES] = {};
+		texture_streamer							  _streamer;
+		vector<texture_streamer::residency_change>	  _stream_changes;
+		vector<retired_resource>					  _retired;
+		vector<geometry_owner>						  _geometry_owners;
+		vector<uint32>								  _free_geometry_owners;
+		vector<range_allocator::relocation>			  _relocations;
+		vector<pending_start>						  _pending_starts;
+		atomic<uint64>								  _last_upload_frame = 0;
 	};
 }
@@ -7,6 +7,7 @@
 #include <assert.h>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <fstream>
 #include <functional>
 #include <utility> // For std::swap, std::move
@@ -466,7 +467,7 @@ namespace vekt
 		}
 		static inline float ceilf(float f)
 		{
-			return std::ceilf(f);
+			return std::ceil(f);
 		}
 		static inline float remap(float val, float from_low, float from_high, float to_low, float to_high)
 		{
@@ -782,8 +783,8 @@ namespace vekt
 
 	struct second_color_props
 	{
-		VEKT_VEC4 color		= VEKT_VEC4(1, 1, 1, 1);
-		direction direction = direction::horizontal;
+		VEKT_VEC4 color			  = VEKT_VEC4(1, 1, 1, 1);
+		direction color_direction = direction::horizontal;
 	};
 
 	struct rounding_props
@@ -796,7 +797,7 @@ namespace vekt
 	struct text_props
 	{
 		VEKT_STRING	  text	  = "";
-		font*		  font	  = nullptr;
+		font*		  fnt	  = nullptr;
 		unsigned char spacing = 0;
 		float		  scale	  = 1.0f;
 		uint64_t	  hash	  = 0;
@@ -982,7 +983,7 @@ namespace vekt
 		static inline uint64_t hash_text_props(const vekt::text_props& text, const VEKT_VEC4& color)
 		{
 			uint64_t h = std::hash<VEKT_STRING>{}(text.text);
-			h		   = hash_combine_64(h, std::hash<void*>{}(text.font));
+			h		   = hash_combine_64(h, std::hash<void*>{}(text.fnt));
 			h		   = hash_combine_64(h, std::hash<float>{}(text.scale));
 			h		   = hash_combine_64(h, std::hash<unsigned char>{}(text.spacing));
 			h		   = hash_combine_64(h, std::hash<float>{}(color.x));
@@ -2080,7 +2081,7 @@ namespace vekt
 			{
 				second_color_props& p = widget_get_second_color(widget);
 				second_color		  = p.color;
-				color_direction		  = p.direction;
+				color_direction		  = p.color_direction;
 				multi_color			  = true;
 			}
 
@@ -2855,16 +2856,16 @@ namespace vekt
 
 	void builder::add_text(const text_props& text, const VEKT_VEC4& color, const VEKT_VEC2& position, const VEKT_VEC2& size, unsigned int draw_order, void* user_data)
 	{
-		if (text.font == nullptr)
+		if (text.fnt == nullptr)
 		{
 			V_ERR("vekt::builder::add_text() -> No font is set!");
 			return;
 		}
 
-		draw_buffer* db = get_draw_buffer(draw_order, user_data, text.font);
+		draw_buffer* db = get_draw_buffer(draw_order, user_data, text.fnt);
 
-		const float pixel_scale = text.font->_scale;
-		const float subpixel	= text.font->type == font_type::lcd ? 3.0f : 1.0f;
+		const float pixel_scale = text.fnt->_scale;
+		const float subpixel	= text.fnt->type == font_type::lcd ? 3.0f : 1.0f;
 
 		const unsigned int start_vertices_idx = db->vertex_count;
 		const unsigned int start_indices_idx  = db->index_count;
@@ -2889,7 +2890,7 @@ namespace vekt
 		auto draw_char = [&](const glyph& g, unsigned long c, unsigned long previous_char) {
 			if (previous_char != 0)
 			{
-				pen.x += static_cast<float>(text.font->glyph_info[previous_char].kern_advance[c]) * scale;
+				pen.x += static_cast<float>(text.fnt->glyph_info[previous_char].kern_advance[c]) * scale;
 			}
 
 			const float quad_left	= pen.x + g.x_offset / subpixel * text.scale;
@@ -2947,7 +2948,7 @@ namespace vekt
 		for (c = (uint8_t*)cstr; *c; c++)
 		{
 			auto		 character = *c;
-			const glyph& ch		   = text.font->glyph_info[character];
+			const glyph& ch		   = text.fnt->glyph_info[character];
 			max_y_offset		   = math::max(max_y_offset, -ch.y_offset);
 		}
 		// pen.y += 10;
@@ -2957,7 +2958,7 @@ namespace vekt
 		for (c = (uint8_t*)cstr; *c; c++)
 		{
 			auto		 character = *c;
-			const glyph& ch		   = text.font->glyph_info[character];
+			const glyph& ch		   = text.fnt->glyph_info[character];
 			draw_char(ch, character, previous_char);
 			previous_char = character;
 		}
@@ -2965,13 +2966,13 @@ namespace vekt
 
 	void builder::add_text_cached(const text_props& text, const VEKT_VEC4& color, const VEKT_VEC2& position, const VEKT_VEC2& size, unsigned int draw_order, void* user_data)
 	{
-		if (text.font == nullptr)
+		if (text.fnt == nullptr)
 		{
 			V_ERR("vekt::builder::add_text() -> No font is set!");
 			return;
 		}
 
-		draw_buffer*   db	= get_draw_buffer(draw_order, user_data, text.font);
+		draw_buffer*   db	= get_draw_buffer(draw_order, user_data, text.fnt);
 		const uint64_t hash = text.hash == 0 ? text_cache::hash_text_props(text, color) : text.hash;
 		auto		   it	= _text_cache.find([hash](const text_cache& cache) -> bool { return cache.hash == hash; });
 		if (it != _text_cache.end())
@@ -2998,8 +2999,8 @@ namespace vekt
 			return;
 		}
 
-		const float pixel_scale = text.font->_scale;
-		const float subpixel	= text.font->type == font_type::lcd ? 3.0f : 1.0f;
+		const float pixel_scale = text.fnt->_scale;
+		const float subpixel	= text.fnt->type == font_type::lcd ? 3.0f : 1.0f;
 
 		const unsigned int start_vertices_idx = db->vertex_count;
 		const unsigned int start_indices_idx  = db->index_count;
@@ -3024,7 +3025,7 @@ namespace vekt
 		auto draw_char = [&](const glyph& g, unsigned long c, unsigned long previous_char) {
 			if (previous_char != 0)
 			{
-				pen.x += static_cast<float>(text.font->glyph_info[previous_char].kern_advance[c]) * scale;
+				pen.x += static_cast<float>(text.fnt->glyph_info[previous_char].kern_advance[c]) * scale;
 			}
 
 			const float quad_left	= pen.x + g.x_offset / subpixel * text.scale;
@@ -3082,7 +3083,7 @@ namespace vekt
 		for (c = (uint8_t*)cstr; *c; c++)
 		{
 			auto		 character = *c;
-			const glyph& ch		   = text.font->glyph_info[character];
+			const glyph& ch		   = text.fnt->glyph_info[character];
 			max_y_offset		   = math::max(max_y_offset, -ch.y_offset);
 		}
 
@@ -3092,7 +3093,7 @@ namespace vekt
 		for (c = (uint8_t*)cstr; *c; c++)
 		{
 			auto		 character = *c;
-			const glyph& ch		   = text.font->glyph_info[character];
+			const glyph& ch		   = text.fnt->glyph_info[character];
 			draw_char(ch, character, previous_char);
 			previous_char = character;
 		}
@@ -3127,13 +3128,13 @@ namespace vekt
 
 	VEKT_VEC2 builder::get_text_size(const text_props& text, const VEKT_VEC2& parent_size)
 	{
-		if (text.font == nullptr)
+		if (text.fnt == nullptr)
 		{
 			V_ERR("vekt::builder::get_text_size() -> No font is set!");
 			return VEKT_VEC2();
 		}
 
-		const font* fnt			= text.font;
+		const font* fnt			= text.fnt;
 		const float pixel_scale = fnt->_scale;
 
 		float total_x = 0.0f;
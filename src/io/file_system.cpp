@@ -2,6 +2,7 @@
 
 #include "file_system.hpp"
 #include "log.hpp"
+#include "mapped_file.hpp"
 #include "data/string_util.hpp"
 
 #include <filesystem>
@@ -206,21 +207,16 @@ namespace SFG
 
 	void file_system::read_file_as_vector(const char* filePath, vector<char>& vec)
 	{
-		std::ifstream file(filePath, std::ios::binary);
-		if (!file)
+		mapped_file file;
+		if (!file.open(filePath))
 		{
 			SFG_ERR("Could not open file! {0}", filePath);
 			return;
 		}
 
-		// Size
-		file.seekg(0, std::ios::end);
-		std::streampos length = file.tellg();
-		file.seekg(0, std::ios::beg);
-
-		// Into vec
-		vec = vector<char>(length);
-		file.read(&vec[0], length);
+		// empty files have no data, the range is empty as well.
+		const char* data = reinterpret_cast<const char*>(file.get_data());
+		vec.assign(data, data + file.get_size());
 	}
 
 	string file_system::get_running_directory()
@@ -3,6 +3,8 @@
 #include "log.hpp"
 #include "data/vector_util.hpp"
 #include "data/string.hpp"
+#include <cstdio>
+#include <charconv>
 
 #ifdef SFG_PLATFORM_WINDOWS
 #define WIN32_LEAN_AND_MEAN
@@ -11,12 +13,170 @@
 
 namespace SFG
 {
-	void log::log_impl(log_level level, const char* msg)
+	namespace
 	{
+		void append_arg(const log_entry& e, const log_arg& arg, std::string& out)
+		{
+			char		buffer[32];
+			char* const end = buffer + sizeof(buffer);
+
+			switch (arg.type)
+			{
+			case log_arg_type::int64:
+				out.append(buffer, std::to_chars(buffer, end, arg.i).ptr);
+				break;
+			case log_arg_type::uint64:
+				out.append(buffer, std::to_chars(buffer, end, arg.u).ptr);
+				break;
+			case log_arg_type::float64: {
+				std::ostringstream oss;
+				oss << arg.d;
+				out += oss.str();
+				break;
+			}
+			case log_arg_type::boolean:
+				out += arg.u ? "1" : "0";
+				break;
+			case log_arg_type::character:
+				out += static_cast<char>(arg.u);
+				break;
+			case log_arg_type::text:
+				out.append(e.text + arg.text_offset, arg.text_size);
+				break;
+			}
+		}
+	}
+
+	log::log()
+	{
+		_thread = std::thread([this] { run(); });
+	}
+
+	log::~log()
+	{
+		flush();
+		_running.store(false, std::memory_order_release);
+		wake();
+		if (_thread.joinable())
+			_thread.join();
+		set_file(nullptr);
+	}
+
+	void log::run()
+	{
+		std::string message;
+		message.reserve(512);
+
+		for (;;)
+		{
+			bool popped = false;
+			while (_queue.try_pop([&](log_entry& e) { dispatch(e, message); }))
+			{
+				_dispatched.fetch_add(1, std::memory_order_release);
+				popped = true;
+			}
+
+			if (popped)
+				continue;
+
+			if (!_running.load(std::memory_order_acquire))
+				break;
+
+			// anything pushed after this point either gets popped below or wakes us up through the signal.
+			const uint32 signal = _signal.load(std::memory_order_acquire);
+			_sleeping.store(true, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			if (_queue.try_pop([&](log_entry& e) { dispatch(e, message); }))
+			{
+				_dispatched.fetch_add(1, std::memory_order_release);
+				_sleeping.store(false, std::memory_order_relaxed);
+				continue;
+			}
+
+			if (_running.load(std::memory_order_acquire))
+				_signal.wait(signal, std::memory_order_acquire);
+			_sleeping.store(false, std::memory_order_relaxed);
+		}
+	}
+
+	void log::wake()
+	{
+		_signal.fetch_add(1, std::memory_order_release);
+		_signal.notify_one();
+	}
+
+	void log::flush()
+	{
+		// a listener logging an error would otherwise wait on itself.
+		if (std::this_thread::get_id() == _thread.get_id())
+			return;
+
+		const size_t target = _queue.get_enqueue_position();
+		while (_dispatched.load(std::memory_order_acquire) < target)
+			std::this_thread::yield();
+	}
+
+	void log::dispatch(const log_entry& e, std::string& out)
+	{
+		if (!is_level_enabled(e.level))
+			return;
+
+		const std::string_view format = e.format ? std::string_view(e.format) : std::string_view(e.text + e.format_offset, e.format_size);
+
+		out.clear();
+		out += "[";
+		out += get_level(e.level);
+		out += "] ";
+		const size_t msg_start = out.size();
+
+		size_t i = 0;
+		while (i < format.size())
+		{
+			if (format[i] == '{')
+			{
+				const size_t end = format.find('}', i);
+				if (end != std::string_view::npos)
+				{
+					const std::string_view index_str = format.substr(i + 1, end - i - 1);
+					uint32				   index	 = 0;
+					const auto			   res		 = std::from_chars(index_str.data(), index_str.data() + index_str.size(), index);
+
+					// keep the original text for invalid or out of bounds indices.
+					if (res.ec == std::errc() && res.ptr == index_str.data() + index_str.size() && index < e.arg_count)
+						append_arg(e, e.args[index], out);
+					else
+						out.append(format.data() + i, end - i + 1);
+
+					i = end + 1;
+					continue;
+				}
+			}
+			out += format[i++];
+		}
+
+		out += "\n";
+		if (_console.load(std::memory_order_relaxed))
+			write_console(e.level, out.c_str());
+
 		LOCK_GUARD(_mtx);
 
-		const string msgStr = "[" + string(get_level(level)) + "] " + msg + "\n";
+		if (_file)
+		{
+			std::fwrite(out.data(), 1, out.size(), _file);
+			std::fflush(_file);
+		}
+
+		// listeners get the message without the level prefix or the line break.
+		out.pop_back();
+		const char* msg = out.c_str() + msg_start;
+
+		for (const listener& l : _listeners)
+			l.f(e.level, msg);
+	}
 
+	void log::write_console(log_level level, const char* msg)
+	{
 #ifdef SFG_PLATFORM_WINDOWS
 		HANDLE hConsole;
 		int	   color = 15;
@@ -34,36 +194,50 @@ namespace SFG
 
 		hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
 		SetConsoleTextAttribute(hConsole, color);
-		WriteConsole(GetStdHandle(STD_OUTPUT_HANDLE), msgStr.c_str(), static_cast<DWORD>(strlen(msgStr.c_str())), NULL, NULL);
+		WriteConsole(GetStdHandle(STD_OUTPUT_HANDLE), msg, static_cast<DWORD>(strlen(msg)), NULL, NULL);
 #else
-		std::cout << msgStr.c_str();
+		std::cout << msg;
 #endif
-
-		/*
-				ostream		stream;
-				const uint8 dt		  = (uint8)pipe_data_type::log;
-				const uint8 log_level = (uint8)level;
-				stream << dt;
-				stream << level;
-				stream.write_raw((uint8*)msg, strlen(msg));
-				process::send_pipe_data(stream.get_raw(), stream.get_size());
-				stream.destroy();
-		*/
-
-		for (const listener& l : _listeners)
-			l.f(level, msg);
 	}
 
 	void log::add_listener(unsigned int id, callback_function f)
 	{
+		LOCK_GUARD(_mtx);
 		_listeners.push_back({.id = id, .f = f});
 	}
 
 	void log::remove_listener(unsigned int id)
 	{
+		// make sure nothing logged so far is still on its way to this listener.
+		flush();
+		LOCK_GUARD(_mtx);
 		std::erase_if(_listeners, [id](const listener& l) -> bool { return l.id == id; });
 	}
 
+	void log::set_file(const char* path)
+	{
+		flush();
+		LOCK_GUARD(_mtx);
+
+		if (_file)
+		{
+			std::fclose(_file);
+			_file = nullptr;
+		}
+
+		if (path)
+			_file = std::fopen(path, "w");
+	}
+
+	void log::set_level_enabled(log_level level, bool enabled)
+	{
+		const uint32 bit = 1u << static_cast<uint32>(level);
+		if (enabled)
+			_level_mask.fetch_or(bit, std::memory_order_relaxed);
+		else
+			_level_mask.fetch_and(~bit, std::memory_order_relaxed);
+	}
+
 	const char* log::get_level(log_level level)
 	{
 		switch (level)
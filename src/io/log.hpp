@@ -22,13 +22,21 @@
 
 #endif
 
+#include "common/size_definitions.hpp"
 #include "data/mutex.hpp"
+#include "data/atomic.hpp"
 #include "memory/malloc_allocator_stl.hpp"
 #include "data/vector.hpp"
+#include "thread/mpmc_queue.hpp"
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <functional>
+#include <thread>
+#include <type_traits>
+#include <cstring>
+#include <cstdio>
 
 namespace SFG
 {
@@ -41,6 +49,52 @@ namespace SFG
 		progress,
 	};
 
+#define LOG_QUEUE_CAPACITY 1024
+#define LOG_MAX_ARGS	   8
+#define LOG_TEXT_SIZE	   352
+
+	enum class log_arg_type : uint8
+	{
+		int64,
+		uint64,
+		float64,
+		boolean,
+		character,
+		text,
+	};
+
+	struct log_arg
+	{
+		union {
+			int64  i;
+			uint64 u;
+			double d;
+			uint32 text_offset;
+		};
+		uint16		 text_size = 0;
+		log_arg_type type	   = log_arg_type::int64;
+	};
+
+	/*
+		What producers push: the format pointer (literals are not copied) plus raw arguments.
+		Strings and anything that is not a plain number are copied into text.
+	*/
+	struct log_entry
+	{
+		const char* format		  = nullptr;
+		log_arg		args[LOG_MAX_ARGS];
+		uint16		format_offset = 0;
+		uint16		format_size	  = 0;
+		uint16		text_size	  = 0;
+		uint8		arg_count	  = 0;
+		log_level	level		  = log_level::info;
+		char		text[LOG_TEXT_SIZE];
+	};
+
+	/*
+		Callers only fill a ring entry, a background thread formats ({N} placeholders), filters and dispatches to console, file and listeners.
+		Listeners are invoked from the log thread. Errors (SFG_ERR, SFG_FATAL) are flushed before log_msg returns.
+	*/
 	class log
 	{
 	public:
@@ -56,53 +110,8 @@ namespace SFG
 			return log;
 		}
 
-		// Helper to convert various types to string
-		template <typename T> std::string to_str(const T& value)
-		{
-			std::ostringstream oss;
-			oss << value;
-			return oss.str();
-		}
-
-		template <typename... Args> std::string format_str(const std::string& format, const Args&... args)
-		{
-			std::vector<std::string> argList{to_str(args)...}; // Convert args to strings
-			std::ostringstream		 result;
-			size_t					 i = 0;
-
-			while (i < format.size())
-			{
-				if (format[i] == '{')
-				{
-					size_t end = format.find('}', i);
-					if (end != std::string::npos)
-					{
-						std::string indexStr = format.substr(i + 1, end - i - 1);
-						try
-						{
-							size_t index = std::stoul(indexStr);
-							if (index < argList.size())
-							{
-								result << argList[index]; // Replace with corresponding argument
-							}
-							else
-							{
-								result << "{" << indexStr << "}"; // Keep original if out of bounds
-							}
-						}
-						catch (...)
-						{
-							result << "{" << indexStr << "}"; // Handle invalid indices
-						}
-						i = end + 1;
-						continue;
-					}
-				}
-				result << format[i++];
-			}
-
-			return result.str();
-		}
+		log();
+		~log();
 
 		/// <summary>
 		///
@@ -110,14 +119,62 @@ namespace SFG
 		/// <typeparam name="...Args"></typeparam>
 		/// <param name="level"></param>
 		/// <param name="...args"></param>
-		template <typename... Args> void log_msg(log_level level, const Args&... args)
+		template <typename Format, typename... Args> void log_msg(log_level level, Format&& format, const Args&... args)
 		{
-			log_impl(level, format_str(args...).c_str());
+			typedef std::remove_reference_t<Format> format_type;
+
+			static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "Too many log arguments!");
+
+			if (!is_level_enabled(level))
+				return;
+
+			push_entry([&](log_entry& e) {
+				e.level		= level;
+				e.text_size = 0;
+				e.arg_count = 0;
+
+				// const char arrays are taken to be string literals and kept as pointers, everything else (mutable buffers included) gets copied.
+				if constexpr (std::is_array_v<format_type> && std::is_same_v<std::remove_extent_t<format_type>, const char>)
+				{
+					e.format	  = format;
+					e.format_size = 0;
+				}
+				else
+				{
+					const std::string_view fmt = to_view(format);
+					e.format				   = nullptr;
+					e.format_offset			   = e.text_size;
+					e.format_size			   = copy_text(e, fmt.data(), fmt.size());
+				}
+
+				(encode_arg(e, args), ...);
+			});
+
+			// errors may be the last thing before a crash, make sure they are out.
+			if (level == log_level::error)
+				flush();
 		}
 
+		/// Blocks until everything logged before the call has been dispatched, no-op on the log thread itself.
+		void flush();
+
 		void add_listener(unsigned int id, callback_function f);
 		void remove_listener(unsigned int id);
 
+		/// Mirrors dispatched messages into a file, nullptr closes it.
+		void set_file(const char* path);
+		void set_level_enabled(log_level level, bool enabled);
+
+		inline void set_console_enabled(bool enabled)
+		{
+			_console.store(enabled, std::memory_order_relaxed);
+		}
+
+		inline bool is_level_enabled(log_level level) const
+		{
+			return (_level_mask.load(std::memory_order_relaxed) & (1u << static_cast<uint32>(level))) != 0;
+		}
+
 	private:
 		struct listener
 		{
@@ -126,13 +183,102 @@ namespace SFG
 		};
 
 	private:
+		template <typename F> inline void push_entry(F&& fill)
+		{
+			// full ring means the log thread is behind, wait instead of dropping messages.
+			while (!_queue.try_push(fill))
+				std::this_thread::yield();
+
+			// pairs with the fence in run(), either the log thread sees the entry or we see it sleeping.
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (_sleeping.load(std::memory_order_relaxed))
+				wake();
+		}
+
+		template <typename T> static std::string_view to_view(const T& value)
+		{
+			if constexpr (std::is_convertible_v<const T&, std::string_view>)
+				return std::string_view(value);
+			else
+				return std::string_view(static_cast<const char*>(value));
+		}
+
+		static uint16 copy_text(log_entry& e, const char* data, size_t size)
+		{
+			const size_t available = static_cast<size_t>(LOG_TEXT_SIZE) - e.text_size;
+			const size_t sz		   = size < available ? size : available;
+			std::memcpy(e.text + e.text_size, data, sz);
+			e.text_size += static_cast<uint16>(sz);
+			return static_cast<uint16>(sz);
+		}
+
+		template <typename T> static void encode_arg(log_entry& e, const T& value)
+		{
+			log_arg& arg = e.args[e.arg_count++];
+
+			if constexpr (std::is_same_v<T, bool>)
+			{
+				arg.type = log_arg_type::boolean;
+				arg.u	 = value ? 1 : 0;
+			}
+			else if constexpr (std::is_same_v<T, char>)
+			{
+				arg.type = log_arg_type::character;
+				arg.u	 = static_cast<uint64>(value);
+			}
+			else if constexpr (std::is_floating_point_v<T>)
+			{
+				arg.type = log_arg_type::float64;
+				arg.d	 = static_cast<double>(value);
+			}
+			else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+			{
+				arg.type = log_arg_type::int64;
+				arg.i	 = static_cast<int64>(value);
+			}
+			else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+			{
+				arg.type = log_arg_type::uint64;
+				arg.u	 = static_cast<uint64>(value);
+			}
+			else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+			{
+				const std::string_view sv = value;
+				arg.type				  = log_arg_type::text;
+				arg.text_offset			  = e.text_size;
+				arg.text_size			  = copy_text(e, sv.data(), sv.size());
+			}
+			else
+			{
+				// slow path, types that only know operator<<.
+				std::ostringstream oss;
+				oss << value;
+				const std::string str = oss.str();
+				arg.type			  = log_arg_type::text;
+				arg.text_offset		  = e.text_size;
+				arg.text_size		  = copy_text(e, str.data(), str.size());
+			}
+		}
+
+		void run();
+		void wake();
+		void dispatch(const log_entry& e, std::string& out);
+		void write_console(log_level level, const char* msg);
 		const char* get_level(log_level lvl);
-		void		log_impl(log_level level, const char* msg);
 
 	private:
 		template <typename T> using vector_malloc = std::vector<T, malloc_allocator_stl<T>>;
 
-		mutex					_mtx;
-		vector_malloc<listener> _listeners;
+		mpmc_queue<log_entry, LOG_QUEUE_CAPACITY> _queue;
+		mutex									  _mtx;
+		vector_malloc<listener>					  _listeners;
+		std::thread								  _thread;
+		std::FILE*								  _file		  = nullptr;
+		atomic<size_t>							  _dispatched = 0;
+		atomic<uint32>							  _level_mask = 0xFFFFFFFF;
+		atomic<uint32>							  _signal	  = 0;
+		atomic<bool>							  _sleeping	  = false;
+		atomic<bool>							  _console	  = true;
+		atomic<bool>							  _running	  = true;
 	};
 }
@@ -0,0 +1,132 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "mapped_file.hpp"
+#include "log.hpp"
+
+#ifdef SFG_PLATFORM_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace SFG
+{
+	mapped_file::~mapped_file()
+	{
+		close();
+	}
+
+	bool mapped_file::open(const char* path)
+	{
+		close();
+
+#ifdef SFG_PLATFORM_WINDOWS
+		HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			SFG_ERR("[mapped_file] -> Could not open file! {0}", path);
+			return false;
+		}
+
+		LARGE_INTEGER size = {};
+		if (!GetFileSizeEx(file, &size))
+		{
+			SFG_ERR("[mapped_file] -> Unreadable file! {0}", path);
+			CloseHandle(file);
+			return false;
+		}
+
+		// empty files can't be mapped, they open with no data.
+		if (size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return true;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping == NULL)
+		{
+			SFG_ERR("[mapped_file] -> Could not create mapping! {0}", path);
+			CloseHandle(file);
+			return false;
+		}
+
+		void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (view == nullptr)
+		{
+			SFG_ERR("[mapped_file] -> Could not map file! {0}", path);
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		_file	 = file;
+		_mapping = mapping;
+		_data	 = static_cast<uint8*>(view);
+		_size	 = static_cast<size_t>(size.QuadPart);
+#else
+		const int fd = ::open(path, O_RDONLY);
+		if (fd == -1)
+		{
+			SFG_ERR("[mapped_file] -> Could not open file! {0}", path);
+			return false;
+		}
+
+		struct stat st = {};
+		if (fstat(fd, &st) != 0)
+		{
+			SFG_ERR("[mapped_file] -> Unreadable file! {0}", path);
+			::close(fd);
+			return false;
+		}
+
+		// empty files can't be mapped, they open with no data.
+		if (st.st_size == 0)
+		{
+			::close(fd);
+			return true;
+		}
+
+		void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+		// the mapping keeps its own reference to the file.
+		::close(fd);
+
+		if (view == MAP_FAILED)
+		{
+			SFG_ERR("[mapped_file] -> Could not map file! {0}", path);
+			return false;
+		}
+
+		madvise(view, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+		_data = static_cast<uint8*>(view);
+		_size = static_cast<size_t>(st.st_size);
+#endif
+
+		return true;
+	}
+
+	void mapped_file::close()
+	{
+		if (_data == nullptr)
+			return;
+
+#ifdef SFG_PLATFORM_WINDOWS
+		UnmapViewOfFile(_data);
+		CloseHandle(static_cast<HANDLE>(_mapping));
+		CloseHandle(static_cast<HANDLE>(_file));
+		_mapping = nullptr;
+		_file	 = nullptr;
+#else
+		munmap(_data, _size);
+#endif
+
+		_data = nullptr;
+		_size = 0;
+	}
+}
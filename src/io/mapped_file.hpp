@@ -0,0 +1,51 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+
+namespace SFG
+{
+	/*
+		Read-only memory mapping of a whole file, mmap on posix, CreateFileMapping/MapViewOfFile on Windows.
+		Pages are faulted in on first access, nothing is copied until someone reads the bytes.
+	*/
+	class mapped_file
+	{
+	public:
+		mapped_file() = default;
+		~mapped_file();
+
+		mapped_file(const mapped_file& other)			 = delete;
+		mapped_file& operator=(const mapped_file& other) = delete;
+
+		/// Empty files open successfully with no data & a size of 0.
+		bool open(const char* path);
+		void close();
+
+		inline const uint8* get_data() const
+		{
+			return _data;
+		}
+
+		inline size_t get_size() const
+		{
+			return _size;
+		}
+
+		/// False for empty files as well, nothing is mapped for them.
+		inline bool is_open() const
+		{
+			return _data != nullptr;
+		}
+
+	private:
+		uint8* _data = nullptr;
+		size_t _size = 0;
+
+#ifdef SFG_PLATFORM_WINDOWS
+		void* _file	   = nullptr;
+		void* _mapping = nullptr;
+#endif
+	};
+}
@@ -2,6 +2,7 @@
 
 #include "aabb.hpp"
 #include "plane.hpp"
+#include "matrix4x3.hpp"
 #include "math/math.hpp"
 #include "data/ostream.hpp"
 #include "data/istream.hpp"
@@ -38,6 +39,17 @@ namespace SFG
 		return negative;
 	}
 
+	aabb aabb::transform(const matrix4x3& m) const
+	{
+		// center goes through the full transform, extents through the absolute linear part.
+		const vector3 center = m * ((bounds_min + bounds_max) * 0.5f);
+		const vector3 extent = (bounds_max - bounds_min) * 0.5f;
+		const vector3 e		 = vector3(math::abs(m[0]) * extent.x + math::abs(m[3]) * extent.y + math::abs(m[6]) * extent.z,
+									   math::abs(m[1]) * extent.x + math::abs(m[4]) * extent.y + math::abs(m[7]) * extent.z,
+									   math::abs(m[2]) * extent.x + math::abs(m[5]) * extent.y + math::abs(m[8]) * extent.z);
+		return aabb(center - e, center + e);
+	}
+
 	void aabb::remove(const aabb& other)
 	{
 		bounds_min -= other.bounds_min;
@@ -5,6 +5,7 @@
 namespace SFG
 {
 	struct plane;
+	class matrix4x3;
 
 	class ostream;
 	class istream;
@@ -27,6 +28,7 @@ namespace SFG
 		bool	is_inside_plane(const vector3& center, const plane& plane);
 		vector3 get_positive(const vector3& normal) const;
 		vector3 get_negative(const vector3& normal) const;
+		aabb	transform(const matrix4x3& m) const;
 
 		void remove(const aabb& other);
 		void add(const aabb& other);
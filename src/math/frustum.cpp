@@ -14,7 +14,10 @@ namespace SFG
 			const vector3 normal = p.normal;
 
 			if (vector3::dot(normal, other.get_positive(normal)) + pos < 0.0f)
-				test = frustum_result ::outside;
+			{
+				test = frustum_result::outside;
+				return;
+			}
 
 			if (vector3::dot(normal, other.get_negative(normal)) + pos < 0.0f)
 				test = frustum_result::intersects;
@@ -47,16 +50,19 @@ namespace SFG
 
 	frustum frustum::extract(const matrix4x4& m)
 	{
+		// rows of the view projection give n.p + w >= 0 inside, planes keep n.p - distance so w is negated.
+		// depth range is 0-1, near plane is the z row alone.
 		frustum fr = {};
-		fr.left	   = plane(m[3] + m[0], m[7] + m[4], m[11] + m[8], m[15] + m[12]);
-		fr.right   = plane(m[3] - m[0], m[7] - m[4], m[11] - m[8], m[15] - m[12]);
-		fr.bottom  = plane(m[3] + m[1], m[7] + m[5], m[11] + m[9], m[15] + m[13]);
-		fr.top	   = plane(m[3] - m[1], m[7] - m[5], m[11] - m[9], m[15] - m[13]);
-		fr.near	   = plane(m[3] + m[2], m[7] + m[6], m[11] + m[10], m[15] + m[14]);
-		fr.far	   = plane(m[3] - m[2], m[7] - m[6], m[11] - m[10], m[15] - m[14]);
+		fr.left	   = plane(m[3] + m[0], m[7] + m[4], m[11] + m[8], -(m[15] + m[12]));
+		fr.right   = plane(m[3] - m[0], m[7] - m[4], m[11] - m[8], -(m[15] - m[12]));
+		fr.bottom  = plane(m[3] + m[1], m[7] + m[5], m[11] + m[9], -(m[15] + m[13]));
+		fr.top	   = plane(m[3] - m[1], m[7] - m[5], m[11] - m[9], -(m[15] - m[13]));
+		fr.near	   = plane(m[2], m[6], m[10], -m[14]);
+		fr.far	   = plane(m[3] - m[2], m[7] - m[6], m[11] - m[10], -(m[15] - m[14]));
 		fr.left.normalize();
 		fr.right.normalize();
 		fr.bottom.normalize();
+		fr.top.normalize();
 		fr.near.normalize();
 		fr.far.normalize();
 		return fr;
@@ -16,7 +16,7 @@ namespace SFG
 
 		template <typename T> inline T copysign(T number, T sign)
 		{
-			return std::copysignf(number, sign);
+			return std::copysign(number, sign);
 		}
 
 		template <typename T> inline T clamp(T value, T min_val, T max_val)
@@ -108,11 +108,11 @@ namespace SFG
 		}
 		inline float sqrt(float value)
 		{
-			return std::sqrtf(value);
+			return std::sqrt(value);
 		}
 		inline float tan(float value)
 		{
-			return std::tanf(value);
+			return std::tan(value);
 		}
 	}
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "math/math_common.hpp"
 
 #include "memory/memory_tracer.hpp"
+#include <bit>
 
 namespace SFG
 {
@@ -15,18 +16,21 @@ namespace SFG
 			uninit();
 	}
 
-	void chunk_allocator32::init(size_t size)
+	void chunk_allocator32::init(size_t size, bool zero_memory)
 	{
 		const size_t alignment = alignof(uint32);
 		SFG_ASSERT(size % alignment == 0);
 
 		const size_t mem_size = ALIGN_UP(size, alignment);
 		_raw				  = reinterpret_cast<uint8*>(SFG_ALIGNED_MALLOC(alignment, mem_size));
-		_total_size			  = mem_size;
+		_total_size			  = static_cast<uint32>(mem_size);
+		_zero_memory		  = zero_memory;
 
 #ifdef ENABLE_MEMORY_TRACER
 		memory_tracer::get().on_allocation(_raw, mem_size);
 #endif
+
+		reset();
 	}
 
 	void chunk_allocator32::uninit()
@@ -38,11 +42,283 @@ namespace SFG
 		SFG_ASSERT(_raw != nullptr);
 		SFG_ALIGNED_FREE(_raw);
 		_raw = nullptr;
+
+		_blocks.clear();
+		_dead_blocks.clear();
 	}
 
 	void chunk_allocator32::reset()
 	{
-		_free_chunks.resize(0);
-		_head = 0;
+		_blocks.resize(0);
+		_dead_blocks.resize(0);
+
+		for (uint32 fl = 0; fl < FL_COUNT; fl++)
+		{
+			_sl_bitmap[fl] = 0;
+			for (uint32 sl = 0; sl < SL_COUNT; sl++)
+				_free_heads[fl][sl] = NULL_BLOCK;
+		}
+
+		_fl_bitmap		  = 0;
+		_head			  = 0;
+		_used_size		  = 0;
+		_used_block_count = 0;
+		_free_block_count = 0;
+
+		if (_total_size != 0)
+			insert_free(create_block(0, _total_size));
+	}
+
+	void chunk_allocator32::free(chunk_handle32 handle)
+	{
+		SFG_ASSERT(handle.size != 0);
+
+		uint32 index = handle.block;
+		SFG_ASSERT(index < _blocks.size() && _blocks[index].offset == handle.head && !_blocks[index].is_free);
+
+		_used_size -= _blocks[index].size;
+		_used_block_count--;
+
+		// merge with previous
+		const uint32 prev = _blocks[index].prev_phys;
+		if (prev != NULL_BLOCK && _blocks[prev].is_free)
+		{
+			remove_free(prev);
+
+			const uint32 next		= _blocks[index].next_phys;
+			_blocks[prev].size	   += _blocks[index].size;
+			_blocks[prev].next_phys = next;
+			if (next != NULL_BLOCK)
+				_blocks[next].prev_phys = prev;
+
+			destroy_block(index);
+			index = prev;
+		}
+
+		// merge with next
+		const uint32 next = _blocks[index].next_phys;
+		if (next != NULL_BLOCK && _blocks[next].is_free)
+		{
+			remove_free(next);
+
+			const uint32 next_next	 = _blocks[next].next_phys;
+			_blocks[index].size		+= _blocks[next].size;
+			_blocks[index].next_phys = next_next;
+			if (next_next != NULL_BLOCK)
+				_blocks[next_next].prev_phys = index;
+
+			destroy_block(next);
+		}
+
+		insert_free(index);
+	}
+
+	chunk_allocator_stats chunk_allocator32::get_stats() const
+	{
+		chunk_allocator_stats stats = {
+			.total_size		  = _total_size,
+			.used_size		  = _used_size,
+			.free_size		  = _total_size - _used_size,
+			.used_block_count = _used_block_count,
+			.free_block_count = _free_block_count,
+		};
+
+		if (_fl_bitmap != 0)
+		{
+			// largest block can only be in the highest non-empty bin.
+			const uint32 fl = 31 - std::countl_zero(_fl_bitmap);
+			const uint32 sl = 31 - std::countl_zero(_sl_bitmap[fl]);
+
+			for (uint32 index = _free_heads[fl][sl]; index != NULL_BLOCK; index = _blocks[index].next_free)
+				stats.largest_free_block = _blocks[index].size > stats.largest_free_block ? _blocks[index].size : stats.largest_free_block;
+		}
+
+		if (stats.free_size != 0)
+			stats.fragmentation = 1.0f - static_cast<float>(stats.largest_free_block) / static_cast<float>(stats.free_size);
+
+		return stats;
+	}
+
+	chunk_handle32 chunk_allocator32::allocate_aligned(uint32 size, uint32 alignment)
+	{
+		const uint32 search_size = alignment > 1 ? size + alignment - 1 : size;
+
+		uint32 index = find_free(search_size);
+		SFG_ASSERT(index != NULL_BLOCK);
+		if (index == NULL_BLOCK)
+			return {};
+
+		remove_free(index);
+
+		const uint32 offset			= _blocks[index].offset;
+		const uint32 aligned_offset = ALIGN_UP(offset, alignment);
+
+		// pre-chunk split, previous physical block is never free so no merge needed.
+		if (aligned_offset > offset)
+		{
+			const uint32 aligned = split(index, aligned_offset - offset);
+			insert_free(index);
+			index = aligned;
+		}
+
+		// post-chunk split
+		if (_blocks[index].size > size)
+			insert_free(split(index, size));
+
+		_used_size += size;
+		_used_block_count++;
+
+		if (aligned_offset + size > _head)
+			_head = aligned_offset + size;
+
+		return {.head = aligned_offset, .size = size, .block = index};
+	}
+
+	uint32 chunk_allocator32::create_block(uint32 offset, uint32 size)
+	{
+		uint32 index = 0;
+
+		if (!_dead_blocks.empty())
+		{
+			index = _dead_blocks.back();
+			_dead_blocks.pop_back();
+		}
+		else
+		{
+			index = static_cast<uint32>(_blocks.size());
+			_blocks.push_back({});
+		}
+
+		_blocks[index] = {.offset = offset, .size = size};
+		return index;
+	}
+
+	void chunk_allocator32::destroy_block(uint32 index)
+	{
+		_dead_blocks.push_back(index);
+	}
+
+	void chunk_allocator32::insert_free(uint32 index)
+	{
+		block& b = _blocks[index];
+
+		uint32 fl = 0, sl = 0;
+		mapping_insert(b.size, fl, sl);
+
+		const uint32 head = _free_heads[fl][sl];
+		b.is_free		  = 1;
+		b.prev_free		  = NULL_BLOCK;
+		b.next_free		  = head;
+
+		if (head != NULL_BLOCK)
+			_blocks[head].prev_free = index;
+
+		_free_heads[fl][sl] = index;
+		_sl_bitmap[fl] |= 1u << sl;
+		_fl_bitmap |= 1u << fl;
+		_free_block_count++;
+	}
+
+	void chunk_allocator32::remove_free(uint32 index)
+	{
+		block& b = _blocks[index];
+
+		uint32 fl = 0, sl = 0;
+		mapping_insert(b.size, fl, sl);
+
+		if (b.prev_free != NULL_BLOCK)
+			_blocks[b.prev_free].next_free = b.next_free;
+		if (b.next_free != NULL_BLOCK)
+			_blocks[b.next_free].prev_free = b.prev_free;
+
+		if (_free_heads[fl][sl] == index)
+		{
+			_free_heads[fl][sl] = b.next_free;
+
+			if (b.next_free == NULL_BLOCK)
+			{
+				_sl_bitmap[fl] &= ~(1u << sl);
+				if (_sl_bitmap[fl] == 0)
+					_fl_bitmap &= ~(1u << fl);
+			}
+		}
+
+		b.is_free	= 0;
+		b.prev_free = NULL_BLOCK;
+		b.next_free = NULL_BLOCK;
+		_free_block_count--;
+	}
+
+	uint32 chunk_allocator32::find_free(uint32 size)
+	{
+		uint32 fl = 0, sl = 0;
+		mapping_search(size, fl, sl);
+
+		if (fl >= FL_COUNT)
+			return NULL_BLOCK;
+
+		uint32 sl_map = _sl_bitmap[fl] & (~0u << sl);
+
+		if (sl_map == 0)
+		{
+			const uint32 fl_map = _fl_bitmap & (~0u << (fl + 1));
+			if (fl_map == 0)
+				return NULL_BLOCK;
+
+			fl	   = std::countr_zero(fl_map);
+			sl_map = _sl_bitmap[fl];
+		}
+
+		sl = std::countr_zero(sl_map);
+		return _free_heads[fl][sl];
+	}
+
+	uint32 chunk_allocator32::split(uint32 index, uint32 size)
+	{
+		SFG_ASSERT(_blocks[index].size > size);
+
+		const uint32 remaining = create_block(_blocks[index].offset + size, _blocks[index].size - size);
+		const uint32 next	   = _blocks[index].next_phys;
+
+		_blocks[remaining].prev_phys = index;
+		_blocks[remaining].next_phys = next;
+		if (next != NULL_BLOCK)
+			_blocks[next].prev_phys = remaining;
+
+		_blocks[index].next_phys = remaining;
+		_blocks[index].size		 = size;
+		return remaining;
+	}
+
+	void chunk_allocator32::mapping_insert(uint32 size, uint32& fl, uint32& sl)
+	{
+		if (size < SL_COUNT)
+		{
+			fl = 0;
+			sl = size;
+			return;
+		}
+
+		const uint32 log2 = 31 - std::countl_zero(size);
+		sl				  = (size >> (log2 - SL_LOG2)) ^ SL_COUNT;
+		fl				  = log2 - SL_LOG2 + 1;
+	}
+
+	void chunk_allocator32::mapping_search(uint32 size, uint32& fl, uint32& sl)
+	{
+		// round up to the next class so any block in the found bin fits.
+		if (size >= SL_COUNT)
+		{
+			const uint32 log2  = 31 - std::countl_zero(size);
+			const uint32 round = (1u << (log2 - SL_LOG2)) - 1;
+			if (size > 0xFFFFFFFF - round)
+			{
+				fl = FL_COUNT;
+				return;
+			}
+			size += round;
+		}
+
+		mapping_insert(size, fl, sl);
 	}
 }
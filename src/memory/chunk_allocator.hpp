@@ -9,16 +9,50 @@
 #include "data/vector_util.hpp"
 #include "math/math_common.hpp"
 #include "memory.hpp"
+#include <type_traits>
 
 namespace SFG
 {
+	struct chunk_allocator_stats
+	{
+		uint32 total_size		  = 0;
+		uint32 used_size		  = 0;
+		uint32 free_size		  = 0;
+		uint32 largest_free_block = 0;
+		uint32 used_block_count	  = 0;
+		uint32 free_block_count	  = 0;
+
+		// 0 when all free memory is a single block, approaches 1 as it gets scattered.
+		float fragmentation = 0.0f;
+	};
 
+	/*
+		Two level segregated fit allocator, allocate & free are O(1).
+		Block bookkeeping lives outside of the managed memory, handles carry their block index next to the offset.
+	*/
 	class chunk_allocator32
 	{
+	private:
+		static constexpr uint32 SL_LOG2	   = 4;
+		static constexpr uint32 SL_COUNT   = 1 << SL_LOG2;
+		static constexpr uint32 FL_COUNT   = 32 - SL_LOG2 + 1;
+		static constexpr uint32 NULL_BLOCK = 0xFFFFFFFF;
+
+		struct block
+		{
+			uint32 offset	 = 0;
+			uint32 size		 = 0;
+			uint32 prev_phys = NULL_BLOCK;
+			uint32 next_phys = NULL_BLOCK;
+			uint32 prev_free = NULL_BLOCK;
+			uint32 next_free = NULL_BLOCK;
+			uint8  is_free	 = 0;
+		};
+
 	public:
 		~chunk_allocator32();
 
-		void init(size_t total_size);
+		void init(size_t total_size, bool zero_memory = true);
 		void uninit();
 		void reset();
 
@@ -26,97 +60,29 @@ namespace SFG
 		{
 			SFG_ASSERT(count != 0);
 
-			const size_t item_alignment	  = alignof(T);
-			const size_t padded_item_size = ALIGN_UP(sizeof(T), item_alignment);
-			const uint32 requested_size	  = static_cast<uint32>(padded_item_size * count);
+			const size_t		 item_alignment	  = alignof(T);
+			const size_t		 padded_item_size = ALIGN_UP(sizeof(T), item_alignment);
+			const uint32		 requested_size	  = static_cast<uint32>(padded_item_size * count);
+			const chunk_handle32 handle			  = allocate_aligned(requested_size, static_cast<uint32>(item_alignment));
 
-			if (!_free_chunks.empty())
+			if (_zero_memory)
 			{
-				for (auto it = _free_chunks.begin(); it != _free_chunks.end(); ++it)
+				if constexpr (std::is_trivially_default_constructible_v<T>)
+					SFG_MEMSET(_raw + handle.head, 0, handle.size);
+				else
 				{
-					const chunk_handle32 chunk = *it;
-
-					const uint32 aligned_head		 = ALIGN_UP(chunk.head, item_alignment);
-					const uint32 aligned_size_needed = (aligned_head - chunk.head) + requested_size;
-
-					if (chunk.size >= aligned_size_needed)
-					{
-						_free_chunks.erase(it);
-
-						const chunk_handle32 allocated_chunk = {.head = aligned_head, .size = requested_size};
-
-						// pre-chunk split.
-						if (aligned_head > chunk.head)
-							_free_chunks.push_back({.head = chunk.head, .size = aligned_head - chunk.head});
-
-						// post-chunk split
-						const uint32 remaining_size = chunk.size - aligned_size_needed;
-						if (remaining_size > 0)
-							_free_chunks.push_back({.head = allocated_chunk.head + allocated_chunk.size, .size = remaining_size});
-
-						return allocated_chunk;
-					}
+					T* ptr = reinterpret_cast<T*>(_raw + handle.head);
+					for (size_t i = 0; i < count; i++)
+						ptr[i] = T();
 				}
 			}
 
-			const uint32 current_aligned_head = ALIGN_UP(_head, item_alignment);
-			const uint32 needed_size		  = (current_aligned_head - _head) + requested_size;
-
-			SFG_ASSERT(_head + needed_size <= _total_size);
-
-			const chunk_handle32 ret_val = {
-				.head = current_aligned_head,
-				.size = requested_size,
-			};
-
-			T* ptr = reinterpret_cast<T*>(_raw + ret_val.head);
-			for (size_t i = 0; i < count; i++)
-			{
-				ptr[i] = T();
-			}
-
-			_head += needed_size;
-			return ret_val;
+			return handle;
 		}
 
-		inline void free(chunk_handle32 handle)
-		{
-			SFG_ASSERT(handle.size != 0);
-
-			SFG_MEMSET(_raw + handle.head, 0, handle.size);
-
-			// sorted by head address.
-			auto it = std::lower_bound(_free_chunks.begin(), _free_chunks.end(), handle, [](const chunk_handle32& a, const chunk_handle32& b) { return a.head < b.head; });
-
-			bool was_merged = false;
-
-			// Check if the new chunk can be merged with the one before it.
-			if (it != _free_chunks.begin())
-			{
-				auto prev_it = it - 1;
-				if (prev_it->head + prev_it->size == handle.head)
-				{
-					// merge prev
-					prev_it->size += handle.size;
-					handle	   = *prev_it; // update for next merge check
-					it		   = prev_it + 1;
-					was_merged = true;
-				}
-			}
+		void free(chunk_handle32 handle);
 
-			// merge with next
-			if (it != _free_chunks.end() && handle.head + handle.size == it->head)
-			{
-				it->head = handle.head;
-				it->size += handle.size;
-			}
-			else
-			{
-				// no merge
-				if (!was_merged)
-					_free_chunks.insert(it, handle);
-			}
-		}
+		chunk_allocator_stats get_stats() const;
 
 		template <typename T> T* get(chunk_handle32 handle)
 		{
@@ -129,16 +95,38 @@ namespace SFG
 			return _raw + index;
 		}
 
+		/// High water mark of the managed memory.
 		inline uint32 get_current() const
 		{
 			return _head;
 		}
 
 	private:
-		uint8*				   _raw = nullptr;
-		vector<chunk_handle32> _free_chunks;
-		uint32				   _head	   = 0;
-		uint32				   _total_size = 0;
+		chunk_handle32 allocate_aligned(uint32 size, uint32 alignment);
+
+		uint32 create_block(uint32 offset, uint32 size);
+		void   destroy_block(uint32 index);
+		void   insert_free(uint32 index);
+		void   remove_free(uint32 index);
+		uint32 find_free(uint32 size);
+		uint32 split(uint32 index, uint32 size);
+
+		static void mapping_insert(uint32 size, uint32& fl, uint32& sl);
+		static void mapping_search(uint32 size, uint32& fl, uint32& sl);
+
+	private:
+		uint8*		   _raw = nullptr;
+		vector<block>  _blocks;
+		vector<uint32> _dead_blocks;
+		uint32		   _free_heads[FL_COUNT][SL_COUNT];
+		uint32		   _sl_bitmap[FL_COUNT] = {};
+		uint32		   _fl_bitmap			= 0;
+		uint32		   _head				= 0;
+		uint32		   _total_size			= 0;
+		uint32		   _used_size			= 0;
+		uint32		   _used_block_count	= 0;
+		uint32		   _free_block_count	= 0;
+		bool		   _zero_memory			= true;
 	};
 
 }
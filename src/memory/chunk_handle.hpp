@@ -8,7 +8,8 @@ namespace SFG
 {
 	struct chunk_handle32
 	{
-		uint32 head = 0;
-		uint32 size = 0;
+		uint32 head	 = 0;
+		uint32 size	 = 0;
+		uint32 block = 0; // allocator bookkeeping, free() goes straight to it.
 	};
 }
@@ -13,9 +13,11 @@
 #endif
 
 #include <memory>
+#include <cstring>
 #define SFG_MEMCPY(...)	 memcpy(__VA_ARGS__)
 #define SFG_MEMMOVE(...) memmove(__VA_ARGS__)
 #define SFG_MEMSET(...)	 memset(__VA_ARGS__)
+#define SFG_MEMCMP(...)	 memcmp(__VA_ARGS__)
 #define SFG_MALLOC(...)	 malloc(__VA_ARGS__)
 #define SFG_FREE(...)	 free(__VA_ARGS__)
 
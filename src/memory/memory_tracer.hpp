@@ -3,7 +3,7 @@
 
 #pragma once
 
-#ifndef NDEBUG
+#if !defined(NDEBUG) && defined(SFG_PLATFORM_WINDOWS)
 #define ENABLE_MEMORY_TRACER
 #endif
 
@@ -100,7 +100,7 @@ namespace SFG
 #define POP_MEMORY_CATEGORY()
 #define CHECK_LEAKS()
 #define PUSH_ALLOCATION(PTR, SIZE)
-#define PUSH_ALLOCATION()
+#define PUSH_ALLOCATION_SZ(SIZE)
 #define PUSH_DEALLOCATION(PTR)
-#define PUSH_DEALLOCATION()
+#define PUSH_DEALLOCATION_SZ(SIZE)
 #endif
\ No newline at end of file
@@ -0,0 +1,108 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "memory/memory.hpp"
+#include "memory/memory_tracer.hpp"
+#include "io/assert.hpp"
+#include "data/vector.hpp"
+#include <bit>
+
+namespace SFG
+{
+	/*
+		Grows in fixed size pages, items never move so indices & references stay valid.
+		Each page is a contiguous run of T, hot loops should iterate page by page.
+	*/
+	template <typename T, uint32 PAGE_SIZE> class paged_array
+	{
+		static_assert((PAGE_SIZE & (PAGE_SIZE - 1)) == 0, "Page size must be a power of two!");
+
+	public:
+		static constexpr uint32 PAGE_SHIFT = std::countr_zero(PAGE_SIZE);
+		static constexpr uint32 PAGE_MASK  = PAGE_SIZE - 1;
+
+		inline void init(size_t item_count)
+		{
+			SFG_ASSERT(_pages.empty());
+			grow(item_count);
+		}
+
+		inline void grow(size_t item_count)
+		{
+			while (get_capacity() < item_count)
+			{
+				T* page = reinterpret_cast<T*>(SFG_ALIGNED_MALLOC(alignof(T), sizeof(T) * PAGE_SIZE));
+				SFG_ASSERT(page != nullptr);
+
+#ifdef ENABLE_MEMORY_TRACER
+				memory_tracer::get().on_allocation(page, sizeof(T) * PAGE_SIZE);
+#endif
+
+				for (uint32 i = 0; i < PAGE_SIZE; i++)
+					new (&page[i]) T();
+
+				_pages.push_back(page);
+			}
+		}
+
+		inline void reset()
+		{
+			for (T* page : _pages)
+			{
+				for (uint32 i = 0; i < PAGE_SIZE; i++)
+					page[i] = T();
+			}
+		}
+
+		inline void reset(uint32 index)
+		{
+			get(index) = T();
+		}
+
+		inline void uninit()
+		{
+			for (T* page : _pages)
+			{
+#ifdef ENABLE_MEMORY_TRACER
+				memory_tracer::get().on_free(page);
+#endif
+				SFG_ALIGNED_FREE(page);
+			}
+
+			_pages.clear();
+		}
+
+		inline T& get(uint32 index)
+		{
+			SFG_ASSERT(index < get_capacity());
+			return _pages[index >> PAGE_SHIFT][index & PAGE_MASK];
+		}
+
+		inline const T& get(uint32 index) const
+		{
+			SFG_ASSERT(index < get_capacity());
+			return _pages[index >> PAGE_SHIFT][index & PAGE_MASK];
+		}
+
+		inline T* get_page(uint32 page_index) const
+		{
+			return _pages[page_index];
+		}
+
+		inline uint32 get_page_count() const
+		{
+			return static_cast<uint32>(_pages.size());
+		}
+
+		inline size_t get_capacity() const
+		{
+			return _pages.size() * PAGE_SIZE;
+		}
+
+	private:
+		vector<T*> _pages;
+	};
+
+}
@@ -0,0 +1,177 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "pool_handle.hpp"
+#include "paged_array.hpp"
+#include "io/assert.hpp"
+#include "data/vector.hpp"
+
+namespace SFG
+{
+	/*
+		Handle only pool with 32 bit indices & generations, grows a page at a time.
+		Payloads live in parallel paged_arrays owned by the user, indexed by handle.index.
+	*/
+	template <uint32 PAGE_SIZE> class paged_pool_allocator32
+	{
+	public:
+		inline void init(size_t item_count)
+		{
+			_generations.init(item_count);
+			_actives.init(item_count);
+			reset();
+		}
+
+		inline void uninit()
+		{
+			_generations.uninit();
+			_actives.uninit();
+			_free_indices.clear();
+			_head		 = 0;
+			_alive_count = 0;
+		}
+
+		inline void reset()
+		{
+			const uint32 count = static_cast<uint32>(_generations.get_capacity());
+			for (uint32 i = 0; i < count; i++)
+			{
+				_generations.get(i) = 1;
+				_actives.get(i)		= 0;
+			}
+
+			_free_indices.resize(0);
+			_head		 = 0;
+			_alive_count = 0;
+		}
+
+		/// Returns true if the pool had to grow, callers grow their own paged payloads to get_capacity().
+		inline bool allocate(pool_handle32& out_handle)
+		{
+			uint32 index = 0;
+			bool   grew	 = false;
+
+			if (!_free_indices.empty())
+			{
+				index = _free_indices.back();
+				_free_indices.pop_back();
+			}
+			else
+			{
+				index = _head++;
+
+				if (index >= _generations.get_capacity())
+				{
+					const uint32 old_capacity = static_cast<uint32>(_generations.get_capacity());
+					_generations.grow(static_cast<size_t>(index) + 1);
+					_actives.grow(static_cast<size_t>(index) + 1);
+
+					const uint32 new_capacity = static_cast<uint32>(_generations.get_capacity());
+					for (uint32 i = old_capacity; i < new_capacity; i++)
+						_generations.get(i) = 1;
+
+					grew = true;
+				}
+			}
+
+			_actives.get(index) = 1;
+			_alive_count++;
+			out_handle = {.generation = _generations.get(index), .index = index};
+			return grew;
+		}
+
+		inline void free(pool_handle32 handle)
+		{
+			SFG_ASSERT(is_valid(handle));
+
+			_actives.get(handle.index) = 0;
+
+			// skip 0, it marks null handles.
+			uint32& gen = _generations.get(handle.index);
+			gen			= gen == 0xFFFFFFFF ? 1 : gen + 1;
+
+			_free_indices.push_back(handle.index);
+			_alive_count--;
+		}
+
+		inline bool is_valid(pool_handle32 handle) const
+		{
+			return handle.index < _head && handle.generation == _generations.get(handle.index);
+		}
+
+		inline bool is_active(uint32 index) const
+		{
+			return _actives.get(index) != 0;
+		}
+
+		struct handle_iterator
+		{
+			const paged_pool_allocator32* pool	  = nullptr;
+			uint32						  current = 0;
+
+			handle_iterator(const paged_pool_allocator32* _pool, uint32 _start) : pool(_pool), current(_start)
+			{
+				while (current != pool->_head && !pool->is_active(current))
+					++current;
+			}
+
+			pool_handle32 operator*() const
+			{
+				return {.generation = pool->_generations.get(current), .index = current};
+			}
+
+			handle_iterator& operator++()
+			{
+				do
+				{
+					++current;
+				} while (current != pool->_head && !pool->is_active(current));
+				return *this;
+			}
+
+			bool operator==(const handle_iterator& other) const
+			{
+				return current == other.current;
+			}
+
+			bool operator!=(const handle_iterator& other) const
+			{
+				return current != other.current;
+			}
+		};
+
+		handle_iterator begin() const
+		{
+			return handle_iterator(this, 0);
+		}
+
+		handle_iterator end() const
+		{
+			return handle_iterator(this, _head);
+		}
+
+		/// One past the highest index ever handed out.
+		inline uint32 get_head() const
+		{
+			return _head;
+		}
+
+		inline uint32 get_alive_count() const
+		{
+			return _alive_count;
+		}
+
+		inline size_t get_capacity() const
+		{
+			return _generations.get_capacity();
+		}
+
+	private:
+		paged_array<uint32, PAGE_SIZE> _generations;
+		paged_array<uint8, PAGE_SIZE>  _actives;
+		vector<uint32>				   _free_indices;
+		uint32						   _head		= 0;
+		uint32						   _alive_count = 0;
+	};
+}
@@ -0,0 +1,141 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "memory.hpp"
+#include "memory_tracer.hpp"
+#include "io/assert.hpp"
+#include "data/vector.hpp"
+#include <cstring>
+#include <bit>
+
+namespace SFG
+{
+	/*
+		Growable text storage, strings are placed in power of two slots carved out of fixed size pages.
+		Freed slots go into per-size free lists, allocate & deallocate are O(1) and pointers stay stable.
+	*/
+	template <size_t PAGE_SIZE> class paged_text_allocator
+	{
+	private:
+		static constexpr uint32 MIN_SLOT_LOG2 = 4;
+		static constexpr uint32 CLASS_COUNT	  = std::countr_zero(PAGE_SIZE) - MIN_SLOT_LOG2 + 1;
+
+		static_assert((PAGE_SIZE & (PAGE_SIZE - 1)) == 0, "Page size must be a power of two!");
+
+		struct free_slot
+		{
+			free_slot* next = nullptr;
+		};
+
+	public:
+		~paged_text_allocator()
+		{
+			for (char* page : _pages)
+			{
+#ifdef ENABLE_MEMORY_TRACER
+				memory_tracer::get().on_free(page);
+#endif
+				SFG_FREE(page);
+			}
+		}
+
+		const char* allocate(size_t len)
+		{
+			char* slot = allocate_slot(len + 1);
+			slot[0]	   = '\0';
+			return slot;
+		}
+
+		const char* allocate(const char* text)
+		{
+			if (!text)
+				return nullptr;
+
+			const size_t len  = strlen(text);
+			char*		 slot = allocate_slot(len + 1);
+			std::strcpy(slot, text);
+			return slot;
+		}
+
+		void deallocate(const char* ptr)
+		{
+			char*		slot	   = const_cast<char*>(ptr);
+			const uint8 size_class = static_cast<uint8>(slot[-1]);
+			SFG_ASSERT(size_class < CLASS_COUNT);
+
+			free_slot* fs			= reinterpret_cast<free_slot*>(slot - sizeof(free_slot*));
+			fs->next				= _free_lists[size_class];
+			_free_lists[size_class] = fs;
+		}
+
+		inline void reset()
+		{
+			for (uint32 i = 0; i < CLASS_COUNT; i++)
+				_free_lists[i] = nullptr;
+
+			_page	   = 0;
+			_page_head = 0;
+		}
+
+		inline size_t get_page_count() const
+		{
+			return _pages.size();
+		}
+
+	private:
+		// Slots start with a pointer sized header, the last byte of which keeps the size class.
+		char* allocate_slot(size_t size)
+		{
+			const size_t total		= size + sizeof(free_slot*);
+			const uint32 size_log2	= static_cast<uint32>(std::bit_width(total - 1));
+			const uint32 size_class = size_log2 > MIN_SLOT_LOG2 ? size_log2 - MIN_SLOT_LOG2 : 0;
+			SFG_ASSERT(size_class < CLASS_COUNT);
+
+			char* slot = nullptr;
+
+			if (_free_lists[size_class] != nullptr)
+			{
+				free_slot* fs			= _free_lists[size_class];
+				_free_lists[size_class] = fs->next;
+				slot					= reinterpret_cast<char*>(fs);
+			}
+			else
+			{
+				const size_t slot_size = static_cast<size_t>(1) << (size_class + MIN_SLOT_LOG2);
+
+				if (_page == _pages.size() || _page_head + slot_size > PAGE_SIZE)
+				{
+					if (_page < _pages.size() && _page_head != 0)
+						_page++;
+
+					if (_page == _pages.size())
+					{
+						char* page = reinterpret_cast<char*>(SFG_MALLOC(PAGE_SIZE));
+#ifdef ENABLE_MEMORY_TRACER
+						memory_tracer::get().on_allocation(page, PAGE_SIZE);
+#endif
+						_pages.push_back(page);
+					}
+
+					_page_head = 0;
+				}
+
+				slot		= _pages[_page] + _page_head;
+				_page_head += slot_size;
+			}
+
+			char* text = slot + sizeof(free_slot*);
+			text[-1]   = static_cast<char>(size_class);
+			return text;
+		}
+
+	private:
+		vector<char*> _pages;
+		free_slot*	  _free_lists[CLASS_COUNT] = {};
+		size_t		  _page					   = 0;
+		size_t		  _page_head			   = 0;
+	};
+
+}
@@ -28,4 +28,20 @@ namespace SFG
 		}
 	};
 
+	struct pool_handle32
+	{
+		uint32 generation = 0;
+		uint32 index	  = 0;
+
+		bool operator==(const pool_handle32& other) const
+		{
+			return generation == other.generation && index == other.index;
+		}
+
+		bool is_null() const
+		{
+			return generation == 0;
+		}
+	};
+
 }
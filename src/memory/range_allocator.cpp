@@ -0,0 +1,214 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "range_allocator.hpp"
+#include "io/assert.hpp"
+#include <algorithm>
+
+namespace SFG
+{
+	namespace
+	{
+		inline uint32 align_up(uint32 value, uint32 alignment)
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+	}
+
+	void range_allocator::init(uint32 capacity)
+	{
+		SFG_ASSERT(capacity != 0);
+		_capacity = capacity;
+		_used	  = 0;
+		_entries.resize(0);
+		_free_ids.resize(0);
+		_free.resize(0);
+		_free.push_back({.offset = 0, .size = capacity});
+	}
+
+	void range_allocator::uninit()
+	{
+		_entries.clear();
+		_free_ids.clear();
+		_free.clear();
+		_order.clear();
+		_capacity = 0;
+		_used	  = 0;
+	}
+
+	uint32 range_allocator::new_entry()
+	{
+		if (!_free_ids.empty())
+		{
+			const uint32 id = _free_ids.back();
+			_free_ids.pop_back();
+			return id;
+		}
+
+		_entries.push_back({});
+		return static_cast<uint32>(_entries.size() - 1);
+	}
+
+	bool range_allocator::take(uint32 size, uint32 alignment, uint32 limit, uint32& out_offset)
+	{
+		const uint32 count = static_cast<uint32>(_free.size());
+		for (uint32 i = 0; i < count; i++)
+		{
+			free_range&	 fr		 = _free[i];
+			const uint32 aligned = align_up(fr.offset, alignment);
+			const uint32 end	 = fr.offset + fr.size;
+
+			// sorted by offset, nothing after this can end lower.
+			if (aligned + size > limit)
+				return false;
+
+			if (aligned + size > end)
+				continue;
+
+			out_offset		   = aligned;
+			const uint32 front = aligned - fr.offset;
+			const uint32 back  = end - (aligned + size);
+
+			if (front == 0 && back == 0)
+				_free.erase(_free.begin() + i);
+			else if (front == 0)
+				fr = {.offset = aligned + size, .size = back};
+			else
+			{
+				fr.size = front;
+				if (back != 0)
+					_free.insert(_free.begin() + i + 1, {.offset = aligned + size, .size = back});
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	void range_allocator::release(uint32 offset, uint32 size)
+	{
+		auto it = std::lower_bound(_free.begin(), _free.end(), offset, [](const free_range& fr, uint32 off) { return fr.offset < off; });
+
+		const bool merge_prev = it != _free.begin() && (it - 1)->offset + (it - 1)->size == offset;
+		const bool merge_next = it != _free.end() && offset + size == it->offset;
+		SFG_ASSERT(it == _free.end() || offset + size <= it->offset);
+
+		if (merge_prev && merge_next)
+		{
+			(it - 1)->size += size + it->size;
+			_free.erase(it);
+		}
+		else if (merge_prev)
+			(it - 1)->size += size;
+		else if (merge_next)
+		{
+			it->offset = offset;
+			it->size += size;
+		}
+		else
+			_free.insert(it, {.offset = offset, .size = size});
+	}
+
+	uint32 range_allocator::allocate(uint32 size, uint32 alignment, uint32 user)
+	{
+		SFG_ASSERT(size != 0 && alignment != 0);
+
+		uint32 offset = 0;
+		if (!take(size, alignment, _capacity, offset))
+			return RANGE_INVALID_ID;
+
+		const uint32 id = new_entry();
+		_entries[id]	= {.offset = offset, .size = size, .alignment = alignment, .user = user, .alive = 1};
+		_used += size;
+		return id;
+	}
+
+	void range_allocator::free(uint32 id)
+	{
+		range_entry& e = _entries[id];
+		SFG_ASSERT(e.alive);
+		release(e.offset, e.size);
+		_used -= e.size;
+		e.alive = 0;
+		_free_ids.push_back(id);
+	}
+
+	void range_allocator::retire(uint32 id)
+	{
+		SFG_ASSERT(_entries[id].alive);
+		_entries[id].retired = 1;
+	}
+
+	void range_allocator::grow(uint32 new_capacity)
+	{
+		SFG_ASSERT(new_capacity > _capacity);
+		release(_capacity, new_capacity - _capacity);
+		_capacity = new_capacity;
+	}
+
+	uint32 range_allocator::defragment(uint32 max_bytes, vector<relocation>& out_relocations)
+	{
+		// a single hole at the end means there is nothing to compact.
+		if (_free.empty() || _free[0].offset >= get_high_water())
+			return 0;
+
+		// highest first, each one goes to the lowest hole that takes it entirely below where it is now.
+		_order.resize(0);
+		const uint32 entry_count = static_cast<uint32>(_entries.size());
+		for (uint32 id = 0; id < entry_count; id++)
+		{
+			const range_entry& e = _entries[id];
+			if (e.alive && !e.retired)
+				_order.push_back(id);
+		}
+
+		std::sort(_order.begin(), _order.end(), [this](uint32 a, uint32 b) { return _entries[a].offset > _entries[b].offset; });
+
+		uint32 moved   = 0;
+		uint32 largest = get_largest_free(); // only shrinks while moving, stays a valid bound.
+		for (uint32 id : _order)
+		{
+			if (moved >= max_bytes || _free.empty())
+				break;
+
+			const range_entry src = _entries[id];
+			if (_free[0].offset > src.offset)
+				break;
+
+			if (src.size > largest)
+				continue;
+
+			uint32 offset = 0;
+			if (!take(src.size, src.alignment, src.offset, offset))
+				continue;
+
+			// the old range is kept as its own allocation, readers of the old offset may still be in flight.
+			const uint32 retired_id = new_entry();
+			_entries[retired_id]	= {.offset = src.offset, .size = src.size, .alignment = src.alignment, .user = src.user, .alive = 1, .retired = 1};
+			_entries[id].offset		= offset;
+			_used += src.size;
+
+			out_relocations.push_back({.id = id, .retired_id = retired_id, .old_offset = src.offset, .new_offset = offset, .size = src.size});
+			moved += src.size;
+		}
+
+		return moved;
+	}
+
+	uint32 range_allocator::get_high_water() const
+	{
+		if (_free.empty())
+			return _capacity;
+
+		const free_range& last = _free.back();
+		return last.offset + last.size == _capacity ? last.offset : _capacity;
+	}
+
+	uint32 range_allocator::get_largest_free() const
+	{
+		uint32 largest = 0;
+		for (const free_range& fr : _free)
+			largest = fr.size > largest ? fr.size : largest;
+		return largest;
+	}
+}
@@ -0,0 +1,106 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "data/vector.hpp"
+
+namespace SFG
+{
+#define RANGE_INVALID_ID UINT32_MAX
+
+	/*
+		Offset sub-allocator over a range that can grow, meant for memory that lives elsewhere (a gpu buffer). Free ranges are kept sorted & coalesced,
+		allocations go to the lowest range that fits. defragment() moves the highest allocations down into holes below them, the range a move
+		leaves behind stays allocated under retired_id until the caller frees it, so data still read from there isn't handed out again.
+	*/
+	class range_allocator
+	{
+	public:
+		struct relocation
+		{
+			uint32 id		  = 0;
+			uint32 retired_id = 0;
+			uint32 old_offset = 0;
+			uint32 new_offset = 0;
+			uint32 size		  = 0;
+		};
+
+		void init(uint32 capacity);
+		void uninit();
+
+		/// Offsets are a multiple of alignment, which doesn't need to be a power of two. Returns RANGE_INVALID_ID if nothing fits.
+		uint32 allocate(uint32 size, uint32 alignment, uint32 user = 0);
+		void   free(uint32 id);
+		void   grow(uint32 new_capacity);
+
+		/// Keeps a range where it is from now on, for ones waiting to be freed.
+		void retire(uint32 id);
+
+		/// Moves allocations until max_bytes are moved or nothing else gets lower, returns the bytes moved.
+		uint32 defragment(uint32 max_bytes, vector<relocation>& out_relocations);
+
+		inline uint32 get_offset(uint32 id) const
+		{
+			return _entries[id].offset;
+		}
+
+		inline uint32 get_size(uint32 id) const
+		{
+			return _entries[id].size;
+		}
+
+		inline uint32 get_user(uint32 id) const
+		{
+			return _entries[id].user;
+		}
+
+		inline uint32 get_capacity() const
+		{
+			return _capacity;
+		}
+
+		inline uint32 get_used() const
+		{
+			return _used;
+		}
+
+		inline uint32 get_free_range_count() const
+		{
+			return static_cast<uint32>(_free.size());
+		}
+
+		/// End of the highest allocation.
+		uint32 get_high_water() const;
+		uint32 get_largest_free() const;
+
+	private:
+		struct range_entry
+		{
+			uint32 offset	 = 0;
+			uint32 size		 = 0;
+			uint32 alignment = 1;
+			uint32 user		 = 0;
+			uint8  alive	 = 0;
+			uint8  retired	 = 0;
+		};
+
+		struct free_range
+		{
+			uint32 offset = 0;
+			uint32 size	  = 0;
+		};
+
+		uint32 new_entry();
+		bool   take(uint32 size, uint32 alignment, uint32 limit, uint32& out_offset);
+		void   release(uint32 offset, uint32 size);
+
+	private:
+		vector<range_entry> _entries;
+		vector<uint32>		_free_ids;
+		vector<free_range>	_free;
+		vector<uint32>		_order;
+		uint32				_capacity = 0;
+		uint32				_used	  = 0;
+	};
+}
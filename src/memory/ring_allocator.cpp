@@ -0,0 +1,92 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "ring_allocator.hpp"
+#include "io/assert.hpp"
+
+namespace SFG
+{
+	void ring_allocator::init(size_t capacity)
+	{
+		SFG_ASSERT(capacity != 0);
+		_capacity	   = capacity;
+		_head		   = 0;
+		_tail		   = 0;
+		_used		   = 0;
+		_frame_size	   = 0;
+		_pending_first = 0;
+		_pending_count = 0;
+	}
+
+	size_t ring_allocator::allocate(size_t size, size_t alignment)
+	{
+		SFG_ASSERT(size != 0 && alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+		// nothing in flight, start over from the front to keep allocations contiguous.
+		if (_used == 0 && _pending_count == 0)
+		{
+			_head = 0;
+			_tail = 0;
+		}
+
+		if (_used == _capacity)
+			return RING_INVALID_OFFSET;
+
+		const size_t aligned = (_head + alignment - 1) & ~(alignment - 1);
+
+		if (_head >= _tail)
+		{
+			// free space runs to the end, then wraps to the tail.
+			if (aligned + size <= _capacity)
+			{
+				_used += aligned + size - _head;
+				_frame_size += aligned + size - _head;
+				_head = aligned + size;
+				return aligned;
+			}
+
+			if (size > _tail)
+				return RING_INVALID_OFFSET;
+
+			const size_t wasted = _capacity - _head + size;
+			_used += wasted;
+			_frame_size += wasted;
+			_head = size;
+			return 0;
+		}
+
+		if (aligned + size > _tail)
+			return RING_INVALID_OFFSET;
+
+		_used += aligned + size - _head;
+		_frame_size += aligned + size - _head;
+		_head = aligned + size;
+		return aligned;
+	}
+
+	void ring_allocator::end_frame(uint64 fence)
+	{
+		SFG_ASSERT(_pending_count < RING_MAX_PENDING_FRAMES);
+
+		frame_marker& m = _pending[(_pending_first + _pending_count) % RING_MAX_PENDING_FRAMES];
+		m.fence			= fence;
+		m.head			= _head;
+		m.size			= _frame_size;
+		_frame_size		= 0;
+		_pending_count++;
+	}
+
+	void ring_allocator::retire(uint64 completed_fence)
+	{
+		while (_pending_count != 0)
+		{
+			const frame_marker& m = _pending[_pending_first];
+			if (m.fence > completed_fence)
+				break;
+
+			_tail = m.head;
+			_used -= m.size;
+			_pending_first = (_pending_first + 1) % RING_MAX_PENDING_FRAMES;
+			_pending_count--;
+		}
+	}
+}
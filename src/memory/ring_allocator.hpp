@@ -0,0 +1,61 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+
+namespace SFG
+{
+#define RING_MAX_PENDING_FRAMES 8
+#define RING_INVALID_OFFSET		SIZE_MAX
+
+	/*
+		Hands out offsets in a fixed range, meant for memory the gpu reads after the cpu is done with it. Allocations are grouped per frame with
+		end_frame(fence), retire(completed) gives back every frame whose fence has passed, oldest first. Owns no memory.
+	*/
+	class ring_allocator
+	{
+	public:
+		void init(size_t capacity);
+
+		/// Returns RING_INVALID_OFFSET when the space in use by pending frames leaves no room.
+		size_t allocate(size_t size, size_t alignment = 1);
+
+		/// Closes the allocations made since the last call, they are released once fence is retired.
+		void end_frame(uint64 fence);
+		void retire(uint64 completed_fence);
+
+		inline size_t get_capacity() const
+		{
+			return _capacity;
+		}
+
+		/// Bytes held by pending frames & the open one, wasted space at wrap & alignment included.
+		inline size_t get_used() const
+		{
+			return _used;
+		}
+
+		inline uint32 get_pending_frames() const
+		{
+			return _pending_count;
+		}
+
+	private:
+		struct frame_marker
+		{
+			uint64 fence = 0;
+			size_t head	 = 0;
+			size_t size	 = 0;
+		};
+
+		frame_marker _pending[RING_MAX_PENDING_FRAMES] = {};
+		size_t		 _capacity						   = 0;
+		size_t		 _head							   = 0;
+		size_t		 _tail							   = 0;
+		size_t		 _used							   = 0;
+		size_t		 _frame_size					   = 0;
+		uint32		 _pending_first					   = 0;
+		uint32		 _pending_count					   = 0;
+	};
+}
@@ -0,0 +1,49 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "sparse_set16.hpp"
+
+namespace SFG
+{
+	sparse_set16::~sparse_set16()
+	{
+		if (_raw != nullptr)
+			uninit();
+	}
+
+	void sparse_set16::uninit()
+	{
+		SFG_ASSERT(_raw != nullptr);
+#ifdef ENABLE_MEMORY_TRACER
+		memory_tracer::get().on_free(_raw);
+#endif
+		SFG_ALIGNED_FREE(_raw);
+		_raw			   = nullptr;
+		_head			   = 0;
+		_count			   = 0;
+		_free_count		   = 0;
+		_item_count		   = 0;
+		_item_size_aligned = 0;
+	}
+
+	void sparse_set16::reset()
+	{
+		_head		= 0;
+		_count		= 0;
+		_free_count = 0;
+
+		if (_raw == nullptr)
+			return;
+
+		SFG_MEMSET(_raw, 0, static_cast<size_t>(_item_count) * _item_size_aligned + sizeof(uint16) * _item_count * 2);
+
+		// generation 0 is the null handle.
+		uint16* generations = get_generations();
+		for (uint16 i = 0; i < _item_count; i++)
+			generations[i] = 1;
+	}
+
+	bool sparse_set16::is_valid(pool_handle16 handle) const
+	{
+		return handle.index < _head && handle.generation == get_generations()[handle.index];
+	}
+}
@@ -0,0 +1,213 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "pool_handle.hpp"
+#include "io/assert.hpp"
+#include "memory/memory.hpp"
+#include "memory/memory_tracer.hpp"
+#include <new>
+#include <utility>
+
+namespace SFG
+{
+	/*
+		Items are kept tightly packed in a dense array, handles point into a sparse array that maps to the dense slot. Freeing moves the last
+		item into the hole, so iteration over get_dense() never touches dead slots. Handles stay valid until freed, dense indices & pointers
+		don't survive a free.
+	*/
+	class sparse_set16
+	{
+	public:
+		~sparse_set16();
+
+		template <typename T> inline void init(size_t item_count)
+		{
+			SFG_ASSERT(_raw == nullptr);
+			SFG_ASSERT(item_count < UINT16_MAX);
+
+			const size_t padded_item_size = (sizeof(T) + alignof(T) - 1) & ~(alignof(T) - 1);
+			const size_t sz_items		  = padded_item_size * item_count;
+			const size_t sz_indices		  = sizeof(uint16) * item_count * 4;
+			const size_t total_size		  = (sz_items + sz_indices + alignof(T) - 1) & ~(alignof(T) - 1);
+			_raw						  = reinterpret_cast<uint8*>(SFG_ALIGNED_MALLOC(alignof(T), total_size));
+			_item_count					  = static_cast<uint16>(item_count);
+			_item_size_aligned			  = static_cast<uint16>(padded_item_size);
+
+#ifdef ENABLE_MEMORY_TRACER
+			memory_tracer::get().on_allocation(_raw, total_size);
+#endif
+
+			reset();
+		}
+
+		void uninit();
+
+		/// Drops every item without running destructors, capacity stays.
+		void reset();
+		bool is_valid(pool_handle16 handle) const;
+
+		template <typename T> pool_handle16 allocate()
+		{
+			SFG_ASSERT(sizeof(T) <= _item_size_aligned);
+
+			uint16 index = 0;
+			if (_free_count != 0)
+			{
+				index = get_free_indices()[_free_count - 1];
+				_free_count--;
+			}
+			else
+			{
+				index = _head;
+				_head++;
+				SFG_ASSERT(_head <= _item_count);
+			}
+
+			const uint16 dense = _count;
+			_count++;
+			get_dense_to_sparse()[dense] = index;
+			get_sparse_to_dense()[index] = dense;
+			new (get_dense<T>() + dense) T();
+
+			return {.generation = get_generations()[index], .index = index};
+		}
+
+		template <typename T> void free(pool_handle16 handle)
+		{
+			SFG_ASSERT(is_valid(handle));
+
+			uint16*		 dense_to_sparse = get_dense_to_sparse();
+			uint16*		 sparse_to_dense = get_sparse_to_dense();
+			T*			 items			 = get_dense<T>();
+			const uint16 dense			 = sparse_to_dense[handle.index];
+			const uint16 last			 = _count - 1;
+
+			if (dense != last)
+			{
+				const uint16 moved	   = dense_to_sparse[last];
+				items[dense]		   = std::move(items[last]);
+				dense_to_sparse[dense] = moved;
+				sparse_to_dense[moved] = dense;
+			}
+
+			items[last].~T();
+			_count--;
+
+			get_generations()[handle.index]++;
+			get_free_indices()[_free_count] = handle.index;
+			_free_count++;
+		}
+
+		template <typename T> inline T& get(pool_handle16 handle) const
+		{
+			SFG_ASSERT(is_valid(handle));
+			return get_dense<T>()[get_sparse_to_dense()[handle.index]];
+		}
+
+		/// get_count() packed items.
+		template <typename T> inline T* get_dense() const
+		{
+			SFG_ASSERT(sizeof(T) == _item_size_aligned);
+			return reinterpret_cast<T*>(_raw);
+		}
+
+		/// For callers that don't know the type, items are get_item_size() apart.
+		inline uint8* get_dense_raw(uint16 dense_index) const
+		{
+			SFG_ASSERT(dense_index < _count);
+			return _raw + static_cast<size_t>(dense_index) * _item_size_aligned;
+		}
+
+		inline uint16 get_item_size() const
+		{
+			return _item_size_aligned;
+		}
+
+		inline pool_handle16 get_handle(uint16 dense_index) const
+		{
+			SFG_ASSERT(dense_index < _count);
+			const uint16 index = get_dense_to_sparse()[dense_index];
+			return {.generation = get_generations()[index], .index = index};
+		}
+
+		inline uint16 get_count() const
+		{
+			return _count;
+		}
+
+		inline uint16 get_capacity() const
+		{
+			return _item_count;
+		}
+
+		inline uint8* get_raw() const
+		{
+			return _raw;
+		}
+
+		struct handle_iterator
+		{
+			const sparse_set16* set		= nullptr;
+			uint16				current = 0;
+
+			pool_handle16 operator*() const
+			{
+				return set->get_handle(current);
+			}
+
+			handle_iterator& operator++()
+			{
+				++current;
+				return *this;
+			}
+
+			bool operator==(const handle_iterator& other) const
+			{
+				return current == other.current;
+			}
+
+			bool operator!=(const handle_iterator& other) const
+			{
+				return current != other.current;
+			}
+		};
+
+		/// Handles in dense order.
+		handle_iterator begin() const
+		{
+			return {.set = this, .current = 0};
+		}
+
+		handle_iterator end() const
+		{
+			return {.set = this, .current = _count};
+		}
+
+	private:
+		uint16* get_dense_to_sparse() const
+		{
+			return reinterpret_cast<uint16*>(_raw + static_cast<size_t>(_item_count) * _item_size_aligned);
+		}
+		uint16* get_sparse_to_dense() const
+		{
+			return get_dense_to_sparse() + _item_count;
+		}
+		uint16* get_generations() const
+		{
+			return get_dense_to_sparse() + _item_count * 2;
+		}
+		uint16* get_free_indices() const
+		{
+			return get_dense_to_sparse() + _item_count * 3;
+		}
+
+	private:
+		uint8* _raw				  = nullptr;
+		uint16 _head			  = 0;
+		uint16 _count			  = 0;
+		uint16 _free_count		  = 0;
+		uint16 _item_count		  = 0;
+		uint16 _item_size_aligned = 0;
+	};
+}
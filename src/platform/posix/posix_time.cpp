@@ -0,0 +1,101 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "platform/time.hpp"
+#include <time.h>
+#include <sched.h>
+
+namespace SFG
+{
+	namespace
+	{
+		// cycles are nanoseconds of the monotonic clock.
+		inline int64 monotonic_ns()
+		{
+			timespec ts;
+			clock_gettime(CLOCK_MONOTONIC, &ts);
+			return static_cast<int64>(ts.tv_sec) * 1000000000ll + static_cast<int64>(ts.tv_nsec);
+		}
+	}
+
+	void time::init()
+	{
+	}
+
+	void time::uninit()
+	{
+	}
+
+	int64 time::get_cpu_microseconds()
+	{
+		return monotonic_ns() / 1000ll;
+	}
+
+	double time::get_cpu_seconds()
+	{
+		return static_cast<double>(monotonic_ns()) * 1e-9;
+	}
+
+	int64 time::get_cpu_cycles()
+	{
+		return monotonic_ns();
+	}
+
+	double time::get_delta_seconds(int64 fromCycles, int64 toCycles)
+	{
+		return static_cast<double>(toCycles - fromCycles) * 1e-9;
+	}
+
+	int64 time::get_delta_microseconds(int64 fromCycles, int64 toCycles)
+	{
+		return (toCycles - fromCycles) / 1000ll;
+	}
+
+	void time::throttle(int64 microseconds)
+	{
+		if (microseconds < 0)
+			return;
+
+		int64		now	   = get_cpu_microseconds();
+		const int64 target = now + microseconds;
+
+		for (;;)
+		{
+			now = get_cpu_microseconds();
+
+			if (now >= target)
+			{
+				break;
+			}
+
+			int64 diff = target - now;
+
+			if (diff > 2000)
+			{
+				uint32 ms = static_cast<uint32>((double)(diff - 2000) / 1000.0);
+				go_to_sleep(ms);
+			}
+			else
+			{
+				go_to_sleep(0);
+			}
+		}
+	}
+
+	void time::go_to_sleep(uint32 milliseconds)
+	{
+		if (milliseconds == 0)
+		{
+			sched_yield();
+			return;
+		}
+
+		timespec ts = {.tv_sec = static_cast<time_t>(milliseconds / 1000), .tv_nsec = static_cast<long>(milliseconds % 1000) * 1000000l};
+		nanosleep(&ts, nullptr);
+	}
+
+	void time::YieldThread()
+	{
+		sched_yield();
+	}
+
+} // namespace SFG
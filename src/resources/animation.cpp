@@ -18,14 +18,14 @@ namespace SFG
 		{
 			keyframes					  = alloc.allocate<animation_keyframe_v3>(kf_count);
 			animation_keyframe_v3* ptr_kf = alloc.get<animation_keyframe_v3>(keyframes);
-			SFG_MEMCPY(ptr_kf, raw.keyframes.data(), raw.keyframes.size());
+			SFG_MEMCPY(ptr_kf, raw.keyframes.data(), sizeof(animation_keyframe_v3) * kf_count);
 		}
 
 		if (kf_splines_count != 0)
 		{
 			keyframes_spline					 = alloc.allocate<animation_keyframe_v3_spline>(kf_splines_count);
 			animation_keyframe_v3_spline* ptr_kf = alloc.get<animation_keyframe_v3_spline>(keyframes_spline);
-			SFG_MEMCPY(ptr_kf, raw.keyframes_spline.data(), raw.keyframes_spline.size());
+			SFG_MEMCPY(ptr_kf, raw.keyframes_spline.data(), sizeof(animation_keyframe_v3_spline) * kf_splines_count);
 		}
 	}
 
@@ -43,10 +43,10 @@ namespace SFG
 		if (keyframes.size == 0 && keyframes_spline.size == 0)
 			return vector3::zero; // Return a default value.
 
-		animation_keyframe_v3*		  ptr					 = alloc.get<animation_keyframe_v3>(keyframes);
-		animation_keyframe_v3_spline* ptr_spline			 = alloc.get<animation_keyframe_v3_spline>(keyframes_spline);
-		const uint32				  keyframes_count		 = keyframes.size == 0 ? 0 : sizeof(animation_keyframe_v3) / keyframes.size;
-		const uint32				  keyframes_spline_count = keyframes.size == 0 ? 0 : sizeof(animation_keyframe_v3_spline) / keyframes_spline.size;
+		animation_keyframe_v3*		  ptr					 = keyframes.size == 0 ? nullptr : alloc.get<animation_keyframe_v3>(keyframes);
+		animation_keyframe_v3_spline* ptr_spline			 = keyframes_spline.size == 0 ? nullptr : alloc.get<animation_keyframe_v3_spline>(keyframes_spline);
+		const uint32				  keyframes_count		 = keyframes.size / static_cast<uint32>(sizeof(animation_keyframe_v3));
+		const uint32				  keyframes_spline_count = keyframes_spline.size / static_cast<uint32>(sizeof(animation_keyframe_v3_spline));
 
 		if (interpolation == animation_interpolation::cubic_spline && keyframes_spline_count != 0)
 		{
@@ -126,8 +126,8 @@ namespace SFG
 
 	void animation_channel_q::create_from_raw(const animation_channel_q_raw& raw, chunk_allocator32& alloc)
 	{
-		interpolation = interpolation;
-		node_index	  = node_index;
+		interpolation = raw.interpolation;
+		node_index	  = raw.node_index;
 
 		const uint32 kf_count		  = static_cast<uint32>(raw.keyframes.size());
 		const uint32 kf_splines_count = static_cast<uint32>(raw.keyframes_spline.size());
@@ -136,14 +136,14 @@ namespace SFG
 		{
 			keyframes					 = alloc.allocate<animation_keyframe_q>(kf_count);
 			animation_keyframe_q* ptr_kf = alloc.get<animation_keyframe_q>(keyframes);
-			SFG_MEMCPY(ptr_kf, raw.keyframes.data(), raw.keyframes.size());
+			SFG_MEMCPY(ptr_kf, raw.keyframes.data(), sizeof(animation_keyframe_q) * kf_count);
 		}
 
 		if (kf_splines_count != 0)
 		{
 			keyframes_spline					= alloc.allocate<animation_keyframe_q_spline>(kf_splines_count);
 			animation_keyframe_q_spline* ptr_kf = alloc.get<animation_keyframe_q_spline>(keyframes_spline);
-			SFG_MEMCPY(ptr_kf, raw.keyframes_spline.data(), raw.keyframes_spline.size());
+			SFG_MEMCPY(ptr_kf, raw.keyframes_spline.data(), sizeof(animation_keyframe_q_spline) * kf_splines_count);
 		}
 	}
 
@@ -161,10 +161,10 @@ namespace SFG
 		if (keyframes.size == 0 && keyframes_spline.size == 0)
 			return quat::identity;
 
-		animation_keyframe_q*		 ptr					= alloc.get<animation_keyframe_q>(keyframes);
-		animation_keyframe_q_spline* ptr_spline				= alloc.get<animation_keyframe_q_spline>(keyframes_spline);
-		const uint32				 keyframes_count		= keyframes.size == 0 ? 0 : sizeof(animation_keyframe_q) / keyframes.size;
-		const uint32				 keyframes_spline_count = keyframes.size == 0 ? 0 : sizeof(animation_keyframe_q_spline) / keyframes_spline.size;
+		animation_keyframe_q*		 ptr					= keyframes.size == 0 ? nullptr : alloc.get<animation_keyframe_q>(keyframes);
+		animation_keyframe_q_spline* ptr_spline				= keyframes_spline.size == 0 ? nullptr : alloc.get<animation_keyframe_q_spline>(keyframes_spline);
+		const uint32				 keyframes_count		= keyframes.size / static_cast<uint32>(sizeof(animation_keyframe_q));
+		const uint32				 keyframes_spline_count = keyframes_spline.size / static_cast<uint32>(sizeof(animation_keyframe_q_spline));
 
 		if (interpolation == animation_interpolation::cubic_spline)
 		{
@@ -256,9 +256,8 @@ namespace SFG
 	{
 		if (!raw.name.empty())
 		{
-			_name = alloc.allocate<uint8>(raw.name.size());
+			_name = alloc.allocate<uint8>(raw.name.size() + 1);
 			strcpy((char*)alloc.get(_name.head), raw.name.data());
-			strcpy((char*)(alloc.get(_name.head + _name.size)), "\0");
 		}
 
 		_duration = raw.duration;
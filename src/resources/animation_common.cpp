@@ -6,6 +6,9 @@
 
 namespace SFG
 {
+	static_assert(sizeof(animation_keyframe_v3) == 16 && sizeof(animation_keyframe_v3_spline) == 40, "Keyframes are bulk serialized, they can't have padding!");
+	static_assert(sizeof(animation_keyframe_q) == 20 && sizeof(animation_keyframe_q_spline) == 52, "Keyframes are bulk serialized, they can't have padding!");
+
 	void animation_keyframe_v3::serialize(ostream& stream) const
 	{
 		stream << time;
@@ -22,6 +22,8 @@ namespace SFG
 		float	time  = 0.0f;
 		vector3 value = vector3::zero;
 
+		static constexpr bool bulk_serializable = true;
+
 		void serialize(ostream& stream) const;
 		void deserialize(istream& stream);
 	};
@@ -33,6 +35,8 @@ namespace SFG
 		vector3 value		= vector3::zero;
 		vector3 out_tangent = vector3::zero;
 
+		static constexpr bool bulk_serializable = true;
+
 		void serialize(ostream& stream) const;
 		void deserialize(istream& stream);
 	};
@@ -42,6 +46,8 @@ namespace SFG
 		float time	= 0.0f;
 		quat  value = quat();
 
+		static constexpr bool bulk_serializable = true;
+
 		void serialize(ostream& stream) const;
 		void deserialize(istream& stream);
 	};
@@ -53,6 +59,8 @@ namespace SFG
 		quat  value		  = quat();
 		quat  out_tangent = quat();
 
+		static constexpr bool bulk_serializable = true;
+
 		void serialize(ostream& stream) const;
 		void deserialize(istream& stream);
 	};
@@ -25,6 +25,11 @@ namespace SFG
 			_all_shaders.push_back(resources.get_resource_handle_by_hash<shader>(sh));
 		_default_shader = resources.get_resource<shader>(_all_shaders[0]).get_hw();
 
+		SFG_ASSERT(texture_count <= MAX_MATERIAL_TEXTURES);
+		_textures.clear();
+		for (string_id txt : raw.textures)
+			_textures.push_back(resources.get_resource_handle_by_hash<texture>(txt));
+
 		for (uint8 i = 0; i < FRAMES_IN_FLIGHT; i++)
 		{
 			if (_buffers[i].is_alive())
@@ -51,23 +56,30 @@ namespace SFG
 			_bind_groups[i] = backend->create_empty_bind_group();
 			backend->bind_group_add_pointer(_bind_groups[i], rpi_table_material, 3, false);
 
-			vector<bind_group_pointer> updates;
+			update_bindings(resources, i);
+		}
+	}
+
+	void material::update_bindings(world_resources& resources, uint8 frame_index)
+	{
+		gfx_backend*			   backend = gfx_backend::get();
+		vector<bind_group_pointer> updates;
+		updates.push_back({
+			.resource	   = _buffers[frame_index].get_hw_gpu(),
+			.pointer_index = upi_material_ubo0,
+			.type		   = binding_type::ubo,
+		});
+
+		const uint8 texture_count = static_cast<uint8>(_textures.size());
+		for (uint8 k = 0; k < texture_count; k++)
+		{
 			updates.push_back({
-				.resource	   = _buffers[i].get_hw_gpu(),
-				.pointer_index = upi_material_ubo0,
-				.type		   = binding_type::ubo,
+				.resource	   = resources.get_resource<texture>(_textures[k]).get_hw(),
+				.pointer_index = static_cast<uint8>(upi_material_texture0 + k),
+				.type		   = binding_type::texture_binding,
 			});
-
-			for (uint8 k = 0; k < texture_count; k++)
-			{
-				updates.push_back({
-					.resource	   = resources.get_resource_by_hash<texture>(raw.textures[k]).get_hw(),
-					.pointer_index = static_cast<uint8>(upi_material_texture0 + k),
-					.type		   = binding_type::texture_binding,
-				});
-			}
-			backend->bind_group_update_pointer(_bind_groups[i], 0, updates);
 		}
+		backend->bind_group_update_pointer(_bind_groups[frame_index], 0, updates);
 	}
 
 	void material::destroy()
@@ -87,13 +99,16 @@ namespace SFG
 		if (flags_to_match == 0)
 			return _default_shader;
 
+		// variants have to match exactly, a skinned shader can't draw packed vertices.
+		const uint8 variant_mask = shader::flags::is_skinned | shader::flags::is_packed;
+
 		for (pool_handle16 handle : _all_shaders)
 		{
 			const shader& sh = resources.get_resource<shader>(handle);
-			if (sh.get_flags().is_set(flags_to_match))
+			if ((sh.get_flags().value() & variant_mask) == flags_to_match)
 				return sh.get_hw();
 		}
-		SFG_ASSERT(false);
+		SFG_ASSERT(false, "Material has no shader variant for the flags, packed meshes need an is_packed shader in the material.");
 		return _default_shader;
 	}
 }
\ No newline at end of file
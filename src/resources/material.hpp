@@ -28,6 +28,9 @@ namespace SFG
 		void   destroy();
 		gfx_id get_shader(world_resources& resources, uint8 flags_to_match) const;
 
+		/// Points the frame's group at the current device copies, streamed textures swap theirs as mips come & go.
+		void update_bindings(world_resources& resources, uint8 frame_index);
+
 		inline bool is_dirty(uint8 frame_index) const
 		{
 			return _buffers[frame_index].is_dirty();
@@ -58,10 +61,16 @@ namespace SFG
 			return _material_data;
 		}
 
+		inline const static_vector<resource_handle, MAX_MATERIAL_TEXTURES>& get_textures() const
+		{
+			return _textures;
+		}
+
 	private:
 		ostream														 _material_data				= {};
 		buffer														 _buffers[FRAMES_IN_FLIGHT] = {};
 		static_vector<resource_handle, MAX_MATERIAL_SHADER_VARIANTS> _all_shaders;
+		static_vector<resource_handle, MAX_MATERIAL_TEXTURES>		 _textures;
 		gfx_id														 _default_shader				= 0;
 		gfx_id														 _bind_groups[FRAMES_IN_FLIGHT] = {};
 		bitmask<uint8>												 _flags							= 0;
@@ -13,17 +13,63 @@ namespace SFG
 	{
 		if (!raw.name.empty())
 		{
-			_name = alloc.allocate<uint8>(raw.name.size());
+			_name = alloc.allocate<uint8>(raw.name.size() + 1);
 			strcpy((char*)alloc.get(_name.head), raw.name.data());
-			strcpy((char*)(alloc.get(_name.head + _name.size)), "\0");
 		}
 
 		_node_index				  = raw.node_index;
+		_quantization			  = raw.quantization;
+		_lod_count				  = raw.lod_errors.empty() ? 1 : static_cast<uint8>(raw.lod_errors.size() < MAX_MESH_LODS ? raw.lod_errors.size() : MAX_MESH_LODS);
+
+		for (uint8 i = 0; i < _lod_count && i < raw.lod_errors.size(); i++)
+			_lod_errors[i] = raw.lod_errors[i];
 		_primitives_static_count  = static_cast<uint16>(raw.primitives_static.size());
 		_primitives_skinned_count = static_cast<uint16>(raw.primitives_skinned.size());
 
 		vector<uint16> materials;
 
+		vector3 bounds_min = vector3(MATH_INF_F, MATH_INF_F, MATH_INF_F);
+		vector3 bounds_max = vector3(-MATH_INF_F, -MATH_INF_F, -MATH_INF_F);
+
+		auto add_bounds = [&](const vector3& pos) {
+			bounds_min = vector3::min(bounds_min, pos);
+			bounds_max = vector3::max(bounds_max, pos);
+		};
+
+		// packed positions can't leave the quantization bounds.
+		auto add_packed_bounds = [&]() {
+			add_bounds(_quantization.position_min);
+			add_bounds(_quantization.position_min + _quantization.position_extent);
+		};
+
+		// primitives with a shorter chain than the mesh keep drawing their last level.
+		auto fill_lods = [&](primitive& prim, const vector<uint32>& counts, size_t index_count) {
+			if (counts.empty())
+				prim.lods[0] = {.index_start = 0, .index_count = static_cast<uint32>(index_count)};
+
+			uint32 start = 0;
+			for (size_t i = 0; i < counts.size() && i < MAX_MESH_LODS; i++)
+			{
+				prim.lods[i] = {.index_start = start, .index_count = counts[i]};
+				start += counts[i];
+			}
+
+			const size_t filled = counts.empty() ? 1 : (counts.size() < MAX_MESH_LODS ? counts.size() : MAX_MESH_LODS);
+			for (size_t i = filled; i < MAX_MESH_LODS; i++)
+				prim.lods[i] = prim.lods[filled - 1];
+
+			prim.indices_count = prim.lods[0].index_count;
+		};
+
+		auto copy_meshlets = [&](primitive& prim, const vector<meshlet>& meshlets) {
+			if (meshlets.empty())
+				return;
+
+			prim.meshlet_count = static_cast<uint32>(meshlets.size());
+			prim.meshlets	   = alloc.allocate<meshlet>(meshlets.size());
+			SFG_MEMCPY(alloc.get(prim.meshlets.head), meshlets.data(), sizeof(meshlet) * meshlets.size());
+		};
+
 		auto add_material = [&](uint16 m) {
 			int32 index = vector_util::index_of(materials, m);
 			if (index == -1)
@@ -40,13 +86,29 @@ namespace SFG
 			{
 				const primitive_static_raw& prim_loaded = raw.primitives_static[i];
 				primitive&					prim		= ptr[i];
-				prim.indices_count						= static_cast<uint32>(prim_loaded.indices.size());
+				fill_lods(prim, prim_loaded.lod_index_counts, prim_loaded.indices.size());
+				copy_meshlets(prim, prim_loaded.meshlets);
 				add_material(prim.material_index);
 
-				prim.indices  = alloc.allocate<primitive_index>(prim_loaded.indices.size());
-				prim.vertices = alloc.allocate<vertex_static>(prim_loaded.vertices.size());
+				prim.indices = alloc.allocate<primitive_index>(prim_loaded.indices.size());
 				SFG_MEMCPY(alloc.get(prim.indices.head), prim_loaded.indices.data(), sizeof(primitive_index) * prim_loaded.indices.size());
+
+				if (!prim_loaded.vertices_packed.empty())
+				{
+					prim.is_packed	 = 1;
+					prim.vertex_size = static_cast<uint16>(sizeof(vertex_static_packed));
+					prim.vertices	 = alloc.allocate<vertex_static_packed>(prim_loaded.vertices_packed.size());
+					SFG_MEMCPY(alloc.get(prim.vertices.head), prim_loaded.vertices_packed.data(), sizeof(vertex_static_packed) * prim_loaded.vertices_packed.size());
+					add_packed_bounds();
+					continue;
+				}
+
+				prim.vertex_size = static_cast<uint16>(sizeof(vertex_static));
+				prim.vertices	 = alloc.allocate<vertex_static>(prim_loaded.vertices.size());
 				SFG_MEMCPY(alloc.get(prim.vertices.head), prim_loaded.vertices.data(), sizeof(vertex_static) * prim_loaded.vertices.size());
+
+				for (const vertex_static& v : prim_loaded.vertices)
+					add_bounds(v.pos);
 			}
 		}
 
@@ -60,16 +122,34 @@ namespace SFG
 			{
 				const primitive_skinned_raw& prim_loaded = raw.primitives_skinned[i];
 				primitive&					 prim		 = ptr[i];
-				prim.indices_count						 = static_cast<uint32>(prim_loaded.indices.size());
+				fill_lods(prim, prim_loaded.lod_index_counts, prim_loaded.indices.size());
+				copy_meshlets(prim, prim_loaded.meshlets);
 
 				add_material(prim.material_index);
-				prim.indices  = alloc.allocate<primitive_index>(prim_loaded.indices.size());
-				prim.vertices = alloc.allocate<vertex_skinned>(prim_loaded.vertices.size());
+				prim.indices = alloc.allocate<primitive_index>(prim_loaded.indices.size());
 				SFG_MEMCPY(alloc.get(prim.indices.head), prim_loaded.indices.data(), sizeof(primitive_index) * prim_loaded.indices.size());
+
+				if (!prim_loaded.vertices_packed.empty())
+				{
+					prim.is_packed	 = 1;
+					prim.vertex_size = static_cast<uint16>(sizeof(vertex_skinned_packed));
+					prim.vertices	 = alloc.allocate<vertex_skinned_packed>(prim_loaded.vertices_packed.size());
+					SFG_MEMCPY(alloc.get(prim.vertices.head), prim_loaded.vertices_packed.data(), sizeof(vertex_skinned_packed) * prim_loaded.vertices_packed.size());
+					add_packed_bounds();
+					continue;
+				}
+
+				prim.vertex_size = static_cast<uint16>(sizeof(vertex_skinned));
+				prim.vertices	 = alloc.allocate<vertex_skinned>(prim_loaded.vertices.size());
 				SFG_MEMCPY(alloc.get(prim.vertices.head), prim_loaded.vertices.data(), sizeof(vertex_skinned) * prim_loaded.vertices.size());
+
+				for (const vertex_skinned& v : prim_loaded.vertices)
+					add_bounds(v.pos);
 			}
 		}
 
+		_local_aabb = bounds_min.x <= bounds_max.x ? aabb(bounds_min, bounds_max) : aabb();
+
 		_material_count	  = static_cast<uint16>(materials.size());
 		_material_indices = alloc.allocate<uint16>(materials.size());
 		SFG_MEMCPY(alloc.get(_material_indices.head), materials.data(), sizeof(uint16) * materials.size());
@@ -116,6 +196,8 @@ namespace SFG
 				primitive& prim = ptr[i];
 				alloc.free(prim.indices);
 				alloc.free(prim.vertices);
+				if (prim.meshlet_count != 0)
+					alloc.free(prim.meshlets);
 			}
 
 			alloc.free(_primitives_static);
@@ -130,6 +212,8 @@ namespace SFG
 				primitive& prim = ptr[i];
 				alloc.free(prim.indices);
 				alloc.free(prim.vertices);
+				if (prim.meshlet_count != 0)
+					alloc.free(prim.meshlets);
 			}
 
 			alloc.free(_primitives_skinned);
@@ -144,5 +228,8 @@ namespace SFG
 		_primitives_static_count  = 0;
 		_primitives_skinned_count = 0;
 		_material_count			  = 0;
+		_local_aabb				  = {};
+		_quantization			  = {};
+		_lod_count				  = 1;
 	}
 }
\ No newline at end of file
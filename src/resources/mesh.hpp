@@ -3,6 +3,9 @@
 #include "common/size_definitions.hpp"
 #include "resources/common_resources.hpp"
 #include "memory/chunk_handle.hpp"
+#include "math/aabb.hpp"
+#include "resources/vertex.hpp"
+#include "gfx/common/gfx_constants.hpp"
 
 namespace SFG
 {
@@ -53,18 +56,42 @@ namespace SFG
 			return _material_count;
 		}
 
+		inline const aabb& get_local_aabb() const
+		{
+			return _local_aabb;
+		}
+
+		inline const vertex_quantization& get_quantization() const
+		{
+			return _quantization;
+		}
+
+		inline const float* get_lod_errors() const
+		{
+			return _lod_errors;
+		}
+
+		inline uint8 get_lod_count() const
+		{
+			return _lod_count;
+		}
+
 	private:
 		friend class model;
 
 	private:
-		uint16		   _node_index	   = 0;
-		uint16		   _material_count = 0;
-		chunk_handle32 _name;
-		chunk_handle32 _primitives_static;
-		chunk_handle32 _primitives_skinned;
-		chunk_handle32 _material_indices; // original indices into the loaded model.
-		uint16		   _primitives_static_count	 = 0;
-		uint16		   _primitives_skinned_count = 0;
+		aabb				_local_aabb				   = {};
+		vertex_quantization _quantization			   = {};
+		float				_lod_errors[MAX_MESH_LODS] = {};
+		uint16				_node_index				   = 0;
+		uint16				_material_count			   = 0;
+		chunk_handle32		_name;
+		chunk_handle32		_primitives_static;
+		chunk_handle32		_primitives_skinned;
+		chunk_handle32		_material_indices; // original indices into the loaded model.
+		uint16				_primitives_static_count  = 0;
+		uint16				_primitives_skinned_count = 0;
+		uint8				_lod_count				  = 1;
 	};
 
 }
\ No newline at end of file
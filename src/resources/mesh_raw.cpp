@@ -15,6 +15,8 @@ namespace SFG
 		stream << name;
 		stream << sid;
 		stream << node_index;
+		stream << quantization;
+		stream << lod_errors;
 		stream << primitives_static;
 		stream << primitives_skinned;
 	}
@@ -24,6 +26,8 @@ namespace SFG
 		stream >> name;
 		stream >> sid;
 		stream >> node_index;
+		stream >> quantization;
+		stream >> lod_errors;
 		stream >> primitives_static;
 		stream >> primitives_skinned;
 	}
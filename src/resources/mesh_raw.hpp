@@ -17,6 +17,8 @@ namespace SFG
 		string						  name		 = "";
 		string_id					  sid		 = 0;
 		uint16						  node_index = 0;
+		vertex_quantization			  quantization;
+		vector<float>				  lod_errors; // geometric error of every level in mesh units, empty without a LOD chain.
 		vector<primitive_static_raw>  primitives_static;
 		vector<primitive_skinned_raw> primitives_skinned;
 
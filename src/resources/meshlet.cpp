@@ -0,0 +1,28 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "meshlet.hpp"
+#include "data/ostream.hpp"
+#include "data/istream.hpp"
+
+namespace SFG
+{
+	void meshlet::serialize(ostream& stream) const
+	{
+		stream << center;
+		stream << radius;
+		stream << cone_axis;
+		stream << cone_cutoff;
+		stream << index_start;
+		stream << index_count;
+	}
+
+	void meshlet::deserialize(istream& stream)
+	{
+		stream >> center;
+		stream >> radius;
+		stream >> cone_axis;
+		stream >> cone_cutoff;
+		stream >> index_start;
+		stream >> index_count;
+	}
+}
@@ -0,0 +1,28 @@
+// Copyright (c) 2025 Inan Evin
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "math/vector3.hpp"
+
+namespace SFG
+{
+	class ostream;
+	class istream;
+
+	/// A contiguous triangle range of a primitive's first level, indices relative to the primitive.
+	/// Bounds are in mesh space. The cluster faces away from any camera within the cone, see cluster_culler.
+	struct meshlet
+	{
+		vector3 center		= vector3::zero;
+		float	radius		= 0.0f;
+		vector3 cone_axis	= vector3::zero;
+		float	cone_cutoff = 1.0f; // sin of the cone's half angle, 1 never culls.
+		uint32	index_start = 0;
+		uint32	index_count = 0;
+
+		static constexpr bool bulk_serializable = true;
+
+		void serialize(ostream& stream) const;
+		void deserialize(istream& stream);
+	};
+}
@@ -18,7 +18,6 @@ namespace SFG
 		{
 			_name = alloc.allocate<uint8>(raw.name.size() + 1);
 			strcpy((char*)alloc.get(_name.head), raw.name.data());
-			strcpy((char*)(alloc.get(_name.head + _name.size)), "\0");
 		}
 
 		_parent_index = raw.parent_index;
@@ -7,9 +7,15 @@
 #ifdef SFG_TOOLMODE
 
 #include "io/log.hpp"
+#include "io/file_system.hpp"
+#include "project/engine_data.hpp"
 #include "data/vector_util.hpp"
 #include "math/math.hpp"
+#include "gfx/util/mesh_util.hpp"
+#include "gfx/util/vertex_util.hpp"
 #include "vendor/nhlohmann/json.hpp"
+#include <fstream>
+using json = nlohmann::json;
 
 #define TINYGLTF_NO_INCLUDE_STB_IMAGE
 #define TINYGLTF_NO_INCLUDE_STB_IMAGE_WRITE
@@ -52,6 +58,9 @@ namespace SFG
 	}
 
 #ifdef SFG_TOOLMODE
+
+#define MODEL_LOD_MIN_REDUCTION 0.9f
+
 	namespace
 	{
 		matrix4x4 make_mat(const vector<double>& d)
@@ -70,6 +79,206 @@ namespace SFG
 			return mat;
 		}
 
+		/// weld, reorder for post-transform cache & overdraw, then for fetch locality.
+		auto optimize_prim = [](auto& prim, const char* mesh_name) {
+			const size_t				 vertex_size = sizeof(prim.vertices[0]);
+			const mesh_util::cache_stats before		 = mesh_util::analyze(prim.indices.data(), prim.indices.size(), prim.vertices.size(), vertex_size);
+			mesh_util::optimize(prim.vertices, prim.indices);
+			const mesh_util::cache_stats after = mesh_util::analyze(prim.indices.data(), prim.indices.size(), prim.vertices.size(), vertex_size);
+			SFG_INFO("Optimized mesh {0}: vertices {1} -> {2}, ACMR {3} -> {4}, ATVR {5} -> {6}", mesh_name, before.vertices, after.vertices, before.acmr, after.acmr, before.atvr, after.atvr);
+		};
+
+		/// clusters the first level for culling, then restores fetch locality for the new triangle order. Primitives fitting into one meshlet are left alone.
+		template <typename PRIM> void build_prim_meshlets(PRIM& prim, const char* mesh_name)
+		{
+			const size_t index_count = prim.indices.size();
+			prim.meshlets.clear();
+			if (index_count / 3 <= MESH_MESHLET_TRIANGLES)
+				return;
+
+			const size_t			vertex_size = sizeof(prim.vertices[0]);
+			vector<primitive_index> clustered(index_count);
+			mesh_util::build_meshlets(prim.meshlets, clustered.data(), prim.indices.data(), index_count, reinterpret_cast<const uint8*>(&prim.vertices[0].pos), vertex_size, reinterpret_cast<const uint8*>(&prim.vertices[0].normal), vertex_size, prim.vertices.size());
+
+			vector<uint32> remap(prim.vertices.size());
+			auto		   vertices = prim.vertices;
+			mesh_util::generate_fetch_remap(remap.data(), clustered.data(), index_count, vertices.size());
+			mesh_util::remap_indices(prim.indices.data(), clustered.data(), index_count, remap.data());
+			mesh_util::remap_vertices(prim.vertices.data(), vertices.data(), vertices.size(), vertex_size, remap.data());
+
+			const mesh_util::cache_stats stats = mesh_util::analyze(prim.indices.data(), index_count, prim.vertices.size(), vertex_size);
+			SFG_INFO("Built {0} meshlets for mesh {1}, ACMR {2}", prim.meshlets.size(), mesh_name, stats.acmr);
+		}
+
+		/// every level is simplified from the previous one, errors accumulate so they bound the distance to the base mesh.
+		template <typename PRIM> uint8 generate_prim_lods(PRIM& prim, uint8 lod_count, float reduction, float max_error, float* out_errors)
+		{
+			const size_t			base_count = prim.indices.size();
+			vector<primitive_index> level	   = prim.indices;
+			vector<primitive_index> simplified(base_count);
+			vector<primitive_index> optimized(base_count);
+			float					error  = 0.0f;
+			uint8					levels = 1;
+
+			prim.lod_index_counts = {static_cast<uint32>(base_count)};
+
+			for (; levels < lod_count; levels++)
+			{
+				const size_t target		 = static_cast<size_t>(static_cast<float>(level.size()) * reduction) / 3 * 3;
+				float		 level_error = 0.0f;
+				const size_t count		 = mesh_util::simplify(simplified.data(), level.data(), level.size(), reinterpret_cast<const uint8*>(&prim.vertices[0].pos), sizeof(prim.vertices[0]), prim.vertices.size(), target, max_error, &level_error);
+
+				// not worth another level.
+				if (count == 0 || static_cast<float>(count) > static_cast<float>(level.size()) * MODEL_LOD_MIN_REDUCTION)
+					break;
+
+				mesh_util::optimize_vertex_cache(optimized.data(), simplified.data(), count, prim.vertices.size());
+				level.assign(optimized.begin(), optimized.begin() + count);
+				error += level_error;
+				out_errors[levels] = math::max(out_errors[levels], error);
+
+				prim.indices.insert(prim.indices.end(), level.begin(), level.end());
+				prim.lod_index_counts.push_back(static_cast<uint32>(count));
+			}
+
+			if (levels == 1)
+				prim.lod_index_counts.clear();
+
+			return levels;
+		}
+
+		template <typename PRIM> size_t get_lod_triangles(const PRIM& prim, uint8 level)
+		{
+			if (prim.lod_index_counts.empty())
+				return prim.indices.size() / 3;
+
+			const size_t last = prim.lod_index_counts.size() - 1;
+			return prim.lod_index_counts[level < last ? level : last] / 3;
+		}
+
+		void generate_lods(mesh_raw& mesh, uint8 lod_count, float reduction, float max_error)
+		{
+			float errors[MAX_MESH_LODS] = {};
+			uint8 levels				= 1;
+			lod_count					= lod_count < MAX_MESH_LODS ? lod_count : MAX_MESH_LODS;
+
+			for (primitive_static_raw& prim : mesh.primitives_static)
+			{
+				if (prim.vertices.empty())
+					continue;
+
+				const uint8 prim_levels = generate_prim_lods(prim, lod_count, reduction, max_error, errors);
+				levels					= prim_levels > levels ? prim_levels : levels;
+			}
+
+			for (primitive_skinned_raw& prim : mesh.primitives_skinned)
+			{
+				if (prim.vertices.empty())
+					continue;
+
+				const uint8 prim_levels = generate_prim_lods(prim, lod_count, reduction, max_error, errors);
+				levels					= prim_levels > levels ? prim_levels : levels;
+			}
+
+			if (levels == 1)
+				return;
+
+			// a primitive with a shorter chain could leave a level with a smaller error than the previous one.
+			for (uint8 i = 1; i < levels; i++)
+				errors[i] = math::max(errors[i], errors[i - 1]);
+
+			mesh.lod_errors.assign(errors, errors + levels);
+
+			for (uint8 i = 0; i < levels; i++)
+			{
+				size_t triangles = 0;
+				for (const primitive_static_raw& prim : mesh.primitives_static)
+					triangles += get_lod_triangles(prim, i);
+				for (const primitive_skinned_raw& prim : mesh.primitives_skinned)
+					triangles += get_lod_triangles(prim, i);
+
+				SFG_INFO("Mesh {0} LOD {1}: {2} triangles, error {3}", mesh.name, i, triangles, errors[i]);
+			}
+		}
+
+		/// all primitives share the mesh quantization, skinned ones referencing joints past 255 stay unpacked.
+		void pack_mesh(mesh_raw& mesh)
+		{
+			vector3 bounds_min = vector3(MATH_INF_F, MATH_INF_F, MATH_INF_F);
+			vector3 bounds_max = vector3(-MATH_INF_F, -MATH_INF_F, -MATH_INF_F);
+
+			for (const primitive_static_raw& prim : mesh.primitives_static)
+			{
+				for (const vertex_static& v : prim.vertices)
+				{
+					bounds_min = vector3::min(bounds_min, v.pos);
+					bounds_max = vector3::max(bounds_max, v.pos);
+				}
+			}
+
+			for (const primitive_skinned_raw& prim : mesh.primitives_skinned)
+			{
+				for (const vertex_skinned& v : prim.vertices)
+				{
+					bounds_min = vector3::min(bounds_min, v.pos);
+					bounds_max = vector3::max(bounds_max, v.pos);
+				}
+			}
+
+			mesh.quantization = vertex_util::calculate_quantization(bounds_min, bounds_max);
+
+			vertex_util::pack_error err		   = {};
+			size_t					size_full  = 0;
+			size_t					size_after = 0;
+
+			for (primitive_static_raw& prim : mesh.primitives_static)
+			{
+				const size_t count = prim.vertices.size();
+				prim.vertices_packed.resize(count);
+
+				for (size_t i = 0; i < count; i++)
+				{
+					vertex_static decoded = {};
+					vertex_util::pack(prim.vertices[i], mesh.quantization, prim.vertices_packed[i]);
+					vertex_util::unpack(prim.vertices_packed[i], mesh.quantization, decoded);
+					vertex_util::measure_error(prim.vertices[i], decoded, err);
+				}
+
+				size_full += count * sizeof(vertex_static);
+				size_after += count * sizeof(vertex_static_packed);
+				prim.vertices.clear();
+			}
+
+			for (primitive_skinned_raw& prim : mesh.primitives_skinned)
+			{
+				const size_t count = prim.vertices.size();
+				prim.vertices_packed.resize(count);
+				size_full += count * sizeof(vertex_skinned);
+
+				bool packed = true;
+				for (size_t i = 0; i < count && packed; i++)
+				{
+					vertex_skinned decoded = {};
+					packed				   = vertex_util::pack(prim.vertices[i], mesh.quantization, prim.vertices_packed[i]);
+					vertex_util::unpack(prim.vertices_packed[i], mesh.quantization, decoded);
+					vertex_util::measure_error(prim.vertices[i], decoded, err);
+				}
+
+				if (!packed)
+				{
+					SFG_WARN("Mesh {0} has joint indices past 255, keeping full precision vertices.", mesh.name);
+					prim.vertices_packed.clear();
+					size_after += count * sizeof(vertex_skinned);
+					continue;
+				}
+
+				size_after += count * sizeof(vertex_skinned_packed);
+				prim.vertices.clear();
+			}
+
+			SFG_INFO("Packed mesh {0}: {1} -> {2} bytes, max error position {3} normal {4} tangent {5} uv {6} weight {7}", mesh.name, size_full, size_after, err.position, err.normal, err.tangent, err.uv, err.weight);
+		}
+
 		auto fill_prim = [](auto&						prim,
 							const tinygltf::Model&		model,
 							const tinygltf::Primitive&	tprim,
@@ -111,30 +320,19 @@ namespace SFG
 				prim.indices.resize(start_indices + num_indices);
 				SFG_ASSERT(num_indices % 3 == 0);
 
-				if (index_a.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
-				{
-					uint8* data = (uint8*)&index_b.data[index_a.byteOffset + index_bv.byteOffset];
-					for (uint32 k = 0; k < num_indices; k++)
-						prim.indices[start_indices + k] = static_cast<primitive_index>(data[k]);
-				}
-				else if (index_a.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
+				// primitives sharing a material are merged, indices are rebased onto the merged vertices.
+				const uint8* index_data = &index_b.data[index_a.byteOffset + index_bv.byteOffset];
+				for (size_t k = 0; k < num_indices; k++)
 				{
-					if (sizeof(primitive_index) == sizeof(uint16))
-					{
-						SFG_MEMCPY(prim.indices.data() + start_indices * sizeof(primitive_index), &index_b.data[index_a.byteOffset + index_bv.byteOffset], num_indices * sizeof(uint16));
-					}
+					size_t index = 0;
+					if (index_a.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
+						index = index_data[k];
+					else if (index_a.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
+						index = reinterpret_cast<const uint16*>(index_data)[k];
 					else
-					{
-						// our indices are 32 bit, need to cast
-						uint16* data = (uint16*)&index_b.data[index_a.byteOffset + index_bv.byteOffset];
+						index = reinterpret_cast<const uint32*>(index_data)[k];
 
-						for (uint32 k = 0; k < num_indices; k++)
-							prim.indices[start_indices + k] = static_cast<uint32>(data[k]);
-					}
-				}
-				else
-				{
-					SFG_MEMCPY(prim.indices.data() + start_indices * sizeof(primitive_index), &index_b.data[index_a.byteOffset + index_bv.byteOffset], num_indices * sizeof(uint32));
+					prim.indices[start_indices + k] = static_cast<primitive_index>(start_vertices + index);
 				}
 			}
 
@@ -238,12 +436,42 @@ namespace SFG
 	}
 	bool model_raw::cook_from_file(const char* file, const char* relative_path)
 	{
+		// a descriptor names the gltf source along with the cook options, a bare gltf cooks with the defaults.
+		string source = file;
+		if (file_system::get_file_extension(file) == "stkfrg")
+		{
+			if (!file_system::exists(file))
+			{
+				SFG_ERR("File doesn't exist! {0}", file);
+				return false;
+			}
+
+			try
+			{
+				std::ifstream f(file);
+				json		  json_data = json::parse(f);
+				f.close();
+
+				source		   = engine_data::get().get_working_dir() + json_data.value<string>("source", "");
+				pack_vertices  = json_data.value<uint8>("pack_vertices", 0);
+				build_meshlets = json_data.value<uint8>("build_meshlets", 1);
+				lod_count	   = json_data.value<uint8>("lod_count", 1);
+				lod_reduction  = json_data.value<float>("lod_reduction", 0.5f);
+				lod_max_error  = json_data.value<float>("lod_max_error", 0.05f);
+			}
+			catch (std::exception e)
+			{
+				SFG_ERR("Failed loading model descriptor: {0}", e.what());
+				return false;
+			}
+		}
+
 		tinygltf::Model	   model;
 		tinygltf::TinyGLTF loader;
 		loader.SetPreserveImageChannels(false);
 
 		string err = "", warn = "";
-		bool   ret = loader.LoadASCIIFromFile(&model, &err, &warn, file);
+		bool   ret = loader.LoadASCIIFromFile(&model, &err, &warn, source);
 
 		if (!warn.empty())
 		{
@@ -258,7 +486,7 @@ namespace SFG
 
 		if (!ret)
 		{
-			SFG_ERR("Loading model failed! {0}", file);
+			SFG_ERR("Loading model failed! {0}", source);
 			return false;
 		}
 
@@ -363,6 +591,27 @@ namespace SFG
 				fill_prim(prim, model, tprim, vertex_accessor, vertex_buffer_view, vertex_buffer, num_vertices, start_vertex, start_index);
 			}
 
+			for (primitive_static_raw& prim : mesh.primitives_static)
+				optimize_prim(prim, mesh.name.c_str());
+
+			for (primitive_skinned_raw& prim : mesh.primitives_skinned)
+				optimize_prim(prim, mesh.name.c_str());
+
+			if (build_meshlets)
+			{
+				for (primitive_static_raw& prim : mesh.primitives_static)
+					build_prim_meshlets(prim, mesh.name.c_str());
+
+				for (primitive_skinned_raw& prim : mesh.primitives_skinned)
+					build_prim_meshlets(prim, mesh.name.c_str());
+			}
+
+			if (lod_count > 1)
+				generate_lods(mesh, lod_count, lod_reduction, lod_max_error);
+
+			if (pack_vertices)
+				pack_mesh(mesh);
+
 			const size_t all_nodes_sz = model.nodes.size();
 			loaded_nodes.resize(all_nodes_sz);
 
@@ -21,6 +21,11 @@ namespace SFG
 		vector<animation_raw>  loaded_animations;
 		aabb				   total_aabb;
 		uint8				   material_count = 0;
+		uint8				   pack_vertices  = 0; // cook options, read from the model descriptor & not serialized.
+		uint8				   build_meshlets = 1;
+		uint8				   lod_count	  = 1; // levels including the base, 1 skips generate_lods.
+		float				   lod_reduction  = 0.5f;  // triangle ratio of each level to the previous one.
+		float				   lod_max_error  = 0.05f; // relative to the mesh extent.
 
 		void serialize(ostream& stream) const;
 		void deserialize(istream& stream);
@@ -3,13 +3,24 @@
 
 #include "common/size_definitions.hpp"
 #include "memory/chunk_handle.hpp"
+#include "gfx/common/gfx_constants.hpp"
 
 namespace SFG
 {
+	/// Starts are kept per render data index, the render thread only patches the copy of the index it's working on.
 	struct primitive_runtime
 	{
-		uint32 vertex_start = 0;
-		uint32 index_start	= 0;
+		uint32 vertex_start[THREAD_BUFFER_COUNT] = {};		   // in vertices, not bytes.
+		uint32 index_start[THREAD_BUFFER_COUNT]	 = {};		   // in indices, not bytes.
+		uint32 vertex_range						 = UINT32_MAX; // geometry heap ranges.
+		uint32 index_range						 = UINT32_MAX;
+	};
+
+	/// Relative to the primitive's own indices.
+	struct primitive_lod
+	{
+		uint32 index_start = 0;
+		uint32 index_count = 0;
 	};
 
 	struct primitive
@@ -19,6 +30,11 @@ namespace SFG
 		chunk_handle32	  vertices;
 		chunk_handle32	  indices;
 		uint32			  indices_count = 0;
+		uint16			  vertex_size	= 0;
+		uint8			  is_packed		= 0;
+		primitive_lod	  lods[MAX_MESH_LODS];
+		chunk_handle32	  meshlets;
+		uint32			  meshlet_count = 0;
 	};
 
 }
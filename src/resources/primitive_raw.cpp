@@ -10,24 +10,36 @@ namespace SFG
 	{
 		stream << material_index;
 		stream << vertices;
+		stream << vertices_packed;
 		stream << indices;
+		stream << lod_index_counts;
+		stream << meshlets;
 	}
 	void primitive_static_raw::deserialize(istream& stream)
 	{
 		stream >> material_index;
 		stream >> vertices;
+		stream >> vertices_packed;
 		stream >> indices;
+		stream >> lod_index_counts;
+		stream >> meshlets;
 	}
 	void primitive_skinned_raw::serialize(ostream& stream) const
 	{
 		stream << material_index;
 		stream << vertices;
+		stream << vertices_packed;
 		stream << indices;
+		stream << lod_index_counts;
+		stream << meshlets;
 	}
 	void primitive_skinned_raw::deserialize(istream& stream)
 	{
 		stream >> material_index;
 		stream >> vertices;
+		stream >> vertices_packed;
 		stream >> indices;
+		stream >> lod_index_counts;
+		stream >> meshlets;
 	}
 }
\ No newline at end of file
@@ -5,17 +5,24 @@
 #include "data/vector.hpp"
 #include "gfx/common/gfx_constants.hpp"
 #include "vertex.hpp"
+#include "meshlet.hpp"
 
 namespace SFG
 {
 	class ostream;
 	class istream;
 
+	/// Either vertices or vertices_packed is filled, packed ones are decoded with the owning mesh's quantization.
+	/// With a LOD chain, indices holds every level back to back and lod_index_counts their sizes, all levels share the vertices.
+	/// meshlets split the first level into clusters for culling, empty for primitives too small to bother.
 	struct primitive_static_raw
 	{
-		uint16					material_index = 0;
-		vector<vertex_static>	vertices;
-		vector<primitive_index> indices;
+		uint16						 material_index = 0;
+		vector<vertex_static>		 vertices;
+		vector<vertex_static_packed> vertices_packed;
+		vector<primitive_index>		 indices;
+		vector<uint32>				 lod_index_counts;
+		vector<meshlet>				 meshlets;
 
 		void serialize(ostream& stream) const;
 		void deserialize(istream& stream);
@@ -23,9 +30,12 @@ namespace SFG
 
 	struct primitive_skinned_raw
 	{
-		uint16					material_index = 0;
-		vector<vertex_skinned>	vertices;
-		vector<primitive_index> indices;
+		uint16						  material_index = 0;
+		vector<vertex_skinned>		  vertices;
+		vector<vertex_skinned_packed> vertices_packed;
+		vector<primitive_index>		  indices;
+		vector<uint32>				  lod_index_counts;
+		vector<meshlet>				  meshlets;
 
 		void serialize(ostream& stream) const;
 		void deserialize(istream& stream);
@@ -26,6 +26,7 @@ namespace SFG
 		_hw = backend->create_shader(raw.desc);
 		_flags.set(shader::flags::hw_exists);
 		_flags.set(shader::flags::is_skinned, raw.is_skinned);
+		_flags.set(shader::flags::is_packed, raw.is_packed);
 	}
 
 	void shader::destroy()
@@ -21,6 +21,7 @@ namespace SFG
 		{
 			is_skinned = 1 << 0,
 			hw_exists  = 1 << 1,
+			is_packed  = 1 << 2,
 		};
 
 		~shader();
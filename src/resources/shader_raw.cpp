@@ -8,6 +8,7 @@
 #include "io/file_system.hpp"
 #include "project/engine_data.hpp"
 #include "gfx/backend/backend.hpp"
+#include "gfx/util/gfx_util.hpp"
 #include "vendor/nhlohmann/json.hpp"
 #include <fstream>
 using json = nlohmann::json;
@@ -51,7 +52,7 @@ namespace SFG
 
 		for (const shader_color_attachment& att : desc.attachments)
 		{
-			stream << att.format;
+			stream << att.attachment_format;
 			stream << att.blend_attachment.blend_enabled;
 			stream << att.blend_attachment.src_alpha_blend_factor;
 			stream << att.blend_attachment.dst_alpha_blend_factor;
@@ -66,11 +67,11 @@ namespace SFG
 		{
 			stream << desc.depth_stencil_desc.attachment_format;
 			stream << desc.depth_stencil_desc.depth_compare;
-			stream << desc.depth_stencil_desc.back_stencil_state.compare_op;
+			stream << desc.depth_stencil_desc.back_stencil_state.cmp_op;
 			stream << desc.depth_stencil_desc.back_stencil_state.depth_fail_op;
 			stream << desc.depth_stencil_desc.back_stencil_state.fail_op;
 			stream << desc.depth_stencil_desc.back_stencil_state.pass_op;
-			stream << desc.depth_stencil_desc.front_stencil_state.compare_op;
+			stream << desc.depth_stencil_desc.front_stencil_state.cmp_op;
 			stream << desc.depth_stencil_desc.front_stencil_state.depth_fail_op;
 			stream << desc.depth_stencil_desc.front_stencil_state.fail_op;
 			stream << desc.depth_stencil_desc.front_stencil_state.pass_op;
@@ -92,7 +93,7 @@ namespace SFG
 			stream << inp.index;
 			stream << static_cast<uint32>(inp.offset);
 			stream << static_cast<uint32>(inp.size);
-			stream << inp.format;
+			stream << inp.input_format;
 		}
 
 		stream << desc.blend_logic_op;
@@ -145,7 +146,7 @@ namespace SFG
 		{
 			shader_color_attachment& att   = desc.attachments[i];
 			uint8					 flags = 0;
-			stream >> att.format;
+			stream >> att.attachment_format;
 			stream >> att.blend_attachment.blend_enabled;
 			stream >> att.blend_attachment.src_alpha_blend_factor;
 			stream >> att.blend_attachment.dst_alpha_blend_factor;
@@ -162,11 +163,11 @@ namespace SFG
 			uint8 flags = 0;
 			stream >> desc.depth_stencil_desc.attachment_format;
 			stream >> desc.depth_stencil_desc.depth_compare;
-			stream >> desc.depth_stencil_desc.back_stencil_state.compare_op;
+			stream >> desc.depth_stencil_desc.back_stencil_state.cmp_op;
 			stream >> desc.depth_stencil_desc.back_stencil_state.depth_fail_op;
 			stream >> desc.depth_stencil_desc.back_stencil_state.fail_op;
 			stream >> desc.depth_stencil_desc.back_stencil_state.pass_op;
-			stream >> desc.depth_stencil_desc.front_stencil_state.compare_op;
+			stream >> desc.depth_stencil_desc.front_stencil_state.cmp_op;
 			stream >> desc.depth_stencil_desc.front_stencil_state.depth_fail_op;
 			stream >> desc.depth_stencil_desc.front_stencil_state.fail_op;
 			stream >> desc.depth_stencil_desc.front_stencil_state.pass_op;
@@ -193,7 +194,7 @@ namespace SFG
 			stream >> inp.index;
 			stream >> offset;
 			stream >> size;
-			stream >> inp.format;
+			stream >> inp.input_format;
 
 			inp.offset = static_cast<size_t>(offset);
 			inp.size   = static_cast<size_t>(size);
@@ -212,6 +213,7 @@ namespace SFG
 		stream << name;
 		stream << defines;
 		stream << is_skinned;
+		stream << is_packed;
 		serialize(stream, desc);
 	}
 
@@ -220,6 +222,7 @@ namespace SFG
 		stream >> name;
 		stream >> defines;
 		stream >> is_skinned;
+		stream >> is_packed;
 		deserialize(stream, desc);
 	}
 
@@ -242,6 +245,15 @@ namespace SFG
 			desc	   = json_data.value<shader_desc>("desc", {});
 			defines	   = json_data.value<vector<string>>("defines", {});
 			is_skinned = json_data.value<uint8>("is_skinned", 0);
+			is_packed  = json_data.value<uint8>("is_packed", 0);
+
+			// a packed variant compiles the same source, inputs follow the packed vertex layouts unless the descriptor lists them.
+			if (is_packed)
+			{
+				defines.push_back("SFG_PACKED_VERTICES");
+				if (desc.inputs.empty())
+					desc.inputs = gfx_util::get_input_layout(is_skinned ? input_layout_type::mesh_skinned_packed : input_layout_type::mesh_static_packed);
+			}
 
 			const string source = engine_data::get().get_working_dir() + name;
 			if (!file_system::exists(source.c_str()))
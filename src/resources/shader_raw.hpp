@@ -19,6 +19,7 @@ namespace SFG
 		shader_desc	   desc		  = {};
 		vector<string> defines	  = {};
 		uint8		   is_skinned = 0;
+		uint8		   is_packed  = 0; // cooked with SFG_PACKED_VERTICES defined, draws meshes cooked with pack_vertices.
 
 		shader_raw(){};
 		shader_raw(const shader_raw& temp_obj)			  = delete;
@@ -13,9 +13,8 @@ namespace SFG
 
 		if (!raw.name.empty())
 		{
-			_name = alloc.allocate<uint8>(raw.name.size());
+			_name = alloc.allocate<uint8>(raw.name.size() + 1);
 			strcpy((char*)alloc.get(_name.head), raw.name.data());
-			strcpy((char*)(alloc.get(_name.head + _name.size)), "\0");
 		}
 
 		_joints = alloc.allocate<skin_joint>(raw.joints.size());
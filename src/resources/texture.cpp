@@ -20,20 +20,30 @@ namespace SFG
 	void texture::create_from_raw(const texture_raw& raw)
 	{
 		_cpu_buffers = raw.buffers;
+		_format		 = raw.texture_format;
 
-		SFG_ASSERT(_cpu_buffers.empty());
+		SFG_ASSERT(!_cpu_buffers.empty());
+
+		// only the tail goes to the device here, the rest streams in on demand.
+		create_hw(texture_streamer::calculate_tail_mip(_cpu_buffers.data(), get_cpu_count()), raw.name.c_str());
+	}
 
+	void texture::create_hw(uint8 first_mip, const char* debug_name)
+	{
+		SFG_ASSERT(!_flags.is_set(texture::flags::hw_exists));
+		SFG_ASSERT(first_mip < _cpu_buffers.size());
+
+		_first_mip			 = first_mip;
 		gfx_backend* backend = gfx_backend::get();
 		_hw					 = backend->create_texture({
-							 .texture_format = static_cast<format>(raw.texture_format),
-							 .size			 = vector2ui16(get_width(), get_height()),
+							 .texture_format = static_cast<format>(_format),
+							 .size			 = _cpu_buffers[first_mip].size,
 							 .flags			 = texture_flags::tf_is_2d | texture_flags::tf_sampled,
 							 .views			 = {{}},
-							 .mip_levels	 = static_cast<uint8>(_cpu_buffers.size()),
+							 .mip_levels	 = static_cast<uint8>(_cpu_buffers.size() - first_mip),
 							 .array_length	 = 1,
 							 .samples		 = 1,
-							 .debug_name	 = raw.name.c_str(),
-
+							 .debug_name	 = debug_name,
 		 });
 
 		_flags.set(texture::flags::hw_exists);
@@ -41,11 +51,25 @@ namespace SFG
 		create_intermediate();
 	}
 
+	gfx_id texture::release_hw()
+	{
+		SFG_ASSERT(_flags.is_set(texture::flags::hw_exists));
+		_flags.remove(texture::flags::hw_exists);
+		return _hw;
+	}
+
+	gfx_id texture::release_intermediate()
+	{
+		SFG_ASSERT(_flags.is_set(texture::flags::intermediate_exists));
+		_flags.remove(texture::flags::intermediate_exists);
+		return _intermediate;
+	}
+
 	void texture::destroy_cpu()
 	{
 		for (texture_buffer& buf : _cpu_buffers)
 		{
-			PUSH_DEALLOCATION_SZ(buf.size.x * buf.size.y * buf.bpp);
+			PUSH_DEALLOCATION_SZ(buf.get_data_size());
 			SFG_FREE(buf.pixels);
 		}
 		_cpu_buffers.clear();
@@ -93,10 +117,13 @@ namespace SFG
 		SFG_ASSERT(!_flags.is_set(texture::flags::intermediate_exists));
 		gfx_backend* backend = gfx_backend::get();
 
-		uint32 total_size = 0;
-		for (const texture_buffer& buf : _cpu_buffers)
+		uint32		 total_size = 0;
+		const uint8	 count		= get_cpu_count();
+		for (uint8 i = _first_mip; i < count; i++)
 		{
-			total_size += backend->get_texture_size(buf.size.x, buf.size.y, buf.bpp);
+			// compressed data is laid out in rows of blocks.
+			const texture_buffer& buf = _cpu_buffers[i];
+			total_size += backend->get_texture_size(buf.get_row_pitch(), buf.get_row_count(), 1);
 		}
 
 		const uint32 intermediate_size = backend->align_texture_size(total_size);
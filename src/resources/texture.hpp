@@ -8,6 +8,7 @@
 #include "gfx/common/gfx_constants.hpp"
 #include "gfx/common/texture_buffer.hpp"
 #include "resources/common_resources.hpp"
+#include "gfx/world/texture_streamer.hpp"
 
 namespace SFG
 {
@@ -29,6 +30,9 @@ namespace SFG
 		void   create_from_raw(const texture_raw& raw);
 		void   destroy_cpu();
 		void   destroy();
+		void   create_hw(uint8 first_mip, const char* debug_name = "streamed_texture");
+		gfx_id release_hw();
+		gfx_id release_intermediate();
 		uint8  get_bpp() const;
 		uint16 get_width() const;
 		uint16 get_height() const;
@@ -54,6 +58,22 @@ namespace SFG
 			return _intermediate;
 		}
 
+		/// Most detailed mip the device copy holds, the tail first for textures that stream.
+		inline uint8 get_first_mip() const
+		{
+			return _first_mip;
+		}
+
+		inline uint16 get_stream_id() const
+		{
+			return _stream_id;
+		}
+
+		inline void set_stream_id(uint16 id)
+		{
+			_stream_id = id;
+		}
+
 	private:
 		void create_intermediate();
 		void destroy_intermediate();
@@ -63,6 +83,9 @@ namespace SFG
 		static_vector<texture_buffer, MAX_TEXTURE_MIPS> _cpu_buffers;
 		gfx_id											_hw			  = 0;
 		gfx_id											_intermediate = 0;
+		uint16											_stream_id	  = STREAM_INVALID_ID;
+		uint8											_format		  = 0;
+		uint8											_first_mip	  = 0;
 		bitmask<uint8>									_flags		  = 0;
 	};
 
@@ -15,6 +15,7 @@
 #include "project/engine_data.hpp"
 #include "gfx/common/format.hpp"
 #include "gfx/util/image_util.hpp"
+#include "gfx/util/block_compressor.hpp"
 #include <fstream>
 #include <vendor/nhlohmann/json.hpp>
 using json = nlohmann::json;
@@ -33,7 +34,8 @@ namespace SFG
 		{
 			stream << b.size;
 			stream << b.bpp;
-			stream.write_raw(b.pixels, static_cast<size_t>(b.size.x * b.size.y * b.bpp));
+			stream << b.block_size;
+			stream.write_raw(b.pixels, b.get_data_size());
 		}
 	}
 
@@ -48,8 +50,9 @@ namespace SFG
 			texture_buffer& b = buffers[i];
 			stream >> b.size;
 			stream >> b.bpp;
+			stream >> b.block_size;
 
-			const size_t pixels_size = b.size.x * b.size.y * b.bpp;
+			const size_t pixels_size = b.get_data_size();
 
 			SFG_ASSERT(pixels_size != 0);
 			b.pixels = reinterpret_cast<uint8*>(SFG_MALLOC(pixels_size));
@@ -77,11 +80,14 @@ namespace SFG
 			name		   = json_data.value<string>("source", "");
 			gen_mips	   = json_data.value<uint8>("gen_mips", 0);
 
-			const format fmt	   = static_cast<format>(static_cast<format>(texture_format));
-			const uint8	 channels  = format_get_channels(fmt);
-			const uint8	 bpp	   = format_get_bpp(fmt);
-			const bool	 is_linear = format_is_linear(fmt);
-			const string source	   = engine_data::get().get_working_dir() + name;
+			const uint8 is_normal_map = json_data.value<uint8>("normal_map", 0);
+
+			const format fmt		= static_cast<format>(static_cast<format>(texture_format));
+			const uint8	 channels	= format_get_channels(fmt);
+			const uint8	 block_size = format_get_block_size(fmt);
+			const uint8	 bpp		= block_size != 0 ? channels : format_get_bpp(fmt);
+			const bool	 is_linear	= format_is_linear(fmt);
+			const string source		= engine_data::get().get_working_dir() + name;
 			SFG_ASSERT(file_system::exists(source.c_str()));
 			SFG_ASSERT(fmt != format::undefined);
 
@@ -107,8 +113,34 @@ namespace SFG
 			buffers.resize(count);
 			buffers[0] = b;
 
-			if (gen_mips == 1)
-				image_util::generate_mips(buffers.data(), count, image_util::mip_gen_filter::box, channels, is_linear, false);
+			// 1 box, 2 kaiser.
+			if (gen_mips != 0)
+				image_util::generate_mips(buffers.data(), count, gen_mips == 2 ? image_util::mip_gen_filter::kaiser : image_util::mip_gen_filter::box, channels, is_linear, false, is_normal_map != 0);
+
+			// block formats are cooked from the 8 bit chain, every level is encoded & replaced.
+			if (block_size != 0)
+			{
+				if (size.x % 4 != 0 || size.y % 4 != 0)
+				{
+					SFG_ERR("Block compressed textures need a size multiple of 4: {0}", file);
+					for (texture_buffer& buf : buffers)
+					{
+						PUSH_DEALLOCATION_SZ(buf.get_data_size());
+						SFG_FREE(buf.pixels);
+					}
+					buffers.clear();
+					return false;
+				}
+
+				for (texture_buffer& buf : buffers)
+				{
+					texture_buffer compressed = {};
+					block_compressor::compress(buf, compressed, {.target = fmt});
+					PUSH_DEALLOCATION_SZ(buf.get_data_size());
+					SFG_FREE(buf.pixels);
+					buf = compressed;
+				}
+			}
 		}
 		catch (std::exception e)
 		{
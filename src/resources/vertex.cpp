@@ -5,6 +5,11 @@
 
 namespace SFG
 {
+	static_assert(sizeof(vertex_static) == 48, "vertex_static is bulk serialized, it can't have padding!");
+	static_assert(sizeof(vertex_skinned) == 72, "vertex_skinned is bulk serialized, it can't have padding!");
+	static_assert(sizeof(vertex_static_packed) == 20, "vertex_static_packed is bulk serialized, it can't have padding!");
+	static_assert(sizeof(vertex_skinned_packed) == 28, "vertex_skinned_packed is bulk serialized, it can't have padding!");
+
 	void vertex_static::serialize(ostream& stream) const
 	{
 		stream << pos;
@@ -38,4 +43,49 @@ namespace SFG
 		stream >> bone_weights;
 		stream >> bone_indices;
 	}
+
+	void vertex_quantization::serialize(ostream& stream) const
+	{
+		stream << position_min;
+		stream << position_extent;
+	}
+	void vertex_quantization::deserialize(istream& stream)
+	{
+		stream >> position_min;
+		stream >> position_extent;
+	}
+
+	void vertex_static_packed::serialize(ostream& stream) const
+	{
+		stream << pos.x << pos.y << pos.z << pos.w;
+		stream << normal.x << normal.y;
+		stream << tangent.x << tangent.y;
+		stream << uv;
+	}
+	void vertex_static_packed::deserialize(istream& stream)
+	{
+		stream >> pos.x >> pos.y >> pos.z >> pos.w;
+		stream >> normal.x >> normal.y;
+		stream >> tangent.x >> tangent.y;
+		stream >> uv;
+	}
+
+	void vertex_skinned_packed::serialize(ostream& stream) const
+	{
+		stream << pos.x << pos.y << pos.z << pos.w;
+		stream << normal.x << normal.y;
+		stream << tangent.x << tangent.y;
+		stream << uv;
+		stream.write_raw(bone_weights, 4);
+		stream.write_raw(bone_indices, 4);
+	}
+	void vertex_skinned_packed::deserialize(istream& stream)
+	{
+		stream >> pos.x >> pos.y >> pos.z >> pos.w;
+		stream >> normal.x >> normal.y;
+		stream >> tangent.x >> tangent.y;
+		stream >> uv;
+		stream.read_to_raw(bone_weights, 4);
+		stream.read_to_raw(bone_indices, 4);
+	}
 }
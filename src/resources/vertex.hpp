@@ -4,6 +4,9 @@
 #include "math/vector3.hpp"
 #include "math/vector4.hpp"
 #include "math/vector4i16.hpp"
+#include "math/vector4ui16.hpp"
+#include "math/vector2i16.hpp"
+#include "math/vector2ui16.hpp"
 
 namespace SFG
 {
@@ -17,6 +20,8 @@ namespace SFG
 		vector4 tangent = vector4::zero;
 		vector2 uv		= vector2::zero;
 
+		static constexpr bool bulk_serializable = true;
+
 		void serialize(ostream& stream) const;
 		void deserialize(istream& stream);
 	};
@@ -30,7 +35,47 @@ namespace SFG
 		vector4	   bone_weights = vector4::zero;
 		vector4i16 bone_indices = vector4i16::zero;
 
+		static constexpr bool bulk_serializable = true;
+
+		void serialize(ostream& stream) const;
+		void deserialize(istream& stream);
+	};
+
+	/// Packed positions are unorm16 within [position_min, position_min + position_extent].
+	struct vertex_quantization
+	{
+		vector3 position_min	= vector3::zero;
+		vector3 position_extent = vector3::one;
+
+		void serialize(ostream& stream) const;
+		void deserialize(istream& stream);
+	};
+
+	struct vertex_static_packed
+	{
+		vector4ui16 pos		= vector4ui16::zero; // xyz quantized, w tangent handedness, 0 -> -1, 65535 -> 1.
+		vector2i16	normal	= vector2i16::zero;	 // octahedral, snorm.
+		vector2i16	tangent = vector2i16::zero;	 // octahedral, snorm.
+		vector2ui16 uv		= vector2ui16::zero; // half floats.
+
+		static constexpr bool bulk_serializable = true;
+
+		void serialize(ostream& stream) const;
+		void deserialize(istream& stream);
+	};
+
+	struct vertex_skinned_packed
+	{
+		vector4ui16 pos				= vector4ui16::zero;
+		vector2i16	normal			= vector2i16::zero;
+		vector2i16	tangent			= vector2i16::zero;
+		vector2ui16 uv				= vector2ui16::zero;
+		uint8		bone_weights[4] = {}; // unorm, always sums up to 255.
+		uint8		bone_indices[4] = {};
+
+		static constexpr bool bulk_serializable = true;
+
 		void serialize(ostream& stream) const;
 		void deserialize(istream& stream);
 	};
-}
\ No newline at end of file
+}
@@ -39,6 +39,7 @@ namespace SFG
 			json		  json_data = json::parse(f);
 			f.close();
 
+			const string source = engine_data::get().get_working_dir() + json_data.value<string>("source", "");
 			if (!file_system::exists(source.c_str()))
 			{
 				SFG_ERR("File don't exist! {0}", source.c_str());
@@ -0,0 +1,36 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "bulk.hpp"
+#include "endianness.hpp"
+#include "io/log.hpp"
+
+namespace SFG
+{
+	bool bulk_header::validate(size_t expected_element_size, bool swappable, size_t available, size_t& skip) const
+	{
+		const size_t payload = static_cast<size_t>(padding) + static_cast<size_t>(count) * element_size;
+
+		if (version != SERIALIZATION_BULK_VERSION || alignment != SERIALIZATION_BULK_ALIGNMENT || padding >= alignment || payload > available)
+		{
+			SFG_ERR("[Serialization] -> Invalid bulk array, version {0} expected {1}, the data needs a re-cook!", version, SERIALIZATION_BULK_VERSION);
+			skip = available;
+			return false;
+		}
+
+		skip = payload;
+
+		if (element_size != expected_element_size)
+		{
+			SFG_ERR("[Serialization] -> Bulk element size {0} expected {1}, data was cooked with a different layout!", element_size, expected_element_size);
+			return false;
+		}
+
+		if (!swappable && ((flags & SERIALIZATION_BULK_BIG_ENDIAN) != 0) != endianness::should_swap())
+		{
+			SFG_ERR("[Serialization] -> Bulk data was written with a different endianness!");
+			return false;
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,34 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+
+namespace SFG
+{
+#define SERIALIZATION_BULK_ALIGNMENT  16
+#define SERIALIZATION_BULK_BIG_ENDIAN (1 << 0)
+#define SERIALIZATION_BULK_VERSION	  1
+
+	/*
+		Written in front of every bulk array:
+		[uint32 count][uint16 element_size][uint8 alignment][uint8 flags][uint8 version][uint8 padding][padding zeros][count * element_size bytes]
+		Padding places the payload on an alignment boundary relative to the stream start, so it can be viewed in place.
+		Bump SERIALIZATION_BULK_VERSION whenever this layout changes, data written with another version is refused.
+	*/
+	struct bulk_header
+	{
+		uint32 count		= 0;
+		uint16 element_size = 0;
+		uint8  alignment	= 0;
+		uint8  flags		= 0;
+		uint8  version		= SERIALIZATION_BULK_VERSION;
+		uint8  padding		= 0;
+
+		/// Checked in every build, logs the reason on failure. skip is set to what has to be dropped: the whole array if only the element layout
+		/// doesn't match, the rest of the stream if this isn't a bulk array of this version at all. available counts the bytes after the header.
+		bool validate(size_t expected_element_size, bool swappable, size_t available, size_t& skip) const;
+	};
+
+#define SERIALIZATION_BULK_HEADER_SIZE 10
+}
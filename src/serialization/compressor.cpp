@@ -2,78 +2,416 @@
 
 #include "compressor.hpp"
 #include "io/log.hpp"
+#include "io/assert.hpp"
 #include "data/istream.hpp"
 #include "data/ostream.hpp"
+#include "data/atomic.hpp"
+#include "memory/memory.hpp"
+#include "thread/job_system.hpp"
 #include <lz4/lz4.h>
 
 namespace SFG
 {
-	size_t estimate_decompressed_size(size_t compressedSize)
+	namespace
 	{
-		// return (compressedSize << 8) - compressedSize - 2526;
-		return 255 * compressedSize + 24;
+		bool decode_block(const uint8* src, uint32 packed_size, uint8* out, size_t raw_size)
+		{
+			if (packed_size & COMPRESSOR_STORED_BIT)
+			{
+				SFG_MEMCPY(out, src, raw_size);
+				return true;
+			}
+
+			const int written = LZ4_decompress_safe((const char*)src, (char*)out, static_cast<int>(packed_size), static_cast<int>(raw_size));
+			return written == static_cast<int>(raw_size);
+		}
+
+		void write_header(ostream& out, const compressed_header& header)
+		{
+			const uint8	 zeros[COMPRESSOR_HEADER_SIZE] = {};
+			const uint32 magic						   = COMPRESSOR_MAGIC;
+			out << magic << header.block_size << header.raw_size << header.block_count << header.version;
+			out.write_raw(zeros, COMPRESSOR_HEADER_SIZE - out.get_size());
+		}
+
+		bool read_packed_sizes(const compressed_header& header, const uint8* index, vector<uint32>& out)
+		{
+			istream in(const_cast<uint8*>(index), header.get_index_size());
+			out.resize(header.block_count);
+
+			for (uint32 i = 0; i < header.block_count; i++)
+			{
+				in >> out[i];
+
+				// stored blocks have to match their raw size, compressed ones can't exceed the lz4 bound.
+				const size_t raw_size = header.get_block_raw_size(i);
+				const size_t size	  = out[i] & ~COMPRESSOR_STORED_BIT;
+				if ((out[i] & COMPRESSOR_STORED_BIT) ? size != raw_size : size > static_cast<size_t>(LZ4_compressBound(static_cast<int>(raw_size))))
+					return false;
+			}
+
+			return true;
+		}
+	}
+
+	bool compressed_header::has_magic(const uint8* data, size_t size)
+	{
+		if (size < sizeof(uint32))
+			return false;
+
+		uint32 magic = 0;
+		SFG_MEMCPY(&magic, data, sizeof(uint32));
+		return magic == COMPRESSOR_MAGIC;
+	}
+
+	bool compressed_header::read(const uint8* data, size_t size)
+	{
+		if (size < COMPRESSOR_HEADER_SIZE || !has_magic(data, size))
+			return false;
+
+		istream in(const_cast<uint8*>(data), size);
+		in.seek(sizeof(uint32));
+		in >> block_size;
+		in >> raw_size;
+		in >> block_count;
+		in >> version;
+
+		if (version > COMPRESSOR_VERSION)
+		{
+			SFG_ERR("[compressor] -> Container version {0} is newer than {1}, the data needs a re-cook!", version, COMPRESSOR_VERSION);
+			return false;
+		}
+
+		if (block_count == 0)
+			return true;
+
+		return block_size != 0 && (raw_size + block_size - 1) / block_size == block_count;
+	}
+
+	bool compressed_blocks::parse(const uint8* data, size_t size)
+	{
+		_payload	 = nullptr;
+		_legacy_size = 0;
+		_offsets.resize(0);
+		_packed_sizes.resize(0);
+
+		if (!compressed_header::has_magic(data, size))
+			return parse_legacy(data, size);
+
+		if (!_header.read(data, size))
+			return false;
+
+		const size_t index_end = COMPRESSOR_HEADER_SIZE + _header.get_index_size();
+		if (size < index_end)
+			return false;
+
+		if (is_stored())
+		{
+			if (size - COMPRESSOR_HEADER_SIZE < _header.raw_size)
+				return false;
+
+			_payload = data + COMPRESSOR_HEADER_SIZE;
+			return true;
+		}
+
+		if (!read_packed_sizes(_header, data + COMPRESSOR_HEADER_SIZE, _packed_sizes))
+			return false;
+
+		_offsets.resize(_header.block_count + 1);
+		size_t offset = 0;
+		for (uint32 i = 0; i < _header.block_count; i++)
+		{
+			_offsets[i] = offset;
+			offset += _packed_sizes[i] & ~COMPRESSOR_STORED_BIT;
+		}
+		_offsets[_header.block_count] = offset;
+
+		if (size - index_end < offset)
+			return false;
+
+		_payload = data + index_end;
+		return true;
+	}
+
+	bool compressed_blocks::parse_legacy(const uint8* data, size_t size)
+	{
+		if (size < COMPRESSOR_LEGACY_TRAILER)
+			return false;
+
+		// lz4 always ends with literals, so the trailer is readable at the end of compressed streams as well.
+		uint8  compressed = 0;
+		uint32 total	  = 0;
+		SFG_MEMCPY(&compressed, data + size - COMPRESSOR_LEGACY_TRAILER, sizeof(uint8));
+		SFG_MEMCPY(&total, data + size - sizeof(uint32), sizeof(uint32));
+
+		if (total < COMPRESSOR_LEGACY_TRAILER || compressed > 1 || (compressed == 0 && total != size))
+			return false;
+
+		_header = {
+			.raw_size	 = static_cast<uint64>(total - COMPRESSOR_LEGACY_TRAILER),
+			.block_size	 = 0,
+			.block_count = 0,
+			.version	 = 0,
+		};
+		_payload	 = data;
+		_legacy_size = compressed ? size : 0;
+		return true;
+	}
+
+	bool compressed_blocks::decompress_block(uint32 index, uint8* out) const
+	{
+		SFG_ASSERT(index < _header.block_count);
+		return decode_block(_payload + _offsets[index], _packed_sizes[index], out, _header.get_block_raw_size(index));
+	}
+
+	bool compressed_blocks::decompress_range(size_t offset, size_t size, uint8* out, bool parallel) const
+	{
+		SFG_ASSERT(offset + size <= _header.raw_size);
+
+		if (size == 0)
+			return true;
+
+		if (is_stored())
+		{
+			SFG_MEMCPY(out, _payload + offset, size);
+			return true;
+		}
+
+		if (_legacy_size != 0)
+		{
+			// one stream, decoding stops at the end of the range. The trailer is never needed.
+			const int target = static_cast<int>(offset + size);
+			uint8*	  dst	 = offset == 0 ? out : reinterpret_cast<uint8*>(SFG_MALLOC(offset + size));
+			const int read	 = LZ4_decompress_safe_partial((const char*)_payload, (char*)dst, static_cast<int>(_legacy_size), target, target);
+			if (offset != 0)
+			{
+				SFG_MEMCPY(out, dst + offset, size);
+				SFG_FREE(dst);
+			}
+			return read == target;
+		}
+
+		const size_t block_size = static_cast<size_t>(_header.block_size);
+		const uint32 first		= static_cast<uint32>(offset / block_size);
+		const uint32 last		= static_cast<uint32>((offset + size - 1) / block_size);
+		atomic<bool> failed		= false;
+
+		auto decode = [&](uint32 i) {
+			const uint32 block		 = first + i;
+			const size_t block_start = static_cast<size_t>(block) * block_size;
+			const size_t block_raw	 = _header.get_block_raw_size(block);
+			const size_t copy_start	 = offset > block_start ? offset : block_start;
+			const size_t copy_end	 = (offset + size) < (block_start + block_raw) ? (offset + size) : (block_start + block_raw);
+			uint8*		 dst		 = out + (copy_start - offset);
+
+			if (copy_start == block_start && copy_end == block_start + block_raw)
+			{
+				if (!decompress_block(block, dst))
+					failed.store(true, std::memory_order_relaxed);
+				return;
+			}
+
+			// edges of the range, decode the whole block aside and copy the touched part.
+			uint8* tmp = reinterpret_cast<uint8*>(SFG_MALLOC(block_raw));
+			if (decompress_block(block, tmp))
+				SFG_MEMCPY(dst, tmp + (copy_start - block_start), copy_end - copy_start);
+			else
+				failed.store(true, std::memory_order_relaxed);
+			SFG_FREE(tmp);
+		};
+
+		const uint32 count = last - first + 1;
+
+		if (parallel)
+			job_system::get().parallel_for(count, 1, decode);
+		else
+		{
+			for (uint32 i = 0; i < count; i++)
+				decode(i);
+		}
+
+		return !failed.load(std::memory_order_relaxed);
+	}
+
+	block_decoder::~block_decoder()
+	{
+		_output.destroy();
+	}
+
+	bool block_decoder::feed(const uint8* data, size_t size)
+	{
+		if (_failed)
+			return false;
+
+		_pending.insert(_pending.end(), data, data + size);
+
+		if (!_header_parsed)
+		{
+			const uint8* pending   = _pending.data() + _pending_offset;
+			const size_t available = _pending.size() - _pending_offset;
+
+			if (available < COMPRESSOR_HEADER_SIZE)
+				return true;
+
+			if (!_header.read(pending, available))
+			{
+				_failed = true;
+				return false;
+			}
+
+			const size_t index_end = COMPRESSOR_HEADER_SIZE + _header.get_index_size();
+			if (available < index_end)
+				return true;
+
+			if (!read_packed_sizes(_header, pending + COMPRESSOR_HEADER_SIZE, _packed_sizes))
+			{
+				_failed = true;
+				return false;
+			}
+
+			_output.create(nullptr, static_cast<size_t>(_header.raw_size));
+			_pending_offset += index_end;
+			_header_parsed = true;
+		}
+
+		uint8*		 out	   = _output.get_raw();
+		const uint8* pending   = _pending.data() + _pending_offset;
+		const size_t available = _pending.size() - _pending_offset;
+		size_t		 consumed  = 0;
+
+		if (_header.block_count == 0)
+		{
+			const size_t remaining = static_cast<size_t>(_header.raw_size) - _decoded;
+			consumed			   = available < remaining ? available : remaining;
+			SFG_MEMCPY(out + _decoded, pending, consumed);
+			_decoded += consumed;
+		}
+		else
+		{
+			while (_next_block < _header.block_count)
+			{
+				const uint32 packed	   = _packed_sizes[_next_block];
+				const size_t comp_size = packed & ~COMPRESSOR_STORED_BIT;
+				if (available - consumed < comp_size)
+					break;
+
+				const size_t raw_size = _header.get_block_raw_size(_next_block);
+				if (!decode_block(pending + consumed, packed, out + static_cast<size_t>(_next_block) * _header.block_size, raw_size))
+				{
+					_failed = true;
+					return false;
+				}
+
+				consumed += comp_size;
+				_decoded += raw_size;
+				_next_block++;
+			}
+		}
+
+		// consumed bytes are only skipped, the buffer is compacted once they make up half of it so each byte moves at most once on average.
+		_pending_offset += consumed;
+		if (_pending_offset == _pending.size())
+		{
+			_pending.resize(0);
+			_pending_offset = 0;
+		}
+		else if (_pending_offset >= _pending.size() / 2)
+		{
+			_pending.erase(_pending.begin(), _pending.begin() + _pending_offset);
+			_pending_offset = 0;
+		}
+
+		return true;
+	}
+
+	istream block_decoder::release()
+	{
+		istream out = _output;
+		_output		= istream();
+		return out;
 	}
 
 	ostream compressor::compress(ostream& stream)
 	{
-		const uint32 streamSize		  = static_cast<uint32>(stream.get_size());
-		const uint8	 shouldCompress	  = (streamSize < 150000000 && streamSize > 750000) ? 1 : 0;
-		const uint32 uncompressedSize = streamSize + sizeof(uint8) + sizeof(uint32);
+		const size_t raw_size	 = stream.get_size();
+		const uint8* raw		 = stream.get_raw();
+		const uint32 block_count = raw_size < COMPRESSOR_MIN_SIZE ? 0 : static_cast<uint32>((raw_size + COMPRESSOR_BLOCK_SIZE - 1) / COMPRESSOR_BLOCK_SIZE);
 
-		stream << shouldCompress;
-		stream << uncompressedSize;
+		const compressed_header header = {
+			.raw_size	 = static_cast<uint64>(raw_size),
+			.block_size	 = COMPRESSOR_BLOCK_SIZE,
+			.block_count = block_count,
+		};
 
-		if (!shouldCompress)
+		ostream out;
+
+		if (block_count == 0)
 		{
-			ostream compressed;
-			compressed.create(stream.get_size());
-			compressed.write_raw(stream.get_raw(), stream.get_size());
-			return compressed;
+			out.create(COMPRESSOR_HEADER_SIZE + raw_size);
+			write_header(out, header);
+			if (raw_size != 0)
+				out.write_raw(raw, raw_size);
+			return out;
 		}
 
-		const int size			= static_cast<int>(stream.get_size());
-		const int compressBound = LZ4_compressBound(size);
+		// every block gets a bound sized slot so they can be compressed independently.
+		const size_t   bound   = static_cast<size_t>(LZ4_compressBound(COMPRESSOR_BLOCK_SIZE));
+		uint8*		   scratch = reinterpret_cast<uint8*>(SFG_MALLOC(bound * block_count));
+		vector<uint32> packed_sizes(block_count);
+
+		job_system::get().parallel_for(block_count, 1, [&](uint32 i) {
+			const uint8* src	  = raw + static_cast<size_t>(i) * COMPRESSOR_BLOCK_SIZE;
+			const size_t src_size = header.get_block_raw_size(i);
+			uint8*		 dst	  = scratch + static_cast<size_t>(i) * bound;
+			const int	 written  = LZ4_compress_default((const char*)src, (char*)dst, static_cast<int>(src_size), static_cast<int>(bound));
+
+			// incompressible blocks are kept raw.
+			if (written <= 0 || static_cast<size_t>(written) >= src_size)
+				packed_sizes[i] = static_cast<uint32>(src_size) | COMPRESSOR_STORED_BIT;
+			else
+				packed_sizes[i] = static_cast<uint32>(written);
+		});
+
+		size_t total = COMPRESSOR_HEADER_SIZE + header.get_index_size();
+		for (uint32 sz : packed_sizes)
+			total += sz & ~COMPRESSOR_STORED_BIT;
+
+		out.create(total);
+		write_header(out, header);
 
-		// Create stream capable of holding max compressed bytes.
-		ostream compressedStream = ostream();
-		compressedStream.create(compressBound);
-		char* dest		   = (char*)compressedStream.get_raw();
-		char* data		   = (char*)stream.get_raw();
-		int	  bytesWritten = LZ4_compress_default(data, dest, size, compressBound);
+		for (uint32 sz : packed_sizes)
+			out << sz;
 
-		if (bytesWritten == 0)
+		for (uint32 i = 0; i < block_count; i++)
 		{
-			SFG_ERR("[compressor] -> LZ4 compression failed!");
+			const uint32 packed = packed_sizes[i];
+			const uint8* src	= (packed & COMPRESSOR_STORED_BIT) ? raw + static_cast<size_t>(i) * COMPRESSOR_BLOCK_SIZE : scratch + static_cast<size_t>(i) * bound;
+			out.write_raw(src, packed & ~COMPRESSOR_STORED_BIT);
 		}
 
-		compressedStream.shrink(static_cast<size_t>(bytesWritten));
-		return compressedStream;
+		SFG_FREE(scratch);
+		return out;
 	}
 
 	istream compressor::decompress(istream& stream)
 	{
-		// Read uncompressed size of archive.
-		uint8  shouldDecompress = 0;
-		uint32 uncompressedSize = 0;
-		stream.seek(stream.get_size() - sizeof(uint32) - sizeof(uint8));
-		stream.read(shouldDecompress);
-		stream.read(uncompressedSize);
-		stream.seek(0);
-
-		if (!shouldDecompress)
-		{
-			istream copy;
-			copy.create(stream.get_raw(), stream.get_size() - sizeof(uint32) - sizeof(uint8));
-			return copy;
-		}
-
-		const size_t size				= stream.get_size();
-		istream		 decompressedStream = istream();
-		decompressedStream.create(nullptr, uncompressedSize);
-		void*	  src			   = stream.get_raw();
-		void*	  ptr			   = decompressedStream.get_raw();
-		const int decompressedSize = LZ4_decompress_safe((char*)src, (char*)ptr, static_cast<int>(size), static_cast<int>(uncompressedSize));
-		decompressedStream.shrink(static_cast<size_t>(decompressedSize) - sizeof(uint32) - sizeof(uint8));
-		return decompressedStream;
+		compressed_blocks blocks;
+		if (!blocks.parse(stream.get_raw(), stream.get_size()))
+		{
+			SFG_ERR("[compressor] -> Invalid compressed data!");
+			return {};
+		}
+
+		istream out;
+		out.create(nullptr, blocks.get_raw_size());
+
+		if (!blocks.decompress_range(0, blocks.get_raw_size(), out.get_raw()))
+		{
+			SFG_ERR("[compressor] -> LZ4 decompression failed!");
+			out.destroy();
+			return {};
+		}
+
+		return out;
 	}
 }
@@ -2,10 +2,143 @@
 
 #pragma once
 
+#include "common/size_definitions.hpp"
+#include "data/vector.hpp"
+#include "data/istream.hpp"
+
 namespace SFG
 {
 	class ostream;
-	class istream;
+
+#define COMPRESSOR_MAGIC		  0x5A474653 // SFGZ
+#define COMPRESSOR_VERSION		  1
+#define COMPRESSOR_BLOCK_SIZE	  (256 * 1024)
+#define COMPRESSOR_MIN_SIZE		  750000
+#define COMPRESSOR_STORED_BIT	  0x80000000
+#define COMPRESSOR_HEADER_SIZE	  32
+#define COMPRESSOR_LEGACY_TRAILER 5
+
+	/*
+		Container layout:
+		[uint32 magic][uint32 block_size][uint64 raw_size][uint32 block_count][uint32 version][zeros up to COMPRESSOR_HEADER_SIZE, keeps stored payloads aligned]
+		[uint32 packed size per block, COMPRESSOR_STORED_BIT marks blocks kept uncompressed]
+		[blocks, back to back]
+
+		Blocks are independent LZ4 blocks, so they are compressed/decompressed in parallel and any range can be decoded alone.
+		block_count 0 means the payload is stored as is right after the header, which lets it be viewed in place.
+		Version 0 is the same layout written before the field existed, newer versions than COMPRESSOR_VERSION are rejected.
+
+		Data without the magic is read as the legacy format: the payload followed by [uint8 compressed][uint32 payload size + trailer],
+		either stored or compressed as one LZ4 stream together with the trailer.
+	*/
+	struct compressed_header
+	{
+		uint64 raw_size	   = 0;
+		uint32 block_size  = 0;
+		uint32 block_count = 0;
+		uint32 version	   = COMPRESSOR_VERSION;
+
+		/// Reads the header only, returns false for foreign or newer data or if size is too small.
+		bool read(const uint8* data, size_t size);
+
+		static bool has_magic(const uint8* data, size_t size);
+
+		inline size_t get_index_size() const
+		{
+			return static_cast<size_t>(block_count) * sizeof(uint32);
+		}
+
+		inline size_t get_block_raw_size(uint32 index) const
+		{
+			const uint64 start = static_cast<uint64>(index) * block_size;
+			const uint64 end   = start + block_size;
+			return static_cast<size_t>((end < raw_size ? end : raw_size) - start);
+		}
+	};
+
+	/// Random access over a fully available container, legacy data is accepted too but compressed legacy data decodes from its start.
+	class compressed_blocks
+	{
+	public:
+		bool parse(const uint8* data, size_t size);
+		bool decompress_block(uint32 index, uint8* out) const;
+
+		/// Decodes [offset, offset + size) of the raw payload, only the blocks touching the range are decompressed.
+		bool decompress_range(size_t offset, size_t size, uint8* out, bool parallel = true) const;
+
+		inline bool is_stored() const
+		{
+			return _header.block_count == 0 && _legacy_size == 0;
+		}
+
+		inline const uint8* get_stored_data() const
+		{
+			return _payload;
+		}
+
+		inline size_t get_raw_size() const
+		{
+			return static_cast<size_t>(_header.raw_size);
+		}
+
+		inline uint32 get_block_count() const
+		{
+			return _header.block_count;
+		}
+
+		inline uint32 get_block_size() const
+		{
+			return _header.block_size;
+		}
+
+	private:
+		bool parse_legacy(const uint8* data, size_t size);
+
+	private:
+		compressed_header _header;
+		vector<size_t>	  _offsets;
+		vector<uint32>	  _packed_sizes;
+		const uint8*	  _payload	   = nullptr;
+		size_t			  _legacy_size = 0; // packed size of a compressed legacy stream.
+	};
+
+	/// Decodes a container while it arrives, every block is decompressed as soon as its bytes are complete. Legacy data is rejected, its trailer comes last.
+	class block_decoder
+	{
+	public:
+		block_decoder() = default;
+		~block_decoder();
+
+		block_decoder(const block_decoder& other)			 = delete;
+		block_decoder& operator=(const block_decoder& other) = delete;
+
+		/// Returns false if the data turned out to be invalid.
+		bool feed(const uint8* data, size_t size);
+
+		/// Hands over the output, only get_decoded_size() bytes are valid until is_done().
+		istream release();
+
+		inline bool is_done() const
+		{
+			return _header_parsed && _decoded == _header.raw_size;
+		}
+
+		inline size_t get_decoded_size() const
+		{
+			return _decoded;
+		}
+
+	private:
+		compressed_header _header;
+		vector<uint8>	  _pending;
+		vector<uint32>	  _packed_sizes;
+		istream			  _output;
+		size_t			  _pending_offset = 0;
+		size_t			  _decoded		  = 0;
+		uint32			  _next_block	  = 0;
+		bool			  _header_parsed  = false;
+		bool			  _failed		  = false;
+	};
 
 	class compressor
 	{
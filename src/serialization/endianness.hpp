@@ -14,6 +14,7 @@
 #include <bit>
 #include <algorithm>
 #include <array>
+#include <cstdint>
 
 namespace SFG
 {
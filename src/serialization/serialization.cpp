@@ -5,10 +5,10 @@
 #include "io/file_system.hpp"
 #include "data/ostream.hpp"
 #include "data/istream.hpp"
+#include "io/mapped_file.hpp"
 #include "compressor.hpp"
 
 #include <fstream>
-#include <filesystem>
 
 namespace SFG
 {
@@ -65,32 +65,56 @@ namespace SFG
 			return {};
 		}
 
-		std::ifstream rf(path, std::ios::out | std::ios::binary);
-
-		if (!rf)
+		mapped_file file;
+		istream		in;
+		if (!load_from_file_mapped(path, file, in))
 		{
 			SFG_ERR("[Serialization] -> Could not open file for reading! {0}", path);
-			return istream();
+			return {};
+		}
+
+		// stored data still points into the mapping, which closes on return.
+		if (file.is_open())
+		{
+			istream copy;
+			copy.create(in.get_raw(), in.get_size());
+			return copy;
 		}
 
-		auto size = std::filesystem::file_size(path);
+		return in;
+	}
 
-		// Create
-		istream readStream;
-		readStream.create(nullptr, size);
-		readStream.read_from_ifstream(rf);
-		rf.close();
+	bool serialization::load_from_file_mapped(const char* path, mapped_file& out_file, istream& out_stream)
+	{
+		if (!out_file.open(path))
+			return false;
 
-		if (!rf.good())
+		compressed_blocks blocks;
+		if (!blocks.parse(out_file.get_data(), out_file.get_size()))
 		{
-			SFG_ERR("[Serialization] -> Error occured while reading the file! {0}", path);
-			readStream.destroy();
-			return {};
+			SFG_ERR("[Serialization] -> Invalid file! {0}", path);
+			out_file.close();
+			return false;
 		}
 
-		istream decompressedStream = compressor::decompress(readStream);
-		readStream.destroy();
-		return decompressedStream;
+		if (blocks.is_stored())
+		{
+			out_stream = istream(const_cast<uint8*>(blocks.get_stored_data()), blocks.get_raw_size());
+			return true;
+		}
+
+		out_stream.create(nullptr, blocks.get_raw_size());
+		const bool ok = blocks.decompress_range(0, blocks.get_raw_size(), out_stream.get_raw());
+		out_file.close();
+
+		if (!ok)
+		{
+			SFG_ERR("[Serialization] -> Failed decompressing file! {0}", path);
+			out_stream.destroy();
+			return false;
+		}
+
+		return true;
 	}
 
 }
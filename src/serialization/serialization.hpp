@@ -8,6 +8,7 @@ namespace SFG
 {
 	class ostream;
 	class istream;
+	class mapped_file;
 
 	class serialization
 	{
@@ -15,6 +16,9 @@ namespace SFG
 		static bool	   write_to_file(string_view fileInput, const char* targetFilePath);
 		static bool	   save_to_file(const char* path, ostream& stream);
 		static istream load_from_file(const char* path);
+
+		/// Uncompressed files are viewed in place, out_stream points into out_file and is valid while it stays open. Compressed files are decompressed straight from the mapping, which is closed afterwards.
+		static bool load_from_file_mapped(const char* path, mapped_file& out_file, istream& out_stream);
 	};
 
 }
@@ -0,0 +1,348 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "job_system.hpp"
+#include "io/log.hpp"
+#include "common/profiler.hpp"
+
+namespace SFG
+{
+	thread_local int32 job_system::s_thread_index = -1;
+
+#define JOB_SPIN_COUNT 64
+
+	void job_system::init(uint32 worker_count)
+	{
+		SFG_ASSERT(!_is_init);
+
+		if (worker_count == 0)
+		{
+			// Keep the main & render threads' cores free.
+			const uint32 hw = std::thread::hardware_concurrency();
+			worker_count	= hw > 3 ? hw - 2 : 1;
+		}
+
+		_thread_count = worker_count + JOB_MAX_EXTERNAL_THREADS;
+		_thread_data  = new per_thread_data[_thread_count];
+		_external_mask.store(0);
+		_signal.store(0);
+		_is_running.store(1, std::memory_order_release);
+
+		_workers.reserve(worker_count);
+		for (uint32 i = 0; i < worker_count; i++)
+			_workers.push_back(std::thread(&job_system::worker_loop, this, i));
+
+		_is_init = true;
+		SFG_INFO("job_system::init() -> workers: {0}", worker_count);
+	}
+
+	void job_system::uninit()
+	{
+		if (!_is_init)
+			return;
+
+		_is_running.store(0, std::memory_order_release);
+		wake_workers();
+
+		for (std::thread& t : _workers)
+			t.join();
+
+		_workers.clear();
+		delete[] _thread_data;
+		_thread_data  = nullptr;
+		_thread_count = 0;
+		_is_init	  = false;
+	}
+
+	void job_system::register_thread()
+	{
+		SFG_ASSERT(_is_init);
+
+		if (s_thread_index != -1)
+			return;
+
+		uint32 mask = _external_mask.load(std::memory_order_relaxed);
+		while (true)
+		{
+			uint32 slot = 0;
+			while (slot < JOB_MAX_EXTERNAL_THREADS && (mask & (1u << slot)))
+				slot++;
+
+			SFG_ASSERT(slot < JOB_MAX_EXTERNAL_THREADS);
+
+			if (_external_mask.compare_exchange_weak(mask, mask | (1u << slot), std::memory_order_acq_rel))
+			{
+				s_thread_index = static_cast<int32>(_workers.size() + slot);
+				return;
+			}
+		}
+	}
+
+	void job_system::unregister_thread()
+	{
+		if (!_is_init || s_thread_index == -1)
+			return;
+
+		const uint32 slot = static_cast<uint32>(s_thread_index) - static_cast<uint32>(_workers.size());
+
+		// Anything left behind is drained before the slot is handed out again.
+		while (execute_next(static_cast<uint32>(s_thread_index)))
+			;
+
+		_external_mask.fetch_and(~(1u << slot), std::memory_order_acq_rel);
+		s_thread_index = -1;
+	}
+
+	void job_system::submit(const job_desc& desc, job_counter* counter, job_counter* dependency)
+	{
+		submit(&desc, 1, counter, dependency);
+	}
+
+	void job_system::submit(const job_desc* descs, uint32 count, job_counter* counter, job_counter* dependency)
+	{
+		if (!_is_init)
+		{
+			for (uint32 i = 0; i < count; i++)
+				descs[i].function(descs[i].user_data, descs[i].start, descs[i].end);
+			return;
+		}
+
+		SFG_ASSERT(s_thread_index != -1);
+		const uint32 thread_index = static_cast<uint32>(s_thread_index);
+
+		if (counter)
+			counter->value.fetch_add(count, std::memory_order_relaxed);
+
+		for (uint32 i = 0; i < count; i++)
+		{
+			const job_desc& d = descs[i];
+			push_job(thread_index,
+					 {
+						 .function	 = d.function,
+						 .user_data	 = d.user_data,
+						 .counter	 = counter,
+						 .dependency = dependency,
+						 .start		 = d.start,
+						 .end		 = d.end,
+					 });
+		}
+
+		wake_workers();
+	}
+
+	void job_system::submit_range(job_function function, void* user_data, uint32 count, uint32 batch_size, job_counter* counter, job_counter* dependency)
+	{
+		if (batch_size == 0)
+			batch_size = 1;
+
+		if (!_is_init)
+		{
+			function(user_data, 0, count);
+			return;
+		}
+
+		SFG_ASSERT(s_thread_index != -1);
+		const uint32 thread_index = static_cast<uint32>(s_thread_index);
+		const uint32 batch_count  = (count + batch_size - 1) / batch_size;
+
+		if (counter)
+			counter->value.fetch_add(batch_count, std::memory_order_relaxed);
+
+		for (uint32 i = 0; i < batch_count; i++)
+		{
+			const uint32 start = i * batch_size;
+			const uint32 end   = start + batch_size > count ? count : start + batch_size;
+			push_job(thread_index,
+					 {
+						 .function	 = function,
+						 .user_data	 = user_data,
+						 .counter	 = counter,
+						 .dependency = dependency,
+						 .start		 = start,
+						 .end		 = end,
+					 });
+		}
+
+		wake_workers();
+	}
+
+	void job_system::wait(job_counter* counter)
+	{
+		if (!_is_init)
+			return;
+
+		SFG_ASSERT(s_thread_index != -1);
+		const uint32 thread_index = static_cast<uint32>(s_thread_index);
+
+		while (!counter->is_done())
+		{
+			if (!execute_next(thread_index))
+				std::this_thread::yield();
+		}
+	}
+
+	void job_system::worker_loop(uint32 thread_index)
+	{
+		s_thread_index = static_cast<int32>(thread_index);
+		SFG_PROFILE_THREAD("job_worker");
+
+		while (_is_running.load(std::memory_order_acquire))
+		{
+			if (execute_next(thread_index))
+				continue;
+
+			// Anything submitted after this point bumps the signal, so wait() below can't miss it.
+			const uint32 signal = _signal.load(std::memory_order_acquire);
+
+			bool found = false;
+			for (uint32 i = 0; i < JOB_SPIN_COUNT; i++)
+			{
+				if (execute_next(thread_index))
+				{
+					found = true;
+					break;
+				}
+				std::this_thread::yield();
+			}
+
+			if (found || !_is_running.load(std::memory_order_acquire))
+				continue;
+
+			_signal.wait(signal, std::memory_order_acquire);
+		}
+
+		s_thread_index = -1;
+	}
+
+	bool job_system::execute_next(uint32 thread_index)
+	{
+		job_slot* found = find_job(thread_index);
+		if (found == nullptr)
+			return false;
+
+		const job_counter* dependency = found->value.dependency;
+		if (dependency && !dependency->is_done())
+		{
+			requeue_job(thread_index, found);
+
+			// Parked job sits at the bottom again, give older work in our own queue a chance.
+			job_slot* older = _thread_data[thread_index].queue.steal();
+			if (older == nullptr)
+				return false;
+
+			const job_counter* older_dependency = older->value.dependency;
+			if (older_dependency && !older_dependency->is_done())
+			{
+				requeue_job(thread_index, older);
+				return false;
+			}
+
+			consume_job(older);
+			return true;
+		}
+
+		consume_job(found);
+		return true;
+	}
+
+	job_system::job_slot* job_system::find_job(uint32 thread_index)
+	{
+		per_thread_data& own = _thread_data[thread_index];
+
+		job_slot* j = own.queue.pop();
+		if (j)
+			return j;
+
+		const uint32 start = own.steal_start;
+		for (uint32 i = 0; i < _thread_count; i++)
+		{
+			const uint32 victim = (start + i) % _thread_count;
+			if (victim == thread_index)
+				continue;
+
+			j = _thread_data[victim].queue.steal();
+			if (j)
+			{
+				own.steal_start = victim;
+				return j;
+			}
+		}
+
+		return nullptr;
+	}
+
+	job_system::job_slot* job_system::acquire_slot(uint32 thread_index)
+	{
+		per_thread_data& data = _thread_data[thread_index];
+
+		// Slots still referenced by any queue or being copied out by a thief are skipped. Parked jobs can pin slots in other threads' queues, so give up after one lap.
+		for (uint32 i = 0; i < JOB_POOL_CAPACITY; i++)
+		{
+			job_slot* slot = &data.jobs[data.job_head % JOB_POOL_CAPACITY];
+			data.job_head++;
+
+			if (slot->in_use.load(std::memory_order_acquire) == 0)
+			{
+				slot->in_use.store(1, std::memory_order_relaxed);
+				return slot;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void job_system::push_job(uint32 thread_index, const job& j)
+	{
+		job_slot* slot = acquire_slot(thread_index);
+
+		if (slot != nullptr)
+		{
+			slot->value = j;
+			if (_thread_data[thread_index].queue.push(slot))
+				return;
+
+			slot->in_use.store(0, std::memory_order_release);
+		}
+
+		// Queue or pool is full, run it right away.
+		if (j.dependency)
+			wait(j.dependency);
+
+		run_job(j);
+	}
+
+	void job_system::requeue_job(uint32 thread_index, job_slot* slot)
+	{
+		// The slot keeps its job, only the pointer moves to the back of our queue.
+		if (_thread_data[thread_index].queue.push(slot))
+			return;
+
+		const job j = slot->value;
+		slot->in_use.store(0, std::memory_order_release);
+		wait(j.dependency);
+		run_job(j);
+	}
+
+	void job_system::consume_job(job_slot* slot)
+	{
+		const job j = slot->value;
+		slot->in_use.store(0, std::memory_order_release);
+		run_job(j);
+	}
+
+	void job_system::run_job(const job& j)
+	{
+		j.function(j.user_data, j.start, j.end);
+
+		if (j.counter && j.counter->value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			// Jobs parked on this counter as a dependency may now run.
+			wake_workers();
+		}
+	}
+
+	void job_system::wake_workers()
+	{
+		_signal.fetch_add(1, std::memory_order_release);
+		_signal.notify_all();
+	}
+}
@@ -0,0 +1,183 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "data/atomic.hpp"
+#include "data/vector.hpp"
+#include "io/assert.hpp"
+#include "work_stealing_queue.hpp"
+#include <thread>
+#include <type_traits>
+
+namespace SFG
+{
+#define JOB_MAX_EXTERNAL_THREADS 4
+#define JOB_QUEUE_CAPACITY		 1024
+#define JOB_POOL_CAPACITY		 (JOB_QUEUE_CAPACITY * 2)
+
+	typedef void (*job_function)(void* user_data, uint32 start, uint32 end);
+
+	struct job_counter
+	{
+		atomic<uint32> value = 0;
+
+		inline bool is_done() const
+		{
+			return value.load(std::memory_order_acquire) == 0;
+		}
+	};
+
+	struct job_desc
+	{
+		job_function function  = nullptr;
+		void*		 user_data = nullptr;
+		uint32		 start	   = 0;
+		uint32		 end	   = 0;
+	};
+
+	class job_system
+	{
+	private:
+		struct job
+		{
+			job_function function	= nullptr;
+			void*		 user_data	= nullptr;
+			job_counter* counter	= nullptr;
+			job_counter* dependency = nullptr;
+			uint32		 start		= 0;
+			uint32		 end		= 0;
+		};
+
+		/// Owned by the thread that filled it until whoever pops or steals it copies the job out & releases it.
+		struct job_slot
+		{
+			job			  value	 = {};
+			atomic<uint8> in_use = 0;
+		};
+
+		struct alignas(64) per_thread_data
+		{
+			work_stealing_queue<job_slot, JOB_QUEUE_CAPACITY> queue;
+			job_slot										  jobs[JOB_POOL_CAPACITY];
+			uint32											  job_head	  = 0;
+			uint32											  steal_start = 0;
+		};
+
+	public:
+		static job_system& get()
+		{
+			static job_system instance;
+			return instance;
+		}
+
+		/// Spawns worker threads, 0 picks hardware concurrency minus the main & render threads.
+		void init(uint32 worker_count = 0);
+		void uninit();
+
+		/// Non-worker threads (main, render, tools) need to register before submitting or waiting.
+		void register_thread();
+		void unregister_thread();
+
+		/// Jobs are not started until dependency reaches zero, counter is decremented once per finished job.
+		void submit(const job_desc& desc, job_counter* counter, job_counter* dependency = nullptr);
+		void submit(const job_desc* descs, uint32 count, job_counter* counter, job_counter* dependency = nullptr);
+		void submit_range(job_function function, void* user_data, uint32 count, uint32 batch_size, job_counter* counter, job_counter* dependency = nullptr);
+
+		/// Executes pending jobs on the calling thread until counter reaches zero.
+		void wait(job_counter* counter);
+
+		template <typename F> void submit(F& f, job_counter* counter, job_counter* dependency = nullptr)
+		{
+			submit({.function = &job_system::invoke_single<F>, .user_data = &f, .start = 0, .end = 1}, counter, dependency);
+		}
+
+		/// f(uint32 index) for every index in [0, count), blocks until all are done. Runs inline on threads that are not registered.
+		template <typename F> void parallel_for(uint32 count, uint32 batch_size, F&& f)
+		{
+			using func = std::remove_reference_t<F>;
+
+			if (count == 0)
+				return;
+
+			if (!_is_init || s_thread_index == -1 || count <= batch_size)
+			{
+				for (uint32 i = 0; i < count; i++)
+					f(i);
+				return;
+			}
+
+			job_counter counter;
+			submit_range(&job_system::invoke_each<func>, (void*)&f, count, batch_size, &counter);
+			wait(&counter);
+		}
+
+		/// f(uint32 start, uint32 end) for every batch in [0, count), blocks until all are done.
+		template <typename F> void parallel_for_batched(uint32 count, uint32 batch_size, F&& f)
+		{
+			using func = std::remove_reference_t<F>;
+
+			if (count == 0)
+				return;
+
+			if (!_is_init || s_thread_index == -1 || count <= batch_size)
+			{
+				f(0, count);
+				return;
+			}
+
+			job_counter counter;
+			submit_range(&job_system::invoke_batch<func>, (void*)&f, count, batch_size, &counter);
+			wait(&counter);
+		}
+
+		inline uint32 get_worker_count() const
+		{
+			return static_cast<uint32>(_workers.size());
+		}
+
+		inline bool is_init() const
+		{
+			return _is_init;
+		}
+
+	private:
+		template <typename F> static void invoke_single(void* user_data, uint32 start, uint32 end)
+		{
+			(*static_cast<F*>(user_data))();
+		}
+
+		template <typename F> static void invoke_each(void* user_data, uint32 start, uint32 end)
+		{
+			F& f = *static_cast<F*>(user_data);
+			for (uint32 i = start; i < end; i++)
+				f(i);
+		}
+
+		template <typename F> static void invoke_batch(void* user_data, uint32 start, uint32 end)
+		{
+			(*static_cast<F*>(user_data))(start, end);
+		}
+
+		void worker_loop(uint32 thread_index);
+		bool execute_next(uint32 thread_index);
+		job_slot* find_job(uint32 thread_index);
+		job_slot* acquire_slot(uint32 thread_index);
+		void	  push_job(uint32 thread_index, const job& j);
+		void	  requeue_job(uint32 thread_index, job_slot* slot);
+		void	  consume_job(job_slot* slot);
+		void	  run_job(const job& j);
+		void wake_workers();
+
+	private:
+		static thread_local int32 s_thread_index;
+
+		vector<std::thread> _workers;
+		per_thread_data*	_thread_data   = nullptr;
+		uint32				_thread_count  = 0;
+		atomic<uint32>		_external_mask = 0;
+		atomic<uint32>		_signal		   = 0;
+		atomic<uint8>		_is_running	   = 0;
+		bool				_is_init	   = false;
+	};
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "data/atomic.hpp"
+
+namespace SFG
+{
+	/*
+		Fixed capacity bounded queue, any number of producers and consumers (Vyukov).
+		Each cell carries a sequence number, a slot is claimed with a single CAS and published by bumping its sequence.
+		Items are filled/read in place through the callbacks so large items are not copied twice.
+	*/
+	template <typename T, uint32 CAPACITY> class mpmc_queue
+	{
+		static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Capacity must be a power of two!");
+
+		static constexpr size_t MASK = static_cast<size_t>(CAPACITY) - 1;
+
+		struct alignas(64) cell
+		{
+			atomic<size_t> sequence = 0;
+			T			   data		= {};
+		};
+
+	public:
+		mpmc_queue()
+		{
+			for (size_t i = 0; i < CAPACITY; i++)
+				_cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		/// fill(T&) is called on the claimed slot, returns false when the queue is full.
+		template <typename F> inline bool try_push(F&& fill)
+		{
+			size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+			cell*  c   = nullptr;
+
+			for (;;)
+			{
+				c						  = &_cells[pos & MASK];
+				const size_t   seq		  = c->sequence.load(std::memory_order_acquire);
+				const intptr_t difference = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+				if (difference == 0)
+				{
+					if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (difference < 0)
+					return false;
+				else
+					pos = _enqueue_pos.load(std::memory_order_relaxed);
+			}
+
+			fill(c->data);
+			c->sequence.store(pos + 1, std::memory_order_release);
+			return true;
+		}
+
+		/// read(T&) is called on the oldest item, returns false when the queue is empty.
+		template <typename F> inline bool try_pop(F&& read)
+		{
+			size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+			cell*  c   = nullptr;
+
+			for (;;)
+			{
+				c						  = &_cells[pos & MASK];
+				const size_t   seq		  = c->sequence.load(std::memory_order_acquire);
+				const intptr_t difference = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+
+				if (difference == 0)
+				{
+					if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (difference < 0)
+					return false;
+				else
+					pos = _dequeue_pos.load(std::memory_order_relaxed);
+			}
+
+			read(c->data);
+			c->sequence.store(pos + MASK + 1, std::memory_order_release);
+			return true;
+		}
+
+		/// Total number of claimed pushes, including ones still being filled.
+		inline size_t get_enqueue_position() const
+		{
+			return _enqueue_pos.load(std::memory_order_acquire);
+		}
+
+	private:
+		cell					   _cells[CAPACITY];
+		alignas(64) atomic<size_t> _enqueue_pos = 0;
+		alignas(64) atomic<size_t> _dequeue_pos = 0;
+	};
+}
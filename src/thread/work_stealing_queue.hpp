@@ -0,0 +1,94 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "data/atomic.hpp"
+
+namespace SFG
+{
+	/*
+		Fixed capacity Chase-Lev deque.
+		Owner thread pushes/pops at the bottom, any other thread can steal from the top.
+	*/
+	template <typename T, uint32 CAPACITY> class work_stealing_queue
+	{
+		static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Capacity must be a power of two!");
+
+		static constexpr int64 MASK = static_cast<int64>(CAPACITY) - 1;
+
+	public:
+		// Owner only.
+		inline bool push(T* item)
+		{
+			const int64 bottom = _bottom.load(std::memory_order_relaxed);
+			const int64 top	   = _top.load(std::memory_order_acquire);
+
+			if (bottom - top >= static_cast<int64>(CAPACITY))
+				return false;
+
+			_items[bottom & MASK].store(item, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return true;
+		}
+
+		// Owner only.
+		inline T* pop()
+		{
+			const int64 bottom = _bottom.load(std::memory_order_relaxed) - 1;
+			_bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64 top = _top.load(std::memory_order_relaxed);
+
+			if (top > bottom)
+			{
+				_bottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			T* item = _items[bottom & MASK].load(std::memory_order_relaxed);
+
+			// Last item, race against stealers.
+			if (top == bottom)
+			{
+				if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					item = nullptr;
+
+				_bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+
+			return item;
+		}
+
+		// Any thread.
+		inline T* steal()
+		{
+			int64 top = _top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const int64 bottom = _bottom.load(std::memory_order_acquire);
+
+			if (top >= bottom)
+				return nullptr;
+
+			T* item = _items[top & MASK].load(std::memory_order_relaxed);
+
+			if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+
+			return item;
+		}
+
+		inline uint32 size() const
+		{
+			const int64 bottom = _bottom.load(std::memory_order_relaxed);
+			const int64 top	   = _top.load(std::memory_order_relaxed);
+			return bottom > top ? static_cast<uint32>(bottom - top) : 0;
+		}
+
+	private:
+		alignas(64) atomic<int64> _top	  = 0;
+		alignas(64) atomic<int64> _bottom = 0;
+		atomic<T*> _items[CAPACITY]		  = {};
+	};
+}
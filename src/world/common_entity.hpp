@@ -8,8 +8,8 @@
 
 namespace SFG
 {
-	typedef uint16		  world_id;
-	typedef pool_handle16 entity_handle;
+	typedef uint32		  world_id;
+	typedef pool_handle32 entity_handle;
 
 #define NULL_WORLD_ID std::numeric_limits<world_id>::max()
 
@@ -18,19 +18,24 @@ namespace SFG
 		entity_flags_local_transform_dirty = 1 << 0,
 		entity_flags_abs_transform_dirty   = 1 << 1,
 		entity_flags_abs_rotation_dirty	   = 1 << 2,
+		entity_flags_abs_transform_changed = 1 << 3,
+		entity_flags_abs_matrix_stale	   = 1 << 4, // cached abs matrix, marked over the whole subtree.
+		entity_flags_abs_aabb_stale		   = 1 << 5, // cached abs aabb, marked over the whole subtree.
 	};
 
 	struct entity_meta
 	{
 		const char*		name  = "";
-		bitmask<uint16> flags = entity_flags_local_transform_dirty | entity_flags_abs_transform_dirty;
+		bitmask<uint16> flags = entity_flags_local_transform_dirty | entity_flags_abs_transform_dirty | entity_flags_abs_rotation_dirty | entity_flags_abs_matrix_stale | entity_flags_abs_aabb_stale;
 	};
 
 	struct entity_family
 	{
-		pool_handle16 parent	   = {};
-		pool_handle16 first_child  = {};
-		pool_handle16 prev_sibling = {};
-		pool_handle16 next_sibling = {};
+		entity_handle parent	   = {};
+		entity_handle first_child  = {};
+		entity_handle prev_sibling = {};
+		entity_handle next_sibling = {};
+		uint32		  depth		   = 0;
+		uint32		  level_slot   = 0;
 	};
 }
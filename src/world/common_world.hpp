@@ -19,7 +19,9 @@ namespace SFG
 
 #define MAX_RENDERABLE_NODES	 1024
 #define MAX_RENDERABLE_MATERIALS 256
-#define MAX_ENTITIES			 512
+#define ENTITY_PAGE_SIZE		 1024
+#define ENTITY_INITIAL_CAPACITY	 1024
+#define ENTITY_TEXT_PAGE_SIZE	 (1024 * 16)
 #define MAX_TRAIT_AUX_MEMORY	 1024
 	static constexpr size_t MAX_MODEL_AUX_MEMORY = 1048576;
 
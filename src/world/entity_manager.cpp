@@ -4,24 +4,17 @@
 #include "world.hpp"
 #include "world/traits/trait_mesh_renderer.hpp"
 #include "world/traits/trait_light.hpp"
+#include "thread/job_system.hpp"
+#include "common/profiler.hpp"
 
 namespace SFG
 {
+#define TRANSFORM_BATCH_SIZE 256
+
 	entity_manager::entity_manager(world& w) : _world(w)
 	{
-		_entities.init<world_id>(MAX_ENTITIES);
-		_metas.init(MAX_ENTITIES);
-		_positions.init(MAX_ENTITIES);
-		_prev_positions.init(MAX_ENTITIES);
-		_rotations.init(MAX_ENTITIES);
-		_rotations_abs.init(MAX_ENTITIES);
-		_prev_rotations.init(MAX_ENTITIES);
-		_scales.init(MAX_ENTITIES);
-		_prev_scales.init(MAX_ENTITIES);
-		_aabbs.init(MAX_ENTITIES);
-		_matrices.init(MAX_ENTITIES);
-		_abs_matrices.init(MAX_ENTITIES);
-		_families.init(MAX_ENTITIES);
+		_entities.init(ENTITY_INITIAL_CAPACITY);
+		grow_entity_data(_entities.get_capacity());
 
 		_traits.resize(trait_types::trait_type_allowed_max);
 
@@ -35,9 +28,24 @@ namespace SFG
 		{
 			if (stg.storage.get_raw())
 				stg.storage.uninit();
+			stg.owners.uninit();
 		}
 
 		_entities.uninit();
+		_metas.uninit();
+		_positions.uninit();
+		_prev_positions.uninit();
+		_rotations.uninit();
+		_rotations_abs.uninit();
+		_prev_rotations.uninit();
+		_scales.uninit();
+		_prev_scales.uninit();
+		_aabbs.uninit();
+		_aabbs_abs.uninit();
+		_matrices.uninit();
+		_abs_matrices.uninit();
+		_families.uninit();
+		_trait_masks.uninit();
 	}
 
 	void entity_manager::init()
@@ -52,10 +60,35 @@ namespace SFG
 		reset_all_entity_data();
 	}
 
+	void entity_manager::grow_entity_data(size_t capacity)
+	{
+		_metas.grow(capacity);
+		_positions.grow(capacity);
+		_prev_positions.grow(capacity);
+		_rotations.grow(capacity);
+		_rotations_abs.grow(capacity);
+		_prev_rotations.grow(capacity);
+		_scales.grow(capacity);
+		_prev_scales.grow(capacity);
+		_aabbs.grow(capacity);
+		_aabbs_abs.grow(capacity);
+		_matrices.grow(capacity);
+		_abs_matrices.grow(capacity);
+		_families.grow(capacity);
+		_trait_masks.grow(capacity);
+
+		for (trait_storage& stg : _traits)
+		{
+			if (stg.storage.get_raw())
+				stg.owners.grow(capacity);
+		}
+	}
+
 	void entity_manager::reset_all_entity_data()
 	{
 		_entities.reset();
 		_aabbs.reset();
+		_aabbs_abs.reset();
 		_metas.reset();
 		_positions.reset();
 		_prev_positions.reset();
@@ -67,11 +100,16 @@ namespace SFG
 		_matrices.reset();
 		_abs_matrices.reset();
 		_families.reset();
+		_trait_masks.reset();
+
+		for (vector<transform_node>& level : _transform_levels)
+			level.resize(0);
 	}
 
 	void entity_manager::reset_entity_data(world_id id)
 	{
 		_aabbs.reset(id);
+		_aabbs_abs.reset(id);
 		_metas.reset(id);
 		_positions.reset(id);
 		_prev_positions.reset(id);
@@ -83,11 +121,16 @@ namespace SFG
 		_matrices.reset(id);
 		_abs_matrices.reset(id);
 		_families.reset(id);
+		_trait_masks.reset(id);
 	}
 
 	entity_handle entity_manager::create_entity(const char* name)
 	{
-		entity_handle handle = _entities.allocate<world_id>();
+		entity_handle handle = {};
+		if (_entities.allocate(handle))
+			grow_entity_data(_entities.get_capacity());
+
+		hierarchy_insert(handle.index, NULL_WORLD_ID, 0);
 		set_entity_scale(handle, vector3::one);
 		set_entity_prev_scale_abs(handle, vector3::one);
 
@@ -149,8 +192,27 @@ namespace SFG
 			target_child = next;
 		}
 
+		// Traits go with their entity, queries would otherwise reach orphans through the reused index.
+		const uint32 mask = _trait_masks.get(entity.index).value();
+		for (uint8 i = 0; i < trait_types::trait_type_allowed_max; i++)
+		{
+			if ((mask & (1u << i)) == 0)
+				continue;
+
+			trait_storage& stg = _traits[i];
+			stg.free_trait(stg.storage, stg.owners.get(entity.index));
+		}
+
+		hierarchy_remove(entity.index);
 		reset_entity_data(entity.index);
-		_entities.free<world_id>(entity);
+		_entities.free(entity);
+	}
+
+	void entity_manager::set_entity_aabb(entity_handle entity, const aabb& box)
+	{
+		SFG_ASSERT(_entities.is_valid(entity));
+		_aabbs.get(entity.index) = box;
+		_metas.get(entity.index).flags.set(entity_flags::entity_flags_abs_transform_dirty | entity_flags::entity_flags_abs_aabb_stale);
 	}
 
 	const aabb& entity_manager::get_entity_aabb(entity_handle entity)
@@ -159,6 +221,21 @@ namespace SFG
 		return _aabbs.get(entity.index);
 	}
 
+	const aabb& entity_manager::get_entity_aabb_abs(entity_handle entity)
+	{
+		SFG_ASSERT(_entities.is_valid(entity));
+
+		aabb&			 box   = _aabbs_abs.get(entity.index);
+		bitmask<uint16>& flags = _metas.get(entity.index).flags;
+		if (flags.is_set(entity_flags::entity_flags_abs_aabb_stale))
+		{
+			box = _aabbs.get(entity.index).transform(get_entity_transform_abs(entity));
+			flags.remove(entity_flags::entity_flags_abs_aabb_stale);
+		}
+
+		return box;
+	}
+
 	void entity_manager::add_child(entity_handle parent, entity_handle child_to_add)
 	{
 		SFG_ASSERT(_entities.is_valid(parent));
@@ -200,6 +277,10 @@ namespace SFG
 			fam_found_last_child.next_sibling	= child_to_add;
 			fam_child.prev_sibling				= last_child;
 		}
+
+		hierarchy_move(child_to_add.index, parent.index, fam_parent.depth + 1);
+		_metas.get(child_to_add.index).flags.set(entity_flags::entity_flags_abs_transform_dirty);
+		mark_abs_stale(child_to_add.index, entity_flags::entity_flags_abs_rotation_dirty | entity_flags::entity_flags_abs_matrix_stale | entity_flags::entity_flags_abs_aabb_stale);
 	}
 
 	void entity_manager::remove_child(entity_handle parent, entity_handle child_to_remove)
@@ -249,6 +330,10 @@ namespace SFG
 		fam_child.next_sibling = {};
 		fam_child.prev_sibling = {};
 		fam_child.parent	   = {};
+
+		hierarchy_move(child_to_remove.index, NULL_WORLD_ID, 0);
+		_metas.get(child_to_remove.index).flags.set(entity_flags::entity_flags_abs_transform_dirty);
+		mark_abs_stale(child_to_remove.index, entity_flags::entity_flags_abs_rotation_dirty | entity_flags::entity_flags_abs_matrix_stale | entity_flags::entity_flags_abs_aabb_stale);
 	}
 
 	void entity_manager::remove_from_parent(entity_handle entity)
@@ -302,7 +387,7 @@ namespace SFG
 		SFG_ASSERT(_entities.is_valid(entity));
 		_positions.get(entity.index) = pos;
 		_metas.get(entity.index).flags.set(entity_flags::entity_flags_local_transform_dirty | entity_flags::entity_flags_abs_transform_dirty);
-		visit_children(entity, [this](entity_handle e) { _metas.get(e.index).flags.set(entity_flags::entity_flags_abs_transform_dirty); });
+		mark_abs_stale(entity.index, entity_flags::entity_flags_abs_matrix_stale | entity_flags::entity_flags_abs_aabb_stale);
 	}
 
 	void entity_manager::set_entity_position_abs(entity_handle entity, const vector3& pos)
@@ -337,8 +422,8 @@ namespace SFG
 	{
 		SFG_ASSERT(_entities.is_valid(entity));
 		_rotations.get(entity.index) = rot;
-		_metas.get(entity.index).flags.set(entity_flags::entity_flags_local_transform_dirty | entity_flags::entity_flags_abs_transform_dirty | entity_flags::entity_flags_abs_rotation_dirty);
-		visit_children(entity, [this](entity_handle e) { _metas.get(e.index).flags.set(entity_flags::entity_flags_abs_transform_dirty | entity_flags::entity_flags_abs_rotation_dirty); });
+		_metas.get(entity.index).flags.set(entity_flags::entity_flags_local_transform_dirty | entity_flags::entity_flags_abs_transform_dirty);
+		mark_abs_stale(entity.index, entity_flags::entity_flags_abs_rotation_dirty | entity_flags::entity_flags_abs_matrix_stale | entity_flags::entity_flags_abs_aabb_stale);
 	}
 
 	void entity_manager::set_entity_rotation_abs(entity_handle entity, const quat& rot)
@@ -367,22 +452,18 @@ namespace SFG
 
 	const quat& entity_manager::get_entity_rotation_abs(entity_handle entity)
 	{
-		entity_family& fam			  = _families.get(entity.index);
-		entity_handle  parent		  = fam.parent;
-		const quat&	   local_rotation = _rotations.get(entity.index);
-
-		if (parent.is_null())
-			return local_rotation;
+		SFG_ASSERT(_entities.is_valid(entity));
 
-		bitmask<uint16>& flags	 = _metas.get(entity.index).flags;
 		quat&			 abs_rot = _rotations_abs.get(entity.index);
-
-		if (flags.is_set(entity_flags::entity_flags_abs_rotation_dirty))
-		{
-			abs_rot = get_entity_rotation_abs(parent) * local_rotation;
-			flags.remove(entity_flags::entity_flags_abs_rotation_dirty);
-		}
-
+		bitmask<uint16>& flags	 = _metas.get(entity.index).flags;
+		if (!flags.is_set(entity_flags::entity_flags_abs_rotation_dirty))
+			return abs_rot;
+
+		// Parent is refreshed first, a clean entity never sits below a stale one.
+		const entity_handle parent		   = _families.get(entity.index).parent;
+		const quat&			local_rotation = _rotations.get(entity.index);
+		abs_rot							   = parent.is_null() ? local_rotation : (get_entity_rotation_abs(parent) * local_rotation);
+		flags.remove(entity_flags::entity_flags_abs_rotation_dirty);
 		return abs_rot;
 	}
 
@@ -403,7 +484,7 @@ namespace SFG
 		SFG_ASSERT(_entities.is_valid(entity));
 		_scales.get(entity.index) = scale;
 		_metas.get(entity.index).flags.set(entity_flags::entity_flags_local_transform_dirty | entity_flags::entity_flags_abs_transform_dirty);
-		visit_children(entity, [this](entity_handle e) { _metas.get(e.index).flags.set(entity_flags::entity_flags_abs_transform_dirty); });
+		mark_abs_stale(entity.index, entity_flags::entity_flags_abs_matrix_stale | entity_flags::entity_flags_abs_aabb_stale);
 	}
 
 	void entity_manager::set_entity_scale_abs(entity_handle entity, const vector3& scale)
@@ -448,18 +529,16 @@ namespace SFG
 	{
 		SFG_ASSERT(_entities.is_valid(entity));
 
-		bitmask<uint16>& flags		= _metas.get(entity.index).flags;
 		matrix4x3&		 abs_matrix = _abs_matrices.get(entity.index);
-
-		if (!flags.is_set(entity_flags::entity_flags_abs_transform_dirty))
+		bitmask<uint16>& flags		= _metas.get(entity.index).flags;
+		if (!flags.is_set(entity_flags::entity_flags_abs_matrix_stale))
 			return abs_matrix;
 
-		entity_family& fam	  = _families.get(entity.index);
-		entity_handle  parent = fam.parent;
-
-		const matrix4x3& local_transform = get_entity_transform(entity);
-		abs_matrix						 = parent.is_null() ? local_transform : (get_entity_transform_abs(parent) * local_transform);
-		flags.remove(entity_flags::entity_flags_abs_transform_dirty);
+		// Parent is refreshed first, a clean entity never sits below a stale one.
+		const entity_handle parent			= _families.get(entity.index).parent;
+		const matrix4x3&	local_transform = get_entity_transform(entity);
+		abs_matrix							= parent.is_null() ? local_transform : (get_entity_transform_abs(parent) * local_transform);
+		flags.remove(entity_flags::entity_flags_abs_matrix_stale);
 		return abs_matrix;
 	}
 
@@ -519,4 +598,134 @@ namespace SFG
 		return matrix4x3::transform(interpolated_pos, interpolated_rot, interpolated_scale);
 	}
 
-}
\ No newline at end of file
+	/* ----------------                     ---------------- */
+	/* ---------------- transform hierarchy ---------------- */
+	/* ----------------                     ---------------- */
+
+	uint8 entity_manager::find_query_driver(uint32 all) const
+	{
+		SFG_ASSERT(all != 0);
+
+		uint8  driver = 0;
+		uint32 least  = UINT32_MAX;
+		for (uint8 i = 0; i < trait_types::trait_type_allowed_max; i++)
+		{
+			if ((all & (1u << i)) == 0)
+				continue;
+
+			const uint32 count = _traits[i].storage.get_count();
+			if (count < least)
+			{
+				least  = count;
+				driver = i;
+			}
+		}
+
+		return driver;
+	}
+
+	void entity_manager::update_transforms()
+	{
+		SFG_PROFILE_FUNCTION();
+		// A level only depends on the one above it, entities within a level are independent.
+		for (vector<transform_node>& level : _transform_levels)
+		{
+			const uint32 count = static_cast<uint32>(level.size());
+			if (count == 0)
+				break;
+
+			job_system::get().parallel_for_batched(count, TRANSFORM_BATCH_SIZE, [this, &level](uint32 start, uint32 end) {
+				for (uint32 i = start; i < end; i++)
+					update_transform_node(level[i]);
+			});
+		}
+	}
+
+	void entity_manager::update_transform_node(const transform_node& node)
+	{
+		bitmask<uint16>& flags			= _metas.get(node.entity).flags;
+		const bool		 has_parent		= node.parent != NULL_WORLD_ID;
+		const bool		 parent_changed = has_parent && _metas.get(node.parent).flags.is_set(entity_flags::entity_flags_abs_transform_changed);
+
+		if (!parent_changed && !flags.is_set(entity_flags::entity_flags_abs_transform_dirty))
+		{
+			flags.remove(entity_flags::entity_flags_abs_transform_changed);
+			return;
+		}
+
+		matrix4x3& local = _matrices.get(node.entity);
+		if (flags.is_set(entity_flags::entity_flags_local_transform_dirty))
+			local = matrix4x3::transform(_positions.get(node.entity), _rotations.get(node.entity), _scales.get(node.entity));
+
+		if (has_parent)
+		{
+			_abs_matrices.get(node.entity)	= _abs_matrices.get(node.parent) * local;
+			_rotations_abs.get(node.entity) = _rotations_abs.get(node.parent) * _rotations.get(node.entity);
+		}
+		else
+		{
+			_abs_matrices.get(node.entity)	= local;
+			_rotations_abs.get(node.entity) = _rotations.get(node.entity);
+		}
+
+		_aabbs_abs.get(node.entity) = _aabbs.get(node.entity).transform(_abs_matrices.get(node.entity));
+
+		flags.remove(entity_flags::entity_flags_local_transform_dirty | entity_flags::entity_flags_abs_transform_dirty | entity_flags::entity_flags_abs_rotation_dirty | entity_flags::entity_flags_abs_matrix_stale | entity_flags::entity_flags_abs_aabb_stale);
+		flags.set(entity_flags::entity_flags_abs_transform_changed);
+	}
+
+	void entity_manager::mark_abs_stale(world_id entity, uint16 stale_flags)
+	{
+		// An entity carrying the flags already had its subtree marked along with it.
+		bitmask<uint16>& flags = _metas.get(entity).flags;
+		if (flags.is_all_set(stale_flags))
+			return;
+
+		flags.set(stale_flags);
+		visit_subtree(entity, [this, stale_flags](world_id child) {
+			bitmask<uint16>& child_flags = _metas.get(child).flags;
+			if (child_flags.is_all_set(stale_flags))
+				return false;
+
+			child_flags.set(stale_flags);
+			return true;
+		});
+	}
+
+	void entity_manager::hierarchy_insert(world_id entity, world_id parent, uint32 depth)
+	{
+		if (depth >= _transform_levels.size())
+			_transform_levels.resize(depth + 1);
+
+		vector<transform_node>& level = _transform_levels[depth];
+		entity_family&			fam	  = _families.get(entity);
+		fam.depth					  = depth;
+		fam.level_slot				  = static_cast<uint32>(level.size());
+		level.push_back({.entity = entity, .parent = parent});
+	}
+
+	void entity_manager::hierarchy_remove(world_id entity)
+	{
+		const entity_family&	fam	  = _families.get(entity);
+		vector<transform_node>& level = _transform_levels[fam.depth];
+
+		const transform_node last			  = level.back();
+		level[fam.level_slot]				  = last;
+		_families.get(last.entity).level_slot = fam.level_slot;
+		level.pop_back();
+	}
+
+	void entity_manager::hierarchy_move(world_id entity, world_id parent, uint32 depth)
+	{
+		hierarchy_remove(entity);
+		hierarchy_insert(entity, parent, depth);
+
+		// Whole subtree shifts along with the entity, parents are visited before their children.
+		visit_subtree(entity, [this](world_id child) {
+			const world_id child_parent = _families.get(child).parent.index;
+			hierarchy_remove(child);
+			hierarchy_insert(child, child_parent, _families.get(child_parent).depth + 1);
+			return true;
+		});
+	}
+}
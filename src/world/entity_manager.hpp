@@ -4,23 +4,30 @@
 #include "common_world.hpp"
 #include "common_entity.hpp"
 #include "traits/common_trait.hpp"
-#include "memory/pool_allocator_simple.hpp"
-#include "memory/pool_allocator16.hpp"
+#include "memory/paged_array.hpp"
+#include "memory/paged_pool_allocator32.hpp"
+#include "memory/sparse_set16.hpp"
 #include "data/static_vector.hpp"
 #include "memory/chunk_allocator.hpp"
 #include "math/aabb.hpp"
 #include "math/matrix4x3.hpp"
 #include "math/quat.hpp"
 #include <gui/vekt.hpp>
+#include "thread/job_system.hpp"
 #include <functional>
+#include <cstddef>
 
 namespace SFG
 {
 	class world;
 
+	typedef void (*trait_free_function)(sparse_set16& storage, trait_handle handle);
+
 	struct trait_storage
 	{
-		pool_allocator16 storage;
+		sparse_set16									storage;
+		paged_array<trait_handle, ENTITY_PAGE_SIZE> owners; // per entity, valid where its trait mask bit is set.
+		trait_free_function							free_trait = nullptr;
 	};
 
 	class entity_manager
@@ -40,7 +47,9 @@ namespace SFG
 		void				 remove_child(entity_handle parent, entity_handle child);
 		void				 remove_from_parent(entity_handle entity);
 		entity_handle		 get_child_by_index(entity_handle parent, uint32 index);
+		void				 set_entity_aabb(entity_handle entity, const aabb& box);
 		const aabb&			 get_entity_aabb(entity_handle entity);
+		const aabb&			 get_entity_aabb_abs(entity_handle entity);
 		const entity_meta&	 get_entity_meta(entity_handle entity) const;
 		const entity_family& get_entity_family(entity_handle entity) const;
 
@@ -67,6 +76,9 @@ namespace SFG
 		const vector3&	 get_entity_prev_scale_abs(entity_handle entity) const;
 		matrix4x3		 calculate_interpolated_transform_abs(entity_handle entity, float interpolation);
 
+		/// Recomputes every dirty world matrix, parents before children, one hierarchy level at a time.
+		void update_transforms();
+
 		template <typename VisitFunc> void visit_children(entity_handle parent, VisitFunc f)
 		{
 			const entity_family& fam	= get_entity_family(parent);
@@ -96,36 +108,87 @@ namespace SFG
 
 		template <typename T> void init_trait_storage(uint32 max_count)
 		{
-			_traits[T::TYPE_INDEX].storage.init<T>(max_count);
+			static_assert(offsetof(T, meta) == 0, "Traits need to start with their meta!");
+			trait_storage& stg = _traits[T::TYPE_INDEX];
+			stg.storage.template init<T>(max_count);
+			stg.owners.grow(_entities.get_capacity());
+			stg.free_trait = &entity_manager::free_trait<T>;
 		}
 
+		/// An entity holds at most one trait of each type.
 		template <typename T> trait_handle add_trait(entity_handle entity)
 		{
-			pool_allocator16& storage = _traits[T::TYPE_INDEX].storage;
-			trait_handle	  handle  = storage.allocate<T>();
-			T&				  tr	  = storage.get<T>(handle);
-			tr						  = T();
-			tr.meta.entity			  = entity;
+			bitmask<uint32>& mask = _trait_masks.get(entity.index);
+			SFG_ASSERT(!mask.is_set(trait_mask<T>()));
+			mask.set(trait_mask<T>());
+
+			trait_storage& stg	  = _traits[T::TYPE_INDEX];
+			trait_handle   handle = stg.storage.template allocate<T>();
+			T&			   tr	  = stg.storage.template get<T>(handle);
+			tr.meta.entity		  = entity;
+			stg.owners.get(entity.index) = handle;
 			return handle;
 		}
 
 		template <typename T> T& get_trait(trait_handle handle)
 		{
-			pool_allocator16& storage = _traits[T::TYPE_INDEX].storage;
+			sparse_set16& storage = _traits[T::TYPE_INDEX].storage;
 			return storage.get<T>(handle);
 		}
-		template <typename T> const pool_allocator16& get_trait_storage() const
+
+		/// Traits of a type are packed, iterate get_dense<T>() up to get_count().
+		template <typename T> const sparse_set16& get_trait_storage() const
 		{
-			const pool_allocator16& storage = _traits[T::TYPE_INDEX].storage;
+			const sparse_set16& storage = _traits[T::TYPE_INDEX].storage;
 			return storage;
 		}
 
+		/// Moves the last trait of the type into the freed slot, handles stay valid.
 		template <typename T> void remove_trait(trait_handle handle)
 		{
-			pool_allocator16& storage = _traits[T::TYPE_INDEX].storage;
-			T&				  tr	  = storage.get<T>(handle);
-			tr.~T();
-			storage.free(handle);
+			sparse_set16&		storage = _traits[T::TYPE_INDEX].storage;
+			const entity_handle entity	= storage.template get<T>(handle).meta.entity;
+			_trait_masks.get(entity.index).remove(trait_mask<T>());
+			storage.template free<T>(handle);
+		}
+
+		template <typename T> bool has_trait(entity_handle entity) const
+		{
+			return _trait_masks.get(entity.index).is_set(trait_mask<T>());
+		}
+
+		template <typename T> T& get_entity_trait(entity_handle entity)
+		{
+			SFG_ASSERT(has_trait<T>(entity));
+			trait_storage& stg = _traits[T::TYPE_INDEX];
+			return stg.storage.template get<T>(stg.owners.get(entity.index));
+		}
+
+		inline uint32 get_trait_mask(entity_handle entity) const
+		{
+			return _trait_masks.get(entity.index).value();
+		}
+
+		/// f(entity_handle, T&...) for every entity with all of T & none of the without mask (see trait_mask()). Walks the smallest storage of T,
+		/// traits & entities can't be added or removed from within f.
+		template <typename... T, typename F> void query(F&& f, uint32 without = 0)
+		{
+			const uint32		all		= trait_mask<T...>();
+			const sparse_set16& storage = _traits[find_query_driver(all)].storage;
+			const uint16		count	= storage.get_count();
+			for (uint16 i = 0; i < count; i++)
+				visit_query<T...>(storage, i, all, without, f);
+		}
+
+		/// Same as query(), batches run on the job system so f needs to be safe to call concurrently.
+		template <typename... T, typename F> void query_parallel(uint32 batch_size, F&& f, uint32 without = 0)
+		{
+			const uint32		all		= trait_mask<T...>();
+			const sparse_set16& storage = _traits[find_query_driver(all)].storage;
+			job_system::get().parallel_for_batched(storage.get_count(), batch_size, [&](uint32 start, uint32 end) {
+				for (uint32 i = start; i < end; i++)
+					visit_query<T...>(storage, static_cast<uint16>(i), all, without, f);
+			});
 		}
 
 		inline chunk_allocator32& get_trait_aux_memory()
@@ -145,33 +208,95 @@ namespace SFG
 			return _world;
 		}
 
-		inline pool_allocator16& get_entities()
+		inline paged_pool_allocator32<ENTITY_PAGE_SIZE>& get_entities()
 		{
 			return _entities;
 		}
 
 	private:
+		struct transform_node
+		{
+			world_id entity = 0;
+			world_id parent = NULL_WORLD_ID;
+		};
+
+		void grow_entity_data(size_t capacity);
 		void reset_all_entity_data();
 		void reset_entity_data(world_id id);
 
+		void hierarchy_insert(world_id entity, world_id parent, uint32 depth);
+		void hierarchy_remove(world_id entity);
+		void hierarchy_move(world_id entity, world_id parent, uint32 depth);
+		void mark_abs_stale(world_id entity, uint16 stale_flags);
+		void update_transform_node(const transform_node& node);
+
+		template <typename T> static void free_trait(sparse_set16& storage, trait_handle handle)
+		{
+			storage.template free<T>(handle);
+		}
+
+		/// Pre-order walk below entity without recursion, f returns false to skip the children of a node.
+		template <typename F> void visit_subtree(world_id entity, F&& f)
+		{
+			entity_handle current = _families.get(entity).first_child;
+			while (!current.is_null())
+			{
+				const entity_family& fam = _families.get(current.index);
+				if (f(current.index) && !fam.first_child.is_null())
+				{
+					current = fam.first_child;
+					continue;
+				}
+
+				// Climb until a next sibling is found or the walk is back at entity.
+				while (!current.is_null())
+				{
+					const entity_family& up = _families.get(current.index);
+					if (!up.next_sibling.is_null())
+					{
+						current = up.next_sibling;
+						break;
+					}
+
+					current = up.parent.index == entity ? entity_handle{} : up.parent;
+				}
+			}
+		}
+
+		/// Type index of the required storage with the fewest traits.
+		uint8 find_query_driver(uint32 all) const;
+
+		template <typename... T, typename F> inline void visit_query(const sparse_set16& storage, uint16 dense_index, uint32 all, uint32 without, F& f)
+		{
+			const entity_handle entity = reinterpret_cast<const trait_meta*>(storage.get_dense_raw(dense_index))->entity;
+			const uint32		mask   = _trait_masks.get(entity.index).value();
+			if ((mask & all) != all || (mask & without) != 0)
+				return;
+
+			f(entity, get_entity_trait<T>(entity)...);
+		}
+
 	private:
 		world& _world;
 
-		pool_allocator16					 _entities		 = {};
-		pool_allocator_simple<entity_meta>	 _metas			 = {};
-		pool_allocator_simple<entity_family> _families		 = {};
-		pool_allocator_simple<vector3>		 _positions		 = {};
-		pool_allocator_simple<vector3>		 _prev_positions = {};
-		pool_allocator_simple<quat>			 _rotations		 = {};
-		pool_allocator_simple<quat>			 _rotations_abs	 = {};
-		pool_allocator_simple<quat>			 _prev_rotations = {};
-		pool_allocator_simple<vector3>		 _scales		 = {};
-		pool_allocator_simple<vector3>		 _prev_scales	 = {};
-		pool_allocator_simple<aabb>			 _aabbs			 = {};
-		pool_allocator_simple<matrix4x3>	 _matrices		 = {};
-		pool_allocator_simple<matrix4x3>	 _abs_matrices	 = {};
+		paged_pool_allocator32<ENTITY_PAGE_SIZE>	 _entities		 = {};
+		paged_array<entity_meta, ENTITY_PAGE_SIZE>	 _metas			 = {};
+		paged_array<entity_family, ENTITY_PAGE_SIZE> _families		 = {};
+		paged_array<vector3, ENTITY_PAGE_SIZE>		 _positions		 = {};
+		paged_array<vector3, ENTITY_PAGE_SIZE>		 _prev_positions = {};
+		paged_array<quat, ENTITY_PAGE_SIZE>			 _rotations		 = {};
+		paged_array<quat, ENTITY_PAGE_SIZE>			 _rotations_abs	 = {};
+		paged_array<quat, ENTITY_PAGE_SIZE>			 _prev_rotations = {};
+		paged_array<vector3, ENTITY_PAGE_SIZE>		 _scales		 = {};
+		paged_array<vector3, ENTITY_PAGE_SIZE>		 _prev_scales	 = {};
+		paged_array<aabb, ENTITY_PAGE_SIZE>			 _aabbs			 = {};
+		paged_array<aabb, ENTITY_PAGE_SIZE>			 _aabbs_abs		 = {};
+		paged_array<matrix4x3, ENTITY_PAGE_SIZE>	 _matrices		 = {};
+		paged_array<matrix4x3, ENTITY_PAGE_SIZE>	 _abs_matrices	 = {};
+		paged_array<bitmask<uint32>, ENTITY_PAGE_SIZE> _trait_masks	 = {};
 
 		static_vector<trait_storage, trait_types::trait_type_allowed_max> _traits;
 		chunk_allocator32												  _trait_aux_memory;
+		vector<vector<transform_node>>									  _transform_levels;
 	};
 }
@@ -0,0 +1,119 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "system_scheduler.hpp"
+#include "world.hpp"
+#include "thread/job_system.hpp"
+#include "io/assert.hpp"
+#include "common/profiler.hpp"
+#include <algorithm>
+
+namespace SFG
+{
+	uint32 system_scheduler::add_system(const system_desc& desc)
+	{
+		SFG_ASSERT(desc.function != nullptr);
+		const uint32 id = _next_id++;
+		_systems.push_back({.desc = desc, .id = id, .alive = 1});
+		_dirty = 1;
+		return id;
+	}
+
+	void system_scheduler::remove_system(uint32 id)
+	{
+		auto it = std::find_if(_systems.begin(), _systems.end(), [id](const system_entry& e) { return e.id == id && e.alive; });
+		SFG_ASSERT(it != _systems.end());
+		it->alive = 0;
+		_dirty	  = 1;
+	}
+
+	void system_scheduler::clear()
+	{
+		_systems.clear();
+		_order.clear();
+		_wave_ends.clear();
+		_wave_flags.clear();
+		_dirty = 0;
+	}
+
+	bool system_scheduler::conflicts(const system_desc& a, const system_desc& b)
+	{
+		if (((a.reads | a.writes | b.reads | b.writes) & SYSTEM_ACCESS_STRUCTURE) != 0)
+			return true;
+
+		return (a.writes & (b.reads | b.writes)) != 0 || (b.writes & a.reads) != 0;
+	}
+
+	void system_scheduler::build()
+	{
+		if (!_dirty)
+			return;
+
+		_dirty = 0;
+		_systems.erase(std::remove_if(_systems.begin(), _systems.end(), [](const system_entry& e) { return !e.alive; }), _systems.end());
+
+		const uint32 count = static_cast<uint32>(_systems.size());
+		uint32		 waves = 0;
+		for (uint32 i = 0; i < count; i++)
+		{
+			system_entry& e = _systems[i];
+			e.wave			= 0;
+			for (uint32 j = 0; j < i; j++)
+			{
+				if (_systems[j].wave >= e.wave && conflicts(_systems[j].desc, e.desc))
+					e.wave = _systems[j].wave + 1;
+			}
+			waves = std::max(waves, e.wave + 1);
+		}
+
+		_order.resize(count);
+		for (uint32 i = 0; i < count; i++)
+			_order[i] = i;
+		std::stable_sort(_order.begin(), _order.end(), [this](uint32 a, uint32 b) { return _systems[a].wave < _systems[b].wave; });
+
+		_wave_ends.resize(waves);
+		_wave_flags.assign(waves, 0);
+		for (uint32 i = 0; i < count; i++)
+		{
+			const system_entry& e = _systems[_order[i]];
+			_wave_ends[e.wave]	  = i + 1;
+
+			// new entities start out stale too.
+			if (((e.desc.reads | e.desc.writes) & (SYSTEM_ACCESS_TRANSFORMS | SYSTEM_ACCESS_STRUCTURE)) != 0)
+				_wave_flags[e.wave] |= wave_flags_uses_transforms;
+			if ((e.desc.writes & SYSTEM_ACCESS_TRANSFORMS) != 0 || ((e.desc.reads | e.desc.writes) & SYSTEM_ACCESS_STRUCTURE) != 0)
+				_wave_flags[e.wave] |= wave_flags_writes_transforms;
+		}
+	}
+
+	void system_scheduler::execute(world& w, float dt)
+	{
+		build();
+
+		entity_manager& em	  = w.get_entity_manager();
+		uint32			begin = 0;
+		bool			stale = true; // anything may have moved since the last tick.
+
+		for (uint32 wave = 0; wave < _wave_ends.size(); wave++)
+		{
+			const uint32  end	= _wave_ends[wave];
+			const uint32* order = _order.data() + begin;
+			const uint32  count = end - begin;
+
+			if (stale && (_wave_flags[wave] & wave_flags_uses_transforms) != 0)
+			{
+				em.update_transforms();
+				stale = false;
+			}
+
+			job_system::get().parallel_for(count, 1, [&](uint32 i) {
+				const system_desc& desc = _systems[order[i]].desc;
+				SFG_PROFILE_ZONE(desc.name);
+				desc.function(w, dt, desc.user_data);
+			});
+
+			if ((_wave_flags[wave] & wave_flags_writes_transforms) != 0)
+				stale = true;
+			begin = end;
+		}
+	}
+}
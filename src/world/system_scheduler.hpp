@@ -0,0 +1,78 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "data/vector.hpp"
+
+namespace SFG
+{
+	class world;
+
+	typedef void (*system_function)(world& w, float dt, void* user_data);
+
+	// access bits 0 - 31 are trait types, see trait_mask().
+#define SYSTEM_ACCESS_TRANSFORMS (1ull << 32) // entity positions, rotations, scales & bounds.
+#define SYSTEM_ACCESS_STRUCTURE	 (1ull << 33) // creates or destroys entities or traits, runs alone.
+#define SYSTEM_INVALID_ID		 UINT32_MAX
+
+	struct system_desc
+	{
+		const char*		name	  = "";
+		system_function function  = nullptr;
+		void*			user_data = nullptr;
+		uint64			reads	  = 0;
+		uint64			writes	  = 0;
+	};
+
+	/*
+		Systems run in registration order, except that ones which don't conflict are grouped into the same wave and run in parallel on the job
+		system. Two systems conflict when either writes something the other reads or writes. A system lands in the wave after the last earlier
+		system it conflicts with, so the order of conflicting systems is kept.
+		Reading transforms lazily refreshes the entity manager's world space caches, which isn't safe from parallel readers. Transforms are
+		settled before the first wave touching them & again after every wave that wrote them, so readers in a wave only ever read.
+	*/
+	class system_scheduler
+	{
+	public:
+		uint32 add_system(const system_desc& desc);
+		void   remove_system(uint32 id);
+		void   clear();
+
+		/// Blocks until every system is done.
+		void execute(world& w, float dt);
+
+		inline uint32 get_wave_count()
+		{
+			build();
+			return static_cast<uint32>(_wave_ends.size());
+		}
+
+		static bool conflicts(const system_desc& a, const system_desc& b);
+
+	private:
+		enum wave_flags : uint8
+		{
+			wave_flags_uses_transforms	 = 1 << 0,
+			wave_flags_writes_transforms = 1 << 1,
+		};
+
+		struct system_entry
+		{
+			system_desc desc  = {};
+			uint32		id	  = 0;
+			uint32		wave  = 0;
+			uint8		alive = 0;
+		};
+
+		void build();
+
+	private:
+		vector<system_entry> _systems;
+		vector<uint32>		 _order;	 // entry indices sorted by wave.
+		vector<uint32>		 _wave_ends; // one past the wave's last in _order.
+		vector<uint8>		 _wave_flags;
+		uint32				 _next_id = 0;
+		uint8				 _dirty	  = 0;
+	};
+}
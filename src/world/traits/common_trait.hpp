@@ -23,9 +23,15 @@ namespace SFG
 
 	typedef pool_handle16 trait_handle;
 
+	/// Every trait starts with its meta, queries read the owning entity through it.
 	struct trait_meta
 	{
 		entity_handle  entity;
 		bitmask<uint8> flags;
 	};
+
+	template <typename... T> constexpr uint32 trait_mask()
+	{
+		return (0u | ... | (1u << T::TYPE_INDEX));
+	}
 }
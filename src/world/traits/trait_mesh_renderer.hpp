@@ -70,6 +70,7 @@ namespace SFG
 		resource_handle mesh		   = {};
 		chunk_handle32	materials	   = {};
 		uint16			material_count = 0;
+		uint8			lod			   = 0; // last selected level, kept for hysteresis.
 	};
 
 }
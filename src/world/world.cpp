@@ -13,20 +13,16 @@ using json = nlohmann::json;
 #endif
 
 /* DEBUG */
-#include <algorithm>
-#include <execution>
 #include "gfx/renderer.hpp"
 #include "resources/texture.hpp"
-#include "resources/texture_raw.hpp"
 #include "resources/shader.hpp"
 #include "resources/material.hpp"
 #include "resources/model.hpp"
 #include "resources/skin.hpp"
 #include "resources/mesh.hpp"
 #include "resources/animation.hpp"
-#include "platform/time.hpp"
+#include "common/profiler.hpp"
 #include "gfx/world/world_renderer.hpp"
-#include "resources/model_raw.hpp"
 #include "resources/model_node.hpp"
 #include "resources/primitive.hpp"
 #include "world/traits/trait_mesh_renderer.hpp"
@@ -52,35 +48,6 @@ namespace SFG
 		_entity_manager.init();
 	}
 
-	static vector<const char*> debug_textures = {
-		"assets/boombox/boombox_base.stkfrg",
-		"assets/boombox/boombox_emissive.stkfrg",
-		"assets/boombox/boombox_normal.stkfrg",
-		"assets/boombox/boombox_orm.stkfrg",
-		"assets/cesium_man/cesium_man_base.stkfrg",
-	};
-
-	static vector<const char*> debug_mats = {
-		"assets/boombox/boombox_material.stkfrg",
-		//"assets/cesium_man/cesium_man_material.stkfrg",
-	};
-
-	static vector<const char*> debug_shaders = {
-		"assets/shaders/object/default_lit.stkfrg",
-		"assets/shaders/object/default_lit_skinned.stkfrg",
-	};
-
-	static vector<const char*> debug_models = {
-		"assets/boombox/boombox.gltf",
-		"assets/cesium_man/CesiumMan.gltf",
-	};
-
-	static vector<resource_handle> loaded_debug_textures	  = {};
-	static vector<resource_handle> loaded_debug_mats		  = {};
-	static vector<resource_handle> loaded_debug_shaders		  = {};
-	static vector<model_raw>	   loaded_debug_models_loaded = {};
-	static vector<resource_handle> loaded_debug_models		  = {};
-
 	void world::load_debug()
 	{
 		/*
@@ -144,132 +111,10 @@ namespace SFG
 		report();
 		return;
 		*/
-
-		vector<std::function<void()>> tasks;
-
-		const int64 mr_begin = time::get_cpu_microseconds();
-
-		/* Debug
-		for (const char* t : debug_textures)
-		{
-			const resource_handle handle = _resources.create_resource<texture>(TO_SIDC(t));
-			loaded_debug_textures.push_back(handle);
-			const string abs = engine_data::get().get_working_dir() + t;
-			tasks.push_back([handle, abs, this]() {
-				texture_raw raw;
-				texture& txt = _resources.get_resource<texture>(handle);
-				raw.create_from_file(abs.c_str());
-				raw.populate(txt);
-
-			});
-		}
-
-		for (const char* t : debug_shaders)
-		{
-			const resource_handle handle = _resources.create_resource<shader>(TO_SIDC(t));
-			loaded_debug_shaders.push_back(handle);
-			const string abs = engine_data::get().get_working_dir() + t;
-			tasks.push_back([handle, abs, this]() { _resources.get_resource<shader>(handle).create_from_file_vertex_pixel(abs.c_str(), false, renderer::get_bind_layout_global()); });
-		}
-
-		std::for_each(std::execution::par, tasks.begin(), tasks.end(), [](std::function<void()>& task) { task(); });
-
-		tasks.clear();
-
-		for (const char* t : debug_mats)
-		{
-			const resource_handle handle = _resources.create_resource<material>(TO_SIDC(t));
-			loaded_debug_mats.push_back(handle);
-			const string abs = engine_data::get().get_working_dir() + t;
-			tasks.push_back([handle, abs, this]() { _resources.get_resource<material>(handle).create_from_file(abs.c_str(), _resources); });
-		}
-
-		loaded_debug_models_loaded.resize(debug_models.size());
-		int i = 0;
-		for (const char* t : debug_models)
-		{
-			const resource_handle handle = _resources.create_resource<model>(TO_SIDC(t));
-			loaded_debug_models.push_back(handle);
-
-			const string relative = t;
-			const string abs	  = engine_data::get().get_working_dir() + relative;
-			const int	 index	  = i;
-			tasks.push_back([handle, abs, relative, this, index]() { loaded_debug_models_loaded[index].create_from_file(abs.c_str(), relative.c_str()); });
-			i++;
-		}
-
-		std::for_each(std::execution::par, tasks.begin(), tasks.end(), [](std::function<void()>& task) { task(); });
-
-		i = 0;
-		for (resource_handle handle : loaded_debug_models)
-		{
-			model& mdl = _resources.get_resource<model>(handle);
-			loaded_debug_models_loaded[i].cook(mdl, _resources.get_aux(), _resources);
-			i++;
-		}
-
-		for (resource_handle h : loaded_debug_textures)
-		{
-			_world_renderer->get_resource_uploads().add_pending_texture(&_resources.get_resource<texture>(h));
-		}
-
-		for (resource_handle h : loaded_debug_models)
-		{
-			model&				 m				= _resources.get_resource<model>(h);
-			const chunk_handle32 created_meshes = m.get_created_meshes();
-			const uint16		 meshes_count	= m.get_mesh_count();
-
-			chunk_allocator32& aux	   = _resources.get_aux();
-			resource_handle*   handles = meshes_count == 0 ? nullptr : aux.get<resource_handle>(created_meshes);
-
-			for (uint16 i = 0; i < meshes_count; i++)
-			{
-				resource_handle& handle = handles[i];
-				mesh&			 m		= _resources.get_resource<mesh>(handle);
-				_world_renderer->get_resource_uploads().add_pending_mesh(&m);
-			}
-		}
-
-		for (resource_handle h : loaded_debug_mats)
-		{
-			_world_renderer->get_resource_uploads().add_pending_material(&_resources.get_resource<material>(h));
-		}
-
-		const int64 mr_diff = time::get_cpu_microseconds() - mr_begin;
-		SFG_INFO("Resources took: {0} ms", mr_diff / 1000);
-
-		if (!loaded_debug_models.empty())
-			add_model_to_world(loaded_debug_models[0], &loaded_debug_mats[0], 1);
-			*/
 	}
 
 	void world::uninit()
 	{
-		for (resource_handle handle : loaded_debug_textures)
-		{
-			_resources.get_resource<texture>(handle).destroy();
-			_resources.destroy_resource<texture>(handle);
-		}
-
-		for (resource_handle handle : loaded_debug_mats)
-		{
-			_resources.get_resource<material>(handle).destroy();
-			_resources.destroy_resource<material>(handle);
-		}
-
-		for (resource_handle handle : loaded_debug_shaders)
-		{
-			_resources.get_resource<shader>(handle).destroy();
-			_resources.destroy_resource<shader>(handle);
-		}
-
-		for (resource_handle handle : loaded_debug_models)
-		{
-			_resources.get_resource<model>(handle).destroy(_resources, _resources.get_aux());
-
-			_resources.destroy_resource<model>(handle);
-		}
-
 		_entity_manager.uninit();
 		_resources.uninit();
 		_txt_allocator.reset();
@@ -281,10 +126,15 @@ namespace SFG
 
 	void world::tick(uint8 data_index, const vector2ui16& res, float dt)
 	{
+		SFG_PROFILE_FUNCTION();
+		// systems move entities around, world matrices are settled right after.
+		_systems.execute(*this, dt);
+		_entity_manager.update_transforms();
 	}
 
 	void world::pre_render(uint8 data_index, const vector2ui16& res)
 	{
+		SFG_PROFILE_FUNCTION();
 	}
 
 	entity_handle world::add_model_to_world(resource_handle handle, resource_handle* materials, uint32 material_size)
@@ -366,12 +216,14 @@ namespace SFG
 			SFG_ASSERT(mat_count != 0);
 			uint16* material_indices = aux.get<uint16>(m.get_material_indices());
 
-			trait_handle		 trait		 = _entity_manager.add_trait<trait_mesh_renderer>(created_node_entities[m.get_node_index()]);
+			const entity_handle	 node_entity = created_node_entities[m.get_node_index()];
+			trait_handle		 trait		 = _entity_manager.add_trait<trait_mesh_renderer>(node_entity);
 			trait_mesh_renderer& t			 = _entity_manager.get_trait<trait_mesh_renderer>(trait);
 			t.material_count				 = mat_count;
 			t.mesh							 = handle;
 			t.materials						 = aux.allocate<resource_handle>(mat_count);
 			resource_handle* trait_materials = aux.get<resource_handle>(t.materials);
+			_entity_manager.set_entity_aabb(node_entity, m.get_local_aabb());
 
 			for (uint16 j = 0; j < mat_count; j++)
 			{
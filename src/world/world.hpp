@@ -4,10 +4,11 @@
 #include "data/bitmask.hpp"
 #include "common_world.hpp"
 #include "data/vector.hpp"
-#include "memory/text_allocator.hpp"
+#include "memory/paged_text_allocator.hpp"
 #include "world/world_resources.hpp"
 #include "gfx/camera.hpp"
 #include "entity_manager.hpp"
+#include "system_scheduler.hpp"
 
 namespace SFG
 {
@@ -53,6 +54,11 @@ namespace SFG
 			return _flags;
 		}
 
+		inline system_scheduler& get_systems()
+		{
+			return _systems;
+		}
+
 		inline world_resources& get_resources()
 		{
 			return _resources;
@@ -63,7 +69,7 @@ namespace SFG
 			return _camera;
 		}
 
-		inline text_allocator<MAX_ENTITIES * 5>& get_text_allocator()
+		inline paged_text_allocator<ENTITY_TEXT_PAGE_SIZE>& get_text_allocator()
 		{
 			return _txt_allocator;
 		}
@@ -79,11 +85,12 @@ namespace SFG
 		}
 
 	private:
-		world_renderer*					 _world_renderer = nullptr;
-		world_resources					 _resources		 = {};
-		text_allocator<MAX_ENTITIES * 5> _txt_allocator;
-		bitmask<uint8>					 _flags = 0;
-		entity_manager					 _entity_manager;
-		camera							 _camera = {};
+		world_renderer*								_world_renderer = nullptr;
+		world_resources								_resources		= {};
+		paged_text_allocator<ENTITY_TEXT_PAGE_SIZE> _txt_allocator;
+		bitmask<uint8>								_flags = 0;
+		entity_manager								_entity_manager;
+		system_scheduler							_systems;
+		camera										_camera = {};
 	};
 }
\ No newline at end of file
@@ -58,7 +58,9 @@ namespace SFG
 	void world_resources::init(world* w)
 	{
 		_world = w;
+#ifdef SFG_TOOLMODE
 		debug_console::get()->register_console_function<const char*>("world_load_texture", std::bind(&world_resources::load_texture, this, std::placeholders::_1));
+#endif
 	}
 
 	void world_resources::uninit()
@@ -68,7 +70,9 @@ namespace SFG
 			stg.storage.reset();
 
 		_world = nullptr;
+#ifdef SFG_TOOLMODE
 		debug_console::get()->unregister_console_function("world_load_texture");
+#endif
 	}
 
 #ifdef SFG_TOOLMODE
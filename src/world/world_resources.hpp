@@ -55,7 +55,7 @@ namespace SFG
 		template <typename T> T& get_resource(resource_handle handle) const
 		{
 			SFG_ASSERT(T::TYPE_INDEX < _storages.size());
-			return _storages[T::TYPE_INDEX].storage.get<T>(handle);
+			return _storages[T::TYPE_INDEX].storage.template get<T>(handle);
 		}
 
 		template <typename T> T& get_resource_by_hash(string_id hash) const
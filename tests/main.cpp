@@ -0,0 +1,77 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "test.hpp"
+#include "thread/job_system.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace SFG;
+using namespace SFG::test;
+
+namespace
+{
+	void print_usage()
+	{
+		std::printf("usage: StakeforgeTests [options]\n"
+					"  --filter <text>    only cases whose group/name contains text\n"
+					"  --seed <value>     fixture seed, default %u\n"
+					"  --list             prints the cases without running them\n",
+					TEST_DEFAULT_SEED);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	test_config config = {};
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg	  = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+		if (std::strcmp(arg, "--list") == 0)
+		{
+			config.list = 1;
+			continue;
+		}
+
+		if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0)
+		{
+			print_usage();
+			return 0;
+		}
+
+		if (value == nullptr)
+		{
+			std::fprintf(stderr, "missing value for %s\n", arg);
+			print_usage();
+			return 1;
+		}
+
+		if (std::strcmp(arg, "--filter") == 0)
+			config.filter = value;
+		else if (std::strcmp(arg, "--seed") == 0)
+			config.seed = static_cast<uint32>(std::strtoul(value, nullptr, 0));
+		else
+		{
+			std::fprintf(stderr, "unknown option %s\n", arg);
+			print_usage();
+			return 1;
+		}
+
+		i++;
+	}
+
+	if (config.list)
+		return test_registry::get().run(config);
+
+	job_system::get().init(0);
+	job_system::get().register_thread();
+
+	const int result = test_registry::get().run(config);
+
+	job_system::get().unregister_thread();
+	job_system::get().uninit();
+	return result;
+}
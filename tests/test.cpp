@@ -0,0 +1,88 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "test.hpp"
+#include "data/string.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace SFG::test
+{
+	namespace
+	{
+		uint64 hash_name(const char* group, const char* name)
+		{
+			// fnv1a, so a case gets the same fixture no matter which others run.
+			uint64 h	   = 14695981039346656037ull;
+			auto   combine = [&h](const char* str) {
+				  for (; *str != 0; str++)
+				  {
+					  h ^= static_cast<uint8>(*str);
+					  h *= 1099511628211ull;
+				  }
+			};
+			combine(group);
+			combine("/");
+			combine(name);
+			return h;
+		}
+	}
+
+	bool test_context::check(bool condition, const char* expression, const char* file, int line)
+	{
+		_checks++;
+		if (condition)
+			return true;
+
+		_failures++;
+		std::printf("  failed: %s\n    at %s:%d\n", expression, file, line);
+		return false;
+	}
+
+	void test_registry::add(const test_case& c)
+	{
+		_cases.push_back(c);
+	}
+
+	int test_registry::run(const test_config& config)
+	{
+		std::sort(_cases.begin(), _cases.end(), [](const test_case& a, const test_case& b) {
+			const int group = std::strcmp(a.group, b.group);
+			return group != 0 ? group < 0 : std::strcmp(a.name, b.name) < 0;
+		});
+
+		uint32 ran	  = 0;
+		uint32 failed = 0;
+		uint32 checks = 0;
+
+		for (const test_case& c : _cases)
+		{
+			string full = c.group;
+			full += "/";
+			full += c.name;
+			if (config.filter != nullptr && full.find(config.filter) == string::npos)
+				continue;
+
+			if (config.list)
+			{
+				std::printf("%s\n", full.c_str());
+				continue;
+			}
+
+			std::printf("%s\n", full.c_str());
+			test_context ctx(hash_name(c.group, c.name) ^ config.seed);
+			c.function(ctx);
+
+			ran++;
+			checks += ctx.get_checks();
+			if (ctx.get_failures() != 0)
+				failed++;
+		}
+
+		if (config.list)
+			return 0;
+
+		std::printf("%u cases, %u checks, %u failed\n", ran, checks, failed);
+		return failed == 0 ? 0 : 1;
+	}
+}
@@ -0,0 +1,123 @@
+// Copyright (c) 2025 Inan Evin
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "data/vector.hpp"
+
+namespace SFG::test
+{
+#define TEST_DEFAULT_SEED 0x5F6Bu
+
+	/// Deterministic across platforms, fixtures draw everything from one of these.
+	struct test_random
+	{
+		uint64 state = 0;
+
+		inline uint32 next()
+		{
+			// pcg32.
+			const uint64 old		= state;
+			state					= old * 6364136223846793005ull + 1442695040888963407ull;
+			const uint32 xorshifted = static_cast<uint32>(((old >> 18u) ^ old) >> 27u);
+			const uint32 rot		= static_cast<uint32>(old >> 59u);
+			return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31u));
+		}
+
+		/// [0, max)
+		inline uint32 next(uint32 max)
+		{
+			return static_cast<uint32>((static_cast<uint64>(next()) * max) >> 32);
+		}
+
+		/// [min, max)
+		inline float range(float min, float max)
+		{
+			return min + (max - min) * (static_cast<float>(next() >> 8) * (1.0f / 16777216.0f));
+		}
+	};
+
+	/// Handed to every case, failed checks are printed & counted, the case keeps running after them.
+	class test_context
+	{
+	public:
+		test_context(uint64 seed)
+		{
+			_random.state = seed;
+			_random.next();
+		}
+
+		inline test_random& get_random()
+		{
+			return _random;
+		}
+
+		inline uint32 get_failures() const
+		{
+			return _failures;
+		}
+
+		inline uint32 get_checks() const
+		{
+			return _checks;
+		}
+
+		/// Returns the condition so a case can bail out before using what failed.
+		bool check(bool condition, const char* expression, const char* file, int line);
+
+	private:
+		test_random _random	  = {};
+		uint32		_failures = 0;
+		uint32		_checks	  = 0;
+	};
+
+	typedef void (*test_function)(test_context& ctx);
+
+	struct test_case
+	{
+		const char*	  group	   = "";
+		const char*	  name	   = "";
+		test_function function = nullptr;
+	};
+
+	struct test_config
+	{
+		const char* filter = nullptr; // substring of group/name.
+		uint32		seed   = TEST_DEFAULT_SEED;
+		uint8		list   = 0;
+	};
+
+	class test_registry
+	{
+	public:
+		static test_registry& get()
+		{
+			static test_registry instance;
+			return instance;
+		}
+
+		void add(const test_case& c);
+
+		/// Returns the process exit code.
+		int run(const test_config& config);
+
+	private:
+		vector<test_case> _cases;
+	};
+
+	struct test_registrar
+	{
+		test_registrar(const char* group, const char* name, test_function function)
+		{
+			test_registry::get().add({.group = group, .name = name, .function = function});
+		}
+	};
+}
+
+#define SFG_TEST(GROUP, NAME)                                                                                     \
+	static void								test_##GROUP##_##NAME(SFG::test::test_context& ctx);                \
+	static const SFG::test::test_registrar test_registrar_##GROUP##_##NAME(#GROUP, #NAME, &test_##GROUP##_##NAME); \
+	static void								test_##GROUP##_##NAME(SFG::test::test_context& ctx)
+
+#define SFG_CHECK(EXPRESSION)			  ctx.check(static_cast<bool>(EXPRESSION), #EXPRESSION, __FILE__, __LINE__)
+#define SFG_CHECK_NEAR(A, B, TOLERANCE) ctx.check(((A) - (B)) <= (TOLERANCE) && ((B) - (A)) <= (TOLERANCE), #A " ~= " #B, __FILE__, __LINE__)
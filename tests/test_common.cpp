@@ -0,0 +1,63 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "test.hpp"
+#include "common/profiler.hpp"
+#include "io/file_system.hpp"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace SFG;
+using namespace SFG::test;
+
+#ifdef ENABLE_PROFILER
+
+namespace
+{
+	uint32 count_occurrences(const std::string& text, const char* what)
+	{
+		uint32 count = 0;
+		for (size_t pos = text.find(what); pos != std::string::npos; pos = text.find(what, pos + 1))
+			count++;
+		return count;
+	}
+}
+
+SFG_TEST(common, profiler_reuses_thread_slots)
+{
+	profiler& p = profiler::get();
+	p.begin_capture();
+
+	// more restarts than there are slots, a named thread keeps landing in the one it had.
+	for (uint32 i = 0; i < PROFILER_MAX_THREADS * 2; i++)
+	{
+		std::thread t([] {
+			SFG_PROFILE_THREAD("test_restarted");
+			SFG_PROFILE_ZONE("test_restarted_zone");
+		});
+		t.join();
+	}
+
+	std::thread unnamed([] { SFG_PROFILE_ZONE("test_unnamed_zone"); });
+	unnamed.join();
+
+	p.end_capture();
+
+	const char* path = "profiler_reuses_thread_slots.json";
+	if (!SFG_CHECK(p.export_chrome_trace(path)))
+		return;
+
+	std::ifstream	  file(path);
+	std::stringstream ss;
+	ss << file.rdbuf();
+	file.close();
+	file_system::delete_file(path);
+
+	const std::string trace = ss.str();
+	SFG_CHECK(count_occurrences(trace, "\"test_restarted\"") == 1);
+	SFG_CHECK(count_occurrences(trace, "test_restarted_zone") == PROFILER_MAX_THREADS * 2);
+	SFG_CHECK(count_occurrences(trace, "test_unnamed_zone") == 1);
+}
+
+#endif
@@ -0,0 +1,268 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "test.hpp"
+#include "data/ostream.hpp"
+#include "data/istream.hpp"
+#include "serialization/compressor.hpp"
+#include "resources/vertex.hpp"
+#include "memory/memory.hpp"
+#include <lz4/lz4.h>
+
+using namespace SFG;
+using namespace SFG::test;
+
+namespace
+{
+	/// Repeating runs with some noise, compresses well but not trivially.
+	void make_payload(ostream& stream, size_t size, test_random& rnd)
+	{
+		stream.create(size);
+		for (size_t i = 0; i < size; i++)
+		{
+			const uint8 v = static_cast<uint8>(rnd.next(8) == 0 ? rnd.next(256) : (i / 64) & 0xFF);
+			stream << v;
+		}
+	}
+
+	bool equals(const istream& a, const ostream& b)
+	{
+		return a.get_size() == b.get_size() && (b.get_size() == 0 || SFG_MEMCMP(a.get_raw(), b.get_raw(), b.get_size()) == 0);
+	}
+
+	/// What compressor wrote before the block container.
+	ostream write_legacy(ostream& raw, bool compress)
+	{
+		const uint8	 compressed = compress ? 1 : 0;
+		const uint32 total		= static_cast<uint32>(raw.get_size() + COMPRESSOR_LEGACY_TRAILER);
+
+		ostream src;
+		src.create(total);
+		src.write_raw(raw.get_raw(), raw.get_size());
+		src << compressed << total;
+
+		if (!compress)
+			return src;
+
+		const int bound = LZ4_compressBound(static_cast<int>(src.get_size()));
+		ostream	  out;
+		out.create(static_cast<size_t>(bound));
+		const int written = LZ4_compress_default((const char*)src.get_raw(), (char*)out.get_raw(), static_cast<int>(src.get_size()), bound);
+		out.shrink(static_cast<size_t>(written));
+		src.destroy();
+		return out;
+	}
+
+#define TEST_STORED_SIZE 4096
+#define TEST_BLOCKS_SIZE (COMPRESSOR_BLOCK_SIZE * 4 + 1234)
+}
+
+SFG_TEST(data, compressor_round_trip)
+{
+	const size_t sizes[] = {0, TEST_STORED_SIZE, TEST_BLOCKS_SIZE};
+
+	for (size_t size : sizes)
+	{
+		ostream raw;
+		make_payload(raw, size, ctx.get_random());
+		ostream packed = compressor::compress(raw);
+		istream in(packed.get_raw(), packed.get_size());
+		istream out = compressor::decompress(in);
+
+		SFG_CHECK(compressed_header::has_magic(packed.get_raw(), packed.get_size()));
+		SFG_CHECK(equals(out, raw));
+
+		out.destroy();
+		packed.destroy();
+		raw.destroy();
+	}
+}
+
+SFG_TEST(data, compressor_range)
+{
+	ostream raw;
+	make_payload(raw, TEST_BLOCKS_SIZE, ctx.get_random());
+	ostream packed = compressor::compress(raw);
+
+	compressed_blocks blocks;
+	if (!SFG_CHECK(blocks.parse(packed.get_raw(), packed.get_size())))
+		return;
+
+	SFG_CHECK(!blocks.is_stored());
+	SFG_CHECK(blocks.get_block_count() == 5);
+
+	// straddles the first block boundary, ends inside the partial last block.
+	const size_t ranges[][2] = {{COMPRESSOR_BLOCK_SIZE - 100, 200}, {COMPRESSOR_BLOCK_SIZE * 4, 1234}, {17, COMPRESSOR_BLOCK_SIZE * 3}};
+	vector<uint8> out;
+
+	for (const size_t* r : ranges)
+	{
+		out.resize(r[1]);
+		SFG_CHECK(blocks.decompress_range(r[0], r[1], out.data(), false));
+		SFG_CHECK(SFG_MEMCMP(out.data(), raw.get_raw() + r[0], r[1]) == 0);
+	}
+
+	packed.destroy();
+	raw.destroy();
+}
+
+SFG_TEST(data, compressor_block_decoder_chunks)
+{
+	ostream raw;
+	make_payload(raw, TEST_BLOCKS_SIZE, ctx.get_random());
+	ostream packed = compressor::compress(raw);
+
+	// odd sized pieces so headers, the index and blocks all get split.
+	block_decoder decoder;
+	size_t		  fed = 0;
+	while (fed < packed.get_size())
+	{
+		const size_t remaining = packed.get_size() - fed;
+		const size_t chunk	   = 1 + ctx.get_random().next(40000);
+		const size_t size	   = chunk < remaining ? chunk : remaining;
+		if (!SFG_CHECK(decoder.feed(packed.get_raw() + fed, size)))
+			break;
+		fed += size;
+	}
+
+	SFG_CHECK(decoder.is_done());
+	istream out = decoder.release();
+	SFG_CHECK(equals(out, raw));
+
+	out.destroy();
+	packed.destroy();
+	raw.destroy();
+}
+
+SFG_TEST(data, compressor_reads_legacy)
+{
+	const size_t sizes[] = {TEST_STORED_SIZE, TEST_BLOCKS_SIZE};
+
+	for (size_t size : sizes)
+	{
+		for (uint32 compress = 0; compress < 2; compress++)
+		{
+			ostream raw;
+			make_payload(raw, size, ctx.get_random());
+			ostream legacy = write_legacy(raw, compress != 0);
+			istream in(legacy.get_raw(), legacy.get_size());
+			istream out = compressor::decompress(in);
+
+			SFG_CHECK(!compressed_header::has_magic(legacy.get_raw(), legacy.get_size()));
+			SFG_CHECK(equals(out, raw));
+
+			// ranges of compressed legacy data decode from the start of the stream.
+			compressed_blocks blocks;
+			vector<uint8>	  part(100);
+			SFG_CHECK(blocks.parse(legacy.get_raw(), legacy.get_size()));
+			SFG_CHECK(blocks.is_stored() == (compress == 0));
+			SFG_CHECK(blocks.decompress_range(size - 200, 100, part.data()));
+			SFG_CHECK(SFG_MEMCMP(part.data(), raw.get_raw() + size - 200, 100) == 0);
+
+			out.destroy();
+			legacy.destroy();
+			raw.destroy();
+		}
+	}
+}
+
+SFG_TEST(data, compressor_rejects_newer_version)
+{
+	ostream raw;
+	make_payload(raw, TEST_STORED_SIZE, ctx.get_random());
+	ostream packed = compressor::compress(raw);
+
+	// version sits right after magic, block size, raw size & block count.
+	const uint32 version = COMPRESSOR_VERSION + 1;
+	SFG_MEMCPY(packed.get_raw() + 20, &version, sizeof(uint32));
+
+	compressed_blocks blocks;
+	block_decoder	  decoder;
+	SFG_CHECK(!blocks.parse(packed.get_raw(), packed.get_size()));
+	SFG_CHECK(!decoder.feed(packed.get_raw(), packed.get_size()));
+
+	packed.destroy();
+	raw.destroy();
+}
+
+SFG_TEST(data, bulk_round_trip)
+{
+	vector<vertex_static> vertices(1000);
+	vector<float>		  values(37);
+	for (vertex_static& v : vertices)
+		v.pos = vector3(ctx.get_random().range(-1.0f, 1.0f), 0.0f, 1.0f);
+	for (float& f : values)
+		f = ctx.get_random().range(-1.0f, 1.0f);
+
+	// odd sized field first so the payloads need padding.
+	const uint8 marker = 7;
+	ostream		out;
+	out << marker;
+	serialize_vector(out, vertices);
+	serialize_vector(out, values);
+
+	istream				  in(out.get_raw(), out.get_size());
+	vector<vertex_static> read_vertices;
+	vector<float>		  read_values;
+	uint8				  read_marker = 0;
+	in >> read_marker;
+	deserialize_vector(in, read_vertices);
+	deserialize_vector(in, read_values);
+
+	SFG_CHECK(read_marker == marker);
+	SFG_CHECK(in.get_remaining() == 0);
+	SFG_CHECK(read_vertices.size() == vertices.size() && SFG_MEMCMP(read_vertices.data(), vertices.data(), vertices.size() * sizeof(vertex_static)) == 0);
+	SFG_CHECK(read_values == values);
+
+	out.destroy();
+}
+
+SFG_TEST(data, bulk_skips_mismatching_layout)
+{
+	const vector<uint32> written = {1, 2, 3, 4, 5};
+	const uint32		 after	 = 0xABCD;
+	ostream				 out;
+	serialize_vector(out, written);
+	out << after;
+
+	// read back as uint16, the array is dropped whole and the stream stays in sync.
+	istream		   in(out.get_raw(), out.get_size());
+	vector<uint16> read		  = {9};
+	uint32		   read_after = 0;
+	deserialize_vector(in, read);
+	in >> read_after;
+
+	SFG_CHECK(read.empty());
+	SFG_CHECK(read_after == after);
+
+	out.destroy();
+}
+
+SFG_TEST(data, bulk_rejects_other_versions)
+{
+	const vector<uint32> written = {1, 2, 3};
+	ostream				 out;
+	serialize_vector(out, written);
+
+	// count, element size, alignment & flags come first.
+	out.get_raw()[8] = SERIALIZATION_BULK_VERSION + 1;
+
+	istream		   in(out.get_raw(), out.get_size());
+	vector<uint32> read;
+	deserialize_vector(in, read);
+	SFG_CHECK(read.empty());
+	SFG_CHECK(in.get_remaining() == 0);
+
+	// the count prefixed layout written before bulk arrays.
+	const uint32 count = static_cast<uint32>(written.size());
+	ostream		 legacy;
+	legacy << count;
+	for (uint32 v : written)
+		legacy << v;
+
+	istream legacy_in(legacy.get_raw(), legacy.get_size());
+	deserialize_vector(legacy_in, read);
+	SFG_CHECK(read.empty());
+
+	legacy.destroy();
+	out.destroy();
+}
@@ -0,0 +1,1537 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "test.hpp"
+#include "gfx/util/vertex_util.hpp"
+#include "gfx/util/mesh_util.hpp"
+#include "gfx/util/block_compressor.hpp"
+#include "gfx/util/mip_util.hpp"
+#include "gfx/util/image_util.hpp"
+#include "gfx/common/texture_buffer.hpp"
+#include "gfx/world/cluster_culler.hpp"
+#include "gfx/world/frustum_culler.hpp"
+#include "gfx/world/draw_list.hpp"
+#include "gfx/world/draw_instancer.hpp"
+#include "gfx/world/texture_streamer.hpp"
+#include "gfx/backend/backend.hpp"
+#include "gfx/buffer_queue.hpp"
+#include "gfx/common/commands.hpp"
+#include "data/ostream.hpp"
+#include "resources/primitive.hpp"
+#include "math/frustum.hpp"
+#include "math/matrix4x3.hpp"
+#include "math/matrix4x4.hpp"
+#include "math/aabb.hpp"
+#include "memory/memory.hpp"
+#include "math/math.hpp"
+#include <algorithm>
+
+using namespace SFG;
+using namespace SFG::test;
+
+namespace
+{
+	vector3 random_direction(test_random& rnd)
+	{
+		for (;;)
+		{
+			const vector3 v = vector3(rnd.range(-1.0f, 1.0f), rnd.range(-1.0f, 1.0f), rnd.range(-1.0f, 1.0f));
+			if (vector3::dot(v, v) > 0.01f)
+				return v.normalized();
+		}
+	}
+
+	vertex_static random_vertex(test_random& rnd, const vector3& bounds_min, const vector3& bounds_max)
+	{
+		const vector3 tangent = random_direction(rnd);
+		return {
+			.pos	 = vector3(rnd.range(bounds_min.x, bounds_max.x), rnd.range(bounds_min.y, bounds_max.y), rnd.range(bounds_min.z, bounds_max.z)),
+			.normal	 = random_direction(rnd),
+			.tangent = vector4(tangent.x, tangent.y, tangent.z, rnd.next(2) == 0 ? -1.0f : 1.0f),
+			.uv		 = vector2(rnd.range(-4.0f, 4.0f), rnd.range(-4.0f, 4.0f)),
+		};
+	}
+
+	/// side x side vertices on the xz plane at integer coordinates, triangles shuffled so the vertex cache has work to do.
+	void make_grid(vector<primitive_index>& indices, vector<vector3>& positions, uint32 side, test_random& rnd)
+	{
+		const uint32   quads = (side - 1) * (side - 1);
+		vector<uint32> order(quads);
+		for (uint32 i = 0; i < quads; i++)
+			order[i] = i;
+		for (uint32 i = quads; i > 1; i--)
+			std::swap(order[i - 1], order[rnd.next(i)]);
+
+		indices.resize(0);
+		for (uint32 q : order)
+		{
+			const uint32		  i		  = (q / (side - 1)) * side + q % (side - 1);
+			const primitive_index quad[6] = {
+				static_cast<primitive_index>(i),
+				static_cast<primitive_index>(i + side),
+				static_cast<primitive_index>(i + 1),
+				static_cast<primitive_index>(i + 1),
+				static_cast<primitive_index>(i + side),
+				static_cast<primitive_index>(i + side + 1),
+			};
+			indices.insert(indices.end(), quad, quad + 6);
+		}
+
+		positions.resize(static_cast<size_t>(side) * side);
+		for (uint32 i = 0; i < side * side; i++)
+			positions[i] = vector3(static_cast<float>(i % side), 0.0f, static_cast<float>(i / side));
+	}
+
+	/// Rotated so the smallest index leads, which keeps the winding, then sorted. Equal when both hold the same triangles.
+	vector<uint64> sorted_triangles(const primitive_index* indices, size_t index_count)
+	{
+		vector<uint64> out;
+		out.reserve(index_count / 3);
+		for (size_t i = 0; i < index_count; i += 3)
+		{
+			uint64 a = indices[i], b = indices[i + 1], c = indices[i + 2];
+			while (a > b || a > c)
+			{
+				const uint64 t = a;
+				a			   = b;
+				b			   = c;
+				c			   = t;
+			}
+			out.push_back((a << 32) | (b << 16) | c);
+		}
+		std::sort(out.begin(), out.end());
+		return out;
+	}
+
+	/// Back to the grid vertex a position was made from.
+	primitive_index grid_index(const vector3& pos, uint32 side)
+	{
+		return static_cast<primitive_index>(static_cast<uint32>(pos.z) * side + static_cast<uint32>(pos.x));
+	}
+
+	/// Axis aligned box as a frustum, planes face inwards.
+	frustum make_box_frustum(const vector3& min, const vector3& max)
+	{
+		frustum fr = {};
+		fr.left	   = plane(1.0f, 0.0f, 0.0f, min.x);
+		fr.right   = plane(-1.0f, 0.0f, 0.0f, -max.x);
+		fr.bottom  = plane(0.0f, 1.0f, 0.0f, min.y);
+		fr.top	   = plane(0.0f, -1.0f, 0.0f, -max.y);
+		fr.near	   = plane(0.0f, 0.0f, 1.0f, min.z);
+		fr.far	   = plane(0.0f, 0.0f, -1.0f, -max.z);
+		return fr;
+	}
+
+	/// Grid meshlets facing +y, in out_indices order.
+	void make_grid_meshlets(vector<meshlet>& meshlets, vector<primitive_index>& out_indices, vector<vector3>& positions, uint32 side, test_random& rnd)
+	{
+		vector<primitive_index> indices;
+		make_grid(indices, positions, side, rnd);
+		const vector<vector3> normals(positions.size(), vector3(0.0f, 1.0f, 0.0f));
+
+		out_indices.resize(indices.size());
+		mesh_util::build_meshlets(meshlets, out_indices.data(), indices.data(), indices.size(), reinterpret_cast<const uint8*>(positions.data()), sizeof(vector3), reinterpret_cast<const uint8*>(normals.data()), sizeof(vector3), positions.size());
+	}
+
+	/// Smooth gradients with per pixel noise and an alpha ramp, closer to albedo maps than pure noise.
+	texture_buffer make_image(uint16 size, test_random& rnd)
+	{
+		texture_buffer buffer = {};
+		buffer.size			  = vector2ui16(size, size);
+		buffer.bpp			  = 4;
+		buffer.pixels		  = reinterpret_cast<uint8*>(SFG_MALLOC(static_cast<size_t>(size) * size * 4));
+
+		for (uint32 y = 0; y < size; y++)
+		{
+			for (uint32 x = 0; x < size; x++)
+			{
+				uint8* p = buffer.pixels + (static_cast<size_t>(y) * size + x) * 4;
+				p[0]	 = static_cast<uint8>((x * 255 / size + rnd.next(24)) & 0xFF);
+				p[1]	 = static_cast<uint8>((y * 255 / size + rnd.next(24)) & 0xFF);
+				p[2]	 = static_cast<uint8>(((x ^ y) & 0x3F) + rnd.next(16));
+				p[3]	 = static_cast<uint8>((x + y) * 255 / (size * 2));
+			}
+		}
+
+		return buffer;
+	}
+
+	/// Encodes & decodes through the reference decoders, returns the psnr over channels.
+	float compress_psnr(const texture_buffer& src, format target, uint8 channels)
+	{
+		texture_buffer compressed = {};
+		texture_buffer decoded	  = {.size = src.size, .bpp = 4};
+		decoded.pixels			  = reinterpret_cast<uint8*>(SFG_MALLOC(decoded.get_data_size()));
+
+		float psnr = 0.0f;
+		if (block_compressor::compress(src, compressed, {.target = target}) && block_compressor::decompress(compressed, target, decoded))
+			psnr = block_compressor::calculate_psnr(src, decoded, channels);
+
+		SFG_FREE(compressed.pixels);
+		SFG_FREE(decoded.pixels);
+		return psnr;
+	}
+
+	/// LSB first, the way BC7 blocks are laid out.
+	struct bit_writer
+	{
+		uint8* data = nullptr;
+		uint32 bit	= 0;
+
+		void write(uint32 value, uint32 count)
+		{
+			for (uint32 i = 0; i < count; i++, bit++)
+				data[bit / 8] |= static_cast<uint8>(((value >> i) & 1) << (bit % 8));
+		}
+	};
+
+	/// Expected recordings are written field by field with the widths null_backend documents.
+	template <typename T> void put(ostream& stream, T value)
+	{
+		stream.write(value);
+	}
+
+	void put_draw(ostream& stream, const indexed_draw& draw)
+	{
+		put<uint8>(stream, command_bind_constants::TID);
+		put<uint16>(stream, 0);
+		put<uint8>(stream, 4);
+		put<uint8>(stream, 0);
+		put<constant_data>(stream, draw.constants);
+
+		put<uint8>(stream, command_draw_indexed_instanced::TID);
+		put<uint32>(stream, draw.index_count);
+		put<uint32>(stream, draw.instance_count);
+		put<uint32>(stream, draw.start_index);
+		put<uint32>(stream, draw.base_vertex);
+		put<uint32>(stream, draw.start_instance);
+	}
+
+	/// Noise in every channel & byte, worst case for keeping the simd and scalar paths in step.
+	texture_buffer make_noise(uint16 width, uint16 height, uint8 bpp, test_random& rnd)
+	{
+		texture_buffer buffer = {.size = vector2ui16(width, height), .bpp = bpp};
+		buffer.pixels		  = reinterpret_cast<uint8*>(SFG_MALLOC(buffer.get_data_size()));
+		for (size_t i = 0; i < buffer.get_data_size(); i++)
+			buffer.pixels[i] = static_cast<uint8>(rnd.next(256));
+		return buffer;
+	}
+
+	/// Levels past the source, which stays with the caller.
+	void free_chain(texture_buffer* chain, uint8 levels)
+	{
+		for (uint8 i = 1; i < levels; i++)
+		{
+			SFG_FREE(chain[i].pixels);
+			chain[i] = {};
+		}
+	}
+
+	/// Levels of b that differ from a in any byte.
+	uint32 count_level_mismatches(const texture_buffer* a, const texture_buffer* b, uint8 levels)
+	{
+		uint32 mismatches = 0;
+		for (uint8 i = 1; i < levels; i++)
+			mismatches += a[i].get_data_size() != b[i].get_data_size() || SFG_MEMCMP(a[i].pixels, b[i].pixels, a[i].get_data_size()) != 0;
+		return mismatches;
+	}
+
+	vector3 decode_normal(const uint8* p)
+	{
+		return vector3(p[0] / 255.0f * 2.0f - 1.0f, p[1] / 255.0f * 2.0f - 1.0f, p[2] / 255.0f * 2.0f - 1.0f);
+	}
+
+	/// 1024 square rgba8 chain, most detailed first. The tail starts at the 64 square mip.
+	const uint32 STREAM_MIPS[11] = {4194304, 1048576, 262144, 65536, 16384, 4096, 1024, 256, 64, 16, 4};
+
+	/// Stands in for the device, applies the streamer's changes & counts what each one rebuilds, independent of the streamer's own stats.
+	struct stream_device
+	{
+		vector<uint8> resident;
+		vector<uint8> alive;
+		uint64		  frame_uploaded = 0;
+		uint32		  frame_uploads	 = 0;
+
+		static uint64 bytes_from(uint8 first_mip)
+		{
+			uint64 total = 0;
+			for (uint8 i = first_mip; i < 11; i++)
+				total += STREAM_MIPS[i];
+			return total;
+		}
+
+		uint16 add(texture_streamer& streamer)
+		{
+			const uint16 id = streamer.add_texture(STREAM_MIPS, 11, 4, 4);
+			if (id >= resident.size())
+			{
+				resident.resize(id + 1);
+				alive.resize(id + 1);
+			}
+			resident[id] = 4;
+			alive[id]	 = 1;
+			return id;
+		}
+
+		void remove(texture_streamer& streamer, uint16 id)
+		{
+			streamer.remove_texture(id);
+			alive[id] = 0;
+		}
+
+		void apply(const vector<texture_streamer::residency_change>& changes)
+		{
+			frame_uploaded = 0;
+			frame_uploads  = 0;
+			for (const texture_streamer::residency_change& c : changes)
+			{
+				resident[c.id] = c.first_mip;
+				frame_uploaded += bytes_from(c.first_mip);
+				frame_uploads++;
+			}
+		}
+
+		uint64 resident_bytes() const
+		{
+			uint64 total = 0;
+			for (uint32 i = 0; i < resident.size(); i++)
+				total += alive[i] ? bytes_from(resident[i]) : 0;
+			return total;
+		}
+	};
+
+#define TEST_PACK_VERTICES	   4096
+#define TEST_GRID_SIDE		   48
+#define TEST_INVALID_INDEX	   0xFFFFFFFF
+#define TEST_BC_SIZE		   128
+#define TEST_BC1_PSNR		   30.0f // db, the fixture measures about 32 for bc1, 44 for bc4 & 34 for rgba bc7.
+#define TEST_BC4_PSNR		   42.0f
+#define TEST_BC7_PSNR		   32.0f
+#define TEST_GRID_ACMR		   0.8f // tipsify on a grid with a 16 entry cache, the shuffled input is close to 2.
+#define TEST_MIP_WIDTH		   384 // first level is past MIP_PARALLEL_PIXELS so bands really go wide.
+#define TEST_MIP_HEIGHT		   256
+#define TEST_MIP_LEVELS		   10
+#define TEST_MIP_NORMAL		   0.01f // 8 bit xyz is off by up to sqrt(3) / 255 from unit length.
+#define TEST_MIP_STB_MEAN	   0.02 // the fixture measures about 0.005 on the first level.
+#define TEST_INSTANCE_DRAWS	   4096
+#define TEST_INSTANCE_VARIANTS 48
+#define TEST_CULL_BOXES		   1003 // not a multiple of 8, the scalar tail runs too.
+}
+
+SFG_TEST(gfx, vertex_pack_static_round_trip)
+{
+	const vector3			  bounds_min = vector3(-12.0f, -0.5f, 3.0f);
+	const vector3			  bounds_max = vector3(40.0f, 2.0f, 3.25f);
+	const vertex_quantization quant		 = vertex_util::calculate_quantization(bounds_min, bounds_max);
+	vertex_util::pack_error	  err		 = {};
+
+	for (uint32 i = 0; i < TEST_PACK_VERTICES; i++)
+	{
+		const vertex_static	 v		 = random_vertex(ctx.get_random(), bounds_min, bounds_max);
+		vertex_static_packed packed	 = {};
+		vertex_static		 decoded = {};
+		vertex_util::pack(v, quant, packed);
+		vertex_util::unpack(packed, quant, decoded);
+		vertex_util::measure_error(v, decoded, err);
+
+		SFG_CHECK(decoded.tangent.w == v.tangent.w);
+	}
+
+	// half a unorm16 step on the widest axis, uvs within half precision at |4|. Angles are measured through a float acos, which can't resolve much below 0.03 degrees.
+	const float position_step = quant.position_extent.x / 65535.0f;
+	SFG_CHECK(err.position <= position_step);
+	SFG_CHECK(err.normal < 0.05f);
+	SFG_CHECK(err.tangent < 0.05f);
+	SFG_CHECK(err.uv <= 4.0f / 2048.0f);
+}
+
+SFG_TEST(gfx, vertex_pack_bounds_are_exact)
+{
+	const vector3			  bounds_min = vector3(-1.0f, -2.0f, -3.0f);
+	const vector3			  bounds_max = vector3(1.0f, 2.0f, 3.0f);
+	const vertex_quantization quant		 = vertex_util::calculate_quantization(bounds_min, bounds_max);
+
+	const vertex_static corners[2] = {
+		{.pos = bounds_min, .normal = vector3(0.0f, 0.0f, 1.0f), .tangent = vector4(1.0f, 0.0f, 0.0f, 1.0f)},
+		{.pos = bounds_max, .normal = vector3(0.0f, 0.0f, -1.0f), .tangent = vector4(-1.0f, 0.0f, 0.0f, -1.0f)},
+	};
+
+	for (const vertex_static& v : corners)
+	{
+		vertex_static_packed packed	 = {};
+		vertex_static		 decoded = {};
+		vertex_util::pack(v, quant, packed);
+		vertex_util::unpack(packed, quant, decoded);
+
+		SFG_CHECK_NEAR(decoded.pos.x, v.pos.x, 1e-5f);
+		SFG_CHECK_NEAR(decoded.pos.y, v.pos.y, 1e-5f);
+		SFG_CHECK_NEAR(decoded.pos.z, v.pos.z, 1e-5f);
+		SFG_CHECK_NEAR(vector3::dot(decoded.normal, v.normal), 1.0f, 1e-5f);
+		SFG_CHECK(decoded.tangent.w == v.tangent.w);
+	}
+}
+
+SFG_TEST(gfx, vertex_pack_skinned_weights)
+{
+	const vertex_quantization quant = vertex_util::calculate_quantization(vector3(-1.0f, -1.0f, -1.0f), vector3(1.0f, 1.0f, 1.0f));
+	vertex_util::pack_error	  err	= {};
+
+	for (uint32 i = 0; i < TEST_PACK_VERTICES; i++)
+	{
+		test_random&		  rnd	  = ctx.get_random();
+		const vertex_static	  base	  = random_vertex(rnd, vector3(-1.0f, -1.0f, -1.0f), vector3(1.0f, 1.0f, 1.0f));
+		vertex_skinned		  v		  = {};
+		vertex_skinned_packed packed  = {};
+		vertex_skinned		  decoded = {};
+
+		v.pos		   = base.pos;
+		v.normal	   = base.normal;
+		v.tangent	   = base.tangent;
+		v.uv		   = base.uv;
+		v.bone_weights = vector4(rnd.range(0.0f, 1.0f), rnd.range(0.0f, 1.0f), rnd.range(0.0f, 1.0f), rnd.range(0.0f, 1.0f));
+		v.bone_indices = vector4i16(static_cast<int16>(rnd.next(256)), static_cast<int16>(rnd.next(256)), static_cast<int16>(rnd.next(256)), static_cast<int16>(rnd.next(256)));
+
+		if (!SFG_CHECK(vertex_util::pack(v, quant, packed)))
+			return;
+
+		vertex_util::unpack(packed, quant, decoded);
+		vertex_util::measure_error(v, decoded, err);
+
+		SFG_CHECK(packed.bone_weights[0] + packed.bone_weights[1] + packed.bone_weights[2] + packed.bone_weights[3] == 255);
+		SFG_CHECK(decoded.bone_indices.x == v.bone_indices.x && decoded.bone_indices.y == v.bone_indices.y && decoded.bone_indices.z == v.bone_indices.z && decoded.bone_indices.w == v.bone_indices.w);
+	}
+
+	// rounding plus the remainder handed to the largest weight, at most 2 steps.
+	SFG_CHECK(err.weight <= 2.0f / 255.0f);
+}
+
+SFG_TEST(gfx, vertex_pack_skinned_rejects_wide_joints)
+{
+	const vertex_quantization quant	 = vertex_util::calculate_quantization(vector3::zero, vector3::one);
+	vertex_skinned			  v		 = {};
+	vertex_skinned_packed	  packed = {};
+
+	v.bone_weights = vector4(1.0f, 0.0f, 0.0f, 0.0f);
+	v.bone_indices = vector4i16(3, 256, 0, 0);
+	SFG_CHECK(!vertex_util::pack(v, quant, packed));
+
+	v.bone_indices = vector4i16(3, 255, 0, 0);
+	SFG_CHECK(vertex_util::pack(v, quant, packed));
+	SFG_CHECK(packed.bone_weights[0] == 255);
+}
+
+SFG_TEST(gfx, vertex_half_float)
+{
+	const float exact[] = {0.0f, 1.0f, -2.0f, 0.5f, 65504.0f, 6.103515625e-05f, 5.9604644775390625e-08f};
+	for (float f : exact)
+		SFG_CHECK(vertex_util::half_to_float(vertex_util::float_to_half(f)) == f);
+
+	SFG_CHECK(vertex_util::float_to_half(-0.0f) == 0x8000);
+	SFG_CHECK(vertex_util::float_to_half(1e6f) == 0x7C00);
+	SFG_CHECK(vertex_util::float_to_half(-1e6f) == 0xFC00);
+
+	// relative error stays within half an ulp of the 10 bit mantissa across the normal range.
+	for (uint32 i = 0; i < TEST_PACK_VERTICES; i++)
+	{
+		const float f = ctx.get_random().range(-1000.0f, 1000.0f);
+		const float d = vertex_util::half_to_float(vertex_util::float_to_half(f));
+		SFG_CHECK(math::abs(d - f) <= math::abs(f) / 2048.0f + 1e-7f);
+	}
+}
+
+SFG_TEST(gfx, mesh_weld_remap)
+{
+	vector<primitive_index> grid;
+	vector<vector3>			positions;
+	make_grid(grid, positions, TEST_GRID_SIDE, ctx.get_random());
+
+	// one copy per corner as importers hand them over, plus a copy with its own uv and an unreferenced vertex at the end.
+	vector<vertex_static>	vertices;
+	vector<primitive_index> indices;
+	for (size_t i = 0; i < grid.size(); i++)
+	{
+		vertices.push_back({.pos = positions[grid[i]], .normal = vector3(0.0f, 1.0f, 0.0f)});
+		indices.push_back(static_cast<primitive_index>(i));
+	}
+	vertices[indices[0]].uv = vector2(0.5f, 0.5f);
+	vertices.push_back({.pos = vector3(-1.0f, 0.0f, -1.0f)});
+
+	vector<uint32> remap(vertices.size());
+	const uint32   welded = mesh_util::generate_weld_remap(remap.data(), indices.data(), indices.size(), vertices.data(), vertices.size(), sizeof(vertex_static));
+
+	// the seam copy only stays apart if its position is used by another corner too.
+	uint32 shared = 0;
+	for (const vertex_static& v : vertices)
+		shared += v.pos.x == vertices[0].pos.x && v.pos.z == vertices[0].pos.z;
+
+	SFG_CHECK(welded == TEST_GRID_SIDE * TEST_GRID_SIDE + (shared > 1 ? 1 : 0));
+	SFG_CHECK(remap.back() == TEST_INVALID_INDEX);
+	if (!SFG_CHECK(remap[0] == 0))
+		return;
+
+	vector<vertex_static> out(welded);
+	mesh_util::remap_indices(indices.data(), indices.data(), indices.size(), remap.data());
+	mesh_util::remap_vertices(out.data(), vertices.data(), vertices.size(), sizeof(vertex_static), remap.data());
+
+	// same triangles in grid terms, every welded vertex kept its own data.
+	vector<primitive_index> welded_grid(indices.size());
+	for (size_t i = 0; i < indices.size(); i++)
+		welded_grid[i] = grid_index(out[indices[i]].pos, TEST_GRID_SIDE);
+
+	SFG_CHECK(sorted_triangles(welded_grid.data(), welded_grid.size()) == sorted_triangles(grid.data(), grid.size()));
+	SFG_CHECK(out[indices[0]].uv.x == 0.5f);
+}
+
+SFG_TEST(gfx, mesh_vertex_cache_tipsify)
+{
+	vector<primitive_index> indices;
+	vector<vector3>			positions;
+	make_grid(indices, positions, TEST_GRID_SIDE, ctx.get_random());
+
+	const size_t			vertex_count = positions.size();
+	vector<primitive_index> out(indices.size());
+	vector<uint32>			clusters;
+	mesh_util::optimize_vertex_cache(out.data(), indices.data(), indices.size(), vertex_count, MESH_CACHE_SIZE, &clusters);
+
+	const mesh_util::cache_stats before = mesh_util::analyze(indices.data(), indices.size(), vertex_count, sizeof(vector3));
+	const mesh_util::cache_stats after	= mesh_util::analyze(out.data(), out.size(), vertex_count, sizeof(vector3));
+
+	SFG_CHECK(sorted_triangles(out.data(), out.size()) == sorted_triangles(indices.data(), indices.size()));
+	SFG_CHECK(after.acmr < before.acmr * 0.5f);
+	SFG_CHECK(after.acmr < TEST_GRID_ACMR);
+
+	// cluster offsets are triangle starts, ascending from 0.
+	if (!SFG_CHECK(!clusters.empty() && clusters[0] == 0))
+		return;
+	for (size_t i = 1; i < clusters.size(); i++)
+		SFG_CHECK(clusters[i] > clusters[i - 1] && clusters[i] < out.size() / 3);
+}
+
+SFG_TEST(gfx, mesh_fetch_remap)
+{
+	vector<primitive_index> grid;
+	vector<vector3>			positions;
+	make_grid(grid, positions, TEST_GRID_SIDE, ctx.get_random());
+
+	// one vertex nothing uses.
+	positions.push_back(vector3(-1.0f, 0.0f, -1.0f));
+
+	vector<primitive_index> indices(grid.size());
+	mesh_util::optimize_vertex_cache(indices.data(), grid.data(), grid.size(), positions.size());
+
+	vector<uint32> remap(positions.size());
+	const uint32   used = mesh_util::generate_fetch_remap(remap.data(), indices.data(), indices.size(), positions.size());
+	SFG_CHECK(used == TEST_GRID_SIDE * TEST_GRID_SIDE);
+	SFG_CHECK(remap.back() == TEST_INVALID_INDEX);
+
+	vector<vector3> fetched(used);
+	mesh_util::remap_indices(indices.data(), indices.data(), indices.size(), remap.data());
+	mesh_util::remap_vertices(fetched.data(), positions.data(), positions.size(), sizeof(vector3), remap.data());
+
+	// every index is either seen before or the next vertex in the buffer.
+	uint32 next			= 0;
+	uint32 out_of_order	= 0;
+	for (primitive_index i : indices)
+	{
+		if (i == next)
+			next++;
+		else if (i > next)
+			out_of_order++;
+	}
+
+	SFG_CHECK(out_of_order == 0);
+	SFG_CHECK(next == used);
+
+	vector<primitive_index> fetched_grid(indices.size());
+	for (size_t i = 0; i < indices.size(); i++)
+		fetched_grid[i] = grid_index(fetched[indices[i]], TEST_GRID_SIDE);
+	SFG_CHECK(sorted_triangles(fetched_grid.data(), fetched_grid.size()) == sorted_triangles(grid.data(), grid.size()));
+}
+
+SFG_TEST(gfx, mesh_optimize_pipeline)
+{
+	vector<primitive_index> grid;
+	vector<vector3>			positions;
+	make_grid(grid, positions, TEST_GRID_SIDE, ctx.get_random());
+
+	vector<vertex_static>	vertices;
+	vector<primitive_index> indices;
+	for (size_t i = 0; i < grid.size(); i++)
+	{
+		vertices.push_back({.pos = positions[grid[i]], .normal = vector3(0.0f, 1.0f, 0.0f)});
+		indices.push_back(static_cast<primitive_index>(i));
+	}
+
+	mesh_util::optimize(vertices, indices);
+
+	if (!SFG_CHECK(vertices.size() == positions.size() && indices.size() == grid.size()))
+		return;
+
+	vector<primitive_index> optimized_grid(indices.size());
+	for (size_t i = 0; i < indices.size(); i++)
+		optimized_grid[i] = grid_index(vertices[indices[i]].pos, TEST_GRID_SIDE);
+
+	SFG_CHECK(sorted_triangles(optimized_grid.data(), optimized_grid.size()) == sorted_triangles(grid.data(), grid.size()));
+	SFG_CHECK(mesh_util::analyze(indices.data(), indices.size(), vertices.size(), sizeof(vertex_static)).acmr < TEST_GRID_ACMR * MESH_OVERDRAW_THRESHOLD);
+}
+
+SFG_TEST(gfx, mesh_build_meshlets)
+{
+	vector<primitive_index> indices;
+	vector<vector3>			positions;
+	make_grid(indices, positions, TEST_GRID_SIDE, ctx.get_random());
+
+	vector<meshlet>			meshlets;
+	vector<primitive_index> out(indices.size());
+	const size_t			count = mesh_util::build_meshlets(meshlets, out.data(), indices.data(), indices.size(), reinterpret_cast<const uint8*>(positions.data()), sizeof(vector3), nullptr, 0, positions.size());
+
+	if (!SFG_CHECK(count == meshlets.size() && count > 1))
+		return;
+
+	SFG_CHECK(sorted_triangles(out.data(), out.size()) == sorted_triangles(indices.data(), indices.size()));
+
+	// back to back ranges within the limits, bounds hold every vertex, flat cones face +y.
+	uint32		   next = 0;
+	vector<uint32> seen(positions.size(), UINT32_MAX);
+	for (uint32 i = 0; i < count; i++)
+	{
+		const meshlet& m = meshlets[i];
+		SFG_CHECK(m.index_start == next && m.index_count % 3 == 0);
+		SFG_CHECK(m.index_count / 3 <= MESH_MESHLET_TRIANGLES);
+		next = m.index_start + m.index_count;
+
+		uint32 unique  = 0;
+		float  outside = 0.0f;
+		for (uint32 k = m.index_start; k < next; k++)
+		{
+			const primitive_index v = out[k];
+			if (seen[v] != i)
+			{
+				seen[v] = i;
+				unique++;
+			}
+			outside = math::max(outside, (positions[v] - m.center).magnitude() - m.radius);
+		}
+
+		SFG_CHECK(unique <= MESH_MESHLET_VERTICES);
+		SFG_CHECK(outside <= 1e-4f);
+		SFG_CHECK_NEAR(m.cone_axis.y, 1.0f, 1e-4f);
+		SFG_CHECK(m.cone_cutoff < 0.01f);
+	}
+
+	SFG_CHECK(next == out.size());
+}
+
+SFG_TEST(gfx, cluster_cull_backface)
+{
+	vector<meshlet>			meshlets;
+	vector<primitive_index> indices;
+	vector<vector3>			positions;
+	make_grid_meshlets(meshlets, indices, positions, TEST_GRID_SIDE, ctx.get_random());
+
+	const float	  side		 = static_cast<float>(TEST_GRID_SIDE);
+	const frustum everything = make_box_frustum(vector3(-1.0f, -100.0f, -1.0f), vector3(side + 1.0f, 100.0f, side + 1.0f));
+	const vector3 above		 = vector3(side * 0.5f, 50.0f, side * 0.5f);
+	const vector3 below		 = vector3(side * 0.5f, -50.0f, side * 0.5f);
+	const uint32  count		 = static_cast<uint32>(meshlets.size());
+
+	// seen from the front, every meshlet survives & the back to back ranges merge into one.
+	primitive_lod	   ranges[CLUSTER_MAX_RANGES];
+	cluster_cull_stats stats  = {};
+	uint32			   result = cluster_culler::cull(meshlets.data(), count, &everything, 1, matrix4x3::identity, 1.0f, &above, ranges, CLUSTER_MAX_RANGES, stats);
+	SFG_CHECK(result == 1 && ranges[0].index_start == 0 && ranges[0].index_count == indices.size());
+	SFG_CHECK(stats.visible == count && stats.backface_culled == 0);
+
+	// from behind, all of them face away.
+	stats.reset();
+	result = cluster_culler::cull(meshlets.data(), count, &everything, 1, matrix4x3::identity, 1.0f, &below, ranges, CLUSTER_MAX_RANGES, stats);
+	SFG_CHECK(result == 0);
+	SFG_CHECK(stats.backface_culled == count);
+
+	// no camera skips the test.
+	stats.reset();
+	result = cluster_culler::cull(meshlets.data(), count, &everything, 1, matrix4x3::identity, 1.0f, nullptr, ranges, CLUSTER_MAX_RANGES, stats);
+	SFG_CHECK(result == 1 && stats.visible == count);
+}
+
+SFG_TEST(gfx, cluster_cull_frustum_ranges)
+{
+	vector<meshlet>			meshlets;
+	vector<primitive_index> indices;
+	vector<vector3>			positions;
+	make_grid_meshlets(meshlets, indices, positions, TEST_GRID_SIDE, ctx.get_random());
+
+	// a slab over part of the grid, some meshlets straddle its sides.
+	const float	  side	= static_cast<float>(TEST_GRID_SIDE);
+	const vector3 min	= vector3(side * 0.3f, -1.0f, -1.0f);
+	const vector3 max	= vector3(side * 0.6f, 1.0f, side + 1.0f);
+	const frustum slab	= make_box_frustum(min, max);
+	const uint32  count	= static_cast<uint32>(meshlets.size());
+
+	const uint32 max_ranges_list[] = {CLUSTER_MAX_RANGES, 2};
+	for (uint32 max_ranges : max_ranges_list)
+	{
+		primitive_lod	   ranges[CLUSTER_MAX_RANGES];
+		cluster_cull_stats stats  = {};
+		const uint32	   result = cluster_culler::cull(meshlets.data(), count, &slab, 1, matrix4x3::identity, 1.0f, nullptr, ranges, max_ranges, stats);
+
+		SFG_CHECK(result <= max_ranges);
+		SFG_CHECK(stats.tested == count && stats.visible + stats.frustum_culled == count);
+		SFG_CHECK(stats.visible > 0 && stats.frustum_culled > 0);
+
+		// ranges ascend without overlapping, every sphere touching the slab is drawn.
+		for (uint32 r = 1; r < result; r++)
+			SFG_CHECK(ranges[r].index_start > ranges[r - 1].index_start + ranges[r - 1].index_count);
+
+		uint32 missing = 0;
+		uint32 visible = 0;
+		for (const meshlet& m : meshlets)
+		{
+			if (m.center.x + m.radius < min.x || m.center.x - m.radius > max.x)
+				continue;
+
+			visible++;
+			bool covered = false;
+			for (uint32 r = 0; r < result; r++)
+				covered |= m.index_start >= ranges[r].index_start && m.index_start + m.index_count <= ranges[r].index_start + ranges[r].index_count;
+			missing += !covered;
+		}
+
+		SFG_CHECK(visible == stats.visible);
+		SFG_CHECK(missing == 0);
+	}
+}
+
+SFG_TEST(gfx, frustum_cull_synthetic_scene)
+{
+	// camera at y 10 looking down +z, at z 50 the view reaches about 62 to either side & 35 up or down.
+	const matrix4x4 proj = matrix4x4::perspective(70.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
+	const matrix4x4 view = matrix4x4::look_at(vector3(0.0f, 10.0f, 0.0f), vector3(0.0f, 10.0f, 100.0f), vector3::up);
+	const frustum	fr	 = frustum::extract(proj * view);
+
+	struct placed_box
+	{
+		vector3		   center;
+		float		   half;
+		frustum_result expected;
+	};
+
+	const placed_box placed[] = {
+		{.center = vector3(0.0f, 10.0f, 50.0f), .half = 1.0f, .expected = frustum_result::inside},
+		{.center = vector3(20.0f, 0.0f, 200.0f), .half = 4.0f, .expected = frustum_result::inside},
+		{.center = vector3(0.0f, 10.0f, 900.0f), .half = 5.0f, .expected = frustum_result::inside},
+		{.center = vector3(0.0f, 10.0f, -50.0f), .half = 1.0f, .expected = frustum_result::outside},
+		{.center = vector3(200.0f, 10.0f, 50.0f), .half = 1.0f, .expected = frustum_result::outside},
+		{.center = vector3(0.0f, 100.0f, 50.0f), .half = 1.0f, .expected = frustum_result::outside},
+		{.center = vector3(0.0f, 10.0f, 1100.0f), .half = 5.0f, .expected = frustum_result::outside},
+		{.center = vector3(-62.0f, 10.0f, 50.0f), .half = 2.0f, .expected = frustum_result::intersects},
+		{.center = vector3(0.0f, 45.0f, 50.0f), .half = 2.0f, .expected = frustum_result::intersects},
+		{.center = vector3(0.0f, 10.0f, 0.0f), .half = 1.0f, .expected = frustum_result::intersects},
+		{.center = vector3(0.0f, 10.0f, 1000.0f), .half = 5.0f, .expected = frustum_result::intersects},
+	};
+	const uint32 placed_count = sizeof(placed) / sizeof(placed_box);
+
+	vector<aabb> boxes;
+	uint32		 placed_visible = 0;
+	for (const placed_box& p : placed)
+	{
+		const aabb box = aabb(p.center - vector3::one * p.half, p.center + vector3::one * p.half);
+		SFG_CHECK(frustum::test(fr, box) == p.expected);
+		SFG_CHECK(frustum_culler::is_visible(&fr, 1, box) == (p.expected != frustum_result::outside));
+		placed_visible += p.expected != frustum_result::outside;
+		boxes.push_back(box);
+	}
+
+	// batched path on the placed boxes alone, fewer than a full simd batch.
+	vector<uint8> out(TEST_CULL_BOXES);
+	cull_stats	  stats = {};
+	frustum_culler::cull(&fr, 1, boxes.data(), placed_count, out.data(), stats);
+	for (uint32 i = 0; i < placed_count; i++)
+		SFG_CHECK(out[i] == (placed[i].expected != frustum_result::outside ? 1 : 0));
+	SFG_CHECK(stats.tested == placed_count && stats.visible == placed_visible && stats.culled == placed_count - placed_visible);
+
+	// then a scattered scene around the camera, against one view & two.
+	test_random& rnd = ctx.get_random();
+	while (boxes.size() < TEST_CULL_BOXES)
+	{
+		const vector3 center(rnd.range(-500.0f, 500.0f), rnd.range(-20.0f, 50.0f), rnd.range(-500.0f, 1200.0f));
+		const vector3 half(rnd.range(0.5f, 8.0f), rnd.range(0.5f, 8.0f), rnd.range(0.5f, 8.0f));
+		boxes.push_back(aabb(center - half, center + half));
+	}
+
+	const matrix4x4 side_view = matrix4x4::look_at(vector3(0.0f, 10.0f, 0.0f), vector3(100.0f, 10.0f, 0.0f), vector3::up);
+	const frustum	views[]	  = {fr, frustum::extract(proj * side_view)};
+
+	for (uint32 view_count = 1; view_count <= 2; view_count++)
+	{
+		stats.reset();
+		frustum_culler::cull(views, view_count, boxes.data(), TEST_CULL_BOXES, out.data(), stats);
+
+		uint32 visible	= 0;
+		uint32 mismatch = 0;
+		for (uint32 i = 0; i < TEST_CULL_BOXES; i++)
+		{
+			const bool expected = frustum_culler::is_visible(views, view_count, boxes[i]);
+			visible += expected;
+			mismatch += out[i] != (expected ? 1 : 0);
+		}
+
+		SFG_CHECK(mismatch == 0);
+		SFG_CHECK(stats.tested == TEST_CULL_BOXES);
+		SFG_CHECK(stats.visible == visible && stats.culled == TEST_CULL_BOXES - visible);
+		SFG_CHECK(visible > 0 && visible < TEST_CULL_BOXES);
+	}
+
+	// stats add up across calls.
+	frustum_culler::cull(views, 1, boxes.data(), placed_count, out.data(), stats);
+	SFG_CHECK(stats.tested == TEST_CULL_BOXES + placed_count);
+}
+
+SFG_TEST(gfx, block_decode_bc1_reference)
+{
+	// red & blue endpoints, one pixel per palette entry in the first row.
+	uint8 block[8] = {0x00, 0xF8, 0x1F, 0x00, 0xE4, 0x00, 0x00, 0x00};
+	uint8 rgba[64] = {};
+	block_compressor::decode_bc1(block, rgba);
+
+	const uint8 four_color[4][4] = {{255, 0, 0, 255}, {0, 0, 255, 255}, {170, 0, 85, 255}, {85, 0, 170, 255}};
+	for (uint32 i = 0; i < 4; i++)
+		SFG_CHECK(SFG_MEMCMP(rgba + i * 4, four_color[i], 4) == 0);
+
+	// swapped endpoints select the three color mode, the midpoint rounds either way & index 3 is transparent black.
+	const uint8 swapped[8] = {0x1F, 0x00, 0x00, 0xF8, 0xE4, 0x00, 0x00, 0x00};
+	block_compressor::decode_bc1(swapped, rgba);
+	SFG_CHECK(rgba[0] == 0 && rgba[2] == 255);
+	SFG_CHECK(rgba[4] == 255 && rgba[6] == 0);
+	SFG_CHECK_NEAR(static_cast<int32>(rgba[8]), 127, 1);
+	SFG_CHECK_NEAR(static_cast<int32>(rgba[10]), 127, 1);
+	SFG_CHECK(rgba[12] == 0 && rgba[13] == 0 && rgba[14] == 0 && rgba[15] == 0);
+}
+
+SFG_TEST(gfx, block_decode_bc4_reference)
+{
+	// 3 bit indices 0, 1, 2, 7 in the first four pixels.
+	uint8 block[8] = {200, 100, 0x88, 0x0E, 0x00, 0x00, 0x00, 0x00};
+	uint8 rgba[64] = {};
+	block_compressor::decode_bc4(block, 0, rgba);
+	SFG_CHECK(rgba[0] == 200 && rgba[4] == 100);
+	SFG_CHECK_NEAR(static_cast<int32>(rgba[8]), 186, 1); // (6 * 200 + 100) / 7
+	SFG_CHECK_NEAR(static_cast<int32>(rgba[12]), 114, 1); // (200 + 6 * 100) / 7
+
+	// ordered endpoints select the six value mode, 6 & 7 are 0 & 255.
+	block[0] = 100;
+	block[1] = 200;
+	block[2] = 0x06 | (0x7 << 3);
+	block[3] = 0x00;
+	block_compressor::decode_bc4(block, 0, rgba);
+	SFG_CHECK(rgba[0] == 0 && rgba[4] == 255);
+}
+
+SFG_TEST(gfx, block_decode_bc7_reference)
+{
+	// mode 6, endpoints 127 with p bit 1 & 0 with p bit 0, so 255 and 0 on every channel.
+	uint8	   block[16] = {};
+	bit_writer w		 = {.data = block};
+	w.write(1 << 6, 7);
+	for (uint32 c = 0; c < 4; c++)
+	{
+		w.write(127, 7);
+		w.write(0, 7);
+	}
+	w.write(1, 1);
+	w.write(0, 1);
+
+	// anchor 0, then the middle & last weights.
+	const uint32 indices[4] = {0, 8, 15, 7};
+	w.write(indices[0], 3);
+	for (uint32 i = 1; i < 16; i++)
+		w.write(indices[i < 4 ? i : 0], 4);
+
+	uint8 rgba[64] = {};
+	if (!SFG_CHECK(block_compressor::decode_bc7(block, rgba)))
+		return;
+
+	// ((64 - w) * e0 + w * e1 + 32) >> 6, weights 0, 34, 64 & 30.
+	const uint8 expected[4] = {255, 120, 0, 135};
+	for (uint32 i = 0; i < 4; i++)
+		SFG_CHECK(rgba[i * 4] == expected[i] && rgba[i * 4 + 1] == expected[i] && rgba[i * 4 + 2] == expected[i] && rgba[i * 4 + 3] == expected[i]);
+
+	// mode 0 isn't emitted, decoding refuses it.
+	uint8 mode0[16] = {0x01};
+	SFG_CHECK(!block_compressor::decode_bc7(mode0, rgba));
+}
+
+SFG_TEST(gfx, block_compress_psnr)
+{
+	texture_buffer src = make_image(TEST_BC_SIZE, ctx.get_random());
+
+	const float bc3 = compress_psnr(src, format::bc3_block_unorm, 4);
+	const float bc4 = compress_psnr(src, format::bc4_block_unorm, 1);
+	const float bc5 = compress_psnr(src, format::bc5_block_unorm, 2);
+	const float bc7 = compress_psnr(src, format::bc7_block_unorm, 4);
+
+	// bc1 turns anything below half alpha into transparent black, it's measured on the opaque image.
+	for (size_t i = 3; i < src.get_data_size(); i += 4)
+		src.pixels[i] = 255;
+	const float bc1		   = compress_psnr(src, format::bc1_block_unorm, 3);
+	const float bc7_opaque = compress_psnr(src, format::bc7_block_unorm, 3);
+
+	SFG_CHECK(bc1 > TEST_BC1_PSNR);
+	SFG_CHECK(bc3 > TEST_BC1_PSNR);
+	SFG_CHECK(bc4 > TEST_BC4_PSNR);
+	SFG_CHECK(bc5 > TEST_BC4_PSNR);
+	SFG_CHECK(bc7 > TEST_BC7_PSNR);
+	SFG_CHECK(bc7_opaque > bc1);
+
+	// solid colors the endpoints hold exactly come back exact. 565 for bc1, one shared p bit for bc7 so every channel is odd.
+	const uint8 solid_bc1[4] = {255, 0, 255, 255};
+	const uint8 solid_bc7[4] = {201, 37, 123, 255};
+	for (size_t i = 0; i < src.get_data_size(); i += 4)
+		SFG_MEMCPY(src.pixels + i, solid_bc1, 4);
+	SFG_CHECK(compress_psnr(src, format::bc1_block_unorm, 3) == MATH_INF_F);
+	SFG_CHECK(compress_psnr(src, format::bc4_block_unorm, 1) == MATH_INF_F);
+
+	for (size_t i = 0; i < src.get_data_size(); i += 4)
+		SFG_MEMCPY(src.pixels + i, solid_bc7, 4);
+	SFG_CHECK(compress_psnr(src, format::bc7_block_unorm, 4) == MATH_INF_F);
+	SFG_CHECK(compress_psnr(src, format::bc4_block_unorm, 1) == MATH_INF_F);
+	SFG_CHECK(compress_psnr(src, format::bc5_block_unorm, 2) == MATH_INF_F);
+
+	SFG_FREE(src.pixels);
+}
+
+// a pass walked through draw_binder comes back as the exact byte stream null_backend documents.
+SFG_TEST(gfx, null_backend_records_draw_pass)
+{
+	null_backend* backend = null_backend::create_instance();
+	const gfx_id  queue	  = backend->get_queue_gfx();
+	const gfx_id  cmd	  = backend->create_command_buffer({.type = command_type::graphics});
+	backend->set_recording(true);
+
+	// the second draw shares all state with the first, the third switches pipeline & group only.
+	const indexed_draw draws[3] = {
+		{.constants = {1, 2, 3, 4}, .base_vertex = 10, .index_count = 36, .instance_count = 1, .pipeline = 1, .bind_group = 2, .vertex_buffer = 3, .idx_buffer = 4, .vertex_size = 48},
+		{.constants = {5, 6, 7, 8}, .base_vertex = 20, .index_count = 12, .instance_count = 3, .start_index = 36, .start_instance = 1, .pipeline = 1, .bind_group = 2, .vertex_buffer = 3, .idx_buffer = 4, .vertex_size = 48},
+		{.constants = {9, 10, 11, 12}, .index_count = 6, .instance_count = 2, .start_index = 48, .start_instance = 4, .pipeline = 5, .bind_group = 6, .vertex_buffer = 3, .idx_buffer = 4, .vertex_size = 48},
+	};
+
+	render_pass_color_attachment attachment = {.texture = 7};
+	draw_stats					 stats		= {};
+	draw_binder					 binder(cmd, stats);
+
+	backend->reset_command_buffer(cmd);
+	backend->cmd_begin_render_pass(cmd, {.color_attachments = &attachment, .color_attachment_count = 1});
+	for (const indexed_draw& d : draws)
+	{
+		binder.bind(d, true);
+		binder.draw(d);
+	}
+	backend->cmd_end_render_pass(cmd, {});
+	backend->close_command_buffer(cmd);
+	backend->submit_commands(queue, &cmd, 1);
+
+	ostream commands;
+	put<uint8>(commands, command_begin_render_pass::TID);
+	put<uint8>(commands, 1);
+	put<gfx_id>(commands, 7);
+	put<load_op>(commands, load_op::clear);
+	put<store_op>(commands, store_op::store);
+	put<uint8>(commands, 0);
+
+	put<uint8>(commands, command_bind_vertex_buffers::TID);
+	put<gfx_id>(commands, 3);
+	put<uint8>(commands, 0);
+	put<uint16>(commands, 48);
+	put<uint64>(commands, 0);
+	put<uint8>(commands, command_bind_index_buffers::TID);
+	put<gfx_id>(commands, 4);
+	put<uint64>(commands, 0);
+	put<uint8>(commands, 2);
+	put<uint8>(commands, command_bind_pipeline::TID);
+	put<gfx_id>(commands, 1);
+	put<uint8>(commands, command_bind_group::TID);
+	put<gfx_id>(commands, 2);
+	put_draw(commands, draws[0]);
+
+	put_draw(commands, draws[1]);
+
+	put<uint8>(commands, command_bind_pipeline::TID);
+	put<gfx_id>(commands, 5);
+	put<uint8>(commands, command_bind_group::TID);
+	put<gfx_id>(commands, 6);
+	put_draw(commands, draws[2]);
+
+	put<uint8>(commands, command_end_render_pass::TID);
+
+	ostream expected;
+	put<uint8>(expected, null_backend::RECORD_SUBMIT);
+	put<gfx_id>(expected, queue);
+	put<gfx_id>(expected, cmd);
+	put<uint32>(expected, static_cast<uint32>(commands.get_size()));
+	expected.write_raw(commands.get_raw(), commands.get_size());
+
+	const ostream& recording = backend->get_recording();
+	SFG_CHECK(backend->get_submitted_command_count() == 1);
+	SFG_CHECK(stats.draws == 3 && stats.vertex_binds == 1 && stats.index_binds == 1 && stats.pipeline_binds == 2 && stats.group_binds == 2);
+	if (SFG_CHECK(recording.get_size() == expected.get_size()))
+		SFG_CHECK(SFG_MEMCMP(recording.get_raw(), expected.get_raw(), expected.get_size()) == 0);
+
+	commands.destroy();
+	expected.destroy();
+	backend->set_recording(false);
+	backend->destroy_command_buffer(cmd);
+	null_backend::destroy_instance();
+}
+
+SFG_TEST(gfx, buffer_queue_keeps_overlapping_writes_in_order)
+{
+	null_backend* backend = null_backend::create_instance();
+	const gfx_id  queue	  = backend->get_queue_gfx();
+	const gfx_id  cmd	  = backend->create_command_buffer({.type = command_type::transfer});
+	const gfx_id  target  = backend->create_resource({.size = 256, .debug_name = "target"});
+
+	buffer_queue bq;
+	bq.init();
+
+	// the second write lands below & over the first one, the last two continue each other in the ring & the target.
+	struct write
+	{
+		uint32 offset;
+		uint32 size;
+		uint8  value;
+	};
+
+	const write writes[] = {
+		{.offset = 32, .size = 64, .value = 0xAA},
+		{.offset = 0, .size = 64, .value = 0xBB},
+		{.offset = 128, .size = 32, .value = 0xCC},
+		{.offset = 160, .size = 32, .value = 0xDD},
+	};
+
+	for (const write& w : writes)
+	{
+		uint8* ptr = bq.allocate(target, w.offset, w.size);
+		if (SFG_CHECK(ptr != nullptr))
+			SFG_MEMSET(ptr, w.value, w.size);
+	}
+
+	backend->set_recording(true);
+	backend->reset_command_buffer(cmd);
+	bq.flush_all(cmd);
+	backend->close_command_buffer(cmd);
+	backend->submit_commands(queue, &cmd, 1);
+
+	uint8* data = nullptr;
+	backend->map_resource(target, data);
+	if (SFG_CHECK(data != nullptr))
+	{
+		uint32 wrong = 0;
+		for (uint32 i = 0; i < 256; i++)
+		{
+			const uint8 expected = i < 64 ? 0xBB : i < 96 ? 0xAA : i < 128 ? 0 : i < 160 ? 0xCC : i < 192 ? 0xDD : 0;
+			wrong += data[i] != expected;
+		}
+		SFG_CHECK(wrong == 0);
+	}
+
+	// copies in the order they were written, the adjacent pair merged into one. The ring is the source of the first copy.
+	const ostream& recording = backend->get_recording();
+	const uint32   header	 = sizeof(uint8) + sizeof(gfx_id) * 2 + sizeof(uint32);
+	gfx_id		   ring		 = target;
+	if (recording.get_size() > header + sizeof(uint8) + sizeof(gfx_id))
+		SFG_MEMCPY(&ring, recording.get_raw() + header + sizeof(uint8), sizeof(gfx_id));
+	SFG_CHECK(ring != target);
+
+	ostream commands;
+
+	auto put_copy = [&](uint32 source_offset, uint32 destination_offset, uint32 size) {
+		put<uint8>(commands, command_copy_buffer::TID);
+		put<gfx_id>(commands, ring);
+		put<gfx_id>(commands, target);
+		put<uint32>(commands, source_offset);
+		put<uint32>(commands, destination_offset);
+		put<uint32>(commands, size);
+	};
+	put_copy(0, 32, 64);
+	put_copy(64, 0, 64);
+	put_copy(128, 128, 64);
+
+	if (SFG_CHECK(recording.get_size() == header + commands.get_size()))
+		SFG_CHECK(SFG_MEMCMP(recording.get_raw() + header, commands.get_raw(), commands.get_size()) == 0);
+
+	commands.destroy();
+	backend->set_recording(false);
+	bq.uninit();
+	backend->destroy_resource(target);
+	backend->destroy_command_buffer(cmd);
+	null_backend::destroy_instance();
+}
+
+SFG_TEST(gfx, mip_simd_and_parallel_match_scalar)
+{
+	struct format_case
+	{
+		uint8 channels;
+		uint8 channel_size;
+		uint8 is_linear;
+		uint8 premultiplied_alpha;
+		uint8 is_normal_map;
+	};
+
+	const format_case cases[] = {
+		{4, 1, 0, 0, 0},
+		{4, 1, 1, 1, 0},
+		{3, 1, 1, 0, 1},
+		{2, 1, 1, 0, 1},
+		{1, 1, 1, 0, 0},
+		{4, 2, 1, 0, 0},
+		{1, 2, 0, 0, 0},
+	};
+
+	const mip_util::filter filters[] = {mip_util::filter::box, mip_util::filter::kaiser};
+	const uint8			   levels	 = image_util::calculate_mip_levels(TEST_MIP_WIDTH, TEST_MIP_HEIGHT);
+	if (!SFG_CHECK(levels <= TEST_MIP_LEVELS))
+		return;
+
+	for (const format_case& fc : cases)
+	{
+		texture_buffer reference[TEST_MIP_LEVELS];
+		texture_buffer other[TEST_MIP_LEVELS];
+		reference[0] = make_noise(TEST_MIP_WIDTH, TEST_MIP_HEIGHT, fc.channels * fc.channel_size, ctx.get_random());
+		other[0]	 = reference[0];
+
+		for (mip_util::filter f : filters)
+		{
+			mip_util::desc d = {
+				.mip_filter			 = f,
+				.channels			 = fc.channels,
+				.channel_size		 = fc.channel_size,
+				.is_linear			 = fc.is_linear,
+				.premultiplied_alpha = fc.premultiplied_alpha,
+				.is_normal_map		 = fc.is_normal_map,
+				.use_simd			 = 0,
+				.parallel			 = 0,
+			};
+			mip_util::generate(reference, levels, d);
+
+			// every other simd/parallel combination has to come out byte for byte the same.
+			for (uint8 combination = 1; combination < 4; combination++)
+			{
+				d.use_simd = combination & 1;
+				d.parallel = (combination >> 1) & 1;
+				mip_util::generate(other, levels, d);
+				SFG_CHECK(count_level_mismatches(reference, other, levels) == 0);
+				free_chain(other, levels);
+			}
+
+			free_chain(reference, levels);
+		}
+
+		SFG_FREE(reference[0].pixels);
+	}
+}
+
+SFG_TEST(gfx, mip_srgb_round_trip)
+{
+	float previous = -1.0f;
+	for (uint32 v = 0; v < 256; v++)
+	{
+		const float linear = mip_util::srgb_to_linear(static_cast<uint8>(v));
+		const float c	   = v / 255.0f;
+		const float exact  = c <= 0.04045f ? c / 12.92f : math::pow((c + 0.055f) / 1.055f, 2.4f);
+
+		SFG_CHECK(mip_util::linear_to_srgb(linear) == v);
+		SFG_CHECK_NEAR(linear, exact, 1e-5f);
+		SFG_CHECK(linear > previous);
+		previous = linear;
+	}
+
+	SFG_CHECK(mip_util::srgb_to_linear(0) == 0.0f);
+	SFG_CHECK(mip_util::srgb_to_linear(255) == 1.0f);
+	SFG_CHECK(mip_util::linear_to_srgb(-1.0f) == 0);
+	SFG_CHECK(mip_util::linear_to_srgb(2.0f) == 255);
+}
+
+SFG_TEST(gfx, mip_normal_map_renormalized)
+{
+	const uint8	   levels = image_util::calculate_mip_levels(TEST_MIP_WIDTH, TEST_MIP_HEIGHT);
+	texture_buffer chain[TEST_MIP_LEVELS];
+	chain[0]		= {.size = vector2ui16(TEST_MIP_WIDTH, TEST_MIP_HEIGHT), .bpp = 4};
+	chain[0].pixels	= reinterpret_cast<uint8*>(SFG_MALLOC(chain[0].get_data_size()));
+
+	// unit normals facing out of the surface, noisy enough that plain averages come out well short of unit length.
+	for (size_t i = 0; i < chain[0].get_data_size(); i += 4)
+	{
+		vector3 n			   = random_direction(ctx.get_random());
+		n.z					   = math::abs(n.z);
+		chain[0].pixels[i + 0] = static_cast<uint8>(math::round((n.x * 0.5f + 0.5f) * 255.0f));
+		chain[0].pixels[i + 1] = static_cast<uint8>(math::round((n.y * 0.5f + 0.5f) * 255.0f));
+		chain[0].pixels[i + 2] = static_cast<uint8>(math::round((n.z * 0.5f + 0.5f) * 255.0f));
+		chain[0].pixels[i + 3] = 255;
+	}
+
+	const mip_util::filter filters[] = {mip_util::filter::box, mip_util::filter::kaiser};
+	for (mip_util::filter f : filters)
+	{
+		for (uint8 normalize = 0; normalize < 2; normalize++)
+		{
+			mip_util::generate(chain, levels, {.mip_filter = f, .is_linear = 1, .is_normal_map = normalize});
+
+			float  worst = 0.0f;
+			double sum	 = 0.0;
+			for (size_t i = 0; i < chain[1].get_data_size(); i += 4)
+			{
+				const float len = decode_normal(chain[1].pixels + i).magnitude();
+				worst			= math::max(worst, math::abs(len - 1.0f));
+				sum += len;
+			}
+
+			for (uint8 l = 2; l < levels && normalize; l++)
+			{
+				for (size_t i = 0; i < chain[l].get_data_size(); i += 4)
+					worst = math::max(worst, math::abs(decode_normal(chain[l].pixels + i).magnitude() - 1.0f));
+			}
+
+			const double mean = sum / static_cast<double>(chain[1].get_data_size() / 4);
+			if (normalize)
+				SFG_CHECK(worst < TEST_MIP_NORMAL);
+			else
+				SFG_CHECK(mean < 0.9);
+
+			free_chain(chain, levels);
+		}
+	}
+
+	SFG_FREE(chain[0].pixels);
+}
+
+// box filtered sRGB chains stay within a rounding step of the stb path mip_util replaced, opaque so alpha weighting stays out of it.
+SFG_TEST(gfx, mip_box_close_to_stb)
+{
+	const uint8	   levels = image_util::calculate_mip_levels(TEST_MIP_WIDTH, TEST_MIP_WIDTH);
+	texture_buffer chain[TEST_MIP_LEVELS];
+	texture_buffer ref[TEST_MIP_LEVELS];
+	chain[0] = make_image(TEST_MIP_WIDTH, ctx.get_random());
+	for (size_t i = 3; i < chain[0].get_data_size(); i += 4)
+		chain[0].pixels[i] = 255;
+	ref[0] = chain[0];
+
+	mip_util::generate(chain, levels, {.mip_filter = mip_util::filter::box, .is_linear = 0});
+	image_util::generate_mips_stb(ref, levels, image_util::mip_gen_filter::box, 4, false, false);
+
+	for (uint8 l = 1; l < levels; l++)
+	{
+		uint32 worst = 0;
+		uint64 sum	 = 0;
+		for (size_t i = 0; i < chain[l].get_data_size(); i++)
+		{
+			const uint32 diff = chain[l].pixels[i] > ref[l].pixels[i] ? chain[l].pixels[i] - ref[l].pixels[i] : ref[l].pixels[i] - chain[l].pixels[i];
+			worst			  = math::max(worst, diff);
+			sum += diff;
+		}
+
+		SFG_CHECK(worst <= 1);
+		if (l == 1)
+			SFG_CHECK(static_cast<double>(sum) / static_cast<double>(chain[l].get_data_size()) < TEST_MIP_STB_MEAN);
+	}
+
+	free_chain(chain, levels);
+	free_chain(ref, levels);
+	SFG_FREE(chain[0].pixels);
+}
+
+SFG_TEST(gfx, texture_streamer_upload_budget)
+{
+	const uint64 tail	= stream_device::bytes_from(4);
+	const uint64 step	= stream_device::bytes_from(3);
+	const uint64 budget = 2 * 1024 * 1024;
+
+	texture_streamer streamer;
+	stream_device	 device;
+	streamer.init({.upload_bytes = budget, .resident_bytes = UINT64_MAX});
+
+	uint16 ids[4];
+	for (uint16& id : ids)
+		id = device.add(streamer);
+	SFG_CHECK(streamer.get_stats().resident_bytes == tail * 4);
+
+	// everything wants the full chain, each frame uploads what fits & the rest comes later.
+	vector<texture_streamer::residency_change> changes;
+	for (uint64 frame = 1; frame < 16; frame++)
+	{
+		for (uint16 id : ids)
+			streamer.request(id, 0, frame);
+
+		changes.resize(0);
+		streamer.update(frame, changes);
+		device.apply(changes);
+
+		// over budget only as the single upload of an otherwise idle frame.
+		SFG_CHECK(device.frame_uploaded <= budget || device.frame_uploads == 1);
+		SFG_CHECK(device.frame_uploaded == streamer.get_stats().uploaded_bytes);
+		SFG_CHECK(device.resident_bytes() == streamer.get_stats().resident_bytes);
+	}
+
+	for (uint16 id : ids)
+		SFG_CHECK(device.resident[id] == 0 && streamer.get_resident_mip(id) == 0);
+
+	// a budget below even one step: an idle frame lets a single step through, the others wait.
+	streamer.uninit();
+	device = {};
+	streamer.init({.upload_bytes = step / 2, .resident_bytes = UINT64_MAX});
+	for (uint16& id : ids)
+		id = device.add(streamer);
+
+	for (uint64 frame = 1; frame < 5; frame++)
+	{
+		for (uint16 id : ids)
+			streamer.request(id, 0, frame);
+
+		changes.resize(0);
+		streamer.update(frame, changes);
+		device.apply(changes);
+
+		if (!SFG_CHECK(changes.size() == 1))
+			break;
+		SFG_CHECK(changes[0].first_mip == 3);
+		SFG_CHECK(device.frame_uploaded == step);
+		SFG_CHECK(streamer.get_stats().starved == 4);
+	}
+
+	streamer.uninit();
+}
+
+SFG_TEST(gfx, texture_streamer_resident_budget_lru)
+{
+	const uint64 tail	  = stream_device::bytes_from(4);
+	const uint64 upgraded = stream_device::bytes_from(1);
+
+	// room for the tails & two textures at mip 1.
+	texture_streamer streamer;
+	stream_device	 device;
+	streamer.init({.upload_bytes = UINT64_MAX, .resident_bytes = tail * 4 + (upgraded - tail) * 2});
+
+	const uint16 a = device.add(streamer);
+	const uint16 b = device.add(streamer);
+	const uint16 c = device.add(streamer);
+	const uint16 d = device.add(streamer);
+
+	vector<texture_streamer::residency_change> changes;
+
+	auto tick = [&](uint64 frame) {
+		changes.resize(0);
+		streamer.update(frame, changes);
+		device.apply(changes);
+		SFG_CHECK(device.resident_bytes() == streamer.get_stats().resident_bytes);
+		SFG_CHECK(device.resident_bytes() <= tail * 4 + (upgraded - tail) * 2);
+	};
+
+	streamer.request(a, 1, 1);
+	tick(1);
+	streamer.request(b, 1, 2);
+	tick(2);
+	SFG_CHECK(device.resident[a] == 1 && device.resident[b] == 1);
+
+	// full, the least recently requested one drops back to its tail first.
+	streamer.request(c, 1, 3);
+	tick(3);
+	if (SFG_CHECK(changes.size() == 2))
+	{
+		SFG_CHECK(changes[0].id == a && changes[0].evicted == 1 && changes[0].first_mip == 4);
+		SFG_CHECK(changes[1].id == c && changes[1].evicted == 0 && changes[1].first_mip == 1);
+	}
+	SFG_CHECK(streamer.get_stats().evictions == 1);
+	SFG_CHECK(device.resident[a] == 4 && device.resident[b] == 1 && device.resident[c] == 1);
+
+	// b is the oldest, but it's asked for again this frame, so c goes instead.
+	streamer.request(b, 1, 4);
+	streamer.request(d, 1, 4);
+	tick(4);
+	SFG_CHECK(device.resident[b] == 1 && device.resident[c] == 4 && device.resident[d] == 1);
+
+	// nothing left that may go, the request waits at its tail.
+	streamer.request(a, 1, 5);
+	streamer.request(b, 1, 5);
+	streamer.request(d, 1, 5);
+	tick(5);
+	SFG_CHECK(changes.empty());
+	SFG_CHECK(streamer.get_stats().starved == 1);
+	SFG_CHECK(device.resident[a] == 4);
+
+	streamer.uninit();
+}
+
+SFG_TEST(gfx, texture_streamer_remove_accounting)
+{
+	const uint64 tail	  = stream_device::bytes_from(4);
+	const uint64 upgraded = stream_device::bytes_from(1);
+
+	texture_streamer streamer;
+	stream_device	 device;
+	streamer.init({.upload_bytes = UINT64_MAX, .resident_bytes = tail * 3 + (upgraded - tail) * 2});
+
+	const uint16 a = device.add(streamer);
+	const uint16 b = device.add(streamer);
+
+	vector<texture_streamer::residency_change> changes;
+	streamer.request(a, 1, 1);
+	streamer.request(b, 1, 1);
+	streamer.update(1, changes);
+	device.apply(changes);
+	SFG_CHECK(streamer.get_resident_bytes(a) == upgraded);
+
+	// removing an upgraded texture gives back everything it held.
+	const uint64 before = streamer.get_stats().resident_bytes;
+	device.remove(streamer, a);
+	SFG_CHECK(streamer.get_stats().resident_bytes == before - upgraded);
+	SFG_CHECK(streamer.get_stats().resident_bytes == device.resident_bytes());
+
+	// the freed id comes back with just its tail, and the removed one is never evicted.
+	const uint16 c = device.add(streamer);
+	SFG_CHECK(c == a);
+	SFG_CHECK(streamer.get_resident_bytes(c) == tail);
+	SFG_CHECK(streamer.get_stats().resident_bytes == device.resident_bytes());
+
+	changes.resize(0);
+	streamer.request(c, 1, 2);
+	streamer.update(2, changes);
+	device.apply(changes);
+	SFG_CHECK(changes.size() == 1 && changes[0].id == c && changes[0].evicted == 0);
+	SFG_CHECK(streamer.get_stats().resident_bytes == device.resident_bytes());
+
+	device.remove(streamer, b);
+	device.remove(streamer, c);
+	SFG_CHECK(streamer.get_stats().resident_bytes == 0);
+	streamer.uninit();
+}
+
+SFG_TEST(gfx, draw_instancer_batches)
+{
+	// variants share a pipeline, meshes differ in buffers & index ranges, materials in the bind group.
+	vector<indexed_draw> variants(TEST_INSTANCE_VARIANTS);
+	for (uint32 i = 0; i < TEST_INSTANCE_VARIANTS; i++)
+	{
+		indexed_draw& d	 = variants[i];
+		d.pipeline		 = 3;
+		d.bind_group	 = static_cast<gfx_id>(i % 5);
+		d.vertex_buffer	 = static_cast<gfx_id>(i / 5);
+		d.idx_buffer	 = static_cast<gfx_id>(i / 5);
+		d.vertex_size	 = 48;
+		d.base_vertex	 = (i / 5) * 100;
+		d.start_index	 = (i / 5) * 300;
+		d.index_count	 = 300;
+		d.instance_count = 1;
+	}
+
+	draw_instancer		   instancer;
+	vector<vector<uint32>> expected(TEST_INSTANCE_VARIANTS);
+	vector<uint16>		   nearest(TEST_INSTANCE_VARIANTS, UINT16_MAX);
+	vector<int32>		   first_seen;
+
+	// the second pass checks nothing leaks through reset().
+	for (uint32 pass = 0; pass < 2; pass++)
+	{
+		instancer.reset();
+		for (vector<uint32>& e : expected)
+			e.resize(0);
+		std::fill(nearest.begin(), nearest.end(), UINT16_MAX);
+		first_seen.resize(0);
+
+		for (uint32 i = 0; i < TEST_INSTANCE_DRAWS; i++)
+		{
+			const uint32 variant = ctx.get_random().next(TEST_INSTANCE_VARIANTS);
+			const uint32 slot	 = i * 7 + 3;
+			const uint16 depth	 = static_cast<uint16>(ctx.get_random().next(UINT16_MAX));
+
+			// per draw data that isn't part of the batch key.
+			indexed_draw d		  = variants[variant];
+			d.constants.constant0 = i;
+			d.start_instance	  = i;
+			instancer.add(d, slot, depth);
+
+			if (expected[variant].empty())
+				first_seen.push_back(static_cast<int32>(variant));
+			expected[variant].push_back(slot);
+			nearest[variant] = math::min(nearest[variant], depth);
+		}
+
+		instancer.build();
+
+		const vector<indexed_draw>& draws	  = instancer.get_draws();
+		const vector<uint32>&		instances = instancer.get_instances();
+		if (!SFG_CHECK(draws.size() == first_seen.size()) || !SFG_CHECK(instances.size() == TEST_INSTANCE_DRAWS))
+			return;
+
+		// batches in first seen order, each one's slots contiguous from constant0 in the order they were added.
+		uint32 offset = 0;
+		uint32 wrong  = 0;
+		for (uint32 b = 0; b < draws.size(); b++)
+		{
+			const indexed_draw&	  d		= draws[b];
+			const uint32		  v		= static_cast<uint32>(first_seen[b]);
+			const vector<uint32>& slots = expected[v];
+
+			wrong += d.constants.constant0 != offset || d.instance_count != slots.size() || d.start_instance != 0;
+			wrong += !(indexed_draw(d) == variants[v]) || instancer.get_depths()[b] != nearest[v];
+			wrong += SFG_MEMCMP(instances.data() + offset, slots.data(), slots.size() * sizeof(uint32)) != 0;
+			offset += d.instance_count;
+		}
+
+		SFG_CHECK(wrong == 0);
+		SFG_CHECK(offset == TEST_INSTANCE_DRAWS);
+	}
+}
+
+SFG_TEST(gfx, draw_instancer_keeps_different_draws_apart)
+{
+	const indexed_draw base = {
+		.constants		= {0, 11, 12, 13},
+		.base_vertex	= 100,
+		.index_count	= 36,
+		.instance_count = 1,
+		.start_index	= 72,
+		.pipeline		= 1,
+		.bind_group		= 2,
+		.vertex_buffer	= 3,
+		.idx_buffer		= 4,
+		.vertex_size	= 48,
+	};
+
+	// one change per compared field.
+	vector<indexed_draw> apart(10, base);
+	apart[0].base_vertex++;
+	apart[1].index_count++;
+	apart[2].start_index++;
+	apart[3].pipeline++;
+	apart[4].bind_group++;
+	apart[5].vertex_buffer++;
+	apart[6].idx_buffer++;
+	apart[7].constants.constant1++;
+	apart[8].constants.constant2++;
+	apart[9].constants.constant3++;
+
+	// constant0 & start_instance are rewritten per batch, they don't split one.
+	indexed_draw same		 = base;
+	same.constants.constant0 = 99;
+	same.start_instance		 = 5;
+
+	draw_instancer instancer;
+	instancer.add(base, 0, 10);
+	for (uint32 i = 0; i < apart.size(); i++)
+		instancer.add(apart[i], i + 1, 10);
+	instancer.add(same, 100, 5);
+	instancer.build();
+
+	const vector<indexed_draw>& draws = instancer.get_draws();
+	if (!SFG_CHECK(draws.size() == apart.size() + 1))
+		return;
+
+	SFG_CHECK(draws[0].instance_count == 2);
+	SFG_CHECK(instancer.get_depths()[0] == 5);
+	SFG_CHECK(instancer.get_instances()[0] == 0 && instancer.get_instances()[1] == 100);
+	for (uint32 i = 1; i < draws.size(); i++)
+	{
+		SFG_CHECK(draws[i].instance_count == 1);
+		SFG_CHECK(draws[i].constants.constant0 == i + 1);
+		SFG_CHECK(instancer.get_instances()[i + 1] == i);
+	}
+}
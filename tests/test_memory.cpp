@@ -0,0 +1,329 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "test.hpp"
+#include "memory/ring_allocator.hpp"
+#include "memory/range_allocator.hpp"
+
+using namespace SFG;
+using namespace SFG::test;
+
+namespace
+{
+	/// Byte ownership of a range_allocator's live ranges, to catch overlaps the allocator itself can't see.
+	struct range_shadow
+	{
+		vector<uint32> owner;
+		uint32		   overlaps = 0;
+
+		void mark(const range_allocator& alloc, uint32 id)
+		{
+			for (uint32 b = alloc.get_offset(id); b < alloc.get_offset(id) + alloc.get_size(id); b++)
+			{
+				overlaps += owner[b] != RANGE_INVALID_ID;
+				owner[b] = id;
+			}
+		}
+
+		void clear(uint32 offset, uint32 size)
+		{
+			for (uint32 b = offset; b < offset + size; b++)
+				owner[b] = RANGE_INVALID_ID;
+		}
+	};
+
+#define TEST_RING_CAPACITY 4096
+#define TEST_RING_FRAMES   2000
+#define TEST_RING_LATENCY  3
+#define TEST_RANGE_STEPS   3000
+#define TEST_RANGE_LIVE	   256
+}
+
+SFG_TEST(memory, ring_wrap_around)
+{
+	ring_allocator ring;
+	ring.init(1024);
+
+	SFG_CHECK(ring.allocate(400) == 0);
+	ring.end_frame(1);
+	SFG_CHECK(ring.allocate(400) == 400);
+	ring.end_frame(2);
+	ring.retire(1);
+
+	// 224 bytes left at the end don't fit, the allocation wraps into what frame 1 gave back & the tail end counts as used.
+	SFG_CHECK(ring.allocate(300) == 0);
+	SFG_CHECK(ring.get_used() == 400 + 224 + 300);
+	SFG_CHECK(ring.allocate(200) == RING_INVALID_OFFSET);
+	SFG_CHECK(ring.allocate(100) == 300);
+	SFG_CHECK(ring.get_used() == ring.get_capacity());
+	SFG_CHECK(ring.allocate(1) == RING_INVALID_OFFSET);
+	ring.end_frame(3);
+
+	// frame 2 is out of the way, the head runs up to frame 3's wasted tail end.
+	ring.retire(2);
+	SFG_CHECK(ring.get_used() == 224 + 400);
+	SFG_CHECK(ring.allocate(400) == 400);
+	SFG_CHECK(ring.allocate(1) == RING_INVALID_OFFSET);
+	ring.end_frame(4);
+
+	// empty again, starts over from the front.
+	ring.retire(4);
+	SFG_CHECK(ring.get_used() == 0 && ring.get_pending_frames() == 0);
+	SFG_CHECK(ring.allocate(1000) == 0);
+}
+
+SFG_TEST(memory, ring_alignment)
+{
+	ring_allocator ring;
+	ring.init(1024);
+
+	SFG_CHECK(ring.allocate(3) == 0);
+	SFG_CHECK(ring.allocate(8, 256) == 256);
+	SFG_CHECK(ring.get_used() == 264);
+
+	// doesn't fit behind the pending frame, does once the ring is empty & starts over.
+	ring.end_frame(1);
+	SFG_CHECK(ring.allocate(700, 512) == RING_INVALID_OFFSET);
+	ring.retire(1);
+	SFG_CHECK(ring.allocate(700, 512) == 0);
+}
+
+SFG_TEST(memory, ring_fence_retire)
+{
+	ring_allocator ring;
+	ring.init(1024);
+
+	for (uint64 fence = 1; fence <= 3; fence++)
+	{
+		SFG_CHECK(ring.allocate(100) != RING_INVALID_OFFSET);
+		ring.end_frame(fence);
+	}
+
+	// nothing passed yet, then oldest first & only up to the completed fence.
+	ring.retire(0);
+	SFG_CHECK(ring.get_pending_frames() == 3 && ring.get_used() == 300);
+	ring.retire(2);
+	SFG_CHECK(ring.get_pending_frames() == 1 && ring.get_used() == 100);
+	ring.retire(2);
+	SFG_CHECK(ring.get_pending_frames() == 1);
+
+	// a frame without allocations still takes its turn.
+	ring.end_frame(4);
+	ring.retire(3);
+	SFG_CHECK(ring.get_pending_frames() == 1 && ring.get_used() == 0);
+	ring.retire(4);
+	SFG_CHECK(ring.get_pending_frames() == 0);
+}
+
+SFG_TEST(memory, ring_frames_never_overlap)
+{
+	// every byte remembers the frame holding it, the gpu lags a few frames behind.
+	ring_allocator ring;
+	ring.init(TEST_RING_CAPACITY);
+	vector<uint64> owner(TEST_RING_CAPACITY, 0);
+	uint32		   overlaps	 = 0;
+	uint32		   allocated = 0;
+
+	for (uint64 frame = 1; frame <= TEST_RING_FRAMES; frame++)
+	{
+		if (frame > TEST_RING_LATENCY)
+		{
+			const uint64 completed = frame - TEST_RING_LATENCY;
+			ring.retire(completed);
+			for (uint64& o : owner)
+				o = o <= completed ? 0 : o;
+		}
+
+		const uint32 count = ctx.get_random().next(6);
+		for (uint32 i = 0; i < count; i++)
+		{
+			const size_t size	   = 1 + ctx.get_random().next(600);
+			const size_t alignment = static_cast<size_t>(1) << ctx.get_random().next(9);
+			const size_t offset	   = ring.allocate(size, alignment);
+			if (offset == RING_INVALID_OFFSET)
+				continue;
+
+			allocated++;
+			SFG_CHECK(offset % alignment == 0 && offset + size <= TEST_RING_CAPACITY);
+			for (size_t b = offset; b < offset + size && b < TEST_RING_CAPACITY; b++)
+			{
+				overlaps += owner[b] != 0;
+				owner[b] = frame;
+			}
+		}
+
+		ring.end_frame(frame);
+		SFG_CHECK(ring.get_used() <= ring.get_capacity());
+	}
+
+	SFG_CHECK(overlaps == 0);
+	SFG_CHECK(allocated > TEST_RING_FRAMES);
+}
+
+SFG_TEST(memory, range_allocate_free_coalesce)
+{
+	range_allocator alloc;
+	alloc.init(1000);
+
+	const uint32 a = alloc.allocate(100, 1, 7);
+	const uint32 b = alloc.allocate(100, 1);
+	const uint32 c = alloc.allocate(100, 1);
+	SFG_CHECK(alloc.get_offset(a) == 0 && alloc.get_offset(b) == 100 && alloc.get_offset(c) == 200);
+	SFG_CHECK(alloc.get_user(a) == 7 && alloc.get_used() == 300 && alloc.get_high_water() == 300);
+
+	// holes merge with both neighbours.
+	alloc.free(b);
+	SFG_CHECK(alloc.get_free_range_count() == 2);
+	alloc.free(a);
+	SFG_CHECK(alloc.get_free_range_count() == 2 && alloc.get_largest_free() == 700);
+	alloc.free(c);
+	SFG_CHECK(alloc.get_free_range_count() == 1 && alloc.get_used() == 0 && alloc.get_high_water() == 0);
+
+	// lowest fit, alignment needn't be a power of two, the front padding stays free.
+	const uint32 d = alloc.allocate(10, 1);
+	const uint32 e = alloc.allocate(10, 24);
+	const uint32 f = alloc.allocate(14, 1);
+	SFG_CHECK(alloc.get_offset(d) == 0 && alloc.get_offset(e) == 24 && alloc.get_offset(f) == 10);
+	SFG_CHECK(alloc.get_used() == 34);
+	SFG_CHECK(alloc.allocate(2000, 1) == RANGE_INVALID_ID);
+
+	alloc.uninit();
+}
+
+SFG_TEST(memory, range_grow)
+{
+	range_allocator alloc;
+	alloc.init(1000);
+
+	const uint32 a = alloc.allocate(600, 1);
+	const uint32 b = alloc.allocate(300, 1);
+	SFG_CHECK(alloc.allocate(200, 1) == RANGE_INVALID_ID);
+
+	// the free end joins the grown space.
+	alloc.grow(2000);
+	SFG_CHECK(alloc.get_capacity() == 2000 && alloc.get_free_range_count() == 1);
+	const uint32 c = alloc.allocate(200, 1);
+	SFG_CHECK(c != RANGE_INVALID_ID && alloc.get_offset(c) == 900);
+	SFG_CHECK(alloc.get_offset(a) == 0 && alloc.get_offset(b) == 600);
+
+	alloc.uninit();
+}
+
+SFG_TEST(memory, range_defragment_relocations)
+{
+	range_allocator alloc;
+	alloc.init(1000);
+
+	uint32 ids[10];
+	for (uint32 i = 0; i < 10; i++)
+		ids[i] = alloc.allocate(100, 4, i);
+	for (uint32 i = 0; i < 10; i += 2)
+		alloc.free(ids[i]);
+
+	// bounded step, stops after the first move past max_bytes.
+	vector<range_allocator::relocation> relocations;
+	SFG_CHECK(alloc.defragment(150, relocations) == 200);
+	SFG_CHECK(relocations.size() == 2);
+
+	const uint32 moved = alloc.defragment(UINT32_MAX, relocations);
+	SFG_CHECK(moved > 0);
+
+	// moves go down, keep size & user, the old range stays held under retired_id until freed.
+	for (const range_allocator::relocation& r : relocations)
+	{
+		SFG_CHECK(r.new_offset < r.old_offset && r.new_offset % 4 == 0);
+		SFG_CHECK(alloc.get_offset(r.id) == r.new_offset);
+		SFG_CHECK(alloc.get_offset(r.retired_id) == r.old_offset && alloc.get_size(r.retired_id) == r.size);
+		SFG_CHECK(alloc.get_user(r.retired_id) == alloc.get_user(r.id));
+	}
+
+	SFG_CHECK(alloc.get_used() == 500 + 200 + moved);
+
+	// retired ranges never move themselves, and freeing them leaves the live data packed at the front.
+	vector<range_allocator::relocation> again;
+	alloc.defragment(UINT32_MAX, again);
+	SFG_CHECK(again.empty());
+
+	for (const range_allocator::relocation& r : relocations)
+		alloc.free(r.retired_id);
+	SFG_CHECK(alloc.get_used() == 500 && alloc.get_high_water() == 500 && alloc.get_free_range_count() == 1);
+
+	alloc.uninit();
+}
+
+SFG_TEST(memory, range_random_never_overlaps)
+{
+	// allocations, frees & defragment steps at random, retired ranges are freed one step later like the geometry heaps do.
+	range_allocator alloc;
+	alloc.init(1 << 16);
+	range_shadow shadow = {.owner = vector<uint32>(1 << 16, RANGE_INVALID_ID)};
+
+	vector<uint32>						live;
+	vector<uint32>						retired;
+	vector<range_allocator::relocation> relocations;
+	uint64								live_bytes = 0;
+	uint32								moves	   = 0;
+
+	for (uint32 step = 0; step < TEST_RANGE_STEPS; step++)
+	{
+		for (uint32 id : retired)
+		{
+			shadow.clear(alloc.get_offset(id), alloc.get_size(id));
+			alloc.free(id);
+		}
+		retired.resize(0);
+
+		test_random& rnd = ctx.get_random();
+		const uint32 op	 = rnd.next(10);
+
+		if (op < 5 && live.size() < TEST_RANGE_LIVE)
+		{
+			const uint32 alignment = 1 + rnd.next(48);
+			const uint32 size	   = 1 + rnd.next(1024);
+			const uint32 id		   = alloc.allocate(size, alignment);
+			if (id == RANGE_INVALID_ID)
+			{
+				alloc.grow(alloc.get_capacity() + (1 << 14));
+				shadow.owner.resize(alloc.get_capacity(), RANGE_INVALID_ID);
+				continue;
+			}
+
+			SFG_CHECK(alloc.get_offset(id) % alignment == 0);
+			shadow.mark(alloc, id);
+			live.push_back(id);
+			live_bytes += size;
+		}
+		else if (op < 9 && !live.empty())
+		{
+			const uint32 slot = rnd.next(static_cast<uint32>(live.size()));
+			const uint32 id	  = live[slot];
+			live_bytes -= alloc.get_size(id);
+			shadow.clear(alloc.get_offset(id), alloc.get_size(id));
+			alloc.free(id);
+			live[slot] = live.back();
+			live.pop_back();
+		}
+		else
+		{
+			relocations.resize(0);
+			alloc.defragment(4096, relocations);
+			for (const range_allocator::relocation& r : relocations)
+			{
+				// the old bytes now belong to the retired id, the new ones must have been free.
+				for (uint32 b = r.old_offset; b < r.old_offset + r.size; b++)
+					shadow.owner[b] = r.retired_id;
+				shadow.mark(alloc, r.id);
+				retired.push_back(r.retired_id);
+				moves++;
+			}
+		}
+
+		uint64 retired_bytes = 0;
+		for (uint32 id : retired)
+			retired_bytes += alloc.get_size(id);
+		SFG_CHECK(alloc.get_used() == live_bytes + retired_bytes);
+	}
+
+	SFG_CHECK(shadow.overlaps == 0);
+	SFG_CHECK(moves > 0);
+	alloc.uninit();
+}
@@ -0,0 +1,212 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "test.hpp"
+#include "thread/job_system.hpp"
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using namespace SFG;
+using namespace SFG::test;
+
+namespace
+{
+	struct stage_fixture
+	{
+		atomic<uint32> first_done  = 0;
+		atomic<uint32> second_done = 0;
+		atomic<uint32> early	   = 0;
+		atomic<uint32> checksum	   = 0;
+		uint32		   first_count = 0;
+	};
+
+	void first_stage(void* user_data, uint32 start, uint32 end)
+	{
+		stage_fixture& f = *static_cast<stage_fixture*>(user_data);
+
+		// a little work so the dependent stage gets a chance to be picked up too early.
+		uint32 hash = start;
+		for (uint32 i = 0; i < 2000; i++)
+			hash = hash * 1664525u + 1013904223u;
+		f.checksum.fetch_add(hash, std::memory_order_relaxed);
+
+		f.first_done.fetch_add(end - start, std::memory_order_acq_rel);
+	}
+
+	void second_stage(void* user_data, uint32 start, uint32 end)
+	{
+		stage_fixture& f = *static_cast<stage_fixture*>(user_data);
+		f.early.fetch_add(f.first_done.load(std::memory_order_acquire) != f.first_count, std::memory_order_relaxed);
+		f.second_done.fetch_add(end - start, std::memory_order_acq_rel);
+	}
+
+	struct nested_fixture
+	{
+		atomic<uint32> incomplete = 0;
+		atomic<uint32> parents	  = 0;
+		uint32		   children	  = 0;
+	};
+
+	void count_child(void* user_data, uint32 start, uint32 end)
+	{
+		static_cast<atomic<uint32>*>(user_data)->fetch_add(end - start, std::memory_order_acq_rel);
+	}
+
+	/// Waits on its own children from whichever thread runs it, the wait keeps executing other jobs meanwhile.
+	void nested_parent(void* user_data, uint32 start, uint32 end)
+	{
+		nested_fixture& f		 = *static_cast<nested_fixture*>(user_data);
+		atomic<uint32>	children = 0;
+		job_counter		counter;
+
+		job_system::get().submit_range(&count_child, &children, f.children, 1, &counter);
+		job_system::get().wait(&counter);
+
+		f.incomplete.fetch_add(children.load(std::memory_order_acquire) != f.children, std::memory_order_relaxed);
+		f.parents.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/// Every job holds until all of them started, which only works out if they run on that many threads at once.
+	struct rendezvous
+	{
+		atomic<uint32>			arrived	  = 0;
+		atomic<uint32>			timeouts  = 0;
+		uint32					expected  = 0;
+		uint32					timeout_s = 0;
+		std::mutex				mtx;
+		vector<std::thread::id> threads;
+	};
+
+	void meet(void* user_data, uint32 start, uint32 end)
+	{
+		rendezvous& r = *static_cast<rendezvous*>(user_data);
+		{
+			std::lock_guard<std::mutex> lock(r.mtx);
+			r.threads.push_back(std::this_thread::get_id());
+		}
+
+		r.arrived.fetch_add(1, std::memory_order_acq_rel);
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(r.timeout_s);
+		while (r.arrived.load(std::memory_order_acquire) < r.expected)
+		{
+			if (std::chrono::steady_clock::now() > deadline)
+			{
+				r.timeouts.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			std::this_thread::yield();
+		}
+	}
+
+#define TEST_FOR_MAX		 65537
+#define TEST_STAGE_JOBS		 256
+#define TEST_NESTED_PARENTS	 16
+#define TEST_NESTED_CHILDREN 32
+#define TEST_JOB_TIMEOUT_S	 10
+}
+
+SFG_TEST(thread, parallel_for_runs_every_index_once)
+{
+	job_system& js = job_system::get();
+	if (!SFG_CHECK(js.is_init()))
+		return;
+
+	atomic<uint32>* hits	  = new atomic<uint32>[TEST_FOR_MAX];
+	const uint32	counts[]  = {0, 1, 7, 64, 1000, TEST_FOR_MAX};
+	const uint32	batches[] = {0, 1, 16, 1000};
+
+	for (uint32 count : counts)
+	{
+		for (uint32 batch : batches)
+		{
+			for (uint32 i = 0; i < TEST_FOR_MAX; i++)
+				hits[i].store(0, std::memory_order_relaxed);
+
+			js.parallel_for(count, batch, [&](uint32 i) { hits[i].fetch_add(1, std::memory_order_relaxed); });
+
+			uint32 wrong = 0;
+			for (uint32 i = 0; i < TEST_FOR_MAX; i++)
+				wrong += hits[i].load(std::memory_order_relaxed) != (i < count ? 1u : 0u);
+			SFG_CHECK(wrong == 0);
+
+			// batched ranges tile the same indices, nothing overlaps or falls in between.
+			for (uint32 i = 0; i < TEST_FOR_MAX; i++)
+				hits[i].store(0, std::memory_order_relaxed);
+
+			js.parallel_for_batched(count, batch, [&](uint32 start, uint32 end) {
+				for (uint32 i = start; i < end; i++)
+					hits[i].fetch_add(1, std::memory_order_relaxed);
+			});
+
+			wrong = 0;
+			for (uint32 i = 0; i < TEST_FOR_MAX; i++)
+				wrong += hits[i].load(std::memory_order_relaxed) != (i < count ? 1u : 0u);
+			SFG_CHECK(wrong == 0);
+		}
+	}
+
+	delete[] hits;
+}
+
+SFG_TEST(thread, counters_and_dependencies)
+{
+	job_system& js = job_system::get();
+	if (!SFG_CHECK(js.is_init()))
+		return;
+
+	// the dependent stage is pushed last, so its jobs are the first ones popped & parked.
+	stage_fixture stages = {.first_count = TEST_STAGE_JOBS};
+	job_counter	  first;
+	job_counter	  second;
+	js.submit_range(&first_stage, &stages, TEST_STAGE_JOBS, 1, &first);
+	js.submit_range(&second_stage, &stages, TEST_STAGE_JOBS, 1, &second, &first);
+	js.wait(&second);
+
+	SFG_CHECK(first.is_done());
+	SFG_CHECK(second.is_done());
+	SFG_CHECK(stages.first_done.load() == TEST_STAGE_JOBS);
+	SFG_CHECK(stages.second_done.load() == TEST_STAGE_JOBS);
+	SFG_CHECK(stages.early.load() == 0);
+
+	// one counter shared by several submits, including a functor.
+	atomic<uint32> single = 0;
+	auto		   bump	  = [&]() { single.fetch_add(1, std::memory_order_relaxed); };
+	job_counter	   shared;
+	js.submit(bump, &shared);
+	js.submit(bump, &shared);
+	js.submit({.function = &count_child, .user_data = &single, .start = 0, .end = 3}, &shared);
+	js.wait(&shared);
+	SFG_CHECK(single.load() == 5);
+
+	// jobs that wait on their own children.
+	nested_fixture nested = {.children = TEST_NESTED_CHILDREN};
+	job_counter	   parents;
+	js.submit_range(&nested_parent, &nested, TEST_NESTED_PARENTS, 1, &parents);
+	js.wait(&parents);
+	SFG_CHECK(nested.parents.load() == TEST_NESTED_PARENTS);
+	SFG_CHECK(nested.incomplete.load() == 0);
+}
+
+SFG_TEST(thread, workers_steal_from_a_busy_queue)
+{
+	job_system& js = job_system::get();
+	if (!SFG_CHECK(js.is_init() && js.get_worker_count() > 0))
+		return;
+
+	// everything lands in the main thread's queue, the main thread can only run one of them.
+	rendezvous r;
+	r.expected	= js.get_worker_count() + 1;
+	r.timeout_s = TEST_JOB_TIMEOUT_S;
+
+	job_counter counter;
+	js.submit_range(&meet, &r, r.expected, 1, &counter);
+	js.wait(&counter);
+
+	std::sort(r.threads.begin(), r.threads.end());
+	const uint32 distinct = static_cast<uint32>(std::unique(r.threads.begin(), r.threads.end()) - r.threads.begin());
+
+	SFG_CHECK(r.timeouts.load() == 0);
+	SFG_CHECK(r.arrived.load() == r.expected);
+	SFG_CHECK(distinct == r.expected);
+}
@@ -0,0 +1,175 @@
+// Copyright (c) 2025 Inan Evin
+
+#include "test.hpp"
+#include "world/world.hpp"
+#include "world/entity_manager.hpp"
+#include "world/system_scheduler.hpp"
+
+using namespace SFG;
+using namespace SFG::test;
+
+namespace
+{
+	/// Roots in a row with one child each, the writer slides the roots along x.
+	struct transform_fixture
+	{
+		vector<entity_handle> roots;
+		vector<entity_handle> children;
+		float				  offset = 0.0f;
+	};
+
+	struct transform_reader
+	{
+		transform_fixture* fixture = nullptr;
+		uint32			   stale   = 0;
+		uint32			   wrong   = 0;
+	};
+
+	void move_roots(world& w, float dt, void* user_data)
+	{
+		transform_fixture& f  = *static_cast<transform_fixture*>(user_data);
+		entity_manager&	   em = w.get_entity_manager();
+		f.offset += 1.0f;
+		for (uint32 i = 0; i < f.roots.size(); i++)
+			em.set_entity_position(f.roots[i], vector3(f.offset, 0.0f, static_cast<float>(i)));
+	}
+
+	void read_children(world& w, float dt, void* user_data)
+	{
+		transform_reader&  r  = *static_cast<transform_reader*>(user_data);
+		transform_fixture& f  = *r.fixture;
+		entity_manager&	   em = w.get_entity_manager();
+
+		const uint16 stale_flags = entity_flags::entity_flags_abs_matrix_stale | entity_flags::entity_flags_abs_aabb_stale | entity_flags::entity_flags_abs_rotation_dirty;
+		for (uint32 i = 0; i < f.children.size(); i++)
+		{
+			const entity_handle child = f.children[i];
+			r.stale += em.get_entity_meta(child).flags.is_set(stale_flags);
+
+			const vector3 pos = em.get_entity_transform_abs(child).get_translation();
+			const aabb&	  box = em.get_entity_aabb_abs(child);
+			r.wrong += pos.x != f.offset || pos.y != 1.0f || pos.z != static_cast<float>(i) || box.bounds_min.x != f.offset - 0.5f;
+		}
+	}
+
+#define TEST_TRANSFORM_ROOTS   512
+#define TEST_TRANSFORM_READERS 4
+#define TEST_TRANSFORM_TICKS   3
+#define TEST_ENTITY_COUNT	   1048576 // 1024 pages of ENTITY_PAGE_SIZE.
+}
+
+SFG_TEST(world, scheduler_settles_transforms_between_waves)
+{
+	world			  w;
+	entity_manager&	  em = w.get_entity_manager();
+	transform_fixture fixture;
+
+	for (uint32 i = 0; i < TEST_TRANSFORM_ROOTS; i++)
+	{
+		const entity_handle root  = em.create_entity("root");
+		const entity_handle child = em.create_entity("child");
+		em.add_child(root, child);
+		em.set_entity_position(child, vector3(0.0f, 1.0f, 0.0f));
+		em.set_entity_aabb(child, aabb(vector3(-0.5f, -0.5f, -0.5f), vector3(0.5f, 0.5f, 0.5f)));
+		fixture.roots.push_back(root);
+		fixture.children.push_back(child);
+	}
+
+	// one writer, then readers sharing the next wave.
+	system_scheduler scheduler;
+	transform_reader readers[TEST_TRANSFORM_READERS];
+	scheduler.add_system({.name = "move", .function = &move_roots, .user_data = &fixture, .writes = SYSTEM_ACCESS_TRANSFORMS});
+	for (transform_reader& r : readers)
+	{
+		r.fixture = &fixture;
+		scheduler.add_system({.name = "read", .function = &read_children, .user_data = &r, .reads = SYSTEM_ACCESS_TRANSFORMS});
+	}
+
+	SFG_CHECK(scheduler.get_wave_count() == 2);
+
+	for (uint32 tick = 0; tick < TEST_TRANSFORM_TICKS; tick++)
+		scheduler.execute(w, 0.016f);
+
+	// readers found the caches settled, nothing was refreshed while they ran in parallel.
+	for (const transform_reader& r : readers)
+	{
+		SFG_CHECK(r.stale == 0);
+		SFG_CHECK(r.wrong == 0);
+	}
+}
+
+SFG_TEST(world, entity_handles_across_pages)
+{
+	world											w;
+	entity_manager&									em		 = w.get_entity_manager();
+	const paged_pool_allocator32<ENTITY_PAGE_SIZE>&	entities = em.get_entities();
+	vector<entity_handle>							handles(TEST_ENTITY_COUNT);
+
+	// first entity's storage, growing by pages must not move it.
+	handles[0]			 = em.create_entity("first");
+	const vector3* first = &em.get_entity_position(handles[0]);
+
+	for (uint32 i = 1; i < TEST_ENTITY_COUNT; i++)
+		handles[i] = em.create_entity("entity");
+
+	uint32 wrong = 0;
+	for (uint32 i = 0; i < TEST_ENTITY_COUNT; i++)
+	{
+		wrong += handles[i].index != i || !entities.is_valid(handles[i]);
+		em.set_entity_position(handles[i], vector3(static_cast<float>(i), 0.0f, 0.0f));
+	}
+
+	SFG_CHECK(wrong == 0);
+	SFG_CHECK(entities.get_alive_count() == TEST_ENTITY_COUNT);
+	SFG_CHECK(entities.get_capacity() >= TEST_ENTITY_COUNT);
+	SFG_CHECK(first == &em.get_entity_position(handles[0]));
+
+	// every other one goes, the rest keep their index & data.
+	vector<entity_handle> stale;
+	for (uint32 i = 0; i < TEST_ENTITY_COUNT; i += 2)
+	{
+		em.destroy_entity(handles[i]);
+		stale.push_back(handles[i]);
+	}
+
+	wrong = 0;
+	for (const entity_handle& h : stale)
+		wrong += entities.is_valid(h);
+	SFG_CHECK(wrong == 0);
+
+	wrong = 0;
+	for (uint32 i = 1; i < TEST_ENTITY_COUNT; i += 2)
+		wrong += !entities.is_valid(handles[i]) || em.get_entity_position(handles[i]).x != static_cast<float>(i);
+	SFG_CHECK(wrong == 0);
+	SFG_CHECK(entities.get_alive_count() == TEST_ENTITY_COUNT / 2);
+
+	// refill reuses the freed slots without growing, the stale handles stay dead.
+	const size_t capacity = entities.get_capacity();
+	const uint32 head	  = entities.get_head();
+	uint32		 reused	  = 0;
+	for (uint32 i = 0; i < stale.size(); i++)
+	{
+		const entity_handle h = em.create_entity("again");
+		reused += h.index < TEST_ENTITY_COUNT && h.index % 2 == 0 && h.generation != handles[h.index].generation;
+		handles[h.index]	  = h;
+	}
+
+	SFG_CHECK(reused == stale.size());
+	SFG_CHECK(entities.get_capacity() == capacity && entities.get_head() == head);
+
+	wrong = 0;
+	for (const entity_handle& h : stale)
+		wrong += entities.is_valid(h);
+	for (const entity_handle& h : handles)
+		wrong += !entities.is_valid(h);
+	SFG_CHECK(wrong == 0);
+
+	for (const entity_handle& h : handles)
+		em.destroy_entity(h);
+
+	wrong = 0;
+	for (const entity_handle& h : handles)
+		wrong += entities.is_valid(h);
+	SFG_CHECK(wrong == 0);
+	SFG_CHECK(entities.get_alive_count() == 0);
+}